@@ -145,6 +145,7 @@ class ClientOriginatedMessage(google.protobuf.message.Message):
     CLOSE_REQUEST_FIELD_NUMBER: builtins.int
     INVOKE_FUNCTION_REQUEST_FIELD_NUMBER: builtins.int
     LIST_PROMPTS_REQUEST_FIELD_NUMBER: builtins.int
+    GET_SCROLLBACK_REQUEST_FIELD_NUMBER: builtins.int
     id: builtins.int = ...
 
     @property
@@ -249,6 +250,9 @@ class ClientOriginatedMessage(google.protobuf.message.Message):
     @property
     def list_prompts_request(self) -> global___ListPromptsRequest: ...
 
+    @property
+    def get_scrollback_request(self) -> global___GetScrollbackRequest: ...
+
     def __init__(self,
         *,
         id : typing.Optional[builtins.int] = ...,
@@ -286,10 +290,11 @@ class ClientOriginatedMessage(google.protobuf.message.Message):
         close_request : typing.Optional[global___CloseRequest] = ...,
         invoke_function_request : typing.Optional[global___InvokeFunctionRequest] = ...,
         list_prompts_request : typing.Optional[global___ListPromptsRequest] = ...,
+        get_scrollback_request : typing.Optional[global___GetScrollbackRequest] = ...,
         ) -> None: ...
-    def HasField(self, field_name: typing_extensions.Literal[u"activate_request",b"activate_request",u"close_request",b"close_request",u"color_preset_request",b"color_preset_request",u"create_tab_request",b"create_tab_request",u"focus_request",b"focus_request",u"get_broadcast_domains_request",b"get_broadcast_domains_request",u"get_buffer_request",b"get_buffer_request",u"get_profile_property_request",b"get_profile_property_request",u"get_prompt_request",b"get_prompt_request",u"get_property_request",b"get_property_request",u"id",b"id",u"inject_request",b"inject_request",u"invoke_function_request",b"invoke_function_request",u"list_profiles_request",b"list_profiles_request",u"list_prompts_request",b"list_prompts_request",u"list_sessions_request",b"list_sessions_request",u"menu_item_request",b"menu_item_request",u"notification_request",b"notification_request",u"preferences_request",b"preferences_request",u"register_tool_request",b"register_tool_request",u"reorder_tabs_request",b"reorder_tabs_request",u"restart_session_request",b"restart_session_request",u"saved_arrangement_request",b"saved_arrangement_request",u"selection_request",b"selection_request",u"send_text_request",b"send_text_request",u"server_originated_rpc_result_request",b"server_originated_rpc_result_request",u"set_broadcast_domains_request",b"set_broadcast_domains_request",u"set_profile_property_request",b"set_profile_property_request",u"set_property_request",b"set_property_request",u"set_tab_layout_request",b"set_tab_layout_request",u"split_pane_request",b"split_pane_request",u"status_bar_component_request",b"status_bar_component_request",u"submessage",b"submessage",u"tmux_request",b"tmux_request",u"transaction_request",b"transaction_request",u"variable_request",b"variable_request"]) -> builtins.bool: ...
-    def ClearField(self, field_name: typing_extensions.Literal[u"activate_request",b"activate_request",u"close_request",b"close_request",u"color_preset_request",b"color_preset_request",u"create_tab_request",b"create_tab_request",u"focus_request",b"focus_request",u"get_broadcast_domains_request",b"get_broadcast_domains_request",u"get_buffer_request",b"get_buffer_request",u"get_profile_property_request",b"get_profile_property_request",u"get_prompt_request",b"get_prompt_request",u"get_property_request",b"get_property_request",u"id",b"id",u"inject_request",b"inject_request",u"invoke_function_request",b"invoke_function_request",u"list_profiles_request",b"list_profiles_request",u"list_prompts_request",b"list_prompts_request",u"list_sessions_request",b"list_sessions_request",u"menu_item_request",b"menu_item_request",u"notification_request",b"notification_request",u"preferences_request",b"preferences_request",u"register_tool_request",b"register_tool_request",u"reorder_tabs_request",b"reorder_tabs_request",u"restart_session_request",b"restart_session_request",u"saved_arrangement_request",b"saved_arrangement_request",u"selection_request",b"selection_request",u"send_text_request",b"send_text_request",u"server_originated_rpc_result_request",b"server_originated_rpc_result_request",u"set_broadcast_domains_request",b"set_broadcast_domains_request",u"set_profile_property_request",b"set_profile_property_request",u"set_property_request",b"set_property_request",u"set_tab_layout_request",b"set_tab_layout_request",u"split_pane_request",b"split_pane_request",u"status_bar_component_request",b"status_bar_component_request",u"submessage",b"submessage",u"tmux_request",b"tmux_request",u"transaction_request",b"transaction_request",u"variable_request",b"variable_request"]) -> None: ...
-    def WhichOneof(self, oneof_group: typing_extensions.Literal[u"submessage",b"submessage"]) -> typing_extensions.Literal["get_buffer_request","get_prompt_request","transaction_request","notification_request","register_tool_request","set_profile_property_request","list_sessions_request","send_text_request","create_tab_request","split_pane_request","get_profile_property_request","set_property_request","get_property_request","inject_request","activate_request","variable_request","saved_arrangement_request","focus_request","list_profiles_request","server_originated_rpc_result_request","restart_session_request","menu_item_request","set_tab_layout_request","get_broadcast_domains_request","tmux_request","reorder_tabs_request","preferences_request","color_preset_request","selection_request","status_bar_component_request","set_broadcast_domains_request","close_request","invoke_function_request","list_prompts_request"]: ...
+    def HasField(self, field_name: typing_extensions.Literal[u"activate_request",b"activate_request",u"close_request",b"close_request",u"color_preset_request",b"color_preset_request",u"create_tab_request",b"create_tab_request",u"focus_request",b"focus_request",u"get_broadcast_domains_request",b"get_broadcast_domains_request",u"get_buffer_request",b"get_buffer_request",u"get_profile_property_request",b"get_profile_property_request",u"get_prompt_request",b"get_prompt_request",u"get_property_request",b"get_property_request",u"get_scrollback_request",b"get_scrollback_request",u"id",b"id",u"inject_request",b"inject_request",u"invoke_function_request",b"invoke_function_request",u"list_profiles_request",b"list_profiles_request",u"list_prompts_request",b"list_prompts_request",u"list_sessions_request",b"list_sessions_request",u"menu_item_request",b"menu_item_request",u"notification_request",b"notification_request",u"preferences_request",b"preferences_request",u"register_tool_request",b"register_tool_request",u"reorder_tabs_request",b"reorder_tabs_request",u"restart_session_request",b"restart_session_request",u"saved_arrangement_request",b"saved_arrangement_request",u"selection_request",b"selection_request",u"send_text_request",b"send_text_request",u"server_originated_rpc_result_request",b"server_originated_rpc_result_request",u"set_broadcast_domains_request",b"set_broadcast_domains_request",u"set_profile_property_request",b"set_profile_property_request",u"set_property_request",b"set_property_request",u"set_tab_layout_request",b"set_tab_layout_request",u"split_pane_request",b"split_pane_request",u"status_bar_component_request",b"status_bar_component_request",u"submessage",b"submessage",u"tmux_request",b"tmux_request",u"transaction_request",b"transaction_request",u"variable_request",b"variable_request"]) -> builtins.bool: ...
+    def ClearField(self, field_name: typing_extensions.Literal[u"activate_request",b"activate_request",u"close_request",b"close_request",u"color_preset_request",b"color_preset_request",u"create_tab_request",b"create_tab_request",u"focus_request",b"focus_request",u"get_broadcast_domains_request",b"get_broadcast_domains_request",u"get_buffer_request",b"get_buffer_request",u"get_profile_property_request",b"get_profile_property_request",u"get_prompt_request",b"get_prompt_request",u"get_property_request",b"get_property_request",u"get_scrollback_request",b"get_scrollback_request",u"id",b"id",u"inject_request",b"inject_request",u"invoke_function_request",b"invoke_function_request",u"list_profiles_request",b"list_profiles_request",u"list_prompts_request",b"list_prompts_request",u"list_sessions_request",b"list_sessions_request",u"menu_item_request",b"menu_item_request",u"notification_request",b"notification_request",u"preferences_request",b"preferences_request",u"register_tool_request",b"register_tool_request",u"reorder_tabs_request",b"reorder_tabs_request",u"restart_session_request",b"restart_session_request",u"saved_arrangement_request",b"saved_arrangement_request",u"selection_request",b"selection_request",u"send_text_request",b"send_text_request",u"server_originated_rpc_result_request",b"server_originated_rpc_result_request",u"set_broadcast_domains_request",b"set_broadcast_domains_request",u"set_profile_property_request",b"set_profile_property_request",u"set_property_request",b"set_property_request",u"set_tab_layout_request",b"set_tab_layout_request",u"split_pane_request",b"split_pane_request",u"status_bar_component_request",b"status_bar_component_request",u"submessage",b"submessage",u"tmux_request",b"tmux_request",u"transaction_request",b"transaction_request",u"variable_request",b"variable_request"]) -> None: ...
+    def WhichOneof(self, oneof_group: typing_extensions.Literal[u"submessage",b"submessage"]) -> typing_extensions.Literal["get_buffer_request","get_prompt_request","transaction_request","notification_request","register_tool_request","set_profile_property_request","list_sessions_request","send_text_request","create_tab_request","split_pane_request","get_profile_property_request","set_property_request","get_property_request","inject_request","activate_request","variable_request","saved_arrangement_request","focus_request","list_profiles_request","server_originated_rpc_result_request","restart_session_request","menu_item_request","set_tab_layout_request","get_broadcast_domains_request","tmux_request","reorder_tabs_request","preferences_request","color_preset_request","selection_request","status_bar_component_request","set_broadcast_domains_request","close_request","invoke_function_request","list_prompts_request","get_scrollback_request"]: ...
 global___ClientOriginatedMessage = ClientOriginatedMessage
 
 class ServerOriginatedMessage(google.protobuf.message.Message):
@@ -330,6 +335,7 @@ class ServerOriginatedMessage(google.protobuf.message.Message):
     CLOSE_RESPONSE_FIELD_NUMBER: builtins.int
     INVOKE_FUNCTION_RESPONSE_FIELD_NUMBER: builtins.int
     LIST_PROMPTS_RESPONSE_FIELD_NUMBER: builtins.int
+    GET_SCROLLBACK_RESPONSE_FIELD_NUMBER: builtins.int
     NOTIFICATION_FIELD_NUMBER: builtins.int
     id: builtins.int = ...
     error: typing.Text = ...
@@ -436,6 +442,9 @@ class ServerOriginatedMessage(google.protobuf.message.Message):
     @property
     def list_prompts_response(self) -> global___ListPromptsResponse: ...
 
+    @property
+    def get_scrollback_response(self) -> global___GetScrollbackResponse: ...
+
     @property
     def notification(self) -> global___Notification: ...
 
@@ -477,11 +486,12 @@ class ServerOriginatedMessage(google.protobuf.message.Message):
         close_response : typing.Optional[global___CloseResponse] = ...,
         invoke_function_response : typing.Optional[global___InvokeFunctionResponse] = ...,
         list_prompts_response : typing.Optional[global___ListPromptsResponse] = ...,
+        get_scrollback_response : typing.Optional[global___GetScrollbackResponse] = ...,
         notification : typing.Optional[global___Notification] = ...,
         ) -> None: ...
-    def HasField(self, field_name: typing_extensions.Literal[u"activate_response",b"activate_response",u"close_response",b"close_response",u"color_preset_response",b"color_preset_response",u"create_tab_response",b"create_tab_response",u"error",b"error",u"focus_response",b"focus_response",u"get_broadcast_domains_response",b"get_broadcast_domains_response",u"get_buffer_response",b"get_buffer_response",u"get_profile_property_response",b"get_profile_property_response",u"get_prompt_response",b"get_prompt_response",u"get_property_response",b"get_property_response",u"id",b"id",u"inject_response",b"inject_response",u"invoke_function_response",b"invoke_function_response",u"list_profiles_response",b"list_profiles_response",u"list_prompts_response",b"list_prompts_response",u"list_sessions_response",b"list_sessions_response",u"menu_item_response",b"menu_item_response",u"notification",b"notification",u"notification_response",b"notification_response",u"preferences_response",b"preferences_response",u"register_tool_response",b"register_tool_response",u"reorder_tabs_response",b"reorder_tabs_response",u"restart_session_response",b"restart_session_response",u"saved_arrangement_response",b"saved_arrangement_response",u"selection_response",b"selection_response",u"send_text_response",b"send_text_response",u"server_originated_rpc_result_response",b"server_originated_rpc_result_response",u"set_broadcast_domains_response",b"set_broadcast_domains_response",u"set_profile_property_response",b"set_profile_property_response",u"set_property_response",b"set_property_response",u"set_tab_layout_response",b"set_tab_layout_response",u"split_pane_response",b"split_pane_response",u"status_bar_component_response",b"status_bar_component_response",u"submessage",b"submessage",u"tmux_response",b"tmux_response",u"transaction_response",b"transaction_response",u"variable_response",b"variable_response"]) -> builtins.bool: ...
-    def ClearField(self, field_name: typing_extensions.Literal[u"activate_response",b"activate_response",u"close_response",b"close_response",u"color_preset_response",b"color_preset_response",u"create_tab_response",b"create_tab_response",u"error",b"error",u"focus_response",b"focus_response",u"get_broadcast_domains_response",b"get_broadcast_domains_response",u"get_buffer_response",b"get_buffer_response",u"get_profile_property_response",b"get_profile_property_response",u"get_prompt_response",b"get_prompt_response",u"get_property_response",b"get_property_response",u"id",b"id",u"inject_response",b"inject_response",u"invoke_function_response",b"invoke_function_response",u"list_profiles_response",b"list_profiles_response",u"list_prompts_response",b"list_prompts_response",u"list_sessions_response",b"list_sessions_response",u"menu_item_response",b"menu_item_response",u"notification",b"notification",u"notification_response",b"notification_response",u"preferences_response",b"preferences_response",u"register_tool_response",b"register_tool_response",u"reorder_tabs_response",b"reorder_tabs_response",u"restart_session_response",b"restart_session_response",u"saved_arrangement_response",b"saved_arrangement_response",u"selection_response",b"selection_response",u"send_text_response",b"send_text_response",u"server_originated_rpc_result_response",b"server_originated_rpc_result_response",u"set_broadcast_domains_response",b"set_broadcast_domains_response",u"set_profile_property_response",b"set_profile_property_response",u"set_property_response",b"set_property_response",u"set_tab_layout_response",b"set_tab_layout_response",u"split_pane_response",b"split_pane_response",u"status_bar_component_response",b"status_bar_component_response",u"submessage",b"submessage",u"tmux_response",b"tmux_response",u"transaction_response",b"transaction_response",u"variable_response",b"variable_response"]) -> None: ...
-    def WhichOneof(self, oneof_group: typing_extensions.Literal[u"submessage",b"submessage"]) -> typing_extensions.Literal["error","get_buffer_response","get_prompt_response","transaction_response","notification_response","register_tool_response","set_profile_property_response","list_sessions_response","send_text_response","create_tab_response","split_pane_response","get_profile_property_response","set_property_response","get_property_response","inject_response","activate_response","variable_response","saved_arrangement_response","focus_response","list_profiles_response","server_originated_rpc_result_response","restart_session_response","menu_item_response","set_tab_layout_response","get_broadcast_domains_response","tmux_response","reorder_tabs_response","preferences_response","color_preset_response","selection_response","status_bar_component_response","set_broadcast_domains_response","close_response","invoke_function_response","list_prompts_response","notification"]: ...
+    def HasField(self, field_name: typing_extensions.Literal[u"activate_response",b"activate_response",u"close_response",b"close_response",u"color_preset_response",b"color_preset_response",u"create_tab_response",b"create_tab_response",u"error",b"error",u"focus_response",b"focus_response",u"get_broadcast_domains_response",b"get_broadcast_domains_response",u"get_buffer_response",b"get_buffer_response",u"get_profile_property_response",b"get_profile_property_response",u"get_prompt_response",b"get_prompt_response",u"get_property_response",b"get_property_response",u"get_scrollback_response",b"get_scrollback_response",u"id",b"id",u"inject_response",b"inject_response",u"invoke_function_response",b"invoke_function_response",u"list_profiles_response",b"list_profiles_response",u"list_prompts_response",b"list_prompts_response",u"list_sessions_response",b"list_sessions_response",u"menu_item_response",b"menu_item_response",u"notification",b"notification",u"notification_response",b"notification_response",u"preferences_response",b"preferences_response",u"register_tool_response",b"register_tool_response",u"reorder_tabs_response",b"reorder_tabs_response",u"restart_session_response",b"restart_session_response",u"saved_arrangement_response",b"saved_arrangement_response",u"selection_response",b"selection_response",u"send_text_response",b"send_text_response",u"server_originated_rpc_result_response",b"server_originated_rpc_result_response",u"set_broadcast_domains_response",b"set_broadcast_domains_response",u"set_profile_property_response",b"set_profile_property_response",u"set_property_response",b"set_property_response",u"set_tab_layout_response",b"set_tab_layout_response",u"split_pane_response",b"split_pane_response",u"status_bar_component_response",b"status_bar_component_response",u"submessage",b"submessage",u"tmux_response",b"tmux_response",u"transaction_response",b"transaction_response",u"variable_response",b"variable_response"]) -> builtins.bool: ...
+    def ClearField(self, field_name: typing_extensions.Literal[u"activate_response",b"activate_response",u"close_response",b"close_response",u"color_preset_response",b"color_preset_response",u"create_tab_response",b"create_tab_response",u"error",b"error",u"focus_response",b"focus_response",u"get_broadcast_domains_response",b"get_broadcast_domains_response",u"get_buffer_response",b"get_buffer_response",u"get_profile_property_response",b"get_profile_property_response",u"get_prompt_response",b"get_prompt_response",u"get_property_response",b"get_property_response",u"get_scrollback_response",b"get_scrollback_response",u"id",b"id",u"inject_response",b"inject_response",u"invoke_function_response",b"invoke_function_response",u"list_profiles_response",b"list_profiles_response",u"list_prompts_response",b"list_prompts_response",u"list_sessions_response",b"list_sessions_response",u"menu_item_response",b"menu_item_response",u"notification",b"notification",u"notification_response",b"notification_response",u"preferences_response",b"preferences_response",u"register_tool_response",b"register_tool_response",u"reorder_tabs_response",b"reorder_tabs_response",u"restart_session_response",b"restart_session_response",u"saved_arrangement_response",b"saved_arrangement_response",u"selection_response",b"selection_response",u"send_text_response",b"send_text_response",u"server_originated_rpc_result_response",b"server_originated_rpc_result_response",u"set_broadcast_domains_response",b"set_broadcast_domains_response",u"set_profile_property_response",b"set_profile_property_response",u"set_property_response",b"set_property_response",u"set_tab_layout_response",b"set_tab_layout_response",u"split_pane_response",b"split_pane_response",u"status_bar_component_response",b"status_bar_component_response",u"submessage",b"submessage",u"tmux_response",b"tmux_response",u"transaction_response",b"transaction_response",u"variable_response",b"variable_response"]) -> None: ...
+    def WhichOneof(self, oneof_group: typing_extensions.Literal[u"submessage",b"submessage"]) -> typing_extensions.Literal["error","get_buffer_response","get_prompt_response","transaction_response","notification_response","register_tool_response","set_profile_property_response","list_sessions_response","send_text_response","create_tab_response","split_pane_response","get_profile_property_response","set_property_response","get_property_response","inject_response","activate_response","variable_response","saved_arrangement_response","focus_response","list_profiles_response","server_originated_rpc_result_response","restart_session_response","menu_item_response","set_tab_layout_response","get_broadcast_domains_response","tmux_response","reorder_tabs_response","preferences_response","color_preset_response","selection_response","status_bar_component_response","set_broadcast_domains_response","close_response","invoke_function_response","list_prompts_response","get_scrollback_response","notification"]: ...
 global___ServerOriginatedMessage = ServerOriginatedMessage
 
 class InvokeFunctionRequest(google.protobuf.message.Message):
@@ -3120,6 +3130,66 @@ class GetBufferResponse(google.protobuf.message.Message):
     def ClearField(self, field_name: typing_extensions.Literal[u"contents",b"contents",u"cursor",b"cursor",u"num_lines_above_screen",b"num_lines_above_screen",u"range",b"range",u"status",b"status",u"windowed_coord_range",b"windowed_coord_range"]) -> None: ...
 global___GetBufferResponse = GetBufferResponse
 
+class GetScrollbackRequest(google.protobuf.message.Message):
+    DESCRIPTOR: google.protobuf.descriptor.Descriptor = ...
+    SESSION_FIELD_NUMBER: builtins.int
+    CURSOR_FIELD_NUMBER: builtins.int
+    MAX_LINES_FIELD_NUMBER: builtins.int
+    TEXT_ONLY_FIELD_NUMBER: builtins.int
+    session: typing.Text = ...
+    cursor: builtins.int = ...
+    max_lines: builtins.int = ...
+    text_only: builtins.bool = ...
+
+    def __init__(self,
+        *,
+        session : typing.Optional[typing.Text] = ...,
+        cursor : typing.Optional[builtins.int] = ...,
+        max_lines : typing.Optional[builtins.int] = ...,
+        text_only : typing.Optional[builtins.bool] = ...,
+        ) -> None: ...
+    def HasField(self, field_name: typing_extensions.Literal[u"cursor",b"cursor",u"max_lines",b"max_lines",u"session",b"session",u"text_only",b"text_only"]) -> builtins.bool: ...
+    def ClearField(self, field_name: typing_extensions.Literal[u"cursor",b"cursor",u"max_lines",b"max_lines",u"session",b"session",u"text_only",b"text_only"]) -> None: ...
+global___GetScrollbackRequest = GetScrollbackRequest
+
+class GetScrollbackResponse(google.protobuf.message.Message):
+    DESCRIPTOR: google.protobuf.descriptor.Descriptor = ...
+    class _Status(google.protobuf.internal.enum_type_wrapper._EnumTypeWrapper[Status.V], builtins.type):
+        DESCRIPTOR: google.protobuf.descriptor.EnumDescriptor = ...
+        OK = GetScrollbackResponse.Status.V(0)
+        SESSION_NOT_FOUND = GetScrollbackResponse.Status.V(1)
+        INVALID_CURSOR = GetScrollbackResponse.Status.V(2)
+    class Status(metaclass=_Status):
+        V = typing.NewType('V', builtins.int)
+    OK = GetScrollbackResponse.Status.V(0)
+    SESSION_NOT_FOUND = GetScrollbackResponse.Status.V(1)
+    INVALID_CURSOR = GetScrollbackResponse.Status.V(2)
+
+    STATUS_FIELD_NUMBER: builtins.int
+    CONTENTS_FIELD_NUMBER: builtins.int
+    FIRST_LINE_FIELD_NUMBER: builtins.int
+    NEXT_CURSOR_FIELD_NUMBER: builtins.int
+    END_OF_BUFFER_FIELD_NUMBER: builtins.int
+    status: global___GetScrollbackResponse.Status.V = ...
+    first_line: builtins.int = ...
+    next_cursor: builtins.int = ...
+    end_of_buffer: builtins.int = ...
+
+    @property
+    def contents(self) -> google.protobuf.internal.containers.RepeatedCompositeFieldContainer[global___LineContents]: ...
+
+    def __init__(self,
+        *,
+        status : typing.Optional[global___GetScrollbackResponse.Status.V] = ...,
+        contents : typing.Optional[typing.Iterable[global___LineContents]] = ...,
+        first_line : typing.Optional[builtins.int] = ...,
+        next_cursor : typing.Optional[builtins.int] = ...,
+        end_of_buffer : typing.Optional[builtins.int] = ...,
+        ) -> None: ...
+    def HasField(self, field_name: typing_extensions.Literal[u"end_of_buffer",b"end_of_buffer",u"first_line",b"first_line",u"next_cursor",b"next_cursor",u"status",b"status"]) -> builtins.bool: ...
+    def ClearField(self, field_name: typing_extensions.Literal[u"contents",b"contents",u"end_of_buffer",b"end_of_buffer",u"first_line",b"first_line",u"next_cursor",b"next_cursor",u"status",b"status"]) -> None: ...
+global___GetScrollbackResponse = GetScrollbackResponse
+
 class GetPromptRequest(google.protobuf.message.Message):
     DESCRIPTOR: google.protobuf.descriptor.Descriptor = ...
     SESSION_FIELD_NUMBER: builtins.int
@@ -226,6 +226,34 @@ async def async_get_screen_contents(
     return await _async_call(connection, request)
 
 
+async def async_get_scrollback(
+        connection,
+        session,
+        cursor=None,
+        max_lines=None,
+        text_only=False):
+    """
+    Gets one chunk of a session's history and screen contents.
+
+    connection: A connected iterm2.Connection.
+    session: Session ID
+    cursor: Absolute line number to start at, or None for the oldest line.
+    max_lines: Maximum number of lines to return, or None for the default.
+    text_only: If True, omit per-cell code point counts.
+
+    Returns: iterm2.api_pb2.ServerOriginatedMessage
+    """
+    request = _alloc_request()
+    request.get_scrollback_request.session = session
+    if cursor is not None:
+        request.get_scrollback_request.cursor = cursor
+    if max_lines is not None:
+        request.get_scrollback_request.max_lines = max_lines
+    if text_only:
+        request.get_scrollback_request.text_only = True
+    return await _async_call(connection, request)
+
+
 async def async_get_prompt(
     connection, session=None, prompt_id=None):
     """
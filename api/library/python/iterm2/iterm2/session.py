@@ -409,6 +409,66 @@ class Session:
             iterm2.api_pb2.GetBufferResponse.Status.Name(
                 response.get_buffer_response.status))
 
+    async def async_export_scrollback(
+            self,
+            first_line: typing.Optional[int] = None,
+            lines_per_chunk: typing.Optional[int] = None,
+            text_only: bool = False) -> typing.AsyncIterator[
+                typing.List['iterm2.screen.LineContents']]:
+        """
+        Streams the session's history and screen contents in chunks.
+
+        Unlike `async_get_contents`, this does not need a transaction and is
+        suitable for very long histories. Each request reads from a snapshot
+        taken when it arrives, so the session may keep producing output
+        while you export. Lines that scroll out of history between chunks are
+        skipped.
+
+        :param first_line: The absolute line number to begin at, or `None`
+            to begin with the oldest available line.
+        :param lines_per_chunk: The maximum number of lines to fetch per
+            request, or `None` to let iTerm2 pick.
+        :param text_only: If `True`, only the text and continuation of each
+            line are fetched. This is faster but methods like `string_at`
+            will not work.
+        :returns: An async iterator of lists of
+            :class:`iterm2.screen.LineContents`.
+
+        :throws: :class:`~iterm2.rpc.RPCException` if something goes wrong.
+
+        .. code-block:: python
+          :caption: Example that writes a session's history to a file.
+
+          with open("history.txt", "w") as f:
+              async for lines in session.async_export_scrollback(
+                      text_only=True):
+                  for line in lines:
+                      f.write(line.string)
+                      if line.hard_eol:
+                          f.write("\\n")
+
+        """
+        cursor = first_line
+        while True:
+            response = await iterm2.rpc.async_get_scrollback(
+                self.connection,
+                self.session_id,
+                cursor,
+                lines_per_chunk,
+                text_only)
+            # pylint: disable=no-member
+            status = response.get_scrollback_response.status
+            if status != iterm2.api_pb2.GetScrollbackResponse.Status.Value(
+                    "OK"):
+                raise iterm2.rpc.RPCException(
+                    iterm2.api_pb2.GetScrollbackResponse.Status.Name(status))
+            chunk = response.get_scrollback_response
+            if chunk.contents:
+                yield list(map(iterm2.screen.LineContents, chunk.contents))
+            if chunk.next_cursor >= chunk.end_of_buffer:
+                return
+            cursor = chunk.next_cursor
+
     def get_screen_streamer(
             self, want_contents: bool = True) -> iterm2.screen.ScreenStreamer:
         """
@@ -0,0 +1,278 @@
+//
+//  LineBlockTest.m
+//  iTerm2XCTests
+//
+//  Created by George Nachman on 10/18/26.
+//
+
+#import <XCTest/XCTest.h>
+#import "iTermEncoderAdapter.h"
+#import "iTermGraphEncoder.h"
+#import "LineBlock.h"
+#import "LineBuffer.h"
+
+static void LineBlockTestFillLine(screen_char_t *line, int length, int seed) {
+    for (int i = 0; i < length; i++) {
+        memset(&line[i], 0, sizeof(line[i]));
+        line[i].code = 'a' + (i + seed) % 26;
+        line[i].foregroundColor = seed % 8;
+        line[i].bold = (i % 3) == 0;
+    }
+}
+
+static screen_char_t LineBlockTestContinuation(int seed) {
+    screen_char_t continuation = { 0 };
+    continuation.code = (seed % 2) ? EOL_SOFT : EOL_HARD;
+    continuation.backgroundColor = seed % 256;
+    continuation.bgGreen = (seed * 7) % 256;
+    continuation.bgBlue = (seed * 13) % 256;
+    continuation.backgroundColorMode = ColorModeAlternate;
+    return continuation;
+}
+
+@interface LineBlockTest : XCTestCase
+@end
+
+@implementation LineBlockTest
+
+- (LineBlock *)blockWithLines:(int)numberOfLines partial:(BOOL)partial {
+    LineBlock *block = [[[LineBlock alloc] initWithRawBufferSize:numberOfLines * 100] autorelease];
+    screen_char_t line[100];
+    for (int i = 0; i < numberOfLines; i++) {
+        const int length = (i * 37) % 100;
+        LineBlockTestFillLine(line, length, i);
+        XCTAssertTrue([block appendLine:line
+                                 length:length
+                                partial:partial && i + 1 == numberOfLines
+                                  width:80
+                              timestamp:1000000 + i * 0.25
+                           continuation:LineBlockTestContinuation(i)]);
+    }
+    return block;
+}
+
+- (LineBuffer *)lineBufferWithLines:(int)numberOfLines {
+    LineBuffer *lineBuffer = [[[LineBuffer alloc] initWithBlockSize:8192] autorelease];
+    screen_char_t line[100];
+    for (int i = 0; i < numberOfLines; i++) {
+        const int length = (i * 37) % 100;
+        LineBlockTestFillLine(line, length, i);
+        [lineBuffer appendLine:line
+                        length:length
+                       partial:NO
+                         width:80
+                     timestamp:1000000 + i
+                  continuation:LineBlockTestContinuation(i)];
+    }
+    return lineBuffer;
+}
+
+// Decodes packed data the way restoring a saved block does. The keys are those of
+// -packedDictionaryCompressed:.
+- (LineBlock *)blockWithPackedData:(NSData *)data guid:(NSString *)guid {
+    return [LineBlock blockWithDictionary:@{ @"Packed Data": data, @"GUID": guid }];
+}
+
+// Replaces the little-endian int32 at |offset|. The header is laid out as in
+// iTermPackedLineBlockHeader, and the cumulative line lengths follow it.
+- (NSData *)packedData:(NSData *)data withInt:(int32_t)value atOffset:(NSUInteger)offset {
+    NSMutableData *result = [[data mutableCopy] autorelease];
+    const int32_t littleEndian = OSSwapHostToLittleInt32(value);
+    [result replaceBytesInRange:NSMakeRange(offset, sizeof(littleEndian)) withBytes:&littleEndian];
+    return result;
+}
+
+- (void)testPackedRoundTripMatchesDictionary {
+    for (NSNumber *compress in @[ @NO, @YES ]) {
+        LineBlock *block = [self blockWithLines:200 partial:YES];
+        block.mayHaveDoubleWidthCharacter = YES;
+        int charsDropped = 0;
+        [block dropLines:3 withWidth:80 chars:&charsDropped];
+
+        NSData *packed = [block packedDataCompressed:compress.boolValue];
+        LineBlock *decoded = [self blockWithPackedData:packed guid:block.stringUniqueIdentifier];
+        XCTAssertNotNil(decoded);
+        XCTAssertEqualObjects(decoded.dictionary, block.dictionary, @"compress=%@", compress);
+        XCTAssertEqual([decoded getNumLinesWithWrapWidth:80], [block getNumLinesWithWrapWidth:80]);
+    }
+}
+
+- (void)testPackedDataIsSmallerThanDictionary {
+    LineBlock *block = [self blockWithLines:1000 partial:NO];
+    NSData *legacy = [NSPropertyListSerialization dataWithPropertyList:block.dictionary
+                                                                format:NSPropertyListBinaryFormat_v1_0
+                                                               options:0
+                                                                 error:nil];
+    NSData *packed = [block packedDataCompressed:NO];
+    NSData *compressed = [block packedDataCompressed:YES];
+    XCTAssertLessThan(packed.length, legacy.length);
+    XCTAssertLessThan(compressed.length, packed.length);
+}
+
+- (void)testEmptyBlockRoundTrips {
+    LineBlock *block = [[[LineBlock alloc] initWithRawBufferSize:10] autorelease];
+    LineBlock *decoded = [self blockWithPackedData:[block packedDataCompressed:YES]
+                                                   guid:block.stringUniqueIdentifier];
+    XCTAssertEqualObjects(decoded.dictionary, block.dictionary);
+    XCTAssertTrue(decoded.isEmpty);
+}
+
+- (void)testBlockWithDictionaryAcceptsBothFormats {
+    LineBlock *block = [self blockWithLines:50 partial:NO];
+    LineBlock *fromLegacy = [LineBlock blockWithDictionary:block.dictionary];
+    LineBlock *fromPacked = [LineBlock blockWithDictionary:[block packedDictionaryCompressed:YES]];
+    XCTAssertEqualObjects(fromLegacy.dictionary, block.dictionary);
+    XCTAssertEqualObjects(fromPacked.dictionary, block.dictionary);
+}
+
+- (void)testCorruptPackedDataIsRejected {
+    LineBlock *block = [self blockWithLines:50 partial:NO];
+    for (NSNumber *compress in @[ @NO, @YES ]) {
+        NSData *packed = [block packedDataCompressed:compress.boolValue];
+        XCTAssertNil([self blockWithPackedData:[packed subdataWithRange:NSMakeRange(0, packed.length - 1)]
+                                               guid:@"guid"]);
+        XCTAssertNil([self blockWithPackedData:[packed subdataWithRange:NSMakeRange(0, 8)]
+                                               guid:@"guid"]);
+
+        NSMutableData *badMagic = [[packed mutableCopy] autorelease];
+        ((unsigned char *)badMagic.mutableBytes)[0] ^= 0xff;
+        XCTAssertNil([self blockWithPackedData:badMagic guid:@"guid"]);
+    }
+}
+
+- (void)testInconsistentPackedHeaderIsRejected {
+    LineBlock *block = [self blockWithLines:50 partial:NO];
+    NSData *packed = [block packedDataCompressed:NO];
+    XCTAssertNotNil([self blockWithPackedData:packed guid:@"guid"]);
+
+    // Offsets into iTermPackedLineBlockHeader.
+    const NSUInteger startOffsetOffset = 16;
+    const NSUInteger firstEntryOffset = 20;
+    const NSUInteger headerLength = 36;
+
+    XCTAssertNil([self blockWithPackedData:[self packedData:packed withInt:51 atOffset:firstEntryOffset] guid:@"guid"]);
+    XCTAssertNil([self blockWithPackedData:[self packedData:packed withInt:-1 atOffset:firstEntryOffset] guid:@"guid"]);
+    XCTAssertNil([self blockWithPackedData:[self packedData:packed withInt:block.rawSpaceUsed + 1 atOffset:startOffsetOffset]
+                                      guid:@"guid"]);
+
+    // Cumulative line lengths that run backwards or past the end of the raw buffer.
+    XCTAssertNil([self blockWithPackedData:[self packedData:packed withInt:block.rawSpaceUsed atOffset:headerLength]
+                                      guid:@"guid"]);
+    XCTAssertNil([self blockWithPackedData:[self packedData:packed
+                                                    withInt:block.rawSpaceUsed + 1
+                                                   atOffset:headerLength + 49 * sizeof(int32_t)]
+                                      guid:@"guid"]);
+}
+
+// A copy shares characters with its original, so appending to either must not change the other.
+- (void)testCopyIsIndependentOfOriginal {
+    LineBlock *original = [self blockWithLines:10 partial:NO];
+    NSDictionary *before = original.dictionary;
+    LineBlock *copy = [[original copy] autorelease];
+
+    screen_char_t line[20];
+    LineBlockTestFillLine(line, 20, 100);
+    XCTAssertTrue([original appendLine:line length:20 partial:NO width:80 timestamp:0 continuation:LineBlockTestContinuation(0)]);
+    LineBlockTestFillLine(line, 20, 200);
+    XCTAssertTrue([copy appendLine:line length:20 partial:NO width:80 timestamp:0 continuation:LineBlockTestContinuation(0)]);
+
+    XCTAssertEqual([original numRawLines], 11);
+    XCTAssertEqual([copy numRawLines], 11);
+    XCTAssertEqual([original rawLine:10][0].code, 'a' + 100 % 26);
+    XCTAssertEqual([copy rawLine:10][0].code, 'a' + 200 % 26);
+    for (int i = 0; i < 10; i++) {
+        XCTAssertEqual([original getRawLineLength:i], [copy getRawLineLength:i]);
+        XCTAssertEqual(memcmp([original rawLine:i], [copy rawLine:i], [copy getRawLineLength:i] * sizeof(screen_char_t)), 0);
+    }
+
+    // The copy outlives a resized original.
+    LineBlock *secondCopy = [original copy];
+    [original shrinkToFit];
+    [original removeLastWrappedLines:1 width:80];
+    XCTAssertEqual([secondCopy numRawLines], 11);
+    [secondCopy removeLastWrappedLines:1 width:80];
+    XCTAssertEqualObjects(secondCopy.dictionary[@"Raw Buffer"], before[@"Raw Buffer"]);
+    [secondCopy release];
+}
+
+- (void)testLineBufferRoundTrip {
+    LineBuffer *lineBuffer = [self lineBufferWithLines:5000];
+    iTermMutableDictionaryEncoderAdapter *encoder = [iTermMutableDictionaryEncoderAdapter encoder];
+    [lineBuffer encode:encoder maxLines:1000000];
+    LineBuffer *decoded = [[[LineBuffer alloc] initWithDictionary:encoder.mutableDictionary] autorelease];
+    XCTAssertNotNil(decoded);
+    XCTAssertEqual([decoded numLinesWithWidth:80], [lineBuffer numLinesWithWidth:80]);
+    XCTAssertEqualObjects([decoded compactLineDumpWithWidth:80 andContinuationMarks:YES],
+                          [lineBuffer compactLineDumpWithWidth:80 andContinuationMarks:YES]);
+}
+
+// Blocks are decoded concurrently, so check that a buffer with many blocks keeps them in order.
+- (void)testLineBufferWithManyBlocksRoundTrip {
+    LineBuffer *lineBuffer = [self lineBufferWithLines:50000];
+    iTermMutableDictionaryEncoderAdapter *encoder = [iTermMutableDictionaryEncoderAdapter encoder];
+    [lineBuffer encode:encoder maxLines:1000000];
+    XCTAssertGreaterThan([encoder.mutableDictionary[@"Blocks"] count], 50);
+
+    LineBuffer *decoded = [[[LineBuffer alloc] initWithDictionary:encoder.mutableDictionary] autorelease];
+    XCTAssertNotNil(decoded);
+    XCTAssertEqualObjects([decoded compactLineDumpWithWidth:80 andContinuationMarks:YES],
+                          [lineBuffer compactLineDumpWithWidth:80 andContinuationMarks:YES]);
+}
+
+#pragma mark - Performance
+
+// Encodes 100k lines of history into a graph encoder the way a restorable state save does.
+- (void)measureSaveWithEncoding:(NSDictionary *(^)(LineBlock *block))encoding {
+    NSMutableArray<LineBlock *> *blocks = [NSMutableArray array];
+    for (int i = 0; i < 100; i++) {
+        [blocks addObject:[self blockWithLines:1000 partial:NO]];
+    }
+    [self measureBlock:^{
+        iTermGraphEncoder *graphEncoder = [[[iTermGraphEncoder alloc] initWithKey:@""
+                                                                       identifier:@""
+                                                                       generation:1] autorelease];
+        iTermGraphEncoderAdapter *adapter =
+            [[[iTermGraphEncoderAdapter alloc] initWithGraphEncoder:graphEncoder] autorelease];
+        for (LineBlock *block in blocks) {
+            [adapter encodeDictionaryWithKey:block.stringUniqueIdentifier
+                                  generation:block.generation
+                                       block:^BOOL(id<iTermEncoderAdapter> subencoder) {
+                [subencoder mergeDictionary:encoding(block)];
+                return YES;
+            }];
+        }
+    }];
+}
+
+- (void)testSaveDictionaryFormatPerformance {
+    [self measureSaveWithEncoding:^NSDictionary *(LineBlock *block) {
+        return block.dictionary;
+    }];
+}
+
+- (void)testSavePackedFormatPerformance {
+    [self measureSaveWithEncoding:^NSDictionary *(LineBlock *block) {
+        return [block packedDictionaryCompressed:NO];
+    }];
+}
+
+- (void)testSaveCompressedPackedFormatPerformance {
+    [self measureSaveWithEncoding:^NSDictionary *(LineBlock *block) {
+        return [block packedDictionaryCompressed:YES];
+    }];
+}
+
+// Decodes 50k lines of history the way restoring a session does.
+- (void)testRestoreLineBufferPerformance {
+    LineBuffer *lineBuffer = [self lineBufferWithLines:50000];
+    iTermMutableDictionaryEncoderAdapter *encoder = [iTermMutableDictionaryEncoderAdapter encoder];
+    [lineBuffer encode:encoder maxLines:1000000];
+    NSDictionary *dictionary = encoder.mutableDictionary;
+    [self measureBlock:^{
+        LineBuffer *decoded = [[LineBuffer alloc] initWithDictionary:dictionary];
+        XCTAssertNotNil(decoded);
+        [decoded release];
+    }];
+}
+
+@end
@@ -148,6 +148,9 @@ static NSString *const kDiffScriptPath = @"/tmp/diffs";
 - (void)textViewWillNeedUpdateForBlink {
 }
 
+- (void)textViewDidDrawWithDuration:(NSTimeInterval)duration {
+}
+
 - (BOOL)textViewWindowUsesTransparency {
     return NO;
 }
@@ -511,6 +514,15 @@ static NSString *const kDiffScriptPath = @"/tmp/diffs";
     return nil;
 }
 
+- (NSInteger)generationForLine:(int)y {
+    return 0;
+}
+
+- (LineBuffer *)newSnapshotOfLinesInRange:(NSRange)range linesBefore:(out int *)linesBeforePtr {
+    *linesBeforePtr = 0;
+    return [[LineBuffer alloc] init];
+}
+
 - (int)numberOfScrollbackLines {
     return 0;
 }
@@ -2498,6 +2510,79 @@ static NSString *const kDiffScriptPath = @"/tmp/diffs";
     return _buffer;
 }
 
+#pragma mark - Attributed string cache
+
+// A screenful of text in a variety of colors and styles.
+- (NSString *)attributedStringCacheTestInputWithSize:(VT100GridSize)size {
+    NSMutableString *input = [NSMutableString string];
+    for (int y = 0; y < size.height; y++) {
+        for (int x = 0; x < size.width; x += 8) {
+            [input appendString:[self sgrSequence:31 + (x / 8 + y) % 7]];
+            if ((x / 8) % 3 == 0) {
+                [input appendString:[self sgrSequence:1]];
+            }
+            [input appendString:[@"abc def " substringToIndex:MIN(8, size.width - x)]];
+            [input appendString:[self sgrSequence:0]];
+        }
+        if (y + 1 < size.height) {
+            [input appendString:@"\r\n"];
+        }
+    }
+    return input;
+}
+
+- (void)testRedrawingUnchangedLinesUsesAttributedStringCache {
+    const VT100GridSize size = VT100GridSizeMake(40, 10);
+    PTYSession *session = [self sessionWithProfileOverrides:@{} size:size];
+    [session synchronousReadTask:[self attributedStringCacheTestInputWithSize:size]];
+    iTermTextDrawingHelper *drawingHelper = session.textview.drawingHelper;
+
+    NSData *first = [[session.view snapshot] rawPixelsInRGBColorSpace];
+    const NSInteger misses = drawingHelper.attributedStringCacheMisses;
+    const NSInteger hits = drawingHelper.attributedStringCacheHits;
+    XCTAssertGreaterThan(misses, 0);
+
+    NSData *second = [[session.view snapshot] rawPixelsInRGBColorSpace];
+    XCTAssertEqual(drawingHelper.attributedStringCacheMisses, misses);
+    XCTAssertGreaterThan(drawingHelper.attributedStringCacheHits, hits);
+    XCTAssertEqualObjects(first, second);
+
+    // Changing one line rebuilds only that line's runs.
+    [session synchronousReadTask:@"\r\nxyz"];
+    const NSInteger hitsBeforeChange = drawingHelper.attributedStringCacheHits;
+    [session.view snapshot];
+    XCTAssertGreaterThan(drawingHelper.attributedStringCacheMisses, misses);
+    XCTAssertGreaterThan(drawingHelper.attributedStringCacheHits, hitsBeforeChange);
+}
+
+- (void)testAttributedStringCacheDistinguishesColors {
+    const VT100GridSize size = VT100GridSizeMake(10, 2);
+    PTYSession *session = [self sessionWithProfileOverrides:@{} size:size];
+    [session synchronousReadTask:[NSString stringWithFormat:@"%@abc%@\r\n%@abc%@",
+                                  [self sgrSequence:31], [self sgrSequence:0],
+                                  [self sgrSequence:32], [self sgrSequence:0]]];
+    iTermTextDrawingHelper *drawingHelper = session.textview.drawingHelper;
+    [session.view snapshot];
+
+    // Both lines have the same characters, but they must not share attributed strings.
+    XCTAssertEqual(drawingHelper.attributedStringCacheHits, 0);
+    XCTAssertGreaterThanOrEqual(drawingHelper.attributedStringCacheMisses, 2);
+}
+
+// Redraws a full screen of colored text that doesn't change between frames.
+- (void)testRedrawUnchangedScreenPerformance {
+    const VT100GridSize size = VT100GridSizeMake(160, 50);
+    PTYSession *session = [self sessionWithProfileOverrides:@{} size:size];
+    [session synchronousReadTask:[self attributedStringCacheTestInputWithSize:size]];
+    [session.view snapshot];
+
+    [self measureBlock:^{
+        for (int i = 0; i < 10; i++) {
+            [session.view snapshot];
+        }
+    }];
+}
+
 #pragma mark - Test selection
 
 - (void)testSelectedTextVeryBasic {
@@ -2876,6 +2876,17 @@ NSLog(@"Known bug: %s should be true, but %s is.", #expressionThatShouldBeTrue,
     XCTAssert([screen shouldSendContentsChangedNotification]);
 }
 
+- (void)testSnapshotOfEmptyRangeAtEndIsEmpty {
+    VT100Screen *screen = [self fiveByFourScreenWithFourLinesOneWrappedAndOneInLineBuffer];
+    const int numberOfLines = [screen numberOfScrollbackLines] + [screen.currentGrid numberOfLinesUsed];
+    int linesBefore = -1;
+    LineBuffer *snapshot = [screen newSnapshotOfLinesInRange:NSMakeRange(numberOfLines, 0)
+                                                 linesBefore:&linesBefore];
+    XCTAssertEqual(linesBefore, numberOfLines);
+    XCTAssertEqual([snapshot numLinesWithWidth:screen.width], 0);
+    [snapshot release];
+}
+
 #pragma mark - Test for VT100TerminalDelegate methods
 
 - (void)testPrinting {
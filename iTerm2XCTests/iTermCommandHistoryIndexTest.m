@@ -0,0 +1,168 @@
+//
+//  iTermCommandHistoryIndexTest.m
+//  iTerm2XCTests
+//
+//  Created by George Nachman on 10/18/26.
+//
+
+#import <XCTest/XCTest.h>
+#import "iTermCommandHistoryIndex.h"
+
+@interface iTermFakeCommandHistoryEntry : NSObject<iTermCommandHistoryIndexable>
+@property(nonatomic, copy) NSString *command;
+@property(nonatomic, retain) NSNumber *numberOfUses;
+@property(nonatomic, retain) NSNumber *timeOfLastUse;
+@end
+
+@implementation iTermFakeCommandHistoryEntry
+
++ (instancetype)entryWithCommand:(NSString *)command uses:(NSInteger)uses time:(NSTimeInterval)time {
+    iTermFakeCommandHistoryEntry *entry = [[[self alloc] init] autorelease];
+    entry.command = command;
+    entry.numberOfUses = @(uses);
+    entry.timeOfLastUse = @(time);
+    return entry;
+}
+
+- (void)dealloc {
+    [_command release];
+    [_numberOfUses release];
+    [_timeOfLastUse release];
+    [super dealloc];
+}
+
+@end
+
+@interface iTermCommandHistoryIndexTest : XCTestCase
+@end
+
+@implementation iTermCommandHistoryIndexTest
+
+// The index should give the same answer as checking every entry and sorting the matches.
+- (NSArray<iTermFakeCommandHistoryEntry *> *)slowEntriesWithPrefix:(NSString *)prefix
+                                                          inEntries:(NSArray<iTermFakeCommandHistoryEntry *> *)entries
+                                                       maximumCount:(NSUInteger)maximumCount {
+    NSMutableArray<iTermFakeCommandHistoryEntry *> *matches = [NSMutableArray array];
+    for (iTermFakeCommandHistoryEntry *entry in entries) {
+        if (prefix.length == 0 ||
+            [entry.command rangeOfString:prefix options:(NSAnchoredSearch | NSCaseInsensitiveSearch)].location == 0) {
+            [matches addObject:entry];
+        }
+    }
+    [matches sortUsingComparator:^NSComparisonResult(iTermFakeCommandHistoryEntry *lhs,
+                                                     iTermFakeCommandHistoryEntry *rhs) {
+        if (lhs.numberOfUses.integerValue != rhs.numberOfUses.integerValue) {
+            return lhs.numberOfUses.integerValue > rhs.numberOfUses.integerValue ? NSOrderedAscending : NSOrderedDescending;
+        }
+        return [rhs.timeOfLastUse compare:lhs.timeOfLastUse];
+    }];
+    return [matches subarrayWithRange:NSMakeRange(0, MIN(maximumCount, matches.count))];
+}
+
+- (NSArray<iTermFakeCommandHistoryEntry *> *)randomEntries:(int)count {
+    NSArray<NSString *> *words = @[ @"git", @"Git", @"ls", @"make", @"cd", @"ssh", @"grep", @"vim" ];
+    NSMutableArray<iTermFakeCommandHistoryEntry *> *entries = [NSMutableArray array];
+    for (int i = 0; i < count; i++) {
+        NSString *command = [NSString stringWithFormat:@"%@ %d", words[i % words.count], i];
+        // Times are unique so the expected order is fully determined.
+        [entries addObject:[iTermFakeCommandHistoryEntry entryWithCommand:command
+                                                                     uses:arc4random_uniform(5) + 1
+                                                                     time:i]];
+    }
+    return entries;
+}
+
+- (void)assertIndex:(iTermCommandHistoryIndex *)index
+      matchesEntries:(NSArray<iTermFakeCommandHistoryEntry *> *)entries {
+    for (NSString *prefix in @[ @"", @"g", @"G", @"GIT", @"git 1", @"make 2", @"v", @"vim 7", @"x", @"lsx" ]) {
+        for (NSNumber *maximumCount in @[ @1, @3, @200, @100000 ]) {
+            XCTAssertEqualObjects([index entriesWithPrefix:prefix maximumCount:maximumCount.integerValue],
+                                  [self slowEntriesWithPrefix:prefix
+                                                    inEntries:entries
+                                                 maximumCount:maximumCount.integerValue],
+                                  @"prefix=%@ maximumCount=%@", prefix, maximumCount);
+        }
+    }
+}
+
+- (void)testPrefixSearchMatchesLinearScan {
+    NSArray<iTermFakeCommandHistoryEntry *> *entries = [self randomEntries:2000];
+    iTermCommandHistoryIndex *index = [[[iTermCommandHistoryIndex alloc] initWithEntries:entries] autorelease];
+    XCTAssertEqual(index.count, entries.count);
+    [self assertIndex:index matchesEntries:entries];
+}
+
+- (void)testUpdatesKeepIndexCurrent {
+    NSMutableArray<iTermFakeCommandHistoryEntry *> *entries = [[[self randomEntries:500] mutableCopy] autorelease];
+    iTermCommandHistoryIndex *index = [[[iTermCommandHistoryIndex alloc] initWithEntries:entries] autorelease];
+    NSTimeInterval now = entries.count;
+    for (int i = 0; i < 300; i++) {
+        if (i % 3 == 0) {
+            iTermFakeCommandHistoryEntry *entry =
+                [iTermFakeCommandHistoryEntry entryWithCommand:[NSString stringWithFormat:@"new command %d", i]
+                                                          uses:1
+                                                          time:now++];
+            [entries addObject:entry];
+            [index updateEntry:entry];
+        } else {
+            iTermFakeCommandHistoryEntry *entry = entries[arc4random_uniform((uint32_t)entries.count)];
+            entry.numberOfUses = @(entry.numberOfUses.integerValue + 1);
+            entry.timeOfLastUse = @(now++);
+            [index updateEntry:entry];
+        }
+    }
+    XCTAssertEqual(index.count, entries.count);
+    [self assertIndex:index matchesEntries:entries];
+    XCTAssertEqual([index entriesWithPrefix:@"NEW COMMAND" maximumCount:1000].count, 100);
+}
+
+- (void)testEntryWithCommandIsCaseSensitive {
+    iTermFakeCommandHistoryEntry *lower = [iTermFakeCommandHistoryEntry entryWithCommand:@"git status" uses:1 time:1];
+    iTermFakeCommandHistoryEntry *upper = [iTermFakeCommandHistoryEntry entryWithCommand:@"GIT STATUS" uses:1 time:2];
+    iTermCommandHistoryIndex *index = [[[iTermCommandHistoryIndex alloc] initWithEntries:@[ lower, upper ]] autorelease];
+    XCTAssertEqual([index entryWithCommand:@"git status"], lower);
+    XCTAssertEqual([index entryWithCommand:@"GIT STATUS"], upper);
+    XCTAssertNil([index entryWithCommand:@"Git Status"]);
+    XCTAssertNil([index entryWithCommand:@"git"]);
+    NSArray *expected = @[ upper, lower ];
+    XCTAssertEqualObjects([index entriesWithPrefix:@"Git S" maximumCount:10], expected);
+}
+
+#pragma mark - Performance
+
+- (void)testPrefixSearchWithHalfMillionEntriesPerformance {
+    NSArray<iTermFakeCommandHistoryEntry *> *entries = [self randomEntries:500000];
+    iTermCommandHistoryIndex *index = [[[iTermCommandHistoryIndex alloc] initWithEntries:entries] autorelease];
+    NSArray<NSString *> *prefixes = @[ @"", @"g", @"gi", @"git", @"git ", @"git 1", @"git 12", @"git 123",
+                                       @"m", @"make 4", @"ssh 99", @"vim 4999", @"nothing" ];
+    [self measureBlock:^{
+        for (int i = 0; i < 100; i++) {
+            for (NSString *prefix in prefixes) {
+                [index entriesWithPrefix:prefix maximumCount:200];
+            }
+        }
+    }];
+}
+
+- (void)testAddCommandWithHalfMillionEntriesPerformance {
+    NSArray<iTermFakeCommandHistoryEntry *> *entries = [self randomEntries:500000];
+    iTermCommandHistoryIndex *index = [[[iTermCommandHistoryIndex alloc] initWithEntries:entries] autorelease];
+    __block NSTimeInterval now = entries.count;
+    [self measureBlock:^{
+        for (int i = 0; i < 1000; i++) {
+            iTermFakeCommandHistoryEntry *entry = entries[arc4random_uniform((uint32_t)entries.count)];
+            entry.numberOfUses = @(entry.numberOfUses.integerValue + 1);
+            entry.timeOfLastUse = @(now++);
+            [index updateEntry:entry];
+        }
+    }];
+}
+
+- (void)testBuildIndexWithHalfMillionEntriesPerformance {
+    NSArray<iTermFakeCommandHistoryEntry *> *entries = [self randomEntries:500000];
+    [self measureBlock:^{
+        [[[iTermCommandHistoryIndex alloc] initWithEntries:entries] release];
+    }];
+}
+
+@end
@@ -0,0 +1,158 @@
+//
+//  iTermCompiledExpressionTest.m
+//  iTerm2XCTests
+//
+//  Created by George Nachman on 10/18/26.
+//
+
+#import <XCTest/XCTest.h>
+#import "iTermCompiledExpression.h"
+#import "iTermExpressionEvaluator.h"
+#import "iTermExpressionParser.h"
+#import "iTermObject.h"
+#import "iTermParsedExpression.h"
+#import "iTermVariableScope.h"
+
+@interface iTermCompiledExpressionTest : XCTestCase<iTermObject>
+@end
+
+@implementation iTermCompiledExpressionTest {
+    iTermVariableScope *_scope;
+}
+
+- (void)setUp {
+    [super setUp];
+    iTermVariables *vars = [[[iTermVariables alloc] initWithContext:iTermVariablesSuggestionContextSession owner:self] autorelease];
+    _scope = [[iTermVariableScope alloc] init];
+    [_scope addVariables:vars toScopeNamed:nil];
+    [_scope setValue:@"user" forVariableNamed:@"user"];
+    [_scope setValue:@"host" forVariableNamed:@"hostname"];
+    [_scope setValue:@"/" forVariableNamed:@"path"];
+    [_scope setValue:@3 forVariableNamed:@"jobs"];
+    [_scope setValue:@[ @"a", @2 ] forVariableNamed:@"list"];
+}
+
+- (void)tearDown {
+    [_scope release];
+    [super tearDown];
+}
+
+// Evaluates by walking an AST parsed with _scope, as was done before compilation.
+- (void)assertCompiledEvaluationOf:(NSString *)string
+                              mode:(iTermCompiledExpressionMode)mode
+                            strict:(BOOL)strict
+                matchesParsedValue:(id)expectedValue {
+    iTermCompiledExpression *compiledExpression = [iTermCompiledExpression compiledExpressionWithString:string
+                                                                                                   mode:mode];
+    XCTAssertTrue(compiledExpression.isCompiled, @"%@", string);
+    iTermParsedExpression *parsedExpression = [compiledExpression parsedExpressionWithScope:_scope strict:strict];
+    iTermExpressionEvaluator *evaluator = [[[iTermExpressionEvaluator alloc] initWithParsedExpression:parsedExpression
+                                                                                           invocation:string
+                                                                                                scope:_scope] autorelease];
+    NSError *error = nil;
+    id value = [compiledExpression valueWithScope:_scope strict:strict escapingFunction:nil error:&error];
+
+    XCTAssertEqualObjects(evaluator.value, expectedValue, @"%@", string);
+    XCTAssertEqualObjects(value, evaluator.value, @"%@", string);
+    XCTAssertEqualObjects(error.localizedDescription, evaluator.error.localizedDescription, @"%@", string);
+}
+
+- (void)testInterpolatedStringsMatchParser {
+    const iTermCompiledExpressionMode mode = iTermCompiledExpressionModeInterpolatedString;
+    [self assertCompiledEvaluationOf:@"\\(user)@\\(hostname): \\(path)" mode:mode strict:YES matchesParsedValue:@"user@host: /"];
+    [self assertCompiledEvaluationOf:@"literal only" mode:mode strict:YES matchesParsedValue:@"literal only"];
+    [self assertCompiledEvaluationOf:@"\\(jobs) jobs" mode:mode strict:YES matchesParsedValue:@"3 jobs"];
+    [self assertCompiledEvaluationOf:@"\\(list)" mode:mode strict:YES matchesParsedValue:@"[a, 2]"];
+    [self assertCompiledEvaluationOf:@"<\\(list[1])>" mode:mode strict:YES matchesParsedValue:@"<2>"];
+    [self assertCompiledEvaluationOf:@"<\\(missing?)>" mode:mode strict:YES matchesParsedValue:@"<>"];
+    [self assertCompiledEvaluationOf:@"<\\(null)>" mode:mode strict:YES matchesParsedValue:@"<>"];
+    [self assertCompiledEvaluationOf:@"\\(\"quoted\") \\(42)" mode:mode strict:YES matchesParsedValue:@"quoted 42"];
+}
+
+- (void)testErrorsMatchParser {
+    const iTermCompiledExpressionMode mode = iTermCompiledExpressionModeInterpolatedString;
+    [self assertCompiledEvaluationOf:@"\\(missing)" mode:mode strict:YES matchesParsedValue:nil];
+    [self assertCompiledEvaluationOf:@"\\(list[5])" mode:mode strict:YES matchesParsedValue:nil];
+    [self assertCompiledEvaluationOf:@"\\(path[0])" mode:mode strict:YES matchesParsedValue:nil];
+}
+
+- (void)testExpressionsMatchParser {
+    const iTermCompiledExpressionMode mode = iTermCompiledExpressionModeExpression;
+    [self assertCompiledEvaluationOf:@"jobs" mode:mode strict:NO matchesParsedValue:@3];
+    [self assertCompiledEvaluationOf:@"list" mode:mode strict:NO matchesParsedValue:(@[ @"a", @2 ])];
+    [self assertCompiledEvaluationOf:@"missing?" mode:mode strict:NO matchesParsedValue:nil];
+    [self assertCompiledEvaluationOf:@"\"\\(user) at \\(hostname)\"" mode:mode strict:NO matchesParsedValue:@"user at host"];
+}
+
+- (void)testScopesShareCompiledExpression {
+    NSString *const title = @"\\(user) on \\(hostname)";
+    const NSUInteger hitsBefore = iTermCompiledExpression.numberOfCacheHits;
+    iTermCompiledExpression *first = [iTermCompiledExpression compiledExpressionWithString:title
+                                                                                      mode:iTermCompiledExpressionModeInterpolatedString];
+    iTermCompiledExpression *second = [iTermCompiledExpression compiledExpressionWithString:title
+                                                                                       mode:iTermCompiledExpressionModeInterpolatedString];
+    XCTAssertEqual(first, second);
+    XCTAssertEqual(iTermCompiledExpression.numberOfCacheHits, hitsBefore + 1);
+    XCTAssertGreaterThan(iTermCompiledExpression.cacheHitRate, 0);
+
+    // Same text in another mode is a different expression.
+    iTermCompiledExpression *expression = [iTermCompiledExpression compiledExpressionWithString:title
+                                                                                           mode:iTermCompiledExpressionModeExpression];
+    XCTAssertNotEqual(first, expression);
+
+    iTermVariableScope *otherScope = [[[iTermVariableScope alloc] init] autorelease];
+    iTermVariables *vars = [[[iTermVariables alloc] initWithContext:iTermVariablesSuggestionContextSession owner:self] autorelease];
+    [otherScope addVariables:vars toScopeNamed:nil];
+    [otherScope setValue:@"root" forVariableNamed:@"user"];
+    [otherScope setValue:@"server" forVariableNamed:@"hostname"];
+    XCTAssertEqualObjects([first valueWithScope:_scope strict:YES escapingFunction:nil error:nil], @"user on host");
+    XCTAssertEqualObjects([first valueWithScope:otherScope strict:YES escapingFunction:nil error:nil], @"root on server");
+}
+
+- (void)testFunctionCallsAreNotCompiled {
+    iTermCompiledExpression *compiledExpression =
+        [iTermCompiledExpression compiledExpressionWithString:@"\\(user) \\(f(x: path))"
+                                                         mode:iTermCompiledExpressionModeInterpolatedString];
+    XCTAssertFalse(compiledExpression.isCompiled);
+    XCTAssertTrue(compiledExpression.containsFunctionCall);
+}
+
+- (void)testEscapingFunctionSkipsStrings {
+    iTermCompiledExpression *compiledExpression =
+        [iTermCompiledExpression compiledExpressionWithString:@"\\(user):\\(jobs)"
+                                                         mode:iTermCompiledExpressionModeInterpolatedString];
+    id value = [compiledExpression valueWithScope:_scope
+                                           strict:YES
+                                 escapingFunction:^NSString *(NSString *string) {
+                                     return [NSString stringWithFormat:@"'%@'", string];
+                                 }
+                                            error:nil];
+    XCTAssertEqualObjects(value, @"user:'3'");
+}
+
+#pragma mark - Performance
+
+- (void)testEvaluatingTitleMillionTimesPerformance {
+    iTermCompiledExpression *compiledExpression =
+        [iTermCompiledExpression compiledExpressionWithString:@"\\(user)@\\(hostname): \\(path)"
+                                                         mode:iTermCompiledExpressionModeInterpolatedString];
+    [self measureBlock:^{
+        for (int i = 0; i < 1000000; i++) {
+            @autoreleasepool {
+                [compiledExpression valueWithScope:_scope strict:NO escapingFunction:nil error:nil];
+            }
+        }
+    }];
+}
+
+#pragma mark - iTermObject
+
+- (iTermBuiltInFunctions *)objectMethodRegistry {
+    return nil;
+}
+
+- (iTermVariableScope *)objectScope {
+    return nil;
+}
+
+@end
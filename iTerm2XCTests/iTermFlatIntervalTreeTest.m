@@ -0,0 +1,271 @@
+//
+//  iTermFlatIntervalTreeTest.m
+//  iTerm2XCTests
+//
+//  Created by George Nachman on 10/18/26.
+//
+
+#import <XCTest/XCTest.h>
+#import "IntervalTree.h"
+#import "iTermFlatIntervalTree.h"
+
+@interface iTermFlatIntervalTreeTestObject : NSObject <IntervalTreeObject>
+@end
+
+@implementation iTermFlatIntervalTreeTestObject
+@synthesize entry;
+
+- (instancetype)initWithDictionary:(NSDictionary *)dict {
+    return [self init];
+}
+
+- (NSDictionary *)dictionaryValue {
+    return @{};
+}
+
+@end
+
+// Resembles marks in a session with a lot of history: one per prompt, each a line long.
+static const NSInteger iTermFlatIntervalTreeTestNumberOfMarks = 100000;
+static const long long iTermFlatIntervalTreeTestLineWidth = 81;
+static const long long iTermFlatIntervalTreeTestLinesPerMark = 3;
+
+@interface iTermFlatIntervalTreeTest : XCTestCase
+@end
+
+@implementation iTermFlatIntervalTreeTest {
+    iTermFlatIntervalTree *_tree;
+    unsigned int _seed;
+}
+
+- (void)setUp {
+    [super setUp];
+    _tree = [[[iTermFlatIntervalTree alloc] init] autorelease];
+    _seed = 0;
+}
+
+- (NSArray *)objectsInRangeWithLocation:(long long)location length:(long long)length {
+    NSMutableArray *result = [NSMutableArray array];
+    [_tree enumerateObjectsInRangeWithLocation:location
+                                        length:length
+                                    usingBlock:^(id object, long long location, long long length, BOOL *stop) {
+                                        [result addObject:object];
+                                    }];
+    return result;
+}
+
+- (void)testEmptyTree {
+    XCTAssertEqual(_tree.count, 0);
+    XCTAssertEqualObjects([self objectsInRangeWithLocation:0 length:256], @[]);
+}
+
+- (void)testOverlappingIntervals {
+    NSObject *first = [[[NSObject alloc] init] autorelease];
+    NSObject *second = [[[NSObject alloc] init] autorelease];
+    NSObject *third = [[[NSObject alloc] init] autorelease];
+    [_tree addObject:first withLocation:10 length:10];
+    [_tree addObject:second withLocation:15 length:1];
+    [_tree addObject:third withLocation:20 length:5];
+    [_tree sanityCheck];
+
+    XCTAssertEqualObjects([self objectsInRangeWithLocation:0 length:10], @[]);
+    XCTAssertEqualObjects([self objectsInRangeWithLocation:0 length:11], @[ first ]);
+    XCTAssertEqualObjects([self objectsInRangeWithLocation:15 length:6], (@[ first, second, third ]));
+    XCTAssertEqualObjects([self objectsInRangeWithLocation:20 length:100], @[ third ]);
+    XCTAssertEqualObjects([self objectsInRangeWithLocation:25 length:100], @[]);
+}
+
+- (void)testObjectsAtSameLocationKeepInsertionOrder {
+    NSObject *first = [[[NSObject alloc] init] autorelease];
+    NSObject *second = [[[NSObject alloc] init] autorelease];
+    [_tree addObject:first withLocation:5 length:3];
+    [_tree addObject:second withLocation:5 length:1];
+    XCTAssertEqualObjects([self objectsInRangeWithLocation:0 length:10], (@[ first, second ]));
+
+    XCTAssertTrue([_tree removeObject:first]);
+    XCTAssertFalse([_tree removeObject:first]);
+    XCTAssertFalse([_tree containsObject:first]);
+    XCTAssertEqualObjects([self objectsInRangeWithLocation:0 length:10], @[ second ]);
+    [_tree sanityCheck];
+}
+
+- (void)testEmptyIntervalIsOnlyFoundByEnumeratingAll {
+    NSObject *object = [[[NSObject alloc] init] autorelease];
+    [_tree addObject:object withLocation:5 length:0];
+    XCTAssertEqualObjects([self objectsInRangeWithLocation:0 length:10], @[]);
+
+    NSMutableArray *all = [NSMutableArray array];
+    [_tree enumerateAllObjectsUsingBlock:^(id object, long long location, long long length, BOOL *stop) {
+        [all addObject:object];
+    }];
+    XCTAssertEqualObjects(all, @[ object ]);
+}
+
+- (void)testShiftLocations {
+    NSObject *object = [[[NSObject alloc] init] autorelease];
+    [_tree addObject:object withLocation:100 length:10];
+    [_tree shiftLocationsBy:-90];
+
+    long long location = 0;
+    long long length = 0;
+    XCTAssertTrue([_tree getLocation:&location length:&length ofObject:object]);
+    XCTAssertEqual(location, 10);
+    XCTAssertEqual(length, 10);
+    XCTAssertEqualObjects([self objectsInRangeWithLocation:0 length:11], @[ object ]);
+    XCTAssertEqualObjects([self objectsInRangeWithLocation:100 length:10], @[]);
+
+    // Removal after a shift still finds the object.
+    XCTAssertTrue([_tree removeObject:object]);
+    XCTAssertEqual(_tree.count, 0);
+}
+
+- (void)testRemoveObjectsWithLimitAtOrBefore {
+    NSMutableArray *objects = [NSMutableArray array];
+    for (int i = 0; i < 10; i++) {
+        NSObject *object = [[[NSObject alloc] init] autorelease];
+        [objects addObject:object];
+        [_tree addObject:object withLocation:i * 10 length:5];
+    }
+    // Starts early but extends past the limit, so it must survive.
+    NSObject *longLived = [[[NSObject alloc] init] autorelease];
+    [_tree addObject:longLived withLocation:0 length:1000];
+
+    NSMutableArray *removed = [NSMutableArray array];
+    [_tree removeObjectsWithLimitAtOrBefore:45 usingBlock:^(id object) {
+        [removed addObject:object];
+    }];
+    XCTAssertEqualObjects(removed, [objects subarrayWithRange:NSMakeRange(0, 5)]);
+    XCTAssertEqual(_tree.count, 6);
+    XCTAssertTrue([_tree containsObject:longLived]);
+    XCTAssertTrue([_tree containsObject:objects[5]]);
+    [_tree sanityCheck];
+}
+
+- (void)testRandomOperationsMatchIntervalTree {
+    IntervalTree *reference = [[[IntervalTree alloc] init] autorelease];
+    NSMutableArray<iTermFlatIntervalTreeTestObject *> *live = [NSMutableArray array];
+    for (int i = 0; i < 2000; i++) {
+        const int action = rand_r(&_seed) % 3;
+        if (action == 0 || live.count == 0) {
+            iTermFlatIntervalTreeTestObject *object = [[[iTermFlatIntervalTreeTestObject alloc] init] autorelease];
+            const long long location = rand_r(&_seed) % 255;
+            const long long length = rand_r(&_seed) % (256 - location);
+            [reference addObject:object withInterval:[Interval intervalWithLocation:location length:length]];
+            [_tree addObject:object withLocation:location length:length];
+            [live addObject:object];
+        } else if (action == 1) {
+            const NSUInteger index = rand_r(&_seed) % live.count;
+            [reference removeObject:live[index]];
+            XCTAssertTrue([_tree removeObject:live[index]]);
+            [live removeObjectAtIndex:index];
+        } else {
+            const long long location = rand_r(&_seed) % 255;
+            const long long length = rand_r(&_seed) % (256 - location);
+            NSSet *expected = [NSSet setWithArray:[reference objectsInInterval:[Interval intervalWithLocation:location length:length]]];
+            NSSet *actual = [NSSet setWithArray:[self objectsInRangeWithLocation:location length:length]];
+            XCTAssertEqualObjects(actual, expected);
+        }
+        XCTAssertEqual(_tree.count, reference.count);
+    }
+    [_tree sanityCheck];
+}
+
+#pragma mark - Performance
+
+- (void)addMarksToIntervalTree:(IntervalTree *)intervalTree
+                  flatTree:(iTermFlatIntervalTree *)flatTree {
+    for (NSInteger i = 0; i < iTermFlatIntervalTreeTestNumberOfMarks; i++) {
+        iTermFlatIntervalTreeTestObject *object = [[iTermFlatIntervalTreeTestObject alloc] init];
+        const long long location = i * iTermFlatIntervalTreeTestLinesPerMark * iTermFlatIntervalTreeTestLineWidth;
+        [intervalTree addObject:object
+                   withInterval:[Interval intervalWithLocation:location length:iTermFlatIntervalTreeTestLineWidth]];
+        [flatTree addObject:object withLocation:location length:iTermFlatIntervalTreeTestLineWidth];
+        [object release];
+    }
+}
+
+// Queries a screenful of lines at each of 1000 scroll positions, as drawing does.
+- (NSInteger)numberOfVisibleRegions {
+    return 1000;
+}
+
+- (long long)locationOfVisibleRegion:(NSInteger)i {
+    const long long totalLines = iTermFlatIntervalTreeTestNumberOfMarks * iTermFlatIntervalTreeTestLinesPerMark;
+    return (i * totalLines / self.numberOfVisibleRegions) * iTermFlatIntervalTreeTestLineWidth;
+}
+
+- (void)testIntervalTreeQueryPerformance {
+    IntervalTree *intervalTree = [[[IntervalTree alloc] init] autorelease];
+    [self addMarksToIntervalTree:intervalTree flatTree:nil];
+    [self measureBlock:^{
+        for (NSInteger i = 0; i < self.numberOfVisibleRegions; i++) {
+            @autoreleasepool {
+                Interval *interval = [Interval intervalWithLocation:[self locationOfVisibleRegion:i]
+                                                             length:50 * iTermFlatIntervalTreeTestLineWidth];
+                for (id object in [intervalTree objectsInInterval:interval]) {
+                    (void)object;
+                }
+            }
+        }
+    }];
+}
+
+- (void)testFlatIntervalTreeQueryPerformance {
+    [self addMarksToIntervalTree:nil flatTree:_tree];
+    [self measureBlock:^{
+        for (NSInteger i = 0; i < self.numberOfVisibleRegions; i++) {
+            [_tree enumerateObjectsInRangeWithLocation:[self locationOfVisibleRegion:i]
+                                                length:50 * iTermFlatIntervalTreeTestLineWidth
+                                            usingBlock:^(id object, long long location, long long length, BOOL *stop) {
+                                                (void)object;
+                                            }];
+        }
+    }];
+}
+
+- (void)testIntervalTreeInsertionPerformance {
+    [self measureBlock:^{
+        IntervalTree *intervalTree = [[IntervalTree alloc] init];
+        [self addMarksToIntervalTree:intervalTree flatTree:nil];
+        [intervalTree release];
+    }];
+}
+
+- (void)testFlatIntervalTreeInsertionPerformance {
+    [self measureBlock:^{
+        iTermFlatIntervalTree *flatTree = [[iTermFlatIntervalTree alloc] init];
+        [self addMarksToIntervalTree:nil flatTree:flatTree];
+        [flatTree release];
+    }];
+}
+
+// Drops the oldest half of the marks, as happens when scrollback overflows.
+- (void)testIntervalTreeRemoveOverflowPerformance {
+    [self measureMetrics:[[self class] defaultPerformanceMetrics] automaticallyStartMeasuring:NO forBlock:^{
+        IntervalTree *intervalTree = [[IntervalTree alloc] init];
+        [self addMarksToIntervalTree:intervalTree flatTree:nil];
+        const long long limit = [self locationOfVisibleRegion:self.numberOfVisibleRegions / 2];
+        [self startMeasuring];
+        for (id<IntervalTreeObject> object in [intervalTree objectsInInterval:[Interval intervalWithLocation:0 length:limit]]) {
+            if (object.entry.interval.limit <= limit) {
+                [intervalTree removeObject:object];
+            }
+        }
+        [self stopMeasuring];
+        [intervalTree release];
+    }];
+}
+
+- (void)testFlatIntervalTreeRemoveOverflowPerformance {
+    [self measureMetrics:[[self class] defaultPerformanceMetrics] automaticallyStartMeasuring:NO forBlock:^{
+        iTermFlatIntervalTree *flatTree = [[iTermFlatIntervalTree alloc] init];
+        [self addMarksToIntervalTree:nil flatTree:flatTree];
+        const long long limit = [self locationOfVisibleRegion:self.numberOfVisibleRegions / 2];
+        [self startMeasuring];
+        [flatTree removeObjectsWithLimitAtOrBefore:limit usingBlock:nil];
+        [self stopMeasuring];
+        [flatTree release];
+    }];
+}
+
+@end
@@ -0,0 +1,185 @@
+//
+//  iTermFrameSchedulerTest.m
+//  iTerm2XCTests
+//
+//  Created by George Nachman on 10/18/26.
+//
+
+#import <XCTest/XCTest.h>
+#import "iTermFrameScheduler.h"
+
+static const NSTimeInterval iTermFrameSchedulerTestTick = 1.0 / 60.0;
+
+@interface iTermFrameSchedulerTest : XCTestCase
+@end
+
+@implementation iTermFrameSchedulerTest {
+    iTermFrameSchedulerPolicy *_policy;
+}
+
+- (void)setUp {
+    [super setUp];
+    _policy = [[iTermFrameSchedulerPolicy alloc] initWithTickInterval:iTermFrameSchedulerTestTick];
+}
+
+- (void)tearDown {
+    [_policy release];
+    [super tearDown];
+}
+
+- (NSArray *)clients:(NSInteger)count {
+    NSMutableArray *clients = [NSMutableArray array];
+    for (NSInteger i = 0; i < count; i++) {
+        [clients addObject:[[[NSObject alloc] init] autorelease]];
+    }
+    return clients;
+}
+
+// Runs the virtual clock from `start` to `end`, waking only when the policy asks to. Returns the
+// number of wakeups. If updates is nonnull, it counts each client's updates.
+- (NSInteger)simulateFrom:(NSTimeInterval)start
+                       to:(NSTimeInterval)end
+                  updates:(NSCountedSet *)updates {
+    NSInteger wakeups = 0;
+    NSTimeInterval now = start;
+    while (YES) {
+        const NSTimeInterval wakeup = [_policy nextWakeupAfter:now];
+        if (wakeup >= end) {
+            return wakeups;
+        }
+        NSArray *due = [_policy clientsDueAt:wakeup];
+        XCTAssertGreaterThan(due.count, 0);
+        if (due.count == 0) {
+            return wakeups;
+        }
+        wakeups++;
+        for (id client in due) {
+            [updates addObject:client];
+        }
+        now = wakeup;
+    }
+}
+
+- (void)testClientsWithTheSamePeriodShareWakeups {
+    NSArray *clients = [self clients:40];
+    [clients enumerateObjectsUsingBlock:^(id client, NSUInteger i, BOOL *stop) {
+        // Register at scattered times, as sessions would.
+        [_policy setPeriod:1 priority:iTermFrameSchedulerPriorityBackground forClient:client now:i * 0.037];
+    }];
+    NSCountedSet *updates = [[[NSCountedSet alloc] init] autorelease];
+    const NSInteger wakeups = [self simulateFrom:2 to:12 updates:updates];
+    XCTAssertEqual(wakeups, 10);
+    for (id client in clients) {
+        XCTAssertEqual([updates countForObject:client], 10);
+    }
+}
+
+- (void)testNewClientIsDueWithinOnePeriod {
+    id client = [[[NSObject alloc] init] autorelease];
+    [_policy setPeriod:0.5 priority:iTermFrameSchedulerPriorityVisible forClient:client now:10.1];
+    const NSTimeInterval wakeup = [_policy nextWakeupAfter:10.1];
+    XCTAssertGreaterThan(wakeup, 10.1);
+    XCTAssertLessThanOrEqual(wakeup, 10.6 + 1e-9);
+}
+
+- (void)testKeyWindowIsServedFirst {
+    NSArray *clients = [self clients:3];
+    [_policy setPeriod:iTermFrameSchedulerTestTick priority:iTermFrameSchedulerPriorityBackground forClient:clients[0] now:0];
+    [_policy setPeriod:iTermFrameSchedulerTestTick priority:iTermFrameSchedulerPriorityVisible forClient:clients[1] now:0];
+    [_policy setPeriod:iTermFrameSchedulerTestTick priority:iTermFrameSchedulerPriorityKeyWindow forClient:clients[2] now:0];
+    NSArray *due = [_policy clientsDueAt:[_policy nextWakeupAfter:0]];
+    NSArray *expected = @[ clients[2], clients[1], clients[0] ];
+    XCTAssertEqualObjects(due, expected);
+}
+
+- (void)testOccludedClientsAreSlowedDown {
+    NSArray *clients = [self clients:2];
+    _policy.occludedPeriod = 1;
+    [_policy setPeriod:iTermFrameSchedulerTestTick priority:iTermFrameSchedulerPriorityOccluded forClient:clients[0] now:0];
+    [_policy setPeriod:iTermFrameSchedulerTestTick priority:iTermFrameSchedulerPriorityVisible forClient:clients[1] now:0];
+    NSCountedSet *updates = [[[NSCountedSet alloc] init] autorelease];
+    [self simulateFrom:0 to:5 updates:updates];
+    XCTAssertEqual([updates countForObject:clients[0]], 4);
+    XCTAssertGreaterThanOrEqual([updates countForObject:clients[1]], 299);
+}
+
+- (void)testSpeedingUpTakesEffectOnNextTick {
+    id client = [[[NSObject alloc] init] autorelease];
+    [_policy setPeriod:1 priority:iTermFrameSchedulerPriorityBackground forClient:client now:0];
+    [_policy setPeriod:iTermFrameSchedulerTestTick priority:iTermFrameSchedulerPriorityKeyWindow forClient:client now:0.2];
+    XCTAssertEqualWithAccuracy([_policy nextWakeupAfter:0.2], 13 * iTermFrameSchedulerTestTick, 1e-9);
+}
+
+- (void)testSlowingDownKeepsScheduledUpdate {
+    id client = [[[NSObject alloc] init] autorelease];
+    [_policy setPeriod:iTermFrameSchedulerTestTick priority:iTermFrameSchedulerPriorityKeyWindow forClient:client now:0];
+    [_policy setPeriod:1 priority:iTermFrameSchedulerPriorityBackground forClient:client now:0];
+    XCTAssertEqualWithAccuracy([_policy nextWakeupAfter:0], iTermFrameSchedulerTestTick, 1e-9);
+    XCTAssertEqual([_policy clientsDueAt:iTermFrameSchedulerTestTick].count, 1);
+    XCTAssertEqualWithAccuracy([_policy nextWakeupAfter:iTermFrameSchedulerTestTick], 1, 1e-9);
+}
+
+- (void)testDeferredClientIsDueOnNextTick {
+    id client = [[[NSObject alloc] init] autorelease];
+    [_policy setPeriod:1 priority:iTermFrameSchedulerPriorityVisible forClient:client now:0];
+    XCTAssertEqual([_policy clientsDueAt:1].count, 1);
+    [_policy deferClient:client now:1];
+    XCTAssertEqualWithAccuracy([_policy nextWakeupAfter:1], 1 + iTermFrameSchedulerTestTick, 1e-9);
+    XCTAssertEqual([_policy clientsDueAt:1 + iTermFrameSchedulerTestTick].count, 1);
+}
+
+- (void)testRemovedAndDeallocatedClientsAreForgotten {
+    id removed = [[[NSObject alloc] init] autorelease];
+    [_policy setPeriod:1 priority:iTermFrameSchedulerPriorityVisible forClient:removed now:0];
+    @autoreleasepool {
+        NSObject *deallocated = [[NSObject alloc] init];
+        [_policy setPeriod:1 priority:iTermFrameSchedulerPriorityVisible forClient:deallocated now:0];
+        [deallocated release];
+    }
+    XCTAssertEqual(_policy.count, 1);
+    [_policy removeClient:removed];
+    XCTAssertEqual(_policy.count, 0);
+    XCTAssertTrue(isinf([_policy nextWakeupAfter:0]));
+}
+
+#pragma mark - Performance
+
+// 40 busy sessions: one in the key window, three more visible, and the rest in background tabs.
+- (NSArray *)registerBusySessions {
+    NSArray *clients = [self clients:40];
+    [clients enumerateObjectsUsingBlock:^(id client, NSUInteger i, BOOL *stop) {
+        iTermFrameSchedulerPriority priority;
+        NSTimeInterval period;
+        if (i == 0) {
+            priority = iTermFrameSchedulerPriorityKeyWindow;
+            period = iTermFrameSchedulerTestTick;
+        } else if (i < 4) {
+            priority = iTermFrameSchedulerPriorityVisible;
+            period = iTermFrameSchedulerTestTick;
+        } else {
+            priority = iTermFrameSchedulerPriorityBackground;
+            period = 1;
+        }
+        [_policy setPeriod:period priority:priority forClient:client now:i * 0.0123];
+    }];
+    return clients;
+}
+
+- (void)testBusySessionsWakeupsPerSecond {
+    NSArray *clients = [self registerBusySessions];
+    const NSTimeInterval duration = 60;
+    const NSInteger wakeups = [self simulateFrom:1 to:1 + duration updates:nil];
+
+    // Each session with its own timer wakes up once per period.
+    const double independentWakeupsPerSecond = 4 / iTermFrameSchedulerTestTick + (clients.count - 4) / 1.0;
+    const double wakeupsPerSecond = wakeups / duration;
+    NSLog(@"Wakeups per second: %.1f coalesced, %.1f independent", wakeupsPerSecond, independentWakeupsPerSecond);
+    XCTAssertLessThanOrEqual(wakeupsPerSecond, 1 / iTermFrameSchedulerTestTick + 1);
+    XCTAssertLessThan(wakeupsPerSecond, independentWakeupsPerSecond / 4);
+
+    [self measureBlock:^{
+        [self simulateFrom:1 to:1 + duration updates:nil];
+    }];
+}
+
+@end
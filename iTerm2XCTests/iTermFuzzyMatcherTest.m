@@ -0,0 +1,169 @@
+//
+//  iTermFuzzyMatcherTest.m
+//  iTerm2XCTests
+//
+//  Created by George Nachman on 10/18/26.
+//
+
+#import <XCTest/XCTest.h>
+#import "iTermFuzzyMatcher.h"
+#import "iTermMinimumSubsequenceMatcher.h"
+
+@interface iTermFuzzyMatcherTest : XCTestCase
+@end
+
+@implementation iTermFuzzyMatcherTest
+
+- (NSString *)randomStringOfLength:(NSInteger)length alphabet:(NSString *)alphabet {
+    NSMutableString *string = [NSMutableString string];
+    for (NSInteger i = 0; i < length; i++) {
+        [string appendFormat:@"%C", [alphabet characterAtIndex:arc4random_uniform((uint32_t)alphabet.length)]];
+    }
+    return string;
+}
+
+- (NSArray<NSString *> *)randomCandidates:(int)count {
+    NSArray<NSString *> *words = @[ @"Default", @"ssh", @"prod", @"staging", @"db", @"Web", @"build",
+                                    @"Solarized", @"Dark", @"light", @"tmux", @"git", @"~/src/iterm2" ];
+    NSMutableArray<NSString *> *candidates = [NSMutableArray array];
+    for (int i = 0; i < count; i++) {
+        NSMutableArray<NSString *> *parts = [NSMutableArray array];
+        const int numberOfParts = 1 + arc4random_uniform(4);
+        for (int j = 0; j < numberOfParts; j++) {
+            [parts addObject:words[arc4random_uniform((uint32_t)words.count)]];
+        }
+        [parts addObject:[@(i) stringValue]];
+        [candidates addObject:[parts componentsJoinedByString:@" "]];
+    }
+    return candidates;
+}
+
+// The same ranking the matcher should produce, found by scoring every candidate from scratch.
+- (NSArray<NSNumber *> *)slowIndexesOfBestMatchesForQuery:(NSString *)query
+                                             inCandidates:(NSArray<NSString *> *)candidates
+                                             maximumCount:(NSUInteger)maximumCount {
+    iTermFuzzyMatcher *matcher = [[[iTermFuzzyMatcher alloc] init] autorelease];
+    matcher.query = query;
+    NSMutableArray<NSNumber *> *indexes = [NSMutableArray array];
+    for (NSUInteger i = 0; i < candidates.count; i++) {
+        if (query.length == 0 || [matcher qualityOfMatchForDocument:[matcher documentForString:candidates[i]]] > 0) {
+            [indexes addObject:@(i)];
+        }
+    }
+    return [iTermFuzzyMatcher bestObjects:indexes
+                             maximumCount:maximumCount
+                                    score:^double(NSNumber *index) {
+                                        return [matcher qualityOfMatchForDocument:[matcher documentForString:candidates[index.integerValue]]];
+                                    }];
+}
+
+- (void)testIndexSetsMatchMinimumSubsequenceMatcher {
+    iTermFuzzyMatcher *matcher = [[[iTermFuzzyMatcher alloc] init] autorelease];
+    for (int i = 0; i < 2000; i++) {
+        // Long documents span several words of the bitmaps.
+        NSString *document = [self randomStringOfLength:arc4random_uniform(200) alphabet:@"abcdABCD"];
+        NSString *query = [self randomStringOfLength:1 + arc4random_uniform(5) alphabet:@"abcd"];
+        iTermMinimumSubsequenceMatcher *reference =
+            [[[iTermMinimumSubsequenceMatcher alloc] initWithQuery:query] autorelease];
+        matcher.query = query;
+        XCTAssertEqualObjects([matcher indexSetForDocument:[matcher documentForString:document]],
+                              [reference indexSetForDocument:[document lowercaseString]],
+                              @"query=%@ document=%@", query, document);
+    }
+}
+
+- (void)testQuality {
+    iTermFuzzyMatcher *matcher = [[[iTermFuzzyMatcher alloc] init] autorelease];
+    matcher.query = @"Prod";
+    XCTAssertEqual([matcher qualityOfMatchForDocument:[matcher documentForString:@"prod"]], 1);
+    XCTAssertEqual([matcher qualityOfMatchForDocument:[matcher documentForString:@"PRODUCTION"]], 0.9);
+    XCTAssertEqual([matcher qualityOfMatchForDocument:[matcher documentForString:@"ssh prod"]], 0.5);
+    XCTAssertEqual([matcher qualityOfMatchForDocument:[matcher documentForString:@"a pr od"]], 0.25);
+    XCTAssertEqual([matcher qualityOfMatchForDocument:[matcher documentForString:@"staging"]], 0);
+    NSMutableIndexSet *expected = [NSMutableIndexSet indexSetWithIndexesInRange:NSMakeRange(2, 2)];
+    [expected addIndexesInRange:NSMakeRange(5, 2)];
+    XCTAssertEqualObjects([matcher indexSetForDocument:[matcher documentForString:@"a pr od"]], expected);
+    XCTAssertNil([matcher indexSetForDocument:[matcher documentForString:@"staging"]]);
+
+    matcher.query = @"";
+    XCTAssertEqual([matcher qualityOfMatchForDocument:[matcher documentForString:@"prod"]], 0);
+}
+
+- (void)testNarrowingGivesSameResultsAsStartingOver {
+    NSArray<NSString *> *candidates = [self randomCandidates:3000];
+    iTermFuzzyMatcher *matcher = [[[iTermFuzzyMatcher alloc] initWithStrings:candidates] autorelease];
+    // Type, backspace, and retype so the query both grows and shrinks.
+    NSArray<NSString *> *queries = @[ @"", @"s", @"so", @"sol", @"sold", @"sol", @"so", @"sod",
+                                      @"sodk", @"", @"d", @"db", @"db 1", @"db 12", @"x", @"xy", @"" ];
+    for (NSString *query in queries) {
+        matcher.query = query;
+        for (NSNumber *maximumCount in @[ @1, @10, @100000 ]) {
+            XCTAssertEqualObjects([matcher indexesOfBestMatchesWithMaximumCount:maximumCount.integerValue],
+                                  [self slowIndexesOfBestMatchesForQuery:query
+                                                            inCandidates:candidates
+                                                            maximumCount:maximumCount.integerValue],
+                                  @"query=%@ maximumCount=%@", query, maximumCount);
+        }
+    }
+}
+
+- (void)testBestObjectsKeepsOrderOfTies {
+    NSArray<NSNumber *> *scores = @[ @1, @3, @2, @3, @1, @0, @2 ];
+    double (^score)(NSNumber *) = ^double(NSNumber *number) {
+        return number.doubleValue;
+    };
+    NSArray<NSNumber *> *best = [iTermFuzzyMatcher bestObjects:scores maximumCount:3 score:score];
+    XCTAssertEqual(best.count, 3);
+    XCTAssertEqual(best[0], scores[1]);
+    XCTAssertEqual(best[1], scores[3]);
+    XCTAssertEqual(best[2], scores[2]);
+
+    NSArray<NSNumber *> *all = [iTermFuzzyMatcher bestObjects:scores maximumCount:100 score:score];
+    NSArray<NSNumber *> *expected = @[ scores[1], scores[3], scores[2], scores[6], scores[0], scores[4], scores[5] ];
+    XCTAssertEqual(all.count, expected.count);
+    for (NSUInteger i = 0; i < expected.count; i++) {
+        XCTAssertEqual(all[i], expected[i]);
+    }
+
+    XCTAssertEqual([iTermFuzzyMatcher bestObjects:scores maximumCount:0 score:score].count, 0);
+    XCTAssertEqual([iTermFuzzyMatcher bestObjects:@[] maximumCount:10 score:score].count, 0);
+}
+
+#pragma mark - Performance
+
+// Typing a query one character at a time against 10,000 candidates.
+- (void)testTypingWithTenThousandCandidatesPerformance {
+    NSArray<NSString *> *candidates = [self randomCandidates:10000];
+    iTermFuzzyMatcher *matcher = [[[iTermFuzzyMatcher alloc] initWithStrings:candidates] autorelease];
+    NSString *query = @"solarized dark 99";
+    [self measureBlock:^{
+        for (NSUInteger i = 0; i <= query.length; i++) {
+            matcher.query = [query substringToIndex:i];
+            [matcher indexesOfBestMatchesWithMaximumCount:100];
+        }
+    }];
+}
+
+// The same, scoring each candidate with iTermMinimumSubsequenceMatcher as Open Quickly used to.
+- (void)testTypingWithTenThousandCandidatesUsingMinimumSubsequenceMatcherPerformance {
+    NSArray<NSString *> *candidates = [self randomCandidates:10000];
+    NSString *query = @"solarized dark 99";
+    [self measureBlock:^{
+        for (NSUInteger i = 1; i <= query.length; i++) {
+            iTermMinimumSubsequenceMatcher *matcher =
+                [[[iTermMinimumSubsequenceMatcher alloc] initWithQuery:[query substringToIndex:i]] autorelease];
+            for (NSString *candidate in candidates) {
+                [matcher indexSetForDocument:[candidate lowercaseString]];
+            }
+        }
+    }];
+}
+
+- (void)testPreparingTenThousandCandidatesPerformance {
+    NSArray<NSString *> *candidates = [self randomCandidates:10000];
+    [self measureBlock:^{
+        [[[iTermFuzzyMatcher alloc] initWithStrings:candidates] release];
+    }];
+}
+
+@end
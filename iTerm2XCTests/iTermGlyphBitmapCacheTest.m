@@ -0,0 +1,306 @@
+//
+//  iTermGlyphBitmapCacheTest.m
+//  iTerm2XCTests
+//
+//  Created by George Nachman on 10/18/26.
+//
+
+#import <XCTest/XCTest.h>
+#import "iTermCharacterBitmap.h"
+#import "iTermCharacterParts.h"
+#import "iTermCharacterSource.h"
+#import "iTermGlyphBitmapCache.h"
+#import "PTYFontInfo.h"
+
+static const CGFloat iTermGlyphBitmapCacheTestScale = 2;
+static const CGSize iTermGlyphBitmapCacheTestGlyphSize = { 16, 34 };
+
+@interface iTermGlyphBitmapCacheTest : XCTestCase
+@end
+
+@implementation iTermGlyphBitmapCacheTest {
+    CGContextRef _context;
+    CGColorSpaceRef _colorSpace;
+    iTermCharacterSourceDescriptor *_descriptor;
+    NSString *_path;
+}
+
+- (void)setUp {
+    [super setUp];
+    // Sized like PTYSession's Metal context.
+    const int parts = iTermTextureMapMaxCharacterParts;
+    _colorSpace = CGColorSpaceCreateDeviceRGB();
+    _context = CGBitmapContextCreate(NULL,
+                                     iTermGlyphBitmapCacheTestGlyphSize.width * parts,
+                                     iTermGlyphBitmapCacheTestGlyphSize.height * parts,
+                                     8,
+                                     iTermGlyphBitmapCacheTestGlyphSize.width * parts * 4,
+                                     _colorSpace,
+                                     kCGImageAlphaPremultipliedFirst | kCGBitmapByteOrder32Host);
+    PTYFontInfo *fontInfo = [PTYFontInfo fontInfoWithFont:[NSFont userFixedPitchFontOfSize:12]];
+    _descriptor = [[iTermCharacterSourceDescriptor characterSourceDescriptorWithAsciiFont:fontInfo
+                                                                             nonAsciiFont:fontInfo
+                                                                              asciiOffset:CGSizeZero
+                                                                                glyphSize:iTermGlyphBitmapCacheTestGlyphSize
+                                                                                 cellSize:iTermGlyphBitmapCacheTestGlyphSize
+                                                                   cellSizeWithoutSpacing:iTermGlyphBitmapCacheTestGlyphSize
+                                                                                    scale:iTermGlyphBitmapCacheTestScale
+                                                                              useBoldFont:YES
+                                                                            useItalicFont:YES
+                                                                         usesNonAsciiFont:NO
+                                                                         asciiAntiAliased:YES
+                                                                      nonAsciiAntiAliased:YES] retain];
+    _path = [[NSTemporaryDirectory() stringByAppendingPathComponent:[[NSUUID UUID] UUIDString]] retain];
+}
+
+- (void)tearDown {
+    [[NSFileManager defaultManager] removeItemAtPath:_path error:nil];
+    [_path release];
+    [_descriptor release];
+    CGContextRelease(_context);
+    CGColorSpaceRelease(_colorSpace);
+    [super tearDown];
+}
+
+- (NSArray<NSString *> *)glyphSet {
+    NSMutableArray<NSString *> *strings = [NSMutableArray array];
+    for (unichar c = 33; c < 127; c++) {
+        [strings addObject:[NSString stringWithCharacters:&c length:1]];
+    }
+    [strings addObjectsFromArray:@[ @"é", @"ß", @"λ", @"→", @"─", @"あ" ]];
+    return strings;
+}
+
+- (NSData *)keyForString:(NSString *)string bold:(BOOL)bold {
+    iTermCharacterSourceAttributes *attributes =
+        [iTermCharacterSourceAttributes characterSourceAttributesWithThinStrokes:NO bold:bold italic:NO];
+    return [iTermGlyphBitmapCache keyForCharacter:string
+                                       descriptor:_descriptor
+                                       attributes:attributes
+                                       boxDrawing:NO
+                                           radius:iTermTextureMapMaxCharacterParts / 2
+                         useNativePowerlineGlyphs:NO
+                                   asciiPartsOnly:NO];
+}
+
+// Rasterizes `string` the way iTermMetalPerFrameState does unless the cache already has it.
+- (NSDictionary<NSNumber *, iTermCharacterBitmap *> *)bitmapsForString:(NSString *)string
+                                                                 cache:(iTermGlyphBitmapCache *)cache {
+    NSData *key = [self keyForString:string bold:NO];
+    BOOL emoji = NO;
+    NSDictionary<NSNumber *, iTermCharacterBitmap *> *cached = [cache bitmapsForKey:key emoji:&emoji];
+    if (cached) {
+        return cached;
+    }
+    iTermCharacterSourceAttributes *attributes =
+        [iTermCharacterSourceAttributes characterSourceAttributesWithThinStrokes:NO bold:NO italic:NO];
+    iTermCharacterSource *source = [[[iTermCharacterSource alloc] initWithCharacter:string
+                                                                         descriptor:_descriptor
+                                                                         attributes:attributes
+                                                                         boxDrawing:NO
+                                                                             radius:iTermTextureMapMaxCharacterParts / 2
+                                                           useNativePowerlineGlyphs:NO
+                                                                            context:_context] autorelease];
+    NSMutableDictionary<NSNumber *, iTermCharacterBitmap *> *result = [NSMutableDictionary dictionary];
+    for (NSNumber *part in source.parts) {
+        result[part] = [source bitmapForPart:part.intValue];
+    }
+    [cache setBitmaps:result emoji:source.isEmoji forKey:key];
+    return result;
+}
+
+- (void)assertBitmaps:(NSDictionary<NSNumber *, iTermCharacterBitmap *> *)actual
+         equalBitmaps:(NSDictionary<NSNumber *, iTermCharacterBitmap *> *)expected {
+    XCTAssertEqualObjects([actual.allKeys sortedArrayUsingSelector:@selector(compare:)],
+                          [expected.allKeys sortedArrayUsingSelector:@selector(compare:)]);
+    for (NSNumber *part in expected) {
+        XCTAssertEqualObjects(actual[part].data, expected[part].data);
+        XCTAssertTrue(CGSizeEqualToSize(actual[part].size, expected[part].size));
+    }
+}
+
+- (void)testRasterizingTwiceHitsCache {
+    iTermGlyphBitmapCache *cache = [[[iTermGlyphBitmapCache alloc] initWithCapacity:1024 path:nil] autorelease];
+    NSArray<NSString *> *glyphs = [self glyphSet];
+    NSMutableArray *first = [NSMutableArray array];
+    for (NSString *string in glyphs) {
+        [first addObject:[self bitmapsForString:string cache:cache]];
+    }
+    XCTAssertEqual(cache.misses, (NSInteger)glyphs.count);
+    XCTAssertEqual(cache.hits, 0);
+
+    [glyphs enumerateObjectsUsingBlock:^(NSString * _Nonnull string, NSUInteger i, BOOL * _Nonnull stop) {
+        [self assertBitmaps:[self bitmapsForString:string cache:cache] equalBitmaps:first[i]];
+    }];
+    XCTAssertEqual(cache.misses, (NSInteger)glyphs.count);
+    XCTAssertEqual(cache.hits, (NSInteger)glyphs.count);
+}
+
+- (void)testKeysDependOnAttributes {
+    XCTAssertEqualObjects([self keyForString:@"a" bold:NO], [self keyForString:@"a" bold:NO]);
+    XCTAssertNotEqualObjects([self keyForString:@"a" bold:NO], [self keyForString:@"a" bold:YES]);
+    XCTAssertNotEqualObjects([self keyForString:@"a" bold:NO], [self keyForString:@"b" bold:NO]);
+}
+
+- (void)testEvictsLeastRecentlyUsed {
+    iTermGlyphBitmapCache *cache = [[[iTermGlyphBitmapCache alloc] initWithCapacity:2 path:nil] autorelease];
+    [self bitmapsForString:@"a" cache:cache];
+    [self bitmapsForString:@"b" cache:cache];
+    [self bitmapsForString:@"a" cache:cache];
+    [self bitmapsForString:@"c" cache:cache];
+    XCTAssertNil([cache bitmapsForKey:[self keyForString:@"b" bold:NO] emoji:NULL]);
+    XCTAssertNotNil([cache bitmapsForKey:[self keyForString:@"a" bold:NO] emoji:NULL]);
+}
+
+- (void)testFileIsReadByNextInstance {
+    NSArray<NSString *> *glyphs = [self glyphSet];
+    NSMutableArray *first = [NSMutableArray array];
+    @autoreleasepool {
+        iTermGlyphBitmapCache *cache = [[iTermGlyphBitmapCache alloc] initWithCapacity:1024 path:_path];
+        for (NSString *string in glyphs) {
+            [first addObject:[self bitmapsForString:string cache:cache]];
+        }
+        [cache release];
+    }
+
+    iTermGlyphBitmapCache *cache = [[[iTermGlyphBitmapCache alloc] initWithCapacity:1024 path:_path] autorelease];
+    [glyphs enumerateObjectsUsingBlock:^(NSString * _Nonnull string, NSUInteger i, BOOL * _Nonnull stop) {
+        [self assertBitmaps:[self bitmapsForString:string cache:cache] equalBitmaps:first[i]];
+    }];
+    XCTAssertEqual(cache.misses, 0);
+    XCTAssertEqual(cache.diskHits, (NSInteger)glyphs.count);
+}
+
+- (void)testEntriesEvictedFromMemoryAreReadFromFile {
+    iTermGlyphBitmapCache *cache = [[[iTermGlyphBitmapCache alloc] initWithCapacity:1 path:_path] autorelease];
+    NSDictionary *expected = [self bitmapsForString:@"a" cache:cache];
+    [self bitmapsForString:@"b" cache:cache];
+    [self assertBitmaps:[self bitmapsForString:@"a" cache:cache] equalBitmaps:expected];
+    XCTAssertEqual(cache.diskHits, 1);
+}
+
+- (void)testTruncatedFileKeepsCompleteRecords {
+    @autoreleasepool {
+        iTermGlyphBitmapCache *cache = [[iTermGlyphBitmapCache alloc] initWithCapacity:16 path:_path];
+        [self bitmapsForString:@"a" cache:cache];
+        [self bitmapsForString:@"b" cache:cache];
+        [cache release];
+    }
+    NSDictionary *attributes = [[NSFileManager defaultManager] attributesOfItemAtPath:_path error:nil];
+    XCTAssertEqual(truncate(_path.fileSystemRepresentation, [attributes fileSize] - 1), 0);
+
+    @autoreleasepool {
+        iTermGlyphBitmapCache *cache = [[iTermGlyphBitmapCache alloc] initWithCapacity:16 path:_path];
+        XCTAssertNotNil([cache bitmapsForKey:[self keyForString:@"a" bold:NO] emoji:NULL]);
+        XCTAssertNil([cache bitmapsForKey:[self keyForString:@"b" bold:NO] emoji:NULL]);
+
+        // The torn record was dropped so new records can follow the good ones.
+        [self bitmapsForString:@"b" cache:cache];
+        [cache release];
+    }
+    iTermGlyphBitmapCache *reopened = [[[iTermGlyphBitmapCache alloc] initWithCapacity:16 path:_path] autorelease];
+    XCTAssertNotNil([reopened bitmapsForKey:[self keyForString:@"b" bold:NO] emoji:NULL]);
+}
+
+- (void)testCorruptFileIsDiscarded {
+    [[@"garbage" dataUsingEncoding:NSUTF8StringEncoding] writeToFile:_path atomically:NO];
+    @autoreleasepool {
+        iTermGlyphBitmapCache *cache = [[iTermGlyphBitmapCache alloc] initWithCapacity:16 path:_path];
+        XCTAssertNil([cache bitmapsForKey:[self keyForString:@"a" bold:NO] emoji:NULL]);
+        [self bitmapsForString:@"a" cache:cache];
+        [cache release];
+    }
+
+    iTermGlyphBitmapCache *reopened = [[[iTermGlyphBitmapCache alloc] initWithCapacity:16 path:_path] autorelease];
+    XCTAssertNotNil([reopened bitmapsForKey:[self keyForString:@"a" bold:NO] emoji:NULL]);
+}
+
+- (void)testDamagedRecordIsIgnored {
+    @autoreleasepool {
+        iTermGlyphBitmapCache *cache = [[iTermGlyphBitmapCache alloc] initWithCapacity:16 path:_path];
+        [self bitmapsForString:@"a" cache:cache];
+        [cache release];
+    }
+    // Flip a bit in the last pixel.
+    NSMutableData *data = [NSMutableData dataWithContentsOfFile:_path];
+    ((unsigned char *)data.mutableBytes)[data.length - 1] ^= 1;
+    XCTAssertTrue([data writeToFile:_path atomically:NO]);
+
+    iTermGlyphBitmapCache *cache = [[[iTermGlyphBitmapCache alloc] initWithCapacity:16 path:_path] autorelease];
+    XCTAssertNil([cache bitmapsForKey:[self keyForString:@"a" bold:NO] emoji:NULL]);
+    XCTAssertEqual(cache.diskHits, 0);
+}
+
+- (void)testBitmapWhoseLengthDoesNotMatchItsSizeIsNotReadBack {
+    NSData *key = [self keyForString:@"a" bold:NO];
+    @autoreleasepool {
+        iTermGlyphBitmapCache *cache = [[iTermGlyphBitmapCache alloc] initWithCapacity:16 path:_path];
+        iTermCharacterBitmap *bitmap = [[[iTermCharacterBitmap alloc] init] autorelease];
+        bitmap.size = CGSizeMake(2, 2);
+        bitmap.data = [NSMutableData dataWithLength:2 * 2 * 4 - 1];
+        [cache setBitmaps:@{ @0: bitmap } emoji:NO forKey:key];
+        [cache release];
+    }
+    iTermGlyphBitmapCache *cache = [[[iTermGlyphBitmapCache alloc] initWithCapacity:16 path:_path] autorelease];
+    XCTAssertNil([cache bitmapsForKey:key emoji:NULL]);
+}
+
+// The file is locked by its first user. A second one, as in another process, must neither read nor
+// change it.
+- (void)testLockedFileIsNotShared {
+    iTermGlyphBitmapCache *owner = [[[iTermGlyphBitmapCache alloc] initWithCapacity:1 path:_path] autorelease];
+    NSDictionary *expected = [self bitmapsForString:@"a" cache:owner];
+    NSDictionary *attributes = [[NSFileManager defaultManager] attributesOfItemAtPath:_path error:nil];
+
+    @autoreleasepool {
+        iTermGlyphBitmapCache *other = [[iTermGlyphBitmapCache alloc] initWithCapacity:16 path:_path];
+        XCTAssertNil([other bitmapsForKey:[self keyForString:@"a" bold:NO] emoji:NULL]);
+        [self bitmapsForString:@"b" cache:other];
+        XCTAssertEqual(other.diskHits, 0);
+        [other release];
+    }
+    XCTAssertEqual([[[NSFileManager defaultManager] attributesOfItemAtPath:_path error:nil] fileSize],
+                   [attributes fileSize]);
+
+    // The owner's record is intact. Adding another glyph evicts it from memory so it's read back
+    // from the file.
+    [self bitmapsForString:@"c" cache:owner];
+    [self assertBitmaps:[self bitmapsForString:@"a" cache:owner] equalBitmaps:expected];
+    XCTAssertEqual(owner.diskHits, 1);
+}
+
+#pragma mark - Performance
+
+// Simulates starting up with an empty cache: every glyph gets rasterized.
+- (void)testColdStartPerformance {
+    NSArray<NSString *> *glyphs = [self glyphSet];
+    [self measureBlock:^{
+        iTermGlyphBitmapCache *cache = [[iTermGlyphBitmapCache alloc] initWithCapacity:1024 path:nil];
+        for (NSString *string in glyphs) {
+            [self bitmapsForString:string cache:cache];
+        }
+        [cache release];
+    }];
+}
+
+// Simulates starting up after an earlier launch saved the glyphs to disk.
+- (void)testWarmStartPerformance {
+    NSArray<NSString *> *glyphs = [self glyphSet];
+    @autoreleasepool {
+        iTermGlyphBitmapCache *cache = [[iTermGlyphBitmapCache alloc] initWithCapacity:1024 path:_path];
+        for (NSString *string in glyphs) {
+            [self bitmapsForString:string cache:cache];
+        }
+        [cache release];
+    }
+    [self measureBlock:^{
+        iTermGlyphBitmapCache *cache = [[iTermGlyphBitmapCache alloc] initWithCapacity:1024 path:self->_path];
+        for (NSString *string in glyphs) {
+            [self bitmapsForString:string cache:cache];
+        }
+        XCTAssertEqual(cache.misses, 0);
+        [cache release];
+    }];
+}
+
+@end
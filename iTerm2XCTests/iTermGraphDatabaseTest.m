@@ -0,0 +1,487 @@
+//
+//  iTermGraphDatabaseTest.m
+//  iTerm2XCTests
+//
+//  Created by George Nachman on 10/18/26.
+//
+
+#import <XCTest/XCTest.h>
+#import "FMDatabase.h"
+#import "LineBuffer.h"
+#import "NSData+iTerm.h"
+#import "iTermDatabase.h"
+#import "iTermEncoderAdapter.h"
+#import "iTermGraphChunkStore.h"
+#import "iTermGraphDatabase.h"
+#import "iTermThreadSafety.h"
+
+// Maps "key[identifier]/key[identifier]/..." to each node's POD.
+static void iTermGraphDatabaseTestFlatten(iTermEncoderGraphRecord *record,
+                                          NSString *path,
+                                          NSMutableDictionary *result) {
+    NSString *myPath = [NSString stringWithFormat:@"%@/%@[%@]", path, record.key, record.identifier];
+    result[myPath] = record.pod ?: @{};
+    for (iTermEncoderGraphRecord *child in record.graphRecords) {
+        iTermGraphDatabaseTestFlatten(child, myPath, result);
+    }
+}
+
+static NSDictionary *iTermGraphDatabaseTestFlattened(iTermEncoderGraphRecord *record) {
+    NSMutableDictionary *result = [NSMutableDictionary dictionary];
+    if (record) {
+        iTermGraphDatabaseTestFlatten(record, @"", result);
+    }
+    return result;
+}
+
+// Encodes one child per session under a "sessions" array, the way windows and sessions are saved
+// for restoration. `sessions` maps identifier to generation. A session's contents depend only on
+// its identifier and generation.
+static void iTermGraphDatabaseTestEncodeSessions(iTermGraphEncoder *encoder,
+                                                 NSDictionary<NSString *, NSNumber *> *sessions) {
+    NSArray<NSString *> *identifiers = [sessions.allKeys sortedArrayUsingSelector:@selector(compare:)];
+    [encoder encodeArrayWithKey:@"sessions"
+                     generation:iTermGenerationAlwaysEncode
+                    identifiers:identifiers
+                        options:0
+                          block:^BOOL(NSString *identifier,
+                                      NSInteger i,
+                                      iTermGraphEncoder *subencoder,
+                                      BOOL *stop) {
+        const NSInteger generation = sessions[identifier].integerValue;
+        return [subencoder encodeChildWithKey:@"Session"
+                                   identifier:@""
+                                   generation:generation
+                                        block:^BOOL(iTermGraphEncoder *sessionEncoder) {
+            [sessionEncoder encodeString:identifier forKey:@"guid"];
+            [sessionEncoder encodeNumber:@(generation) forKey:@"generation"];
+            NSMutableData *contents = [NSMutableData dataWithLength:4096];
+            memset(contents.mutableBytes, (int)(identifier.hash + generation), contents.length);
+            [sessionEncoder encodeData:contents forKey:@"contents"];
+            return [sessionEncoder encodeChildWithKey:@"Grid"
+                                           identifier:@""
+                                           generation:generation
+                                                block:^BOOL(iTermGraphEncoder *gridEncoder) {
+                [gridEncoder encodeString:[NSString stringWithFormat:@"%@-%@", identifier, @(generation)]
+                                   forKey:@"lines"];
+                return YES;
+            }];
+        }];
+    }];
+}
+
+static NSDictionary<NSString *, NSNumber *> *iTermGraphDatabaseTestSessions(NSInteger count) {
+    NSMutableDictionary<NSString *, NSNumber *> *sessions = [NSMutableDictionary dictionary];
+    for (NSInteger i = 0; i < count; i++) {
+        sessions[[NSString stringWithFormat:@"session-%04d", (int)i]] = @1;
+    }
+    return sessions;
+}
+
+// Printable junk like tests/spam.cc produces.
+static NSMutableData *iTermGraphDatabaseTestRandomData(NSUInteger length) {
+    NSMutableData *data = [NSMutableData dataWithLength:length];
+    unsigned char *bytes = data.mutableBytes;
+    for (NSUInteger i = 0; i < length; i++) {
+        bytes[i] = 'A' + random() % 60;
+    }
+    return data;
+}
+
+static NSSet<NSData *> *iTermGraphDatabaseTestChunkHashes(NSData *data) {
+    NSMutableSet<NSData *> *hashes = [NSMutableSet set];
+    for (NSValue *value in [iTermGraphChunkStore chunkRangesForData:data]) {
+        [hashes addObject:[data subdataWithRange:value.rangeValue].it_sha256];
+    }
+    return hashes;
+}
+
+// Something like a saved state with many windows of big scrollback: each session has a number
+// of line blocks under it.
+static void iTermGraphDatabaseTestEncodeWindows(iTermGraphEncoder *encoder,
+                                                NSInteger numberOfWindows,
+                                                NSInteger sessionsPerWindow,
+                                                NSInteger blocksPerSession) {
+    NSMutableArray<NSString *> *windowIdentifiers = [NSMutableArray array];
+    for (NSInteger i = 0; i < numberOfWindows; i++) {
+        [windowIdentifiers addObject:[NSString stringWithFormat:@"window-%d", (int)i]];
+    }
+    [encoder encodeArrayWithKey:@"windows"
+                     generation:iTermGenerationAlwaysEncode
+                    identifiers:windowIdentifiers
+                        options:0
+                          block:^BOOL(NSString *windowIdentifier,
+                                      NSInteger i,
+                                      iTermGraphEncoder *windowEncoder,
+                                      BOOL *stop) {
+        NSMutableArray<NSString *> *sessionIdentifiers = [NSMutableArray array];
+        for (NSInteger j = 0; j < sessionsPerWindow; j++) {
+            [sessionIdentifiers addObject:[NSString stringWithFormat:@"%@-session-%d", windowIdentifier, (int)j]];
+        }
+        [windowEncoder encodeArrayWithKey:@"sessions"
+                               generation:iTermGenerationAlwaysEncode
+                              identifiers:sessionIdentifiers
+                                  options:0
+                                    block:^BOOL(NSString *sessionIdentifier,
+                                                NSInteger j,
+                                                iTermGraphEncoder *sessionEncoder,
+                                                BOOL *stop) {
+            NSMutableArray<NSString *> *blockIdentifiers = [NSMutableArray array];
+            for (NSInteger k = 0; k < blocksPerSession; k++) {
+                [blockIdentifiers addObject:[NSString stringWithFormat:@"%@-block-%d", sessionIdentifier, (int)k]];
+            }
+            [sessionEncoder encodeArrayWithKey:@"blocks"
+                                    generation:iTermGenerationAlwaysEncode
+                                   identifiers:blockIdentifiers
+                                       options:0
+                                         block:^BOOL(NSString *blockIdentifier,
+                                                     NSInteger k,
+                                                     iTermGraphEncoder *blockEncoder,
+                                                     BOOL *stop) {
+                [blockEncoder encodeData:iTermGraphDatabaseTestRandomData(16 * 1024) forKey:@"Raw Buffer"];
+                [blockEncoder encodeString:blockIdentifier forKey:@"GUID"];
+                return YES;
+            }];
+            return YES;
+        }];
+        return YES;
+    }];
+}
+
+@interface iTermGraphDatabaseTest : XCTestCase
+@end
+
+@implementation iTermGraphDatabaseTest {
+    NSURL *_directory;
+    NSMutableArray<iTermSqliteDatabaseImpl *> *_databases;
+}
+
+- (void)setUp {
+    NSString *path = [NSTemporaryDirectory() stringByAppendingPathComponent:[[NSUUID UUID] UUIDString]];
+    _directory = [[NSURL fileURLWithPath:path] retain];
+    [[NSFileManager defaultManager] createDirectoryAtURL:_directory
+                             withIntermediateDirectories:YES
+                                              attributes:nil
+                                                   error:nil];
+    _databases = [[NSMutableArray alloc] init];
+}
+
+- (void)tearDown {
+    [[NSFileManager defaultManager] removeItemAtURL:_directory error:nil];
+    [_directory release];
+    [_databases release];
+}
+
+- (NSURL *)databaseURL {
+    return [_directory URLByAppendingPathComponent:@"graph.sqlite"];
+}
+
+- (iTermGraphDatabase *)openGraphDatabase {
+    iTermSqliteDatabaseImpl *db = [[[iTermSqliteDatabaseImpl alloc] initWithURL:self.databaseURL] autorelease];
+    [_databases addObject:db];
+    iTermGraphDatabase *gdb = [[[iTermGraphDatabase alloc] initWithDatabase:db] autorelease];
+    XCTAssertNotNil(gdb);
+    // Wait for it to finish loading.
+    [gdb.thread dispatchSync:^(id state) {}];
+    return gdb;
+}
+
+// Closes the database and releases its lock so it can be opened again.
+- (void)closeGraphDatabase:(iTermGraphDatabase *)gdb {
+    iTermSqliteDatabaseImpl *db = _databases.lastObject;
+    [gdb.thread dispatchSync:^(id state) {
+        [db close];
+        [db unlock];
+    }];
+}
+
+- (void)update:(iTermGraphDatabase *)gdb sessions:(NSDictionary<NSString *, NSNumber *> *)sessions {
+    [gdb updateSynchronously:YES
+                       block:^(iTermGraphEncoder * _Nonnull encoder) {
+        iTermGraphDatabaseTestEncodeSessions(encoder, sessions);
+    }
+                  completion:nil];
+}
+
+- (void)testOnDiskSchemaIsUnchanged {
+    iTermGraphDatabase *gdb = [self openGraphDatabase];
+    [self update:gdb sessions:iTermGraphDatabaseTestSessions(250)];
+    [self closeGraphDatabase:gdb];
+
+    FMDatabase *db = [FMDatabase databaseWithPath:self.databaseURL.path];
+    XCTAssertTrue([db open]);
+    NSMutableArray<NSString *> *columns = [NSMutableArray array];
+    FMResultSet *rs = [db executeQuery:@"pragma table_info(Node)"];
+    while ([rs next]) {
+        [columns addObject:[NSString stringWithFormat:@"%@ %@ %@",
+                            [rs stringForColumn:@"name"],
+                            [rs stringForColumn:@"type"],
+                            @([rs intForColumn:@"notnull"])]];
+    }
+    [rs close];
+    NSArray *expected = @[ @"key text 1", @"identifier text 1", @"parent integer 1", @"data blob 0" ];
+    XCTAssertEqualObjects(columns, expected);
+
+    // Every node but the root must refer to a parent that exists.
+    rs = [db executeQuery:@"select count(*) as c from Node where parent=0"];
+    XCTAssertTrue([rs next]);
+    XCTAssertEqual([rs intForColumn:@"c"], 1);
+    [rs close];
+    rs = [db executeQuery:@"select count(*) as c from Node as child left join Node as p on p.rowid = child.parent "
+                          @"where child.parent != 0 and p.rowid is NULL"];
+    XCTAssertTrue([rs next]);
+    XCTAssertEqual([rs intForColumn:@"c"], 0);
+    [rs close];
+    [db close];
+}
+
+// Databases written before batched saves used plain inserts with SQLite-assigned rowids. They must
+// load, and later saves must build on them correctly.
+- (void)testUpdatesDatabaseWrittenByOlderVersion {
+    FMDatabase *db = [FMDatabase databaseWithPath:self.databaseURL.path];
+    XCTAssertTrue([db open]);
+    XCTAssertTrue([db executeUpdate:@"create table if not exists Node (key text not null, identifier text not null, parent integer not null, data blob)"]);
+    XCTAssertTrue([db executeUpdate:@"insert into Node (key, identifier, parent, data) values (?, ?, ?, ?)",
+                   @"", @"", @0, [NSData data]]);
+    const long long root = db.lastInsertRowId;
+    NSData *pod = [NSData it_dataWithSecurelyArchivedObject:@{ @"color": @"red" } error:nil];
+    XCTAssertTrue([db executeUpdate:@"insert into Node (key, identifier, parent, data) values (?, ?, ?, ?)",
+                   @"legacy", @"", @(root), pod]);
+    [db close];
+
+    iTermGraphDatabase *gdb = [self openGraphDatabase];
+    NSDictionary *loaded = iTermGraphDatabaseTestFlattened(gdb.record);
+    XCTAssertEqualObjects(loaded[@"/[]/legacy[]"], @{ @"color": @"red" });
+
+    NSMutableDictionary<NSString *, NSNumber *> *sessions = [[iTermGraphDatabaseTestSessions(150) mutableCopy] autorelease];
+    [self update:gdb sessions:sessions];
+    for (NSInteger i = 0; i < 150; i += 3) {
+        NSString *identifier = [NSString stringWithFormat:@"session-%04d", (int)i];
+        sessions[identifier] = @2;
+    }
+    [sessions removeObjectForKey:@"session-0001"];
+    sessions[@"session-9999"] = @1;
+    [self update:gdb sessions:sessions];
+    NSDictionary *saved = iTermGraphDatabaseTestFlattened(gdb.record);
+    XCTAssertNil(saved[@"/[]/legacy[]"]);
+    [self closeGraphDatabase:gdb];
+
+    gdb = [self openGraphDatabase];
+    XCTAssertEqualObjects(iTermGraphDatabaseTestFlattened(gdb.record), saved);
+    [self closeGraphDatabase:gdb];
+}
+
+- (void)testUnchangedContentIsSkippedByHash {
+    iTermEncoderGraphRecord *before = [iTermEncoderGraphRecord withPODs:@{ @"x": @1 }
+                                                                 graphs:@[]
+                                                             generation:1
+                                                                    key:@"k"
+                                                             identifier:@""
+                                                                  rowid:@1];
+    iTermEncoderGraphRecord *same = [iTermEncoderGraphRecord withPODs:@{ @"x": @1 }
+                                                               graphs:@[]
+                                                           generation:2
+                                                                  key:@"k"
+                                                           identifier:@""
+                                                                rowid:nil];
+    iTermEncoderGraphRecord *different = [iTermEncoderGraphRecord withPODs:@{ @"x": @2 }
+                                                                    graphs:@[]
+                                                                generation:2
+                                                                       key:@"k"
+                                                                identifier:@""
+                                                                     rowid:nil];
+    XCTAssertEqualObjects(before.contentHash, same.contentHash);
+    XCTAssertNotEqualObjects(before.contentHash, different.contentHash);
+    XCTAssertEqualObjects(different.contentHash, different.data.it_sha256);
+}
+
+#pragma mark - Chunks
+
+- (NSInteger)countOfRowsInTable:(NSString *)table {
+    FMDatabase *db = [FMDatabase databaseWithPath:self.databaseURL.path];
+    XCTAssertTrue([db open]);
+    FMResultSet *rs = [db executeQuery:[NSString stringWithFormat:@"select count(*) as c from %@", table]];
+    XCTAssertTrue([rs next]);
+    const NSInteger count = [rs intForColumn:@"c"];
+    [rs close];
+    [db close];
+    return count;
+}
+
+- (void)update:(iTermGraphDatabase *)gdb contents:(NSData *)contents generation:(NSInteger)generation {
+    [gdb updateSynchronously:YES
+                       block:^(iTermGraphEncoder * _Nonnull encoder) {
+        if (!contents) {
+            return;
+        }
+        [encoder encodeChildWithKey:@"Big"
+                         identifier:@""
+                         generation:generation
+                              block:^BOOL(iTermGraphEncoder *subencoder) {
+            [subencoder encodeData:contents forKey:@"contents"];
+            return YES;
+        }];
+    }
+                  completion:nil];
+}
+
+- (void)testChunkBoundariesSurviveAppends {
+    srandom(1);
+    NSMutableData *data = iTermGraphDatabaseTestRandomData(256 * 1024);
+    NSSet<NSData *> *before = iTermGraphDatabaseTestChunkHashes(data);
+    [data appendData:iTermGraphDatabaseTestRandomData(3000)];
+    NSSet<NSData *> *after = iTermGraphDatabaseTestChunkHashes(data);
+
+    NSMutableSet<NSData *> *common = [[before mutableCopy] autorelease];
+    [common intersectSet:after];
+    // Only the last chunk or two may differ.
+    XCTAssertGreaterThan(before.count, 16);
+    XCTAssertGreaterThanOrEqual(common.count, before.count - 2);
+
+    NSUInteger total = 0;
+    for (NSValue *value in [iTermGraphChunkStore chunkRangesForData:data]) {
+        XCTAssertEqual(value.rangeValue.location, total);
+        XCTAssertLessThanOrEqual(value.rangeValue.length, 16384);
+        total += value.rangeValue.length;
+    }
+    XCTAssertEqual(total, data.length);
+}
+
+- (void)testLargeNodesRoundTripThroughChunks {
+    srandom(2);
+    NSData *contents = iTermGraphDatabaseTestRandomData(100 * 1024);
+    iTermGraphDatabase *gdb = [self openGraphDatabase];
+    [self update:gdb contents:contents generation:1];
+    NSDictionary *saved = iTermGraphDatabaseTestFlattened(gdb.record);
+    XCTAssertEqualObjects(saved[@"/[]/Big[]"][@"contents"], contents);
+    [self closeGraphDatabase:gdb];
+
+    FMDatabase *db = [FMDatabase databaseWithPath:self.databaseURL.path];
+    XCTAssertTrue([db open]);
+    FMResultSet *rs = [db executeQuery:@"select data from Node where key=?", @"Big"];
+    XCTAssertTrue([rs next]);
+    XCTAssertTrue([iTermGraphChunkStore isManifest:[rs dataForColumn:@"data"]]);
+    [rs close];
+    [db close];
+    XCTAssertGreaterThan([self countOfRowsInTable:@"Chunk"], 1);
+
+    gdb = [self openGraphDatabase];
+    XCTAssertEqualObjects(iTermGraphDatabaseTestFlattened(gdb.record), saved);
+    [self closeGraphDatabase:gdb];
+}
+
+- (void)testUnreferencedChunksAreDeleted {
+    srandom(3);
+    NSData *first = iTermGraphDatabaseTestRandomData(64 * 1024);
+    NSData *second = iTermGraphDatabaseTestRandomData(64 * 1024);
+    iTermGraphDatabase *gdb = [self openGraphDatabase];
+    [self update:gdb contents:first generation:1];
+    [self update:gdb contents:second generation:2];
+    [self closeGraphDatabase:gdb];
+    XCTAssertEqual([self countOfRowsInTable:@"Chunk"], (NSInteger)iTermGraphDatabaseTestChunkHashes(second).count);
+
+    gdb = [self openGraphDatabase];
+    XCTAssertEqualObjects(iTermGraphDatabaseTestFlattened(gdb.record)[@"/[]/Big[]"][@"contents"], second);
+    [self update:gdb contents:nil generation:3];
+    [self closeGraphDatabase:gdb];
+    XCTAssertEqual([self countOfRowsInTable:@"Chunk"], 0);
+}
+
+// Appends spam to a line buffer, saving it after each burst as session restoration does. Without
+// chunking the growing tail block is rewritten in full on every save.
+- (void)testScrollbackWriteAmplification {
+    srandom(4);
+    LineBuffer *lineBuffer = [[[LineBuffer alloc] init] autorelease];
+    iTermGraphDatabase *gdb = [self openGraphDatabase];
+    screen_char_t line[80];
+    screen_char_t continuation = { 0 };
+    continuation.code = EOL_HARD;
+    NSUInteger bytesAppended = 0;
+    for (NSInteger burst = 0; burst < 200; burst++) {
+        for (NSInteger i = 0; i < 20; i++) {
+            const int length = 1 + random() % 80;
+            memset(line, 0, sizeof(line));
+            for (int j = 0; j < length; j++) {
+                line[j].code = 'A' + random() % 60;
+            }
+            [lineBuffer appendLine:line
+                            length:length
+                           partial:NO
+                             width:80
+                         timestamp:1000000 + burst
+                      continuation:continuation];
+            bytesAppended += length * sizeof(screen_char_t);
+        }
+        [gdb updateSynchronously:YES
+                           block:^(iTermGraphEncoder * _Nonnull encoder) {
+            iTermGraphEncoderAdapter *adapter =
+                [[[iTermGraphEncoderAdapter alloc] initWithGraphEncoder:encoder] autorelease];
+            [adapter encodeDictionaryWithKey:@"LineBuffer"
+                                  generation:iTermGenerationAlwaysEncode
+                                       block:^BOOL(id<iTermEncoderAdapter> subencoder) {
+                [lineBuffer encode:subencoder maxLines:1000000];
+                return YES;
+            }];
+        }
+                      completion:nil];
+    }
+    [self closeGraphDatabase:gdb];
+
+    NSLog(@"Appended %@ bytes of screen chars. Full rewrites would write %@ bytes; chunked saves wrote %@.",
+          @(bytesAppended), @(gdb.bytesEncoded), @(gdb.bytesWritten));
+    XCTAssertLessThan(gdb.bytesWritten * 2, gdb.bytesEncoded);
+}
+
+#pragma mark - Performance
+
+// Loads a saved state of 30 windows with three sessions each and 320k of scrollback per session.
+- (void)testLoadThirtyWindowsPerformance {
+    srandom(5);
+    iTermGraphDatabase *gdb = [self openGraphDatabase];
+    [gdb updateSynchronously:YES
+                       block:^(iTermGraphEncoder * _Nonnull encoder) {
+        iTermGraphDatabaseTestEncodeWindows(encoder, 30, 3, 20);
+    }
+                  completion:nil];
+    NSDictionary *saved = iTermGraphDatabaseTestFlattened(gdb.record);
+    [self closeGraphDatabase:gdb];
+
+    [self measureMetrics:@[ XCTPerformanceMetric_WallClockTime ]
+    automaticallyStartMeasuring:NO
+                  forBlock:^{
+        [self startMeasuring];
+        iTermGraphDatabase *loaded = [self openGraphDatabase];
+        [self stopMeasuring];
+
+        XCTAssertEqual(iTermGraphDatabaseTestFlattened(loaded.record).count, saved.count);
+        [self closeGraphDatabase:loaded];
+    }];
+}
+
+// Saves a graph of 500 sessions from scratch and then with a tenth of them changed.
+- (void)testSaveFiveHundredSessionsPerformance {
+    NSDictionary<NSString *, NSNumber *> *initial = iTermGraphDatabaseTestSessions(500);
+    __block NSInteger generation = 1;
+    [self measureMetrics:@[ XCTPerformanceMetric_WallClockTime ]
+    automaticallyStartMeasuring:NO
+                  forBlock:^{
+        [[[[iTermSqliteDatabaseImpl alloc] initWithURL:self.databaseURL] autorelease] unlink];
+        iTermGraphDatabase *gdb = [self openGraphDatabase];
+
+        [self startMeasuring];
+        [self update:gdb sessions:initial];
+        NSMutableDictionary<NSString *, NSNumber *> *sessions = [[initial mutableCopy] autorelease];
+        for (NSInteger round = 0; round < 10; round++) {
+            generation += 1;
+            for (NSInteger i = round; i < 500; i += 10) {
+                sessions[[NSString stringWithFormat:@"session-%04d", (int)i]] = @(generation);
+            }
+            [self update:gdb sessions:sessions];
+        }
+        [self stopMeasuring];
+
+        [self closeGraphDatabase:gdb];
+    }];
+}
+
+@end
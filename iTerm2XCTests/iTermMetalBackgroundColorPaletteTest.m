@@ -0,0 +1,237 @@
+//
+//  iTermMetalBackgroundColorPaletteTest.m
+//  iTerm2XCTests
+//
+//  Created by George Nachman on 10/18/26.
+//
+
+#import <XCTest/XCTest.h>
+#import "NSColor+iTerm.h"
+#import "ScreenChar.h"
+#import "iTermColorMap.h"
+#import "iTermMetalBackgroundColorPalette.h"
+#import "iTermMetalPerFrameState.h"
+
+static const int iTermMetalBackgroundColorPaletteTestWidth = 400;
+static const int iTermMetalBackgroundColorPaletteTestHeight = 120;
+
+static iTermColorMap *iTermMetalBackgroundColorPaletteTestColorMap(void) {
+    iTermColorMap *colorMap = [[[iTermColorMap alloc] init] autorelease];
+    [colorMap setColor:[NSColor colorWithSRGBRed:0.9 green:0.9 blue:0.9 alpha:1] forKey:kColorMapForeground];
+    [colorMap setColor:[NSColor colorWithSRGBRed:0.1 green:0.15 blue:0.2 alpha:1] forKey:kColorMapBackground];
+    [colorMap setColor:[NSColor colorWithSRGBRed:0.3 green:0.3 blue:0.8 alpha:1] forKey:kColorMapSelection];
+    [colorMap setColor:[NSColor colorWithSRGBRed:1 green:1 blue:1 alpha:1] forKey:kColorMapSelectedText];
+    [colorMap setColor:[NSColor colorWithSRGBRed:0.8 green:0.8 blue:0.2 alpha:1] forKey:kColorMapCursor];
+    for (int i = 0; i < 256; i++) {
+        [colorMap setColor:[NSColor colorWithSRGBRed:(i % 6) / 5.0 green:((i / 6) % 6) / 5.0 blue:((i / 36) % 6) / 5.0 alpha:1]
+                    forKey:kColorMap8bitBase + i];
+    }
+    return colorMap;
+}
+
+static unsigned int iTermMetalBackgroundColorPaletteTestRandom(unsigned int *state) {
+    *state = *state * 1103515245 + 12345;
+    return (*state >> 16) & 0x7fff;
+}
+
+// Fills a row with short runs of every kind of background color, some selected or matched.
+static void iTermMetalBackgroundColorPaletteTestFillLine(screen_char_t *line,
+                                                         iTermMetalBackgroundCellFlags *flags,
+                                                         int width,
+                                                         unsigned int seed) {
+    unsigned int state = seed;
+    memset(line, 0, sizeof(*line) * width);
+    int x = 0;
+    while (x < width) {
+        screen_char_t c = { 0 };
+        c.code = 'x';
+        iTermMetalBackgroundCellFlags cellFlags = 0;
+        switch (iTermMetalBackgroundColorPaletteTestRandom(&state) % 6) {
+            case 0:
+                c.backgroundColorMode = ColorModeAlternate;
+                c.backgroundColor = iTermMetalBackgroundColorPaletteTestRandom(&state) % (ALTSEM_SYSTEM_MESSAGE + 1);
+                break;
+            case 1:
+            case 2:
+                c.backgroundColorMode = ColorModeNormal;
+                c.backgroundColor = iTermMetalBackgroundColorPaletteTestRandom(&state) % 256;
+                break;
+            case 3:
+                c.backgroundColorMode = ColorMode24bit;
+                c.backgroundColor = iTermMetalBackgroundColorPaletteTestRandom(&state) % 256;
+                c.bgGreen = iTermMetalBackgroundColorPaletteTestRandom(&state) % 256;
+                c.bgBlue = iTermMetalBackgroundColorPaletteTestRandom(&state) % 256;
+                break;
+            case 4:
+                c.backgroundColorMode = ColorModeNormal;
+                c.backgroundColor = iTermMetalBackgroundColorPaletteTestRandom(&state) % 16;
+                c.image = (iTermMetalBackgroundColorPaletteTestRandom(&state) % 4) == 0;
+                break;
+            case 5:
+                c.backgroundColorMode = ColorModeAlternate;
+                c.backgroundColor = ALTSEM_DEFAULT;
+                cellFlags = iTermMetalBackgroundColorPaletteTestRandom(&state) % 4;
+                break;
+        }
+        const int length = MIN(width - x, 1 + (int)(iTermMetalBackgroundColorPaletteTestRandom(&state) % 8));
+        for (int i = 0; i < length; i++) {
+            line[x + i] = c;
+            flags[x + i] = cellFlags;
+        }
+        x += length;
+    }
+}
+
+static BOOL iTermMetalBackgroundColorPaletteTestSameBackground(const screen_char_t *a,
+                                                              iTermMetalBackgroundCellFlags aFlags,
+                                                              const screen_char_t *b,
+                                                              iTermMetalBackgroundCellFlags bFlags) {
+    return (a->backgroundColor == b->backgroundColor &&
+            a->bgGreen == b->bgGreen &&
+            a->bgBlue == b->bgBlue &&
+            a->backgroundColorMode == b->backgroundColorMode &&
+            a->image == b->image &&
+            aFlags == bFlags);
+}
+
+@interface iTermMetalBackgroundColorPaletteTest : XCTestCase
+@end
+
+@implementation iTermMetalBackgroundColorPaletteTest
+
+- (void)assertColor:(vector_float4)actual equals:(vector_float4)expected {
+    XCTAssertEqualWithAccuracy(actual.x, expected.x, 1e-5);
+    XCTAssertEqualWithAccuracy(actual.y, expected.y, 1e-5);
+    XCTAssertEqualWithAccuracy(actual.z, expected.z, 1e-5);
+    XCTAssertEqualWithAccuracy(actual.w, expected.w, 1e-5);
+}
+
+// Compares every cell's colors from the palette against the per-cell path.
+- (void)assertRunsMatchScalarPathWithColorMap:(iTermColorMap *)colorMap {
+    const int width = iTermMetalBackgroundColorPaletteTestWidth;
+    iTermMetalPerFrameState *state = [[[iTermMetalPerFrameState alloc] initWithColorMap:colorMap
+                                                                                   rows:@[]
+                                                                                  width:width
+                                                                               rowCache:nil] autorelease];
+    screen_char_t line[width];
+    iTermMetalBackgroundCellFlags flags[width];
+    iTermMetalBackgroundColorRLE runs[width];
+    vector_float4 unprocessedColors[width];
+
+    for (unsigned int seed = 1; seed <= 20; seed++) {
+        iTermMetalBackgroundColorPaletteTestFillLine(line, flags, width, seed);
+        const int count = iTermMetalBackgroundColorPaletteGetRuns(state.backgroundColorPalette,
+                                                                  line,
+                                                                  flags,
+                                                                  width,
+                                                                  runs,
+                                                                  unprocessedColors);
+        int x = 0;
+        for (int i = 0; i < count; i++) {
+            XCTAssertEqual(runs[i].origin, x);
+            XCTAssertGreaterThan(runs[i].count, 0);
+            if (x > 0) {
+                XCTAssertFalse(iTermMetalBackgroundColorPaletteTestSameBackground(&line[x - 1], flags[x - 1], &line[x], flags[x]));
+            }
+            for (int j = x; j < x + runs[i].count; j++) {
+                XCTAssertTrue(iTermMetalBackgroundColorPaletteTestSameBackground(&line[x], flags[x], &line[j], flags[j]));
+                const vector_float4 expected =
+                    [state unprocessedBackgroundColorForCharacter:line[j]
+                                                         selected:!!(flags[j] & iTermMetalBackgroundCellFlagSelected)
+                                                        findMatch:!!(flags[j] & iTermMetalBackgroundCellFlagFindMatch)];
+                [self assertColor:unprocessedColors[i] equals:expected];
+                [self assertColor:runs[i].color equals:[colorMap fastProcessedBackgroundColorForBackgroundColor:expected]];
+            }
+            x += runs[i].count;
+        }
+        XCTAssertEqual(x, width);
+    }
+}
+
+- (void)testRunsMatchScalarPath {
+    [self assertRunsMatchScalarPathWithColorMap:iTermMetalBackgroundColorPaletteTestColorMap()];
+}
+
+- (void)testRunsMatchScalarPathWhenMutedAndDimmed {
+    iTermColorMap *colorMap = iTermMetalBackgroundColorPaletteTestColorMap();
+    colorMap.mutingAmount = 0.3;
+    colorMap.dimmingAmount = 0.4;
+    [self assertRunsMatchScalarPathWithColorMap:colorMap];
+}
+
+- (void)testRunsMatchScalarPathWhenDimmingOnlyText {
+    iTermColorMap *colorMap = iTermMetalBackgroundColorPaletteTestColorMap();
+    colorMap.dimOnlyText = YES;
+    colorMap.dimmingAmount = 0.4;
+    [self assertRunsMatchScalarPathWithColorMap:colorMap];
+}
+
+#pragma mark - Performance
+
+// Resolves the background colors of a 400x120 grid 30 times, either with the palette or by one
+// message send per run as rows used to.
+- (void)measureBackgroundColorsWithPalette:(BOOL)usePalette {
+    const int width = iTermMetalBackgroundColorPaletteTestWidth;
+    const int height = iTermMetalBackgroundColorPaletteTestHeight;
+    iTermColorMap *colorMap = iTermMetalBackgroundColorPaletteTestColorMap();
+    colorMap.dimmingAmount = 0.2;
+    iTermMetalPerFrameState *state = [[[iTermMetalPerFrameState alloc] initWithColorMap:colorMap
+                                                                                   rows:@[]
+                                                                                  width:width
+                                                                               rowCache:nil] autorelease];
+    screen_char_t *lines = calloc(width * height, sizeof(screen_char_t));
+    iTermMetalBackgroundCellFlags *flags = calloc(width * height, sizeof(iTermMetalBackgroundCellFlags));
+    for (int y = 0; y < height; y++) {
+        iTermMetalBackgroundColorPaletteTestFillLine(lines + y * width, flags + y * width, width, y + 1);
+    }
+    iTermMetalBackgroundColorRLE *runs = calloc(width, sizeof(*runs));
+    vector_float4 *unprocessedColors = calloc(width, sizeof(*unprocessedColors));
+
+    [self measureBlock:^{
+        for (int frame = 0; frame < 30; frame++) {
+            for (int y = 0; y < height; y++) {
+                const screen_char_t *line = lines + y * width;
+                const iTermMetalBackgroundCellFlags *lineFlags = flags + y * width;
+                if (usePalette) {
+                    iTermMetalBackgroundColorPaletteGetRuns(state.backgroundColorPalette,
+                                                            line,
+                                                            lineFlags,
+                                                            width,
+                                                            runs,
+                                                            unprocessedColors);
+                    continue;
+                }
+                int count = 0;
+                for (int x = 0; x < width; x++) {
+                    if (x > 0 && iTermMetalBackgroundColorPaletteTestSameBackground(&line[x - 1], lineFlags[x - 1], &line[x], lineFlags[x])) {
+                        runs[count - 1].count++;
+                        continue;
+                    }
+                    unprocessedColors[count] =
+                        [state unprocessedBackgroundColorForCharacter:line[x]
+                                                             selected:!!(lineFlags[x] & iTermMetalBackgroundCellFlagSelected)
+                                                            findMatch:!!(lineFlags[x] & iTermMetalBackgroundCellFlagFindMatch)];
+                    runs[count].color = [colorMap fastProcessedBackgroundColorForBackgroundColor:unprocessedColors[count]];
+                    runs[count].origin = x;
+                    runs[count].count = 1;
+                    count++;
+                }
+            }
+        }
+    }];
+
+    free(lines);
+    free(flags);
+    free(runs);
+    free(unprocessedColors);
+}
+
+- (void)testBackgroundColorPalettePerformance {
+    [self measureBackgroundColorsWithPalette:YES];
+}
+
+- (void)testScalarBackgroundColorPerformance {
+    [self measureBackgroundColorsWithPalette:NO];
+}
+
+@end
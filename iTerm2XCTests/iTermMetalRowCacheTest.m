@@ -0,0 +1,270 @@
+//
+//  iTermMetalRowCacheTest.m
+//  iTerm2XCTests
+//
+//  Created by George Nachman on 10/18/26.
+//
+
+#import <XCTest/XCTest.h>
+#import "NSColor+iTerm.h"
+#import "ScreenChar.h"
+#import "iTermColorMap.h"
+#import "iTermData.h"
+#import "iTermMetalPerFrameState.h"
+#import "iTermMetalPerFrameStateRow.h"
+#import "iTermMetalRowCache.h"
+
+static iTermColorMap *iTermMetalRowCacheTestColorMap(void) {
+    iTermColorMap *colorMap = [[[iTermColorMap alloc] init] autorelease];
+    [colorMap setColor:[NSColor colorWithSRGBRed:0.9 green:0.9 blue:0.9 alpha:1] forKey:kColorMapForeground];
+    [colorMap setColor:[NSColor colorWithSRGBRed:0.1 green:0.1 blue:0.1 alpha:1] forKey:kColorMapBackground];
+    [colorMap setColor:[NSColor colorWithSRGBRed:0.3 green:0.3 blue:0.8 alpha:1] forKey:kColorMapSelection];
+    [colorMap setColor:[NSColor colorWithSRGBRed:1 green:1 blue:1 alpha:1] forKey:kColorMapSelectedText];
+    [colorMap setColor:[NSColor colorWithSRGBRed:1 green:1 blue:1 alpha:1] forKey:kColorMapBold];
+    [colorMap setColor:[NSColor colorWithSRGBRed:0 green:0 blue:1 alpha:1] forKey:kColorMapLink];
+    for (int i = 0; i < 256; i++) {
+        [colorMap setColor:[NSColor colorWithSRGBRed:(i % 6) / 5.0 green:((i / 6) % 6) / 5.0 blue:((i / 36) % 6) / 5.0 alpha:1]
+                    forKey:kColorMap8bitBase + i];
+    }
+    return colorMap;
+}
+
+// A row of text in runs of a few colors, like the output of ls or a compiler.
+static iTermData *iTermMetalRowCacheTestLine(int width, int seed) {
+    iTermData *data = [iTermScreenCharData dataOfLength:(width + 1) * sizeof(screen_char_t)];
+    screen_char_t *line = data.mutableBytes;
+    memset(line, 0, (width + 1) * sizeof(screen_char_t));
+    const int length = (seed * 37) % width;
+    for (int x = 0; x < width; x++) {
+        line[x].code = x < length ? 'A' + (x + seed) % 58 : 0;
+        line[x].foregroundColorMode = ColorModeNormal;
+        line[x].foregroundColor = ((x / 12) + seed) % 8;
+        line[x].bold = ((x / 20) % 3 == 0);
+        line[x].backgroundColorMode = ColorModeAlternate;
+        line[x].backgroundColor = ALTSEM_DEFAULT;
+        if ((x / 40 + seed) % 5 == 0) {
+            line[x].backgroundColorMode = ColorModeNormal;
+            line[x].backgroundColor = seed % 16;
+        }
+    }
+    line[width].code = EOL_HARD;
+    return data;
+}
+
+static NSArray<iTermMetalPerFrameStateRow *> *iTermMetalRowCacheTestRows(int width, int count, int firstSeed) {
+    NSMutableArray<iTermMetalPerFrameStateRow *> *rows = [NSMutableArray array];
+    for (int i = 0; i < count; i++) {
+        iTermMetalPerFrameStateRow *row =
+            [[[iTermMetalPerFrameStateRow alloc] initWithScreenCharLine:iTermMetalRowCacheTestLine(width, firstSeed + i)
+                                                       selectedIndexSet:nil] autorelease];
+        [rows addObject:row];
+    }
+    return rows;
+}
+
+// Does the CPU-side work of preparing a frame's rows and returns everything that was output.
+static NSData *iTermMetalRowCacheTestPrepareFrame(iTermColorMap *colorMap,
+                                                  NSArray<iTermMetalPerFrameStateRow *> *rows,
+                                                  int width,
+                                                  iTermMetalRowCache *rowCache) {
+    iTermMetalPerFrameState *state = [[[iTermMetalPerFrameState alloc] initWithColorMap:colorMap
+                                                                                   rows:rows
+                                                                                  width:width
+                                                                               rowCache:rowCache] autorelease];
+    NSMutableData *result = [NSMutableData data];
+    iTermMetalGlyphKey *glyphKeys = calloc(width, sizeof(*glyphKeys));
+    iTermMetalGlyphAttributes *attributes = calloc(width, sizeof(*attributes));
+    iTermMetalBackgroundColorRLE *background = calloc(width, sizeof(*background));
+    for (int y = 0; y < rows.count; y++) {
+        memset(glyphKeys, 0, width * sizeof(*glyphKeys));
+        memset(attributes, 0, width * sizeof(*attributes));
+        memset(background, 0, width * sizeof(*background));
+        int rleCount = 0;
+        int drawableGlyphs = 0;
+        iTermMarkStyle markStyle;
+        NSDate *date = nil;
+        NSMutableArray<iTermMetalImageRun *> *imageRuns = [NSMutableArray array];
+        [state metalGetGlyphKeys:glyphKeys
+                      attributes:attributes
+                       imageRuns:imageRuns
+                      background:background
+                        rleCount:&rleCount
+                       markStyle:&markStyle
+                             row:y
+                           width:width
+                  drawableGlyphs:&drawableGlyphs
+                            date:&date];
+        [result appendBytes:glyphKeys length:width * sizeof(*glyphKeys)];
+        [result appendBytes:attributes length:width * sizeof(*attributes)];
+        [result appendBytes:background length:rleCount * sizeof(*background)];
+        [result appendBytes:&rleCount length:sizeof(rleCount)];
+        [result appendBytes:&drawableGlyphs length:sizeof(drawableGlyphs)];
+    }
+    free(glyphKeys);
+    free(attributes);
+    free(background);
+    return result;
+}
+
+@interface iTermMetalRowCacheTest : XCTestCase
+@end
+
+@implementation iTermMetalRowCacheTest
+
+- (void)testCachedRowsMatchFreshlyComputedRows {
+    iTermColorMap *colorMap = iTermMetalRowCacheTestColorMap();
+    NSArray<iTermMetalPerFrameStateRow *> *rows = iTermMetalRowCacheTestRows(80, 24, 0);
+    iTermMetalRowCache *rowCache = [[[iTermMetalRowCache alloc] init] autorelease];
+
+    NSData *first = iTermMetalRowCacheTestPrepareFrame(colorMap, rows, 80, rowCache);
+    XCTAssertEqual(rowCache.misses, 24);
+    XCTAssertEqual(rowCache.hits, 0);
+
+    NSData *second = iTermMetalRowCacheTestPrepareFrame(colorMap, rows, 80, rowCache);
+    XCTAssertEqual(rowCache.hits, 24);
+
+    NSData *uncached = iTermMetalRowCacheTestPrepareFrame(colorMap, rows, 80, nil);
+    XCTAssertEqualObjects(first, uncached);
+    XCTAssertEqualObjects(second, uncached);
+}
+
+- (void)testScrolledRowsAreReused {
+    iTermColorMap *colorMap = iTermMetalRowCacheTestColorMap();
+    iTermMetalRowCache *rowCache = [[[iTermMetalRowCache alloc] init] autorelease];
+    iTermMetalRowCacheTestPrepareFrame(colorMap, iTermMetalRowCacheTestRows(80, 24, 0), 80, rowCache);
+
+    NSArray<iTermMetalPerFrameStateRow *> *scrolled = iTermMetalRowCacheTestRows(80, 24, 1);
+    NSData *cached = iTermMetalRowCacheTestPrepareFrame(colorMap, scrolled, 80, rowCache);
+    XCTAssertEqual(rowCache.hits, 23);
+    XCTAssertEqualObjects(cached, iTermMetalRowCacheTestPrepareFrame(colorMap, scrolled, 80, nil));
+}
+
+- (void)testSelectionChangeInvalidatesOnlyItsRow {
+    iTermColorMap *colorMap = iTermMetalRowCacheTestColorMap();
+    iTermMetalRowCache *rowCache = [[[iTermMetalRowCache alloc] init] autorelease];
+    NSMutableArray<iTermMetalPerFrameStateRow *> *rows = [[iTermMetalRowCacheTestRows(80, 24, 0) mutableCopy] autorelease];
+    iTermMetalRowCacheTestPrepareFrame(colorMap, rows, 80, rowCache);
+
+    rows[5] = [[[iTermMetalPerFrameStateRow alloc] initWithScreenCharLine:iTermMetalRowCacheTestLine(80, 5)
+                                                         selectedIndexSet:[NSIndexSet indexSetWithIndexesInRange:NSMakeRange(3, 10)]] autorelease];
+    NSData *cached = iTermMetalRowCacheTestPrepareFrame(colorMap, rows, 80, rowCache);
+    XCTAssertEqual(rowCache.hits, 23);
+    XCTAssertEqual(rowCache.misses, 25);
+    XCTAssertEqualObjects(cached, iTermMetalRowCacheTestPrepareFrame(colorMap, rows, 80, nil));
+}
+
+- (void)testColorChangeInvalidatesEveryRow {
+    iTermColorMap *colorMap = iTermMetalRowCacheTestColorMap();
+    iTermMetalRowCache *rowCache = [[[iTermMetalRowCache alloc] init] autorelease];
+    NSArray<iTermMetalPerFrameStateRow *> *rows = iTermMetalRowCacheTestRows(80, 24, 0);
+    iTermMetalRowCacheTestPrepareFrame(colorMap, rows, 80, rowCache);
+
+    const NSUInteger generation = colorMap.generation;
+    [colorMap setColor:[NSColor colorWithSRGBRed:1 green:0 blue:0 alpha:1] forKey:kColorMap8bitBase + 1];
+    XCTAssertNotEqual(colorMap.generation, generation);
+    NSData *cached = iTermMetalRowCacheTestPrepareFrame(colorMap, rows, 80, rowCache);
+    XCTAssertEqual(rowCache.hits, 0);
+    XCTAssertEqualObjects(cached, iTermMetalRowCacheTestPrepareFrame(colorMap, rows, 80, nil));
+}
+
+- (void)testEntriesOutliveAFewFramesAndSurviveChurn {
+    iTermMetalRowCache *rowCache = [[[iTermMetalRowCache alloc] init] autorelease];
+    [rowCache beginFrameWithWidth:4 rows:2];
+    iTermMetalGlyphKey glyphKeys[4] = { { .code = 'x', .drawable = YES } };
+    iTermMetalGlyphAttributes attributes[4] = { { 0 } };
+    iTermMetalBackgroundColorRLE background[4] = { { .origin = 0, .count = 4 } };
+    const iTermMetalRowCacheKey key = { .content = 1, .decorations = 2, .settings = 3 };
+    [rowCache setGlyphKeys:glyphKeys attributes:attributes background:background rleCount:1 drawableGlyphs:1 forKey:key];
+
+    // Fill the cache with many other rows over many frames. The first entry can be replaced but
+    // never returns wrong data.
+    for (int frame = 0; frame < 50; frame++) {
+        [rowCache beginFrameWithWidth:4 rows:2];
+        for (uint64_t i = 0; i < 20; i++) {
+            const iTermMetalRowCacheKey other = { .content = frame * 100 + i + 10, .decorations = 2, .settings = 3 };
+            [rowCache setGlyphKeys:glyphKeys attributes:attributes background:background rleCount:1 drawableGlyphs:1 forKey:other];
+        }
+    }
+
+    iTermMetalGlyphKey outKeys[4];
+    iTermMetalGlyphAttributes outAttributes[4];
+    iTermMetalBackgroundColorRLE outBackground[4];
+    int rleCount = 0;
+    int drawableGlyphs = 0;
+    const iTermMetalRowCacheKey recent = { .content = 49 * 100 + 19 + 10, .decorations = 2, .settings = 3 };
+    XCTAssertTrue([rowCache getGlyphKeys:outKeys attributes:outAttributes background:outBackground rleCount:&rleCount drawableGlyphs:&drawableGlyphs forKey:recent]);
+    XCTAssertEqual(outKeys[0].code, 'x');
+    XCTAssertEqual(rleCount, 1);
+    XCTAssertEqual(outBackground[0].count, 4);
+
+    // Changing the width empties the cache.
+    [rowCache beginFrameWithWidth:5 rows:2];
+    XCTAssertFalse([rowCache getGlyphKeys:outKeys attributes:outAttributes background:outBackground rleCount:&rleCount drawableGlyphs:&drawableGlyphs forKey:recent]);
+}
+
+- (void)testHashCollisionIsAMiss {
+    iTermMetalRowCache *rowCache = [[[iTermMetalRowCache alloc] init] autorelease];
+    [rowCache beginFrameWithWidth:4 rows:2];
+    iTermMetalGlyphKey glyphKeys[4] = { { .code = 'x', .drawable = YES } };
+    iTermMetalGlyphAttributes attributes[4] = { { 0 } };
+    iTermMetalBackgroundColorRLE background[4] = { { .origin = 0, .count = 4 } };
+    const char stored[] = "abcd";
+    const iTermMetalRowCacheKey key = { .content = 1, .decorations = 2, .settings = 3, .bytes = stored, .length = 4 };
+    [rowCache setGlyphKeys:glyphKeys attributes:attributes background:background rleCount:1 drawableGlyphs:1 forKey:key];
+
+    iTermMetalGlyphKey outKeys[4];
+    iTermMetalGlyphAttributes outAttributes[4];
+    iTermMetalBackgroundColorRLE outBackground[4];
+    int rleCount = 0;
+    int drawableGlyphs = 0;
+
+    // Same hashes, different bytes.
+    const char colliding[] = "abce";
+    const iTermMetalRowCacheKey collision = { .content = 1, .decorations = 2, .settings = 3, .bytes = colliding, .length = 4 };
+    XCTAssertFalse([rowCache getGlyphKeys:outKeys attributes:outAttributes background:outBackground rleCount:&rleCount drawableGlyphs:&drawableGlyphs forKey:collision]);
+
+    // The cache keeps its own copy of the bytes.
+    char copy[] = "abcd";
+    const iTermMetalRowCacheKey same = { .content = 1, .decorations = 2, .settings = 3, .bytes = copy, .length = 4 };
+    XCTAssertTrue([rowCache getGlyphKeys:outKeys attributes:outAttributes background:outBackground rleCount:&rleCount drawableGlyphs:&drawableGlyphs forKey:same]);
+    XCTAssertEqual(outKeys[0].code, 'x');
+}
+
+#pragma mark - Performance
+
+// Prepares 30 frames of a 400x120 grid. When scrolling, every frame has one new row at the bottom.
+- (void)measureFramePreparationScrolling:(BOOL)scrolling cached:(BOOL)cached {
+    const int width = 400;
+    const int height = 120;
+    const int frames = 30;
+    iTermColorMap *colorMap = iTermMetalRowCacheTestColorMap();
+    NSArray<iTermMetalPerFrameStateRow *> *allRows = iTermMetalRowCacheTestRows(width, height + frames, 0);
+    [self measureBlock:^{
+        iTermMetalRowCache *rowCache = cached ? [[[iTermMetalRowCache alloc] init] autorelease] : nil;
+        for (int frame = 0; frame < frames; frame++) {
+            @autoreleasepool {
+                NSArray<iTermMetalPerFrameStateRow *> *rows =
+                    [allRows subarrayWithRange:NSMakeRange(scrolling ? frame : 0, height)];
+                iTermMetalRowCacheTestPrepareFrame(colorMap, rows, width, rowCache);
+            }
+        }
+    }];
+}
+
+- (void)testStaticFramePreparationPerformance {
+    [self measureFramePreparationScrolling:NO cached:YES];
+}
+
+- (void)testStaticFramePreparationWithoutCachePerformance {
+    [self measureFramePreparationScrolling:NO cached:NO];
+}
+
+- (void)testScrollingFramePreparationPerformance {
+    [self measureFramePreparationScrolling:YES cached:YES];
+}
+
+- (void)testScrollingFramePreparationWithoutCachePerformance {
+    [self measureFramePreparationScrolling:YES cached:NO];
+}
+
+@end
@@ -0,0 +1,574 @@
+//
+//  iTermMultiServerProtocolTest.m
+//  iTerm2XCTests
+//
+//  Created by George Nachman on 10/18/26.
+//
+
+#import <XCTest/XCTest.h>
+#import "iTermClientServerProtocol.h"
+#import "iTermMultiServerProtocol.h"
+
+#include <sys/wait.h>
+#include <util.h>
+
+static const char *iTermMultiServerProtocolTestArgv[] = { "/bin/sh", "-c", "echo ready; sleep 1", NULL };
+static const char *iTermMultiServerProtocolTestEnvp[] = { "PATH=/usr/bin:/bin", "LANG=C", NULL };
+
+static iTermMultiServerRequestLaunch iTermMultiServerProtocolTestLaunch(unsigned long long uniqueId) {
+    return (iTermMultiServerRequestLaunch){
+        .path = "/bin/sh",
+        .argv = iTermMultiServerProtocolTestArgv,
+        .argc = 3,
+        .envp = iTermMultiServerProtocolTestEnvp,
+        .envc = 2,
+        .columns = 80,
+        .rows = 24,
+        .pixel_width = 800,
+        .pixel_height = 480,
+        .isUTF8 = 1,
+        .pwd = "/tmp",
+        .uniqueId = uniqueId
+    };
+}
+
+// Writes a message the way both ends of the real connection do: length, then payload.
+static BOOL iTermMultiServerProtocolTestWrite(int fd,
+                                              iTermClientServerProtocolMessage *message,
+                                              const int *fds,
+                                              int numberOfFileDescriptors) {
+    int error = 0;
+    if (numberOfFileDescriptors > 0) {
+        return iTermFileDescriptorServerWriteLengthAndBufferAndFileDescriptors(fd,
+                                                                               message->ioVectors[0].iov_base,
+                                                                               message->ioVectors[0].iov_len,
+                                                                               fds,
+                                                                               numberOfFileDescriptors,
+                                                                               &error) > 0;
+    }
+    return iTermFileDescriptorServerWriteLengthAndBuffer(fd,
+                                                         message->ioVectors[0].iov_base,
+                                                         message->ioVectors[0].iov_len,
+                                                         &error) > 0;
+}
+
+// Reads a message from the server the way iTermFileDescriptorMultiClient does: the length, then the
+// payload, keeping the control message from whichever recvmsg carried it.
+static BOOL iTermMultiServerProtocolTestReadFromServer(int fd, iTermMultiServerServerOriginatedMessage *out) {
+    size_t length = 0;
+    if (read(fd, &length, sizeof(length)) != sizeof(length)) {
+        return NO;
+    }
+    iTermClientServerProtocolMessage message;
+    iTermClientServerProtocolMessageInitialize(&message);
+    iTermClientServerProtocolMessageEnsureSpace(&message, length);
+    size_t offset = 0;
+    iTermFileDescriptorMultiControlMessage control;
+    memset(&control, 0, sizeof(control));
+    while (offset < length) {
+        iTermClientServerProtocolMessage chunk;
+        const ssize_t n = iTermMultiServerReadMessage(fd, &chunk, length - offset);
+        if (n <= 0) {
+            iTermClientServerProtocolMessageFree(&message);
+            return NO;
+        }
+        if (chunk.controlBuffer.cm.cmsg_len > 0) {
+            control = chunk.controlBuffer;
+        }
+        memmove(message.ioVectors[0].iov_base + offset, chunk.ioVectors[0].iov_base, n);
+        offset += n;
+        iTermClientServerProtocolMessageFree(&chunk);
+    }
+    message.controlBuffer = control;
+    const int status = iTermMultiServerProtocolParseMessageFromServer(&message, out);
+    iTermClientServerProtocolMessageFree(&message);
+    return status == 0;
+}
+
+static int iTermMultiServerProtocolTestLaunchChild(const iTermMultiServerRequestLaunch *launch, pid_t *pidOut) {
+    struct winsize win = { .ws_col = launch->columns, .ws_row = launch->rows };
+    int fd = -1;
+    const pid_t pid = forkpty(&fd, NULL, NULL, &win);
+    if (pid == 0) {
+        execve(launch->path, (char **)launch->argv, (char **)launch->envp);
+        _exit(1);
+    }
+    *pidOut = pid;
+    return pid < 0 ? -1 : fd;
+}
+
+// A stand-in for iTermFileDescriptorMultiServer's request loop. It only handles launches.
+static void iTermMultiServerProtocolTestServe(int fd) {
+    while (YES) {
+        iTermClientServerProtocolMessage message;
+        if (iTermMultiServerRead(fd, &message)) {
+            break;
+        }
+        iTermMultiServerClientOriginatedMessage request;
+        const int status = iTermMultiServerProtocolParseMessageFromClient(&message, &request);
+        iTermClientServerProtocolMessageFree(&message);
+        if (status) {
+            break;
+        }
+
+        iTermMultiServerRequestLaunch *launches;
+        int count;
+        if (request.type == iTermMultiServerRPCTypeLaunchBatch) {
+            launches = request.payload.launchBatch.launches;
+            count = request.payload.launchBatch.count;
+        } else {
+            launches = &request.payload.launch;
+            count = 1;
+        }
+        iTermMultiServerResponseLaunch responses[iTermMultiServerMaximumLaunchBatchSize];
+        int fds[iTermMultiServerMaximumLaunchBatchSize];
+        int numberOfFileDescriptors = 0;
+        for (int i = 0; i < count; i++) {
+            pid_t pid = 0;
+            const int masterFd = iTermMultiServerProtocolTestLaunchChild(&launches[i], &pid);
+            responses[i] = (iTermMultiServerResponseLaunch){
+                .status = masterFd < 0 ? -1 : 0,
+                .pid = pid,
+                .fd = masterFd,
+                .uniqueId = launches[i].uniqueId,
+                .tty = ""
+            };
+            if (masterFd >= 0) {
+                fds[numberOfFileDescriptors++] = masterFd;
+            }
+        }
+
+        iTermMultiServerServerOriginatedMessage response;
+        memset(&response, 0, sizeof(response));
+        if (request.type == iTermMultiServerRPCTypeLaunchBatch) {
+            response.type = iTermMultiServerRPCTypeLaunchBatch;
+            response.payload.launchBatch.count = count;
+            response.payload.launchBatch.launches = responses;
+        } else {
+            response.type = iTermMultiServerRPCTypeLaunch;
+            response.payload.launch = responses[0];
+        }
+        iTermClientServerProtocolMessage encoded;
+        iTermClientServerProtocolMessageInitialize(&encoded);
+        const BOOL ok = (iTermMultiServerProtocolEncodeMessageFromServer(&response, &encoded) == 0 &&
+                         iTermMultiServerProtocolTestWrite(fd, &encoded, fds, numberOfFileDescriptors));
+        iTermClientServerProtocolMessageFree(&encoded);
+        for (int i = 0; i < numberOfFileDescriptors; i++) {
+            close(fds[i]);
+        }
+        iTermMultiServerClientOriginatedMessageFree(&request);
+        if (!ok) {
+            break;
+        }
+    }
+    close(fd);
+}
+
+@interface iTermMultiServerProtocolTest : XCTestCase
+@end
+
+@implementation iTermMultiServerProtocolTest
+
+- (void)testLaunchBatchRequestRoundTrip {
+    iTermMultiServerRequestLaunch launches[3];
+    for (int i = 0; i < 3; i++) {
+        launches[i] = iTermMultiServerProtocolTestLaunch(100 + i);
+        launches[i].columns = 80 + i;
+    }
+    iTermMultiServerClientOriginatedMessage request = {
+        .type = iTermMultiServerRPCTypeLaunchBatch,
+        .payload = {
+            .launchBatch = {
+                .count = 3,
+                .launches = launches
+            }
+        }
+    };
+    iTermClientServerProtocolMessage message;
+    iTermClientServerProtocolMessageInitialize(&message);
+    XCTAssertEqual(iTermMultiServerProtocolEncodeMessageFromClient(&request, &message), 0);
+
+    iTermMultiServerClientOriginatedMessage decoded;
+    XCTAssertEqual(iTermMultiServerProtocolParseMessageFromClient(&message, &decoded), 0);
+    XCTAssertEqual(decoded.type, iTermMultiServerRPCTypeLaunchBatch);
+    XCTAssertEqual(decoded.payload.launchBatch.count, 3);
+    for (int i = 0; i < 3; i++) {
+        const iTermMultiServerRequestLaunch *launch = &decoded.payload.launchBatch.launches[i];
+        XCTAssertEqual(strcmp(launch->path, "/bin/sh"), 0);
+        XCTAssertEqual(launch->argc, 3);
+        XCTAssertEqual(strcmp(launch->argv[2], iTermMultiServerProtocolTestArgv[2]), 0);
+        XCTAssertEqual(launch->envc, 2);
+        XCTAssertEqual(strcmp(launch->envp[1], "LANG=C"), 0);
+        XCTAssertEqual(launch->columns, 80 + i);
+        XCTAssertEqual(launch->rows, 24);
+        XCTAssertEqual(strcmp(launch->pwd, "/tmp"), 0);
+        XCTAssertEqual(launch->uniqueId, 100ULL + i);
+    }
+    iTermMultiServerClientOriginatedMessageFree(&decoded);
+    iTermClientServerProtocolMessageFree(&message);
+}
+
+- (void)testLaunchBatchRequestWithInvalidCountIsRejected {
+    iTermMultiServerRequestLaunch launches[iTermMultiServerMaximumLaunchBatchSize + 1];
+    for (int i = 0; i < iTermMultiServerMaximumLaunchBatchSize + 1; i++) {
+        launches[i] = iTermMultiServerProtocolTestLaunch(i);
+    }
+    for (NSNumber *count in @[ @0, @(iTermMultiServerMaximumLaunchBatchSize + 1) ]) {
+        iTermMultiServerClientOriginatedMessage request = {
+            .type = iTermMultiServerRPCTypeLaunchBatch,
+            .payload = {
+                .launchBatch = {
+                    .count = count.intValue,
+                    .launches = launches
+                }
+            }
+        };
+        iTermClientServerProtocolMessage message;
+        iTermClientServerProtocolMessageInitialize(&message);
+        XCTAssertEqual(iTermMultiServerProtocolEncodeMessageFromClient(&request, &message), 0);
+
+        iTermMultiServerClientOriginatedMessage decoded;
+        XCTAssertNotEqual(iTermMultiServerProtocolParseMessageFromClient(&message, &decoded), 0);
+        iTermMultiServerClientOriginatedMessageFree(&decoded);
+        iTermClientServerProtocolMessageFree(&message);
+    }
+}
+
+// Messages bigger than the initial buffer must grow it rather than truncate it.
+- (void)testEncodingMessageLargerThanInitialBuffer {
+    const int envc = 2000;
+    const char **envp = calloc(envc + 1, sizeof(char *));
+    char value[100];
+    memset(value, 'x', sizeof(value) - 1);
+    value[sizeof(value) - 1] = '\0';
+    for (int i = 0; i < envc; i++) {
+        envp[i] = value;
+    }
+    iTermMultiServerClientOriginatedMessage request = {
+        .type = iTermMultiServerRPCTypeLaunch,
+        .payload = {
+            .launch = iTermMultiServerProtocolTestLaunch(1)
+        }
+    };
+    request.payload.launch.envp = envp;
+    request.payload.launch.envc = envc;
+
+    iTermClientServerProtocolMessage message;
+    iTermClientServerProtocolMessageInitialize(&message);
+    XCTAssertEqual(iTermMultiServerProtocolEncodeMessageFromClient(&request, &message), 0);
+    XCTAssertGreaterThan(message.ioVectors[0].iov_len, envc * sizeof(value));
+
+    iTermMultiServerClientOriginatedMessage decoded;
+    XCTAssertEqual(iTermMultiServerProtocolParseMessageFromClient(&message, &decoded), 0);
+    XCTAssertEqual(decoded.payload.launch.envc, envc);
+    XCTAssertEqual(strcmp(decoded.payload.launch.envp[envc - 1], value), 0);
+    iTermMultiServerClientOriginatedMessageFree(&decoded);
+    iTermClientServerProtocolMessageFree(&message);
+    free(envp);
+}
+
+// File descriptors go to the successful launches in order. Failed launches get none.
+- (void)testLaunchBatchResponsePassesFileDescriptorsInOneMessage {
+    int sockets[2];
+    XCTAssertEqual(socketpair(AF_UNIX, SOCK_STREAM, 0, sockets), 0);
+    int first[2];
+    int second[2];
+    XCTAssertEqual(pipe(first), 0);
+    XCTAssertEqual(pipe(second), 0);
+
+    iTermMultiServerResponseLaunch launches[3] = {
+        { .status = 0, .pid = 11, .fd = first[0], .uniqueId = 1, .tty = "/dev/ttys001" },
+        { .status = -1, .pid = 0, .fd = -1, .uniqueId = 2, .tty = "" },
+        { .status = 0, .pid = 13, .fd = second[0], .uniqueId = 3, .tty = "/dev/ttys003" }
+    };
+    iTermMultiServerServerOriginatedMessage response = {
+        .type = iTermMultiServerRPCTypeLaunchBatch,
+        .payload = {
+            .launchBatch = {
+                .count = 3,
+                .launches = launches
+            }
+        }
+    };
+    iTermClientServerProtocolMessage message;
+    iTermClientServerProtocolMessageInitialize(&message);
+    XCTAssertEqual(iTermMultiServerProtocolEncodeMessageFromServer(&response, &message), 0);
+    const int fds[2] = { first[0], second[0] };
+    XCTAssertTrue(iTermMultiServerProtocolTestWrite(sockets[0], &message, fds, 2));
+    iTermClientServerProtocolMessageFree(&message);
+
+    iTermMultiServerServerOriginatedMessage decoded;
+    XCTAssertTrue(iTermMultiServerProtocolTestReadFromServer(sockets[1], &decoded));
+    XCTAssertEqual(decoded.type, iTermMultiServerRPCTypeLaunchBatch);
+    XCTAssertEqual(decoded.payload.launchBatch.count, 3);
+    XCTAssertEqual(decoded.payload.launchBatch.launches[0].pid, 11);
+    XCTAssertGreaterThanOrEqual(decoded.payload.launchBatch.launches[0].fd, 0);
+    XCTAssertEqual(decoded.payload.launchBatch.launches[1].status, -1);
+    XCTAssertEqual(decoded.payload.launchBatch.launches[1].fd, -1);
+    XCTAssertEqual(decoded.payload.launchBatch.launches[2].uniqueId, 3ULL);
+    XCTAssertEqual(strcmp(decoded.payload.launchBatch.launches[2].tty, "/dev/ttys003"), 0);
+
+    // The received descriptors refer to the pipes, in order.
+    XCTAssertEqual(write(second[1], "2", 1), 1);
+    XCTAssertEqual(write(first[1], "1", 1), 1);
+    char c = 0;
+    XCTAssertEqual(read(decoded.payload.launchBatch.launches[0].fd, &c, 1), 1);
+    XCTAssertEqual(c, '1');
+    XCTAssertEqual(read(decoded.payload.launchBatch.launches[2].fd, &c, 1), 1);
+    XCTAssertEqual(c, '2');
+
+    close(decoded.payload.launchBatch.launches[0].fd);
+    close(decoded.payload.launchBatch.launches[2].fd);
+    iTermMultiServerServerOriginatedMessageFree(&decoded);
+    close(first[0]);
+    close(first[1]);
+    close(second[0]);
+    close(second[1]);
+    close(sockets[0]);
+    close(sockets[1]);
+}
+
+- (void)testLaunchBatchResponseWithMissingFileDescriptorIsRejected {
+    iTermMultiServerResponseLaunch launches[2] = {
+        { .status = 0, .pid = 11, .fd = -1, .uniqueId = 1, .tty = "/dev/ttys001" },
+        { .status = 0, .pid = 12, .fd = -1, .uniqueId = 2, .tty = "/dev/ttys002" }
+    };
+    iTermMultiServerServerOriginatedMessage response = {
+        .type = iTermMultiServerRPCTypeLaunchBatch,
+        .payload = {
+            .launchBatch = {
+                .count = 2,
+                .launches = launches
+            }
+        }
+    };
+    iTermClientServerProtocolMessage message;
+    iTermClientServerProtocolMessageInitialize(&message);
+    XCTAssertEqual(iTermMultiServerProtocolEncodeMessageFromServer(&response, &message), 0);
+
+    iTermMultiServerServerOriginatedMessage decoded;
+    XCTAssertNotEqual(iTermMultiServerProtocolParseMessageFromServer(&message, &decoded), 0);
+    iTermMultiServerServerOriginatedMessageFree(&decoded);
+    iTermClientServerProtocolMessageFree(&message);
+}
+
+static iTermMultiServerReportChild iTermMultiServerProtocolTestReport(pid_t pid, int fd, const char *tty) {
+    return (iTermMultiServerReportChild){
+        .pid = pid,
+        .path = "/bin/sh",
+        .argv = iTermMultiServerProtocolTestArgv,
+        .argc = 3,
+        .envp = iTermMultiServerProtocolTestEnvp,
+        .envc = 2,
+        .isUTF8 = 1,
+        .pwd = "/tmp",
+        .terminated = 0,
+        .tty = tty,
+        .fd = fd
+    };
+}
+
+- (void)testReportChildrenPassesFileDescriptorsInOneMessage {
+    int sockets[2];
+    XCTAssertEqual(socketpair(AF_UNIX, SOCK_STREAM, 0, sockets), 0);
+    int pipes[3][2];
+    for (int i = 0; i < 3; i++) {
+        XCTAssertEqual(pipe(pipes[i]), 0);
+    }
+    iTermMultiServerReportChild children[3] = {
+        iTermMultiServerProtocolTestReport(21, pipes[0][0], "/dev/ttys021"),
+        iTermMultiServerProtocolTestReport(22, pipes[1][0], "/dev/ttys022"),
+        iTermMultiServerProtocolTestReport(23, pipes[2][0], "/dev/ttys023")
+    };
+    iTermMultiServerServerOriginatedMessage report = {
+        .type = iTermMultiServerRPCTypeReportChildren,
+        .payload = {
+            .reportChildren = {
+                .isLast = 1,
+                .count = 3,
+                .children = children
+            }
+        }
+    };
+    iTermClientServerProtocolMessage message;
+    iTermClientServerProtocolMessageInitialize(&message);
+    XCTAssertEqual(iTermMultiServerProtocolEncodeMessageFromServer(&report, &message), 0);
+    const int fds[3] = { pipes[0][0], pipes[1][0], pipes[2][0] };
+    XCTAssertTrue(iTermMultiServerProtocolTestWrite(sockets[0], &message, fds, 3));
+    iTermClientServerProtocolMessageFree(&message);
+
+    iTermMultiServerServerOriginatedMessage decoded;
+    XCTAssertTrue(iTermMultiServerProtocolTestReadFromServer(sockets[1], &decoded));
+    XCTAssertEqual(decoded.type, iTermMultiServerRPCTypeReportChildren);
+    XCTAssertEqual(decoded.payload.reportChildren.isLast, 1);
+    XCTAssertEqual(decoded.payload.reportChildren.count, 3);
+    for (int i = 0; i < 3; i++) {
+        const iTermMultiServerReportChild *child = &decoded.payload.reportChildren.children[i];
+        XCTAssertEqual(child->pid, 21 + i);
+        XCTAssertEqual(child->argc, 3);
+        XCTAssertEqual(strcmp(child->argv[2], "echo ready; sleep 1"), 0);
+        XCTAssertEqual(child->envc, 2);
+        XCTAssertEqual(strcmp(child->pwd, "/tmp"), 0);
+
+        // The received descriptors refer to the pipes, in order.
+        const char expected = '0' + i;
+        XCTAssertEqual(write(pipes[i][1], &expected, 1), 1);
+        char c = 0;
+        XCTAssertEqual(read(child->fd, &c, 1), 1);
+        XCTAssertEqual(c, expected);
+        close(child->fd);
+    }
+    iTermMultiServerServerOriginatedMessageFree(&decoded);
+    for (int i = 0; i < 3; i++) {
+        close(pipes[i][0]);
+        close(pipes[i][1]);
+    }
+    close(sockets[0]);
+    close(sockets[1]);
+}
+
+// Every reported child needs a file descriptor.
+- (void)testReportChildrenWithWrongNumberOfFileDescriptorsIsRejected {
+    int sockets[2];
+    XCTAssertEqual(socketpair(AF_UNIX, SOCK_STREAM, 0, sockets), 0);
+    int fds[2];
+    XCTAssertEqual(pipe(fds), 0);
+    iTermMultiServerReportChild children[2] = {
+        iTermMultiServerProtocolTestReport(31, fds[0], "/dev/ttys031"),
+        iTermMultiServerProtocolTestReport(32, fds[0], "/dev/ttys032")
+    };
+    iTermMultiServerServerOriginatedMessage report = {
+        .type = iTermMultiServerRPCTypeReportChildren,
+        .payload = {
+            .reportChildren = {
+                .isLast = 1,
+                .count = 2,
+                .children = children
+            }
+        }
+    };
+    iTermClientServerProtocolMessage message;
+    iTermClientServerProtocolMessageInitialize(&message);
+    XCTAssertEqual(iTermMultiServerProtocolEncodeMessageFromServer(&report, &message), 0);
+    XCTAssertTrue(iTermMultiServerProtocolTestWrite(sockets[0], &message, fds, 1));
+    iTermClientServerProtocolMessageFree(&message);
+
+    iTermMultiServerServerOriginatedMessage decoded;
+    XCTAssertFalse(iTermMultiServerProtocolTestReadFromServer(sockets[1], &decoded));
+    iTermMultiServerServerOriginatedMessageFree(&decoded);
+    close(fds[0]);
+    close(fds[1]);
+    close(sockets[0]);
+    close(sockets[1]);
+}
+
+#pragma mark - Performance
+
+// Launches `count` shells through a fake server and waits until each has printed its first line.
+// Sequential mode sends one launch per round trip, as clients did before launch batches.
+- (void)launchShells:(int)count batched:(BOOL)batched {
+    int sockets[2];
+    XCTAssertEqual(socketpair(AF_UNIX, SOCK_STREAM, 0, sockets), 0);
+    const int serverFd = sockets[1];
+    dispatch_group_t group = dispatch_group_create();
+    dispatch_group_async(group, dispatch_get_global_queue(QOS_CLASS_USER_INITIATED, 0), ^{
+        iTermMultiServerProtocolTestServe(serverFd);
+    });
+
+    NSMutableArray<NSNumber *> *fds = [NSMutableArray array];
+    NSMutableArray<NSNumber *> *pids = [NSMutableArray array];
+    const int batchSize = batched ? iTermMultiServerMaximumLaunchBatchSize : 1;
+    for (int start = 0; start < count; start += batchSize) {
+        const int n = MIN(batchSize, count - start);
+        iTermMultiServerRequestLaunch launches[iTermMultiServerMaximumLaunchBatchSize];
+        for (int i = 0; i < n; i++) {
+            launches[i] = iTermMultiServerProtocolTestLaunch(start + i);
+        }
+        iTermMultiServerClientOriginatedMessage request;
+        memset(&request, 0, sizeof(request));
+        if (batched) {
+            request.type = iTermMultiServerRPCTypeLaunchBatch;
+            request.payload.launchBatch.count = n;
+            request.payload.launchBatch.launches = launches;
+        } else {
+            request.type = iTermMultiServerRPCTypeLaunch;
+            request.payload.launch = launches[0];
+        }
+        iTermClientServerProtocolMessage message;
+        iTermClientServerProtocolMessageInitialize(&message);
+        XCTAssertEqual(iTermMultiServerProtocolEncodeMessageFromClient(&request, &message), 0);
+        XCTAssertTrue(iTermMultiServerProtocolTestWrite(sockets[0], &message, NULL, 0));
+        iTermClientServerProtocolMessageFree(&message);
+
+        iTermMultiServerServerOriginatedMessage response;
+        XCTAssertTrue(iTermMultiServerProtocolTestReadFromServer(sockets[0], &response));
+        if (batched) {
+            XCTAssertEqual(response.payload.launchBatch.count, n);
+            for (int i = 0; i < response.payload.launchBatch.count; i++) {
+                [fds addObject:@(response.payload.launchBatch.launches[i].fd)];
+                [pids addObject:@(response.payload.launchBatch.launches[i].pid)];
+            }
+        } else {
+            [fds addObject:@(response.payload.launch.fd)];
+            [pids addObject:@(response.payload.launch.pid)];
+        }
+        iTermMultiServerServerOriginatedMessageFree(&response);
+    }
+
+    // A shell is ready once it has produced output.
+    for (NSNumber *fd in fds) {
+        char buffer[64];
+        XCTAssertGreaterThan(read(fd.intValue, buffer, sizeof(buffer)), 0);
+    }
+
+    close(sockets[0]);
+    dispatch_group_wait(group, DISPATCH_TIME_FOREVER);
+    dispatch_release(group);
+    for (NSNumber *fd in fds) {
+        close(fd.intValue);
+    }
+    for (NSNumber *pid in pids) {
+        kill(pid.intValue, SIGKILL);
+        int status;
+        waitpid(pid.intValue, &status, 0);
+    }
+    XCTAssertEqual(fds.count, (NSUInteger)count);
+}
+
+- (void)testTimeToAllShellsReadyBatched1 {
+    [self measureBlock:^{
+        [self launchShells:1 batched:YES];
+    }];
+}
+
+- (void)testTimeToAllShellsReadyBatched10 {
+    [self measureBlock:^{
+        [self launchShells:10 batched:YES];
+    }];
+}
+
+- (void)testTimeToAllShellsReadyBatched100 {
+    [self measureBlock:^{
+        [self launchShells:100 batched:YES];
+    }];
+}
+
+- (void)testTimeToAllShellsReadySequential1 {
+    [self measureBlock:^{
+        [self launchShells:1 batched:NO];
+    }];
+}
+
+- (void)testTimeToAllShellsReadySequential10 {
+    [self measureBlock:^{
+        [self launchShells:10 batched:NO];
+    }];
+}
+
+- (void)testTimeToAllShellsReadySequential100 {
+    [self measureBlock:^{
+        [self launchShells:100 batched:NO];
+    }];
+}
+
+@end
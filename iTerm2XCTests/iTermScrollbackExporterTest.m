@@ -0,0 +1,206 @@
+//
+//  iTermScrollbackExporterTest.m
+//  iTerm2XCTests
+//
+//  Created by George Nachman on 10/18/26.
+//
+
+#import <XCTest/XCTest.h>
+#import "Api.pbobjc.h"
+#import "LineBuffer.h"
+#import "ScreenChar.h"
+#import "iTermScrollbackExporter.h"
+
+static const int kWidth = 80;
+
+@interface iTermScrollbackExporterTest : XCTestCase
+@end
+
+@implementation iTermScrollbackExporterTest
+
+- (LineBuffer *)lineBufferWithLines:(int)count {
+    LineBuffer *lineBuffer = [[[LineBuffer alloc] initWithBlockSize:8192] autorelease];
+    screen_char_t line[kWidth];
+    screen_char_t continuation;
+    memset(&continuation, 0, sizeof(continuation));
+    continuation.code = EOL_HARD;
+    for (int i = 0; i < count; i++) {
+        NSString *string = [NSString stringWithFormat:@"line %d", i];
+        memset(line, 0, sizeof(line));
+        for (int j = 0; j < string.length; j++) {
+            line[j].code = [string characterAtIndex:j];
+        }
+        [lineBuffer appendLine:line
+                        length:(int)string.length
+                       partial:NO
+                         width:kWidth
+                     timestamp:0
+                  continuation:continuation];
+    }
+    return lineBuffer;
+}
+
+- (iTermScrollbackExporter *)exporterWithLines:(int)count overflow:(long long)overflow {
+    return [[[iTermScrollbackExporter alloc] initWithLineBuffer:[self lineBufferWithLines:count]
+                                                          width:kWidth
+                                                       overflow:overflow] autorelease];
+}
+
+- (ITMGetScrollbackRequest *)requestWithCursor:(long long)cursor maxLines:(int)maxLines {
+    ITMGetScrollbackRequest *request = [[[ITMGetScrollbackRequest alloc] init] autorelease];
+    if (cursor >= 0) {
+        request.cursor = cursor;
+    }
+    if (maxLines > 0) {
+        request.maxLines = maxLines;
+    }
+    return request;
+}
+
+- (void)testPagesThroughAllLines {
+    iTermScrollbackExporter *exporter = [self exporterWithLines:2500 overflow:0];
+    XCTAssertEqual(exporter.endOfBuffer, 2500);
+
+    NSMutableArray<NSString *> *lines = [NSMutableArray array];
+    long long cursor = -1;
+    int chunks = 0;
+    do {
+        ITMGetScrollbackResponse *response = [exporter responseForRequest:[self requestWithCursor:cursor
+                                                                                         maxLines:1000]];
+        XCTAssertEqual(response.status, ITMGetScrollbackResponse_Status_Ok);
+        XCTAssertLessThanOrEqual(response.contentsArray.count, 1000);
+        for (ITMLineContents *contents in response.contentsArray) {
+            [lines addObject:contents.text];
+            XCTAssertEqual(contents.continuation, ITMLineContents_Continuation_ContinuationHardEol);
+        }
+        cursor = response.nextCursor;
+        chunks++;
+    } while (cursor < exporter.endOfBuffer);
+
+    XCTAssertEqual(chunks, 3);
+    XCTAssertEqual(lines.count, 2500);
+    XCTAssertEqualObjects(lines.firstObject, @"line 0");
+    XCTAssertEqualObjects(lines.lastObject, @"line 2499");
+}
+
+- (void)testCodePointsPerCell {
+    iTermScrollbackExporter *exporter = [self exporterWithLines:1 overflow:0];
+    ITMGetScrollbackResponse *response = [exporter responseForRequest:[self requestWithCursor:-1 maxLines:0]];
+    XCTAssertEqual(response.contentsArray.count, 1);
+    ITMLineContents *contents = response.contentsArray[0];
+    XCTAssertEqual(contents.codePointsPerCellArray.count, 1);
+    XCTAssertEqual(contents.codePointsPerCellArray[0].numCodePoints, 1);
+    XCTAssertEqual(contents.codePointsPerCellArray[0].repeats, 6);
+}
+
+- (void)testTextOnlyOmitsCodePointsPerCell {
+    iTermScrollbackExporter *exporter = [self exporterWithLines:10 overflow:0];
+    ITMGetScrollbackRequest *request = [self requestWithCursor:-1 maxLines:0];
+    request.textOnly = YES;
+    ITMGetScrollbackResponse *response = [exporter responseForRequest:request];
+    XCTAssertEqual(response.contentsArray.count, 10);
+    for (ITMLineContents *contents in response.contentsArray) {
+        XCTAssertEqual(contents.codePointsPerCellArray.count, 0);
+        XCTAssertTrue(contents.hasContinuation);
+    }
+    XCTAssertEqualObjects(response.contentsArray[9].text, @"line 9");
+}
+
+- (void)testCursorBeforeFirstLineSkipsLostLines {
+    iTermScrollbackExporter *exporter = [self exporterWithLines:10 overflow:100];
+    ITMGetScrollbackResponse *response = [exporter responseForRequest:[self requestWithCursor:50 maxLines:0]];
+    XCTAssertEqual(response.status, ITMGetScrollbackResponse_Status_Ok);
+    XCTAssertEqual(response.firstLine, 100);
+    XCTAssertEqual(response.nextCursor, 110);
+    XCTAssertEqual(response.endOfBuffer, 110);
+    XCTAssertEqualObjects(response.contentsArray[0].text, @"line 0");
+}
+
+- (void)testCursorAtEndReturnsNoLines {
+    iTermScrollbackExporter *exporter = [self exporterWithLines:10 overflow:0];
+    ITMGetScrollbackResponse *response = [exporter responseForRequest:[self requestWithCursor:10 maxLines:0]];
+    XCTAssertEqual(response.status, ITMGetScrollbackResponse_Status_Ok);
+    XCTAssertEqual(response.contentsArray.count, 0);
+    XCTAssertEqual(response.nextCursor, 10);
+}
+
+- (void)testCursorPastEndIsInvalid {
+    iTermScrollbackExporter *exporter = [self exporterWithLines:10 overflow:0];
+    ITMGetScrollbackResponse *response = [exporter responseForRequest:[self requestWithCursor:11 maxLines:0]];
+    XCTAssertEqual(response.status, ITMGetScrollbackResponse_Status_InvalidCursor);
+}
+
+- (void)testMaxLinesIsCapped {
+    iTermScrollbackExporter *exporter = [self exporterWithLines:20000 overflow:0];
+    ITMGetScrollbackResponse *response = [exporter responseForRequest:[self requestWithCursor:-1 maxLines:50000]];
+    XCTAssertEqual(response.contentsArray.count, 10000);
+}
+
+- (void)testSnapshotIsUnaffectedByDroppedLines {
+    LineBuffer *lineBuffer = [self lineBufferWithLines:2000];
+    int linesBefore = -1;
+    LineBuffer *snapshot = [lineBuffer newSnapshotForConcurrentReadingOfLinesInRange:NSMakeRange(0, 2000)
+                                                                               width:kWidth
+                                                                         linesBefore:&linesBefore];
+    XCTAssertEqual(linesBefore, 0);
+    [lineBuffer setMaxLines:10];
+    [lineBuffer dropExcessLinesWithWidth:kWidth];
+
+    iTermScrollbackExporter *exporter = [[[iTermScrollbackExporter alloc] initWithLineBuffer:snapshot
+                                                                                       width:kWidth
+                                                                                    overflow:0] autorelease];
+    [snapshot release];
+    ITMGetScrollbackResponse *response = [exporter responseForRequest:[self requestWithCursor:-1 maxLines:1]];
+    XCTAssertEqualObjects(response.contentsArray[0].text, @"line 0");
+    XCTAssertEqual(exporter.endOfBuffer, 2000);
+}
+
+- (void)testSnapshotOfRequestedLinesOnly {
+    LineBuffer *lineBuffer = [self lineBufferWithLines:20000];
+    ITMGetScrollbackRequest *request = [self requestWithCursor:15000 maxLines:10];
+    const NSRange range = [iTermScrollbackExporter rangeOfLinesForRequest:request firstLine:0 endOfBuffer:20000];
+    XCTAssertEqual(range.location, 15000);
+    XCTAssertEqual(range.length, 10);
+
+    int linesBefore = -1;
+    LineBuffer *snapshot = [lineBuffer newSnapshotForConcurrentReadingOfLinesInRange:range
+                                                                               width:kWidth
+                                                                         linesBefore:&linesBefore];
+    XCTAssertGreaterThan(linesBefore, 0);
+    XCTAssertLessThanOrEqual(linesBefore, 15000);
+    XCTAssertLessThan([snapshot numLinesWithWidth:kWidth], 20000);
+
+    iTermScrollbackExporter *exporter = [[[iTermScrollbackExporter alloc] initWithLineBuffer:snapshot
+                                                                                       width:kWidth
+                                                                                   firstLine:0
+                                                                           firstLineOfBuffer:linesBefore
+                                                                                 endOfBuffer:20000] autorelease];
+    [snapshot release];
+    ITMGetScrollbackResponse *response = [exporter responseForRequest:request];
+    XCTAssertEqual(response.contentsArray.count, 10);
+    XCTAssertEqualObjects(response.contentsArray[0].text, @"line 15000");
+    XCTAssertEqualObjects(response.contentsArray[9].text, @"line 15009");
+    XCTAssertEqual(response.nextCursor, 15010);
+}
+
+#pragma mark - Performance
+
+// Exports a million-line history in text-only chunks. Peak memory should stay proportional to
+// the chunk size rather than the size of the history.
+- (void)testExportMillionLinesPerformance {
+    iTermScrollbackExporter *exporter = [self exporterWithLines:1000000 overflow:0];
+    [self measureWithMetrics:@[ [[[XCTClockMetric alloc] init] autorelease],
+                                [[[XCTMemoryMetric alloc] init] autorelease] ]
+                       block:^{
+        long long cursor = exporter.firstLine;
+        while (cursor < exporter.endOfBuffer) {
+            @autoreleasepool {
+                ITMGetScrollbackRequest *request = [self requestWithCursor:cursor maxLines:10000];
+                request.textOnly = YES;
+                cursor = [exporter responseForRequest:request].nextCursor;
+            }
+        }
+    }];
+}
+
+@end
@@ -0,0 +1,265 @@
+//
+//  iTermSelectionExporterTest.m
+//  iTerm2XCTests
+//
+//  Created by George Nachman on 10/18/26.
+//
+
+#import <XCTest/XCTest.h>
+#import "LineBuffer.h"
+#import "ScreenChar.h"
+#import "iTermSelectionExporter.h"
+
+static const int kWidth = 10;
+
+@interface iTermSelectionExporterTest : XCTestCase
+@end
+
+@implementation iTermSelectionExporterTest
+
+// Characters at or above U+1100 are treated as double-width.
+- (LineBuffer *)lineBufferWithStrings:(NSArray<NSString *> *)strings width:(int)width {
+    LineBuffer *lineBuffer = [[[LineBuffer alloc] initWithBlockSize:8192] autorelease];
+    lineBuffer.mayHaveDoubleWidthCharacter = YES;
+    screen_char_t continuation;
+    memset(&continuation, 0, sizeof(continuation));
+    continuation.code = EOL_HARD;
+    for (NSString *string in strings) {
+        screen_char_t *line = calloc(string.length * 2 + 1, sizeof(screen_char_t));
+        int length = 0;
+        for (int j = 0; j < string.length; j++) {
+            const unichar c = [string characterAtIndex:j];
+            line[length++].code = c;
+            if (c >= 0x1100) {
+                line[length++].code = DWC_RIGHT;
+            }
+        }
+        [lineBuffer appendLine:line
+                        length:length
+                       partial:NO
+                         width:width
+                     timestamp:0
+                  continuation:continuation];
+        free(line);
+    }
+    return lineBuffer;
+}
+
+// Rows at width 10:
+// 0: "hello   "      hard
+// 1: "abcdefghij"    soft
+// 2: "klmnop"        hard
+// 3: "0123456   "    soft
+// 4: "ab"            hard
+// 5: "123456789"     wraps before a double-width character
+// 6: "中x"           hard
+// 7: "last"          hard
+- (NSArray<NSString *> *)strings {
+    return @[ @"hello   ",
+              @"abcdefghijklmnop",
+              @"0123456   ab",
+              @"123456789中x",
+              @"last" ];
+}
+
+- (iTermSelectionExporter *)exporterWithOverflow:(long long)overflow {
+    return [[[iTermSelectionExporter alloc] initWithLineBuffer:[self lineBufferWithStrings:[self strings]
+                                                                                      width:kWidth]
+                                                         width:kWidth
+                                                      overflow:overflow] autorelease];
+}
+
+- (NSString *)textOfExporter:(iTermSelectionExporter *)exporter {
+    NSMutableString *text = [NSMutableString string];
+    XCTAssertTrue([exporter enumerateChunksUsingBlock:^(NSString *chunk, BOOL *stop) {
+        [text appendString:chunk];
+    }]);
+    return text;
+}
+
+- (VT100GridAbsWindowedRange)rangeFrom:(VT100GridAbsCoord)start to:(VT100GridAbsCoord)end {
+    return VT100GridAbsWindowedRangeMake(VT100GridAbsCoordRangeMake(start.x, start.y, end.x, end.y), 0, 0);
+}
+
+- (void)testWholeBufferWithTrimming {
+    iTermSelectionExporter *exporter = [self exporterWithOverflow:0];
+    exporter.trimTrailingWhitespace = YES;
+    exporter.linesPerChunk = 1;
+    [exporter addAbsRange:[self rangeFrom:VT100GridAbsCoordMake(0, 0) to:VT100GridAbsCoordMake(kWidth, 7)]
+                  newline:NO];
+    XCTAssertEqualObjects([self textOfExporter:exporter],
+                          @"hello\nabcdefghijklmnop\n0123456   ab\n123456789中x\nlast");
+}
+
+- (void)testWholeBufferWithoutTrimming {
+    iTermSelectionExporter *exporter = [self exporterWithOverflow:0];
+    exporter.includeLastNewline = YES;
+    exporter.linesPerChunk = 1;
+    [exporter addAbsRange:[self rangeFrom:VT100GridAbsCoordMake(0, 0) to:VT100GridAbsCoordMake(kWidth, 7)]
+                  newline:NO];
+    XCTAssertEqualObjects([self textOfExporter:exporter],
+                          @"hello   \nabcdefghijklmnop\n0123456   ab\n123456789中x\nlast\n");
+}
+
+// Breaking the text into pieces of any size must not change it.
+- (void)testChunkSizeDoesNotChangeText {
+    const VT100GridAbsWindowedRange ranges[] = {
+        [self rangeFrom:VT100GridAbsCoordMake(0, 0) to:VT100GridAbsCoordMake(kWidth, 7)],
+        [self rangeFrom:VT100GridAbsCoordMake(3, 1) to:VT100GridAbsCoordMake(4, 6)],
+        [self rangeFrom:VT100GridAbsCoordMake(8, 3) to:VT100GridAbsCoordMake(1, 4)],
+        VT100GridAbsWindowedRangeMake(VT100GridAbsCoordRangeMake(2, 0, 6, 7), 2, 4),
+    };
+    // The first size is big enough to extract each range in one piece.
+    const int chunkSizes[] = { 1000, 3, 2, 1 };
+    for (int trim = 0; trim < 2; trim++) {
+        for (int lastNewline = 0; lastNewline < 2; lastNewline++) {
+            for (int r = 0; r < sizeof(ranges) / sizeof(*ranges); r++) {
+                NSString *expected = nil;
+                for (int i = 0; i < sizeof(chunkSizes) / sizeof(*chunkSizes); i++) {
+                    const int linesPerChunk = chunkSizes[i];
+                    iTermSelectionExporter *exporter = [self exporterWithOverflow:0];
+                    exporter.trimTrailingWhitespace = trim;
+                    exporter.includeLastNewline = lastNewline;
+                    exporter.linesPerChunk = linesPerChunk;
+                    [exporter addAbsRange:ranges[r] newline:NO];
+                    NSString *text = [self textOfExporter:exporter];
+                    if (!expected) {
+                        expected = text;
+                    } else {
+                        XCTAssertEqualObjects(text, expected,
+                                              @"range=%d trim=%d lastNewline=%d linesPerChunk=%d",
+                                              r, trim, lastNewline, linesPerChunk);
+                    }
+                }
+            }
+        }
+    }
+}
+
+- (void)testNewlineBetweenRanges {
+    iTermSelectionExporter *exporter = [self exporterWithOverflow:0];
+    exporter.linesPerChunk = 1;
+    [exporter addAbsRange:[self rangeFrom:VT100GridAbsCoordMake(0, 1) to:VT100GridAbsCoordMake(3, 1)]
+                  newline:YES];
+    [exporter addAbsRange:[self rangeFrom:VT100GridAbsCoordMake(0, 7) to:VT100GridAbsCoordMake(kWidth, 7)]
+                  newline:YES];
+    XCTAssertEqualObjects([self textOfExporter:exporter], @"abc\nlast\n");
+}
+
+- (void)testRangesBeforeOverflowAreSkipped {
+    iTermSelectionExporter *exporter = [self exporterWithOverflow:100];
+    [exporter addAbsRange:[self rangeFrom:VT100GridAbsCoordMake(0, 50) to:VT100GridAbsCoordMake(kWidth, 107)]
+                  newline:NO];
+    [exporter addAbsRange:[self rangeFrom:VT100GridAbsCoordMake(0, 107) to:VT100GridAbsCoordMake(kWidth, 107)]
+                  newline:NO];
+    XCTAssertEqualObjects([self textOfExporter:exporter], @"last");
+}
+
+- (void)testProgressReachesOne {
+    iTermSelectionExporter *exporter = [self exporterWithOverflow:0];
+    exporter.linesPerChunk = 1;
+    NSMutableArray<NSNumber *> *fractions = [NSMutableArray array];
+    exporter.progress = ^(double fractionCompleted) {
+        [fractions addObject:@(fractionCompleted)];
+    };
+    [exporter addAbsRange:[self rangeFrom:VT100GridAbsCoordMake(0, 0) to:VT100GridAbsCoordMake(kWidth, 7)]
+                  newline:NO];
+    [self textOfExporter:exporter];
+    XCTAssertGreaterThan(fractions.count, 1);
+    for (NSInteger i = 1; i < fractions.count; i++) {
+        XCTAssertGreaterThan(fractions[i].doubleValue, fractions[i - 1].doubleValue);
+    }
+    XCTAssertEqualWithAccuracy(fractions.lastObject.doubleValue, 1.0, 0.0001);
+}
+
+- (void)testCancel {
+    // __block so the progress block doesn't retain the exporter.
+    __block iTermSelectionExporter *exporter = [self exporterWithOverflow:0];
+    exporter.linesPerChunk = 1;
+    exporter.progress = ^(double fractionCompleted) {
+        [exporter cancel];
+    };
+    [exporter addAbsRange:[self rangeFrom:VT100GridAbsCoordMake(0, 0) to:VT100GridAbsCoordMake(kWidth, 7)]
+                  newline:NO];
+    __block int chunks = 0;
+    XCTAssertFalse([exporter enumerateChunksUsingBlock:^(NSString *chunk, BOOL *stop) {
+        chunks++;
+    }]);
+    XCTAssertEqual(chunks, 1);
+    XCTAssertTrue(exporter.cancelled);
+}
+
+- (void)testWriteToURL {
+    iTermSelectionExporter *exporter = [self exporterWithOverflow:0];
+    exporter.linesPerChunk = 1;
+    [exporter addAbsRange:[self rangeFrom:VT100GridAbsCoordMake(0, 0) to:VT100GridAbsCoordMake(kWidth, 7)]
+                  newline:NO];
+    NSURL *url = [[NSURL fileURLWithPath:NSTemporaryDirectory()] URLByAppendingPathComponent:[[NSUUID UUID] UUIDString]];
+    NSError *error = nil;
+    XCTAssertTrue([exporter writeToURL:url error:&error]);
+    XCTAssertNil(error);
+    NSString *contents = [NSString stringWithContentsOfURL:url encoding:NSUTF8StringEncoding error:nil];
+    XCTAssertEqualObjects(contents, @"hello   \nabcdefghijklmnop\n0123456   ab\n123456789中x\nlast");
+    [[NSFileManager defaultManager] removeItemAtURL:url error:nil];
+}
+
+- (void)testCanceledWriteRemovesFile {
+    // __block so the progress block doesn't retain the exporter.
+    __block iTermSelectionExporter *exporter = [self exporterWithOverflow:0];
+    exporter.linesPerChunk = 1;
+    exporter.progress = ^(double fractionCompleted) {
+        [exporter cancel];
+    };
+    [exporter addAbsRange:[self rangeFrom:VT100GridAbsCoordMake(0, 0) to:VT100GridAbsCoordMake(kWidth, 7)]
+                  newline:NO];
+    NSURL *url = [[NSURL fileURLWithPath:NSTemporaryDirectory()] URLByAppendingPathComponent:[[NSUUID UUID] UUIDString]];
+    NSError *error = nil;
+    XCTAssertFalse([exporter writeToURL:url error:&error]);
+    XCTAssertEqual(error.code, NSUserCancelledError);
+    XCTAssertFalse([[NSFileManager defaultManager] fileExistsAtPath:url.path]);
+}
+
+#pragma mark - Performance
+
+// Copies a two-million-line selection to a file, starting with the snapshot that the data source
+// takes on the main thread. Peak memory should stay proportional to the chunk size rather than the
+// size of the selection.
+- (void)testCopyTwoMillionLinesPerformance {
+    const int count = 2000000;
+    const int width = 80;
+    LineBuffer *lineBuffer = [[[LineBuffer alloc] initWithBlockSize:8192] autorelease];
+    screen_char_t line[2];
+    memset(line, 0, sizeof(line));
+    line[0].code = 'x';
+    line[1].code = ' ';
+    screen_char_t continuation;
+    memset(&continuation, 0, sizeof(continuation));
+    continuation.code = EOL_HARD;
+    for (int i = 0; i < count; i++) {
+        [lineBuffer appendLine:line
+                        length:2
+                       partial:NO
+                         width:width
+                     timestamp:0
+                  continuation:continuation];
+    }
+    NSURL *url = [[NSURL fileURLWithPath:NSTemporaryDirectory()] URLByAppendingPathComponent:[[NSUUID UUID] UUIDString]];
+    [self measureWithMetrics:@[ [[[XCTClockMetric alloc] init] autorelease],
+                                [[[XCTMemoryMetric alloc] init] autorelease] ]
+                       block:^{
+        int linesBefore = 0;
+        LineBuffer *snapshot = [[lineBuffer newSnapshotForConcurrentReadingOfLinesInRange:NSMakeRange(0, count)
+                                                                                    width:width
+                                                                              linesBefore:&linesBefore] autorelease];
+        iTermSelectionExporter *exporter = [[[iTermSelectionExporter alloc] initWithLineBuffer:snapshot
+                                                                                         width:width
+                                                                                      overflow:linesBefore] autorelease];
+        exporter.trimTrailingWhitespace = YES;
+        [exporter addAbsRange:VT100GridAbsWindowedRangeMake(VT100GridAbsCoordRangeMake(0, 0, width, count - 1), 0, 0)
+                      newline:NO];
+        XCTAssertTrue([exporter writeToURL:url error:nil]);
+    }];
+    [[NSFileManager defaultManager] removeItemAtURL:url error:nil];
+}
+
+@end
@@ -0,0 +1,295 @@
+//
+//  iTermSelectionIndexTest.m
+//  iTerm2XCTests
+//
+//  Created by George Nachman on 10/18/26.
+//
+
+#import <XCTest/XCTest.h>
+#import "iTermSelection.h"
+#import "iTermSelectionIndex.h"
+
+static const int iTermSelectionIndexTestWidth = 300;
+static const int iTermSelectionIndexTestHeight = 100;
+
+@interface iTermSelectionIndexTest : XCTestCase<iTermSelectionDelegate>
+@end
+
+@implementation iTermSelectionIndexTest {
+    iTermSelection *_selection;
+    long long _totalScrollbackOverflow;
+    unsigned int _seed;
+}
+
+- (void)setUp {
+    [super setUp];
+    _selection = [[iTermSelection alloc] init];
+    _selection.delegate = self;
+    _totalScrollbackOverflow = 0;
+    _seed = 1;
+}
+
+- (void)tearDown {
+    [_selection release];
+    [super tearDown];
+}
+
+#pragma mark - Helpers
+
+- (int)random:(int)n {
+    return rand_r(&_seed) % n;
+}
+
+// Like the find-on-page results, a box selection, and a few windowed and multi-line selections.
+- (NSArray<iTermSubSelection *> *)randomSubSelections:(NSInteger)count {
+    NSMutableArray<iTermSubSelection *> *subs = [NSMutableArray array];
+    for (NSInteger i = 0; i < count; i++) {
+        const int kind = [self random:10];
+        const long long y = [self random:iTermSelectionIndexTestHeight];
+        const int x = [self random:iTermSelectionIndexTestWidth];
+        VT100GridAbsWindowedRange range;
+        iTermSelectionMode mode = kiTermSelectionModeCharacter;
+        if (kind < 7) {
+            // A match on one line.
+            const int length = 1 + [self random:20];
+            range = VT100GridAbsWindowedRangeMake(VT100GridAbsCoordRangeMake(x, y, MIN(iTermSelectionIndexTestWidth, x + length), y), 0, 0);
+        } else if (kind < 8) {
+            // A match wrapping onto later lines.
+            const long long endY = MIN(iTermSelectionIndexTestHeight - 1, y + 1 + [self random:4]);
+            range = VT100GridAbsWindowedRangeMake(VT100GridAbsCoordRangeMake(x, y, [self random:iTermSelectionIndexTestWidth], endY), 0, 0);
+        } else if (kind < 9) {
+            // A selection in a split pane.
+            const int location = [self random:iTermSelectionIndexTestWidth / 2];
+            const int length = 1 + [self random:iTermSelectionIndexTestWidth / 2];
+            const long long endY = MIN(iTermSelectionIndexTestHeight - 1, y + [self random:10]);
+            range = VT100GridAbsWindowedRangeMake(VT100GridAbsCoordRangeMake(location + [self random:length],
+                                                                             y,
+                                                                             location + [self random:length],
+                                                                             endY),
+                                                  location,
+                                                  length);
+            if (range.coordRange.start.y == range.coordRange.end.y &&
+                range.coordRange.start.x > range.coordRange.end.x) {
+                range.coordRange.end.x = range.coordRange.start.x;
+            }
+        } else {
+            mode = kiTermSelectionModeBox;
+            const int right = MIN(iTermSelectionIndexTestWidth, x + 1 + [self random:40]);
+            const long long endY = MIN(iTermSelectionIndexTestHeight - 1, y + [self random:10]);
+            range = VT100GridAbsWindowedRangeMake(VT100GridAbsCoordRangeMake(x, y, right, endY), 0, 0);
+        }
+        [subs addObject:[iTermSubSelection subSelectionWithAbsRange:range
+                                                               mode:mode
+                                                              width:iTermSelectionIndexTestWidth]];
+    }
+    return subs;
+}
+
+// What selectedIndexesOnAbsoluteLine: computed before the index existed.
+- (NSIndexSet *)expectedIndexesOnLine:(long long)line {
+    NSMutableIndexSet *indexes = [NSMutableIndexSet indexSet];
+    for (iTermSubSelection *sub in _selection.allSubSelections) {
+        iTermSelectionToggleIndexesInRange(indexes,
+                                           iTermSelectionRangeOfIndexesInAbsRange(sub.absRange,
+                                                                                  line,
+                                                                                  sub.selectionMode,
+                                                                                  iTermSelectionIndexTestWidth));
+    }
+    return indexes;
+}
+
+// What containsAbsCoord: computed before the index existed.
+- (BOOL)expectedContainsAbsCoord:(VT100GridAbsCoord)coord {
+    BOOL contained = NO;
+    for (iTermSubSelection *sub in _selection.allSubSelections) {
+        if ([sub containsAbsCoord:coord]) {
+            contained = !contained;
+        }
+    }
+    return contained;
+}
+
+- (void)assertSelectionMatchesExpected {
+    for (long long y = 0; y < iTermSelectionIndexTestHeight; y++) {
+        XCTAssertEqualObjects([_selection selectedIndexesOnAbsoluteLine:y],
+                              [self expectedIndexesOnLine:y],
+                              @"line %@", @(y));
+        for (int x = 0; x < iTermSelectionIndexTestWidth; x += 7) {
+            const VT100GridAbsCoord coord = VT100GridAbsCoordMake(x, y);
+            XCTAssertEqual([_selection containsAbsCoord:coord],
+                           [self expectedContainsAbsCoord:coord],
+                           @"%@", VT100GridAbsCoordDescription(coord));
+        }
+    }
+}
+
+#pragma mark - Tests
+
+- (void)testManySubSelectionsMatchUnindexedAnswers {
+    [_selection addSubSelections:[self randomSubSelections:1000]];
+    [self assertSelectionMatchesExpected];
+    // Again, now that lines are cached.
+    [self assertSelectionMatchesExpected];
+}
+
+- (void)testLiveSelectionIsCombinedWithIndex {
+    [_selection addSubSelections:[self randomSubSelections:200]];
+    [_selection beginSelectionAtAbsCoord:VT100GridAbsCoordMake(10, 20)
+                                    mode:kiTermSelectionModeCharacter
+                                  resume:NO
+                                  append:YES];
+    for (int i = 0; i < 5; i++) {
+        [_selection moveSelectionEndpointTo:VT100GridAbsCoordMake(40 + i * 30, 20 + i * 7)];
+        [self assertSelectionMatchesExpected];
+    }
+    [_selection endLiveSelection];
+    [self assertSelectionMatchesExpected];
+}
+
+- (void)testBoxSelectionIsCombinedWithIndex {
+    [_selection addSubSelections:[self randomSubSelections:50]];
+    [_selection beginSelectionAtAbsCoord:VT100GridAbsCoordMake(100, 60)
+                                    mode:kiTermSelectionModeBox
+                                  resume:NO
+                                  append:YES];
+    [_selection moveSelectionEndpointTo:VT100GridAbsCoordMake(20, 30)];
+    [self assertSelectionMatchesExpected];
+    [_selection endLiveSelection];
+    [self assertSelectionMatchesExpected];
+}
+
+- (void)testIndexIsRebuiltWhenSubSelectionsChange {
+    [_selection addSubSelections:[self randomSubSelections:100]];
+    [self assertSelectionMatchesExpected];
+
+    iTermSubSelection *sub =
+        [iTermSubSelection subSelectionWithAbsRange:VT100GridAbsWindowedRangeMake(VT100GridAbsCoordRangeMake(0, 5, 10, 5), 0, 0)
+                                               mode:kiTermSelectionModeCharacter
+                                              width:iTermSelectionIndexTestWidth];
+    [_selection addSubSelection:sub];
+    [self assertSelectionMatchesExpected];
+
+    _totalScrollbackOverflow = 50;
+    [_selection scrollbackOverflowDidChange];
+    [self assertSelectionMatchesExpected];
+
+    [_selection removeWindowsWithWidth:iTermSelectionIndexTestWidth];
+    [self assertSelectionMatchesExpected];
+
+    [_selection clearSelection];
+    XCTAssertEqual([_selection selectedIndexesOnAbsoluteLine:60].count, 0);
+    XCTAssertFalse([_selection containsAbsCoord:VT100GridAbsCoordMake(0, 60)]);
+}
+
+- (void)testOverlappingSubSelectionsToggle {
+    VT100GridAbsWindowedRange outer = VT100GridAbsWindowedRangeMake(VT100GridAbsCoordRangeMake(0, 0, 10, 50), 0, 0);
+    VT100GridAbsWindowedRange inner = VT100GridAbsWindowedRangeMake(VT100GridAbsCoordRangeMake(5, 3, 15, 3), 0, 0);
+    [_selection addSubSelections:@[ [iTermSubSelection subSelectionWithAbsRange:outer
+                                                                           mode:kiTermSelectionModeCharacter
+                                                                          width:iTermSelectionIndexTestWidth],
+                                    [iTermSubSelection subSelectionWithAbsRange:inner
+                                                                           mode:kiTermSelectionModeCharacter
+                                                                          width:iTermSelectionIndexTestWidth] ]];
+    NSMutableIndexSet *expected = [NSMutableIndexSet indexSetWithIndexesInRange:NSMakeRange(0, iTermSelectionIndexTestWidth)];
+    [expected removeIndexesInRange:NSMakeRange(5, 10)];
+    XCTAssertEqualObjects([_selection selectedIndexesOnAbsoluteLine:3], expected);
+    XCTAssertTrue([_selection containsAbsCoord:VT100GridAbsCoordMake(4, 3)]);
+    XCTAssertFalse([_selection containsAbsCoord:VT100GridAbsCoordMake(5, 3)]);
+    XCTAssertFalse([_selection containsAbsCoord:VT100GridAbsCoordMake(14, 3)]);
+    XCTAssertTrue([_selection containsAbsCoord:VT100GridAbsCoordMake(15, 3)]);
+    XCTAssertFalse([_selection containsAbsCoord:VT100GridAbsCoordMake(15, 51)]);
+}
+
+#pragma mark - Performance
+
+// Draws 60 frames of a 300x100 screen with 1,000 sub-selections, asking about each line.
+- (void)testSelectedIndexesWithManySubSelectionsPerformance {
+    [_selection addSubSelections:[self randomSubSelections:1000]];
+    [self measureBlock:^{
+        iTermSelection *selection = [[_selection copy] autorelease];
+        for (int frame = 0; frame < 60; frame++) {
+            for (long long y = 0; y < iTermSelectionIndexTestHeight; y++) {
+                [selection selectedIndexesOnAbsoluteLine:y];
+            }
+        }
+    }];
+}
+
+// The same frames computed the way they were before the index existed.
+- (void)testUnindexedSelectedIndexesWithManySubSelectionsPerformance {
+    [_selection addSubSelections:[self randomSubSelections:1000]];
+    [self measureBlock:^{
+        for (int frame = 0; frame < 60; frame++) {
+            for (long long y = 0; y < iTermSelectionIndexTestHeight; y++) {
+                [self expectedIndexesOnLine:y];
+            }
+        }
+    }];
+}
+
+// Asks about every cell of a 300x100 screen with 1,000 sub-selections.
+- (void)testContainsAbsCoordWithManySubSelectionsPerformance {
+    [_selection addSubSelections:[self randomSubSelections:1000]];
+    [self measureBlock:^{
+        iTermSelection *selection = [[_selection copy] autorelease];
+        for (long long y = 0; y < iTermSelectionIndexTestHeight; y++) {
+            for (int x = 0; x < iTermSelectionIndexTestWidth; x++) {
+                [selection containsAbsCoord:VT100GridAbsCoordMake(x, y)];
+            }
+        }
+    }];
+}
+
+#pragma mark - iTermSelectionDelegate
+
+- (void)selectionDidChange:(iTermSelection *)selection {
+}
+
+- (VT100GridAbsWindowedRange)selectionAbsRangeForParentheticalAt:(VT100GridAbsCoord)coord {
+    return VT100GridAbsWindowedRangeMake(VT100GridAbsCoordRangeMake(-1, -1, -1, -1), 0, 0);
+}
+
+- (VT100GridAbsWindowedRange)selectionAbsRangeForWordAt:(VT100GridAbsCoord)coord {
+    return VT100GridAbsWindowedRangeMake(VT100GridAbsCoordRangeMake(coord.x, coord.y, coord.x + 1, coord.y), 0, 0);
+}
+
+- (VT100GridAbsWindowedRange)selectionAbsRangeForSmartSelectionAt:(VT100GridAbsCoord)coord {
+    return [self selectionAbsRangeForWordAt:coord];
+}
+
+- (VT100GridAbsWindowedRange)selectionAbsRangeForWrappedLineAt:(VT100GridAbsCoord)coord {
+    return [self selectionAbsRangeForLineAt:coord];
+}
+
+- (VT100GridAbsWindowedRange)selectionAbsRangeForLineAt:(VT100GridAbsCoord)coord {
+    return VT100GridAbsWindowedRangeMake(VT100GridAbsCoordRangeMake(0, coord.y, iTermSelectionIndexTestWidth, coord.y),
+                                         0,
+                                         0);
+}
+
+- (VT100GridRange)selectionRangeOfTerminalNullsOnAbsoluteLine:(long long)absLineNumber {
+    return VT100GridRangeMake(INT_MAX, 0);
+}
+
+- (VT100GridAbsCoord)selectionPredecessorOfAbsCoord:(VT100GridAbsCoord)coord {
+    if (coord.x > 0) {
+        return VT100GridAbsCoordMake(coord.x - 1, coord.y);
+    }
+    return VT100GridAbsCoordMake(iTermSelectionIndexTestWidth - 1, coord.y - 1);
+}
+
+- (int)selectionViewportWidth {
+    return iTermSelectionIndexTestWidth;
+}
+
+- (long long)selectionTotalScrollbackOverflow {
+    return _totalScrollbackOverflow;
+}
+
+- (NSIndexSet *)selectionIndexesOnAbsoluteLine:(long long)line
+                           containingCharacter:(unichar)c
+                                       inRange:(NSRange)range {
+    return [NSIndexSet indexSet];
+}
+
+@end
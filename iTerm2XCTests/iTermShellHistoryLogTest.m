@@ -0,0 +1,292 @@
+//
+//  iTermShellHistoryLogTest.m
+//  iTerm2XCTests
+//
+//  Created by George Nachman on 10/18/26.
+//
+
+#import <XCTest/XCTest.h>
+#import "iTermShellHistoryLog.h"
+#import "NSStringITerm.h"
+
+@interface iTermShellHistoryLogTest : XCTestCase
+@end
+
+@implementation iTermShellHistoryLogTest {
+    NSString *_path;
+}
+
+- (void)setUp {
+    _path = [[NSTemporaryDirectory() stringByAppendingPathComponent:[NSString uuid]] retain];
+}
+
+- (void)tearDown {
+    [[NSFileManager defaultManager] removeItemAtPath:_path error:nil];
+    [_path release];
+}
+
+- (iTermShellHistoryLogRecord *)recordWithType:(iTermShellHistoryLogRecordType)type
+                                          text:(NSString *)text
+                                          time:(NSTimeInterval)time {
+    iTermShellHistoryLogRecord *record = [iTermShellHistoryLogRecord recordWithType:type
+                                                                           username:@"user"
+                                                                           hostname:@"host"];
+    record.text = text;
+    record.time = time;
+    return record;
+}
+
+- (NSArray<iTermShellHistoryLogRecord *> *)recordsInLog:(iTermShellHistoryLog *)log hostKey:(NSString *)hostKey {
+    NSMutableArray<iTermShellHistoryLogRecord *> *records = [NSMutableArray array];
+    [log enumerateRecordsForHostKey:hostKey block:^(iTermShellHistoryLogRecord *record) {
+        [records addObject:record];
+    }];
+    return records;
+}
+
+- (NSArray<iTermShellHistoryLogRecord *> *)compactedRecordsInLog:(iTermShellHistoryLog *)log
+                                                          cutoff:(NSTimeInterval)cutoff {
+    NSMutableArray<iTermShellHistoryLogRecord *> *records = [NSMutableArray array];
+    [log enumerateCompactedRecordsForHostKey:@"user@host"
+                               commandCutoff:cutoff
+                             directoryCutoff:cutoff
+                                       block:^(iTermShellHistoryLogRecord *record) {
+        [records addObject:record];
+    }];
+    return records;
+}
+
+- (void)testRecordsRoundTrip {
+    iTermShellHistoryLog *log = [[[iTermShellHistoryLog alloc] initWithPath:_path] autorelease];
+    XCTAssertEqual(log.hostKeys.count, 0);
+
+    iTermShellHistoryLogRecord *use = [iTermShellHistoryLogRecord recordWithType:iTermShellHistoryLogRecordTypeCommandUse
+                                                                        username:@"user"
+                                                                        hostname:@"host"];
+    use.text = @"echo 🙂 café";
+    use.directory = @"/tmp";
+    use.markGuid = @"guid";
+    use.time = 1234.5;
+    use.count = -7;
+    use.code = @-1;
+    use.starred = YES;
+    XCTAssertTrue([log appendRecord:use]);
+
+    iTermShellHistoryLogRecord *other = [iTermShellHistoryLogRecord recordWithType:iTermShellHistoryLogRecordTypeEraseCommands
+                                                                          username:nil
+                                                                          hostname:@"elsewhere"];
+    XCTAssertTrue([log appendRecord:other]);
+
+    log = [[[iTermShellHistoryLog alloc] initWithPath:_path] autorelease];
+    NSArray<NSString *> *expectedHostKeys = @[ @"(null)@elsewhere", @"user@host" ];
+    XCTAssertEqualObjects([log.hostKeys sortedArrayUsingSelector:@selector(compare:)], expectedHostKeys);
+
+    NSArray<iTermShellHistoryLogRecord *> *records = [self recordsInLog:log hostKey:@"user@host"];
+    XCTAssertEqual(records.count, 1);
+    iTermShellHistoryLogRecord *record = records[0];
+    XCTAssertEqual(record.type, iTermShellHistoryLogRecordTypeCommandUse);
+    XCTAssertEqualObjects(record.username, @"user");
+    XCTAssertEqualObjects(record.hostname, @"host");
+    XCTAssertEqualObjects(record.text, @"echo 🙂 café");
+    XCTAssertEqualObjects(record.directory, @"/tmp");
+    XCTAssertEqualObjects(record.markGuid, @"guid");
+    XCTAssertEqual(record.time, 1234.5);
+    XCTAssertEqual(record.count, -7);
+    XCTAssertEqualObjects(record.code, @-1);
+    XCTAssertTrue(record.starred);
+
+    records = [self recordsInLog:log hostKey:@"(null)@elsewhere"];
+    XCTAssertEqual(records.count, 1);
+    XCTAssertEqual(records[0].type, iTermShellHistoryLogRecordTypeEraseCommands);
+    XCTAssertNil(records[0].username);
+    XCTAssertNil(records[0].text);
+    XCTAssertNil(records[0].code);
+    XCTAssertFalse(records[0].starred);
+}
+
+- (void)testTornRecordIsRemoved {
+    iTermShellHistoryLog *log = [[[iTermShellHistoryLog alloc] initWithPath:_path] autorelease];
+    [log appendRecord:[self recordWithType:iTermShellHistoryLogRecordTypeDirectory text:@"/one" time:1]];
+    [log appendRecord:[self recordWithType:iTermShellHistoryLogRecordTypeDirectory text:@"/two" time:2]];
+    const unsigned long long intactSize = log.size;
+
+    // Cut the last record short, as a crash partway through a write would.
+    NSData *data = [NSData dataWithContentsOfFile:_path];
+    [[data subdataWithRange:NSMakeRange(0, data.length - 3)] writeToFile:_path atomically:NO];
+    log = [[[iTermShellHistoryLog alloc] initWithPath:_path] autorelease];
+    NSArray<iTermShellHistoryLogRecord *> *records = [self recordsInLog:log hostKey:@"user@host"];
+    XCTAssertEqual(records.count, 1);
+    XCTAssertEqualObjects(records[0].text, @"/one");
+
+    // Appending after the damage is removed works.
+    [log appendRecord:[self recordWithType:iTermShellHistoryLogRecordTypeDirectory text:@"/six" time:6]];
+    log = [[[iTermShellHistoryLog alloc] initWithPath:_path] autorelease];
+    records = [self recordsInLog:log hostKey:@"user@host"];
+    XCTAssertEqual(records.count, 2);
+    XCTAssertEqualObjects(records[1].text, @"/six");
+    XCTAssertEqual(log.size, intactSize);
+}
+
+- (void)testCorruptRecordIsRemoved {
+    iTermShellHistoryLog *log = [[[iTermShellHistoryLog alloc] initWithPath:_path] autorelease];
+    [log appendRecord:[self recordWithType:iTermShellHistoryLogRecordTypeDirectory text:@"/one" time:1]];
+    const unsigned long long firstSize = log.size;
+    [log appendRecord:[self recordWithType:iTermShellHistoryLogRecordTypeDirectory text:@"/two" time:2]];
+
+    NSMutableData *data = [NSMutableData dataWithContentsOfFile:_path];
+    ((char *)data.mutableBytes)[data.length - 1] ^= 0xff;
+    [data writeToFile:_path atomically:NO];
+
+    log = [[[iTermShellHistoryLog alloc] initWithPath:_path] autorelease];
+    XCTAssertEqual([self recordsInLog:log hostKey:@"user@host"].count, 1);
+    XCTAssertEqual(log.size, firstSize);
+}
+
+- (void)testCompactedRecords {
+    iTermShellHistoryLog *log = [[[iTermShellHistoryLog alloc] initWithPath:_path] autorelease];
+    // An erased command.
+    [log appendRecord:[self recordWithType:iTermShellHistoryLogRecordTypeCommandEntry text:@"erased" time:10]];
+    [log appendRecord:[self recordWithType:iTermShellHistoryLogRecordTypeCommandUse text:@"erased" time:10]];
+    [log appendRecord:[self recordWithType:iTermShellHistoryLogRecordTypeEraseCommands text:nil time:0]];
+
+    // A command used twice, once too long ago to keep, with a status set after the fact.
+    for (int i = 0; i < 2; i++) {
+        iTermShellHistoryLogRecord *entry = [self recordWithType:iTermShellHistoryLogRecordTypeCommandEntry
+                                                            text:@"make"
+                                                            time:50 + i * 50];
+        entry.count = i + 1;
+        [log appendRecord:entry];
+        iTermShellHistoryLogRecord *use = [self recordWithType:iTermShellHistoryLogRecordTypeCommandUse
+                                                          text:@"make"
+                                                          time:50 + i * 50];
+        use.markGuid = [NSString stringWithFormat:@"mark%d", i];
+        [log appendRecord:use];
+    }
+    iTermShellHistoryLogRecord *status = [self recordWithType:iTermShellHistoryLogRecordTypeCommandStatus text:nil time:0];
+    status.markGuid = @"mark1";
+    status.code = @2;
+    [log appendRecord:status];
+
+    // A command whose only use is too old.
+    [log appendRecord:[self recordWithType:iTermShellHistoryLogRecordTypeCommandEntry text:@"old" time:1]];
+    [log appendRecord:[self recordWithType:iTermShellHistoryLogRecordTypeCommandUse text:@"old" time:1]];
+
+    // Directories: one used repeatedly, one too old, and one too old but starred.
+    for (int i = 0; i < 3; i++) {
+        iTermShellHistoryLogRecord *directory = [self recordWithType:iTermShellHistoryLogRecordTypeDirectory
+                                                                text:@"/used"
+                                                                time:80 + i];
+        directory.count = i + 1;
+        [log appendRecord:directory];
+    }
+    [log appendRecord:[self recordWithType:iTermShellHistoryLogRecordTypeDirectory text:@"/old" time:1]];
+    iTermShellHistoryLogRecord *starred = [self recordWithType:iTermShellHistoryLogRecordTypeDirectory
+                                                          text:@"/starred"
+                                                          time:1];
+    starred.starred = YES;
+    [log appendRecord:starred];
+
+    NSArray<iTermShellHistoryLogRecord *> *records = [self compactedRecordsInLog:log cutoff:75];
+    XCTAssertEqual(records.count, 4);
+
+    XCTAssertEqual(records[0].type, iTermShellHistoryLogRecordTypeCommandEntry);
+    XCTAssertEqualObjects(records[0].text, @"make");
+    XCTAssertEqual(records[0].count, 2);
+    XCTAssertEqual(records[0].time, 100);
+
+    XCTAssertEqual(records[1].type, iTermShellHistoryLogRecordTypeCommandUse);
+    XCTAssertEqualObjects(records[1].markGuid, @"mark1");
+    XCTAssertEqualObjects(records[1].code, @2);
+
+    XCTAssertEqual(records[2].type, iTermShellHistoryLogRecordTypeDirectory);
+    XCTAssertEqualObjects(records[2].text, @"/used");
+    XCTAssertEqual(records[2].count, 3);
+
+    XCTAssertEqualObjects(records[3].text, @"/starred");
+    XCTAssertTrue(records[3].starred);
+}
+
+- (void)testReplaceContents {
+    iTermShellHistoryLog *log = [[[iTermShellHistoryLog alloc] initWithPath:_path] autorelease];
+    for (int i = 0; i < 100; i++) {
+        [log appendRecord:[self recordWithType:iTermShellHistoryLogRecordTypeDirectory text:@"/path" time:i]];
+    }
+    const unsigned long long sizeBefore = log.size;
+    XCTAssertTrue([log replaceContentsUsingBlock:^(void (^append)(iTermShellHistoryLogRecord *)) {
+        [log enumerateCompactedRecordsForHostKey:@"user@host"
+                                   commandCutoff:0
+                                 directoryCutoff:0
+                                           block:^(iTermShellHistoryLogRecord *record) {
+            append(record);
+        }];
+    }]);
+    XCTAssertLessThan(log.size, sizeBefore);
+    XCTAssertEqual(log.size, log.sizeAfterLastReplacement);
+    XCTAssertFalse([[NSFileManager defaultManager] fileExistsAtPath:[_path stringByAppendingString:@".tmp"]]);
+
+    // Appends go to the new file.
+    [log appendRecord:[self recordWithType:iTermShellHistoryLogRecordTypeDirectory text:@"/other" time:200]];
+    XCTAssertEqual([self recordsInLog:log hostKey:@"user@host"].count, 2);
+
+    log = [[[iTermShellHistoryLog alloc] initWithPath:_path] autorelease];
+    NSArray<iTermShellHistoryLogRecord *> *records = [self recordsInLog:log hostKey:@"user@host"];
+    XCTAssertEqual(records.count, 2);
+    XCTAssertEqualObjects(records[0].text, @"/path");
+    XCTAssertEqual(records[0].time, 99);
+    XCTAssertEqualObjects(records[1].text, @"/other");
+}
+
+- (void)testReplaceFromSnapshotKeepsLaterAppends {
+    iTermShellHistoryLog *log = [[[iTermShellHistoryLog alloc] initWithPath:_path] autorelease];
+    for (int i = 0; i < 100; i++) {
+        [log appendRecord:[self recordWithType:iTermShellHistoryLogRecordTypeDirectory text:@"/path" time:i]];
+    }
+    iTermShellHistoryLog *snapshot = [[log newSnapshot] autorelease];
+    XCTAssertNotNil(snapshot);
+
+    // Appended after the snapshot was taken, so the replacement doesn't contain it.
+    [log appendRecord:[self recordWithType:iTermShellHistoryLogRecordTypeDirectory text:@"/other" time:200]];
+
+    XCTAssertTrue([snapshot writeReplacementUsingBlock:^(void (^append)(iTermShellHistoryLogRecord *)) {
+        [snapshot enumerateCompactedRecordsForHostKey:@"user@host"
+                                        commandCutoff:0
+                                      directoryCutoff:0
+                                                block:^(iTermShellHistoryLogRecord *record) {
+            append(record);
+        }];
+    }]);
+    XCTAssertTrue([log replaceContentsWithReplacementFromSnapshot:snapshot]);
+    NSArray<iTermShellHistoryLogRecord *> *records = [self recordsInLog:log hostKey:@"user@host"];
+    XCTAssertEqual(records.count, 2);
+    XCTAssertEqualObjects(records[1].text, @"/other");
+
+    log = [[[iTermShellHistoryLog alloc] initWithPath:_path] autorelease];
+    records = [self recordsInLog:log hostKey:@"user@host"];
+    XCTAssertEqual(records.count, 2);
+    XCTAssertEqualObjects(records[0].text, @"/path");
+    XCTAssertEqual(records[0].time, 99);
+    XCTAssertEqualObjects(records[1].text, @"/other");
+}
+
+- (void)testReplaceFromStaleSnapshotFails {
+    iTermShellHistoryLog *log = [[[iTermShellHistoryLog alloc] initWithPath:_path] autorelease];
+    [log appendRecord:[self recordWithType:iTermShellHistoryLogRecordTypeDirectory text:@"/path" time:1]];
+    iTermShellHistoryLog *snapshot = [[log newSnapshot] autorelease];
+    XCTAssertTrue([snapshot writeReplacementUsingBlock:^(void (^append)(iTermShellHistoryLogRecord *)) {}]);
+
+    // Another replacement since the snapshot means the snapshot's replacement is out of date.
+    XCTAssertTrue([log replaceContentsUsingBlock:^(void (^append)(iTermShellHistoryLogRecord *)) {
+        [log enumerateRecordsForHostKey:@"user@host" block:^(iTermShellHistoryLogRecord *record) {
+            append(record);
+        }];
+    }]);
+    XCTAssertFalse([log replaceContentsWithReplacementFromSnapshot:snapshot]);
+    XCTAssertEqual([self recordsInLog:log hostKey:@"user@host"].count, 1);
+}
+
+- (void)testNotALog {
+    [@"not a log" writeToFile:_path atomically:NO encoding:NSUTF8StringEncoding error:nil];
+    XCTAssertNil([[[iTermShellHistoryLog alloc] initWithPath:_path] autorelease]);
+}
+
+@end
@@ -10,6 +10,7 @@
 #import "iTermCommandHistoryEntryMO.h"
 #import "iTermHostRecordMO.h"
 #import "iTermShellHistoryController.h"
+#import "iTermShellHistoryLog.h"
 #import "NSStringITerm.h"
 #import "VT100RemoteHost.h"
 #import "VT100ScreenMark.h"
@@ -17,6 +18,7 @@
 static NSString *const kFakeCommandHistoryPlistPath = @"/tmp/fake_command_history.plist";
 static NSString *const kFakeDirectoriesPlistPath = @"/tmp/fake_directories.plist";
 static NSString *const kSqlitePathForTest = @"/tmp/test_command_history.sqlite";
+static NSString *const kLogPathForTest = @"/tmp/test_shell_history.log";
 static NSTimeInterval kDefaultTime = 10000000;
 
 @interface iTermShellHistoryControllerForTesting : iTermShellHistoryController
@@ -50,6 +52,8 @@ static NSTimeInterval kDefaultTime = 10000000;
         return [kFakeCommandHistoryPlistPath stringByAppendingString:self.guid];
     } else if ([name isEqualTo:@"directories.plist"]) {
         return [kFakeDirectoriesPlistPath stringByAppendingString:self.guid];
+    } else if ([name isEqualTo:@"ShellHistory.log"]) {
+        return [kLogPathForTest stringByAppendingString:self.guid];
     } else {
         return [kSqlitePathForTest stringByAppendingString:self.guid];
     }
@@ -110,6 +114,38 @@ static NSTimeInterval kDefaultTime = 10000000;
 
 @end
 
+@interface iTermShellHistoryControllerWithLogForTesting : iTermShellHistoryControllerWithConfigurableStoreDefaultingToDiskForTesting
+@property(nonatomic) BOOL logEnabled;
+
+- (instancetype)initWithGuid:(NSString *)guid logEnabled:(BOOL)logEnabled;
+
+@end
+
+@implementation iTermShellHistoryControllerWithLogForTesting
+
+- (instancetype)initWithGuid:(NSString *)guid {
+    return [self initWithGuid:guid logEnabled:YES];
+}
+
+- (instancetype)initWithGuid:(NSString *)guid logEnabled:(BOOL)logEnabled {
+    self = [super initPartially];
+    if (self) {
+        self.guid = guid;
+        self.saveToDisk = YES;
+        self.logEnabled = logEnabled;
+        if (![self finishInitialization]) {
+            return nil;
+        }
+    }
+    return self;
+}
+
+- (BOOL)logStorageEnabled {
+    return self.logEnabled;
+}
+
+@end
+
 @interface iTermShellHistoryTest : XCTestCase
 
 @end
@@ -1204,4 +1240,303 @@ static NSTimeInterval kDefaultTime = 10000000;
     XCTAssertTrue([historyController haveCommandsForHost:remoteHost]);
 }
 
+
+#pragma mark - Log
+
+- (VT100RemoteHost *)remoteHostWithUsername:(NSString *)username hostname:(NSString *)hostname {
+    VT100RemoteHost *remoteHost = [[[VT100RemoteHost alloc] init] autorelease];
+    remoteHost.username = username;
+    remoteHost.hostname = hostname;
+    return remoteHost;
+}
+
+- (NSDictionary<NSString *, iTermRecentDirectoryMO *> *)directoriesByPathInController:(iTermShellHistoryController *)historyController
+                                                                               onHost:(VT100RemoteHost *)remoteHost {
+    NSMutableDictionary<NSString *, iTermRecentDirectoryMO *> *result = [NSMutableDictionary dictionary];
+    for (iTermRecentDirectoryMO *directory in [historyController directoriesSortedByScoreOnHost:remoteHost]) {
+        result[directory.path] = directory;
+    }
+    return result;
+}
+
+- (unsigned long long)sizeOfLog {
+    NSString *path = [kLogPathForTest stringByAppendingString:_guid];
+    return [[[NSFileManager defaultManager] attributesOfItemAtPath:path error:nil] fileSize];
+}
+
+- (void)testLogRoundTrip {
+    iTermShellHistoryControllerWithLogForTesting *historyController =
+        [[[iTermShellHistoryControllerWithLogForTesting alloc] initWithGuid:_guid] autorelease];
+    VT100RemoteHost *remoteHost = [self remoteHostWithUsername:@"user1" hostname:@"host1"];
+    VT100ScreenMark *mark1 = [[[VT100ScreenMark alloc] init] autorelease];
+    VT100ScreenMark *mark2 = [[[VT100ScreenMark alloc] init] autorelease];
+
+    historyController.currentTime = kDefaultTime - 10;
+    [historyController addCommand:@"make" onHost:remoteHost inDirectory:@"/src" withMark:mark1];
+    historyController.currentTime = kDefaultTime;
+    [historyController addCommand:@"make" onHost:remoteHost inDirectory:@"/src" withMark:mark2];
+    [historyController addCommand:@"ls" onHost:remoteHost inDirectory:@"/tmp" withMark:nil];
+    [historyController setStatusOfCommandAtMark:mark2 onHost:remoteHost to:2];
+
+    [historyController recordUseOfPath:@"/src" onHost:remoteHost isChange:YES];
+    [historyController recordUseOfPath:@"/src" onHost:remoteHost isChange:YES];
+    iTermRecentDirectoryMO *directory = [historyController recordUseOfPath:@"/tmp"
+                                                                    onHost:remoteHost
+                                                                  isChange:YES];
+    [historyController setDirectory:directory starred:YES];
+    [historyController flushLog];
+
+    historyController = [[[iTermShellHistoryControllerWithLogForTesting alloc] initWithGuid:_guid] autorelease];
+    XCTAssertFalse([[NSFileManager defaultManager] fileExistsAtPath:[kSqlitePathForTest stringByAppendingString:_guid]]);
+    XCTAssertTrue([historyController commandHistoryHasEverBeenUsed]);
+    XCTAssertFalse([historyController haveCommandsForHost:[self remoteHostWithUsername:@"user2" hostname:@"host1"]]);
+
+    NSArray<iTermCommandHistoryEntryMO *> *entries =
+        [historyController commandHistoryEntriesWithPrefix:@"" onHost:remoteHost];
+    XCTAssertEqual(entries.count, 2);
+    XCTAssertEqualObjects(entries[0].command, @"make");
+    XCTAssertEqualObjects(entries[0].numberOfUses, @2);
+    XCTAssertEqualObjects(entries[0].timeOfLastUse, @(kDefaultTime));
+    XCTAssertEqual(entries[0].uses.count, 2);
+    XCTAssertEqualObjects(entries[0].uses[0].markGuid, mark1.guid);
+    XCTAssertEqualObjects(entries[0].uses[0].time, @(kDefaultTime - 10));
+    XCTAssertNil(entries[0].uses[0].code);
+    XCTAssertEqualObjects(entries[0].uses[1].markGuid, mark2.guid);
+    XCTAssertEqualObjects(entries[0].uses[1].directory, @"/src");
+    XCTAssertEqualObjects(entries[0].uses[1].code, @2);
+    XCTAssertEqualObjects(entries[0].uses[1].command, @"make");
+    XCTAssertEqualObjects(entries[1].command, @"ls");
+    XCTAssertEqualObjects([historyController commandUseWithMarkGuid:mark2.guid onHost:remoteHost].code, @2);
+
+    NSDictionary<NSString *, iTermRecentDirectoryMO *> *directories =
+        [self directoriesByPathInController:historyController onHost:remoteHost];
+    XCTAssertEqual(directories.count, 2);
+    XCTAssertEqualObjects(directories[@"/src"].useCount, @2);
+    XCTAssertEqualObjects(directories[@"/src"].starred, @NO);
+    XCTAssertEqualObjects(directories[@"/tmp"].useCount, @1);
+    XCTAssertEqualObjects(directories[@"/tmp"].starred, @YES);
+}
+
+- (void)testMigrationBetweenDatabaseAndLog {
+    VT100RemoteHost *remoteHost = [self remoteHostWithUsername:@"user1" hostname:@"host1"];
+    NSString *databasePath = [kSqlitePathForTest stringByAppendingString:_guid];
+    NSString *logPath = [kLogPathForTest stringByAppendingString:_guid];
+    iTermShellHistoryControllerWithLogForTesting *historyController =
+        [[[iTermShellHistoryControllerWithLogForTesting alloc] initWithGuid:_guid logEnabled:NO] autorelease];
+    [historyController addCommand:@"command1" onHost:remoteHost inDirectory:@"/directory1" withMark:nil];
+    [historyController recordUseOfPath:@"/directory1" onHost:remoteHost isChange:YES];
+    XCTAssertTrue([[NSFileManager defaultManager] fileExistsAtPath:databasePath]);
+    XCTAssertFalse([[NSFileManager defaultManager] fileExistsAtPath:logPath]);
+
+    // Database to log.
+    historyController = [[[iTermShellHistoryControllerWithLogForTesting alloc] initWithGuid:_guid logEnabled:YES] autorelease];
+    XCTAssertFalse([[NSFileManager defaultManager] fileExistsAtPath:databasePath]);
+    XCTAssertTrue([[NSFileManager defaultManager] fileExistsAtPath:logPath]);
+    XCTAssertTrue([historyController haveCommandsForHost:remoteHost]);
+    XCTAssertTrue([historyController haveDirectoriesForHost:remoteHost]);
+    [historyController addCommand:@"command2" onHost:remoteHost inDirectory:@"/directory1" withMark:nil];
+    [historyController flushLog];
+
+    // Log back to database.
+    historyController = [[[iTermShellHistoryControllerWithLogForTesting alloc] initWithGuid:_guid logEnabled:NO] autorelease];
+    XCTAssertFalse([[NSFileManager defaultManager] fileExistsAtPath:logPath]);
+    XCTAssertEqual([historyController commandHistoryEntriesWithPrefix:@"command" onHost:remoteHost].count, 2);
+    XCTAssertTrue([historyController haveDirectoriesForHost:remoteHost]);
+
+    historyController = [[[iTermShellHistoryControllerWithLogForTesting alloc] initWithGuid:_guid logEnabled:NO] autorelease];
+    XCTAssertEqual([historyController commandHistoryEntriesWithPrefix:@"command" onHost:remoteHost].count, 2);
+}
+
+// A database next to an existing log may hold history the log doesn't, as after running an older
+// version, so it is not deleted.
+- (void)testDatabaseIsKeptWhenLogAlreadyExists {
+    VT100RemoteHost *remoteHost = [self remoteHostWithUsername:@"user1" hostname:@"host1"];
+    NSString *databasePath = [kSqlitePathForTest stringByAppendingString:_guid];
+    NSString *logPath = [kLogPathForTest stringByAppendingString:_guid];
+    iTermShellHistoryControllerWithLogForTesting *historyController =
+        [[[iTermShellHistoryControllerWithLogForTesting alloc] initWithGuid:_guid logEnabled:NO] autorelease];
+    [historyController addCommand:@"command1" onHost:remoteHost inDirectory:@"/directory1" withMark:nil];
+    XCTAssertTrue([iTermShellHistoryLog writeLogAtPath:logPath usingBlock:^(void (^append)(iTermShellHistoryLogRecord *)) {}]);
+
+    historyController = [[[iTermShellHistoryControllerWithLogForTesting alloc] initWithGuid:_guid logEnabled:YES] autorelease];
+    XCTAssertTrue([[NSFileManager defaultManager] fileExistsAtPath:databasePath]);
+    XCTAssertTrue([[NSFileManager defaultManager] fileExistsAtPath:logPath]);
+}
+
+- (void)testLogCompaction {
+    iTermShellHistoryControllerWithLogForTesting *historyController =
+        [[[iTermShellHistoryControllerWithLogForTesting alloc] initWithGuid:_guid] autorelease];
+    VT100RemoteHost *remoteHost = [self remoteHostWithUsername:@"user1" hostname:@"host1"];
+    for (int i = 0; i < 2000; i++) {
+        [historyController recordUseOfPath:[NSString stringWithFormat:@"/path/%d", i % 10]
+                                    onHost:remoteHost
+                                  isChange:YES];
+    }
+
+    // Too old to keep.
+    historyController.currentTime = kDefaultTime - (60 * 60 * 24 * 90 + 1);
+    [historyController addCommand:@"old" onHost:remoteHost inDirectory:@"/path/0" withMark:nil];
+    historyController.currentTime = kDefaultTime;
+    [historyController addCommand:@"new" onHost:remoteHost inDirectory:@"/path/0" withMark:nil];
+    [historyController flushLog];
+
+    const unsigned long long sizeBeforeCompaction = self.sizeOfLog;
+    [historyController compactLog];
+    XCTAssertLessThan(self.sizeOfLog * 10, sizeBeforeCompaction);
+
+    historyController = [[[iTermShellHistoryControllerWithLogForTesting alloc] initWithGuid:_guid] autorelease];
+    NSDictionary<NSString *, iTermRecentDirectoryMO *> *directories =
+        [self directoriesByPathInController:historyController onHost:remoteHost];
+    XCTAssertEqual(directories.count, 10);
+    for (iTermRecentDirectoryMO *directory in directories.allValues) {
+        XCTAssertEqualObjects(directory.useCount, @200);
+    }
+    NSArray<iTermCommandHistoryEntryMO *> *entries =
+        [historyController commandHistoryEntriesWithPrefix:@"" onHost:remoteHost];
+    XCTAssertEqual(entries.count, 1);
+    XCTAssertEqualObjects(entries[0].command, @"new");
+}
+
+- (void)testLogCompactsItself {
+    iTermShellHistoryControllerWithLogForTesting *historyController =
+        [[[iTermShellHistoryControllerWithLogForTesting alloc] initWithGuid:_guid] autorelease];
+    VT100RemoteHost *remoteHost = [self remoteHostWithUsername:@"user1" hostname:@"host1"];
+    for (int i = 0; i < 30000; i++) {
+        [historyController recordUseOfPath:[NSString stringWithFormat:@"/path/%d", i % 10]
+                                    onHost:remoteHost
+                                  isChange:YES];
+    }
+    [historyController flushLog];
+    XCTAssertLessThan(self.sizeOfLog, 1024 * 1024);
+
+    historyController = [[[iTermShellHistoryControllerWithLogForTesting alloc] initWithGuid:_guid] autorelease];
+    NSDictionary<NSString *, iTermRecentDirectoryMO *> *directories =
+        [self directoriesByPathInController:historyController onHost:remoteHost];
+    XCTAssertEqual(directories.count, 10);
+    XCTAssertEqualObjects(directories[@"/path/3"].useCount, @3000);
+}
+
+- (void)testEraseHistoryOfHostsNotYetLoadedFromLog {
+    VT100RemoteHost *remoteHost = [self remoteHostWithUsername:@"user1" hostname:@"host1"];
+    iTermShellHistoryControllerWithLogForTesting *historyController =
+        [[[iTermShellHistoryControllerWithLogForTesting alloc] initWithGuid:_guid] autorelease];
+    [historyController addCommand:@"command" onHost:remoteHost inDirectory:@"/directory" withMark:nil];
+    [historyController recordUseOfPath:@"/directory" onHost:remoteHost isChange:YES];
+    [historyController flushLog];
+
+    historyController = [[[iTermShellHistoryControllerWithLogForTesting alloc] initWithGuid:_guid] autorelease];
+    [historyController eraseCommandHistory:YES directories:NO];
+    XCTAssertFalse([historyController haveCommandsForHost:remoteHost]);
+    XCTAssertTrue([historyController haveDirectoriesForHost:remoteHost]);
+
+    NSData *log = [NSData dataWithContentsOfFile:[kLogPathForTest stringByAppendingString:_guid]];
+    XCTAssertEqual([log rangeOfData:[@"command" dataUsingEncoding:NSUTF8StringEncoding]
+                            options:0
+                              range:NSMakeRange(0, log.length)].location, NSNotFound);
+
+    historyController = [[[iTermShellHistoryControllerWithLogForTesting alloc] initWithGuid:_guid] autorelease];
+    XCTAssertFalse([historyController haveCommandsForHost:remoteHost]);
+    XCTAssertTrue([historyController haveDirectoriesForHost:remoteHost]);
+}
+
+- (void)testEraseHostWithLog {
+    VT100RemoteHost *remoteHost = [self remoteHostWithUsername:@"user1" hostname:@"host1"];
+    iTermShellHistoryControllerWithLogForTesting *historyController =
+        [[[iTermShellHistoryControllerWithLogForTesting alloc] initWithGuid:_guid] autorelease];
+    [historyController addCommand:@"command" onHost:remoteHost inDirectory:@"/directory" withMark:nil];
+    [historyController recordUseOfPath:@"/directory" onHost:remoteHost isChange:YES];
+    [historyController eraseCommandHistoryForHost:remoteHost];
+    [historyController addCommand:@"command2" onHost:remoteHost inDirectory:@"/directory" withMark:nil];
+    [historyController eraseDirectoriesForHost:remoteHost];
+    [historyController flushLog];
+
+    historyController = [[[iTermShellHistoryControllerWithLogForTesting alloc] initWithGuid:_guid] autorelease];
+    NSArray<iTermCommandHistoryEntryMO *> *entries =
+        [historyController commandHistoryEntriesWithPrefix:@"" onHost:remoteHost];
+    XCTAssertEqual(entries.count, 1);
+    XCTAssertEqualObjects(entries[0].command, @"command2");
+    XCTAssertFalse([historyController haveDirectoriesForHost:remoteHost]);
+}
+
+- (void)testBackingStoreDidChangeWithLog {
+    VT100RemoteHost *remoteHost = [self remoteHostWithUsername:@"user1" hostname:@"host1"];
+    NSString *logPath = [kLogPathForTest stringByAppendingString:_guid];
+    iTermShellHistoryControllerWithLogForTesting *historyController =
+        [[[iTermShellHistoryControllerWithLogForTesting alloc] initWithGuid:_guid] autorelease];
+    [historyController addCommand:@"command1" onHost:remoteHost inDirectory:@"/directory" withMark:nil];
+    [historyController recordUseOfPath:@"/directory" onHost:remoteHost isChange:YES];
+    [historyController flushLog];
+
+    // Loads everything into memory and removes the log.
+    historyController = [[[iTermShellHistoryControllerWithLogForTesting alloc] initWithGuid:_guid] autorelease];
+    historyController.saveToDisk = NO;
+    [historyController backingStoreTypeDidChange];
+    XCTAssertFalse([[NSFileManager defaultManager] fileExistsAtPath:logPath]);
+    XCTAssertTrue([historyController haveCommandsForHost:remoteHost]);
+    XCTAssertTrue([historyController haveDirectoriesForHost:remoteHost]);
+    [historyController addCommand:@"command2" onHost:remoteHost inDirectory:@"/directory" withMark:nil];
+
+    // Writes everything to a new log.
+    historyController.saveToDisk = YES;
+    [historyController backingStoreTypeDidChange];
+    XCTAssertTrue([[NSFileManager defaultManager] fileExistsAtPath:logPath]);
+    XCTAssertFalse([[NSFileManager defaultManager] fileExistsAtPath:[kSqlitePathForTest stringByAppendingString:_guid]]);
+
+    historyController = [[[iTermShellHistoryControllerWithLogForTesting alloc] initWithGuid:_guid] autorelease];
+    XCTAssertEqual([historyController commandHistoryEntriesWithPrefix:@"command" onHost:remoteHost].count, 2);
+    XCTAssertTrue([historyController haveDirectoriesForHost:remoteHost]);
+}
+
+#pragma mark - Performance
+
+// Half a million command uses spread over 100 hosts. Only the host that's asked about is loaded.
+- (void)testLaunchWithLargeLogPerformance {
+    NSString *path = [kLogPathForTest stringByAppendingString:_guid];
+    [iTermShellHistoryLog writeLogAtPath:path usingBlock:^(void (^append)(iTermShellHistoryLogRecord *)) {
+        for (int host = 0; host < 100; host++) {
+            NSString *hostname = [NSString stringWithFormat:@"host%d", host];
+            for (int command = 0; command < 1000; command++) {
+                NSString *text = [NSString stringWithFormat:@"command %d", command];
+                iTermShellHistoryLogRecord *entry =
+                    [iTermShellHistoryLogRecord recordWithType:iTermShellHistoryLogRecordTypeCommandEntry
+                                                      username:@"user"
+                                                      hostname:hostname];
+                entry.text = text;
+                entry.count = 5;
+                entry.time = kDefaultTime - command;
+                append(entry);
+                for (int use = 0; use < 5; use++) {
+                    iTermShellHistoryLogRecord *record =
+                        [iTermShellHistoryLogRecord recordWithType:iTermShellHistoryLogRecordTypeCommandUse
+                                                          username:@"user"
+                                                          hostname:hostname];
+                    record.text = text;
+                    record.directory = @"/Users/user/src";
+                    record.markGuid = [NSString stringWithFormat:@"%d-%d-%d", host, command, use];
+                    record.time = kDefaultTime - command - use;
+                    record.code = @0;
+                    append(record);
+                }
+            }
+            for (int directory = 0; directory < 100; directory++) {
+                iTermShellHistoryLogRecord *record =
+                    [iTermShellHistoryLogRecord recordWithType:iTermShellHistoryLogRecordTypeDirectory
+                                                      username:@"user"
+                                                      hostname:hostname];
+                record.text = [NSString stringWithFormat:@"/Users/user/src/%d", directory];
+                record.count = directory;
+                record.time = kDefaultTime - directory;
+                append(record);
+            }
+        }
+    }];
+    VT100RemoteHost *remoteHost = [self remoteHostWithUsername:@"user" hostname:@"host7"];
+    [self measureBlock:^{
+        iTermShellHistoryControllerWithLogForTesting *historyController =
+            [[iTermShellHistoryControllerWithLogForTesting alloc] initWithGuid:_guid];
+        XCTAssertEqual([historyController commandHistoryEntriesWithPrefix:@"command 12" onHost:remoteHost].count, 11);
+        [historyController release];
+    }];
+}
+
 @end
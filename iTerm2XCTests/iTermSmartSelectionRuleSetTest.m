@@ -0,0 +1,179 @@
+//
+//  iTermSmartSelectionRuleSetTest.m
+//  iTerm2XCTests
+//
+//  Created by George Nachman on 10/18/26.
+//
+
+#import <XCTest/XCTest.h>
+#import "iTermSmartSelectionRuleSet.h"
+#import "RegexKitLite.h"
+#import "SmartSelectionController.h"
+
+@interface iTermSmartSelectionRuleSetTest : XCTestCase
+@end
+
+@implementation iTermSmartSelectionRuleSetTest
+
+- (NSArray<NSString *> *)cases {
+    NSString *root = [[@(__FILE__) stringByDeletingLastPathComponent] stringByDeletingLastPathComponent];
+    NSString *path = [root stringByAppendingPathComponent:@"tests/smart_selection_cases.txt"];
+    NSString *contents = [NSString stringWithContentsOfFile:path encoding:NSUTF8StringEncoding error:nil];
+    XCTAssertNotNil(contents, @"Can't read %@", path);
+    NSMutableArray<NSString *> *cases = [NSMutableArray array];
+    for (NSString *line in [contents componentsSeparatedByString:@"\n"]) {
+        if (line.length) {
+            [cases addObject:line];
+        }
+    }
+    return cases;
+}
+
+// Describes each match as a string so results can be compared with XCTAssertEqualObjects.
+- (NSArray<NSString *> *)matchesInString:(NSString *)string
+                                coveringOffset:(NSInteger)offset
+                                         rules:(NSArray<NSDictionary *> *)rules {
+    NSMutableArray<NSString *> *matches = [NSMutableArray array];
+    iTermSmartSelectionRuleSet *ruleSet = [iTermSmartSelectionRuleSet ruleSetWithRules:rules];
+    [ruleSet enumerateMatchesInString:string
+                       coveringOffset:offset
+                       actionRequired:NO
+                                block:^(NSDictionary *rule, double precision, NSRange range, NSArray<NSString *> *components) {
+                                    [matches addObject:[NSString stringWithFormat:@"%@ %@ %@ %@",
+                                                        @([rules indexOfObjectIdenticalTo:rule]),
+                                                        @(precision),
+                                                        NSStringFromRange(range),
+                                                        components]];
+                                }];
+    return matches;
+}
+
+// The algorithm iTermTextExtractor used before rule sets: search a fresh substring starting at
+// each candidate offset, then run the regex again for its capture components.
+- (NSArray<NSString *> *)referenceMatchesInString:(NSString *)textWindow
+                                   coveringOffset:(NSInteger)targetOffset
+                                            rules:(NSArray<NSDictionary *> *)rules {
+    NSMutableArray<NSString *> *matches = [NSMutableArray array];
+    for (NSUInteger j = 0; j < rules.count; j++) {
+        NSDictionary *rule = rules[j];
+        NSString *regex = [SmartSelectionController regexInRule:rule];
+        double precision = [SmartSelectionController precisionInRule:rule];
+        for (int i = 0; i <= targetOffset; i++) {
+            NSString* substring = [textWindow substringWithRange:NSMakeRange(i, [textWindow length] - i)];
+            NSError* regexError = nil;
+            NSRange temp = [substring rangeOfRegex:regex
+                                           options:0
+                                           inRange:NSMakeRange(0, [substring length])
+                                           capture:0
+                                             error:&regexError];
+            if (temp.location != NSNotFound) {
+                if (i + temp.location <= targetOffset && i + temp.location + temp.length > targetOffset) {
+                    NSArray *components = [substring captureComponentsMatchedByRegex:regex
+                                                                             options:0
+                                                                               range:NSMakeRange(0, [substring length])
+                                                                               error:&regexError];
+                    [matches addObject:[NSString stringWithFormat:@"%@ %@ %@ %@",
+                                        @(j),
+                                        @(precision),
+                                        NSStringFromRange(NSMakeRange(i + temp.location, temp.length)),
+                                        components]];
+                    i += temp.location + temp.length - 1;
+                } else {
+                    i += temp.location;
+                }
+            } else {
+                break;
+            }
+        }
+    }
+    return matches;
+}
+
+- (void)testMatchesAgreeWithPerOffsetSearch {
+    NSArray<NSDictionary *> *rules = [SmartSelectionController defaultRules];
+    for (NSString *line in [self cases]) {
+        for (NSInteger offset = 0; offset < line.length; offset++) {
+            NSArray<NSString *> *expected = [self referenceMatchesInString:line coveringOffset:offset rules:rules];
+            NSArray<NSString *> *actual = [self matchesInString:line coveringOffset:offset rules:rules];
+            XCTAssertEqualObjects(actual, expected, @"Line “%@” at offset %@", line, @(offset));
+        }
+    }
+}
+
+// A match that doesn't cover the offset must not hide a later overlapping one that does.
+- (void)testFindsOverlappingMatchAfterOneThatMisses {
+    NSArray<NSDictionary *> *rules = @[ @{ kRegexKey: @"ab|bcd", kPrecisionKey: kNormalPrecision } ];
+    NSArray<NSString *> *actual = [self matchesInString:@"abcd" coveringOffset:3 rules:rules];
+    XCTAssertEqualObjects(actual, [self referenceMatchesInString:@"abcd" coveringOffset:3 rules:rules]);
+    XCTAssertEqual(actual.count, 1);
+}
+
+- (void)testUnmatchedCaptureGroupIsEmpty {
+    NSArray<NSDictionary *> *rules = @[ @{ kRegexKey: @"(x)?foo", kPrecisionKey: kNormalPrecision } ];
+    __block NSArray<NSString *> *components = nil;
+    [[iTermSmartSelectionRuleSet ruleSetWithRules:rules] enumerateMatchesInString:@"a foo"
+                                                                   coveringOffset:3
+                                                                   actionRequired:NO
+                                                                            block:^(NSDictionary *rule, double precision, NSRange range, NSArray<NSString *> *matchComponents) {
+                                                                                components = [[matchComponents retain] autorelease];
+                                                                            }];
+    NSArray *expected = @[ @"foo", @"" ];
+    XCTAssertEqualObjects(components, expected);
+}
+
+- (void)testInvalidRegexNeverMatches {
+    NSArray<NSDictionary *> *rules = @[ @{ kRegexKey: @"(unbalanced", kPrecisionKey: kNormalPrecision },
+                                        @{ kRegexKey: @"\\S+", kPrecisionKey: kNormalPrecision } ];
+    NSArray<NSString *> *actual = [self matchesInString:@"(unbalanced" coveringOffset:0 rules:rules];
+    XCTAssertEqual(actual.count, 1);
+    XCTAssertTrue([actual[0] hasPrefix:@"1 "]);
+}
+
+- (void)testActionRequiredSkipsRulesWithoutActions {
+    NSArray<NSDictionary *> *rules = @[ @{ kRegexKey: @"\\S+", kPrecisionKey: kNormalPrecision } ];
+    __block NSInteger count = 0;
+    [[iTermSmartSelectionRuleSet ruleSetWithRules:rules] enumerateMatchesInString:@"foo"
+                                                                   coveringOffset:0
+                                                                   actionRequired:YES
+                                                                            block:^(NSDictionary *rule, double precision, NSRange range, NSArray<NSString *> *components) {
+                                                                                count++;
+                                                                            }];
+    XCTAssertEqual(count, 0);
+}
+
+- (void)testRuleSetsAreShared {
+    NSArray<NSDictionary *> *rules = [SmartSelectionController defaultRules];
+    XCTAssertEqual([iTermSmartSelectionRuleSet ruleSetWithRules:rules],
+                   [iTermSmartSelectionRuleSet ruleSetWithRules:[[rules mutableCopy] autorelease]]);
+}
+
+#pragma mark - Performance
+
+// Every case, clicked at every offset.
+- (void)measureMatchingWithBlock:(void (^)(NSString *line, NSInteger offset, NSArray<NSDictionary *> *rules))block {
+    NSArray<NSDictionary *> *rules = [SmartSelectionController defaultRules];
+    NSArray<NSString *> *cases = [self cases];
+    [self measureBlock:^{
+        for (NSString *line in cases) {
+            for (NSInteger offset = 0; offset < line.length; offset++) {
+                @autoreleasepool {
+                    block(line, offset, rules);
+                }
+            }
+        }
+    }];
+}
+
+- (void)testSmartSelectionCasesPerformance {
+    [self measureMatchingWithBlock:^(NSString *line, NSInteger offset, NSArray<NSDictionary *> *rules) {
+        [self matchesInString:line coveringOffset:offset rules:rules];
+    }];
+}
+
+- (void)testSmartSelectionCasesPerOffsetSearchPerformance {
+    [self measureMatchingWithBlock:^(NSString *line, NSInteger offset, NSArray<NSDictionary *> *rules) {
+        [self referenceMatchesInString:line coveringOffset:offset rules:rules];
+    }];
+}
+
+@end
@@ -0,0 +1,166 @@
+//
+//  iTermSwiftyStringSchedulerTest.m
+//  iTerm2XCTests
+//
+//  Created by George Nachman on 10/18/26.
+//
+
+#import <XCTest/XCTest.h>
+#import "iTermObject.h"
+#import "iTermSwiftyString.h"
+#import "iTermSwiftyStringScheduler.h"
+#import "iTermVariableScope.h"
+
+@interface iTermSwiftyStringSchedulerTest : XCTestCase<iTermObject>
+@end
+
+@implementation iTermSwiftyStringSchedulerTest {
+    NSInteger _numberOfTitleChanges;
+}
+
+- (void)setUp {
+    [super setUp];
+    [[iTermSwiftyStringScheduler sharedInstance] evaluatePendingNodes];
+}
+
+- (iTermVariableScope *)sessionScope {
+    iTermVariables *vars = [[[iTermVariables alloc] initWithContext:iTermVariablesSuggestionContextSession owner:self] autorelease];
+    iTermVariableScope *scope = [[[iTermVariableScope alloc] init] autorelease];
+    [scope addVariables:vars toScopeNamed:nil];
+    [scope setValue:@"user" forVariableNamed:@"user"];
+    [scope setValue:@"host" forVariableNamed:@"hostname"];
+    [scope setValue:@"/" forVariableNamed:@"path"];
+    return scope;
+}
+
+// Resembles a session: autoName is evaluated from a format, and a title and a badge are evaluated
+// from autoName and path. Returns the objects to keep alive.
+- (NSArray *)addSessionWithScope:(iTermVariableScope *)scope {
+    [scope setValue:@"\\(user)@\\(hostname)" forVariableNamed:@"autoNameFormat"];
+    iTermSwiftyString *autoName = [[[iTermSwiftyString alloc] initWithScope:scope
+                                                                 sourcePath:@"autoNameFormat"
+                                                            destinationPath:@"autoName"] autorelease];
+    iTermSwiftyString *title = [[[iTermSwiftyString alloc] initWithString:@"\\(autoName): \\(path)"
+                                                                    scope:scope
+                                                                 observer:^NSString *(NSString *newValue, NSError *error) {
+                                                                     self->_numberOfTitleChanges++;
+                                                                     return newValue;
+                                                                 }] autorelease];
+    [scope setValue:@"\\(path)" forVariableNamed:@"badgeFormat"];
+    iTermSwiftyString *badge = [[[iTermSwiftyString alloc] initWithScope:scope
+                                                              sourcePath:@"badgeFormat"
+                                                         destinationPath:@"badge"] autorelease];
+
+    // The scheduler learns that the title depends on autoName the first time autoName changes.
+    [scope setValue:@"nobody" forVariableNamed:@"user"];
+    [[iTermSwiftyStringScheduler sharedInstance] evaluatePendingNodes];
+    [scope setValue:@"user" forVariableNamed:@"user"];
+    [[iTermSwiftyStringScheduler sharedInstance] evaluatePendingNodes];
+    return @[ scope, autoName, title, badge ];
+}
+
+- (void)testChangesAreCoalesced {
+    iTermVariableScope *scope = [self sessionScope];
+    __block NSInteger numberOfChanges = 0;
+    iTermSwiftyString *swiftyString =
+        [[[iTermSwiftyString alloc] initWithString:@"\\(user)@\\(hostname):\\(path)"
+                                             scope:scope
+                                          observer:^NSString *(NSString *newValue, NSError *error) {
+                                              numberOfChanges++;
+                                              return newValue;
+                                          }] autorelease];
+    XCTAssertEqualObjects(swiftyString.evaluatedString, @"user@host:/");
+    numberOfChanges = 0;
+
+    for (int i = 0; i < 3; i++) {
+        [scope setValue:[NSString stringWithFormat:@"/%d", i] forVariableNamed:@"path"];
+        [scope setValue:[NSString stringWithFormat:@"host%d", i] forVariableNamed:@"hostname"];
+        [scope setValue:[NSString stringWithFormat:@"user%d", i] forVariableNamed:@"user"];
+    }
+    XCTAssertEqual(numberOfChanges, 0);
+
+    const NSUInteger evaluationsBefore = [[iTermSwiftyStringScheduler sharedInstance] numberOfEvaluations];
+    [[iTermSwiftyStringScheduler sharedInstance] evaluatePendingNodes];
+    XCTAssertEqual(numberOfChanges, 1);
+    XCTAssertEqual([[iTermSwiftyStringScheduler sharedInstance] numberOfEvaluations], evaluationsBefore + 1);
+    XCTAssertEqualObjects(swiftyString.evaluatedString, @"user2@host2:/2");
+    XCTAssertGreaterThan([[iTermSwiftyStringScheduler sharedInstance] evaluationsPerSecond], 0);
+}
+
+- (void)testProducerIsEvaluatedBeforeConsumer {
+    iTermVariableScope *scope = [self sessionScope];
+    NSArray *session = [self addSessionWithScope:scope];
+    iTermSwiftyString *title = session[2];
+    XCTAssertEqualObjects(title.evaluatedString, @"user@host: /");
+
+    // The title is dirtied by the path before autoName is, but it must wait for autoName.
+    _numberOfTitleChanges = 0;
+    const NSUInteger batchesBefore = [[iTermSwiftyStringScheduler sharedInstance] numberOfBatches];
+    [scope setValue:@"/tmp" forVariableNamed:@"path"];
+    [scope setValue:@"root" forVariableNamed:@"user"];
+    [[iTermSwiftyStringScheduler sharedInstance] evaluatePendingNodes];
+
+    XCTAssertEqual(_numberOfTitleChanges, 1);
+    XCTAssertEqualObjects(title.evaluatedString, @"root@host: /tmp");
+    XCTAssertEqualObjects([scope valueForVariableName:@"badge"], @"/tmp");
+    XCTAssertEqual([[iTermSwiftyStringScheduler sharedInstance] numberOfBatches], batchesBefore + 1);
+}
+
+- (void)testEachStringIsEvaluatedOncePerBatch {
+    NSMutableArray *sessions = [NSMutableArray array];
+    for (int i = 0; i < 100; i++) {
+        [sessions addObject:[self addSessionWithScope:[self sessionScope]]];
+    }
+    _numberOfTitleChanges = 0;
+    const NSUInteger evaluationsBefore = [[iTermSwiftyStringScheduler sharedInstance] numberOfEvaluations];
+    for (NSArray *session in sessions) {
+        iTermVariableScope *scope = session[0];
+        [scope setValue:@"/usr" forVariableNamed:@"path"];
+        [scope setValue:@"remote" forVariableNamed:@"hostname"];
+        [scope setValue:@"admin" forVariableNamed:@"user"];
+    }
+    [[iTermSwiftyStringScheduler sharedInstance] evaluatePendingNodes];
+
+    // autoName, title, and badge for each session.
+    XCTAssertEqual([[iTermSwiftyStringScheduler sharedInstance] numberOfEvaluations], evaluationsBefore + 300);
+    XCTAssertEqual(_numberOfTitleChanges, 100);
+    for (NSArray *session in sessions) {
+        iTermSwiftyString *title = session[2];
+        XCTAssertEqualObjects(title.evaluatedString, @"admin@remote: /usr");
+    }
+}
+
+#pragma mark - Performance
+
+// Shell integration reporting a new directory, host, and user in 100 sessions at once.
+- (void)testUpdatingHundredSessionsPerformance {
+    NSMutableArray *sessions = [NSMutableArray array];
+    for (int i = 0; i < 100; i++) {
+        [sessions addObject:[self addSessionWithScope:[self sessionScope]]];
+    }
+    __block int generation = 0;
+    [self measureBlock:^{
+        for (int i = 0; i < 10; i++) {
+            generation++;
+            for (NSArray *session in sessions) {
+                iTermVariableScope *scope = session[0];
+                [scope setValue:[NSString stringWithFormat:@"/src/%d", generation] forVariableNamed:@"path"];
+                [scope setValue:[NSString stringWithFormat:@"host%d", generation] forVariableNamed:@"hostname"];
+                [scope setValue:[NSString stringWithFormat:@"user%d", generation] forVariableNamed:@"user"];
+            }
+            [[iTermSwiftyStringScheduler sharedInstance] evaluatePendingNodes];
+        }
+    }];
+}
+
+#pragma mark - iTermObject
+
+- (iTermBuiltInFunctions *)objectMethodRegistry {
+    return nil;
+}
+
+- (iTermVariableScope *)objectScope {
+    return nil;
+}
+
+@end
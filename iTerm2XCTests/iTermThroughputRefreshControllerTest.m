@@ -0,0 +1,234 @@
+//
+//  iTermThroughputRefreshControllerTest.m
+//  iTerm2XCTests
+//
+//  Created by George Nachman on 10/18/26.
+//
+
+#import <XCTest/XCTest.h>
+#import "iTermThroughputRefreshController.h"
+
+// A parser that handles 100 MB/s and a frame that takes 10 ms to draw.
+static const double iTermThroughputRefreshControllerTestParseCost = 10e-9;
+static const NSTimeInterval iTermThroughputRefreshControllerTestDrawCost = 0.01;
+// The slow frame rate that adaptive frame rate uses during high throughput.
+static const NSTimeInterval iTermThroughputRefreshControllerTestNormalPeriod = 1.0 / 30.0;
+// Same as the history duration of PTYSession's throughput estimator.
+static const NSTimeInterval iTermThroughputRefreshControllerTestThroughputWindow = 5.0 / 30.0;
+static const NSInteger iTermThroughputRefreshControllerTestChunkSize = 64 * 1024;
+static const NSInteger iTermThroughputRefreshControllerTestBigOutput = 200 * 1024 * 1024;
+
+typedef struct {
+    NSTimeInterval drainTime;
+    NSInteger frames;
+    // Longest time between frames drawn in the second after the keystroke, if there was one.
+    NSTimeInterval longestPeriodAfterKeystroke;
+} iTermThroughputRefreshSimulationResult;
+
+@interface iTermThroughputRefreshControllerTest : XCTestCase
+@end
+
+@implementation iTermThroughputRefreshControllerTest {
+    iTermThroughputRefreshController *_controller;
+}
+
+- (void)setUp {
+    [super setUp];
+    _controller = [[iTermThroughputRefreshController alloc] init];
+    [_controller didParseBytes:1000000 duration:1000000 * iTermThroughputRefreshControllerTestParseCost];
+    [_controller didDrawFrameWithDuration:iTermThroughputRefreshControllerTestDrawCost];
+}
+
+- (void)tearDown {
+    [_controller release];
+    [super tearDown];
+}
+
+// Throughput that needs `load` of the main thread to parse.
+- (NSInteger)throughputForLoad:(double)load {
+    return load / iTermThroughputRefreshControllerTestParseCost;
+}
+
+- (NSTimeInterval)periodForLoad:(double)load at:(NSTimeInterval)now {
+    return [_controller bulkPeriodForThroughput:[self throughputForLoad:load]
+                                  minimumPeriod:iTermThroughputRefreshControllerTestNormalPeriod
+                                            now:now];
+}
+
+- (void)testSustainedLoadEntersBulkOutputMode {
+    XCTAssertEqual([self periodForLoad:0.9 at:10], 0);
+    XCTAssertEqual([self periodForLoad:0.9 at:10.1], 0);
+    // Drawing gets 5% of the main thread: one 10 ms frame per 200 ms.
+    XCTAssertEqualWithAccuracy([self periodForLoad:0.9 at:10.3], 0.2, 1e-9);
+    XCTAssertTrue(_controller.bulkOutput);
+}
+
+- (void)testShortBurstsDoNotEnterBulkOutputMode {
+    XCTAssertEqual([self periodForLoad:0.9 at:10], 0);
+    XCTAssertEqual([self periodForLoad:0.1 at:10.2], 0);
+    XCTAssertEqual([self periodForLoad:0.9 at:10.3], 0);
+    XCTAssertEqual([self periodForLoad:0.9 at:10.5], 0);
+    XCTAssertFalse(_controller.bulkOutput);
+}
+
+- (void)testModerateLoadDoesNotEnterBulkOutputMode {
+    for (int i = 0; i < 20; i++) {
+        XCTAssertEqual([self periodForLoad:0.3 at:10 + i * 0.1], 0);
+    }
+}
+
+- (void)testLeavesBulkOutputModeWhenOutputSlows {
+    [self periodForLoad:0.9 at:10];
+    XCTAssertGreaterThan([self periodForLoad:0.9 at:10.3], 0);
+    // Between the thresholds it stays in bulk output mode.
+    XCTAssertGreaterThan([self periodForLoad:0.3 at:10.4], 0);
+    XCTAssertEqual([self periodForLoad:0.1 at:10.5], 0);
+    XCTAssertFalse(_controller.bulkOutput);
+}
+
+- (void)testKeystrokeSnapsBack {
+    [self periodForLoad:0.9 at:10];
+    XCTAssertGreaterThan([self periodForLoad:0.9 at:10.3], 0);
+    [_controller didHandleKeystrokeAt:10.35];
+    XCTAssertFalse(_controller.bulkOutput);
+    XCTAssertEqual([self periodForLoad:0.9 at:10.4], 0);
+    XCTAssertEqual([self periodForLoad:0.9 at:11.3], 0);
+
+    // After the grace period, sustained load enters bulk output mode again.
+    XCTAssertEqual([self periodForLoad:0.9 at:11.4], 0);
+    XCTAssertGreaterThan([self periodForLoad:0.9 at:11.7], 0);
+}
+
+- (void)testBulkPeriodIsClamped {
+    [_controller didDrawFrameWithDuration:1];
+    [self periodForLoad:0.9 at:10];
+    XCTAssertEqualWithAccuracy([self periodForLoad:0.9 at:10.3], _controller.maximumBulkPeriod, 1e-9);
+
+    iTermThroughputRefreshController *cheap = [[[iTermThroughputRefreshController alloc] init] autorelease];
+    [cheap didParseBytes:1000000 duration:1000000 * iTermThroughputRefreshControllerTestParseCost];
+    [cheap didDrawFrameWithDuration:0.0001];
+    [cheap bulkPeriodForThroughput:[self throughputForLoad:0.9] minimumPeriod:iTermThroughputRefreshControllerTestNormalPeriod now:10];
+    XCTAssertEqualWithAccuracy([cheap bulkPeriodForThroughput:[self throughputForLoad:0.9]
+                                                minimumPeriod:iTermThroughputRefreshControllerTestNormalPeriod
+                                                          now:10.3],
+                               iTermThroughputRefreshControllerTestNormalPeriod,
+                               1e-9);
+}
+
+- (void)testSmallBatchesDoNotAffectParseCost {
+    const double before = _controller.parseCostPerByte;
+    [_controller didParseBytes:10 duration:1];
+    XCTAssertEqual(_controller.parseCostPerByte, before);
+}
+
+#pragma mark - Simulation
+
+// Simulates the main thread of a session whose program writes `total` bytes as fast as it can. The
+// main thread alternates between parsing a chunk and, when a frame is due, drawing. With
+// `adaptive` the controller picks the time between frames; otherwise it's always the normal period.
+// If keystrokeTime is positive, a key is pressed then.
+- (iTermThroughputRefreshSimulationResult)simulateDrainingBytes:(NSInteger)total
+                                                       adaptive:(BOOL)adaptive
+                                                  keystrokeTime:(NSTimeInterval)keystrokeTime {
+    iTermThroughputRefreshController *controller = [[[iTermThroughputRefreshController alloc] init] autorelease];
+    iTermThroughputRefreshSimulationResult result = { 0 };
+    const NSInteger windowChunks = 4096;
+    NSTimeInterval *chunkTimes = calloc(windowChunks, sizeof(NSTimeInterval));
+    NSInteger chunksParsed = 0;
+    NSInteger oldestChunkInWindow = 0;
+
+    NSTimeInterval now = 0;
+    NSTimeInterval nextFrame = iTermThroughputRefreshControllerTestNormalPeriod;
+    NSTimeInterval lastFrame = 0;
+    BOOL keystrokeHandled = NO;
+    NSInteger remaining = total;
+    while (remaining > 0) {
+        if (keystrokeTime > 0 && !keystrokeHandled && now >= keystrokeTime) {
+            keystrokeHandled = YES;
+            [controller didHandleKeystrokeAt:now];
+            nextFrame = MIN(nextFrame, now + iTermThroughputRefreshControllerTestNormalPeriod);
+        }
+        if (now >= nextFrame) {
+            now += iTermThroughputRefreshControllerTestDrawCost;
+            [controller didDrawFrameWithDuration:iTermThroughputRefreshControllerTestDrawCost];
+            result.frames++;
+            if (keystrokeHandled && lastFrame >= keystrokeTime && now - keystrokeTime < 1) {
+                result.longestPeriodAfterKeystroke = MAX(result.longestPeriodAfterKeystroke, now - lastFrame);
+            }
+            lastFrame = now;
+
+            // Bytes parsed recently, like iTermThroughputEstimator.
+            while (oldestChunkInWindow < chunksParsed &&
+                   chunkTimes[oldestChunkInWindow % windowChunks] < now - iTermThroughputRefreshControllerTestThroughputWindow) {
+                oldestChunkInWindow++;
+            }
+            const NSInteger throughput = ((chunksParsed - oldestChunkInWindow) * iTermThroughputRefreshControllerTestChunkSize /
+                                          iTermThroughputRefreshControllerTestThroughputWindow);
+            NSTimeInterval period = iTermThroughputRefreshControllerTestNormalPeriod;
+            if (adaptive) {
+                const NSTimeInterval bulkPeriod = [controller bulkPeriodForThroughput:throughput
+                                                                        minimumPeriod:iTermThroughputRefreshControllerTestNormalPeriod
+                                                                                  now:now];
+                if (bulkPeriod > 0) {
+                    period = bulkPeriod;
+                }
+            }
+            nextFrame = now + period;
+            continue;
+        }
+        const NSInteger chunk = MIN(remaining, iTermThroughputRefreshControllerTestChunkSize);
+        const NSTimeInterval duration = chunk * iTermThroughputRefreshControllerTestParseCost;
+        now += duration;
+        [controller didParseBytes:chunk duration:duration];
+        remaining -= chunk;
+        XCTAssertLessThan(chunksParsed - oldestChunkInWindow, windowChunks);
+        chunkTimes[chunksParsed % windowChunks] = now;
+        chunksParsed++;
+    }
+    free(chunkTimes);
+    result.drainTime = now;
+    return result;
+}
+
+- (void)testBulkOutputDrainsFaster {
+    const iTermThroughputRefreshSimulationResult fixed =
+        [self simulateDrainingBytes:iTermThroughputRefreshControllerTestBigOutput adaptive:NO keystrokeTime:0];
+    const iTermThroughputRefreshSimulationResult adaptive =
+        [self simulateDrainingBytes:iTermThroughputRefreshControllerTestBigOutput adaptive:YES keystrokeTime:0];
+    NSLog(@"Time to drain 200 MB: %.2fs with %@ frames at a fixed rate, %.2fs with %@ frames adaptively",
+          fixed.drainTime, @(fixed.frames), adaptive.drainTime, @(adaptive.frames));
+
+    // Parsing alone takes about 2.1 seconds. At 30 FPS drawing takes almost a quarter of the main
+    // thread, so the fixed rate needs about 2.7 seconds. Adaptively it's about 2.3.
+    XCTAssertLessThan(adaptive.drainTime, fixed.drainTime * 0.9);
+    // It still redraws often enough to show progress.
+    XCTAssertGreaterThanOrEqual(adaptive.frames, (NSInteger)(adaptive.drainTime / 0.5));
+}
+
+- (void)testKeystrokeRestoresFrameRateDuringBulkOutput {
+    const iTermThroughputRefreshSimulationResult result =
+        [self simulateDrainingBytes:iTermThroughputRefreshControllerTestBigOutput adaptive:YES keystrokeTime:1];
+    XCTAssertGreaterThan(result.longestPeriodAfterKeystroke, 0);
+    XCTAssertLessThanOrEqual(result.longestPeriodAfterKeystroke,
+                             iTermThroughputRefreshControllerTestNormalPeriod + iTermThroughputRefreshControllerTestDrawCost + 0.001);
+}
+
+#pragma mark - Performance
+
+- (void)testTimeToDrainBulkOutputAtFixedRate {
+    [self measureBlock:^{
+        const iTermThroughputRefreshSimulationResult result =
+            [self simulateDrainingBytes:iTermThroughputRefreshControllerTestBigOutput adaptive:NO keystrokeTime:0];
+        NSLog(@"Simulated time to drain at a fixed rate: %.2fs", result.drainTime);
+    }];
+}
+
+- (void)testTimeToDrainBulkOutputAdaptively {
+    [self measureBlock:^{
+        const iTermThroughputRefreshSimulationResult result =
+            [self simulateDrainingBytes:iTermThroughputRefreshControllerTestBigOutput adaptive:YES keystrokeTime:0];
+        NSLog(@"Simulated time to drain adaptively: %.2fs", result.drainTime);
+    }];
+}
+
+@end
@@ -0,0 +1,246 @@
+//
+//  iTermURLActionCacheTest.m
+//  iTerm2XCTests
+//
+//  Created by George Nachman on 10/18/26.
+//
+
+#import <XCTest/XCTest.h>
+#import "iTermMalloc.h"
+#import "iTermSemanticHistoryController.h"
+#import "iTermTextExtractor.h"
+#import "iTermURLActionCache.h"
+#import "iTermURLActionFactory.h"
+#import "ScreenChar.h"
+#import "SmartSelectionController.h"
+#import "URLAction.h"
+
+static const int iTermURLActionCacheTestWidth = 50;
+
+@interface iTermURLActionCacheTest : XCTestCase<iTermTextDataSource>
+@end
+
+@implementation iTermURLActionCacheTest {
+    NSArray<NSString *> *_lines;
+    screen_char_t *_buffer;
+    NSString *_directory;
+    iTermSemanticHistoryController *_semanticHistoryController;
+    iTermURLActionCache *_cache;
+}
+
+- (void)setUp {
+    [super setUp];
+    _directory = [[NSTemporaryDirectory() stringByAppendingPathComponent:[[NSUUID UUID] UUIDString]] retain];
+    NSFileManager *fileManager = [NSFileManager defaultManager];
+    [fileManager createDirectoryAtPath:[_directory stringByAppendingPathComponent:@"include"]
+           withIntermediateDirectories:YES
+                            attributes:nil
+                                 error:nil];
+    [fileManager createFileAtPath:[_directory stringByAppendingPathComponent:@"main.c"] contents:[NSData data] attributes:nil];
+    [fileManager createFileAtPath:[_directory stringByAppendingPathComponent:@"include/util.h"] contents:[NSData data] attributes:nil];
+
+    _lines = [@[ @"main.c:12:5: error: use of undeclared x",
+                 @"In file included from include/util.h:3:",
+                 @"see https://example.com/docs for details",
+                 @"missing.c:1: note: nothing here exists" ] retain];
+    _semanticHistoryController = [[iTermSemanticHistoryController alloc] init];
+    _cache = [[iTermURLActionCache alloc] initWithCapacity:1024];
+}
+
+- (void)tearDown {
+    [[NSFileManager defaultManager] removeItemAtPath:_directory error:nil];
+    [_directory release];
+    [_lines release];
+    [_semanticHistoryController release];
+    [_cache release];
+    if (_buffer) {
+        free(_buffer);
+        _buffer = NULL;
+    }
+    [super tearDown];
+}
+
+#pragma mark - Helpers
+
+- (iTermURLActionCacheKey *)keyForCoord:(VT100GridCoord)coord
+                             generation:(NSInteger)generation
+                       workingDirectory:(NSString *)workingDirectory {
+    NSMutableData *generations = [NSMutableData data];
+    for (NSInteger i = 0; i < _lines.count; i++) {
+        [generations appendBytes:&generation length:sizeof(generation)];
+    }
+    return [[[iTermURLActionCacheKey alloc] initWithAbsLine:coord.y
+                                                     column:coord.x
+                                               columnWindow:VT100GridRangeMake(0, iTermURLActionCacheTestWidth)
+                                        respectHardNewlines:YES
+                                            lineGenerations:generations
+                                           workingDirectory:workingDirectory
+                                                      rules:[SmartSelectionController defaultRules]] autorelease];
+}
+
+- (void)evaluateAt:(VT100GridCoord)coord completion:(void (^)(URLAction *))completion {
+    iTermTextExtractor *extractor = [iTermTextExtractor textExtractorWithDataSource:self];
+    [extractor restrictToLogicalWindowIncludingCoord:coord];
+    [iTermURLActionFactory urlActionAtCoord:coord
+                        respectHardNewlines:YES
+                           workingDirectory:_directory
+                                 remoteHost:nil
+                                  selectors:@{}
+                                      rules:[SmartSelectionController defaultRules]
+                                  extractor:extractor
+                  semanticHistoryController:_semanticHistoryController
+                                pathFactory:^SCPPath *(NSString *path, int line) { return nil; }
+                                 completion:completion];
+}
+
+// Waits for a possibly asynchronous result.
+- (URLAction *)waitForAction:(void (^)(void (^completion)(URLAction *)))block {
+    __block URLAction *result = nil;
+    XCTestExpectation *expectation = [self expectationWithDescription:@"URL action"];
+    block(^(URLAction *action) {
+        result = [action retain];
+        [expectation fulfill];
+    });
+    [self waitForExpectationsWithTimeout:10 handler:nil];
+    return [result autorelease];
+}
+
+- (URLAction *)uncachedActionAt:(VT100GridCoord)coord {
+    return [self waitForAction:^(void (^completion)(URLAction *)) {
+        [self evaluateAt:coord completion:completion];
+    }];
+}
+
+- (URLAction *)cachedActionAt:(VT100GridCoord)coord now:(NSTimeInterval)now {
+    return [self waitForAction:^(void (^completion)(URLAction *)) {
+        [_cache actionForKey:[self keyForCoord:coord generation:1 workingDirectory:_directory]
+                         now:now
+                    evaluate:^(void (^evaluateCompletion)(URLAction *)) {
+                        [self evaluateAt:coord completion:evaluateCompletion];
+                    }
+                  completion:completion];
+    }];
+}
+
+- (NSString *)describe:(URLAction *)action {
+    if (!action) {
+        return @"nil";
+    }
+    return [NSString stringWithFormat:@"type=%@ string=%@ range=%@ fullPath=%@ line=%@ column=%@ object=%@",
+            @(action.actionType), action.string, VT100GridWindowedRangeDescription(action.range),
+            action.fullPath, action.lineNumber, action.columnNumber, action.representedObject];
+}
+
+// Runs `evaluate` through the cache with a fake evaluation and returns whether it was called.
+- (BOOL)evaluatesKey:(iTermURLActionCacheKey *)key now:(NSTimeInterval)now result:(URLAction *)result {
+    __block BOOL evaluated = NO;
+    [_cache actionForKey:key
+                     now:now
+                evaluate:^(void (^completion)(URLAction *)) {
+                    evaluated = YES;
+                    completion(result);
+                }
+              completion:^(URLAction *action) {}];
+    return evaluated;
+}
+
+#pragma mark - Tests
+
+- (void)testCachedResultsMatchUncachedEvaluation {
+    NSInteger lookups = 0;
+    NSInteger found = 0;
+    for (int pass = 0; pass < 2; pass++) {
+        for (int y = 0; y < (int)_lines.count; y++) {
+            for (int x = 0; x < (int)_lines[y].length; x++) {
+                const VT100GridCoord coord = VT100GridCoordMake(x, y);
+                NSString *expected = [self describe:[self uncachedActionAt:coord]];
+                NSString *actual = [self describe:[self cachedActionAt:coord now:100]];
+                XCTAssertEqualObjects(actual, expected, @"At %@ on pass %@", VT100GridCoordDescription(coord), @(pass));
+                if (![expected isEqualToString:@"nil"]) {
+                    found++;
+                }
+                lookups++;
+            }
+        }
+    }
+    XCTAssertGreaterThan(found, 0);
+    XCTAssertEqual(_cache.misses, lookups / 2);
+    XCTAssertEqual(_cache.hits, lookups / 2);
+}
+
+- (void)testChangedContentIsEvaluatedAgain {
+    URLAction *action = [URLAction urlActionToOpenURL:@"https://example.com/"];
+    const VT100GridCoord coord = VT100GridCoordMake(3, 1);
+    XCTAssertTrue([self evaluatesKey:[self keyForCoord:coord generation:1 workingDirectory:@"/"] now:0 result:action]);
+    XCTAssertFalse([self evaluatesKey:[self keyForCoord:coord generation:1 workingDirectory:@"/"] now:1 result:action]);
+    XCTAssertTrue([self evaluatesKey:[self keyForCoord:coord generation:2 workingDirectory:@"/"] now:1 result:action]);
+    XCTAssertTrue([self evaluatesKey:[self keyForCoord:coord generation:1 workingDirectory:@"/tmp"] now:1 result:action]);
+    XCTAssertTrue([self evaluatesKey:[self keyForCoord:VT100GridCoordMake(4, 1) generation:1 workingDirectory:@"/"] now:1 result:action]);
+}
+
+- (void)testNegativeResultsExpireSooner {
+    URLAction *action = [URLAction urlActionToOpenURL:@"https://example.com/"];
+    iTermURLActionCacheKey *positive = [self keyForCoord:VT100GridCoordMake(0, 0) generation:1 workingDirectory:@"/"];
+    iTermURLActionCacheKey *negative = [self keyForCoord:VT100GridCoordMake(1, 0) generation:1 workingDirectory:@"/"];
+    XCTAssertTrue([self evaluatesKey:positive now:0 result:action]);
+    XCTAssertTrue([self evaluatesKey:negative now:0 result:nil]);
+
+    const NSTimeInterval beforeNegativeExpiry = _cache.negativeTTL - 0.1;
+    XCTAssertFalse([self evaluatesKey:negative now:beforeNegativeExpiry result:nil]);
+
+    const NSTimeInterval afterNegativeExpiry = _cache.negativeTTL + 0.1;
+    XCTAssertTrue([self evaluatesKey:negative now:afterNegativeExpiry result:nil]);
+    XCTAssertFalse([self evaluatesKey:positive now:afterNegativeExpiry result:action]);
+
+    XCTAssertTrue([self evaluatesKey:positive now:_cache.positiveTTL + 0.1 result:action]);
+}
+
+- (void)testRemoveAllActions {
+    iTermURLActionCacheKey *key = [self keyForCoord:VT100GridCoordMake(0, 0) generation:1 workingDirectory:@"/"];
+    XCTAssertTrue([self evaluatesKey:key now:0 result:nil]);
+    [_cache removeAllActions];
+    XCTAssertTrue([self evaluatesKey:key now:0 result:nil]);
+}
+
+- (void)testPathLikeTokens {
+    NSString *text = @"main.c:12:5: error: see (include/util.h:3) and ~/notes.txt, not words. Also /usr/bin";
+    NSArray<NSString *> *expected = @[ @"main.c", @"include/util.h", @"~/notes.txt", @"/usr/bin" ];
+    XCTAssertEqualObjects([iTermURLActionCache pathLikeTokensInString:text], expected);
+}
+
+#pragma mark - iTermTextDataSource
+
+- (int)width {
+    return iTermURLActionCacheTestWidth;
+}
+
+- (int)numberOfLines {
+    return (int)_lines.count;
+}
+
+- (screen_char_t *)getLineAtIndex:(int)theIndex {
+    if (!_buffer) {
+        _buffer = iTermMalloc(sizeof(screen_char_t) * (iTermURLActionCacheTestWidth + 1));
+    }
+    memset(_buffer, 0, sizeof(screen_char_t) * (iTermURLActionCacheTestWidth + 1));
+    screen_char_t color = { 0 };
+    int len = 0;
+    StringToScreenChars(_lines[theIndex],
+                        _buffer,
+                        color,
+                        color,
+                        &len,
+                        NO,
+                        NULL,
+                        NULL,
+                        NO,
+                        9);
+    _buffer[iTermURLActionCacheTestWidth].code = EOL_HARD;
+    return _buffer;
+}
+
+- (long long)totalScrollbackOverflow {
+    return 0;
+}
+
+@end
@@ -0,0 +1,227 @@
+//
+//  iTermWebSocketFrameBuilderTest.m
+//  iTerm2XCTests
+//
+//  Created by George Nachman on 10/18/26.
+//
+
+#import <XCTest/XCTest.h>
+#import "iTermWebSocketFrame.h"
+#import "iTermWebSocketFrameBuilder.h"
+
+#include <sys/socket.h>
+
+// Encodes a frame the way a client would: always masked.
+static NSData *iTermMaskedFrame(iTermWebSocketOpcode opcode, BOOL fin, NSData *payload, uint32_t seed) {
+    NSMutableData *data = [NSMutableData data];
+    uint8_t byte = (fin ? 0x80 : 0) | opcode;
+    [data appendBytes:&byte length:1];
+    if (payload.length <= 125) {
+        byte = 0x80 | payload.length;
+        [data appendBytes:&byte length:1];
+    } else if (payload.length <= 0xffff) {
+        byte = 0x80 | 126;
+        [data appendBytes:&byte length:1];
+        uint16_t length = htons(payload.length);
+        [data appendBytes:&length length:sizeof(length)];
+    } else {
+        byte = 0x80 | 127;
+        [data appendBytes:&byte length:1];
+        uint64_t length = htonll(payload.length);
+        [data appendBytes:&length length:sizeof(length)];
+    }
+    unsigned char key[4] = { seed & 0xff, (seed >> 8) & 0xff, (seed >> 16) & 0xff, (seed >> 24) | 1 };
+    [data appendBytes:key length:sizeof(key)];
+    const unsigned char *bytes = payload.bytes;
+    for (NSUInteger i = 0; i < payload.length; i++) {
+        unsigned char c = bytes[i] ^ key[i & 3];
+        [data appendBytes:&c length:1];
+    }
+    return data;
+}
+
+static NSData *iTermPayload(NSUInteger length, unsigned char seed) {
+    NSMutableData *data = [NSMutableData dataWithLength:length];
+    unsigned char *bytes = data.mutableBytes;
+    for (NSUInteger i = 0; i < length; i++) {
+        bytes[i] = (unsigned char)(i * 31 + seed);
+    }
+    return data;
+}
+
+@interface iTermWebSocketFrameBuilderTest : XCTestCase
+@end
+
+@implementation iTermWebSocketFrameBuilderTest
+
+- (void)testUnmaskMatchesScalar {
+    const unsigned char key[4] = { 0x12, 0x34, 0x56, 0x78 };
+    for (NSUInteger length = 0; length < 100; length++) {
+        NSData *payload = iTermPayload(length, length);
+        NSMutableData *actual = [[payload mutableCopy] autorelease];
+        iTermWebSocketFrameUnmask(actual.mutableBytes, actual.length, key);
+
+        NSMutableData *expected = [[payload mutableCopy] autorelease];
+        unsigned char *bytes = expected.mutableBytes;
+        for (NSUInteger i = 0; i < length; i++) {
+            bytes[i] ^= key[i & 3];
+        }
+        XCTAssertEqualObjects(actual, expected, @"length %@", @(length));
+    }
+}
+
+- (void)testHeaderEncoding {
+    NSData *header = [iTermWebSocketFrame headerForFinalFrameWithOpcode:iTermWebSocketOpcodeBinary
+                                                          payloadLength:125];
+    const unsigned char shortHeader[] = { 0x82, 125 };
+    XCTAssertEqualObjects(header, [NSData dataWithBytes:shortHeader length:sizeof(shortHeader)]);
+
+    header = [iTermWebSocketFrame headerForFinalFrameWithOpcode:iTermWebSocketOpcodeText
+                                                  payloadLength:0x1234];
+    const unsigned char mediumHeader[] = { 0x81, 126, 0x12, 0x34 };
+    XCTAssertEqualObjects(header, [NSData dataWithBytes:mediumHeader length:sizeof(mediumHeader)]);
+
+    header = [iTermWebSocketFrame headerForFinalFrameWithOpcode:iTermWebSocketOpcodeBinary
+                                                  payloadLength:0x10000];
+    const unsigned char longHeader[] = { 0x82, 127, 0, 0, 0, 0, 0, 1, 0, 0 };
+    XCTAssertEqualObjects(header, [NSData dataWithBytes:longHeader length:sizeof(longHeader)]);
+}
+
+- (void)testFramesSplitAcrossReads {
+    NSArray<NSNumber *> *lengths = @[ @0, @1, @125, @126, @1000, @0xffff, @0x10000, @200000 ];
+    NSMutableData *stream = [NSMutableData data];
+    NSMutableArray<NSData *> *expected = [NSMutableArray array];
+    for (NSNumber *length in lengths) {
+        NSData *payload = iTermPayload(length.unsignedIntegerValue, expected.count);
+        [expected addObject:payload];
+        [stream appendData:iTermMaskedFrame(iTermWebSocketOpcodeBinary, YES, payload, (uint32_t)expected.count * 7919)];
+    }
+
+    // Try a variety of read sizes so that headers, masks, and payloads all get split.
+    for (NSNumber *chunkSize in @[ @1, @3, @7, @4096, @16384, @(stream.length) ]) {
+        iTermWebSocketFrameBuilder *builder = [[[iTermWebSocketFrameBuilder alloc] init] autorelease];
+        NSMutableArray<NSData *> *actual = [NSMutableArray array];
+        for (NSUInteger offset = 0; offset < stream.length; offset += chunkSize.unsignedIntegerValue) {
+            const NSUInteger length = MIN(chunkSize.unsignedIntegerValue, stream.length - offset);
+            NSMutableData *chunk = [NSMutableData dataWithBytes:(const unsigned char *)stream.bytes + offset
+                                                         length:length];
+            [builder addData:chunk frame:^(iTermWebSocketFrame *frame, BOOL *stop) {
+                XCTAssertNotNil(frame);
+                XCTAssertEqual(frame.opcode, iTermWebSocketOpcodeBinary);
+                [actual addObject:frame.payload];
+            }];
+        }
+        XCTAssertEqualObjects(actual, expected, @"chunk size %@", chunkSize);
+    }
+}
+
+- (void)testFragmentsAreJoined {
+    NSMutableData *stream = [NSMutableData data];
+    [stream appendData:iTermMaskedFrame(iTermWebSocketOpcodeText, NO, [@"Hello, " dataUsingEncoding:NSUTF8StringEncoding], 1)];
+    [stream appendData:iTermMaskedFrame(iTermWebSocketOpcodeContinuation, YES, [@"world" dataUsingEncoding:NSUTF8StringEncoding], 2)];
+
+    iTermWebSocketFrameBuilder *builder = [[[iTermWebSocketFrameBuilder alloc] init] autorelease];
+    __block NSString *text = nil;
+    [builder addData:stream frame:^(iTermWebSocketFrame *frame, BOOL *stop) {
+        text = [frame.text retain];
+    }];
+    XCTAssertEqualObjects(text, @"Hello, world");
+    [text release];
+}
+
+- (void)testFragmentCannotBeAppendedToFinishedFrame {
+    NSMutableData *buffer = [[iTermMaskedFrame(iTermWebSocketOpcodeText, YES, [@"Hello" dataUsingEncoding:NSUTF8StringEncoding], 1) mutableCopy] autorelease];
+    NSMutableData *continuationBuffer = [[iTermMaskedFrame(iTermWebSocketOpcodeContinuation, YES, [@"world" dataUsingEncoding:NSUTF8StringEncoding], 2) mutableCopy] autorelease];
+    NSUInteger consumed = 0;
+    iTermWebSocketFrame *frame = [iTermWebSocketFrame frameByParsingBuffer:buffer offset:0 consumed:&consumed];
+    iTermWebSocketFrame *continuation = [iTermWebSocketFrame frameByParsingBuffer:continuationBuffer offset:0 consumed:&consumed];
+    XCTAssertTrue(frame.fin);
+    XCTAssertFalse([frame appendFragment:continuation]);
+    XCTAssertEqualObjects(frame.text, @"Hello");
+}
+
+// Payloads refer to the buffer they were read into, so they must stay valid after the builder
+// moves on to later reads.
+- (void)testPayloadOutlivesLaterReads {
+    iTermWebSocketFrameBuilder *builder = [[[iTermWebSocketFrameBuilder alloc] init] autorelease];
+    NSData *first = iTermPayload(100, 1);
+    NSData *second = iTermPayload(100, 2);
+    NSData *firstFrame = iTermMaskedFrame(iTermWebSocketOpcodeBinary, YES, first, 3);
+    NSData *secondFrame = iTermMaskedFrame(iTermWebSocketOpcodeBinary, YES, second, 4);
+
+    NSMutableData *chunk = [[firstFrame mutableCopy] autorelease];
+    [chunk appendData:[secondFrame subdataWithRange:NSMakeRange(0, 10)]];
+    __block NSData *payload = nil;
+    [builder addData:chunk frame:^(iTermWebSocketFrame *frame, BOOL *stop) {
+        payload = [frame.payload retain];
+    }];
+    NSMutableData *rest = [[[secondFrame subdataWithRange:NSMakeRange(10, secondFrame.length - 10)] mutableCopy] autorelease];
+    __block NSData *secondPayload = nil;
+    [builder addData:rest frame:^(iTermWebSocketFrame *frame, BOOL *stop) {
+        secondPayload = [frame.payload retain];
+    }];
+    XCTAssertEqualObjects(payload, first);
+    XCTAssertEqualObjects(secondPayload, second);
+    [payload release];
+    [secondPayload release];
+}
+
+#pragma mark - Performance
+
+// Streams masked frames through a unix socket pair and parses them the way
+// iTermWebSocketConnection does.
+- (void)testThroughputOverUnixSocket {
+    const NSInteger numberOfFrames = 100000;
+    const NSUInteger payloadLength = 256;
+    NSMutableData *stream = [NSMutableData data];
+    for (NSInteger i = 0; i < numberOfFrames; i++) {
+        [stream appendData:iTermMaskedFrame(iTermWebSocketOpcodeBinary, YES, iTermPayload(payloadLength, i), (uint32_t)i)];
+    }
+
+    [self measureBlock:^{
+        int fds[2];
+        XCTAssertEqual(socketpair(AF_UNIX, SOCK_STREAM, 0, fds), 0);
+        dispatch_group_t group = dispatch_group_create();
+        dispatch_group_async(group, dispatch_get_global_queue(QOS_CLASS_USER_INITIATED, 0), ^{
+            const unsigned char *bytes = stream.bytes;
+            NSUInteger written = 0;
+            while (written < stream.length) {
+                const ssize_t rc = write(fds[0], bytes + written, stream.length - written);
+                if (rc <= 0) {
+                    break;
+                }
+                written += rc;
+            }
+            close(fds[0]);
+        });
+
+        iTermWebSocketFrameBuilder *builder = [[iTermWebSocketFrameBuilder alloc] init];
+        __block NSInteger frames = 0;
+        __block NSUInteger bytes = 0;
+        const NSTimeInterval start = [NSDate timeIntervalSinceReferenceDate];
+        while (YES) {
+            @autoreleasepool {
+                NSMutableData *chunk = [NSMutableData dataWithLength:16384];
+                const ssize_t rc = read(fds[1], chunk.mutableBytes, chunk.length);
+                if (rc <= 0) {
+                    break;
+                }
+                chunk.length = rc;
+                [builder addData:chunk frame:^(iTermWebSocketFrame *frame, BOOL *stop) {
+                    frames++;
+                    bytes += frame.payload.length;
+                }];
+            }
+        }
+        const NSTimeInterval elapsed = [NSDate timeIntervalSinceReferenceDate] - start;
+        dispatch_group_wait(group, DISPATCH_TIME_FOREVER);
+        dispatch_release(group);
+        close(fds[1]);
+        [builder release];
+
+        XCTAssertEqual(frames, numberOfFrames);
+        NSLog(@"%.0f frames/sec, %.1f MB/sec", frames / elapsed, bytes / elapsed / 1048576.0);
+    }];
+}
+
+@end
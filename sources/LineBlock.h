@@ -43,6 +43,8 @@ typedef struct {
 @property(nonatomic, readonly) int numberOfCharacters;
 @property(nonatomic, readonly) NSInteger generation;
 
+// Accepts either the format produced by -dictionary or the one produced by
+// -packedDictionaryCompressed:.
 + (instancetype)blockWithDictionary:(NSDictionary *)dictionary;
 
 - (instancetype)initWithRawBufferSize:(int)size;
@@ -210,6 +212,12 @@ int OffsetOfWrappedLine(screen_char_t* p, int n, int length, int width, BOOL may
 // invalid if the block is changed.
 - (NSDictionary *)dictionary;
 
+// Like -dictionary but much cheaper to produce and parse for large blocks: line lengths and
+// metadata are packed arrays instead of arrays of NSNumbers. If compress is set the raw buffer
+// is deflated.
+- (NSDictionary *)packedDictionaryCompressed:(BOOL)compress;
+- (NSData *)packedDataCompressed:(BOOL)compress;
+
 // Number of empty lines at the end of the block.
 - (int)numberOfTrailingEmptyLines;
 
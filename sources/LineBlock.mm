@@ -14,9 +14,12 @@ extern "C" {
 #import "iTermMalloc.h"
 #import "LineBufferHelpers.h"
 #import "NSBundle+iTerm.h"
+#import "NSObject+iTerm.h"
 #import "RegexKitLite.h"
 #import "iTermAdvancedSettingsModel.h"
+#import "zlib.h"
 }
+#include <atomic>
 #include <unordered_map>
 #include <vector>
 
@@ -33,8 +36,50 @@ NSString *const kLineBlockIsPartialKey = @"Is Partial";
 NSString *const kLineBlockMetadataKey = @"Metadata";
 NSString *const kLineBlockMayHaveDWCKey = @"May Have Double Width Character";
 NSString *const kLineBlockGuid = @"GUID";
+NSString *const kLineBlockPackedDataKey = @"Packed Data";
+
+// The packed format is laid out as:
+//   iTermPackedLineBlockHeader
+//   int32_t cumulative_line_lengths[cllEntries]
+//   iTermPackedLineBlockMetadata metadata[cllEntries]
+//   The raw buffer: rawLength bytes of screen_char_t, or storedRawLength bytes of zlib data if
+//   iTermPackedLineBlockFlagCompressed is set.
+// All integers are little-endian. screen_char_t is stored in host order, as in the dictionary
+// format.
+static const uint32_t iTermPackedLineBlockMagic = 0x4b424c69;  // "iLBK"
+static const uint16_t iTermPackedLineBlockVersion = 1;
+
+typedef NS_OPTIONS(uint16_t, iTermPackedLineBlockFlags) {
+    iTermPackedLineBlockFlagIsPartial = 1 << 0,
+    iTermPackedLineBlockFlagMayHaveDWC = 1 << 1,
+    iTermPackedLineBlockFlagCompressed = 1 << 2
+};
 
-static NSInteger LineBlockNextGeneration = -1;
+typedef struct __attribute__((packed)) {
+    uint32_t magic;
+    uint16_t version;
+    uint16_t flags;
+    int32_t bufferSize;
+    int32_t bufferStartOffset;
+    int32_t startOffset;
+    int32_t firstEntry;
+    int32_t cllEntries;
+    uint32_t rawLength;
+    uint32_t storedRawLength;
+} iTermPackedLineBlockHeader;
+
+typedef struct __attribute__((packed)) {
+    uint64_t timestamp;  // Bit pattern of the NSTimeInterval.
+    uint16_t code;
+    uint8_t backgroundColor;
+    uint8_t bgGreen;
+    uint8_t bgBlue;
+    uint8_t backgroundColorMode;
+    uint8_t unused[2];
+} iTermPackedLineBlockMetadata;
+
+// Blocks may be decoded on several threads at once during state restoration.
+static std::atomic<NSInteger> LineBlockNextGeneration(-1);
 
 void EnableDoubleWidthCharacterLineCache() {
     gEnableDoubleWidthCharacterLineCache = YES;
@@ -76,6 +121,9 @@ struct iTermNumFullLinesCacheKeyHasher {
 @implementation LineBlock {
     // The raw lines, end-to-end. There is no delimiter between each line.
     screen_char_t* raw_buffer;
+    // Copies share raw_buffer until one of them needs to modify it. When non-null, this is the
+    // number of blocks sharing raw_buffer and is itself shared by them.
+    std::atomic<int> *raw_buffer_users;
     screen_char_t* buffer_start;  // usable start of buffer (stuff before this is dropped)
 
     int start_offset;  // distance from raw_buffer to buffer_start
@@ -166,6 +214,10 @@ NS_INLINE void iTermLineBlockDidChange(__unsafe_unretained LineBlock *lineBlock)
 }
 
 - (instancetype)initWithDictionary:(NSDictionary *)dictionary {
+    NSData *packedData = [NSData castFrom:dictionary[kLineBlockPackedDataKey]];
+    if (packedData) {
+        return [self initWithPackedData:packedData guid:[NSString castFrom:dictionary[kLineBlockGuid]]];
+    }
     self = [super init];
     if (self) {
         NSArray *requiredKeys = @[ kLineBlockRawBufferKey,
@@ -226,11 +278,122 @@ NS_INLINE void iTermLineBlockDidChange(__unsafe_unretained LineBlock *lineBlock)
     return self;
 }
 
+- (instancetype)initWithPackedData:(NSData *)data guid:(NSString *)guid {
+    self = [super init];
+    if (self) {
+        iTermPackedLineBlockHeader header;
+        if (data.length < sizeof(header)) {
+            [self autorelease];
+            return nil;
+        }
+        const unsigned char *bytes = (const unsigned char *)data.bytes;
+        memcpy(&header, bytes, sizeof(header));
+        const int cllEntries = (int)OSSwapLittleToHostInt32(header.cllEntries);
+        const size_t rawLength = OSSwapLittleToHostInt32(header.rawLength);
+        const size_t storedRawLength = OSSwapLittleToHostInt32(header.storedRawLength);
+        buffer_size = (int)OSSwapLittleToHostInt32(header.bufferSize);
+        const int bufferStartOffset = (int)OSSwapLittleToHostInt32(header.bufferStartOffset);
+        const int startOffset = (int)OSSwapLittleToHostInt32(header.startOffset);
+        const int firstEntry = (int)OSSwapLittleToHostInt32(header.firstEntry);
+        const size_t rawCharacters = rawLength / sizeof(screen_char_t);
+        const iTermPackedLineBlockFlags flags = OSSwapLittleToHostInt16(header.flags);
+        const BOOL compressed = !!(flags & iTermPackedLineBlockFlagCompressed);
+        if (OSSwapLittleToHostInt32(header.magic) != iTermPackedLineBlockMagic ||
+            OSSwapLittleToHostInt16(header.version) != iTermPackedLineBlockVersion ||
+            cllEntries < 0 ||
+            buffer_size < 0 ||
+            rawLength % sizeof(screen_char_t) != 0 ||
+            rawLength > (size_t)buffer_size * sizeof(screen_char_t) ||
+            bufferStartOffset < 0 ||
+            bufferStartOffset > buffer_size ||
+            startOffset < 0 ||
+            (size_t)startOffset > rawCharacters ||
+            firstEntry < 0 ||
+            firstEntry > cllEntries ||
+            (!compressed && storedRawLength != rawLength)) {
+            DLog(@"Bad packed line block header");
+            [self autorelease];
+            return nil;
+        }
+        const unsigned char *cllBytes = bytes + sizeof(header);
+        const unsigned char *metadataBytes = cllBytes + cllEntries * sizeof(int32_t);
+        const unsigned char *rawBytes = metadataBytes + cllEntries * sizeof(iTermPackedLineBlockMetadata);
+        if (data.length != (rawBytes - bytes) + storedRawLength) {
+            DLog(@"Packed line block has length %@ but header implies %@",
+                 @(data.length), @((rawBytes - bytes) + storedRawLength));
+            [self autorelease];
+            return nil;
+        }
+
+        // The raw buffer is inflated or copied directly into its final home.
+        raw_buffer = (screen_char_t *)iTermMalloc(buffer_size * sizeof(screen_char_t));
+        if (compressed) {
+            uLongf inflatedLength = rawLength;
+            if (uncompress((Bytef *)raw_buffer, &inflatedLength, rawBytes, storedRawLength) != Z_OK ||
+                inflatedLength != rawLength) {
+                DLog(@"Failed to inflate packed line block");
+                [self autorelease];
+                return nil;
+            }
+        } else {
+            memmove(raw_buffer, rawBytes, rawLength);
+        }
+        buffer_start = raw_buffer + bufferStartOffset;
+        start_offset = startOffset;
+        first_entry = firstEntry;
+        if (guid) {
+            _guid = [guid copy];
+            DLog(@"Restore block %p with guid %@", self, _guid);
+        }
+        cll_capacity = cllEntries;
+        cumulative_line_lengths = (int *)iTermMalloc(sizeof(int) * cll_capacity);
+#if __LITTLE_ENDIAN__
+        memcpy(cumulative_line_lengths, cllBytes, cllEntries * sizeof(int32_t));
+#else
+        for (int i = 0; i < cllEntries; i++) {
+            int32_t value;
+            memcpy(&value, cllBytes + i * sizeof(value), sizeof(value));
+            cumulative_line_lengths[i] = (int)OSSwapLittleToHostInt32(value);
+        }
+#endif
+        // Line lengths index into the raw buffer, so they must not run backwards or past the end.
+        int previous = 0;
+        for (int i = 0; i < cllEntries; i++) {
+            if (cumulative_line_lengths[i] < previous ||
+                (size_t)cumulative_line_lengths[i] > rawCharacters) {
+                DLog(@"Packed line block has bad cumulative line length %@ at %@",
+                     @(cumulative_line_lengths[i]), @(i));
+                [self autorelease];
+                return nil;
+            }
+            previous = cumulative_line_lengths[i];
+        }
+        [self commonInit];
+
+        for (int i = 0; i < cll_capacity; i++) {
+            iTermPackedLineBlockMetadata packed;
+            memcpy(&packed, metadataBytes + i * sizeof(packed), sizeof(packed));
+            const uint64_t timestampBits = OSSwapLittleToHostInt64(packed.timestamp);
+            memcpy(&metadata_[i].timestamp, &timestampBits, sizeof(metadata_[i].timestamp));
+            metadata_[i].continuation.code = OSSwapLittleToHostInt16(packed.code);
+            metadata_[i].continuation.backgroundColor = packed.backgroundColor;
+            metadata_[i].continuation.bgGreen = packed.bgGreen;
+            metadata_[i].continuation.bgBlue = packed.bgBlue;
+            metadata_[i].continuation.backgroundColorMode = packed.backgroundColorMode;
+            metadata_[i].number_of_wrapped_lines = 0;
+            metadata_[i].generation = LineBlockNextGeneration--;
+        }
+
+        cll_entries = cll_capacity;
+        is_partial = !!(flags & iTermPackedLineBlockFlagIsPartial);
+        _mayHaveDoubleWidthCharacter = !!(flags & iTermPackedLineBlockFlagMayHaveDWC);
+    }
+    return self;
+}
+
 - (void)dealloc
 {
-    if (raw_buffer) {
-        free(raw_buffer);
-    }
+    [self releaseRawBuffer];
     if (cumulative_line_lengths) {
         free(cumulative_line_lengths);
     }
@@ -246,10 +409,16 @@ NS_INLINE void iTermLineBlockDidChange(__unsafe_unretained LineBlock *lineBlock)
     [super dealloc];
 }
 
+// The characters are shared with the copy until either one appends or resizes. The other tables
+// are small and updated by reads, so they're copied.
 - (LineBlock *)copyWithZone:(NSZone *)zone {
     LineBlock *theCopy = [[LineBlock alloc] init];
-    theCopy->raw_buffer = (screen_char_t*)iTermMalloc(sizeof(screen_char_t) * buffer_size);
-    memmove(theCopy->raw_buffer, raw_buffer, sizeof(screen_char_t) * buffer_size);
+    if (!raw_buffer_users) {
+        raw_buffer_users = new std::atomic<int>(1);
+    }
+    raw_buffer_users->fetch_add(1);
+    theCopy->raw_buffer = raw_buffer;
+    theCopy->raw_buffer_users = raw_buffer_users;
     size_t bufferStartOffset = (buffer_start - raw_buffer);
     theCopy->buffer_start = theCopy->raw_buffer + bufferStartOffset;
     theCopy->start_offset = start_offset;
@@ -277,6 +446,40 @@ NS_INLINE void iTermLineBlockDidChange(__unsafe_unretained LineBlock *lineBlock)
     return theCopy;
 }
 
+// Drops this block's reference to raw_buffer, freeing it if no copy still shares it.
+- (void)releaseRawBuffer {
+    if (raw_buffer_users) {
+        const int previousUsers = raw_buffer_users->fetch_sub(1);
+        std::atomic<int> *users = raw_buffer_users;
+        raw_buffer_users = NULL;
+        if (previousUsers > 1) {
+            raw_buffer = NULL;
+            return;
+        }
+        delete users;
+    }
+    free(raw_buffer);
+    raw_buffer = NULL;
+}
+
+// Call before modifying raw_buffer. Gives this block its own copy if it's shared.
+- (void)makeRawBufferUnique {
+    if (!raw_buffer_users) {
+        return;
+    }
+    if (raw_buffer_users->load() == 1) {
+        // Every copy that shared it is gone. Nothing can add a user but this block.
+        delete raw_buffer_users;
+        raw_buffer_users = NULL;
+        return;
+    }
+    screen_char_t *copy = (screen_char_t *)iTermMalloc(sizeof(screen_char_t) * buffer_size);
+    memmove(copy, raw_buffer, sizeof(screen_char_t) * [self rawSpaceUsed]);
+    [self releaseRawBuffer];
+    raw_buffer = copy;
+    buffer_start = raw_buffer + start_offset;
+}
+
 - (int)rawSpaceUsed {
     if (cll_entries == 0) {
         return 0;
@@ -448,6 +651,7 @@ extern "C" int iTermLineBlockNumberOfFullLinesImpl(screen_char_t *buffer,
     if (cll_entries >= iTermLineBlockMaxLines) {
         return NO;
     }
+    [self makeRawBufferUnique];
     memcpy(raw_buffer + space_used, buffer, sizeof(screen_char_t) * length);
     // There's an edge case here. In the else clause, the line buffer looks like this originally:
     //   |xxxx| EOL_SOFT
@@ -971,6 +1175,7 @@ int OffsetOfWrappedLine(screen_char_t* p, int n, int length, int width, BOOL may
 - (void)changeBufferSize:(int)capacity {
     ITAssertWithMessage(capacity >= [self rawSpaceUsed], @"Truncating used space");
     capacity = MAX(1, capacity);
+    [self makeRawBufferUnique];
     raw_buffer = (screen_char_t*) iTermRealloc((void*) raw_buffer, sizeof(screen_char_t), capacity);
     buffer_start = raw_buffer + start_offset;
     buffer_size = capacity;
@@ -1609,6 +1814,83 @@ static int Search(NSString* needle,
               kLineBlockGuid: _guid };
 }
 
+- (NSData *)packedDataCompressed:(BOOL)compress {
+    const size_t rawLength = [self rawSpaceUsed] * sizeof(screen_char_t);
+    const size_t prefixLength = (sizeof(iTermPackedLineBlockHeader) +
+                                 cll_entries * (sizeof(int32_t) + sizeof(iTermPackedLineBlockMetadata)));
+    const uLong storedRawCapacity = compress ? MAX(compressBound(rawLength), rawLength) : rawLength;
+    NSMutableData *data = [NSMutableData dataWithLength:prefixLength + storedRawCapacity];
+    unsigned char *bytes = (unsigned char *)data.mutableBytes;
+
+    unsigned char *cllBytes = bytes + sizeof(iTermPackedLineBlockHeader);
+#if __LITTLE_ENDIAN__
+    memcpy(cllBytes, cumulative_line_lengths, cll_entries * sizeof(int32_t));
+#else
+    for (int i = 0; i < cll_entries; i++) {
+        const int32_t value = OSSwapHostToLittleInt32(cumulative_line_lengths[i]);
+        memcpy(cllBytes + i * sizeof(value), &value, sizeof(value));
+    }
+#endif
+
+    unsigned char *metadataBytes = cllBytes + cll_entries * sizeof(int32_t);
+    for (int i = 0; i < cll_entries; i++) {
+        iTermPackedLineBlockMetadata packed = { 0 };
+        uint64_t timestampBits;
+        memcpy(&timestampBits, &metadata_[i].timestamp, sizeof(timestampBits));
+        packed.timestamp = OSSwapHostToLittleInt64(timestampBits);
+        packed.code = OSSwapHostToLittleInt16(metadata_[i].continuation.code);
+        packed.backgroundColor = metadata_[i].continuation.backgroundColor;
+        packed.bgGreen = metadata_[i].continuation.bgGreen;
+        packed.bgBlue = metadata_[i].continuation.bgBlue;
+        packed.backgroundColorMode = metadata_[i].continuation.backgroundColorMode;
+        memcpy(metadataBytes + i * sizeof(packed), &packed, sizeof(packed));
+    }
+
+    // Fall back to storing the buffer as-is if deflating fails or doesn't help.
+    unsigned char *rawBytes = bytes + prefixLength;
+    uLongf storedRawLength = storedRawCapacity;
+    BOOL compressed = NO;
+    if (compress && rawLength > 0) {
+        compressed = (compress2(rawBytes, &storedRawLength, (const Bytef *)raw_buffer, rawLength, Z_BEST_SPEED) == Z_OK &&
+                      storedRawLength < rawLength);
+    }
+    if (!compressed) {
+        storedRawLength = rawLength;
+        memmove(rawBytes, raw_buffer, rawLength);
+    }
+    data.length = prefixLength + storedRawLength;
+
+    iTermPackedLineBlockFlags flags = 0;
+    if (is_partial) {
+        flags |= iTermPackedLineBlockFlagIsPartial;
+    }
+    if (_mayHaveDoubleWidthCharacter) {
+        flags |= iTermPackedLineBlockFlagMayHaveDWC;
+    }
+    if (compressed) {
+        flags |= iTermPackedLineBlockFlagCompressed;
+    }
+    const iTermPackedLineBlockHeader header = {
+        .magic = OSSwapHostToLittleInt32(iTermPackedLineBlockMagic),
+        .version = OSSwapHostToLittleInt16(iTermPackedLineBlockVersion),
+        .flags = OSSwapHostToLittleInt16(flags),
+        .bufferSize = (int32_t)OSSwapHostToLittleInt32(buffer_size),
+        .bufferStartOffset = (int32_t)OSSwapHostToLittleInt32((int32_t)(buffer_start - raw_buffer)),
+        .startOffset = (int32_t)OSSwapHostToLittleInt32(start_offset),
+        .firstEntry = (int32_t)OSSwapHostToLittleInt32(first_entry),
+        .cllEntries = (int32_t)OSSwapHostToLittleInt32(cll_entries),
+        .rawLength = OSSwapHostToLittleInt32((uint32_t)rawLength),
+        .storedRawLength = OSSwapHostToLittleInt32((uint32_t)storedRawLength)
+    };
+    memcpy(bytes, &header, sizeof(header));
+    return data;
+}
+
+- (NSDictionary *)packedDictionaryCompressed:(BOOL)compress {
+    return @{ kLineBlockPackedDataKey: [self packedDataCompressed:compress],
+              kLineBlockGuid: _guid };
+}
+
 - (int)numberOfCharacters {
     return self.rawSpaceUsed - start_offset;
 }
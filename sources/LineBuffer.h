@@ -66,6 +66,16 @@
 // all earlier blocks.
 - (LineBuffer *)newAppendOnlyCopy;
 
+// Returns a buffer holding copies of the blocks that contain the wrapped lines in |range|, so it
+// may be read from another thread while this buffer continues to be modified. Reading a block
+// updates its caches, so no block may be shared with this buffer. The copies share characters with
+// the originals until one of them is appended to, so this is cheap even for a huge range. Line 0 of the copy is
+// line *linesBeforePtr of this buffer. If |range| is empty or past the end the copy is empty and
+// *linesBeforePtr is the number of lines in this buffer.
+- (LineBuffer *)newSnapshotForConcurrentReadingOfLinesInRange:(NSRange)range
+                                                        width:(int)width
+                                                  linesBefore:(out int *)linesBeforePtr;
+
 // Call this immediately after init. Otherwise the buffer will hold unlimited lines (until you
 // run out of memory).
 - (void)setMaxLines:(int)maxLines;
@@ -117,6 +127,12 @@
                                                 width:(int)width
                                                 count:(int)count;
 
+// Like wrappedLinesFromIndex:width:count: but doesn't allocate an object per line. |chars| is
+// only valid for the duration of the call.
+- (void)enumerateLinesInRange:(NSRange)range
+                        width:(int)width
+                        block:(void (^)(screen_char_t *chars, int length, int eol, screen_char_t continuation, BOOL *stop))block;
+
 // Copy up to width chars from the last line into *ptr. The last line will be removed or
 // truncated from the buffer. Sets *includesEndOfLine to true if this line should have a
 // continuation marker.
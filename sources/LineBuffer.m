@@ -138,22 +138,47 @@ static const NSInteger kUnicodeVersion = 9;
         max_lines = [dictionary[kLineBufferMaxLinesKey] intValue];
         num_dropped_blocks = [dictionary[kLineBufferNumDroppedBlocksKey] intValue];
         droppedChars = [dictionary[kLineBufferDroppedCharsKey] longLongValue];
-        for (NSDictionary *maybeWrapper in dictionary[kLineBufferBlocksKey]) {
-            NSDictionary *blockDictionary = maybeWrapper;
-            if (maybeWrapper[kLineBufferBlockWrapperKey]) {
-                blockDictionary = maybeWrapper[kLineBufferBlockWrapperKey];
-            }
-            LineBlock *block = [LineBlock blockWithDictionary:blockDictionary];
-            if (!block) {
-                [self autorelease];
-                return nil;
-            }
-            [_lineBlocks addBlock:block];
+        if (![self decodeBlocks:dictionary[kLineBufferBlocksKey]]) {
+            [self autorelease];
+            return nil;
         }
     }
     return self;
 }
 
+// Blocks are independent of one another, so with lots of scrollback they are decoded in parallel.
+- (BOOL)decodeBlocks:(NSArray<NSDictionary *> *)wrappers {
+    NSArray<NSDictionary *> *blockDictionaries = [wrappers mapWithBlock:^id(NSDictionary *maybeWrapper) {
+        return maybeWrapper[kLineBufferBlockWrapperKey] ?: maybeWrapper;
+    }];
+    const NSInteger count = blockDictionaries.count;
+    LineBlock **blocks = iTermCalloc(MAX(1, count), sizeof(LineBlock *));
+    void (^decode)(size_t) = ^(size_t i) {
+        @autoreleasepool {
+            blocks[i] = [[LineBlock blockWithDictionary:blockDictionaries[i]] retain];
+        }
+    };
+    if (count > 1 && [iTermAdvancedSettingsModel decodeRestorableStateConcurrently]) {
+        dispatch_apply(count, dispatch_get_global_queue(QOS_CLASS_USER_INITIATED, 0), decode);
+    } else {
+        for (NSInteger i = 0; i < count; i++) {
+            decode(i);
+        }
+    }
+
+    BOOL ok = YES;
+    for (NSInteger i = 0; i < count; i++) {
+        if (!blocks[i]) {
+            ok = NO;
+        } else if (ok) {
+            [_lineBlocks addBlock:blocks[i]];
+        }
+        [blocks[i] release];
+    }
+    free(blocks);
+    return ok;
+}
+
 - (void)dealloc {
     [_lineBlocks release];
     [super dealloc];
@@ -546,6 +571,15 @@ static int RawNumLines(LineBuffer* buffer, int width) {
     return arrays;
 }
 
+- (void)enumerateLinesInRange:(NSRange)range
+                        width:(int)width
+                        block:(void (^)(screen_char_t *, int, int, screen_char_t, BOOL *))block {
+    if (range.length == 0) {
+        return;
+    }
+    [_lineBlocks enumerateLinesInRange:range width:width block:block];
+}
+
 - (int)numLinesWithWidth:(int)width {
     if (width == 0) {
         return 0;
@@ -1108,6 +1142,36 @@ NS_INLINE int TotalNumberOfRawLines(LineBuffer *self) {
     return theCopy;
 }
 
+- (LineBuffer *)newSnapshotForConcurrentReadingOfLinesInRange:(NSRange)range
+                                                        width:(int)width
+                                                  linesBefore:(out int *)linesBeforePtr {
+    LineBuffer *theCopy = [[LineBuffer alloc] initWithBlockSize:block_size];
+    const int numLines = [self numLinesWithWidth:width];
+    if (range.length == 0 || range.location >= numLines) {
+        *linesBeforePtr = numLines;
+        return theCopy;
+    }
+    int firstRemainder = 0;
+    const NSInteger first = [_lineBlocks indexOfBlockContainingLineNumber:(int)range.location
+                                                                   width:width
+                                                               remainder:&firstRemainder];
+    int lastRemainder = 0;
+    const NSInteger last = [_lineBlocks indexOfBlockContainingLineNumber:(int)MIN(NSMaxRange(range), numLines) - 1
+                                                                  width:width
+                                                              remainder:&lastRemainder];
+    assert(first != NSNotFound && last != NSNotFound);
+    for (NSInteger i = first; i <= last; i++) {
+        LineBlock *block = [_lineBlocks[i] copy];
+        [theCopy->_lineBlocks addBlock:block];
+        [block release];
+    }
+    theCopy.mayHaveDoubleWidthCharacter = _mayHaveDoubleWidthCharacter;
+    DLog(@"Snapshot of lines %@ copied blocks [%@, %@] of %@",
+         NSStringFromRange(range), @(first), @(last), @(_lineBlocks.count));
+    *linesBeforePtr = (int)range.location - firstRemainder;
+    return theCopy;
+}
+
 - (int)numberOfDroppedBlocks {
     return num_dropped_blocks;
 }
@@ -1121,6 +1185,7 @@ NS_INLINE int TotalNumberOfRawLines(LineBuffer *self) {
             maxLines:(NSInteger)maxLines {
     __block BOOL truncated = NO;
     __block NSInteger numLines = 0;
+    const BOOL compress = [iTermAdvancedSettingsModel compressRestorableScrollback];
 
     iTermOrderedDictionary<NSString *, LineBlock *> *index =
     [iTermOrderedDictionary byMappingEnumerator:_lineBlocks.blocks.reverseObjectEnumerator
@@ -1144,7 +1209,7 @@ NS_INLINE int TotalNumberOfRawLines(LineBuffer *self) {
                                           block:^BOOL(id<iTermEncoderAdapter>  _Nonnull encoder) {
             assert(!truncated);
             DLog(@"Really encode block %p with guid %@", block, block.stringUniqueIdentifier);
-            [encoder mergeDictionary:block.dictionary]; 
+            [encoder mergeDictionary:[block packedDictionaryCompressed:compress]];
             // This caps the amount of data at a reasonable but arbitrary size.
             numLines += [block getNumLinesWithWrapWidth:80];
             if (numLines >= maxLines) {
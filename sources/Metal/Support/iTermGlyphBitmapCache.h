@@ -0,0 +1,69 @@
+//
+//  iTermGlyphBitmapCache.h
+//  iTerm2SharedARC
+//
+//  Created by George Nachman on 10/18/26.
+//
+
+#import <Foundation/Foundation.h>
+
+@class iTermCharacterBitmap;
+@class iTermCharacterSourceAttributes;
+@class iTermCharacterSourceDescriptor;
+
+NS_ASSUME_NONNULL_BEGIN
+
+// Remembers rasterized glyphs so renderers that draw the same glyph with the same font, size, scale,
+// and attributes don't each rasterize it. Entries are content-addressed: the key is a digest of
+// everything that determines the bitmaps, so one cache can be shared by all sessions.
+//
+// Recently used entries are kept in memory. If the cache has a path, every new entry is also
+// appended to a file there, which is memory-mapped when the cache is created. This lets a new
+// process skip rasterizing glyphs that an earlier one already drew. The file is discarded if it was
+// written by a different version of the app or OS, since glyph rendering may have changed. Keys
+// include each font's file, modification date, and version, so a font that's updated under the same
+// name gets new entries. Records are checksummed and damaged ones are ignored. The file is locked
+// while it's open, so only one process uses it at a time. Other processes that share the path keep
+// their glyphs only in memory.
+//
+// Thread-safe.
+@interface iTermGlyphBitmapCache : NSObject
+
+// Shared by all sessions. Has a file if the persistGlyphBitmaps advanced setting is on.
++ (instancetype)sharedInstance;
+
+// Where the shared instance keeps its file.
++ (NSString *)defaultPath;
+
+// Returns the key for the bitmaps of `string` drawn as iTermCharacterSource would draw it. If
+// asciiPartsOnly is set, only the center part and its horizontal neighbors are cached, as is done
+// for ASCII characters.
++ (NSData *)keyForCharacter:(NSString *)string
+                 descriptor:(iTermCharacterSourceDescriptor *)descriptor
+                 attributes:(iTermCharacterSourceAttributes *)attributes
+                 boxDrawing:(BOOL)boxDrawing
+                     radius:(int)radius
+   useNativePowerlineGlyphs:(BOOL)useNativePowerlineGlyphs
+             asciiPartsOnly:(BOOL)asciiPartsOnly;
+
+// capacity is the number of glyphs kept in memory. If path is nil nothing is saved to disk.
+- (instancetype)initWithCapacity:(NSInteger)capacity path:(nullable NSString *)path NS_DESIGNATED_INITIALIZER;
+- (instancetype)init NS_UNAVAILABLE;
+
+// Returns cached bitmaps, keyed by part, or nil on a miss. Callers must not modify them.
+- (nullable NSDictionary<NSNumber *, iTermCharacterBitmap *> *)bitmapsForKey:(NSData *)key
+                                                                       emoji:(BOOL *)emoji;
+
+- (void)setBitmaps:(NSDictionary<NSNumber *, iTermCharacterBitmap *> *)bitmaps
+             emoji:(BOOL)emoji
+            forKey:(NSData *)key;
+
+// For tests and performance measurement.
+@property (atomic, readonly) NSInteger hits;
+@property (atomic, readonly) NSInteger misses;
+// Number of entries that were found in the file rather than in memory. Also counted in hits.
+@property (atomic, readonly) NSInteger diskHits;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,582 @@
+//
+//  iTermGlyphBitmapCache.m
+//  iTerm2SharedARC
+//
+//  Created by George Nachman on 10/18/26.
+//
+
+#import "iTermGlyphBitmapCache.h"
+
+#import "DebugLogging.h"
+#import "iTermAdvancedSettingsModel.h"
+#import "iTermCache.h"
+#import "iTermCharacterBitmap.h"
+#import "iTermCharacterSource.h"
+#import "NSFileManager+iTerm.h"
+#import "PTYFontInfo.h"
+
+#import <CommonCrypto/CommonDigest.h>
+#import <CoreText/CoreText.h>
+#import <stdatomic.h>
+#import "zlib.h"
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+// Increment when the file format or the contents of keys change.
+static const uint32_t iTermGlyphBitmapCacheFormatVersion = 2;
+static const uint32_t iTermGlyphBitmapCacheMagic = 'iTGB';
+// Glyphs kept in memory by the shared instance.
+static const NSInteger iTermGlyphBitmapCacheSharedCapacity = 8192;
+// New entries aren't saved once the file reaches this size.
+static const off_t iTermGlyphBitmapCacheMaximumFileSize = 128 * 1024 * 1024;
+// Bitmaps are RGBA.
+static const size_t iTermGlyphBitmapCacheBytesPerPixel = 4;
+
+// File layout: a header, then records appended one after another.
+//   Header: magic, format version, stamp length, stamp (identifies the app and OS version).
+//   Record: digest (the key), payload length, CRC-32 of the payload, payload.
+//   Payload: emoji flag, part count, then for each part: part number, width, height, byte count, bytes.
+typedef struct {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t stampLength;
+} iTermGlyphBitmapCacheFileHeader;
+
+typedef struct {
+    unsigned char digest[CC_SHA256_DIGEST_LENGTH];
+    uint32_t payloadLength;
+    uint32_t payloadChecksum;
+} iTermGlyphBitmapCacheRecordHeader;
+
+typedef struct {
+    int32_t part;
+    uint32_t length;
+    double width;
+    double height;
+} iTermGlyphBitmapCachePartHeader;
+
+@interface iTermGlyphBitmapCacheEntry : NSObject
+@property (nonatomic, readonly) NSDictionary<NSNumber *, iTermCharacterBitmap *> *bitmaps;
+@property (nonatomic, readonly) BOOL emoji;
+- (instancetype)initWithBitmaps:(NSDictionary<NSNumber *, iTermCharacterBitmap *> *)bitmaps emoji:(BOOL)emoji;
+@end
+
+@implementation iTermGlyphBitmapCacheEntry
+
+- (instancetype)initWithBitmaps:(NSDictionary<NSNumber *, iTermCharacterBitmap *> *)bitmaps emoji:(BOOL)emoji {
+    self = [super init];
+    if (self) {
+        _bitmaps = [bitmaps copy];
+        _emoji = emoji;
+    }
+    return self;
+}
+
+@end
+
+@implementation iTermGlyphBitmapCache {
+    iTermCache<NSData *, iTermGlyphBitmapCacheEntry *> *_memoryCache;
+    atomic_long _hits;
+    atomic_long _misses;
+    atomic_long _diskHits;
+
+    // The rest is guarded by @synchronized(self).
+    NSString *_path;
+    // Holds an exclusive flock on the file while it's open, so no other process can append to it
+    // or truncate it while it's mapped here.
+    int _fd;
+    // The file as it was when the cache was created.
+    const unsigned char *_map;
+    size_t _mappedLength;
+    // Length of the file including records appended since it was mapped.
+    off_t _fileLength;
+    // Digest -> offset of its record in the file.
+    NSMutableDictionary<NSData *, NSNumber *> *_offsets;
+}
+
++ (instancetype)sharedInstance {
+    static iTermGlyphBitmapCache *instance;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        NSString *path = [iTermAdvancedSettingsModel persistGlyphBitmaps] ? [self defaultPath] : nil;
+        instance = [[self alloc] initWithCapacity:iTermGlyphBitmapCacheSharedCapacity path:path];
+    });
+    return instance;
+}
+
++ (NSString *)defaultPath {
+    NSString *appSupport = [[NSFileManager defaultManager] applicationSupportDirectory];
+    return [appSupport stringByAppendingPathComponent:@"GlyphBitmapCache"];
+}
+
+// Identifies the rasterizer. Files written by a different one are discarded.
++ (NSData *)stamp {
+    NSString *appVersion = [[NSBundle mainBundle] infoDictionary][@"CFBundleVersion"] ?: @"";
+    NSString *osVersion = [[NSProcessInfo processInfo] operatingSystemVersionString];
+    return [[NSString stringWithFormat:@"%@ %@", appVersion, osVersion] dataUsingEncoding:NSUTF8StringEncoding];
+}
+
+#pragma mark - Keys
+
+static void iTermGlyphBitmapCacheAppendString(NSMutableData *data, NSString *string) {
+    NSData *utf8 = [string ?: @"" dataUsingEncoding:NSUTF8StringEncoding];
+    const uint32_t length = (uint32_t)utf8.length;
+    [data appendBytes:&length length:sizeof(length)];
+    [data appendData:utf8];
+}
+
+static void iTermGlyphBitmapCacheAppendDouble(NSMutableData *data, double value) {
+    [data appendBytes:&value length:sizeof(value)];
+}
+
+static void iTermGlyphBitmapCacheAppendInt(NSMutableData *data, int32_t value) {
+    [data appendBytes:&value length:sizeof(value)];
+}
+
+static void iTermGlyphBitmapCacheAppendSize(NSMutableData *data, CGSize size) {
+    iTermGlyphBitmapCacheAppendDouble(data, size.width);
+    iTermGlyphBitmapCacheAppendDouble(data, size.height);
+}
+
+// Identifies the file a font was loaded from and its version, so glyphs drawn with a font that was
+// since updated or reinstalled under the same name aren't reused. Looking these up is slow, so the
+// result is remembered until the set of installed fonts changes.
+static NSString *iTermGlyphBitmapCacheFontIdentity(NSFont *font) {
+    static NSMutableDictionary<NSString *, NSString *> *identities;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        identities = [NSMutableDictionary dictionary];
+        [[NSNotificationCenter defaultCenter] addObserverForName:NSFontSetChangedNotification
+                                                          object:nil
+                                                           queue:nil
+                                                      usingBlock:^(NSNotification * _Nonnull note) {
+            @synchronized (identities) {
+                [identities removeAllObjects];
+            }
+        }];
+    });
+    NSString *name = font.fontName;
+    @synchronized (identities) {
+        NSString *identity = identities[name];
+        if (identity) {
+            return identity;
+        }
+    }
+    CTFontRef ctFont = (__bridge CTFontRef)font;
+    NSURL *url = CFBridgingRelease(CTFontCopyAttribute(ctFont, kCTFontURLAttribute));
+    NSString *version = CFBridgingRelease(CTFontCopyName(ctFont, kCTFontVersionNameKey));
+    NSDate *modificationDate = nil;
+    [url getResourceValue:&modificationDate forKey:NSURLContentModificationDateKey error:nil];
+    NSString *identity = [NSString stringWithFormat:@"%@ %@ %@",
+                          url.path ?: @"",
+                          @(modificationDate.timeIntervalSinceReferenceDate),
+                          version ?: @""];
+    @synchronized (identities) {
+        identities[name] = identity;
+    }
+    return identity;
+}
+
+static void iTermGlyphBitmapCacheAppendFontInfo(NSMutableData *data, PTYFontInfo *fontInfo) {
+    PTYFontInfo *variants[] = {
+        fontInfo, fontInfo.boldVersion, fontInfo.italicVersion, fontInfo.boldItalicVersion
+    };
+    for (size_t i = 0; i < sizeof(variants) / sizeof(*variants); i++) {
+        PTYFontInfo *variant = variants[i];
+        if (!variant.font) {
+            iTermGlyphBitmapCacheAppendInt(data, 0);
+            continue;
+        }
+        iTermGlyphBitmapCacheAppendInt(data, 1);
+        iTermGlyphBitmapCacheAppendString(data, variant.font.fontName);
+        iTermGlyphBitmapCacheAppendString(data, iTermGlyphBitmapCacheFontIdentity(variant.font));
+        iTermGlyphBitmapCacheAppendDouble(data, variant.font.pointSize);
+        iTermGlyphBitmapCacheAppendDouble(data, variant.baselineOffset);
+    }
+}
+
++ (NSData *)keyForCharacter:(NSString *)string
+                 descriptor:(iTermCharacterSourceDescriptor *)descriptor
+                 attributes:(iTermCharacterSourceAttributes *)attributes
+                 boxDrawing:(BOOL)boxDrawing
+                     radius:(int)radius
+   useNativePowerlineGlyphs:(BOOL)useNativePowerlineGlyphs
+             asciiPartsOnly:(BOOL)asciiPartsOnly {
+    NSMutableData *data = [NSMutableData data];
+    iTermGlyphBitmapCacheAppendInt(data, iTermGlyphBitmapCacheFormatVersion);
+    iTermGlyphBitmapCacheAppendFontInfo(data, descriptor.asciiFontInfo);
+    iTermGlyphBitmapCacheAppendFontInfo(data, descriptor.nonAsciiFontInfo);
+    iTermGlyphBitmapCacheAppendSize(data, descriptor.asciiOffset);
+    iTermGlyphBitmapCacheAppendSize(data, descriptor.glyphSize);
+    iTermGlyphBitmapCacheAppendSize(data, descriptor.cellSize);
+    iTermGlyphBitmapCacheAppendSize(data, descriptor.cellSizeWithoutSpacing);
+    iTermGlyphBitmapCacheAppendDouble(data, descriptor.scale);
+    const int32_t flags = ((descriptor.useBoldFont ? 1 : 0) |
+                           (descriptor.useItalicFont ? 2 : 0) |
+                           (descriptor.useNonAsciiFont ? 4 : 0) |
+                           (descriptor.asciiAntiAliased ? 8 : 0) |
+                           (descriptor.nonAsciiAntiAliased ? 16 : 0) |
+                           (attributes.useThinStrokes ? 32 : 0) |
+                           (attributes.bold ? 64 : 0) |
+                           (attributes.italic ? 128 : 0) |
+                           (boxDrawing ? 256 : 0) |
+                           (useNativePowerlineGlyphs ? 512 : 0) |
+                           (asciiPartsOnly ? 1024 : 0));
+    iTermGlyphBitmapCacheAppendInt(data, flags);
+    iTermGlyphBitmapCacheAppendInt(data, radius);
+    iTermGlyphBitmapCacheAppendString(data, string);
+
+    unsigned char digest[CC_SHA256_DIGEST_LENGTH];
+    CC_SHA256(data.bytes, (CC_LONG)data.length, digest);
+    return [NSData dataWithBytes:digest length:sizeof(digest)];
+}
+
+static uint32_t iTermGlyphBitmapCacheChecksum(NSData *payload) {
+    return (uint32_t)crc32(crc32(0, Z_NULL, 0), payload.bytes, (uInt)payload.length);
+}
+
+#pragma mark - Lifecycle
+
+- (instancetype)initWithCapacity:(NSInteger)capacity path:(NSString *)path {
+    self = [super init];
+    if (self) {
+        _memoryCache = [[iTermCache alloc] initWithCapacity:capacity];
+        _offsets = [NSMutableDictionary dictionary];
+        _fd = -1;
+        if (path) {
+            _path = [path copy];
+            [self openFile];
+        }
+    }
+    return self;
+}
+
+- (void)dealloc {
+    [self closeFile];
+}
+
+#pragma mark - APIs
+
+- (NSInteger)hits {
+    return atomic_load_explicit(&_hits, memory_order_relaxed);
+}
+
+- (NSInteger)misses {
+    return atomic_load_explicit(&_misses, memory_order_relaxed);
+}
+
+- (NSInteger)diskHits {
+    return atomic_load_explicit(&_diskHits, memory_order_relaxed);
+}
+
+- (NSDictionary<NSNumber *, iTermCharacterBitmap *> *)bitmapsForKey:(NSData *)key emoji:(BOOL *)emoji {
+    iTermGlyphBitmapCacheEntry *entry = _memoryCache[key];
+    if (!entry) {
+        entry = [self entryFromFileForKey:key];
+        if (entry) {
+            atomic_fetch_add_explicit(&_diskHits, 1, memory_order_relaxed);
+            _memoryCache[key] = entry;
+        }
+    }
+    if (!entry) {
+        atomic_fetch_add_explicit(&_misses, 1, memory_order_relaxed);
+        return nil;
+    }
+    atomic_fetch_add_explicit(&_hits, 1, memory_order_relaxed);
+    if (emoji) {
+        *emoji = entry.emoji;
+    }
+    return entry.bitmaps;
+}
+
+- (void)setBitmaps:(NSDictionary<NSNumber *, iTermCharacterBitmap *> *)bitmaps
+             emoji:(BOOL)emoji
+            forKey:(NSData *)key {
+    iTermGlyphBitmapCacheEntry *entry = [[iTermGlyphBitmapCacheEntry alloc] initWithBitmaps:bitmaps emoji:emoji];
+    _memoryCache[key] = entry;
+    [self appendEntry:entry forKey:key];
+}
+
+#pragma mark - File
+
+- (void)openFile {
+    @synchronized (self) {
+        [[NSFileManager defaultManager] createDirectoryAtPath:[_path stringByDeletingLastPathComponent]
+                                  withIntermediateDirectories:YES
+                                                   attributes:nil
+                                                        error:nil];
+        _fd = open(_path.fileSystemRepresentation, O_RDWR | O_CREAT | O_CLOEXEC, 0600);
+        if (_fd < 0) {
+            DLog(@"Failed to open %@: %s", _path, strerror(errno));
+            return;
+        }
+        // Only one process at a time may use the file. Others keep their glyphs in memory.
+        if (flock(_fd, LOCK_EX | LOCK_NB) != 0) {
+            DLog(@"Not saving glyphs because %@ could not be locked: %s", _path, strerror(errno));
+            close(_fd);
+            _fd = -1;
+            return;
+        }
+        struct stat sb;
+        if (fstat(_fd, &sb) != 0) {
+            [self closeFile];
+            return;
+        }
+        if (sb.st_size > 0) {
+            void *map = mmap(NULL, sb.st_size, PROT_READ, MAP_PRIVATE, _fd, 0);
+            if (map != MAP_FAILED) {
+                _map = map;
+                _mappedLength = sb.st_size;
+            }
+        }
+        const off_t end = [self indexMappedRecords];
+        if (end == 0) {
+            [self resetFile];
+        } else if (end < sb.st_size) {
+            // Drop a record whose write was interrupted.
+            DLog(@"Truncating %@ from %@ to %@", _path, @(sb.st_size), @(end));
+            if (ftruncate(_fd, end) != 0) {
+                [self closeFile];
+                return;
+            }
+        }
+        _fileLength = lseek(_fd, 0, SEEK_END);
+    }
+}
+
+// Validates the header and records every complete record's offset. Returns the length of the valid
+// prefix of the file, or 0 if it is unusable.
+- (off_t)indexMappedRecords {
+    if (!_map) {
+        return 0;
+    }
+    NSData *stamp = [iTermGlyphBitmapCache stamp];
+    iTermGlyphBitmapCacheFileHeader header;
+    if (_mappedLength < sizeof(header)) {
+        return 0;
+    }
+    memcpy(&header, _map, sizeof(header));
+    if (header.magic != iTermGlyphBitmapCacheMagic ||
+        header.version != iTermGlyphBitmapCacheFormatVersion ||
+        header.stampLength != stamp.length ||
+        _mappedLength < sizeof(header) + stamp.length ||
+        memcmp(_map + sizeof(header), stamp.bytes, stamp.length)) {
+        DLog(@"Discarding glyph cache written by another version");
+        return 0;
+    }
+
+    size_t offset = sizeof(header) + stamp.length;
+    while (offset + sizeof(iTermGlyphBitmapCacheRecordHeader) <= _mappedLength) {
+        iTermGlyphBitmapCacheRecordHeader recordHeader;
+        memcpy(&recordHeader, _map + offset, sizeof(recordHeader));
+        const size_t payloadOffset = offset + sizeof(recordHeader);
+        if (recordHeader.payloadLength > _mappedLength - payloadOffset) {
+            break;
+        }
+        NSData *digest = [NSData dataWithBytes:recordHeader.digest length:sizeof(recordHeader.digest)];
+        _offsets[digest] = @(offset);
+        offset = payloadOffset + recordHeader.payloadLength;
+    }
+    return offset;
+}
+
+- (void)resetFile {
+    if (_map) {
+        munmap((void *)_map, _mappedLength);
+        _map = NULL;
+        _mappedLength = 0;
+    }
+    [_offsets removeAllObjects];
+    if (ftruncate(_fd, 0) != 0) {
+        [self closeFile];
+        return;
+    }
+    NSData *stamp = [iTermGlyphBitmapCache stamp];
+    const iTermGlyphBitmapCacheFileHeader header = {
+        .magic = iTermGlyphBitmapCacheMagic,
+        .version = iTermGlyphBitmapCacheFormatVersion,
+        .stampLength = (uint32_t)stamp.length
+    };
+    NSMutableData *data = [NSMutableData dataWithBytes:&header length:sizeof(header)];
+    [data appendData:stamp];
+    if (pwrite(_fd, data.bytes, data.length, 0) != (ssize_t)data.length) {
+        [self closeFile];
+    }
+}
+
+// Unmaps the file before closing it, since closing releases the lock that keeps other processes
+// from truncating it.
+- (void)closeFile {
+    if (_map) {
+        munmap((void *)_map, _mappedLength);
+        _map = NULL;
+        _mappedLength = 0;
+    }
+    [_offsets removeAllObjects];
+    if (_fd >= 0) {
+        close(_fd);
+        _fd = -1;
+    }
+}
+
+- (iTermGlyphBitmapCacheEntry *)entryFromFileForKey:(NSData *)key {
+    NSData *record = nil;
+    @synchronized (self) {
+        NSNumber *offsetNumber = _offsets[key];
+        if (!offsetNumber) {
+            return nil;
+        }
+        const off_t offset = offsetNumber.longLongValue;
+        iTermGlyphBitmapCacheRecordHeader recordHeader;
+        if (offset + sizeof(recordHeader) <= _mappedLength) {
+            memcpy(&recordHeader, _map + offset, sizeof(recordHeader));
+            if (![self recordHeader:&recordHeader matchesKey:key]) {
+                return nil;
+            }
+            if (recordHeader.payloadLength > _mappedLength - offset - sizeof(recordHeader)) {
+                return nil;
+            }
+            record = [NSData dataWithBytesNoCopy:(void *)(_map + offset + sizeof(recordHeader))
+                                          length:recordHeader.payloadLength
+                                    freeWhenDone:NO];
+        } else if (_fd >= 0) {
+            // Appended since the file was mapped.
+            if (pread(_fd, &recordHeader, sizeof(recordHeader), offset) != sizeof(recordHeader)) {
+                return nil;
+            }
+            if (![self recordHeader:&recordHeader matchesKey:key]) {
+                return nil;
+            }
+            NSMutableData *payload = [NSMutableData dataWithLength:recordHeader.payloadLength];
+            if (pread(_fd, payload.mutableBytes, payload.length, offset + sizeof(recordHeader)) != (ssize_t)payload.length) {
+                return nil;
+            }
+            record = payload;
+        }
+        if (![self recordHeader:&recordHeader matchesPayload:record key:key]) {
+            return nil;
+        }
+        // Decode while the map is known to be valid.
+        iTermGlyphBitmapCacheEntry *entry = [self entryFromPayload:record];
+        if (!entry) {
+            DLog(@"Record for %@ in %@ is malformed", key, _path);
+            [_offsets removeObjectForKey:key];
+        }
+        return entry;
+    }
+}
+
+// A record whose digest isn't the key holds some other glyph's bitmaps. It's forgotten so it isn't
+// read again.
+- (BOOL)recordHeader:(const iTermGlyphBitmapCacheRecordHeader *)recordHeader matchesKey:(NSData *)key {
+    if (key.length == sizeof(recordHeader->digest) &&
+        memcmp(recordHeader->digest, key.bytes, key.length) == 0) {
+        return YES;
+    }
+    DLog(@"Record for %@ in %@ has the wrong digest", key, _path);
+    [_offsets removeObjectForKey:key];
+    return NO;
+}
+
+// Detects records that were damaged after they were written.
+- (BOOL)recordHeader:(const iTermGlyphBitmapCacheRecordHeader *)recordHeader
+      matchesPayload:(NSData *)payload
+                 key:(NSData *)key {
+    if (payload && recordHeader->payloadChecksum == iTermGlyphBitmapCacheChecksum(payload)) {
+        return YES;
+    }
+    DLog(@"Record for %@ in %@ has the wrong checksum", key, _path);
+    [_offsets removeObjectForKey:key];
+    return NO;
+}
+
+// Returns nil if any part's byte count doesn't match its size.
+- (iTermGlyphBitmapCacheEntry *)entryFromPayload:(NSData *)payload {
+    const unsigned char *bytes = payload.bytes;
+    const size_t length = payload.length;
+    uint32_t emoji;
+    uint32_t count;
+    if (length < sizeof(emoji) + sizeof(count)) {
+        return nil;
+    }
+    memcpy(&emoji, bytes, sizeof(emoji));
+    memcpy(&count, bytes + sizeof(emoji), sizeof(count));
+    size_t offset = sizeof(emoji) + sizeof(count);
+
+    NSMutableDictionary<NSNumber *, iTermCharacterBitmap *> *bitmaps = [NSMutableDictionary dictionaryWithCapacity:count];
+    for (uint32_t i = 0; i < count; i++) {
+        iTermGlyphBitmapCachePartHeader partHeader;
+        if (offset + sizeof(partHeader) > length) {
+            return nil;
+        }
+        memcpy(&partHeader, bytes + offset, sizeof(partHeader));
+        offset += sizeof(partHeader);
+        if (partHeader.length > length - offset) {
+            return nil;
+        }
+        if (!(partHeader.width >= 0 && partHeader.width <= UINT16_MAX && partHeader.width == floor(partHeader.width)) ||
+            !(partHeader.height >= 0 && partHeader.height <= UINT16_MAX && partHeader.height == floor(partHeader.height)) ||
+            partHeader.length != (size_t)partHeader.width * (size_t)partHeader.height * iTermGlyphBitmapCacheBytesPerPixel) {
+            return nil;
+        }
+        iTermCharacterBitmap *bitmap = [[iTermCharacterBitmap alloc] init];
+        bitmap.data = [NSMutableData dataWithBytes:bytes + offset length:partHeader.length];
+        bitmap.size = CGSizeMake(partHeader.width, partHeader.height);
+        bitmaps[@(partHeader.part)] = bitmap;
+        offset += partHeader.length;
+    }
+    return [[iTermGlyphBitmapCacheEntry alloc] initWithBitmaps:bitmaps emoji:!!emoji];
+}
+
+- (void)appendEntry:(iTermGlyphBitmapCacheEntry *)entry forKey:(NSData *)key {
+    if (!_path) {
+        return;
+    }
+    NSMutableData *record = [NSMutableData data];
+    iTermGlyphBitmapCacheRecordHeader recordHeader;
+    memset(&recordHeader, 0, sizeof(recordHeader));
+    [record appendBytes:&recordHeader length:sizeof(recordHeader)];
+
+    const uint32_t emoji = entry.emoji;
+    const uint32_t count = (uint32_t)entry.bitmaps.count;
+    [record appendBytes:&emoji length:sizeof(emoji)];
+    [record appendBytes:&count length:sizeof(count)];
+    [entry.bitmaps enumerateKeysAndObjectsUsingBlock:^(NSNumber * _Nonnull part, iTermCharacterBitmap * _Nonnull bitmap, BOOL * _Nonnull stop) {
+        iTermGlyphBitmapCachePartHeader partHeader;
+        memset(&partHeader, 0, sizeof(partHeader));
+        partHeader.part = part.intValue;
+        partHeader.length = (uint32_t)bitmap.data.length;
+        partHeader.width = bitmap.size.width;
+        partHeader.height = bitmap.size.height;
+        [record appendBytes:&partHeader length:sizeof(partHeader)];
+        [record appendData:bitmap.data];
+    }];
+
+    memcpy(recordHeader.digest, key.bytes, MIN(key.length, sizeof(recordHeader.digest)));
+    recordHeader.payloadLength = (uint32_t)(record.length - sizeof(recordHeader));
+    NSData *payload = [NSData dataWithBytesNoCopy:(unsigned char *)record.mutableBytes + sizeof(recordHeader)
+                                           length:recordHeader.payloadLength
+                                     freeWhenDone:NO];
+    recordHeader.payloadChecksum = iTermGlyphBitmapCacheChecksum(payload);
+    memcpy(record.mutableBytes, &recordHeader, sizeof(recordHeader));
+
+    @synchronized (self) {
+        if (_fd < 0 || _offsets[key] || _fileLength + (off_t)record.length > iTermGlyphBitmapCacheMaximumFileSize) {
+            return;
+        }
+        const ssize_t written = pwrite(_fd, record.bytes, record.length, _fileLength);
+        if (written != (ssize_t)record.length) {
+            DLog(@"Failed to append to %@: %s", _path, strerror(errno));
+            // Don't leave a partial record where the next one would go.
+            if (ftruncate(_fd, _fileLength) != 0) {
+                [self closeFile];
+            }
+            return;
+        }
+        _offsets[key] = @(_fileLength);
+        _fileLength += record.length;
+    }
+}
+
+@end
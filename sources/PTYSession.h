@@ -900,6 +900,9 @@ backgroundColor:(NSColor *)backgroundColor;
 #pragma mark - API
 
 - (ITMGetBufferResponse *)handleGetBufferRequest:(ITMGetBufferRequest *)request;
+// The completion block is called on a background queue.
+- (void)handleGetScrollbackRequest:(ITMGetScrollbackRequest *)request
+                        completion:(void (^)(ITMGetScrollbackResponse *response))completion;
 - (void)handleGetPromptRequest:(ITMGetPromptRequest *)request
                     completion:(void (^)(ITMGetPromptResponse *response))completion;
 - (void)handleListPromptsRequest:(ITMListPromptsRequest *)request
@@ -60,6 +60,7 @@
 #import "iTermPreferences.h"
 #import "iTermScriptConsole.h"
 #import "iTermScriptHistory.h"
+#import "iTermScrollbackExporter.h"
 #import "iTermSharedImageStore.h"
 #import "iTermSnippetsModel.h"
 #import "iTermStandardKeyMapper.h"
@@ -115,6 +116,7 @@
 #import "iTermWarning.h"
 #import "iTermWebSocketCookieJar.h"
 #import "iTermWorkingDirectoryPoller.h"
+#import "LineBuffer.h"
 #import "MovePaneController.h"
 #import "MovingAverage.h"
 #import "NSAlert+iTerm.h"
@@ -2903,7 +2905,9 @@ ITERM_WEAKLY_REFERENCEABLE
         if (_useAdaptiveFrameRate) {
             [_throughputEstimator addByteCount:length];
         }
+        const CFTimeInterval start = CACurrentMediaTime();
         [self executeTokens:&vector bytesHandled:length];
+        [_cadenceController didParseBytes:length duration:CACurrentMediaTime() - start];
         [_cadenceController didHandleInput];
 
         // Unblock the background thread; if it's ready, it can send the main thread more tokens
@@ -5794,6 +5798,10 @@ scrollToFirstResult:(BOOL)scrollToFirstResult {
     return [self effectiveBlend];
 }
 
+- (void)metalGlueDidPrepareFrameWithDuration:(NSTimeInterval)duration NS_AVAILABLE_MAC(10_11) {
+    [_cadenceController didDrawFrameWithDuration:duration];
+}
+
 - (void)metalGlueDidDrawFrameAndNeedsRedraw:(BOOL)redrawAsap NS_AVAILABLE_MAC(10_11) {
     if (_view.useMetal) {
         if (redrawAsap) {
@@ -8813,6 +8821,10 @@ scrollToFirstResult:(BOOL)scrollToFirstResult {
     self.active = YES;
 }
 
+- (void)textViewDidDrawWithDuration:(NSTimeInterval)duration {
+    [_cadenceController didDrawFrameWithDuration:duration];
+}
+
 - (void)textViewSplitVertically:(BOOL)vertically withProfileGuid:(NSString *)guid
 {
     Profile *profile;
@@ -12661,6 +12673,9 @@ preferredEscaping:(iTermSendTextEscaping)preferredEscaping {
     state.adaptiveFrameRateThroughputThreshold = _adaptiveFrameRateThroughputThreshold;
     state.slowFrameRate = self.useMetal ? [iTermAdvancedSettingsModel metalSlowFrameRate] : [iTermAdvancedSettingsModel slowFrameRate];
     state.liveResizing = _inLiveResize;
+    NSWindow *window = self.view.window;
+    state.key = window.isKeyWindow;
+    state.occluded = window != nil && !(window.occlusionState & NSWindowOcclusionStateVisible);
     return state;
 }
 
@@ -12824,6 +12839,36 @@ preferredEscaping:(iTermSendTextEscaping)preferredEscaping {
     completion(response);
 }
 
+- (void)handleGetScrollbackRequest:(ITMGetScrollbackRequest *)request
+                        completion:(void (^)(ITMGetScrollbackResponse *response))completion {
+    // Copy just the lines this request asks for here on the main thread and do the slow part on a
+    // background queue so exporting a big history doesn't stall the session.
+    const long long overflow = _screen.totalScrollbackOverflow;
+    const long long endOfBuffer = overflow + _screen.numberOfScrollbackLines + [_screen.currentGrid numberOfLinesUsed];
+    const NSRange range = [iTermScrollbackExporter rangeOfLinesForRequest:request
+                                                                firstLine:overflow
+                                                              endOfBuffer:endOfBuffer];
+    int linesBefore = 0;
+    LineBuffer *snapshot = nil;
+    if (range.location == NSNotFound) {
+        snapshot = [[LineBuffer alloc] init];
+    } else {
+        snapshot = [_screen newSnapshotOfLinesInRange:NSMakeRange(range.location - overflow, range.length)
+                                          linesBefore:&linesBefore];
+    }
+    iTermScrollbackExporter *exporter =
+        [[iTermScrollbackExporter alloc] initWithLineBuffer:snapshot
+                                                      width:_screen.width
+                                                  firstLine:overflow
+                                          firstLineOfBuffer:overflow + linesBefore
+                                                endOfBuffer:endOfBuffer];
+    [snapshot release];
+    dispatch_async([iTermScrollbackExporter queue], ^{
+        completion([exporter responseForRequest:request]);
+        [exporter release];
+    });
+}
+
 - (void)handleGetPromptRequest:(ITMGetPromptRequest *)request completion:(void (^)(ITMGetPromptResponse *response))completion {
     VT100ScreenMark *mark;
     if (request.hasUniquePromptId) {
@@ -75,6 +75,10 @@ iTermURLActionHelperDelegate>
 // Returns a dictionary to pass to NSAttributedString.
 - (NSDictionary *)charAttributes:(screen_char_t)c;
 
+// When the selection spans at least streamingCopyMinimumLines lines, starts copying it as plain
+// text on a background queue and returns YES. Returns NO if it should be copied the usual way.
+- (BOOL)copyLargeSelectionInBackground;
+
 #pragma mark - Install Shell Integration
 
 - (IBAction)installShellIntegration:(nullable id)sender;
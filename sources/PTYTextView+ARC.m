@@ -21,6 +21,7 @@
 #import "iTermPreferences.h"
 #import "iTermScriptConsole.h"
 #import "iTermScriptHistory.h"
+#import "iTermSelectionExporter.h"
 #import "iTermShellIntegrationWindowController.h"
 #import "iTermSlowOperationGateway.h"
 #import "iTermSnippetsMenuController.h"
@@ -43,6 +44,7 @@
 #import "PTYNoteViewController.h"
 #import "PTYTextView+Private.h"
 #import "SCPPath.h"
+#import "ToastWindowController.h"
 #import "URLAction.h"
 #import "VT100Terminal.h"
 
@@ -241,6 +243,7 @@ static const NSUInteger kRectangularSelectionModifierMask = (kRectangularSelecti
         return;
     }
 
+    [_urlActionHelper prefetchPathsOnLines:[self rangeOfVisibleLines]];
     __weak __typeof(self) weakSelf = self;
     DLog(@"updateUnderlinedURLs in screen:\n%@", [self.dataSource compactLineDumpWithContinuationMarks]);
     [_urlActionHelper urlActionForClickAtCoord:coord completion:^(URLAction *action) {
@@ -519,6 +522,111 @@ static const NSUInteger kRectangularSelectionModifierMask = (kRectangularSelecti
     return attributes;
 }
 
+- (BOOL)copyLargeSelectionInBackground {
+    const int minimumLines = [iTermAdvancedSettingsModel streamingCopyMinimumLines];
+    if (minimumLines <= 0 || _contextMenuHelper.savedSelectedText || !self.selection.hasSelection) {
+        return NO;
+    }
+    const VT100GridAbsCoordRange span = [self.selection spanningAbsRange];
+    if (span.end.y - span.start.y + 1 < minimumLines) {
+        return NO;
+    }
+    DLog(@"Copy %@ lines in the background", @(span.end.y - span.start.y + 1));
+    [self.selectionExporter cancel];
+    iTermSelectionExporter *exporter = [self newSelectionExporter];
+    // The pasteboard keeps its old contents until the copy finishes, so say what's going on.
+    [ToastWindowController showToastWithMessage:@"Copying selection…"];
+    __weak __typeof(self) weakSelf = self;
+    __weak iTermSelectionExporter *weakExporter = exporter;
+    // Only touched on the exporter's serial queue.
+    __block NSTimeInterval lastReport = [NSDate timeIntervalSinceReferenceDate];
+    exporter.progress = ^(double fractionCompleted) {
+        DLog(@"Copied %.0f%% of the selection", fractionCompleted * 100);
+        const NSTimeInterval now = [NSDate timeIntervalSinceReferenceDate];
+        if (now - lastReport < 1) {
+            return;
+        }
+        lastReport = now;
+        dispatch_async(dispatch_get_main_queue(), ^{
+            [weakSelf selectionExporter:weakExporter didMakeProgress:fractionCompleted];
+        });
+    };
+    self.selectionExporter = exporter;
+    NSURL *url = [[NSURL fileURLWithPath:NSTemporaryDirectory()] URLByAppendingPathComponent:[[NSUUID UUID] UUIDString]];
+    [self exportSelectionWithExporter:exporter toURL:url completion:^(BOOL ok, NSError *error) {
+        [weakSelf selectionExporter:exporter didCopyToURL:url ok:ok error:error];
+    }];
+    return YES;
+}
+
+- (void)selectionExporter:(iTermSelectionExporter *)exporter didMakeProgress:(double)fractionCompleted {
+    if (!exporter || self.selectionExporter != exporter) {
+        return;
+    }
+    [ToastWindowController showToastWithMessage:[NSString stringWithFormat:@"Copying selection: %.0f%%", fractionCompleted * 100]];
+}
+
+- (void)selectionExporter:(iTermSelectionExporter *)exporter
+             didCopyToURL:(NSURL *)url
+                       ok:(BOOL)ok
+                    error:(NSError *)error {
+    if (self.selectionExporter != exporter) {
+        // Another copy started since this one. It was canceled so there's nothing to clean up.
+        return;
+    }
+    self.selectionExporter = nil;
+    if (!ok) {
+        DLog(@"Background copy failed: %@", error);
+        [ToastWindowController showToastWithMessage:@"Copy failed"];
+        return;
+    }
+    NSNumber *size = [[[NSFileManager defaultManager] attributesOfItemAtPath:url.path error:nil] objectForKey:NSFileSize];
+    if ([iTermAdvancedSettingsModel disallowCopyEmptyString] && size.longLongValue == 0) {
+        DLog(@"Disallow copying empty string");
+        [[NSFileManager defaultManager] removeItemAtURL:url error:nil];
+        return;
+    }
+    if (![iTermFilePasteboardDataProvider writeTextFileAtURL:url toPasteboard:[NSPasteboard generalPasteboard]]) {
+        DLog(@"Failed to put %@ on the pasteboard", url.path);
+        [[NSFileManager defaultManager] removeItemAtURL:url error:nil];
+        [ToastWindowController showToastWithMessage:@"Copy failed"];
+        return;
+    }
+    [ToastWindowController showToastWithMessage:@"Copied selection"];
+}
+
+- (iTermSelectionExporter *)newSelectionExporter {
+    // Copy only the lines the selection spans.
+    const long long overflow = [self.dataSource totalScrollbackOverflow];
+    const VT100GridAbsCoordRange span = [self.selection spanningAbsRange];
+    const long long start = MAX(0, span.start.y - overflow);
+    const long long end = MAX(start, span.end.y - overflow + 1);
+    int linesBefore = 0;
+    LineBuffer *snapshot = [self.dataSource newSnapshotOfLinesInRange:NSMakeRange(start, end - start)
+                                                          linesBefore:&linesBefore];
+    iTermSelectionExporter *exporter =
+        [[iTermSelectionExporter alloc] initWithLineBuffer:snapshot
+                                                     width:[self.dataSource width]
+                                                  overflow:overflow + linesBefore];
+    exporter.includeLastNewline = [iTermPreferences boolForKey:kPreferenceKeyCopyLastNewline];
+    exporter.trimTrailingWhitespace = [iTermAdvancedSettingsModel trimWhitespaceOnCopy];
+    [exporter addRangesOfSelection:self.selection];
+    return exporter;
+}
+
+// Runs |completion| on the main thread.
+- (void)exportSelectionWithExporter:(iTermSelectionExporter *)exporter
+                              toURL:(NSURL *)url
+                         completion:(void (^)(BOOL ok, NSError *error))completion {
+    dispatch_async([iTermSelectionExporter queue], ^{
+        NSError *error = nil;
+        const BOOL ok = [exporter writeToURL:url error:&error];
+        dispatch_async(dispatch_get_main_queue(), ^{
+            completion(ok, error);
+        });
+    });
+}
+
 #pragma mark - iTermURLActionHelperDelegate
 
 - (BOOL)urlActionHelperShouldIgnoreHardNewlines:(iTermURLActionHelper *)helper {
@@ -533,6 +641,10 @@ static const NSUInteger kRectangularSelectionModifierMask = (kRectangularSelecti
     return [iTermTextExtractor textExtractorWithDataSource:self.dataSource];
 }
 
+- (NSInteger)urlActionHelper:(iTermURLActionHelper *)helper generationForLine:(int)line {
+    return [self.dataSource generationForLine:line];
+}
+
 - (void)urlActionHelper:(iTermURLActionHelper *)helper workingDirectoryOnLine:(int)y completion:(void (^)(NSString *))completion {
     NSString *workingDirectory = [self.dataSource workingDirectoryOnLine:y];
     DLog(@"According to data source, the working directory on line %d is %@", y, workingDirectory);
@@ -1048,6 +1160,29 @@ toggleTerminalStateForMenuItem:(nonnull NSMenuItem *)item {
     [[iTermSnippetsModel sharedInstance] addSnippet:snippet];
 }
 
+- (void)contextMenuSaveSelectionToFile:(iTermTextViewContextMenuHelper *)contextMenu {
+    NSSavePanel *panel = [NSSavePanel savePanel];
+
+    NSString *directory = [[NSFileManager defaultManager] downloadsDirectory] ?: NSHomeDirectory();
+    [NSSavePanel setDirectoryURL:[NSURL fileURLWithPath:directory] onceForID:@"saveSelectionToFile" savePanel:panel];
+    panel.nameFieldStringValue = @"Selection.txt";
+    panel.canCreateDirectories = YES;
+    [panel setExtensionHidden:NO];
+
+    if ([panel runModal] != NSModalResponseOK) {
+        return;
+    }
+    // Take the snapshot now, before the selection or the buffer has a chance to change.
+    iTermSelectionExporter *exporter = [self newSelectionExporter];
+    NSURL *url = panel.URL;
+    [self exportSelectionWithExporter:exporter toURL:url completion:^(BOOL ok, NSError *error) {
+        if (!ok) {
+            DLog(@"Failed to save selection to %@: %@", url.path, error);
+            [NSApp presentError:error];
+        }
+    }];
+}
+
 - (void)contextMenu:(iTermTextViewContextMenuHelper *)contextMenu addTrigger:(NSString *)text {
     [self.delegate textViewAddTrigger:text];
 }
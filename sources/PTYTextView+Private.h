@@ -20,6 +20,7 @@
 #import "iTermSelection.h"
 #import "iTermSelectionScrollHelper.h"
 
+@class iTermSelectionExporter;
 @class iTermShellIntegrationWindowController;
 @class iTermURLActionHelper;
 @class PTYMouseHandler;
@@ -46,6 +47,8 @@ NSPopoverDelegate> {
 @property(nonatomic, strong) iTermFindCursorView *findCursorView;
 @property(nonatomic, strong) NSWindow *findCursorWindow;  // For find-cursor animation
 @property(nonatomic, strong) iTermQuickLookController *quickLookController;
+// Set while a large selection is being copied in the background.
+@property(nonatomic, strong) iTermSelectionExporter *selectionExporter;
 @property(strong, readwrite) NSTouchBar *touchBar NS_AVAILABLE_MAC(10_12_2);
 
 - (void)addNote;
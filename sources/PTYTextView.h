@@ -115,6 +115,8 @@ preferredEscaping:(iTermSendTextEscaping)preferredEscaping;
 - (BOOL)textViewIsMaximized;
 - (BOOL)textViewTabHasMaximizedPanel;
 - (void)textViewWillNeedUpdateForBlink;
+// Main thread time taken to draw the text view's contents.
+- (void)textViewDidDrawWithDuration:(NSTimeInterval)duration;
 - (BOOL)textViewDelegateHandlesAllKeystrokes;
 - (void)textViewSplitVertically:(BOOL)vertically withProfileGuid:(NSString *)guid;
 - (void)textViewSelectNextTab;
@@ -373,6 +373,8 @@
     [_quickLookController close];
     [_quickLookController release];
     [_contextMenuHelper release];
+    [_selectionExporter cancel];
+    [_selectionExporter release];
     [_highlightedRows release];
     [_scrollAccumulator release];
     [_shadowRateLimit release];
@@ -1144,6 +1146,7 @@
         return;
     }
     DLog(@"drawing document visible rect %@", NSStringFromRect(self.enclosingScrollView.documentVisibleRect));
+    const CFTimeInterval start = CACurrentMediaTime();
 
     const CGFloat virtualOffset = NSMinY(self.enclosingScrollView.documentVisibleRect) - [iTermPreferences intForKey:kPreferenceKeyTopBottomMargins];
     const NSRect *constRectArray;
@@ -1185,6 +1188,7 @@
         }
     }];
     [self maybeInvalidateWindowShadow];
+    [self.delegate textViewDidDrawWithDuration:CACurrentMediaTime() - start];
 }
 
 - (void)drawRect:(NSRect)rect {
@@ -1564,6 +1568,7 @@
     _useCustomBoldColor = flag;
     _brightenBold = brighten;
     _drawingHelper.useCustomBoldColor = flag;
+    _drawingHelper.brightenBold = brighten;
     [self setNeedsDisplay:YES];
 }
 
@@ -2571,6 +2576,9 @@
     DLog(@"-[PTYTextView copy:] called");
     DLog(@"%@", [NSThread callStackSymbols]);
 
+    if ([self copyLargeSelectionInBackground]) {
+        return;
+    }
     NSString *copyString = [self selectedText];
     [self copyString:copyString];
 }
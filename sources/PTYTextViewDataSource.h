@@ -105,6 +105,13 @@
 // Returns the last modified date for a given line.
 - (NSDate *)timestampForLine:(int)y;
 
+// Changes whenever the content of the line changes.
+- (NSInteger)generationForLine:(int)y;
+
+// A copy of the lines of history and the screen that include |range| which may be read on another
+// thread. Its line 0 corresponds to absolute line number totalScrollbackOverflow + *linesBeforePtr.
+- (LineBuffer *)newSnapshotOfLinesInRange:(NSRange)range linesBefore:(out int *)linesBeforePtr;
+
 - (void)addNote:(PTYNoteViewController *)note inRange:(VT100GridCoordRange)range;
 - (void)removeInaccessibleNotes;
 
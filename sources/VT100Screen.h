@@ -125,6 +125,13 @@ extern const NSInteger VT100ScreenBigFileDownloadThreshold;
 // Sets the alt grid's contents. |lines| is NSData with screen_char_t's.
 - (void)setAltScreen:(NSArray *)lines;
 
+// Returns a copy of the part of the scrollback history and the used lines of the current grid
+// that contains |range|, where line 0 is the first line of history. It owns all of its line
+// blocks, so it may be read and released on another thread. Its line 0 is line *linesBeforePtr
+// of history, which is absolute line number totalScrollbackOverflow + *linesBeforePtr. An empty
+// range gives an empty buffer.
+- (LineBuffer *)newSnapshotOfLinesInRange:(NSRange)range linesBefore:(out int *)linesBeforePtr;
+
 // Load state from tmux. The |state| dictionary has keys from the kStateDictXxx values.
 - (void)setTmuxState:(NSDictionary *)state;
 
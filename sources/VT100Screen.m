@@ -1764,6 +1764,31 @@ basedAtAbsoluteLineNumber:(long long)absoluteLineNumber
     return [linebuffer_ numLinesWithWidth:currentGrid_.size.width] + currentGrid_.size.height;
 }
 
+- (LineBuffer *)newSnapshotOfLinesInRange:(NSRange)range linesBefore:(out int *)linesBeforePtr {
+    if (range.length == 0) {
+        // Nothing to copy, as when a reader has already reached the end.
+        *linesBeforePtr = (int)range.location;
+        return [[LineBuffer alloc] init];
+    }
+    const int width = currentGrid_.size.width;
+    const int numberOfHistoryLines = [linebuffer_ numLinesWithWidth:width];
+    const BOOL includesScreen = NSMaxRange(range) > numberOfHistoryLines;
+    NSRange historyRange = NSIntersectionRange(range, NSMakeRange(0, numberOfHistoryLines));
+    if (includesScreen && numberOfHistoryLines > 0) {
+        // The screen's lines are appended after the last line of history, which might be
+        // continued by the screen's first line.
+        const NSUInteger location = MIN(range.location, numberOfHistoryLines - 1);
+        historyRange = NSMakeRange(location, numberOfHistoryLines - location);
+    }
+    LineBuffer *snapshot = [linebuffer_ newSnapshotForConcurrentReadingOfLinesInRange:historyRange
+                                                                                width:width
+                                                                          linesBefore:linesBeforePtr];
+    if (includesScreen) {
+        [currentGrid_ appendLines:[currentGrid_ numberOfLinesUsed] toLineBuffer:snapshot];
+    }
+    return snapshot;
+}
+
 - (int)width {
     return currentGrid_.size.width;
 }
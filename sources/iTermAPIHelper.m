@@ -9,6 +9,7 @@
 
 #import "CVector.h"
 #import "DebugLogging.h"
+#import "iTermAPIModelSnapshot.h"
 #import "iTermAdvancedSettingsModel.h"
 #import "iTermBuriedSessions.h"
 #import "iTermBuiltInFunctions.h"
@@ -647,6 +648,16 @@ static BOOL iTermAPIHelperLastApplescriptAuthRequiredSetting;
                                                    object:nil];
         // End layoutChanged:
 
+        for (NSString *name in @[ NSWindowDidMoveNotification,
+                                  NSWindowDidResizeNotification,
+                                  NSWindowDidEnterFullScreenNotification,
+                                  NSWindowDidExitFullScreenNotification ]) {
+            [[NSNotificationCenter defaultCenter] addObserver:self
+                                                     selector:@selector(windowGeometryDidChange:)
+                                                         name:name
+                                                       object:nil];
+        }
+
         [[NSNotificationCenter defaultCenter] addObserver:self
                                                  selector:@selector(didCreateTerminalWindow:)
                                                      name:iTermDidCreateTerminalWindowNotification
@@ -790,7 +801,12 @@ static BOOL iTermAPIHelperLastApplescriptAuthRequiredSetting;
     }];
 }
 
+- (void)windowGeometryDidChange:(NSNotification *)notification {
+    [_apiServer modelDidChange];
+}
+
 - (void)layoutChanged:(NSNotification *)notification {
+    [_apiServer modelDidChange];
     if (!_layoutChanged) {
         _layoutChanged = YES;
         __weak __typeof(self) weakSelf = self;
@@ -1465,6 +1481,18 @@ static BOOL iTermAPIHelperLastApplescriptAuthRequiredSetting;
     }
 }
 
+- (void)apiServerGetScrollback:(ITMGetScrollbackRequest *)request
+                       handler:(void (^)(ITMGetScrollbackResponse *))handler {
+    PTYSession *session = [self sessionForAPIIdentifier:request.session includeBuriedSessions:YES];
+    if (!session) {
+        ITMGetScrollbackResponse *response = [[ITMGetScrollbackResponse alloc] init];
+        response.status = ITMGetScrollbackResponse_Status_SessionNotFound;
+        handler(response);
+    } else {
+        [session handleGetScrollbackRequest:request completion:handler];
+    }
+}
+
 - (void)apiServerGetPrompt:(ITMGetPromptRequest *)request
                    handler:(void (^)(ITMGetPromptResponse *))handler {
     PTYSession *session = [self sessionForAPIIdentifier:request.session includeBuriedSessions:YES];
@@ -2156,6 +2184,39 @@ static BOOL iTermAPIHelperLastApplescriptAuthRequiredSetting;
     handler([self newListSessionsResponse]);
 }
 
+- (iTermAPIModelSnapshot *)apiServerModelSnapshotWithGeneration:(NSInteger)generation {
+    NSArray<NSString *> *windowPropertyNames = @[ @"frame", @"fullscreen" ];
+    // number_of_lines is left out because it changes with every line of output.
+    NSArray<NSString *> *sessionPropertyNames = @[ @"grid_size", @"buried" ];
+
+    NSMutableDictionary<NSString *, NSDictionary<NSString *, NSString *> *> *windowProperties = [NSMutableDictionary dictionary];
+    NSMutableDictionary<NSString *, NSDictionary<NSString *, NSString *> *> *sessionProperties = [NSMutableDictionary dictionary];
+    void (^addSession)(PTYSession *) = ^(PTYSession *session) {
+        NSMutableDictionary<NSString *, NSString *> *properties = [NSMutableDictionary dictionary];
+        for (NSString *name in sessionPropertyNames) {
+            properties[name] = [self getPropertyFromSession:session name:name];
+        }
+        sessionProperties[session.guid] = properties;
+    };
+    for (PseudoTerminal *term in [[iTermController sharedInstance] terminals]) {
+        NSMutableDictionary<NSString *, NSString *> *properties = [NSMutableDictionary dictionary];
+        for (NSString *name in windowPropertyNames) {
+            properties[name] = [self getPropertyFromWindow:term name:name];
+        }
+        windowProperties[term.terminalGuid] = properties;
+        for (PTYSession *session in term.allSessions) {
+            addSession(session);
+        }
+    }
+    for (PTYSession *session in [[iTermBuriedSessions sharedInstance] buriedSessions]) {
+        addSession(session);
+    }
+    return [[iTermAPIModelSnapshot alloc] initWithGeneration:generation
+                                        listSessionsResponse:[self newListSessionsResponse]
+                                            windowProperties:windowProperties
+                                           sessionProperties:sessionProperties];
+}
+
 - (ITMListSessionsResponse *)newListSessionsResponse {
     ITMListSessionsResponse *response = [[ITMListSessionsResponse alloc] init];
     for (PseudoTerminal *window in [[iTermController sharedInstance] terminals]) {
@@ -0,0 +1,43 @@
+//
+//  iTermAPIModelSnapshot.h
+//  iTerm2SharedARC
+//
+//  Created by George Nachman on 10/18/26.
+//
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+@class ITMClientOriginatedMessage;
+@class ITMListSessionsResponse;
+@class ITMServerOriginatedMessage;
+
+// Returns YES if handling |request| can't change the state of the app.
+BOOL iTermAPIRequestIsReadOnly(ITMClientOriginatedMessage *request);
+
+// An immutable copy of the parts of the window/tab/session model that read-only RPCs ask for
+// most often. It's built on the main thread and then used to answer requests on any thread
+// without waiting for the main thread.
+@interface iTermAPIModelSnapshot : NSObject
+
+// The value of the API server's model generation when this was built.
+@property (nonatomic, readonly) NSInteger generation;
+
+// When this was built, in seconds since boot.
+@property (nonatomic, readonly) NSTimeInterval timestamp;
+
+// windowProperties and sessionProperties map an identifier to a dictionary from property name
+// to JSON value, as GetProperty would return it.
+- (instancetype)initWithGeneration:(NSInteger)generation
+              listSessionsResponse:(ITMListSessionsResponse *)listSessionsResponse
+                  windowProperties:(NSDictionary<NSString *, NSDictionary<NSString *, NSString *> *> *)windowProperties
+                 sessionProperties:(NSDictionary<NSString *, NSDictionary<NSString *, NSString *> *> *)sessionProperties NS_DESIGNATED_INITIALIZER;
+- (instancetype)init NS_UNAVAILABLE;
+
+// Returns nil if the snapshot doesn't have what's needed to answer |request|. Thread-safe.
+- (nullable ITMServerOriginatedMessage *)responseForRequest:(ITMClientOriginatedMessage *)request;
+
+@end
+
+NS_ASSUME_NONNULL_END
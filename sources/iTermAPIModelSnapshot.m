@@ -0,0 +1,109 @@
+//
+//  iTermAPIModelSnapshot.m
+//  iTerm2SharedARC
+//
+//  Created by George Nachman on 10/18/26.
+//
+
+#import "iTermAPIModelSnapshot.h"
+
+#import "Api.pbobjc.h"
+#import "DebugLogging.h"
+#import "NSDate+iTerm.h"
+
+BOOL iTermAPIRequestIsReadOnly(ITMClientOriginatedMessage *request) {
+    switch (request.submessageOneOfCase) {
+        case ITMClientOriginatedMessage_Submessage_OneOfCase_GetBufferRequest:
+        case ITMClientOriginatedMessage_Submessage_OneOfCase_GetScrollbackRequest:
+        case ITMClientOriginatedMessage_Submessage_OneOfCase_GetPromptRequest:
+        case ITMClientOriginatedMessage_Submessage_OneOfCase_ListPromptsRequest:
+        case ITMClientOriginatedMessage_Submessage_OneOfCase_GetProfilePropertyRequest:
+        case ITMClientOriginatedMessage_Submessage_OneOfCase_ListSessionsRequest:
+        case ITMClientOriginatedMessage_Submessage_OneOfCase_GetPropertyRequest:
+        case ITMClientOriginatedMessage_Submessage_OneOfCase_ListProfilesRequest:
+        case ITMClientOriginatedMessage_Submessage_OneOfCase_GetBroadcastDomainsRequest:
+            return YES;
+
+        default:
+            // Requests like VariableRequest and SelectionRequest can both get and set. They're
+            // treated as mutating to be safe.
+            return NO;
+    }
+}
+
+@implementation iTermAPIModelSnapshot {
+    ITMListSessionsResponse *_listSessionsResponse;
+    NSDictionary<NSString *, NSDictionary<NSString *, NSString *> *> *_windowProperties;
+    NSDictionary<NSString *, NSDictionary<NSString *, NSString *> *> *_sessionProperties;
+}
+
+- (instancetype)initWithGeneration:(NSInteger)generation
+              listSessionsResponse:(ITMListSessionsResponse *)listSessionsResponse
+                  windowProperties:(NSDictionary<NSString *, NSDictionary<NSString *, NSString *> *> *)windowProperties
+                 sessionProperties:(NSDictionary<NSString *, NSDictionary<NSString *, NSString *> *> *)sessionProperties {
+    self = [super init];
+    if (self) {
+        _generation = generation;
+        _timestamp = [NSDate it_timeSinceBoot];
+        _listSessionsResponse = [listSessionsResponse copy];
+        _windowProperties = [windowProperties copy];
+        _sessionProperties = [sessionProperties copy];
+    }
+    return self;
+}
+
+- (ITMServerOriginatedMessage *)responseForRequest:(ITMClientOriginatedMessage *)request {
+    switch (request.submessageOneOfCase) {
+        case ITMClientOriginatedMessage_Submessage_OneOfCase_ListSessionsRequest: {
+            ITMServerOriginatedMessage *response = [self newResponseForRequest:request];
+            // Messages are mutable so give each response its own copy.
+            response.listSessionsResponse = [_listSessionsResponse copy];
+            return response;
+        }
+
+        case ITMClientOriginatedMessage_Submessage_OneOfCase_GetPropertyRequest:
+            return [self responseForGetPropertyRequest:request];
+
+        default:
+            return nil;
+    }
+}
+
+#pragma mark - Private
+
+- (ITMServerOriginatedMessage *)newResponseForRequest:(ITMClientOriginatedMessage *)request {
+    ITMServerOriginatedMessage *response = [[ITMServerOriginatedMessage alloc] init];
+    response.id_p = request.id_p;
+    return response;
+}
+
+- (ITMServerOriginatedMessage *)responseForGetPropertyRequest:(ITMClientOriginatedMessage *)request {
+    ITMGetPropertyRequest *getPropertyRequest = request.getPropertyRequest;
+    NSDictionary<NSString *, NSString *> *properties = nil;
+    switch (getPropertyRequest.identifierOneOfCase) {
+        case ITMGetPropertyRequest_Identifier_OneOfCase_WindowId:
+            properties = _windowProperties[getPropertyRequest.windowId];
+            break;
+
+        case ITMGetPropertyRequest_Identifier_OneOfCase_SessionId:
+            properties = _sessionProperties[getPropertyRequest.sessionId];
+            break;
+
+        case ITMGetPropertyRequest_Identifier_OneOfCase_GPBUnsetOneOfCase:
+            break;
+    }
+    // A missing target or property might be one the snapshot doesn't know about (e.g., a session
+    // created since it was built, or a property that changes too often to snapshot) so let the
+    // main thread produce the error.
+    NSString *jsonValue = properties[getPropertyRequest.name];
+    if (!jsonValue) {
+        return nil;
+    }
+    DLog(@"Answer %@ from snapshot with generation %@", getPropertyRequest.name, @(_generation));
+    ITMServerOriginatedMessage *response = [self newResponseForRequest:request];
+    response.getPropertyResponse.status = ITMGetPropertyResponse_Status_Ok;
+    response.getPropertyResponse.jsonValue = jsonValue;
+    return response;
+}
+
+@end
@@ -16,6 +16,8 @@ extern NSString *const iTermAPIServerConnectionRejected;
 extern NSString *const iTermAPIServerConnectionAccepted;
 extern NSString *const iTermAPIServerConnectionClosed;
 
+@class iTermAPIModelSnapshot;
+
 @protocol iTermAPIServerDelegate<NSObject>
 - (BOOL)apiServerAuthorizeProcesses:(NSArray<NSNumber *> *)pids
                       preauthorized:(BOOL)preauthorized
@@ -25,6 +27,8 @@ extern NSString *const iTermAPIServerConnectionClosed;
                         displayName:(out NSString **)displayName;
 - (void)apiServerGetBuffer:(ITMGetBufferRequest *)request handler:(void (^)(ITMGetBufferResponse *))handler;
 - (void)apiServerGetPrompt:(ITMGetPromptRequest *)request handler:(void (^)(ITMGetPromptResponse *))handler;
+// The handler may be called on any thread.
+- (void)apiServerGetScrollback:(ITMGetScrollbackRequest *)request handler:(void (^)(ITMGetScrollbackResponse *))handler;
 - (void)apiServerListPrompts:(ITMListPromptsRequest *)request handler:(void (^)(ITMListPromptsResponse *))handler;
 - (void)apiServerNotification:(ITMNotificationRequest *)request
                 connectionKey:(NSString *)connectionKey
@@ -89,6 +93,10 @@ extern NSString *const iTermAPIServerConnectionClosed;
                       handler:(void (^)(ITMCloseResponse *))response;
 - (void)apiServerInvokeFunctionRequest:(ITMInvokeFunctionRequest *)request
                                handler:(void (^)(ITMInvokeFunctionResponse *))response;
+
+// Called on the main thread. Returns an immutable copy of the model that read-only requests can
+// be answered from without waiting for the main thread.
+- (iTermAPIModelSnapshot *)apiServerModelSnapshotWithGeneration:(NSInteger)generation;
 @end
 
 @interface iTermAPIServer : NSObject
@@ -101,6 +109,10 @@ extern NSString *const iTermAPIServerConnectionClosed;
 - (void)postAPINotification:(ITMNotification *)notification toConnectionKey:(NSString *)connectionKey;
 - (NSString *)websocketKeyForConnectionKey:(NSString *)connectionKey;
 
+// Call on the main thread when something that a model snapshot contains may have changed.
+// Read-only requests wait for the main thread until a new snapshot is built.
+- (void)modelDidChange;
+
 - (void)stop;
 
 @end
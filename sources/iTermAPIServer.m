@@ -10,6 +10,7 @@
 
 #import "Api.pbobjc.h"
 #import "DebugLogging.h"
+#import "iTermAPIModelSnapshot.h"
 #import "iTermAdvancedSettingsModel.h"
 #import "iTermHTTPConnection.h"
 #import "iTermLSOF.h"
@@ -18,12 +19,14 @@
 #import "iTermSocket.h"
 #import "iTermSocketAddress.h"
 #import "NSArray+iTerm.h"
+#import "NSDate+iTerm.h"
 #import "NSFileManager+iTerm.h"
 #import "NSObject+iTerm.h"
 
 #import <objc/runtime.h>
 #include <sys/types.h>
 #include <sys/stat.h>
+#import <stdatomic.h>
 
 #import <Cocoa/Cocoa.h>
 
@@ -33,6 +36,14 @@ NSString *const iTermAPIServerConnectionRejected = @"iTermAPIServerConnectionRej
 NSString *const iTermAPIServerConnectionAccepted = @"iTermAPIServerConnectionAccepted";
 NSString *const iTermAPIServerConnectionClosed = @"iTermAPIServerConnectionClosed";
 
+// Read-only requests kick off a rebuild of the model snapshot when it's older than this, so it
+// stays fresh while a script is polling.
+static const NSTimeInterval iTermAPIServerModelSnapshotRefreshAge = 0.05;
+
+// Not everything in a snapshot posts a notification when it changes (e.g., session titles), so
+// don't use a snapshot older than this unless the main thread is blocked in a transaction.
+static const NSTimeInterval iTermAPIServerModelSnapshotMaximumAge = 0.25;
+
 // State shared between main thread and execution thread for a
 // mainthread-blocking iTerm2-to-script RPC.
 @interface iTermBlockingRPC : NSObject
@@ -126,6 +137,7 @@ NSString *const iTermAPIServerConnectionClosed = @"iTermAPIServerConnectionClose
 @property (atomic) iTermAPITransaction *transaction;
 @property (nonatomic, strong) dispatch_queue_t queue;
 @property (atomic, strong) iTermBlockingRPC *blockingRPC;  // _executionQueue
+@property (atomic, strong) iTermAPIModelSnapshot *modelSnapshot;
 @end
 
 @implementation iTermAPIServer {
@@ -133,6 +145,14 @@ NSString *const iTermAPIServerConnectionClosed = @"iTermAPIServerConnectionClose
     NSMutableDictionary<id, iTermWebSocketConnection *> *_connections;  // _queue
     dispatch_queue_t _executionQueue;
     NSMutableArray<iTermHTTPConnection *> *_pendingConnections;  // _queue
+    // Incremented whenever the model may have changed. A snapshot with an older generation is
+    // never used.
+    _Atomic NSInteger _modelGeneration;
+    // Mutating requests that have arrived but whose main-thread handler hasn't finished. While
+    // nonzero, snapshots are neither published nor used: one built now would hold the state from
+    // before those requests yet carry a generation that looks current.
+    _Atomic NSInteger _pendingMutations;
+    _Atomic int _modelSnapshotRebuildScheduled;
 }
 
 + (instancetype)sharedInstance {
@@ -212,8 +232,13 @@ NSString *const iTermAPIServerConnectionClosed = @"iTermAPIServerConnectionClose
     });
 }
 
+- (void)modelDidChange {
+    atomic_fetch_add(&_modelGeneration, 1);
+}
+
 - (void)stop {
     self.delegate = nil;
+    self.modelSnapshot = nil;
     [_unixSocket close];
     _unixSocket = nil;
     dispatch_sync(_queue, ^{
@@ -434,6 +459,7 @@ NSString *const iTermAPIServerConnectionClosed = @"iTermAPIServerConnectionClose
                 response.transactionResponse = [[ITMTransactionResponse alloc] init];
                 response.transactionResponse.status = ITMTransactionResponse_Status_NoTransaction;
                 [weakSelf sendResponse:response onConnection:webSocketConnection];
+                [weakSelf didFinishRequest:request];
             });
             return;
         }
@@ -450,6 +476,7 @@ NSString *const iTermAPIServerConnectionClosed = @"iTermAPIServerConnectionClose
                 response.transactionResponse.status = ITMTransactionResponse_Status_Ok;
                 [weakSelf sendResponse:response onConnection:webSocketConnection];
             });
+            [weakSelf didFinishRequest:request];
             [weakSelf drainTransaction:transaction];
         });
     } else {
@@ -481,6 +508,7 @@ NSString *const iTermAPIServerConnectionClosed = @"iTermAPIServerConnectionClose
             dispatch_async(_queue, ^{
                 [self sendResponse:response onConnection:transactionRequest.connection];
             });
+            [self didFinishRequest:transactionRequest.request];
             break;
         }
 
@@ -495,6 +523,8 @@ NSString *const iTermAPIServerConnectionClosed = @"iTermAPIServerConnectionClose
         while (apiRequest) {
             if (apiRequest.connection) {
                 [self enqueueOrDispatchRequest:apiRequest.request onConnection:apiRequest.connection];
+            } else {
+                [self didFinishRequest:apiRequest.request];
             }
             apiRequest = [transaction dequeueRequestFromAnyConnection:YES];
         }
@@ -537,6 +567,16 @@ NSString *const iTermAPIServerConnectionClosed = @"iTermAPIServerConnectionClose
                           }];
 }
 
+- (void)handleGetScrollbackRequest:(ITMClientOriginatedMessage *)request connection:(iTermWebSocketConnection *)webSocketConnection {
+    ITMServerOriginatedMessage *response = [self newResponseForRequest:request];
+
+    __weak __typeof(self) weakSelf = self;
+    [_delegate apiServerGetScrollback:request.getScrollbackRequest handler:^(ITMGetScrollbackResponse *getScrollbackResponse) {
+        response.getScrollbackResponse = getScrollbackResponse;
+        [weakSelf finishHandlingRequestWithResponse:response onConnection:webSocketConnection];
+    }];
+}
+
 - (void)handleGetPromptRequest:(ITMClientOriginatedMessage *)request connection:(iTermWebSocketConnection *)webSocketConnection {
     ITMServerOriginatedMessage *response = [self newResponseForRequest:request];
 
@@ -1003,6 +1043,7 @@ NSString *const iTermAPIServerConnectionClosed = @"iTermAPIServerConnectionClose
                                                       userInfo:@{ @"request": request }];
     if (!_delegate) {
         [self handleUnhandleableRequest:request connection:webSocketConnection];
+        [self didFinishRequest:request];
         return;
     }
 
@@ -1018,6 +1059,10 @@ NSString *const iTermAPIServerConnectionClosed = @"iTermAPIServerConnectionClose
             [self handleGetBufferRequest:request connection:webSocketConnection];
             break;
 
+        case ITMClientOriginatedMessage_Submessage_OneOfCase_GetScrollbackRequest:
+            [self handleGetScrollbackRequest:request connection:webSocketConnection];
+            break;
+
         case ITMClientOriginatedMessage_Submessage_OneOfCase_GetPromptRequest:
             [self handleGetPromptRequest:request connection:webSocketConnection];
             break;
@@ -1151,6 +1196,19 @@ NSString *const iTermAPIServerConnectionClosed = @"iTermAPIServerConnectionClose
             break;
     }
     _currentKey = nil;
+    [self didFinishRequest:request];
+}
+
+// Any queue. Call once for every request that reached the execution queue, after its main-thread
+// handler (if any) has run.
+- (void)didFinishRequest:(ITMClientOriginatedMessage *)request {
+    if (!request || iTermAPIRequestIsReadOnly(request)) {
+        return;
+    }
+    // Bump the generation before the count drops so a snapshot can't be published with the
+    // generation of a model this request hadn't yet changed.
+    atomic_fetch_add(&_modelGeneration, 1);
+    atomic_fetch_sub(&_pendingMutations, 1);
 }
 
 // Runs on execution queue.
@@ -1174,12 +1232,81 @@ NSString *const iTermAPIServerConnectionClosed = @"iTermAPIServerConnectionClose
     }
 
     if ([self tryHandleResponse:request toBlockingRPC:self.blockingRPC connection:webSocketConnection]) {
+        [self didFinishRequest:request];
         return;
     }
 
     [self dispatchRequestWhileNotInTransaction:request connection:webSocketConnection];
 }
 
+#pragma mark - Model Snapshots
+
+// _queue. Answers requests the snapshot covers before they reach the execution queue, so they
+// don't wait behind requests that are slow to run. Only ListSessions and GetProperty are covered;
+// other read-only requests need the live model and take the main-thread path. Returns YES if a
+// response was sent.
+- (BOOL)tryAnswerFromModelSnapshot:(ITMClientOriginatedMessage *)request
+                        connection:(iTermWebSocketConnection *)webSocketConnection {
+    if (self.transaction.connection == webSocketConnection) {
+        // Keep requests within a transaction in order.
+        return NO;
+    }
+    if (atomic_load(&_pendingMutations) > 0) {
+        // Wait for earlier writes to be handled.
+        return NO;
+    }
+    iTermAPIModelSnapshot *snapshot = self.modelSnapshot;
+    const NSTimeInterval age = snapshot ? [NSDate it_timeSinceBoot] - snapshot.timestamp : INFINITY;
+    if (age > iTermAPIServerModelSnapshotRefreshAge) {
+        [self scheduleModelSnapshotRebuild];
+    }
+    if (!snapshot || snapshot.generation != atomic_load(&_modelGeneration)) {
+        return NO;
+    }
+    // While the main thread is blocked in a transaction nothing can change except by the
+    // transaction's own requests, which bump the generation.
+    if (age > iTermAPIServerModelSnapshotMaximumAge && !self.transaction) {
+        return NO;
+    }
+    ITMServerOriginatedMessage *response = [snapshot responseForRequest:request];
+    if (!response) {
+        return NO;
+    }
+    DLog(@"Answered %@ from model snapshot", request);
+    dispatch_async(dispatch_get_main_queue(), ^{
+        [[NSNotificationCenter defaultCenter] postNotificationName:iTermAPIServerDidReceiveMessage
+                                                            object:webSocketConnection.key
+                                                          userInfo:@{ @"request": request }];
+    });
+    [self finishHandlingRequestWithResponse:response onConnection:webSocketConnection];
+    return YES;
+}
+
+// Any queue
+- (void)scheduleModelSnapshotRebuild {
+    int expected = 0;
+    if (!atomic_compare_exchange_strong(&_modelSnapshotRebuildScheduled, &expected, 1)) {
+        return;
+    }
+    __weak __typeof(self) weakSelf = self;
+    dispatch_async(dispatch_get_main_queue(), ^{
+        [weakSelf rebuildModelSnapshot];
+    });
+}
+
+// Main queue
+- (void)rebuildModelSnapshot {
+    atomic_store(&_modelSnapshotRebuildScheduled, 0);
+    // Read the generation first so that a change made while building makes the result stale. A
+    // mutation that arrives after this still bumps it, since it's counted before it bumps.
+    const NSInteger generation = atomic_load(&_modelGeneration);
+    if (atomic_load(&_pendingMutations) > 0) {
+        // The model doesn't reflect requests that have already arrived.
+        return;
+    }
+    self.modelSnapshot = [_delegate apiServerModelSnapshotWithGeneration:generation];
+}
+
 #pragma mark - iTermWebSocketConnectionDelegate
 
 // _queue
@@ -1209,10 +1336,19 @@ NSString *const iTermAPIServerConnectionClosed = @"iTermAPIServerConnectionClose
         DLog(@"Dispatch %@", request);
         if (request) {
             DLog(@"Received request: %@", request);
-            __weak __typeof(self) weakSelf = self;
-            dispatch_async(_executionQueue, ^{
-                [weakSelf enqueueOrDispatchRequest:request onConnection:webSocketConnection];
-            });
+            const BOOL readOnly = iTermAPIRequestIsReadOnly(request);
+            if (!readOnly) {
+                // Mutating requests stay ordered on the main thread. Count it here, in arrival
+                // order, so that reads that arrive after this one wait for it to finish.
+                atomic_fetch_add(&_pendingMutations, 1);
+                atomic_fetch_add(&_modelGeneration, 1);
+            }
+            if (!readOnly || ![self tryAnswerFromModelSnapshot:request connection:webSocketConnection]) {
+                __weak __typeof(self) weakSelf = self;
+                dispatch_async(_executionQueue, ^{
+                    [weakSelf enqueueOrDispatchRequest:request onConnection:webSocketConnection];
+                });
+            }
         }
     }
     DLog(@"Got a frame: %@", frame);
@@ -64,6 +64,9 @@ extern NSString *const iTermAdvancedSettingsDidChange;
 + (int)badgeTopMargin;
 + (double)bellRateLimit;
 + (BOOL)bootstrapDaemon;
++ (BOOL)cacheAttributedStrings;
++ (BOOL)cacheMetalRows;
++ (BOOL)cacheURLActions;
 + (BOOL)clearBellIconAggressively;
 + (BOOL)cmdClickWhenInactiveInvokesSemanticHistory;
 + (double)coloredSelectedTabOutlineStrength;
@@ -71,6 +74,7 @@ extern NSString *const iTermAdvancedSettingsDidChange;
 + (double)compactEdgeDragSize;
 + (double)compactMinimalTabBarHeight;
 + (NSString *)composerClearSequence;
++ (BOOL)compressRestorableScrollback;
 + (BOOL)conservativeURLGuessing;
 + (BOOL)convertItalicsToReverseVideoForTmux;
 + (BOOL)convertTabDragToWindowDragForSolitaryTabInCompactOrMinimalTheme;
@@ -78,6 +82,7 @@ extern NSString *const iTermAdvancedSettingsDidChange;
 + (BOOL)copyWithStylesByDefault;
 + (CGFloat)customTabBarFontSize;
 + (BOOL)darkThemeHasBlackTitlebar;
++ (BOOL)decodeRestorableStateConcurrently;
 + (CGFloat)defaultTabBarHeight;
 + (int)defaultTabStopWidth;
 + (NSString *)defaultURLScheme;
@@ -224,12 +229,14 @@ extern NSString *const iTermAdvancedSettingsDidChange;
 + (NSString *)pathToFTP;
 + (NSString *)pathToTelnet;
 + (BOOL)performDictionaryLookupOnQuickLook;
++ (BOOL)persistGlyphBitmaps;
 + (BOOL)pinEditSession;
 + (BOOL)pinchToChangeFontSizeDisabled;
 + (double)pointSizeOfTimeStamp;
 + (BOOL)preferSpeedToFullLigatureSupport;
 + (NSString *)preferredBaseDir;
 + (const BOOL *)preventEscapeSequenceFromClearingHistory;
++ (BOOL)reduceRefreshForBulkOutput;
 + (BOOL)saveScrollBufferWhenClearing;
 + (void)setPreventEscapeSequenceFromClearingHistory:(const BOOL *)value;
 + (const BOOL *)preventEscapeSequenceFromChangingProfile;
@@ -261,6 +268,8 @@ extern NSString *const iTermAdvancedSettingsDidChange;
 + (BOOL)serializeOpeningMultipleFullScreenWindows;
 + (BOOL)setCookie;
 + (void)setSetCookie:(BOOL)value;
++ (BOOL)shareGlyphBitmaps;
++ (BOOL)shellHistoryUsesAppendOnlyLog;
 + (double)shortLivedSessionDuration;
 + (BOOL)shouldSetLCTerminal;
 + (BOOL)showAutomaticProfileSwitchingBanner;
@@ -294,6 +303,7 @@ extern NSString *const iTermAdvancedSettingsDidChange;
 + (BOOL)statusBarIcon;
 + (BOOL)stealKeyFocus;
 + (BOOL)storeStateInSqlite;
++ (int)streamingCopyMinimumLines;
 + (BOOL)supportDecsetMetaSendsEscape;
 + (BOOL)supportREPCode;
 + (BOOL)suppressMultilinePasteWarningWhenNotAtShellPrompt;
@@ -330,6 +340,7 @@ extern NSString *const iTermAdvancedSettingsDidChange;
 + (BOOL)underlineHyperlinks;
 + (double)updateScreenParamsDelay;
 + (BOOL)useCustomTabBarFontSize;
++ (BOOL)useFrameScheduler;
 + (BOOL)useRestorableStateController;
 + (BOOL)useShortcutAccessoryViewController;
 + (NSString *)URLCharacterSet;
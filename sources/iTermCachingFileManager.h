@@ -13,6 +13,12 @@ NS_ASSUME_NONNULL_BEGIN
 
 + (instancetype)cachingFileManager;
 
+// Checks whether files exist on a background queue so later calls to -fileExistsAtPath: for them
+// are answered from the cache. Paths that are cached already, have a prefix in `pathsToIgnore`, or
+// are on network volumes are skipped.
+- (void)prefetchExistenceOfPaths:(NSArray<NSString *> *)paths
+                   pathsToIgnore:(NSArray<NSString *> *)pathsToIgnore;
+
 @end
 
 NS_ASSUME_NONNULL_END
@@ -7,7 +7,10 @@
 
 #import "iTermCachingFileManager.h"
 
+#import "DebugLogging.h"
+#import "NSArray+iTerm.h"
 #import "NSDate+iTerm.h"
+#import "NSFileManager+iTerm.h"
 
 @interface iTermCachingFileManagerEntry : NSObject
 @property (nonatomic) BOOL exists;
@@ -36,6 +39,7 @@
 
 @implementation iTermCachingFileManager {
     NSCache<NSString *, iTermCachingFileManagerEntry *> *_cache;
+    dispatch_queue_t _prefetchQueue;
 }
 
 + (instancetype)cachingFileManager {
@@ -52,6 +56,7 @@
     if (self) {
         _cache = [[NSCache alloc] init];
         _cache.countLimit = 1000;
+        _prefetchQueue = dispatch_queue_create("com.iterm2.caching-file-manager-prefetch", DISPATCH_QUEUE_SERIAL);
     }
     return self;
 }
@@ -70,4 +75,23 @@
     return exists;
 }
 
+- (void)prefetchExistenceOfPaths:(NSArray<NSString *> *)paths
+                   pathsToIgnore:(NSArray<NSString *> *)pathsToIgnore {
+    NSArray<NSString *> *uncached = [paths filteredArrayUsingBlock:^BOOL(NSString *path) {
+        return ![self->_cache objectForKey:path].isValid;
+    }];
+    if (uncached.count == 0) {
+        return;
+    }
+    DLog(@"Prefetch existence of %@ paths", @(uncached.count));
+    dispatch_async(_prefetchQueue, ^{
+        for (NSString *path in uncached) {
+            if (![self fileIsLocal:path additionalNetworkPaths:pathsToIgnore]) {
+                continue;
+            }
+            [self fileExistsAtPath:path];
+        }
+    });
+}
+
 @end
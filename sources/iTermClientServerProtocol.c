@@ -191,7 +191,8 @@ static void iTermClientServerProtocolEncoderEnsureSpace(iTermClientServerProtoco
     if (freeSpace >= additionalSpace) {
         return;
     }
-    iTermClientServerProtocolMessageEnsureSpace(encoder->message, additionalSpace - freeSpace);
+    // iTermClientServerProtocolMessageEnsureSpace takes the total size, not the increment.
+    iTermClientServerProtocolMessageEnsureSpace(encoder->message, encoder->offset + additionalSpace);
 }
 
 static void iTermClientServerProtocolEncoderCopyAndAdvance(iTermClientServerProtocolMessageEncoder *encoder,
@@ -13,7 +13,8 @@ extern const int ITERM_MULTISERVER_MAGIC;
 typedef struct {
     int valid;
     struct msghdr message;
-    iTermFileDescriptorControlMessage controlBuffer;
+    // Large enough to receive a launch batch's file descriptors.
+    iTermFileDescriptorMultiControlMessage controlBuffer;
 
     // "real" storage that message iovectors may choose to use.
     struct iovec ioVectors[1];
@@ -13,17 +13,24 @@
 @implementation iTermClientServerProtocolMessageBox {
     iTermClientServerProtocolMessage _protocolMessage;
     BOOL _haveDecodedMessage;
+    // Parsing a bad message closes its file descriptors, so it must not be parsed again.
+    BOOL _decodingFailed;
     iTermMultiServerServerOriginatedMessage _decodedMessage;
 }
 
 + (instancetype)withMessage:(iTermMultiServerMessage *)message {
     iTermClientServerProtocolMessageBox *box = [[iTermClientServerProtocolMessageBox alloc] init];
     iTermClientServerProtocolMessageInitialize(&box->_protocolMessage);
-    if (message.fileDescriptor) {
-        box->_protocolMessage.controlBuffer.cm.cmsg_len = CMSG_LEN(sizeof(int));
+    NSArray<NSNumber *> *fileDescriptors = message.fileDescriptors;
+    if (fileDescriptors.count > 0) {
+        assert(fileDescriptors.count <= ITERM_MULTISERVER_MAX_FILE_DESCRIPTORS_PER_MESSAGE);
+        box->_protocolMessage.controlBuffer.cm.cmsg_len = CMSG_LEN(sizeof(int) * fileDescriptors.count);
         box->_protocolMessage.controlBuffer.cm.cmsg_level = SOL_SOCKET;
         box->_protocolMessage.controlBuffer.cm.cmsg_type = SCM_RIGHTS;
-        *((int *)CMSG_DATA(&box->_protocolMessage.controlBuffer.cm)) = message.fileDescriptor.intValue;
+        int *fds = (int *)CMSG_DATA(&box->_protocolMessage.controlBuffer.cm);
+        [fileDescriptors enumerateObjectsUsingBlock:^(NSNumber * _Nonnull fd, NSUInteger i, BOOL * _Nonnull stop) {
+            fds[i] = fd.intValue;
+        }];
     }
     iTermClientServerProtocolMessageEnsureSpace(&box->_protocolMessage, message.data.length);
     memmove(box->_protocolMessage.message.msg_iov[0].iov_base, message.data.bytes, message.data.length);
@@ -35,9 +42,13 @@
     if (_haveDecodedMessage) {
         return &_decodedMessage;
     }
+    if (_decodingFailed) {
+        return nil;
+    }
     const int status = iTermMultiServerProtocolParseMessageFromServer(&_protocolMessage, &_decodedMessage);
     if (status) {
         DLog(@"Failed to decode message from server with status %d", status);
+        _decodingFailed = YES;
         return nil;
     }
     _haveDecodedMessage = YES;
@@ -47,6 +58,10 @@
 }
 
 - (void)dealloc {
+    if (_haveDecodedMessage) {
+        // Handlers consume the decoded message synchronously, so its strings and arrays can go.
+        iTermMultiServerServerOriginatedMessageFree(&_decodedMessage);
+    }
     iTermClientServerProtocolMessageFree(&_protocolMessage);
 }
 
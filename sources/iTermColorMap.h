@@ -53,6 +53,16 @@ extern const int kColorMap24bitBase;
 
 @class iTermColorMap;
 
+// Everything -fastProcessedBackgroundColorForBackgroundColor: depends on besides its argument, so
+// many colors can be processed without a message send per color.
+typedef struct {
+    vector_float4 defaultBackgroundColor;
+    float mutingAmount;
+    float dimmingAmount;
+    float backgroundBrightness;
+    BOOL dimOnlyText;
+} iTermBackgroundColorProcessingParameters;
+
 @protocol iTermColorMapDelegate <NSObject>
 
 - (void)colorMap:(iTermColorMap *)colorMap didChangeColorForKey:(iTermColorMapKey)theKey;
@@ -75,6 +85,10 @@ extern const int kColorMap24bitBase;
 @property(nonatomic, assign) double mutingAmount;
 @property(nonatomic, assign) id<iTermColorMapDelegate> delegate;
 @property(nonatomic, assign) double minimumContrast;
+// Changes whenever a color or a setting that affects processed colors changes. Copies share their
+// original's generation until one of them is modified. Generations are never reused, even across
+// color maps.
+@property(nonatomic, readonly) NSUInteger generation;
 
 + (iTermColorMapKey)keyFor8bitRed:(int)red
                             green:(int)green
@@ -95,6 +109,7 @@ extern const int kColorMap24bitBase;
                      disableMinimumContrast:(BOOL)disableMinimumContrast;
 - (NSColor *)processedBackgroundColorForBackgroundColor:(NSColor *)color;
 - (vector_float4)fastProcessedBackgroundColorForBackgroundColor:(vector_float4)backgroundColor;
+- (iTermBackgroundColorProcessingParameters)backgroundColorProcessingParameters;
 - (NSColor *)colorByMutingColor:(NSColor *)color;
 - (vector_float4)fastColorByMutingColor:(vector_float4)color;
 - (NSColor *)colorByDimmingTextColor:(NSColor *)color;
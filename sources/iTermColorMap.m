@@ -40,6 +40,9 @@ const int kColorMapAnsiBrightModifier = 8;
 @property(nonatomic, retain) NSMutableDictionary *map;
 @end
 
+// Main thread only, like all changes to color maps.
+static NSUInteger iTermColorMapNextGeneration = 1;
+
 @implementation iTermColorMap {
     double _backgroundBrightness;
     CGFloat _backgroundRed;
@@ -69,6 +72,7 @@ const int kColorMapAnsiBrightModifier = 8;
     if (self) {
         _map = [[NSMutableDictionary alloc] init];
         _fastMap = [[NSMutableDictionary alloc] init];
+        _generation = iTermColorMapNextGeneration++;
     }
     return self;
 }
@@ -83,11 +87,13 @@ const int kColorMapAnsiBrightModifier = 8;
 
 - (void)setDimmingAmount:(double)dimmingAmount {
     _dimmingAmount = dimmingAmount;
+    _generation = iTermColorMapNextGeneration++;
     [_delegate colorMap:self dimmingAmountDidChangeTo:dimmingAmount];
 }
 
 - (void)setMutingAmount:(double)mutingAmount {
     _mutingAmount = mutingAmount;
+    _generation = iTermColorMapNextGeneration++;
     [_delegate colorMap:self mutingAmountDidChangeTo:mutingAmount];
 }
 
@@ -98,12 +104,15 @@ const int kColorMapAnsiBrightModifier = 8;
     if (!theColor) {
         [_map removeObjectForKey:@(theKey)];
         [_fastMap removeObjectForKey:@(theKey)];
+        _generation = iTermColorMapNextGeneration++;
         return;
     }
 
     if (theColor == _map[@(theKey)])
         return;
 
+    _generation = iTermColorMapNextGeneration++;
+
     CGFloat components[4];
     [theColor getComponents:components];
     if (theKey == kColorMapBackground) {
@@ -166,8 +175,14 @@ const int kColorMapAnsiBrightModifier = 8;
     }
 }
 
+- (void)setMinimumContrast:(double)minimumContrast {
+    _minimumContrast = minimumContrast;
+    _generation = iTermColorMapNextGeneration++;
+}
+
 - (void)setDimOnlyText:(BOOL)dimOnlyText {
     _dimOnlyText = dimOnlyText;
+    _generation = iTermColorMapNextGeneration++;
     [_delegate colorMap:self dimmingAmountDidChangeTo:_dimmingAmount];
 }
 
@@ -376,6 +391,17 @@ const int kColorMapAnsiBrightModifier = 8;
     return dimmedRgb;
 }
 
+- (iTermBackgroundColorProcessingParameters)backgroundColorProcessingParameters {
+    iTermBackgroundColorProcessingParameters parameters = {
+        .defaultBackgroundColor = [self fastColorForKey:kColorMapBackground],
+        .mutingAmount = _mutingAmount,
+        .dimmingAmount = _dimmingAmount,
+        .backgroundBrightness = _backgroundBrightness,
+        .dimOnlyText = _dimOnlyText
+    };
+    return parameters;
+}
+
 // There is an issue where where the passed-in color can be in a different color space than the
 // default background color. It doesn't make sense to combine RGB values from different color
 // spaces. The effects are generally subtle.
@@ -518,6 +544,8 @@ const int kColorMapAnsiBrightModifier = 8;
 
     other->_minimumContrast = _minimumContrast;
 
+    other->_generation = _generation;
+
     other->_delegate = _delegate;
 
     [other->_map release];
@@ -9,11 +9,12 @@
 #import <Cocoa/Cocoa.h>
 
 #import "iTermCommandHistoryEntryMO.h"
+#import "iTermCommandHistoryIndex.h"
 
 @class VT100RemoteHost;
 @class VT100ScreenMark;
 
-@interface iTermCommandHistoryEntryMO (Additions)
+@interface iTermCommandHistoryEntryMO (Additions)<iTermCommandHistoryIndexable>
 
 @property(nonatomic, readonly) VT100ScreenMark *lastMark;
 
@@ -0,0 +1,46 @@
+//
+//  iTermCommandHistoryIndex.h
+//  iTerm2
+//
+//  Created by George Nachman on 10/18/26.
+//
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+@protocol iTermCommandHistoryIndexable<NSObject>
+@property(nullable, nonatomic, readonly) NSString *command;
+@property(nullable, nonatomic, readonly) NSNumber *numberOfUses;
+@property(nullable, nonatomic, readonly) NSNumber *timeOfLastUse;
+@end
+
+// Finds one host's commands by case-insensitive prefix without looking at all of them. Commands
+// are kept sorted by their case-folded text, so the ones with a given prefix are a run that binary
+// search finds. They are also kept in order of rank (most uses first, then most recently used), so
+// when a prefix matches a large share of the history the best matches are found by walking the
+// ranking rather than by sorting every match.
+//
+// The number of uses and time of last use are copied when an entry is added. Call -updateEntry:
+// after changing them.
+@interface iTermCommandHistoryIndex : NSObject
+
+@property(nonatomic, readonly) NSUInteger count;
+
+- (instancetype)initWithEntries:(id<NSFastEnumeration>)entries NS_DESIGNATED_INITIALIZER;
+- (instancetype)init NS_UNAVAILABLE;
+
+// Adds an entry, or re-ranks it if it's already present. Its command must not have changed.
+- (void)updateEntry:(id<iTermCommandHistoryIndexable>)entry;
+
+// Returns the entry whose command is exactly |command|, compared case-sensitively.
+- (nullable id<iTermCommandHistoryIndexable>)entryWithCommand:(NSString *)command;
+
+// Returns up to |maximumCount| entries whose commands begin with |prefix| ignoring case, best
+// ranked first.
+- (NSArray<id<iTermCommandHistoryIndexable>> *)entriesWithPrefix:(NSString *)prefix
+                                                    maximumCount:(NSUInteger)maximumCount;
+
+@end
+
+NS_ASSUME_NONNULL_END
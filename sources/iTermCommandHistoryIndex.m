@@ -0,0 +1,242 @@
+//
+//  iTermCommandHistoryIndex.m
+//  iTerm2
+//
+//  Created by George Nachman on 10/18/26.
+//
+
+#import "iTermCommandHistoryIndex.h"
+
+#include <math.h>
+
+@interface iTermCommandHistoryIndexRecord : NSObject {
+@public
+    // Case-folded command.
+    NSString *_key;
+    NSString *_command;
+    id<iTermCommandHistoryIndexable> _entry;
+    NSInteger _uses;
+    NSTimeInterval _lastUse;
+}
+@end
+
+@implementation iTermCommandHistoryIndexRecord
+
+- (void)dealloc {
+    [_key release];
+    [_command release];
+    [_entry release];
+    [super dealloc];
+}
+
+@end
+
+static NSString *iTermCommandHistoryIndexKey(NSString *command) {
+    return [command stringByFoldingWithOptions:NSCaseInsensitiveSearch locale:nil];
+}
+
+// -[NSString hasPrefix:] is false for an empty prefix.
+static BOOL iTermCommandHistoryIndexKeyHasPrefix(NSString *key, NSString *prefix) {
+    return prefix.length == 0 || [key hasPrefix:prefix];
+}
+
+// Orders by key, then by command so commands that differ only in case have a stable order.
+static NSComparisonResult iTermCommandHistoryIndexCompareKeys(iTermCommandHistoryIndexRecord *lhs,
+                                                              iTermCommandHistoryIndexRecord *rhs) {
+    const NSComparisonResult result = [lhs->_key compare:rhs->_key options:NSLiteralSearch];
+    if (result != NSOrderedSame) {
+        return result;
+    }
+    return [lhs->_command compare:rhs->_command options:NSLiteralSearch];
+}
+
+// Best first. Same order as -[iTermCommandHistoryEntryMO compare:] for prefix matches, with ties
+// broken by command so each record has exactly one place.
+static NSComparisonResult iTermCommandHistoryIndexCompareRanks(iTermCommandHistoryIndexRecord *lhs,
+                                                               iTermCommandHistoryIndexRecord *rhs) {
+    if (lhs->_uses != rhs->_uses) {
+        return lhs->_uses > rhs->_uses ? NSOrderedAscending : NSOrderedDescending;
+    }
+    if (lhs->_lastUse != rhs->_lastUse) {
+        return lhs->_lastUse > rhs->_lastUse ? NSOrderedAscending : NSOrderedDescending;
+    }
+    return iTermCommandHistoryIndexCompareKeys(lhs, rhs);
+}
+
+@implementation iTermCommandHistoryIndex {
+    // Sorted by iTermCommandHistoryIndexCompareKeys.
+    NSMutableArray<iTermCommandHistoryIndexRecord *> *_byKey;
+    // Sorted by iTermCommandHistoryIndexCompareRanks.
+    NSMutableArray<iTermCommandHistoryIndexRecord *> *_byRank;
+    NSMapTable<id<iTermCommandHistoryIndexable>, iTermCommandHistoryIndexRecord *> *_records;
+}
+
+- (instancetype)initWithEntries:(id<NSFastEnumeration>)entries {
+    self = [super init];
+    if (self) {
+        _byKey = [[NSMutableArray alloc] init];
+        _records = [[NSMapTable alloc] initWithKeyOptions:(NSPointerFunctionsStrongMemory |
+                                                           NSPointerFunctionsObjectPointerPersonality)
+                                             valueOptions:NSPointerFunctionsStrongMemory
+                                                 capacity:0];
+        for (id<iTermCommandHistoryIndexable> entry in entries) {
+            if (!entry.command || [_records objectForKey:entry]) {
+                continue;
+            }
+            iTermCommandHistoryIndexRecord *record = [self newRecordForEntry:entry];
+            [_byKey addObject:record];
+            [_records setObject:record forKey:entry];
+            [record release];
+        }
+        [_byKey sortUsingComparator:^NSComparisonResult(id lhs, id rhs) {
+            return iTermCommandHistoryIndexCompareKeys(lhs, rhs);
+        }];
+        _byRank = [_byKey mutableCopy];
+        [_byRank sortUsingComparator:^NSComparisonResult(id lhs, id rhs) {
+            return iTermCommandHistoryIndexCompareRanks(lhs, rhs);
+        }];
+    }
+    return self;
+}
+
+- (void)dealloc {
+    [_byKey release];
+    [_byRank release];
+    [_records release];
+    [super dealloc];
+}
+
+- (NSUInteger)count {
+    return _byKey.count;
+}
+
+- (void)updateEntry:(id<iTermCommandHistoryIndexable>)entry {
+    if (!entry.command) {
+        return;
+    }
+    iTermCommandHistoryIndexRecord *record = [_records objectForKey:entry];
+    if (record) {
+        [_byRank removeObjectAtIndex:[self indexOfRecord:record inRanking:NO]];
+        record->_uses = entry.numberOfUses.integerValue;
+        record->_lastUse = entry.timeOfLastUse.doubleValue;
+    } else {
+        record = [[self newRecordForEntry:entry] autorelease];
+        [_records setObject:record forKey:entry];
+        [_byKey insertObject:record
+                     atIndex:[_byKey indexOfObject:record
+                                     inSortedRange:NSMakeRange(0, _byKey.count)
+                                           options:NSBinarySearchingInsertionIndex
+                                   usingComparator:^NSComparisonResult(id lhs, id rhs) {
+            return iTermCommandHistoryIndexCompareKeys(lhs, rhs);
+        }]];
+    }
+    [_byRank insertObject:record atIndex:[self indexOfRecord:record inRanking:YES]];
+}
+
+- (id<iTermCommandHistoryIndexable>)entryWithCommand:(NSString *)command {
+    NSString *key = iTermCommandHistoryIndexKey(command);
+    for (NSUInteger i = [self indexOfFirstRecordWithKeyAtLeast:key]; i < _byKey.count; i++) {
+        iTermCommandHistoryIndexRecord *record = _byKey[i];
+        if (![record->_key isEqualToString:key]) {
+            break;
+        }
+        if ([record->_command isEqualToString:command]) {
+            return record->_entry;
+        }
+    }
+    return nil;
+}
+
+- (NSArray<id<iTermCommandHistoryIndexable>> *)entriesWithPrefix:(NSString *)prefix
+                                                    maximumCount:(NSUInteger)maximumCount {
+    NSString *key = iTermCommandHistoryIndexKey(prefix ?: @"");
+    const NSUInteger first = [self indexOfFirstRecordWithKeyAtLeast:key];
+    const NSUInteger end = [self indexOfFirstRecordAtOrAfter:first withoutPrefix:key];
+    const NSUInteger numberOfMatches = end - first;
+    if (numberOfMatches == 0 || maximumCount == 0) {
+        return @[];
+    }
+
+    NSMutableArray<id<iTermCommandHistoryIndexable>> *result = [NSMutableArray array];
+    // Walking the ranking visits about count / numberOfMatches records per match found. Sorting
+    // the matches costs about log2(numberOfMatches) per match. Do whichever is cheaper.
+    const double costToWalk = (double)_byRank.count * MIN(maximumCount, numberOfMatches) / numberOfMatches;
+    const double costToSort = numberOfMatches * log2(numberOfMatches + 1);
+    if (costToWalk < costToSort) {
+        for (iTermCommandHistoryIndexRecord *record in _byRank) {
+            if (iTermCommandHistoryIndexKeyHasPrefix(record->_key, key)) {
+                [result addObject:record->_entry];
+                if (result.count == maximumCount) {
+                    break;
+                }
+            }
+        }
+        return result;
+    }
+
+    NSArray<iTermCommandHistoryIndexRecord *> *matches =
+        [[_byKey subarrayWithRange:NSMakeRange(first, numberOfMatches)]
+            sortedArrayUsingComparator:^NSComparisonResult(id lhs, id rhs) {
+                return iTermCommandHistoryIndexCompareRanks(lhs, rhs);
+            }];
+    for (NSUInteger i = 0; i < MIN(maximumCount, matches.count); i++) {
+        [result addObject:matches[i]->_entry];
+    }
+    return result;
+}
+
+#pragma mark - Private
+
+- (iTermCommandHistoryIndexRecord *)newRecordForEntry:(id<iTermCommandHistoryIndexable>)entry {
+    iTermCommandHistoryIndexRecord *record = [[iTermCommandHistoryIndexRecord alloc] init];
+    record->_command = [entry.command copy];
+    record->_key = [iTermCommandHistoryIndexKey(record->_command) retain];
+    record->_entry = [entry retain];
+    record->_uses = entry.numberOfUses.integerValue;
+    record->_lastUse = entry.timeOfLastUse.doubleValue;
+    return record;
+}
+
+// With |insertion| set, returns where |record| belongs in _byRank. Otherwise returns where it is.
+- (NSUInteger)indexOfRecord:(iTermCommandHistoryIndexRecord *)record inRanking:(BOOL)insertion {
+    const NSUInteger index =
+        [_byRank indexOfObject:record
+                 inSortedRange:NSMakeRange(0, _byRank.count)
+                       options:insertion ? NSBinarySearchingInsertionIndex : NSBinarySearchingFirstEqual
+               usingComparator:^NSComparisonResult(id lhs, id rhs) {
+            return iTermCommandHistoryIndexCompareRanks(lhs, rhs);
+        }];
+    assert(index != NSNotFound);
+    return index;
+}
+
+- (NSUInteger)indexOfFirstRecordWithKeyAtLeast:(NSString *)key {
+    NSUInteger lo = 0;
+    NSUInteger hi = _byKey.count;
+    while (lo < hi) {
+        const NSUInteger mid = lo + (hi - lo) / 2;
+        if ([_byKey[mid]->_key compare:key options:NSLiteralSearch] == NSOrderedAscending) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    return lo;
+}
+
+// Records from |start| that begin with |prefix| are contiguous since _byKey is sorted.
+- (NSUInteger)indexOfFirstRecordAtOrAfter:(NSUInteger)start withoutPrefix:(NSString *)prefix {
+    NSUInteger lo = start;
+    NSUInteger hi = _byKey.count;
+    while (lo < hi) {
+        const NSUInteger mid = lo + (hi - lo) / 2;
+        if (iTermCommandHistoryIndexKeyHasPrefix(_byKey[mid]->_key, prefix)) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    return lo;
+}
+
+@end
@@ -0,0 +1,68 @@
+//
+//  iTermCompiledExpression.h
+//  iTerm2SharedARC
+//
+//  Created by George Nachman on 10/18/26.
+//
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+@class iTermParsedExpression;
+@class iTermVariableScope;
+
+typedef NS_ENUM(NSUInteger, iTermCompiledExpressionMode) {
+    // Parsed with +[iTermExpressionParser expressionParser], like session.name or "foo \(x)".
+    iTermCompiledExpressionModeExpression,
+    // Parsed as an interpolated string, like \(user)@\(hostname).
+    iTermCompiledExpressionModeInterpolatedString
+};
+
+// The parser resolves variables while it builds the AST, so a parsed expression is only good for
+// the scope and the values it was parsed with. A compiled expression is parsed once with
+// placeholders for variables, which makes it independent of scope and safe to share among all
+// sessions. Expressions made only of literals and variable references (which is most titles,
+// badges, and trigger parameters) are further reduced to a flat program that looks up values and
+// concatenates them without going through the parser or building an iTermParsedExpression.
+//
+// Should be used only on the main thread, like the parser.
+@interface iTermCompiledExpression : NSObject
+
+@property (nonatomic, readonly) NSString *string;
+@property (nonatomic, readonly) iTermCompiledExpressionMode mode;
+
+// The AST with placeholders in place of variable references.
+@property (nonatomic, readonly) iTermParsedExpression *parsedExpression;
+
+// If NO, use -parsedExpressionWithScope:strict: and evaluate that instead.
+@property (nonatomic, readonly) BOOL isCompiled;
+
+@property (nonatomic, readonly) BOOL containsFunctionCall;
+
+// Instrumentation for the process-wide cache.
+@property (class, nonatomic, readonly) NSUInteger numberOfCacheHits;
+@property (class, nonatomic, readonly) NSUInteger numberOfCacheMisses;
+@property (class, nonatomic, readonly) double cacheHitRate;
+
+// Returns a shared instance from the process-wide cache, parsing it on a miss.
++ (instancetype)compiledExpressionWithString:(NSString *)string
+                                        mode:(iTermCompiledExpressionMode)mode;
+
+- (instancetype)init NS_UNAVAILABLE;
+
+// Parses with variables resolved in |scope|. This is what the parser would have returned.
+- (iTermParsedExpression *)parsedExpressionWithScope:(iTermVariableScope *)scope
+                                              strict:(BOOL)strict;
+
+// Runs the program. Only valid if isCompiled. Gives the same value or error that evaluating
+// -parsedExpressionWithScope:strict: would. |escapingFunction| is applied to the same parts
+// iTermExpressionEvaluator would apply it to.
+- (nullable id)valueWithScope:(iTermVariableScope *)scope
+                       strict:(BOOL)strict
+             escapingFunction:(nullable NSString *(^)(NSString *string))escapingFunction
+                        error:(out NSError * _Nullable * _Nullable)error;
+
+@end
+
+NS_ASSUME_NONNULL_END
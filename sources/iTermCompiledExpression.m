@@ -0,0 +1,316 @@
+//
+//  iTermCompiledExpression.m
+//  iTerm2SharedARC
+//
+//  Created by George Nachman on 10/18/26.
+//
+
+#import "iTermCompiledExpression.h"
+
+#import "DebugLogging.h"
+#import "iTermAdvancedSettingsModel.h"
+#import "iTermCache.h"
+#import "iTermExpressionEvaluator.h"
+#import "iTermExpressionParser.h"
+#import "iTermParsedExpression.h"
+#import "iTermVariableScope.h"
+#import "NSObject+iTerm.h"
+
+typedef NS_ENUM(uint8_t, iTermCompiledExpressionOpcode) {
+    // Produces the operand.
+    iTermCompiledExpressionOpcodeLiteral,
+    // Produces the value of the variable whose path is the operand.
+    iTermCompiledExpressionOpcodeVariable,
+    // Produces the index'th element of the array whose path is the operand.
+    iTermCompiledExpressionOpcodeArrayElement
+};
+
+typedef struct {
+    iTermCompiledExpressionOpcode opcode;
+    BOOL optional;
+    NSInteger index;
+    // Retained by _constants.
+    __unsafe_unretained id operand;
+} iTermCompiledExpressionInstruction;
+
+static const NSInteger iTermCompiledExpressionCacheCapacity = 1024;
+static NSUInteger gNumberOfCacheHits;
+static NSUInteger gNumberOfCacheMisses;
+
+static NSError *iTermCompiledExpressionError(NSInteger code, NSString *reason) {
+    // Same as -[iTermParsedExpression initWithErrorCode:reason:].
+    return [NSError errorWithDomain:@"com.iterm2.parser"
+                               code:code
+                           userInfo:@{ NSLocalizedDescriptionKey: reason }];
+}
+
+// Mirrors -[iTermExpressionParser pathOrDereferencedArrayFromPath:index:] and
+// -parsedExpressionWithValue:errorReason:path:optional:.
+static id iTermCompiledExpressionExecute(const iTermCompiledExpressionInstruction *instruction,
+                                         iTermVariableScope *scope,
+                                         NSError **error) {
+    NSString *path = instruction->operand;
+    id value;
+    switch (instruction->opcode) {
+        case iTermCompiledExpressionOpcodeLiteral:
+            return instruction->operand;
+
+        case iTermCompiledExpressionOpcodeVariable:
+            value = [scope valueForVariableName:path];
+            break;
+
+        case iTermCompiledExpressionOpcodeArrayElement: {
+            id untypedValue = [scope valueForVariableName:path];
+            if (!untypedValue) {
+                value = nil;
+                break;
+            }
+            NSArray *array = [NSArray castFrom:untypedValue];
+            if (!array) {
+                NSString *reason = [NSString stringWithFormat:@"Variable “%@” is of type %@, not array", path, NSStringFromClass([untypedValue class])];
+                *error = iTermCompiledExpressionError(3, reason);
+                return nil;
+            }
+            const NSInteger index = instruction->index;
+            if (index < 0 || index >= array.count) {
+                NSString *reason = [NSString stringWithFormat:@"Index %@ out of range of “%@”, which %@ values", @(index), path, @(array.count)];
+                *error = iTermCompiledExpressionError(3, reason);
+                return nil;
+            }
+            value = array[index];
+            break;
+        }
+    }
+
+    if (!value && instruction->optional) {
+        return nil;
+    }
+    if ([value isKindOfClass:[NSString class]] ||
+        [value isKindOfClass:[NSNumber class]] ||
+        [value isKindOfClass:[NSArray class]]) {
+        return value;
+    }
+    NSString *reason;
+    if (instruction->optional) {
+        reason = [NSString stringWithFormat:@"Invalid type: %@", [value class]];
+    } else {
+        reason = [NSString stringWithFormat:@"Reference to undefined variable “%@”. Change it to “%@?” to treat the undefined value as null.", path, path];
+    }
+    *error = iTermCompiledExpressionError(7, reason);
+    return nil;
+}
+
+@implementation iTermCompiledExpression {
+    iTermCompiledExpressionInstruction *_instructions;
+    NSInteger _count;
+    NSMutableArray *_constants;
+
+    // Interpolated strings join the string values of their parts. Otherwise there is a single
+    // instruction whose value is the result.
+    BOOL _concatenates;
+}
+
++ (iTermCache<NSString *, iTermCompiledExpression *> *)cacheForMode:(iTermCompiledExpressionMode)mode {
+    static iTermCache *expressionCache;
+    static iTermCache *interpolatedStringCache;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        expressionCache = [[iTermCache alloc] initWithCapacity:iTermCompiledExpressionCacheCapacity];
+        interpolatedStringCache = [[iTermCache alloc] initWithCapacity:iTermCompiledExpressionCacheCapacity];
+    });
+    switch (mode) {
+        case iTermCompiledExpressionModeExpression:
+            return expressionCache;
+        case iTermCompiledExpressionModeInterpolatedString:
+            return interpolatedStringCache;
+    }
+    assert(NO);
+    return nil;
+}
+
++ (instancetype)compiledExpressionWithString:(NSString *)string
+                                        mode:(iTermCompiledExpressionMode)mode {
+    iTermCache<NSString *, iTermCompiledExpression *> *cache = [self cacheForMode:mode];
+    iTermCompiledExpression *compiledExpression = cache[string];
+    if (compiledExpression) {
+        gNumberOfCacheHits++;
+        return compiledExpression;
+    }
+    gNumberOfCacheMisses++;
+    compiledExpression = [[self alloc] initWithString:string mode:mode];
+    cache[string] = compiledExpression;
+    DLog(@"Compiled %@ compiled=%@. Cache hit rate is %@",
+         string, @(compiledExpression.isCompiled), @(self.cacheHitRate));
+    return compiledExpression;
+}
+
++ (NSUInteger)numberOfCacheHits {
+    return gNumberOfCacheHits;
+}
+
++ (NSUInteger)numberOfCacheMisses {
+    return gNumberOfCacheMisses;
+}
+
++ (double)cacheHitRate {
+    const NSUInteger total = gNumberOfCacheHits + gNumberOfCacheMisses;
+    if (total == 0) {
+        return 0;
+    }
+    return (double)gNumberOfCacheHits / (double)total;
+}
+
+- (instancetype)initWithString:(NSString *)string mode:(iTermCompiledExpressionMode)mode {
+    self = [super init];
+    if (self) {
+        _string = [string copy];
+        _mode = mode;
+        _parsedExpression = [self parsedExpressionWithScope:[[iTermVariablePlaceholderScope alloc] init]
+                                                     strict:YES];
+        _containsFunctionCall = [_parsedExpression containsAnyFunctionCall];
+        _isCompiled = [self compile];
+    }
+    return self;
+}
+
+- (void)dealloc {
+    free(_instructions);
+}
+
+- (NSString *)description {
+    return [NSString stringWithFormat:@"<%@: %p string=%@ mode=%@ instructions=%@>",
+            NSStringFromClass(self.class), self, _string, @(_mode), @(_count)];
+}
+
+#pragma mark - Parsing
+
+- (iTermParsedExpression *)parsedExpressionWithScope:(iTermVariableScope *)scope
+                                              strict:(BOOL)strict {
+    switch (_mode) {
+        case iTermCompiledExpressionModeExpression:
+            return [[iTermExpressionParser expressionParser] parse:_string scope:scope];
+        case iTermCompiledExpressionModeInterpolatedString:
+            return [iTermExpressionParser parsedExpressionWithInterpolatedString:_string
+                                                                escapingFunction:nil
+                                                                           scope:scope
+                                                                          strict:strict];
+    }
+    assert(NO);
+    return nil;
+}
+
+#pragma mark - Compilation
+
+- (BOOL)compile {
+    NSArray<iTermParsedExpression *> *parts;
+    if (_parsedExpression.expressionType == iTermParsedExpressionTypeInterpolatedString) {
+        parts = _parsedExpression.interpolatedStringParts;
+        _concatenates = YES;
+    } else {
+        parts = @[ _parsedExpression ];
+        _concatenates = (_mode == iTermCompiledExpressionModeInterpolatedString);
+    }
+    _constants = [NSMutableArray array];
+    _instructions = calloc(MAX(1, parts.count), sizeof(*_instructions));
+    for (iTermParsedExpression *part in parts) {
+        if (![self appendInstructionForExpression:part]) {
+            free(_instructions);
+            _instructions = NULL;
+            _count = 0;
+            _constants = nil;
+            return NO;
+        }
+    }
+    return YES;
+}
+
+- (BOOL)appendInstructionForExpression:(iTermParsedExpression *)expression {
+    iTermCompiledExpressionInstruction instruction = { 0 };
+    id operand = nil;
+    switch (expression.expressionType) {
+        case iTermParsedExpressionTypeString:
+        case iTermParsedExpressionTypeNumber:
+        case iTermParsedExpressionTypeNil:
+            instruction.opcode = iTermCompiledExpressionOpcodeLiteral;
+            operand = expression.object;
+            break;
+
+        case iTermParsedExpressionTypeVariableReference:
+            instruction.opcode = iTermCompiledExpressionOpcodeVariable;
+            instruction.optional = expression.optional;
+            operand = expression.placeholder.path;
+            break;
+
+        case iTermParsedExpressionTypeArrayLookup: {
+            iTermExpressionParserArrayDereferencePlaceholder *placeholder = (id)expression.placeholder;
+            instruction.opcode = iTermCompiledExpressionOpcodeArrayElement;
+            instruction.optional = expression.optional;
+            instruction.index = placeholder.index;
+            operand = placeholder.path;
+            break;
+        }
+
+        case iTermParsedExpressionTypeFunctionCall:
+        case iTermParsedExpressionTypeInterpolatedString:
+        case iTermParsedExpressionTypeArrayOfExpressions:
+        case iTermParsedExpressionTypeArrayOfValues:
+        case iTermParsedExpressionTypeError:
+            return NO;
+    }
+    if (operand) {
+        [_constants addObject:operand];
+    }
+    instruction.operand = operand;
+    _instructions[_count++] = instruction;
+    return YES;
+}
+
+#pragma mark - Evaluation
+
+- (id)valueWithScope:(iTermVariableScope *)scope
+              strict:(BOOL)strict
+    escapingFunction:(NSString *(^)(NSString *))escapingFunction
+               error:(out NSError **)errorOut {
+    assert(_isCompiled);
+    NSError *error = nil;
+    if (!_concatenates) {
+        id value = iTermCompiledExpressionExecute(&_instructions[0], scope, &error);
+        if (errorOut) {
+            *errorOut = error;
+        }
+        return value;
+    }
+
+    // See +[iTermExpressionParser parsedExpressionWithInterpolatedString:escapingFunction:scope:strict:]
+    // and -[iTermExpressionEvaluator evaluateInterpolatedStringParts:invocation:withTimeout:completion:].
+    const BOOL lax = !strict && [iTermAdvancedSettingsModel laxNilPolicyInInterpolatedStrings];
+    NSMutableString *result = [NSMutableString string];
+    for (NSInteger i = 0; i < _count; i++) {
+        const iTermCompiledExpressionInstruction *instruction = &_instructions[i];
+        id value = iTermCompiledExpressionExecute(instruction, scope, &error);
+        if (error) {
+            if (lax) {
+                // Only variable references fail, and they become empty strings.
+                error = nil;
+                continue;
+            }
+            if (errorOut) {
+                *errorOut = error;
+            }
+            return nil;
+        }
+        if ([value isKindOfClass:[NSString class]]) {
+            // The parser turns these into string literals, which are not escaped.
+            [result appendString:value];
+            continue;
+        }
+        NSString *string = [iTermExpressionEvaluator stringFromJSONObject:value];
+        if (escapingFunction) {
+            string = escapingFunction(string);
+        }
+        [result appendString:string];
+    }
+    return result;
+}
+
+@end
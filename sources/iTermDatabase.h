@@ -22,6 +22,8 @@ NS_ASSUME_NONNULL_BEGIN
 
 @protocol iTermDatabase<NSObject>
 - (BOOL)executeUpdate:(NSString*)sql, ...;
+// Statements are cached, so repeating the same SQL text reuses its prepared statement.
+- (BOOL)executeUpdate:(NSString *)sql withArguments:(NSArray *)arguments;
 - (NSNumber * _Nullable)lastInsertRowId;
 - (id<iTermDatabaseResultSet> _Nullable)executeQuery:(NSString*)sql, ...;
 - (BOOL)open;
@@ -89,6 +89,14 @@
     return result;
 }
 
+- (BOOL)executeUpdate:(NSString *)sql withArguments:(NSArray *)arguments {
+    const BOOL result = [_db executeUpdate:sql withArgumentsInArray:arguments];
+    if (gDebugLogging) {
+        DLog(@"%@ with %@ arguments", sql, @(arguments.count));
+    }
+    return result;
+}
+
 - (NSNumber *)lastInsertRowId {
     const int64_t rowid = _db.lastInsertRowId;
     if (!rowid) {
@@ -157,6 +165,7 @@
         DLog(@"Failed to open db: %@", _db.lastError);
         return NO;
     }
+    _db.shouldCacheStatements = YES;
     if (![self passesIntegrityCheck]) {
         [self close];
         return NO;
@@ -18,7 +18,10 @@ NS_ASSUME_NONNULL_BEGIN
 @property (nonatomic, readonly, weak) iTermEncoderGraphRecord *parent;
 @property (nullable, nonatomic, readonly) id propertyListValue;
 @property (nonatomic, strong) NSNumber *rowid;
-@property (nonatomic, readonly) NSData *data;  // encoded pod
+@property (nonatomic, readonly) NSData *data;  // encoded pod. Computing it also sets contentHash.
+// SHA-256 of data. It is remembered so that the next save can tell whether a node changed without
+// encoding this revision again.
+@property (nonatomic, readonly) NSData *contentHash;
 @property (nonatomic, readonly) NSString *compactDescription;
 
 + (instancetype)withPODs:(NSDictionary<NSString *, id> *)pod
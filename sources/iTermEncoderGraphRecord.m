@@ -14,7 +14,9 @@
 #import "NSDictionary+iTerm.h"
 #import "NSObject+iTerm.h"
 
-@implementation iTermEncoderGraphRecord
+@implementation iTermEncoderGraphRecord {
+    NSData *_contentHash;
+}
 
 + (instancetype)withPODs:(NSDictionary<NSString *, id> *)pod
                   graphs:(NSArray<iTermEncoderGraphRecord *> *)graphRecords
@@ -312,6 +314,28 @@
 }
 
 - (NSData *)data {
+    NSData *data = [self encodedPod];
+    @synchronized (self) {
+        if (!_contentHash) {
+            _contentHash = data.it_sha256;
+        }
+    }
+    return data;
+}
+
+- (NSData *)contentHash {
+    @synchronized (self) {
+        if (_contentHash) {
+            return _contentHash;
+        }
+    }
+    [self data];
+    @synchronized (self) {
+        return _contentHash;
+    }
+}
+
+- (NSData *)encodedPod {
     if (self.pod.count == 0) {
         return [NSData data];
     }
@@ -43,6 +43,9 @@ NS_ASSUME_NONNULL_BEGIN
 - (void)evaluateWithTimeout:(NSTimeInterval)timeout
                  completion:(void (^)(iTermExpressionEvaluator *evaluator))completion;
 
+// How values are rendered in interpolated strings.
++ (NSString *)stringFromJSONObject:(nullable id)jsonObject;
+
 @end
 
 NS_ASSUME_NONNULL_END
@@ -9,6 +9,7 @@
 
 #import "DebugLogging.h"
 #import "iTermAPIHelper.h"
+#import "iTermCompiledExpression.h"
 #import "iTermExpressionParser.h"
 #import "iTermScriptFunctionCall+Private.h"
 #import "iTermScriptHistory.h"
@@ -31,6 +32,9 @@
     BOOL _isBeingEvaluated;
     id _value;
     iTermParsedExpression *_parsedExpression;
+    // If set, _parsedExpression has placeholders for variables until it is reparsed with _scope.
+    iTermCompiledExpression *_compiledExpression;
+    BOOL _strict;
     iTermVariableScope *_scope;
     NSMutableArray<iTermExpressionEvaluator *> *_innerEvaluators;
     NSString *_invocation;
@@ -49,35 +53,52 @@
     return self;
 }
 
+- (instancetype)initWithCompiledExpression:(iTermCompiledExpression *)compiledExpression
+                                    strict:(BOOL)strict
+                                     scope:(iTermVariableScope *)scope {
+    if (!compiledExpression.isCompiled) {
+        return [self initWithParsedExpression:[compiledExpression parsedExpressionWithScope:scope strict:strict]
+                                   invocation:compiledExpression.string
+                                        scope:scope];
+    }
+    self = [self initWithParsedExpression:compiledExpression.parsedExpression
+                               invocation:compiledExpression.string
+                                    scope:scope];
+    if (self) {
+        _compiledExpression = compiledExpression;
+        _strict = strict;
+    }
+    return self;
+}
+
 - (instancetype)initWithExpressionString:(NSString *)expressionString
                                    scope:(iTermVariableScope *)scope {
-    iTermParsedExpression *parsedExpression =
-    [[iTermExpressionParser expressionParser] parse:expressionString
-                                                scope:scope];
-    return [self initWithParsedExpression:parsedExpression
-                               invocation:expressionString
-                                    scope:scope];
+    iTermCompiledExpression *compiledExpression =
+    [iTermCompiledExpression compiledExpressionWithString:expressionString
+                                                     mode:iTermCompiledExpressionModeExpression];
+    return [self initWithCompiledExpression:compiledExpression
+                                     strict:NO
+                                      scope:scope];
 }
 
 - (instancetype)initWithStrictInterpolatedString:(NSString *)interpolatedString
                                            scope:(iTermVariableScope *)scope {
-    iTermParsedExpression *parsedExpression =
-    [iTermExpressionParser parsedExpressionWithInterpolatedString:interpolatedString
-                                                 escapingFunction:nil
-                                                            scope:scope
-                                                           strict:YES];
-    return [self initWithParsedExpression:parsedExpression
-                               invocation:interpolatedString
-                                    scope:scope];
+    iTermCompiledExpression *compiledExpression =
+    [iTermCompiledExpression compiledExpressionWithString:interpolatedString
+                                                     mode:iTermCompiledExpressionModeInterpolatedString];
+    return [self initWithCompiledExpression:compiledExpression
+                                     strict:YES
+                                      scope:scope];
 }
 
 - (instancetype)initWithInterpolatedString:(NSString *)interpolatedString
                                      scope:(iTermVariableScope *)scope {
-    iTermParsedExpression *parsedExpression = [iTermExpressionParser parsedExpressionWithInterpolatedString:interpolatedString
-                                                                                                      scope:scope];
-    return [self initWithParsedExpression:parsedExpression
-                               invocation:interpolatedString
-                                    scope:scope];
+    iTermCompiledExpression *compiledExpression =
+    [iTermCompiledExpression compiledExpressionWithString:interpolatedString
+                                                     mode:iTermCompiledExpressionModeInterpolatedString];
+    return [self initWithCompiledExpression:compiledExpression
+                                     strict:NO
+                                      scope:scope];
 }
 
 - (id)value {
@@ -110,6 +131,21 @@ static NSMutableArray *iTermExpressionEvaluatorGlobalStore(void) {
 
     [iTermExpressionEvaluatorGlobalStore() addObject:self];
 
+    if (_compiledExpression) {
+        if (timeout == 0 && !_debug) {
+            // Nothing to wait for, so run the program instead of walking the AST.
+            NSError *error = nil;
+            id result = [_compiledExpression valueWithScope:_scope
+                                                     strict:_strict
+                                           escapingFunction:self.escapingFunction
+                                                      error:&error];
+            [self didCompleteWithResult:result error:error missing:[NSSet set] completion:completion];
+            return;
+        }
+        _parsedExpression = [_compiledExpression parsedExpressionWithScope:_scope strict:_strict];
+        _compiledExpression = nil;
+    }
+
     __weak __typeof(self) weakSelf = self;
     BOOL debug = _debug;
     NSString *descr = [NSString stringWithFormat:@"%@: %@", self, _invocation];
@@ -169,7 +205,7 @@ static NSMutableArray *iTermExpressionEvaluatorGlobalStore(void) {
                 if (evaluator.error) {
                     firstError = evaluator.error;
                 } else {
-                    parts[index] = [self stringFromJSONObject:evaluator.value];
+                    parts[index] = [self.class stringFromJSONObject:evaluator.value];
                 }
                 dispatch_group_leave(group);
             }];
@@ -287,7 +323,7 @@ static NSMutableArray *iTermExpressionEvaluatorGlobalStore(void) {
                 firstError = evaluator.error;
                 [self logError:evaluator.error invocation:invocation];
             } else {
-                NSString *decodedString = [self stringFromJSONObject:evaluator.value];
+                NSString *decodedString = [self.class stringFromJSONObject:evaluator.value];
                 if (self.escapingFunction) {
                     decodedString = self.escapingFunction(decodedString);
                 }
@@ -373,7 +409,7 @@ static NSMutableArray *iTermExpressionEvaluatorGlobalStore(void) {
     }
 }
 
-- (NSString *)stringFromJSONObject:(id)jsonObject {
++ (NSString *)stringFromJSONObject:(id)jsonObject {
     NSString *string = [NSString castFrom:jsonObject];
     if (string) {
         return string;
@@ -385,7 +421,7 @@ static NSMutableArray *iTermExpressionEvaluatorGlobalStore(void) {
     NSArray *array = [NSArray castFrom:jsonObject];
     if (array) {
         return [NSString stringWithFormat:@"[%@]", [[array mapWithBlock:^id(id anObject) {
-            return [self stringFromJSONObject:anObject];
+            return [self.class stringFromJSONObject:anObject];
         }] componentsJoinedByString:@", "]];
     }
 
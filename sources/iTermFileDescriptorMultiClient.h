@@ -37,6 +37,11 @@ typedef NS_ENUM(NSUInteger, iTermFileDescriptorMultiClientErrorCode) {
 - (void)fileDescriptorMultiClient:(iTermFileDescriptorMultiClient *)client
                  didDiscoverChild:(iTermFileDescriptorMultiClientChild *)child;
 
+// Attaching completes before the children are reported. This is called after the last one has
+// been discovered. If the connection fails first, you get -fileDescriptorMultiClientDidClose:
+// instead.
+- (void)fileDescriptorMultiClientDidFinishReportingChildren:(iTermFileDescriptorMultiClient *)client;
+
 - (void)fileDescriptorMultiClient:(iTermFileDescriptorMultiClient *)client
                 childDidTerminate:(iTermFileDescriptorMultiClientChild *)child;
 
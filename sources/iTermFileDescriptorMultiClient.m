@@ -206,8 +206,8 @@ NSString *const iTermFileDescriptorMultiClientErrorDomain = @"iTermFileDescripto
 
         __block BOOL ok = NO;
         [result handleObject:^(iTermClientServerProtocolMessageBox * _Nonnull messageBox) {
-            if (messageBox.message.fileDescriptor) {
-                state.writeFD = messageBox.message.fileDescriptor.intValue;
+            if (messageBox.message.fileDescriptors.count > 0) {
+                state.writeFD = messageBox.message.fileDescriptors.firstObject.intValue;
                 DLog(@"tryAttachWithState(%@): Success", strongSelf->_socketPath);
                 [callback invokeWithObject:@(iTermFileDescriptorMultiClientAttachStatusSuccess)];
                 ok = YES;
@@ -272,15 +272,21 @@ NSString *const iTermFileDescriptorMultiClientErrorDomain = @"iTermFileDescripto
         .type = iTermMultiServerRPCTypeHandshake,
         .payload = {
             .handshake = {
-                .maximumProtocolVersion = iTermMultiServerProtocolVersion2
+                .maximumProtocolVersion = iTermMultiServerProtocolVersion4
             }
         }
     };
     [self send:&message state:state callback:callback];
 }
 
-// Read the handshake response. Read the child reports, calling `block` for
-// each. Run the callback. Then start the read-dispatch loop.
+// Read the handshake response. Run the callback. Read the child reports, calling `block` for
+// each. Then start the read-dispatch loop.
+//
+// The callback runs before the child reports are read so that sessions can attach to children as
+// their reports arrive instead of waiting for all of them. The delegate learns that the reports are
+// complete from -fileDescriptorMultiClientDidFinishReportingChildren:. It is safe to send requests
+// in the meantime because the server reports all the children before reading the next request, so
+// no response can be mixed up with the reports.
 - (void)didSendHandshakeRequestWithSuccess:(BOOL)sendOK
                                      state:(iTermFileDescriptorMultiClientState *)state
                                   callback:(iTermCallback<id, NSNumber *> *)callback
@@ -303,18 +309,18 @@ NSString *const iTermFileDescriptorMultiClientErrorDomain = @"iTermFileDescripto
             return;
         }
         state.serverPID = pid;
+        [callback invokeWithObject:@YES];
         [self readInitialChildReports:numberOfChildren
                                 state:state
                                 block:block
                            completion:^(iTermFileDescriptorMultiClientState *state, BOOL ok) {
             DLog(@"Done reading child reports for %@ with ok=%@", socketPath, @(ok));
             if (!ok) {
-                [callback invokeWithObject:@NO];
+                // The delegate finds out through -fileDescriptorMultiClientDidClose:.
+                [self closeWithState:state];
                 return;
             }
-
-            // Ensure the completion callback runs before the read loop starts producing events.
-            [callback invokeWithObject:@YES];
+            [self.delegate fileDescriptorMultiClientDidFinishReportingChildren:self];
             [self readAndDispatchNextMessageWhenReadyWithState:state];
         }];
     }];
@@ -329,7 +335,7 @@ NSString *const iTermFileDescriptorMultiClientErrorDomain = @"iTermFileDescripto
     NSString *socketPath = _socketPath;
     DLog(@"Read handshake response for %@", socketPath);
     [self readMessageWithState:state
-                      callback:[_thread newCallbackWithBlock:^(id  _Nonnull state,
+                      callback:[_thread newCallbackWithBlock:^(iTermFileDescriptorMultiClientState *_Nonnull state,
                                                                iTermResult<iTermClientServerProtocolMessageBox *> *result) {
         [result handleObject:^(iTermClientServerProtocolMessageBox * _Nonnull boxedMessage) {
             DLog(@"Got a response for %@", socketPath);
@@ -344,10 +350,14 @@ NSString *const iTermFileDescriptorMultiClientErrorDomain = @"iTermFileDescripto
                 return;
             }
             DLog(@"Got a valid handshake response for %@", socketPath);
-            if (boxedMessage.decoded->payload.handshake.protocolVersion != iTermMultiServerProtocolVersion2) {
+            const int protocolVersion = boxedMessage.decoded->payload.handshake.protocolVersion;
+            if (protocolVersion < iTermMultiServerProtocolVersion2 ||
+                protocolVersion > iTermMultiServerProtocolVersion4) {
                 completion(state, NO, 0, -1);
                 return;
             }
+            // Servers from before version 3 don't know about launch batches.
+            state.protocolVersion = protocolVersion;
             completion(state,
                        YES,
                        boxedMessage.decoded->payload.handshake.numChildren,
@@ -362,7 +372,8 @@ NSString *const iTermFileDescriptorMultiClientErrorDomain = @"iTermFileDescripto
 // Read exactly `numberOfChildren` child reports. This happens before the
 // read-dispatch loop begins so it is safe to do a bunch of async read calls.
 // It will call itself recursively until numberOfChildren is 0. Then the
-// completion block will be called.
+// completion block will be called. Servers speaking protocol version 4 send
+// many children per message; older ones send one.
 - (void)readInitialChildReports:(int)numberOfChildren
                           state:(iTermFileDescriptorMultiClientState *)state
                           block:(void (^)(iTermFileDescriptorMultiClientState *state, iTermMultiServerReportChild *))block
@@ -390,19 +401,43 @@ NSString *const iTermFileDescriptorMultiClientErrorDomain = @"iTermFileDescripto
                 completion(state, NO);
                 return;
             }
-            if (box.decoded->type != iTermMultiServerRPCTypeReportChild) {
-                DLog(@"Unexpected message type when reading child reports for %@", socketPath);
-                completion(state, NO);
-                return;
-            }
             iTermMultiServerServerOriginatedMessage *message = box.decoded;
-            block(state, &message->payload.reportChild);
-            const BOOL foundLast = message->payload.reportChild.isLast;
+            BOOL foundLast;
+            int numberReported;
+            switch (message->type) {
+                case iTermMultiServerRPCTypeReportChild:
+                    block(state, &message->payload.reportChild);
+                    foundLast = message->payload.reportChild.isLast;
+                    numberReported = 1;
+                    break;
+
+                case iTermMultiServerRPCTypeReportChildren:
+                    if (message->payload.reportChildren.count > numberOfChildren) {
+                        DLog(@"Got %@ child reports but expected at most %@ for %@",
+                             @(message->payload.reportChildren.count), @(numberOfChildren), socketPath);
+                        for (int i = 0; i < message->payload.reportChildren.count; i++) {
+                            close(message->payload.reportChildren.children[i].fd);
+                        }
+                        completion(state, NO);
+                        return;
+                    }
+                    for (int i = 0; i < message->payload.reportChildren.count; i++) {
+                        block(state, &message->payload.reportChildren.children[i]);
+                    }
+                    foundLast = message->payload.reportChildren.isLast;
+                    numberReported = message->payload.reportChildren.count;
+                    break;
+
+                default:
+                    DLog(@"Unexpected message type when reading child reports for %@", socketPath);
+                    completion(state, NO);
+                    return;
+            }
             if (!foundLast) {
                 assert(numberOfChildren > 0);
                 [strongSelf->_thread dispatchAsync:^(iTermFileDescriptorMultiClientState * _Nullable state) {
                     DLog(@"Want another child report for %@", socketPath);
-                    [strongSelf readInitialChildReports:numberOfChildren - 1
+                    [strongSelf readInitialChildReports:numberOfChildren - numberReported
                                                   state:state
                                                   block:block
                                              completion:completion];
@@ -485,6 +520,11 @@ static unsigned long long MakeUniqueID(void) {
         [[iTermFileDescriptorMultiClientPendingLaunch alloc] initWithRequest:messageCopy.payload.launch
                                                                     callback:callback
                                                                       thread:_thread];
+    if (state.protocolVersion >= iTermMultiServerProtocolVersion3) {
+        [state.queuedLaunchIDs addObject:@(uniqueID)];
+        [self sendQueuedLaunchesWithState:state];
+        return;
+    }
 
     [self send:&message state:state callback:[_thread newCallbackWithBlock:^(iTermFileDescriptorMultiClientState *state,
                                                                              NSNumber *result) {
@@ -504,6 +544,92 @@ static unsigned long long MakeUniqueID(void) {
     }]];
 }
 
+// Rough size of a launch request on the wire, used to keep batches well under the server's
+// maximum message size.
+static size_t EstimatedEncodedSizeOfLaunchRequest(const iTermMultiServerRequestLaunch *launch) {
+    size_t size = 128 + strlen(launch->path) + strlen(launch->pwd);
+    for (int i = 0; i < launch->argc; i++) {
+        size += strlen(launch->argv[i]) + 16;
+    }
+    for (int i = 0; i < launch->envc; i++) {
+        size += strlen(launch->envp[i]) + 16;
+    }
+    return size;
+}
+
+// Only one launch request is in flight at a time. Launches requested while waiting for its
+// response accumulate in queuedLaunchIDs and go out together, so starting many sessions at once
+// (e.g., restoring an arrangement) costs a few round trips and the server forks each batch
+// without waiting on the client in between.
+- (void)sendQueuedLaunchesWithState:(iTermFileDescriptorMultiClientState *)state {
+    if (state.launchInFlight) {
+        DLog(@"Launch in flight. %@ queued launches will wait for %@", @(state.queuedLaunchIDs.count), _socketPath);
+        return;
+    }
+    static const size_t iTermMultiClientMaximumLaunchBatchBytes = 512 * 1024;
+    NSMutableArray<NSNumber *> *uniqueIDs = [NSMutableArray array];
+    iTermMultiServerRequestLaunch launches[iTermMultiServerMaximumLaunchBatchSize];
+    size_t bytes = 0;
+    while (state.queuedLaunchIDs.count > 0 && uniqueIDs.count < iTermMultiServerMaximumLaunchBatchSize) {
+        NSNumber *uniqueID = state.queuedLaunchIDs.firstObject;
+        iTermFileDescriptorMultiClientPendingLaunch *pendingLaunch = state.pendingLaunches[uniqueID];
+        if (!pendingLaunch) {
+            // Canceled while queued.
+            [state.queuedLaunchIDs removeObjectAtIndex:0];
+            continue;
+        }
+        const iTermMultiServerRequestLaunch launch = pendingLaunch.launchRequest;
+        const size_t size = EstimatedEncodedSizeOfLaunchRequest(&launch);
+        if (uniqueIDs.count > 0 && bytes + size > iTermMultiClientMaximumLaunchBatchBytes) {
+            break;
+        }
+        bytes += size;
+        launches[uniqueIDs.count] = launch;
+        [uniqueIDs addObject:uniqueID];
+        [state.queuedLaunchIDs removeObjectAtIndex:0];
+    }
+    if (uniqueIDs.count == 0) {
+        return;
+    }
+
+    iTermMultiServerClientOriginatedMessage message;
+    memset(&message, 0, sizeof(message));
+    if (uniqueIDs.count == 1) {
+        message.type = iTermMultiServerRPCTypeLaunch;
+        message.payload.launch = launches[0];
+    } else {
+        message.type = iTermMultiServerRPCTypeLaunchBatch;
+        message.payload.launchBatch.count = (int)uniqueIDs.count;
+        message.payload.launchBatch.launches = launches;
+    }
+    DLog(@"Send %@ launches to %@", @(uniqueIDs.count), _socketPath);
+    state.launchInFlight = YES;
+    [self send:&message state:state callback:[_thread newCallbackWithBlock:^(iTermFileDescriptorMultiClientState *state,
+                                                                             NSNumber *result) {
+        if (result.boolValue) {
+            DLog(@"Wrote %@ launches successfully.", @(uniqueIDs.count));
+            return;
+        }
+        DLog(@"Failed to write %@ launches.", @(uniqueIDs.count));
+        state.launchInFlight = NO;
+        for (NSNumber *uniqueID in uniqueIDs) {
+            iTermFileDescriptorMultiClientPendingLaunch *pendingLaunch = state.pendingLaunches[uniqueID];
+            if (!pendingLaunch) {
+                continue;
+            }
+            DLog(@"Invoke callback with connection-lost error.");
+            [state.pendingLaunches removeObjectForKey:uniqueID];
+            [pendingLaunch cancelWithError:[self connectionLostError]];
+        }
+        [self sendQueuedLaunchesWithState:state];
+    }]];
+}
+
+- (void)launchResponseDidArriveWithState:(iTermFileDescriptorMultiClientState *)state {
+    state.launchInFlight = NO;
+    [self sendQueuedLaunchesWithState:state];
+}
+
 // Called on job manager's queue via [self launchChildWithExecutablePath:…]
 - (iTermMultiServerClientOriginatedMessage)copyLaunchRequest:(iTermMultiServerClientOriginatedMessage)original {
     assert(original.type == iTermMultiServerRPCTypeLaunch);
@@ -575,6 +701,15 @@ static unsigned long long MakeUniqueID(void) {
     [pendingLaunch invalidate];
 }
 
+// Like handleLaunch:state: but for each launch in a batch.
+- (void)handleLaunchBatch:(iTermMultiServerResponseLaunchBatch)batch
+                    state:(iTermFileDescriptorMultiClientState *)state {
+    DLog(@"handleLaunchBatch: %@ launches for %@", @(batch.count), _socketPath);
+    for (int i = 0; i < batch.count; i++) {
+        [self handleLaunch:batch.launches[i] state:state];
+    }
+}
+
 #pragma mark - Wait for Child
 
 // Send a wait request. The response handler gets attached to the child to
@@ -866,6 +1001,8 @@ static unsigned long long MakeUniqueID(void) {
 
     NSDictionary<NSNumber *, iTermFileDescriptorMultiClientPendingLaunch *> *pendingLaunches = [state.pendingLaunches copy];
     [state.pendingLaunches removeAllObjects];
+    [state.queuedLaunchIDs removeAllObjects];
+    state.launchInFlight = NO;
     [pendingLaunches enumerateKeysAndObjectsUsingBlock:
      ^(NSNumber * _Nonnull uniqueID,
        iTermFileDescriptorMultiClientPendingLaunch * _Nonnull pendingLaunch,
@@ -941,6 +1078,12 @@ static unsigned long long MakeUniqueID(void) {
 
         case iTermMultiServerRPCTypeLaunch:
             [self handleLaunch:decoded->payload.launch state:state];
+            [self launchResponseDidArriveWithState:state];
+            break;
+
+        case iTermMultiServerRPCTypeLaunchBatch:
+            [self handleLaunchBatch:decoded->payload.launchBatch state:state];
+            [self launchResponseDidArriveWithState:state];
             break;
 
         case iTermMultiServerRPCTypeTermination:
@@ -950,6 +1093,7 @@ static unsigned long long MakeUniqueID(void) {
         case iTermMultiServerRPCTypeHello:  // Shouldn't happen at this point
         case iTermMultiServerRPCTypeHandshake:
         case iTermMultiServerRPCTypeReportChild:
+        case iTermMultiServerRPCTypeReportChildren:
             DLog(@"Close %@ because of unexpected message of type %@", _socketPath, @(decoded->type));
             [self closeWithState:state];
             break;
@@ -1104,11 +1248,16 @@ static unsigned long long MakeUniqueID(void) {
         [callback invokeWithObject:[iTermResult withError:self.ioError]];
         return;
     }
-    if (message.controlBuffer.cm.cmsg_len == CMSG_LEN(sizeof(int)) &&
-        message.controlBuffer.cm.cmsg_level == SOL_SOCKET &&
-        message.controlBuffer.cm.cmsg_type == SCM_RIGHTS) {
-        DLog(@"Got a file descriptor in message from %@", _socketPath);
-        [builder setFileDescriptor:*((int *)CMSG_DATA(&message.controlBuffer.cm))];
+    int fds[ITERM_MULTISERVER_MAX_FILE_DESCRIPTORS_PER_MESSAGE];
+    const int numberOfFileDescriptors =
+        iTermMultiServerProtocolGetFileDescriptors(&message,
+                                                   fds,
+                                                   ITERM_MULTISERVER_MAX_FILE_DESCRIPTORS_PER_MESSAGE);
+    if (numberOfFileDescriptors > 0) {
+        DLog(@"Got %d file descriptors in message from %@", numberOfFileDescriptors, _socketPath);
+        for (int i = 0; i < numberOfFileDescriptors; i++) {
+            [builder addFileDescriptor:fds[i]];
+        }
     }
 
     if (bytesRead == 0) {
@@ -22,6 +22,12 @@ NS_ASSUME_NONNULL_BEGIN
 @property (nonatomic, readonly) NSMutableArray<iTermFileDescriptorMultiClientChild *> *children;
 @property (nonatomic, readonly) NSMutableDictionary<NSNumber *, iTermFileDescriptorMultiClientPendingLaunch *> *pendingLaunches;
 @property (nonatomic, strong) dispatch_source_t daemonProcessSource;
+// Negotiated during the handshake.
+@property (nonatomic) int protocolVersion;
+// Unique IDs of pending launches that have not been sent yet. Only used with protocol version 3+.
+@property (nonatomic, readonly) NSMutableArray<NSNumber *> *queuedLaunchIDs;
+// Is there a launch or launch batch request awaiting its response?
+@property (nonatomic) BOOL launchInFlight;
 
 - (void)whenWritable:(void (^)(iTermFileDescriptorMultiClientState *state))block;
 - (void)whenReadable:(void (^)(iTermFileDescriptorMultiClientState *state))block;
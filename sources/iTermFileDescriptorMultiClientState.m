@@ -19,6 +19,7 @@
     if (self) {
         _children = [NSMutableArray array];
         _pendingLaunches = [NSMutableDictionary dictionary];
+        _queuedLaunchIDs = [NSMutableArray array];
         _readFD = -1;
         _writeFD = -1;
         _serverPID = -1;
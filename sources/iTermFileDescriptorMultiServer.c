@@ -291,6 +291,105 @@ static int HandleLaunchRequest(int fd, const iTermMultiServerRequestLaunch *laun
                               launch->uniqueId);
 }
 
+static int SendLaunchBatchResponse(int fd,
+                                   iTermMultiServerResponseLaunch *launches,
+                                   int count) {
+    iTermClientServerProtocolMessage obj;
+    iTermClientServerProtocolMessageInitialize(&obj);
+
+    iTermMultiServerServerOriginatedMessage message = {
+        .type = iTermMultiServerRPCTypeLaunchBatch,
+        .payload = {
+            .launchBatch = {
+                .count = count,
+                .launches = launches
+            }
+        }
+    };
+    const int rc = iTermMultiServerProtocolEncodeMessageFromServer(&message, &obj);
+    if (rc) {
+        FDLog(LOG_ERR, "Error encoding launch batch response");
+        iTermClientServerProtocolMessageFree(&obj);
+        return -1;
+    }
+
+    int fds[iTermMultiServerMaximumLaunchBatchSize];
+    int numberOfFileDescriptors = 0;
+    for (int i = 0; i < count; i++) {
+        if (launches[i].status == 0) {
+            fds[numberOfFileDescriptors++] = launches[i].fd;
+        }
+    }
+
+    ssize_t result;
+    int error = 0;
+    if (numberOfFileDescriptors > 0) {
+        FDLog(LOG_DEBUG, "NOTE: sending %d file descriptors", numberOfFileDescriptors);
+        result = iTermFileDescriptorServerWriteLengthAndBufferAndFileDescriptors(fd,
+                                                                                 obj.ioVectors[0].iov_base,
+                                                                                 obj.ioVectors[0].iov_len,
+                                                                                 fds,
+                                                                                 numberOfFileDescriptors,
+                                                                                 &error);
+    } else {
+        FDLog(LOG_ERR, "ERROR: every launch in batch failed. *not* sending file descriptors");
+        result = iTermFileDescriptorServerWriteLengthAndBuffer(fd,
+                                                               obj.ioVectors[0].iov_base,
+                                                               obj.ioVectors[0].iov_len,
+                                                               &error);
+    }
+    if (result < 0) {
+        FDLog(LOG_ERR, "ERROR: SendLaunchBatchResponse: SendMsg failed with %s", strerror(error));
+    }
+    iTermClientServerProtocolMessageFree(&obj);
+    return result == -1;
+}
+
+// Forks every child before writing anything so the children exec concurrently instead of each
+// waiting for a round trip with the client.
+static int HandleLaunchBatchRequest(int fd, const iTermMultiServerRequestLaunchBatch *batch) {
+    FDLog(LOG_DEBUG, "HandleLaunchBatchRequest fd=%d count=%d", fd, batch->count);
+    assert(batch->count > 0 && batch->count <= iTermMultiServerMaximumLaunchBatchSize);
+
+    iTermMultiServerResponseLaunch responses[iTermMultiServerMaximumLaunchBatchSize];
+    char ttys[iTermMultiServerMaximumLaunchBatchSize][PATH_MAX];
+    for (int i = 0; i < batch->count; i++) {
+        const iTermMultiServerRequestLaunch *launch = &batch->launches[i];
+        iTermForkState forkState = {
+            .connectionFd = -1,
+            .deadMansPipe = { 0, 0 },
+        };
+        iTermTTYState ttyState;
+        memset(&ttyState, 0, sizeof(ttyState));
+
+        int error = 0;
+        const int masterFd = Launch(launch, &forkState, &ttyState, &error);
+        if (masterFd < 0) {
+            ttys[i][0] = '\0';
+            responses[i] = (iTermMultiServerResponseLaunch){
+                .status = -1,
+                .pid = 0,
+                .fd = -1,
+                .uniqueId = launch->uniqueId,
+                .tty = ttys[i]
+            };
+            continue;
+        }
+
+        // Happy path
+        AddChild(launch, masterFd, ttyState.tty, &forkState);
+        strlcpy(ttys[i], ttyState.tty, sizeof(ttys[i]));
+        responses[i] = (iTermMultiServerResponseLaunch){
+            .status = 0,
+            .pid = forkState.pid,
+            .fd = masterFd,
+            .uniqueId = launch->uniqueId,
+            .tty = ttys[i]
+        };
+    }
+    return SendLaunchBatchResponse(fd, responses, batch->count);
+}
+
 #pragma mark - Report Termination
 
 static int ReportTermination(int fd, pid_t pid) {
@@ -377,6 +476,73 @@ static int ReportChild(int fd, const iTermMultiServerChild *child, int isLast) {
     return bytes < 0;
 }
 
+// Sends up to iTermMultiServerMaximumReportChildrenBatchSize children in one message with all their
+// file descriptors attached.
+static int ReportChildBatch(int fd, const iTermMultiServerChild **batch, int count, int isLast) {
+    FDLog(LOG_DEBUG, "Report batch of %d children fd=%d isLast=%d", count, fd, isLast);
+    assert(count > 0 && count <= iTermMultiServerMaximumReportChildrenBatchSize);
+
+    iTermMultiServerReportChild reports[iTermMultiServerMaximumReportChildrenBatchSize];
+    int fds[iTermMultiServerMaximumReportChildrenBatchSize];
+    for (int i = 0; i < count; i++) {
+        LogChild(batch[i]);
+        PopulateReportChild(batch[i], 0, &reports[i]);
+        fds[i] = batch[i]->masterFd;
+    }
+
+    iTermClientServerProtocolMessage obj;
+    iTermClientServerProtocolMessageInitialize(&obj);
+
+    iTermMultiServerServerOriginatedMessage message = {
+        .type = iTermMultiServerRPCTypeReportChildren,
+        .payload = {
+            .reportChildren = {
+                .isLast = isLast,
+                .count = count,
+                .children = reports
+            }
+        }
+    };
+    const int rc = iTermMultiServerProtocolEncodeMessageFromServer(&message, &obj);
+    if (rc) {
+        FDLog(LOG_ERR, "Failed to encode report children");
+        iTermClientServerProtocolMessageFree(&obj);
+        return -1;
+    }
+
+    int theError = 0;
+    ssize_t bytes = iTermFileDescriptorServerWriteLengthAndBufferAndFileDescriptors(fd,
+                                                                                    obj.ioVectors[0].iov_base,
+                                                                                    obj.ioVectors[0].iov_len,
+                                                                                    fds,
+                                                                                    count,
+                                                                                    &theError);
+    if (bytes < 0) {
+        FDLog(LOG_ERR, "SendMsg failed with %s", strerror(theError));
+        assert(theError != EAGAIN);
+    } else {
+        FDLog(LOG_DEBUG, "Reported batch of children successfully");
+    }
+    iTermClientServerProtocolMessageFree(&obj);
+    return bytes < 0;
+}
+
+// Roughly how many bytes a child adds to a report. Used to keep batches well under the client's
+// maximum message size when children have large environments.
+static size_t EstimatedReportSize(const iTermMultiServerChild *child) {
+    const iTermMultiServerRequestLaunch *launch = &child->messageWithLaunchRequest.payload.launch;
+    // Tags, lengths, and integer fields.
+    size_t size = 128;
+    size += strlen(launch->path) + strlen(launch->pwd) + strlen(child->tty);
+    for (int i = 0; i < launch->argc; i++) {
+        size += strlen(launch->argv[i]) + sizeof(size_t);
+    }
+    for (int i = 0; i < launch->envc; i++) {
+        size += strlen(launch->envp[i]) + sizeof(size_t);
+    }
+    return size;
+}
+
 #pragma mark - Termination Handling
 
 static pid_t WaitPidNoHang(pid_t pid, int *statusOut) {
@@ -423,7 +589,50 @@ static int WaitForAllProcesses(int connectionFd) {
 
 #pragma mark - Report Children
 
-static int ReportChildren(int fd) {
+// Protocol version 4 and later get children in batches, which is much faster to attach to when
+// there are many of them.
+static int ReportChildrenInBatches(int fd) {
+    FDLog(LOG_DEBUG, "Reporting children in batches...");
+    static const size_t maximumBatchBytes = 512 * 1024;
+    const int numberOfReportableChildren = GetNumberOfReportableChildren();
+    const iTermMultiServerChild *batch[iTermMultiServerMaximumReportChildrenBatchSize];
+    int count = 0;
+    size_t batchBytes = 0;
+    int numberSent = 0;
+    for (int i = numberOfChildren - 1; i >= 0; i--) {
+        if (children[i].willTerminate) {
+            continue;
+        }
+        const size_t size = EstimatedReportSize(&children[i]);
+        if (count > 0 && batchBytes + size > maximumBatchBytes) {
+            if (ReportChildBatch(fd, batch, count, 0)) {
+                FDLog(LOG_ERR, "ReportChildBatch returned an error code");
+                return -1;
+            }
+            count = 0;
+            batchBytes = 0;
+        }
+        batch[count++] = &children[i];
+        batchBytes += size;
+        numberSent += 1;
+        const int isLast = (numberSent == numberOfReportableChildren);
+        if (count == iTermMultiServerMaximumReportChildrenBatchSize || isLast) {
+            if (ReportChildBatch(fd, batch, count, isLast)) {
+                FDLog(LOG_ERR, "ReportChildBatch returned an error code");
+                return -1;
+            }
+            count = 0;
+            batchBytes = 0;
+        }
+    }
+    FDLog(LOG_DEBUG, "Done reporting children...");
+    return 0;
+}
+
+static int ReportChildren(int fd, int protocolVersion) {
+    if (protocolVersion >= iTermMultiServerProtocolVersion4) {
+        return ReportChildrenInBatches(fd);
+    }
     FDLog(LOG_DEBUG, "Reporting children...");
     // Iterate backwards because ReportAndRemoveDeadChild deletes the index passed to it.
     const int numberOfReportableChildren = GetNumberOfReportableChildren();
@@ -453,11 +662,17 @@ static int HandleHandshake(int fd, iTermMultiServerRequestHandshake *handshake)
         FDLog(LOG_ERR, "Maximum protocol version is too low: %d", handshake->maximumProtocolVersion);
         return -1;
     }
+    int protocolVersion = iTermMultiServerProtocolVersion2;
+    if (handshake->maximumProtocolVersion >= iTermMultiServerProtocolVersion4) {
+        protocolVersion = iTermMultiServerProtocolVersion4;
+    } else if (handshake->maximumProtocolVersion >= iTermMultiServerProtocolVersion3) {
+        protocolVersion = iTermMultiServerProtocolVersion3;
+    }
     iTermMultiServerServerOriginatedMessage message = {
         .type = iTermMultiServerRPCTypeHandshake,
         .payload = {
             .handshake = {
-                .protocolVersion = iTermMultiServerProtocolVersion2,
+                .protocolVersion = protocolVersion,
                 .numChildren = GetNumberOfReportableChildren(),
                 .pid = getpid()
             }
@@ -482,7 +697,7 @@ static int HandleHandshake(int fd, iTermMultiServerRequestHandshake *handshake)
     if (bytes < 0) {
         return -1;
     }
-    return ReportChildren(fd);
+    return ReportChildren(fd, protocolVersion);
 }
 
 #pragma mark - Wait
@@ -624,10 +839,14 @@ static int ReadAndHandleRequest(int readFd, int writeFd) {
         case iTermMultiServerRPCTypeLaunch:
             result = HandleLaunchRequest(writeFd, &request.payload.launch);
             break;
+        case iTermMultiServerRPCTypeLaunchBatch:
+            result = HandleLaunchBatchRequest(writeFd, &request.payload.launchBatch);
+            break;
         case iTermMultiServerRPCTypeTermination:
             FDLog(LOG_ERR, "Ignore termination message");
             break;
         case iTermMultiServerRPCTypeReportChild:
+        case iTermMultiServerRPCTypeReportChildren:
             FDLog(LOG_ERR, "Ignore report child message");
             break;
         case iTermMultiServerRPCTypeHello:
@@ -685,7 +904,7 @@ done:
 static void SelectLoop(int acceptFd, int writeFd, int readFd) {
     FDLog(LOG_DEBUG, "Begin SelectLoop.");
     while (1) {
-        static const int fdCount = 3;
+        enum { fdCount = 3 };
         int fds[fdCount] = { gPipe[0], acceptFd, readFd };
         int results[fdCount];
         FDLog(LOG_DEBUG, "Calling select()");
@@ -103,6 +103,21 @@ ssize_t iTermFileDescriptorServerWriteLengthAndBufferAndFileDescriptor(int conne
                                                                        size_t bufferSize,
                                                                        int fdToSend,
                                                                        int *errorOut) {
+    return iTermFileDescriptorServerWriteLengthAndBufferAndFileDescriptors(connectionFd,
+                                                                           buffer,
+                                                                           bufferSize,
+                                                                           &fdToSend,
+                                                                           1,
+                                                                           errorOut);
+}
+
+// Returns -1 on error
+ssize_t iTermFileDescriptorServerWriteLengthAndBufferAndFileDescriptors(int connectionFd,
+                                                                        void *buffer,
+                                                                        size_t bufferSize,
+                                                                        const int *fdsToSend,
+                                                                        int numberOfFileDescriptors,
+                                                                        int *errorOut) {
     // Write length
     unsigned char temp[sizeof(bufferSize)];
     memmove(temp, &bufferSize, sizeof(bufferSize));
@@ -111,11 +126,12 @@ ssize_t iTermFileDescriptorServerWriteLengthAndBufferAndFileDescriptor(int conne
         return rc;
     }
 
-    // Write message with file descriptor
-    rc = iTermFileDescriptorServerSendMessageAndFileDescriptor(connectionFd,
-                                                               buffer,
-                                                               bufferSize,
-                                                               fdToSend);
+    // Write message with file descriptors
+    rc = iTermFileDescriptorServerSendMessageAndFileDescriptors(connectionFd,
+                                                                buffer,
+                                                                bufferSize,
+                                                                fdsToSend,
+                                                                numberOfFileDescriptors);
     if (rc == -1) {
         if (errorOut) {
             *errorOut = errno;
@@ -181,6 +197,21 @@ ssize_t iTermFileDescriptorServerSendMessageAndFileDescriptor(int connectionFd,
                                                               void *buffer,
                                                               size_t bufferSize,
                                                               int fdToSend) {
+    return iTermFileDescriptorServerSendMessageAndFileDescriptors(connectionFd,
+                                                                  buffer,
+                                                                  bufferSize,
+                                                                  &fdToSend,
+                                                                  1);
+}
+
+ssize_t iTermFileDescriptorServerSendMessageAndFileDescriptors(int connectionFd,
+                                                               void *buffer,
+                                                               size_t bufferSize,
+                                                               const int *fdsToSend,
+                                                               int numberOfFileDescriptors) {
+    assert(numberOfFileDescriptors > 0);
+    assert(numberOfFileDescriptors <= ITERM_MULTISERVER_MAX_FILE_DESCRIPTORS_PER_MESSAGE);
+
     // sendmsg wants to send the whole buffer atomically so it has a small upper bound on message
     // size. The client-server protocol allows a message to be fragmented as long as the first
     // one has the file descriptor.
@@ -194,10 +225,11 @@ ssize_t iTermFileDescriptorServerSendMessageAndFileDescriptor(int connectionFd,
     const int maxBufferSize = 1;
 
     if (bufferSize > maxBufferSize) {
-        const ssize_t firstResult = iTermFileDescriptorServerSendMessageAndFileDescriptor(connectionFd,
-                                                                                          buffer,
-                                                                                          maxBufferSize,
-                                                                                          fdToSend);
+        const ssize_t firstResult = iTermFileDescriptorServerSendMessageAndFileDescriptors(connectionFd,
+                                                                                           buffer,
+                                                                                           maxBufferSize,
+                                                                                           fdsToSend,
+                                                                                           numberOfFileDescriptors);
         if (firstResult <= 0) {
             return firstResult;
         }
@@ -220,17 +252,18 @@ ssize_t iTermFileDescriptorServerSendMessageAndFileDescriptor(int connectionFd,
     struct msghdr message;
     memset(&message, 0, sizeof(message));
 
-    iTermFileDescriptorControlMessage controlMessage;
+    iTermFileDescriptorMultiControlMessage controlMessage;
     memset(&controlMessage, 0, sizeof(controlMessage));
 
+    const size_t fdBytes = sizeof(int) * numberOfFileDescriptors;
     message.msg_control = controlMessage.control;
-    message.msg_controllen = sizeof(controlMessage.control);
+    message.msg_controllen = CMSG_SPACE(fdBytes);
 
     struct cmsghdr *messageHeader = CMSG_FIRSTHDR(&message);
-    messageHeader->cmsg_len = CMSG_LEN(sizeof(int));
+    messageHeader->cmsg_len = CMSG_LEN(fdBytes);
     messageHeader->cmsg_level = SOL_SOCKET;
     messageHeader->cmsg_type = SCM_RIGHTS;
-    *((int *) CMSG_DATA(messageHeader)) = fdToSend;
+    memmove(CMSG_DATA(messageHeader), fdsToSend, fdBytes);
 
     message.msg_name = NULL;
     message.msg_namelen = 0;
@@ -246,8 +279,8 @@ ssize_t iTermFileDescriptorServerSendMessageAndFileDescriptor(int connectionFd,
         message.msg_iovlen = 0;
     }
 
-    FDLog(LOG_DEBUG, "Send message of length %d, iovlen=%d along with file descriptor %d",
-          (int)bufferSize, (int)message.msg_iovlen, fdToSend);
+    FDLog(LOG_DEBUG, "Send message of length %d, iovlen=%d along with %d file descriptors starting with %d",
+          (int)bufferSize, (int)message.msg_iovlen, numberOfFileDescriptors, fdsToSend[0]);
 
     ssize_t rc = sendmsg(connectionFd, &message, 0);
     while (rc == -1 && errno == EINTR) {
@@ -18,6 +18,15 @@ typedef union {
     char control[CMSG_SPACE(sizeof(int))];
 } iTermFileDescriptorControlMessage;
 
+// XNU copies control data into a single mbuf, so keep this small enough that the control message
+// fits in one.
+#define ITERM_MULTISERVER_MAX_FILE_DESCRIPTORS_PER_MESSAGE 32
+
+typedef union {
+    struct cmsghdr cm;
+    char control[CMSG_SPACE(sizeof(int) * ITERM_MULTISERVER_MAX_FILE_DESCRIPTORS_PER_MESSAGE)];
+} iTermFileDescriptorMultiControlMessage;
+
 void iTermFileDescriptorServerLog(char *format, ...);
 int iTermFileDescriptorServerAcceptAndClose(int socketFd);
 int iTermFileDescriptorServerAccept(int socketFd);
@@ -28,6 +37,14 @@ ssize_t iTermFileDescriptorServerSendMessageAndFileDescriptor(int connectionFd,
                                                               size_t bufferSize,
                                                               int fdToSend);
 
+// Sends up to ITERM_MULTISERVER_MAX_FILE_DESCRIPTORS_PER_MESSAGE file descriptors in one
+// control message.
+ssize_t iTermFileDescriptorServerSendMessageAndFileDescriptors(int connectionFd,
+                                                               void *buffer,
+                                                               size_t bufferSize,
+                                                               const int *fdsToSend,
+                                                               int numberOfFileDescriptors);
+
 ssize_t iTermFileDescriptorServerWriteLengthAndBuffer(int connectionFd,
                                                       void *buffer,
                                                       size_t bufferSize,
@@ -37,6 +54,12 @@ ssize_t iTermFileDescriptorServerWriteLengthAndBufferAndFileDescriptor(int conne
                                                                        size_t bufferSize,
                                                                        int fdToSend,
                                                                        int *errorOut);
+ssize_t iTermFileDescriptorServerWriteLengthAndBufferAndFileDescriptors(int connectionFd,
+                                                                        void *buffer,
+                                                                        size_t bufferSize,
+                                                                        const int *fdsToSend,
+                                                                        int numberOfFileDescriptors,
+                                                                        int *errorOut);
 
 ssize_t iTermFileDescriptorServerWrite(int fd, void *buffer, size_t bufferSize);
 
@@ -0,0 +1,71 @@
+//
+//  iTermFlatIntervalTree.h
+//  iTerm2Shared
+//
+//  Created by George Nachman on 10/18/26.
+//
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+// Like IntervalTree, but all nodes live in one contiguous array and there are no Interval or
+// IntervalTreeEntry objects. Intervals are half-open, [location, location + length), with 64-bit
+// keys. Two intervals intersect under the same rule as -[Interval intersects:], so empty intervals
+// are never found by a range query.
+//
+// Queries hand each result to a block instead of building an array, so drawing code can look up
+// the marks in the visible region every frame without allocating.
+//
+// Objects are retained and compared by identity. An object may be added at most once. Do not
+// modify the tree while enumerating it.
+@interface iTermFlatIntervalTree : NSObject
+
+@property (nonatomic, readonly) NSInteger count;
+
+// O(log N)
+- (void)addObject:(id)object withLocation:(long long)location length:(long long)length;
+
+// O(log N) plus the number of objects at the same location. Returns NO if not present.
+- (BOOL)removeObject:(id)object;
+
+- (BOOL)containsObject:(id)object;
+
+// Returns NO if |object| is not present.
+- (BOOL)getLocation:(out long long *)locationPtr
+             length:(out long long *)lengthPtr
+           ofObject:(id)object;
+
+- (void)removeAllObjects;
+
+// Calls |block| for each object whose interval intersects [location, location + length), in
+// order of location. O(log N) plus the number of results.
+- (void)enumerateObjectsInRangeWithLocation:(long long)location
+                                     length:(long long)length
+                                 usingBlock:(void (NS_NOESCAPE ^)(id object,
+                                                                  long long location,
+                                                                  long long length,
+                                                                  BOOL *stop))block;
+
+// Calls |block| for each object in order of location, including those with empty intervals.
+- (void)enumerateAllObjectsUsingBlock:(void (NS_NOESCAPE ^)(id object,
+                                                            long long location,
+                                                            long long length,
+                                                            BOOL *stop))block;
+
+// Adds |delta| to every location in O(1) time.
+- (void)shiftLocationsBy:(long long)delta;
+
+// Removes every object whose interval ends at or before |limit|, as when lines are lost to
+// scrollback overflow. |block| is called for each removed object before it is released. Takes
+// O(log N) time plus the number of objects that begin at or before |limit|, rather than a search
+// and a rebalance per object.
+- (void)removeObjectsWithLimitAtOrBefore:(long long)limit
+                              usingBlock:(void (NS_NOESCAPE ^ _Nullable)(id object))block;
+
+// Asserts that the tree is well-formed. For tests.
+- (void)sanityCheck;
+
+@end
+
+NS_ASSUME_NONNULL_END
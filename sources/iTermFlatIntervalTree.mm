@@ -0,0 +1,421 @@
+//
+//  iTermFlatIntervalTree.mm
+//  iTerm2Shared
+//
+//  Created by George Nachman on 10/18/26.
+//
+
+#import "iTermFlatIntervalTree.h"
+
+extern "C" {
+#import "DebugLogging.h"
+}
+#include <algorithm>
+#include <unordered_map>
+#include <vector>
+
+namespace iTerm2 {
+    // A treap ordered by location in which each node also knows the largest limit in its
+    // subtree. Nodes refer to each other by index into _nodes. Freed nodes are reused, so the
+    // array only grows to the largest number of intervals held at once.
+    //
+    // Locations and limits are stored relative to _offset, which makes shifting every interval
+    // a single addition.
+    class FlatIntervalTree {
+    public:
+        static const int32_t kNone = -1;
+
+        struct Node {
+            long long location;
+            long long limit;
+            long long max_limit;
+            uint32_t priority;
+            int32_t left;
+            int32_t right;
+            id object;
+        };
+
+    private:
+        std::vector<Node> _nodes;
+        std::vector<int32_t> _free_list;
+        std::unordered_map<void *, int32_t> _index_of_object;
+        std::vector<int32_t> _scratch;
+        int32_t _root;
+        long long _offset;
+        uint32_t _seed;
+
+    public:
+        FlatIntervalTree() : _root(kNone), _offset(0), _seed(2463534242) { }
+
+        size_t size() const {
+            return _index_of_object.size();
+        }
+
+        bool contains(id object) const {
+            return _index_of_object.find((void *)object) != _index_of_object.end();
+        }
+
+        bool get(id object, long long *location, long long *limit) const {
+            auto it = _index_of_object.find((void *)object);
+            if (it == _index_of_object.end()) {
+                return false;
+            }
+            const Node &node = _nodes[it->second];
+            *location = node.location + _offset;
+            *limit = node.limit + _offset;
+            return true;
+        }
+
+        void insert(id object, long long location, long long limit) {
+            assert(!contains(object));
+            const int32_t i = allocate(object, location - _offset, limit - _offset);
+            _index_of_object[(void *)object] = i;
+
+            // Go after existing intervals at the same location, as IntervalTree does.
+            int32_t before, after;
+            split(_root, _nodes[i].location + 1, &before, &after);
+            _root = merge(merge(before, i), after);
+        }
+
+        bool erase(id object) {
+            auto it = _index_of_object.find((void *)object);
+            if (it == _index_of_object.end()) {
+                return false;
+            }
+            const int32_t i = it->second;
+            _index_of_object.erase(it);
+
+            const long long location = _nodes[i].location;
+            int32_t before, rest, same, after;
+            split(_root, location, &before, &rest);
+            split(rest, location + 1, &same, &after);
+            bool found = false;
+            same = erase_from(same, i, &found);
+            assert(found);
+            deallocate(i);
+            _root = merge(merge(before, same), after);
+            return true;
+        }
+
+        // f(object, location, limit) returns false to stop.
+        template<typename F>
+        void visit_intersecting(long long location, long long limit, F f) const {
+            visit_intersecting(_root, location - _offset, limit - _offset, f);
+        }
+
+        template<typename F>
+        void visit_all(F f) const {
+            visit_all(_root, f);
+        }
+
+        void shift(long long delta) {
+            _offset += delta;
+        }
+
+        // f(object) is called for each removed object before the tree forgets it.
+        template<typename F>
+        void erase_ending_at_or_before(long long limit, F f) {
+            const long long relative_limit = limit - _offset;
+            int32_t candidates, rest;
+            split(_root, relative_limit + 1, &candidates, &rest);
+
+            // Every interval that ends by |limit| also starts by it, so only |candidates| need to
+            // be examined. The few that extend past |limit| are put back.
+            _scratch.clear();
+            collect(candidates, &_scratch);
+            int32_t survivors = kNone;
+            for (const int32_t i : _scratch) {
+                Node &node = _nodes[i];
+                if (node.limit > relative_limit) {
+                    node.left = kNone;
+                    node.right = kNone;
+                    node.max_limit = node.limit;
+                    survivors = merge(survivors, i);
+                    continue;
+                }
+                f(node.object);
+                _index_of_object.erase((void *)node.object);
+                deallocate(i);
+            }
+            _scratch.clear();
+            _root = merge(survivors, rest);
+        }
+
+        // f(object) is called for each object before the tree forgets it.
+        template<typename F>
+        void clear(F f) {
+            for (const auto &pair : _index_of_object) {
+                f(_nodes[pair.second].object);
+            }
+            _nodes.clear();
+            _free_list.clear();
+            _index_of_object.clear();
+            _root = kNone;
+        }
+
+        void check() const {
+            size_t count = 0;
+            check(_root, &count);
+            assert(count == size());
+            assert(_nodes.size() == size() + _free_list.size());
+        }
+
+    private:
+        uint32_t next_priority() {
+            // xorshift32. Deterministic so tests are repeatable.
+            _seed ^= _seed << 13;
+            _seed ^= _seed >> 17;
+            _seed ^= _seed << 5;
+            return _seed;
+        }
+
+        int32_t allocate(id object, long long location, long long limit) {
+            const Node node = { location, limit, limit, next_priority(), kNone, kNone, object };
+            if (!_free_list.empty()) {
+                const int32_t i = _free_list.back();
+                _free_list.pop_back();
+                _nodes[i] = node;
+                return i;
+            }
+            _nodes.push_back(node);
+            return static_cast<int32_t>(_nodes.size() - 1);
+        }
+
+        void deallocate(int32_t i) {
+            _nodes[i].object = nil;
+            _free_list.push_back(i);
+        }
+
+        long long max_limit(int32_t i) const {
+            return i == kNone ? LLONG_MIN : _nodes[i].max_limit;
+        }
+
+        void update(int32_t i) {
+            Node &node = _nodes[i];
+            node.max_limit = std::max(node.limit, std::max(max_limit(node.left), max_limit(node.right)));
+        }
+
+        // Nodes located before |location| go in |left| and the rest in |right|.
+        void split(int32_t i, long long location, int32_t *left, int32_t *right) {
+            if (i == kNone) {
+                *left = kNone;
+                *right = kNone;
+                return;
+            }
+            Node &node = _nodes[i];
+            if (node.location < location) {
+                split(node.right, location, &_nodes[i].right, right);
+                *left = i;
+            } else {
+                split(node.left, location, left, &_nodes[i].left);
+                *right = i;
+            }
+            update(i);
+        }
+
+        // Every node in |left| must be located at or before every node in |right|.
+        int32_t merge(int32_t left, int32_t right) {
+            if (left == kNone) {
+                return right;
+            }
+            if (right == kNone) {
+                return left;
+            }
+            if (_nodes[left].priority > _nodes[right].priority) {
+                const int32_t merged = merge(_nodes[left].right, right);
+                _nodes[left].right = merged;
+                update(left);
+                return left;
+            }
+            const int32_t merged = merge(left, _nodes[right].left);
+            _nodes[right].left = merged;
+            update(right);
+            return right;
+        }
+
+        // All nodes under |i| share a location, so |target| could be on either side.
+        int32_t erase_from(int32_t i, int32_t target, bool *found) {
+            if (i == kNone) {
+                return kNone;
+            }
+            if (i == target) {
+                *found = true;
+                return merge(_nodes[i].left, _nodes[i].right);
+            }
+            const int32_t left = erase_from(_nodes[i].left, target, found);
+            _nodes[i].left = left;
+            if (!*found) {
+                const int32_t right = erase_from(_nodes[i].right, target, found);
+                _nodes[i].right = right;
+            }
+            update(i);
+            return i;
+        }
+
+        template<typename F>
+        bool visit_intersecting(int32_t i, long long location, long long limit, F &f) const {
+            if (i == kNone) {
+                return true;
+            }
+            const Node &node = _nodes[i];
+            if (node.max_limit <= location) {
+                // Everything in this subtree ends before the range begins.
+                return true;
+            }
+            if (!visit_intersecting(node.left, location, limit, f)) {
+                return false;
+            }
+            if (node.location >= limit) {
+                // This node and everything to its right begin after the range ends.
+                return true;
+            }
+            if (std::max(node.location, location) < std::min(node.limit, limit)) {
+                if (!f(node.object, node.location + _offset, node.limit + _offset)) {
+                    return false;
+                }
+            }
+            return visit_intersecting(node.right, location, limit, f);
+        }
+
+        template<typename F>
+        bool visit_all(int32_t i, F &f) const {
+            if (i == kNone) {
+                return true;
+            }
+            const Node &node = _nodes[i];
+            return (visit_all(node.left, f) &&
+                    f(node.object, node.location + _offset, node.limit + _offset) &&
+                    visit_all(node.right, f));
+        }
+
+        void collect(int32_t i, std::vector<int32_t> *indexes) const {
+            if (i == kNone) {
+                return;
+            }
+            collect(_nodes[i].left, indexes);
+            indexes->push_back(i);
+            collect(_nodes[i].right, indexes);
+        }
+
+        void check(int32_t i, size_t *count) const {
+            if (i == kNone) {
+                return;
+            }
+            ++*count;
+            const Node &node = _nodes[i];
+            assert(node.limit >= node.location);
+            assert(_index_of_object.at((void *)node.object) == i);
+            long long expected_max_limit = node.limit;
+            for (const int32_t child : { node.left, node.right }) {
+                if (child == kNone) {
+                    continue;
+                }
+                assert(_nodes[child].priority <= node.priority);
+                check(child, count);
+                expected_max_limit = std::max(expected_max_limit, _nodes[child].max_limit);
+            }
+            assert(node.left == kNone || _nodes[node.left].location <= node.location);
+            assert(node.right == kNone || _nodes[node.right].location >= node.location);
+            assert(node.max_limit == expected_max_limit);
+        }
+    };
+}
+
+@implementation iTermFlatIntervalTree {
+    iTerm2::FlatIntervalTree _tree;
+}
+
+- (void)dealloc {
+    _tree.clear([](id object) {
+        [object release];
+    });
+    [super dealloc];
+}
+
+- (NSString *)description {
+    return [NSString stringWithFormat:@"<%@: %p count=%@>", self.class, self, @(self.count)];
+}
+
+- (NSInteger)count {
+    return _tree.size();
+}
+
+- (void)addObject:(id)object withLocation:(long long)location length:(long long)length {
+    assert(length >= 0);
+    _tree.insert([object retain], location, location + length);
+}
+
+- (BOOL)removeObject:(id)object {
+    if (!_tree.erase(object)) {
+        return NO;
+    }
+    [object release];
+    return YES;
+}
+
+- (BOOL)containsObject:(id)object {
+    return _tree.contains(object);
+}
+
+- (BOOL)getLocation:(out long long *)locationPtr
+             length:(out long long *)lengthPtr
+           ofObject:(id)object {
+    long long location;
+    long long limit;
+    if (!_tree.get(object, &location, &limit)) {
+        return NO;
+    }
+    *locationPtr = location;
+    *lengthPtr = limit - location;
+    return YES;
+}
+
+- (void)removeAllObjects {
+    _tree.clear([](id object) {
+        [object release];
+    });
+}
+
+- (void)enumerateObjectsInRangeWithLocation:(long long)location
+                                     length:(long long)length
+                                 usingBlock:(void (NS_NOESCAPE ^)(id, long long, long long, BOOL *))block {
+    _tree.visit_intersecting(location, location + length, [block](id object, long long location, long long limit) {
+        BOOL stop = NO;
+        block(object, location, limit - location, &stop);
+        return !stop;
+    });
+}
+
+- (void)enumerateAllObjectsUsingBlock:(void (NS_NOESCAPE ^)(id, long long, long long, BOOL *))block {
+    _tree.visit_all([block](id object, long long location, long long limit) {
+        BOOL stop = NO;
+        block(object, location, limit - location, &stop);
+        return !stop;
+    });
+}
+
+- (void)shiftLocationsBy:(long long)delta {
+    _tree.shift(delta);
+}
+
+- (void)removeObjectsWithLimitAtOrBefore:(long long)limit
+                              usingBlock:(void (NS_NOESCAPE ^)(id))block {
+    NSMutableArray *removed = [NSMutableArray array];
+    _tree.erase_ending_at_or_before(limit, [removed](id object) {
+        // The array takes over the tree's reference so |block| may safely look at the tree.
+        [removed addObject:object];
+        [object release];
+    });
+    DLog(@"Removed %@ objects ending at or before %@", @(removed.count), @(limit));
+    if (block) {
+        for (id object in removed) {
+            block(object);
+        }
+    }
+}
+
+- (void)sanityCheck {
+    _tree.check();
+}
+
+@end
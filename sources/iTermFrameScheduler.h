@@ -0,0 +1,84 @@
+//
+//  iTermFrameScheduler.h
+//  iTerm2
+//
+//  Created by George Nachman on 10/18/26.
+//
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+// Lower values are served first when several clients are due on the same tick.
+typedef NS_ENUM(NSInteger, iTermFrameSchedulerPriority) {
+    // Sessions in the key window.
+    iTermFrameSchedulerPriorityKeyWindow,
+    // Other sessions in visible tabs.
+    iTermFrameSchedulerPriorityVisible,
+    // Idle sessions and sessions in hidden tabs.
+    iTermFrameSchedulerPriorityBackground,
+    // Sessions whose windows are completely covered or offscreen.
+    iTermFrameSchedulerPriorityOccluded
+};
+
+@protocol iTermFrameSchedulerClient<NSObject>
+- (void)frameSchedulerDidTick;
+@end
+
+// Decides which clients get updated when. Time is divided into ticks of equal length. Each client
+// has a period, rounded to a whole number of ticks, and is due on the ticks that are multiples of
+// its period. That way clients with the same period are always due together and share a wakeup,
+// however many of them there are.
+//
+// Does not read the clock, so it can be tested with a virtual one. Clients are held weakly.
+@interface iTermFrameSchedulerPolicy : NSObject
+
+@property (nonatomic, readonly) NSTimeInterval tickInterval;
+
+// Clients with iTermFrameSchedulerPriorityOccluded are updated no more often than this.
+@property (nonatomic) NSTimeInterval occludedPeriod;
+
+// Number of registered clients.
+@property (nonatomic, readonly) NSInteger count;
+
+- (instancetype)initWithTickInterval:(NSTimeInterval)tickInterval NS_DESIGNATED_INITIALIZER;
+- (instancetype)init NS_UNAVAILABLE;
+
+// Adds a client or changes its period or priority. A new client is first due within one period.
+- (void)setPeriod:(NSTimeInterval)period
+         priority:(iTermFrameSchedulerPriority)priority
+        forClient:(id)client
+              now:(NSTimeInterval)now;
+
+- (void)removeClient:(id)client;
+- (BOOL)hasClient:(id)client;
+- (iTermFrameSchedulerPriority)priorityOfClient:(id)client;
+
+// Returns the clients that are due at `now`, highest priority first, and schedules their next
+// updates.
+- (NSArray *)clientsDueAt:(NSTimeInterval)now;
+
+// Makes a client due again on the next tick, as when a busy tick had no time left for it.
+- (void)deferClient:(id)client now:(NSTimeInterval)now;
+
+// The time when the next client will be due. INFINITY if there are no clients.
+- (NSTimeInterval)nextWakeupAfter:(NSTimeInterval)now;
+
+@end
+
+// Drives an iTermFrameSchedulerPolicy with a single timer on the main queue, which wakes only when
+// some client is due. On each tick, clients are updated in priority order. Once updating has taken
+// most of a tick, clients outside the key window are deferred to the next tick. Main thread only.
+@interface iTermFrameScheduler : NSObject
+
++ (instancetype)sharedInstance;
+
+- (void)setPeriod:(NSTimeInterval)period
+         priority:(iTermFrameSchedulerPriority)priority
+        forClient:(id<iTermFrameSchedulerClient>)client;
+- (void)removeClient:(id<iTermFrameSchedulerClient>)client;
+- (BOOL)hasClient:(id<iTermFrameSchedulerClient>)client;
+
+@end
+
+NS_ASSUME_NONNULL_END
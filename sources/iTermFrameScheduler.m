@@ -0,0 +1,247 @@
+//
+//  iTermFrameScheduler.m
+//  iTerm2
+//
+//  Created by George Nachman on 10/18/26.
+//
+
+#import "iTermFrameScheduler.h"
+
+#import "DebugLogging.h"
+#import "iTermAdvancedSettingsModel.h"
+
+#import <QuartzCore/QuartzCore.h>
+
+// Fraction of a tick that may be spent updating before clients outside the key window are deferred.
+static const double iTermFrameSchedulerTickBudget = 0.75;
+
+@interface iTermFrameSchedulerEntry : NSObject
+@property (nonatomic, weak) id client;
+@property (nonatomic) long long periodTicks;
+@property (nonatomic) long long nextTick;
+@property (nonatomic) iTermFrameSchedulerPriority priority;
+// Breaks ties between clients with the same priority so the order is stable.
+@property (nonatomic) NSUInteger sequenceNumber;
+@end
+
+@implementation iTermFrameSchedulerEntry
+@end
+
+@implementation iTermFrameSchedulerPolicy {
+    NSMapTable<id, iTermFrameSchedulerEntry *> *_entries;
+    NSUInteger _nextSequenceNumber;
+}
+
+- (instancetype)initWithTickInterval:(NSTimeInterval)tickInterval {
+    self = [super init];
+    if (self) {
+        _tickInterval = tickInterval;
+        _occludedPeriod = 1;
+        _entries = [NSMapTable mapTableWithKeyOptions:(NSPointerFunctionsWeakMemory |
+                                                       NSPointerFunctionsObjectPointerPersonality)
+                                         valueOptions:NSPointerFunctionsStrongMemory];
+    }
+    return self;
+}
+
+- (NSInteger)count {
+    return self.liveEntries.count;
+}
+
+// Entries whose clients haven't been deallocated.
+- (NSArray<iTermFrameSchedulerEntry *> *)liveEntries {
+    NSMutableArray<iTermFrameSchedulerEntry *> *result = [NSMutableArray array];
+    for (iTermFrameSchedulerEntry *entry in _entries.objectEnumerator) {
+        if (entry.client) {
+            [result addObject:entry];
+        }
+    }
+    return result;
+}
+
+- (long long)tickAt:(NSTimeInterval)now {
+    // The epsilon keeps a time computed as tick * tickInterval from rounding down to the previous tick.
+    return (long long)floor(now / _tickInterval + 1e-6);
+}
+
+// The first tick after `tick` that is a multiple of periodTicks.
+static long long iTermFrameSchedulerNextAlignedTick(long long tick, long long periodTicks) {
+    return (tick / periodTicks + 1) * periodTicks;
+}
+
+- (void)setPeriod:(NSTimeInterval)period
+         priority:(iTermFrameSchedulerPriority)priority
+        forClient:(id)client
+              now:(NSTimeInterval)now {
+    if (priority == iTermFrameSchedulerPriorityOccluded) {
+        period = MAX(period, _occludedPeriod);
+    }
+    const long long periodTicks = MAX(1, llround(period / _tickInterval));
+    const long long tick = [self tickAt:now];
+    iTermFrameSchedulerEntry *entry = [_entries objectForKey:client];
+    if (!entry) {
+        entry = [[iTermFrameSchedulerEntry alloc] init];
+        entry.client = client;
+        entry.sequenceNumber = _nextSequenceNumber++;
+        entry.nextTick = iTermFrameSchedulerNextAlignedTick(tick, periodTicks);
+        [_entries setObject:entry forKey:client];
+    } else if (periodTicks != entry.periodTicks) {
+        // Speeding up takes effect right away. Slowing down waits for the update that was already
+        // scheduled.
+        entry.nextTick = MIN(MAX(entry.nextTick, tick + 1),
+                             iTermFrameSchedulerNextAlignedTick(tick, periodTicks));
+    }
+    entry.periodTicks = periodTicks;
+    entry.priority = priority;
+}
+
+- (void)removeClient:(id)client {
+    [_entries removeObjectForKey:client];
+}
+
+- (BOOL)hasClient:(id)client {
+    return [_entries objectForKey:client] != nil;
+}
+
+- (iTermFrameSchedulerPriority)priorityOfClient:(id)client {
+    iTermFrameSchedulerEntry *entry = [_entries objectForKey:client];
+    return entry ? entry.priority : iTermFrameSchedulerPriorityBackground;
+}
+
+- (NSArray *)clientsDueAt:(NSTimeInterval)now {
+    const long long tick = [self tickAt:now];
+    NSMutableArray<iTermFrameSchedulerEntry *> *due = [NSMutableArray array];
+    for (iTermFrameSchedulerEntry *entry in self.liveEntries) {
+        if (entry.nextTick <= tick) {
+            [due addObject:entry];
+            entry.nextTick = iTermFrameSchedulerNextAlignedTick(tick, entry.periodTicks);
+        }
+    }
+    [due sortUsingComparator:^NSComparisonResult(iTermFrameSchedulerEntry *lhs, iTermFrameSchedulerEntry *rhs) {
+        if (lhs.priority != rhs.priority) {
+            return lhs.priority < rhs.priority ? NSOrderedAscending : NSOrderedDescending;
+        }
+        if (lhs.sequenceNumber == rhs.sequenceNumber) {
+            return NSOrderedSame;
+        }
+        return lhs.sequenceNumber < rhs.sequenceNumber ? NSOrderedAscending : NSOrderedDescending;
+    }];
+    NSMutableArray *clients = [NSMutableArray arrayWithCapacity:due.count];
+    for (iTermFrameSchedulerEntry *entry in due) {
+        id client = entry.client;
+        if (client) {
+            [clients addObject:client];
+        }
+    }
+    return clients;
+}
+
+- (void)deferClient:(id)client now:(NSTimeInterval)now {
+    iTermFrameSchedulerEntry *entry = [_entries objectForKey:client];
+    entry.nextTick = [self tickAt:now] + 1;
+}
+
+- (NSTimeInterval)nextWakeupAfter:(NSTimeInterval)now {
+    long long earliest = LLONG_MAX;
+    for (iTermFrameSchedulerEntry *entry in self.liveEntries) {
+        earliest = MIN(earliest, entry.nextTick);
+    }
+    if (earliest == LLONG_MAX) {
+        return INFINITY;
+    }
+    return MAX(now, earliest * _tickInterval);
+}
+
+@end
+
+@implementation iTermFrameScheduler {
+    iTermFrameSchedulerPolicy *_policy;
+    dispatch_source_t _timer;
+    // When _timer is set to fire. INFINITY if it is suspended.
+    NSTimeInterval _scheduledWakeup;
+}
+
++ (instancetype)sharedInstance {
+    static id instance;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        instance = [[self alloc] init];
+    });
+    return instance;
+}
+
+- (instancetype)init {
+    self = [super init];
+    if (self) {
+        // Ticks happen at the same rate as updates of active sessions.
+        _policy = [[iTermFrameSchedulerPolicy alloc] initWithTickInterval:1.0 / MAX(1, [iTermAdvancedSettingsModel activeUpdateCadence])];
+        _timer = dispatch_source_create(DISPATCH_SOURCE_TYPE_TIMER, 0, 0, dispatch_get_main_queue());
+        __weak __typeof(self) weakSelf = self;
+        dispatch_source_set_event_handler(_timer, ^{
+            [weakSelf tick];
+        });
+        _scheduledWakeup = INFINITY;
+        dispatch_source_set_timer(_timer, DISPATCH_TIME_FOREVER, DISPATCH_TIME_FOREVER, 0);
+        dispatch_resume(_timer);
+    }
+    return self;
+}
+
+- (void)dealloc {
+    dispatch_source_cancel(_timer);
+}
+
+- (void)setPeriod:(NSTimeInterval)period
+         priority:(iTermFrameSchedulerPriority)priority
+        forClient:(id<iTermFrameSchedulerClient>)client {
+    DLog(@"Set period of %@ to %@ with priority %@", client, @(period), @(priority));
+    [_policy setPeriod:period priority:priority forClient:client now:CACurrentMediaTime()];
+    [self scheduleWakeup];
+}
+
+- (void)removeClient:(id<iTermFrameSchedulerClient>)client {
+    [_policy removeClient:client];
+    [self scheduleWakeup];
+}
+
+- (BOOL)hasClient:(id<iTermFrameSchedulerClient>)client {
+    return [_policy hasClient:client];
+}
+
+- (void)tick {
+    const NSTimeInterval start = CACurrentMediaTime();
+    _scheduledWakeup = INFINITY;
+    NSArray<id<iTermFrameSchedulerClient>> *clients = [_policy clientsDueAt:start];
+    DLog(@"Tick with %@ due clients", @(clients.count));
+    const NSTimeInterval budget = _policy.tickInterval * iTermFrameSchedulerTickBudget;
+    for (id<iTermFrameSchedulerClient> client in clients) {
+        if ([_policy priorityOfClient:client] != iTermFrameSchedulerPriorityKeyWindow &&
+            CACurrentMediaTime() - start > budget) {
+            DLog(@"Out of time. Defer %@", client);
+            [_policy deferClient:client now:start];
+            continue;
+        }
+        [client frameSchedulerDidTick];
+    }
+    [self scheduleWakeup];
+}
+
+- (void)scheduleWakeup {
+    const NSTimeInterval now = CACurrentMediaTime();
+    const NSTimeInterval wakeup = [_policy nextWakeupAfter:now];
+    if (wakeup == _scheduledWakeup) {
+        return;
+    }
+    _scheduledWakeup = wakeup;
+    if (isinf(wakeup)) {
+        DLog(@"No clients. Suspend timer.");
+        dispatch_source_set_timer(_timer, DISPATCH_TIME_FOREVER, DISPATCH_TIME_FOREVER, 0);
+        return;
+    }
+    dispatch_source_set_timer(_timer,
+                              dispatch_time(DISPATCH_TIME_NOW, (wakeup - now) * NSEC_PER_SEC),
+                              DISPATCH_TIME_FOREVER,
+                              0.0005 * NSEC_PER_SEC);
+}
+
+@end
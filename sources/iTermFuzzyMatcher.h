@@ -0,0 +1,67 @@
+//
+//  iTermFuzzyMatcher.h
+//  iTerm2
+//
+//  Created by George Nachman on 10/18/26.
+//
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+// A string prepared for matching: it is lowercased once and, for each distinct character, a bitmap
+// of where it occurs is built. Get these from -[iTermFuzzyMatcher documentForString:].
+@interface iTermFuzzyMatchDocument : NSObject
+
+@property(nonatomic, readonly) NSString *string;
+
+- (instancetype)init NS_UNAVAILABLE;
+
+@end
+
+// Finds queries as case-insensitive subsequences of documents. It gives the same matches as
+// iTermMinimumSubsequenceMatcher (the shortest span of the document containing the query, taking
+// the earliest in a tie) but is meant to be kept around while the user types: documents are
+// prepared once, matching doesn't allocate, and when the query grows the documents that didn't
+// match the last query are skipped.
+//
+// It can hold a fixed list of candidate strings to narrow and rank, as a picker would, or score
+// documents handed to it one at a time.
+@interface iTermFuzzyMatcher : NSObject
+
+// Setting the query to one that begins with the current query only examines documents that
+// matched the current one.
+@property(nonatomic, copy) NSString *query;
+
+// Strings to be ranked by -indexesOfBestMatchesWithMaximumCount:.
+- (instancetype)initWithStrings:(NSArray<NSString *> *)strings NS_DESIGNATED_INITIALIZER;
+- (instancetype)init;
+
+// Returns the document for |string|, preparing it the first time the string is seen.
+- (iTermFuzzyMatchDocument *)documentForString:(NSString *)string;
+
+// Returns a value between 0 and 1 for how well the query matches a document:
+//   1.0 if the match begins and ends at the ends of the document.
+//   0.9 if the match begins at the start of the document.
+//   0.5 / the number of runs of consecutive matching characters otherwise.
+//   0.0 if there is no match or the query is empty.
+- (double)qualityOfMatchForDocument:(iTermFuzzyMatchDocument *)document;
+
+// Indexes into the lowercased document of the characters that match the query, or nil if there is
+// no match.
+- (nullable NSIndexSet *)indexSetForDocument:(iTermFuzzyMatchDocument *)document;
+
+// Indexes into the strings given at initialization of the best matches to the query, best first.
+// Equally good matches are in their original order. An empty query matches everything equally.
+- (NSArray<NSNumber *> *)indexesOfBestMatchesWithMaximumCount:(NSUInteger)maximumCount;
+
+// Returns up to |maximumCount| of |objects| with the highest scores, highest first. Objects with
+// equal scores keep their relative order. Selection uses a heap, so it's cheaper than sorting
+// everything when only a few objects are wanted.
++ (NSArray *)bestObjects:(NSArray *)objects
+            maximumCount:(NSUInteger)maximumCount
+                   score:(double (^ NS_NOESCAPE)(id object))score;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,463 @@
+//
+//  iTermFuzzyMatcher.m
+//  iTerm2
+//
+//  Created by George Nachman on 10/18/26.
+//
+
+#import "iTermFuzzyMatcher.h"
+
+typedef struct {
+    const unichar *characters;
+    NSInteger length;
+
+    // Bit (c % 64) is set for each character c. A document lacking any of these bits can't match.
+    uint64_t signature;
+
+    // Scratch space for one row of the document's bitmaps per character of the query.
+    const uint64_t **rows;
+} iTermFuzzyQuery;
+
+typedef struct {
+    double score;
+    NSUInteger index;
+} iTermFuzzyScoredIndex;
+
+static uint64_t iTermFuzzySignature(const unichar *characters, NSInteger length) {
+    uint64_t signature = 0;
+    for (NSInteger i = 0; i < length; i++) {
+        signature |= 1ULL << (characters[i] & 63);
+    }
+    return signature;
+}
+
+// Returns the first set bit in |row| after |after|, or -1 if there is none. This finds the next
+// occurrence of a character 64 document positions at a time.
+static inline NSInteger iTermFuzzyNextOccurrence(const uint64_t *row,
+                                                 NSInteger numberOfWords,
+                                                 NSInteger after) {
+    const NSInteger position = after + 1;
+    NSInteger word = position >> 6;
+    if (word >= numberOfWords) {
+        return -1;
+    }
+    uint64_t bits = row[word] & (~0ULL << (position & 63));
+    while (!bits) {
+        word++;
+        if (word == numberOfWords) {
+            return -1;
+        }
+        bits = row[word];
+    }
+    return (word << 6) + __builtin_ctzll(bits);
+}
+
+static int iTermFuzzyCompareCharacters(const void *lhs, const void *rhs) {
+    return (int)*(const unichar *)lhs - (int)*(const unichar *)rhs;
+}
+
+// YES if lhs should come after rhs: it has a lower score, or an equal score and a later index.
+static inline BOOL iTermFuzzyRanksBelow(iTermFuzzyScoredIndex lhs, iTermFuzzyScoredIndex rhs) {
+    if (lhs.score != rhs.score) {
+        return lhs.score < rhs.score;
+    }
+    return lhs.index > rhs.index;
+}
+
+static void iTermFuzzySiftDown(iTermFuzzyScoredIndex *heap, NSUInteger count, NSUInteger i) {
+    while (YES) {
+        NSUInteger lowest = i;
+        const NSUInteger left = 2 * i + 1;
+        const NSUInteger right = left + 1;
+        if (left < count && iTermFuzzyRanksBelow(heap[left], heap[lowest])) {
+            lowest = left;
+        }
+        if (right < count && iTermFuzzyRanksBelow(heap[right], heap[lowest])) {
+            lowest = right;
+        }
+        if (lowest == i) {
+            return;
+        }
+        const iTermFuzzyScoredIndex temp = heap[i];
+        heap[i] = heap[lowest];
+        heap[lowest] = temp;
+        i = lowest;
+    }
+}
+
+// Fills |best| with the (at most |maximumCount|) highest-ranked of |count| scores, best first, and
+// returns how many it filled. indexes[i] identifies scores[i]; if indexes is NULL then i does.
+// |best| must have room for MIN(count, maximumCount) entries.
+static NSUInteger iTermFuzzySelectBest(const double *scores,
+                                       const NSUInteger *indexes,
+                                       NSUInteger count,
+                                       NSUInteger maximumCount,
+                                       iTermFuzzyScoredIndex *best) {
+    // |best| is a min-heap holding the best entries seen so far with the worst of them at the root.
+    NSUInteger size = 0;
+    for (NSUInteger i = 0; i < count; i++) {
+        const iTermFuzzyScoredIndex entry = { scores[i], indexes ? indexes[i] : i };
+        if (size < maximumCount) {
+            NSUInteger child = size++;
+            best[child] = entry;
+            while (child > 0) {
+                const NSUInteger parent = (child - 1) / 2;
+                if (!iTermFuzzyRanksBelow(best[child], best[parent])) {
+                    break;
+                }
+                const iTermFuzzyScoredIndex temp = best[child];
+                best[child] = best[parent];
+                best[parent] = temp;
+                child = parent;
+            }
+        } else if (size > 0 && iTermFuzzyRanksBelow(best[0], entry)) {
+            best[0] = entry;
+            iTermFuzzySiftDown(best, size, 0);
+        }
+    }
+
+    // Repeatedly move the worst to the end, leaving the best at the start.
+    for (NSUInteger end = size; end > 1; end--) {
+        const iTermFuzzyScoredIndex temp = best[0];
+        best[0] = best[end - 1];
+        best[end - 1] = temp;
+        iTermFuzzySiftDown(best, end - 1, 0);
+    }
+    return size;
+}
+
+@interface iTermFuzzyMatchDocument ()
+
+// The matcher's generation in which this document failed to match. See iTermFuzzyMatcher.
+@property(nonatomic) NSUInteger rejectedGeneration;
+
+- (instancetype)initWithString:(NSString *)string NS_DESIGNATED_INITIALIZER;
+
+@end
+
+@implementation iTermFuzzyMatchDocument {
+    NSInteger _length;  // Length of the lowercased string.
+    NSInteger _numberOfWords;  // Words per row of _bitmaps.
+    uint64_t _signature;
+    NSInteger _alphabetSize;
+    unichar *_alphabet;  // Sorted distinct characters of the lowercased string.
+    uint64_t *_bitmaps;  // One row per character in _alphabet, with a bit set where it occurs.
+}
+
+- (instancetype)initWithString:(NSString *)string {
+    self = [super init];
+    if (self) {
+        _string = [string copy];
+        NSString *lowercaseString = [string lowercaseString];
+        _length = lowercaseString.length;
+        _numberOfWords = (_length + 63) / 64;
+
+        unichar *characters = malloc(MAX(1, _length) * sizeof(unichar));
+        [lowercaseString getCharacters:characters range:NSMakeRange(0, _length)];
+        _signature = iTermFuzzySignature(characters, _length);
+
+        _alphabet = malloc(MAX(1, _length) * sizeof(unichar));
+        memcpy(_alphabet, characters, _length * sizeof(unichar));
+        qsort(_alphabet, _length, sizeof(unichar), iTermFuzzyCompareCharacters);
+        for (NSInteger i = 0; i < _length; i++) {
+            if (i == 0 || _alphabet[i] != _alphabet[_alphabetSize - 1]) {
+                _alphabet[_alphabetSize++] = _alphabet[i];
+            }
+        }
+
+        _bitmaps = calloc(MAX(1, _alphabetSize * _numberOfWords), sizeof(uint64_t));
+        for (NSInteger i = 0; i < _length; i++) {
+            uint64_t *row = (uint64_t *)[self rowForCharacter:characters[i]];
+            row[i >> 6] |= 1ULL << (i & 63);
+        }
+        free(characters);
+    }
+    return self;
+}
+
+- (void)dealloc {
+    [_string release];
+    free(_alphabet);
+    free(_bitmaps);
+    [super dealloc];
+}
+
+// Returns the bitmap of where |c| occurs, or NULL if it doesn't.
+- (const uint64_t *)rowForCharacter:(unichar)c {
+    NSInteger low = 0;
+    NSInteger high = _alphabetSize;
+    while (low < high) {
+        const NSInteger middle = (low + high) / 2;
+        if (_alphabet[middle] < c) {
+            low = middle + 1;
+        } else {
+            high = middle;
+        }
+    }
+    if (low == _alphabetSize || _alphabet[low] != c) {
+        return NULL;
+    }
+    return _bitmaps + low * _numberOfWords;
+}
+
+// Finds where the shortest span containing the query as a subsequence starts. Fills in
+// query->rows, which -enumerateMatchStartingAt:query:block: then uses.
+- (BOOL)getStart:(NSInteger *)startPtr ofShortestMatchForQuery:(iTermFuzzyQuery *)query {
+    if (query->length == 0 ||
+        query->length > _length ||
+        (query->signature & ~_signature)) {
+        return NO;
+    }
+    for (NSInteger i = 0; i < query->length; i++) {
+        query->rows[i] = [self rowForCharacter:query->characters[i]];
+        if (!query->rows[i]) {
+            return NO;
+        }
+    }
+
+    // For each occurrence of the first character, the earliest match beginning there takes the
+    // earliest occurrence of each following character. Keep the shortest.
+    NSInteger bestStart = -1;
+    NSInteger bestSpan = 0;
+    NSInteger start = iTermFuzzyNextOccurrence(query->rows[0], _numberOfWords, -1);
+    while (start >= 0) {
+        NSInteger end = start;
+        for (NSInteger i = 1; i < query->length && end >= 0; i++) {
+            end = iTermFuzzyNextOccurrence(query->rows[i], _numberOfWords, end);
+        }
+        if (end < 0) {
+            // Starting later can't help.
+            break;
+        }
+        const NSInteger span = end - start;
+        if (bestStart < 0 || span < bestSpan) {
+            bestStart = start;
+            bestSpan = span;
+        }
+        if (span == query->length - 1) {
+            // Can't do better than consecutive characters.
+            break;
+        }
+        start = iTermFuzzyNextOccurrence(query->rows[0], _numberOfWords, start);
+    }
+    if (bestStart < 0) {
+        return NO;
+    }
+    *startPtr = bestStart;
+    return YES;
+}
+
+// Calls |block| with the document offset of each character of the match beginning at |start|.
+- (void)enumerateMatchStartingAt:(NSInteger)start
+                           query:(const iTermFuzzyQuery *)query
+                           block:(void (^ NS_NOESCAPE)(NSInteger offset))block {
+    NSInteger offset = start;
+    block(offset);
+    for (NSInteger i = 1; i < query->length; i++) {
+        offset = iTermFuzzyNextOccurrence(query->rows[i], _numberOfWords, offset);
+        block(offset);
+    }
+}
+
+- (double)qualityOfMatchForQuery:(iTermFuzzyQuery *)query {
+    NSInteger start;
+    if (![self getStart:&start ofShortestMatchForQuery:query]) {
+        return 0;
+    }
+    __block NSInteger numberOfRuns = 0;
+    __block NSInteger last = -2;
+    [self enumerateMatchStartingAt:start query:query block:^(NSInteger offset) {
+        if (offset != last + 1) {
+            numberOfRuns++;
+        }
+        last = offset;
+    }];
+    if (start == 0 && last == _length - 1) {
+        return 1;
+    }
+    if (start == 0) {
+        return 0.9;
+    }
+    return 0.5 / numberOfRuns;
+}
+
+- (NSIndexSet *)indexSetForQuery:(iTermFuzzyQuery *)query {
+    NSInteger start;
+    if (![self getStart:&start ofShortestMatchForQuery:query]) {
+        return nil;
+    }
+    NSMutableIndexSet *indexSet = [NSMutableIndexSet indexSet];
+    [self enumerateMatchStartingAt:start query:query block:^(NSInteger offset) {
+        [indexSet addIndex:offset];
+    }];
+    return indexSet;
+}
+
+@end
+
+@implementation iTermFuzzyMatcher {
+    // Prepared documents by string.
+    NSMutableDictionary<NSString *, iTermFuzzyMatchDocument *> *_documents;
+
+    // The lowercased query.
+    NSString *_lowercaseQuery;
+    unichar *_queryCharacters;
+    const uint64_t **_rows;
+    iTermFuzzyQuery _fuzzyQuery;
+
+    // Incremented whenever the query changes other than by being extended. Documents remember the
+    // generation in which they failed to match so they can be skipped until it changes.
+    NSUInteger _generation;
+
+    // Candidates given at initialization, in order.
+    NSArray<iTermFuzzyMatchDocument *> *_candidates;
+
+    // Indexes into _candidates of those matching the query, and their qualities.
+    NSUInteger *_survivors;
+    double *_qualities;
+    NSUInteger _numberOfSurvivors;
+}
+
+- (instancetype)init {
+    return [self initWithStrings:@[]];
+}
+
+- (instancetype)initWithStrings:(NSArray<NSString *> *)strings {
+    self = [super init];
+    if (self) {
+        _documents = [[NSMutableDictionary alloc] init];
+        _query = [@"" retain];
+        _lowercaseQuery = [@"" retain];
+        _generation = 1;
+
+        NSMutableArray<iTermFuzzyMatchDocument *> *candidates = [NSMutableArray arrayWithCapacity:strings.count];
+        for (NSString *string in strings) {
+            [candidates addObject:[self documentForString:string]];
+        }
+        _candidates = [candidates copy];
+        _survivors = malloc(MAX(1, _candidates.count) * sizeof(*_survivors));
+        _qualities = malloc(MAX(1, _candidates.count) * sizeof(*_qualities));
+        for (NSUInteger i = 0; i < _candidates.count; i++) {
+            _survivors[i] = i;
+            _qualities[i] = 0;
+        }
+        _numberOfSurvivors = _candidates.count;
+    }
+    return self;
+}
+
+- (void)dealloc {
+    [_documents release];
+    [_query release];
+    [_lowercaseQuery release];
+    [_candidates release];
+    free(_queryCharacters);
+    free(_rows);
+    free(_survivors);
+    free(_qualities);
+    [super dealloc];
+}
+
+- (void)setQuery:(NSString *)query {
+    NSString *lowercaseQuery = [query lowercaseString];
+    // A document that doesn't contain a query can't contain any extension of it.
+    const BOOL narrowing = (_lowercaseQuery.length > 0 && [lowercaseQuery hasPrefix:_lowercaseQuery]);
+    if (!narrowing) {
+        _generation++;
+    }
+
+    [_query autorelease];
+    _query = [query copy];
+    [_lowercaseQuery release];
+    _lowercaseQuery = [lowercaseQuery copy];
+
+    const NSInteger length = _lowercaseQuery.length;
+    free(_queryCharacters);
+    free(_rows);
+    _queryCharacters = malloc(MAX(1, length) * sizeof(unichar));
+    _rows = malloc(MAX(1, length) * sizeof(*_rows));
+    [_lowercaseQuery getCharacters:_queryCharacters range:NSMakeRange(0, length)];
+    _fuzzyQuery.characters = _queryCharacters;
+    _fuzzyQuery.length = length;
+    _fuzzyQuery.signature = iTermFuzzySignature(_queryCharacters, length);
+    _fuzzyQuery.rows = _rows;
+
+    [self narrowCandidates:narrowing];
+}
+
+// Recomputes _survivors, examining only the current ones if |narrowing|.
+- (void)narrowCandidates:(BOOL)narrowing {
+    const NSUInteger count = narrowing ? _numberOfSurvivors : _candidates.count;
+    NSUInteger numberOfSurvivors = 0;
+    for (NSUInteger i = 0; i < count; i++) {
+        const NSUInteger index = narrowing ? _survivors[i] : i;
+        const double quality = [self qualityOfMatchForDocument:_candidates[index]];
+        if (quality > 0 || _fuzzyQuery.length == 0) {
+            _survivors[numberOfSurvivors] = index;
+            _qualities[numberOfSurvivors] = quality;
+            numberOfSurvivors++;
+        }
+    }
+    _numberOfSurvivors = numberOfSurvivors;
+}
+
+- (iTermFuzzyMatchDocument *)documentForString:(NSString *)string {
+    iTermFuzzyMatchDocument *document = _documents[string];
+    if (!document) {
+        document = [[[iTermFuzzyMatchDocument alloc] initWithString:string] autorelease];
+        _documents[string] = document;
+    }
+    return document;
+}
+
+- (double)qualityOfMatchForDocument:(iTermFuzzyMatchDocument *)document {
+    if (document.rejectedGeneration == _generation) {
+        return 0;
+    }
+    const double quality = [document qualityOfMatchForQuery:&_fuzzyQuery];
+    if (quality == 0 && _fuzzyQuery.length > 0) {
+        document.rejectedGeneration = _generation;
+    }
+    return quality;
+}
+
+- (NSIndexSet *)indexSetForDocument:(iTermFuzzyMatchDocument *)document {
+    if (document.rejectedGeneration == _generation) {
+        return nil;
+    }
+    return [document indexSetForQuery:&_fuzzyQuery];
+}
+
+- (NSArray<NSNumber *> *)indexesOfBestMatchesWithMaximumCount:(NSUInteger)maximumCount {
+    const NSUInteger capacity = MIN(maximumCount, _numberOfSurvivors);
+    iTermFuzzyScoredIndex *best = malloc(MAX(1, capacity) * sizeof(*best));
+    const NSUInteger count = iTermFuzzySelectBest(_qualities, _survivors, _numberOfSurvivors, maximumCount, best);
+    NSMutableArray<NSNumber *> *indexes = [NSMutableArray arrayWithCapacity:count];
+    for (NSUInteger i = 0; i < count; i++) {
+        [indexes addObject:@(best[i].index)];
+    }
+    free(best);
+    return indexes;
+}
+
++ (NSArray *)bestObjects:(NSArray *)objects
+            maximumCount:(NSUInteger)maximumCount
+                   score:(double (^ NS_NOESCAPE)(id object))score {
+    const NSUInteger count = objects.count;
+    double *scores = malloc(MAX(1, count) * sizeof(*scores));
+    NSUInteger i = 0;
+    for (id object in objects) {
+        scores[i++] = score(object);
+    }
+    iTermFuzzyScoredIndex *best = malloc(MAX(1, MIN(count, maximumCount)) * sizeof(*best));
+    const NSUInteger numberOfBest = iTermFuzzySelectBest(scores, NULL, count, maximumCount, best);
+    NSMutableArray *result = [NSMutableArray arrayWithCapacity:numberOfBest];
+    for (i = 0; i < numberOfBest; i++) {
+        [result addObject:objects[best[i].index]];
+    }
+    free(best);
+    free(scores);
+    return result;
+}
+
+@end
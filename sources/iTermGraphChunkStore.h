@@ -0,0 +1,66 @@
+//
+//  iTermGraphChunkStore.h
+//  iTerm2SharedARC
+//
+//  Created by George Nachman on 10/18/26.
+//
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+@class iTermGraphDatabaseWriter;
+
+// Large node payloads, like the encoded blocks of a session's scrollback, are split into
+// content-defined chunks kept in the Chunk table under their SHA-256. The node's data column holds
+// a manifest listing its chunks. Chunk boundaries depend only on nearby content, so when a block
+// grows only the chunks around the changes are new and only those are written.
+//
+// This tracks which chunks each node uses so unreferenced chunks can be deleted. Changes made
+// during a save are pending until -commit and are discarded by -rollback. Use on the database's
+// thread only.
+@interface iTermGraphChunkStore: NSObject
+
+// Payloads shorter than this are stored inline. Tests may change it.
+@property (nonatomic) NSUInteger minimumChunkedLength;
+
+// Splits data into boundaries. Exposed for tests.
++ (NSArray<NSValue *> *)chunkRangesForData:(NSData *)data;
+
++ (BOOL)isManifest:(NSData *)data;
+
+// Forget everything, as when the database has been deleted.
+- (void)reset;
+
+#pragma mark - Loading
+
+// `chunks` maps hash to chunk data for the whole Chunk table. Returns the node's payload (which is
+// `stored` itself unless it is a manifest) or nil if a chunk is missing.
+- (NSData * _Nullable)loadStoredData:(NSData *)stored
+                               rowid:(NSNumber *)rowid
+                              chunks:(NSDictionary<NSData *, NSData *> *)chunks;
+
+// After loading, returns chunks in the table that no node uses.
+- (NSArray<NSData *> *)unreferencedHashesIn:(NSArray<NSData *> *)hashes;
+
+#pragma mark - Saving
+
+// Returns what to store in the node's data column. Queues any chunks not already in the table.
+// `hashes` is set to the chunks the manifest refers to, or nil if the data is stored inline. Pass
+// it to -setChunks:forRowID: once the node's rowid is known.
+- (NSData *)storedDataForData:(NSData *)data
+                       writer:(iTermGraphDatabaseWriter *)writer
+                       hashes:(out NSArray<NSData *> * _Nullable * _Nonnull)hashes;
+
+- (void)setChunks:(NSArray<NSData *> * _Nullable)hashes forRowID:(NSNumber *)rowid;
+- (void)removeRowID:(NSNumber *)rowid;
+
+// Queues deletion of chunks that no node uses any more. Call before flushing the writer.
+- (BOOL)finishSaveWithWriter:(iTermGraphDatabaseWriter *)writer;
+
+- (void)commit;
+- (void)rollback;
+
+@end
+
+NS_ASSUME_NONNULL_END
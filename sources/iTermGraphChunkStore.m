@@ -0,0 +1,257 @@
+//
+//  iTermGraphChunkStore.m
+//  iTerm2SharedARC
+//
+//  Created by George Nachman on 10/18/26.
+//
+
+#import "iTermGraphChunkStore.h"
+
+#import "DebugLogging.h"
+#import "NSData+iTerm.h"
+#import "NSObject+iTerm.h"
+#import "iTermGraphDatabaseWriter.h"
+
+#import <CommonCrypto/CommonDigest.h>
+
+// Chunk sizes. The average is about 4k because a tail block gets rewritten on nearly every save
+// and only the chunks around each change are new.
+static const size_t iTermGraphChunkMinimumLength = 1024;
+static const size_t iTermGraphChunkMaximumLength = 16384;
+// A boundary is placed where the top 12 bits of the rolling hash are zero.
+static const uint64_t iTermGraphChunkBoundaryMask = 0xfff0000000000000ULL;
+
+// A manifest is this magic number followed by (SHA-256, little-endian uint32 length) for each
+// chunk. Inline payloads are keyed archives, which begin with "bplist", so they can't collide.
+static const char iTermGraphChunkManifestMagic[8] = { 'i', 'T', 'C', 'h', 'u', 'n', 'k', '1' };
+
+typedef struct __attribute__((packed)) {
+    unsigned char hash[CC_SHA256_DIGEST_LENGTH];
+    uint32_t length;
+} iTermGraphChunkManifestEntry;
+
+// Gear table for the rolling hash. It must never change, or chunks written by earlier sessions
+// would stop deduplicating, so it is generated from a fixed seed.
+static const uint64_t *iTermGraphChunkGearTable(void) {
+    static uint64_t table[256];
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        uint64_t state = 0x6954657232476561ULL;
+        for (int i = 0; i < 256; i++) {
+            // splitmix64
+            state += 0x9e3779b97f4a7c15ULL;
+            uint64_t z = state;
+            z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+            z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+            table[i] = z ^ (z >> 31);
+        }
+    });
+    return table;
+}
+
+// Returns the length of the chunk that begins at bytes. The first iTermGraphChunkMinimumLength
+// bytes are skipped, as in FastCDC; the hash only depends on the last 64 bytes it has seen, so
+// boundaries realign shortly after an edit.
+static size_t iTermGraphChunkNextLength(const unsigned char *bytes, size_t length, const uint64_t *gear) {
+    if (length <= iTermGraphChunkMinimumLength) {
+        return length;
+    }
+    const size_t end = MIN(length, iTermGraphChunkMaximumLength);
+    uint64_t fingerprint = 0;
+    for (size_t i = iTermGraphChunkMinimumLength; i < end; i++) {
+        fingerprint = (fingerprint << 1) + gear[bytes[i]];
+        if (!(fingerprint & iTermGraphChunkBoundaryMask)) {
+            return i + 1;
+        }
+    }
+    return end;
+}
+
+@implementation iTermGraphChunkStore {
+    // Committed state: the chunks each chunked node uses and how many nodes use each chunk.
+    NSMutableDictionary<NSNumber *, NSArray<NSData *> *> *_manifests;
+    NSCountedSet<NSData *> *_referenceCounts;
+
+    // Changes made by the current save. A value of NSNull means the node is gone.
+    NSMutableDictionary<NSNumber *, id> *_pendingManifests;
+    // Chunks queued for insertion by the current save.
+    NSMutableSet<NSData *> *_pendingInsertions;
+}
+
+- (instancetype)init {
+    self = [super init];
+    if (self) {
+        _minimumChunkedLength = 8192;
+        _manifests = [NSMutableDictionary dictionary];
+        _referenceCounts = [[NSCountedSet alloc] init];
+        _pendingManifests = [NSMutableDictionary dictionary];
+        _pendingInsertions = [NSMutableSet set];
+    }
+    return self;
+}
+
++ (NSArray<NSValue *> *)chunkRangesForData:(NSData *)data {
+    const uint64_t *gear = iTermGraphChunkGearTable();
+    const unsigned char *bytes = data.bytes;
+    NSMutableArray<NSValue *> *ranges = [NSMutableArray array];
+    size_t offset = 0;
+    while (offset < data.length) {
+        const size_t length = iTermGraphChunkNextLength(bytes + offset, data.length - offset, gear);
+        [ranges addObject:[NSValue valueWithRange:NSMakeRange(offset, length)]];
+        offset += length;
+    }
+    return ranges;
+}
+
++ (BOOL)isManifest:(NSData *)data {
+    return (data.length >= sizeof(iTermGraphChunkManifestMagic) &&
+            (data.length - sizeof(iTermGraphChunkManifestMagic)) % sizeof(iTermGraphChunkManifestEntry) == 0 &&
+            !memcmp(data.bytes, iTermGraphChunkManifestMagic, sizeof(iTermGraphChunkManifestMagic)));
+}
+
+- (void)reset {
+    [_manifests removeAllObjects];
+    [_referenceCounts removeAllObjects];
+    [self rollback];
+}
+
+#pragma mark - Loading
+
+- (NSData *)loadStoredData:(NSData *)stored
+                     rowid:(NSNumber *)rowid
+                    chunks:(NSDictionary<NSData *, NSData *> *)chunks {
+    if (![iTermGraphChunkStore isManifest:stored]) {
+        return stored;
+    }
+    const NSUInteger count = (stored.length - sizeof(iTermGraphChunkManifestMagic)) / sizeof(iTermGraphChunkManifestEntry);
+    const unsigned char *entries = (const unsigned char *)stored.bytes + sizeof(iTermGraphChunkManifestMagic);
+    NSMutableArray<NSData *> *hashes = [NSMutableArray arrayWithCapacity:count];
+    NSMutableData *data = [NSMutableData data];
+    for (NSUInteger i = 0; i < count; i++) {
+        iTermGraphChunkManifestEntry entry;
+        memcpy(&entry, entries + i * sizeof(entry), sizeof(entry));
+        NSData *hash = [NSData dataWithBytes:entry.hash length:sizeof(entry.hash)];
+        NSData *chunk = chunks[hash];
+        if (chunk.length != OSSwapLittleToHostInt32(entry.length)) {
+            DLog(@"Chunk %@ of rowid %@ is missing or has the wrong length", hash.it_hexEncoded, rowid);
+            return nil;
+        }
+        [data appendData:chunk];
+        [hashes addObject:hash];
+    }
+    _manifests[rowid] = hashes;
+    for (NSData *hash in hashes) {
+        [_referenceCounts addObject:hash];
+    }
+    return data;
+}
+
+- (NSArray<NSData *> *)unreferencedHashesIn:(NSArray<NSData *> *)hashes {
+    NSMutableArray<NSData *> *result = [NSMutableArray array];
+    for (NSData *hash in hashes) {
+        if ([_referenceCounts countForObject:hash] == 0) {
+            [result addObject:hash];
+        }
+    }
+    return result;
+}
+
+#pragma mark - Saving
+
+- (NSData *)storedDataForData:(NSData *)data
+                       writer:(iTermGraphDatabaseWriter *)writer
+                       hashes:(out NSArray<NSData *> **)hashesOut {
+    if (data.length < _minimumChunkedLength) {
+        *hashesOut = nil;
+        return data;
+    }
+    NSArray<NSValue *> *ranges = [iTermGraphChunkStore chunkRangesForData:data];
+    NSMutableData *manifest = [NSMutableData dataWithBytes:iTermGraphChunkManifestMagic
+                                                    length:sizeof(iTermGraphChunkManifestMagic)];
+    NSMutableArray<NSData *> *hashes = [NSMutableArray arrayWithCapacity:ranges.count];
+    for (NSValue *value in ranges) {
+        const NSRange range = value.rangeValue;
+        iTermGraphChunkManifestEntry entry;
+        CC_SHA256((const unsigned char *)data.bytes + range.location, (CC_LONG)range.length, entry.hash);
+        entry.length = OSSwapHostToLittleInt32((uint32_t)range.length);
+        [manifest appendBytes:&entry length:sizeof(entry)];
+
+        NSData *hash = [NSData dataWithBytes:entry.hash length:sizeof(entry.hash)];
+        [hashes addObject:hash];
+        if ([_referenceCounts countForObject:hash] == 0 && ![_pendingInsertions containsObject:hash]) {
+            [_pendingInsertions addObject:hash];
+            [writer insertChunkWithHash:hash data:[data subdataWithRange:range]];
+        }
+    }
+    *hashesOut = hashes;
+    return manifest;
+}
+
+- (void)setChunks:(NSArray<NSData *> *)hashes forRowID:(NSNumber *)rowid {
+    if (hashes) {
+        _pendingManifests[rowid] = hashes;
+    } else {
+        [self removeRowID:rowid];
+    }
+}
+
+- (void)removeRowID:(NSNumber *)rowid {
+    _pendingManifests[rowid] = [NSNull null];
+}
+
+// Net change in reference count for each chunk touched by pending changes.
+- (NSDictionary<NSData *, NSNumber *> *)pendingDeltas {
+    NSMutableDictionary<NSData *, NSNumber *> *deltas = [NSMutableDictionary dictionary];
+    [_pendingManifests enumerateKeysAndObjectsUsingBlock:^(NSNumber *rowid, id value, BOOL *stop) {
+        for (NSData *hash in self->_manifests[rowid]) {
+            deltas[hash] = @(deltas[hash].integerValue - 1);
+        }
+        NSArray<NSData *> *hashes = [NSArray castFrom:value];
+        for (NSData *hash in hashes) {
+            deltas[hash] = @(deltas[hash].integerValue + 1);
+        }
+    }];
+    return deltas;
+}
+
+- (BOOL)finishSaveWithWriter:(iTermGraphDatabaseWriter *)writer {
+    __block BOOL ok = YES;
+    [[self pendingDeltas] enumerateKeysAndObjectsUsingBlock:^(NSData *hash, NSNumber *delta, BOOL *stop) {
+        const NSInteger count = [self->_referenceCounts countForObject:hash] + delta.integerValue;
+        assert(count >= 0);
+        if (count == 0 && delta.integerValue < 0) {
+            if (![writer deleteChunkWithHash:hash]) {
+                ok = NO;
+                *stop = YES;
+            }
+        }
+    }];
+    return ok;
+}
+
+- (void)commit {
+    [[self pendingDeltas] enumerateKeysAndObjectsUsingBlock:^(NSData *hash, NSNumber *delta, BOOL *stop) {
+        for (NSInteger i = 0; i < delta.integerValue; i++) {
+            [self->_referenceCounts addObject:hash];
+        }
+        for (NSInteger i = 0; i > delta.integerValue; i--) {
+            [self->_referenceCounts removeObject:hash];
+        }
+    }];
+    [_pendingManifests enumerateKeysAndObjectsUsingBlock:^(NSNumber *rowid, id value, BOOL *stop) {
+        NSArray<NSData *> *hashes = [NSArray castFrom:value];
+        if (hashes) {
+            self->_manifests[rowid] = hashes;
+        } else {
+            [self->_manifests removeObjectForKey:rowid];
+        }
+    }];
+    [self rollback];
+}
+
+- (void)rollback {
+    [_pendingManifests removeAllObjects];
+    [_pendingInsertions removeAllObjects];
+}
+
+@end
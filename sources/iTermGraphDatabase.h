@@ -23,6 +23,10 @@ NS_ASSUME_NONNULL_BEGIN
 
 // Tests only!
 @property (nonatomic, readonly) id<iTermDatabase> db;
+// Tests only! Total size of changed node payloads saved so far, and the number of bytes actually
+// written for them after deduplicating chunks.
+@property (atomic, readonly) NSUInteger bytesEncoded;
+@property (atomic, readonly) NSUInteger bytesWritten;
 
 - (instancetype)initWithDatabase:(id<iTermDatabase>)db NS_DESIGNATED_INITIALIZER;
 - (instancetype)init NS_UNAVAILABLE;
@@ -11,6 +11,8 @@
 #import "FMDatabase.h"
 #import "NSArray+iTerm.h"
 #import "NSObject+iTerm.h"
+#import "iTermGraphChunkStore.h"
+#import "iTermGraphDatabaseWriter.h"
 #import "iTermGraphDeltaEncoder.h"
 #import "iTermGraphTableTransformer.h"
 #import "iTermThreadSafety.h"
@@ -20,6 +22,7 @@
 
 @interface iTermGraphDatabaseState: iTermSynchronizedState<iTermGraphDatabaseState *>
 @property (nonatomic, strong) id<iTermDatabase> db;
+@property (nonatomic, readonly) iTermGraphChunkStore *chunkStore;
 // Load complete means that the initial attempt to load the DB has finished. It may have failed, leaving
 // us without any state, but it is now safe to proceed to use the graph DB as it won't change out
 // from under you after this point.
@@ -35,6 +38,7 @@
     self = [super initWithQueue:queue];
     if (self) {
         _db = db;
+        _chunkStore = [[iTermGraphChunkStore alloc] init];
         _loadCompleteBlocks = [NSMutableArray array];
     }
     return self;
@@ -66,6 +70,8 @@
 
 @interface iTermGraphDatabase()
 @property (atomic, readwrite) iTermEncoderGraphRecord *record;
+@property (atomic, readwrite) NSUInteger bytesEncoded;
+@property (atomic, readwrite) NSUInteger bytesWritten;
 @end
 
 @implementation iTermGraphDatabase {
@@ -184,6 +190,7 @@
 - (void)reallyInvalidate:(iTermGraphDatabaseState *)state {
     _invalid = YES;
     [state.db executeUpdate:@"delete from Node"];
+    [state.db executeUpdate:@"delete from Chunk"];
     [state.db close];
     state.db = nil;
 }
@@ -264,6 +271,7 @@
     }
     [state.db close];
     [state.db unlink];
+    [state.chunkStore reset];
     if (![self openAndInitializeDatabase:state]) {
         DLog(@"Failed to open and initialize datbase after deleting it.");
         return NO;
@@ -289,7 +297,10 @@
     const BOOL ok = [state.db transaction:^BOOL{
         return [self reallySave:encoder state:state];
     }];
-    if (!ok) {
+    if (ok) {
+        [state.chunkStore commit];
+    } else {
+        [state.chunkStore rollback];
         [encoder.record eraseRowIDs];
         DLog(@"Commit transaction failed: %@", state.db.lastError);
     }
@@ -301,6 +312,9 @@
              state:(iTermGraphDatabaseState *)state {
     DLog(@"Start saving");
     NSDate *start = [NSDate date];
+    iTermGraphDatabaseWriter *writer = [[iTermGraphDatabaseWriter alloc] initWithDatabase:state.db];
+    iTermGraphChunkStore *chunkStore = state.chunkStore;
+    __block NSUInteger bytesEncoded = 0;
     const BOOL ok =
     [encoder enumerateRecords:^(iTermEncoderGraphRecord * _Nullable before,
                                 iTermEncoderGraphRecord * _Nullable after,
@@ -313,26 +327,36 @@
                                          userInfo:nil];
         }
         if (before && !after) {
-            if (![state.db executeUpdate:@"delete from Node where rowid=?", before.rowid]) {
+            [chunkStore removeRowID:before.rowid];
+            if (![writer deleteNodeWithRowID:before.rowid]) {
                 *stop = YES;
                 return;
             }
             return;
         }
         if (!before && after) {
-            if (![state.db executeUpdate:@"insert into Node (key, identifier, parent, data) values (?, ?, ?, ?)",
-                  after.key, after.identifier, parent, after.data ?: [NSData data]]) {
+            // The writer assigns the rowid now so that children, which are enumerated next, can
+            // refer to it even though the row may not have been written yet.
+            NSData *data = after.data ?: [NSData data];
+            bytesEncoded += data.length;
+            NSArray<NSData *> *hashes = nil;
+            NSNumber *rowid = [writer insertNodeWithKey:after.key
+                                             identifier:after.identifier
+                                                 parent:parent
+                                                   data:[chunkStore storedDataForData:data
+                                                                               writer:writer
+                                                                               hashes:&hashes]];
+            if (!rowid) {
                 *stop = YES;
                 return;
             }
-            NSNumber *lastInsertRowID = state.db.lastInsertRowId;
+            [chunkStore setChunks:hashes forRowID:rowid];
             if (parent.integerValue == 0) {
-                DLog(@"Insert root node with path %@, rowid %@", path, lastInsertRowID);
+                DLog(@"Insert root node with path %@, rowid %@", path, rowid);
             }
-            assert(lastInsertRowID);
             @try {
                 // Issue 9117
-                after.rowid = lastInsertRowID;
+                after.rowid = rowid;
             } @catch (NSException *exception) {
                 @throw [exception it_rethrowWithMessage:@"after.key=%@ after.identifier=%@", after.key, after.identifier];
             }
@@ -352,19 +376,35 @@
                 }
             }
             assert(before.rowid.longLongValue == after.rowid.longLongValue);
-            if ([before.data isEqual:after.data]) {
+            // Getting the data also computes after.contentHash. before.contentHash was remembered
+            // when it was saved, so the previous revision is not encoded again.
+            NSData *data = after.data ?: [NSData data];
+            if ([before.contentHash isEqual:after.contentHash]) {
                 return;
             }
-            if (![state.db executeUpdate:@"update Node set data=? where rowid=?", after.data, before.rowid]) {
+            bytesEncoded += data.length;
+            NSArray<NSData *> *hashes = nil;
+            NSData *stored = [chunkStore storedDataForData:data writer:writer hashes:&hashes];
+            [chunkStore setChunks:hashes forRowID:before.rowid];
+            if (![writer updateNodeWithRowID:before.rowid
+                                         key:after.key
+                                  identifier:after.identifier
+                                      parent:parent
+                                        data:stored]) {
                 *stop = YES;
             }
             return;
         }
         assert(NO);
     }];
+    const BOOL flushed = ok && [chunkStore finishSaveWithWriter:writer] && [writer flush];
+    if (flushed) {
+        self.bytesEncoded += bytesEncoded;
+        self.bytesWritten += writer.bytesWritten;
+    }
     NSDate *end = [NSDate date];
     DLog(@"Save duration: %f0.1ms", (end.timeIntervalSinceNow - start.timeIntervalSinceNow) * 1000);
-    return ok;
+    return flushed;
 }
 
 - (BOOL)createTables:(iTermGraphDatabaseState *)state {
@@ -374,6 +414,10 @@
         return NO;
     }
     [state.db executeUpdate:@"create index if not exists parent_index on Node (parent)"];
+    // Content-addressed pieces of large node payloads. See iTermGraphChunkStore.
+    if (![state.db executeUpdate:@"create table if not exists Chunk (hash blob primary key, data blob not null)"]) {
+        return NO;
+    }
 
     // Delete nodes without parents.
     [state.db executeUpdate:
@@ -409,22 +453,69 @@
 - (iTermEncoderGraphRecord * _Nullable)load:(iTermGraphDatabaseState *)state
                                       error:(out NSError **)error {
     DLog(@"load");
+    NSMutableDictionary<NSData *, NSData *> *chunks = [NSMutableDictionary dictionary];
+    {
+        DLog(@"select from Chunk...");
+        FMResultSet *rs = [state.db executeQuery:@"select hash, data from Chunk"];
+        while ([rs next]) {
+            NSData *hash = [rs dataForColumn:@"hash"];
+            NSData *data = [rs dataForColumn:@"data"];
+            if (hash && data) {
+                chunks[hash] = data;
+            }
+        }
+        [rs close];
+    }
     NSMutableArray<NSArray *> *nodes = [NSMutableArray array];
     {
         DLog(@"select from Node...");
         FMResultSet *rs = [state.db executeQuery:@"select key, identifier, parent, rowid, data from Node"];
         while ([rs next]) {
             DLog(@"Read row");
+            NSNumber *rowid = @([rs longLongIntForColumn:@"rowid"]);
+            NSData *data = [state.chunkStore loadStoredData:[rs dataForColumn:@"data"] ?: [NSData data]
+                                                      rowid:rowid
+                                                     chunks:chunks];
+            if (!data) {
+                [rs close];
+                [state.chunkStore reset];
+                if (error) {
+                    *error = [NSError errorWithDomain:@"com.iterm2.graph-db"
+                                                 code:1
+                                             userInfo:@{ NSLocalizedDescriptionKey: @"Missing chunk" }];
+                }
+                return nil;
+            }
             [nodes addObject:@[ [rs stringForColumn:@"key"],
                                 [rs stringForColumn:@"identifier"],
                                 @([rs longLongIntForColumn:@"parent"]),
-                                @([rs longLongIntForColumn:@"rowid"]),
-                                [rs dataForColumn:@"data"] ?: [NSData data] ]];
+                                rowid,
+                                data ]];
         }
         DLog(@"Select done");
         [rs close];
     }
 
+    // Chunks are left behind when -createTables: deletes orphaned nodes.
+    NSArray<NSData *> *unreferenced = [state.chunkStore unreferencedHashesIn:chunks.allKeys];
+    if (unreferenced.count) {
+        DLog(@"Delete %@ unreferenced chunks", @(unreferenced.count));
+        // In a transaction, like chunk writes made while saving, so they're all deleted or none
+        // are. Any left behind are found again on the next load.
+        const BOOL ok = [state.db transaction:^BOOL{
+            iTermGraphDatabaseWriter *writer = [[iTermGraphDatabaseWriter alloc] initWithDatabase:state.db];
+            for (NSData *hash in unreferenced) {
+                if (![writer deleteChunkWithHash:hash]) {
+                    return NO;
+                }
+            }
+            return [writer flush];
+        }];
+        if (!ok) {
+            DLog(@"Failed to delete unreferenced chunks: %@", state.db.lastError);
+        }
+    }
+
     DLog(@"Begin transforming");
     iTermGraphTableTransformer *transformer = [[iTermGraphTableTransformer alloc] initWithNodeRows:nodes];
     iTermEncoderGraphRecord *record = transformer.root;
@@ -0,0 +1,54 @@
+//
+//  iTermGraphDatabaseWriter.h
+//  iTerm2SharedARC
+//
+//  Created by George Nachman on 10/18/26.
+//
+
+#import <Foundation/Foundation.h>
+
+#import "iTermDatabase.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+// Writes the changes from one save of an iTermGraphDatabase to its Node table. Changes are queued
+// and written in multi-row batches whose SQL text repeats from save to save, so SQLite can reuse
+// the prepared statements. New nodes are assigned rowids when they are queued, which lets a child
+// be queued before its parent has been written.
+//
+// Use one writer per transaction.
+@interface iTermGraphDatabaseWriter: NSObject
+
+// Number of blob bytes queued for writing, for measuring write amplification.
+@property (nonatomic, readonly) NSUInteger bytesWritten;
+
+- (instancetype)initWithDatabase:(id<iTermDatabase>)db NS_DESIGNATED_INITIALIZER;
+- (instancetype)init NS_UNAVAILABLE;
+
+// Returns the rowid the new node will have, or nil if a write has failed.
+- (NSNumber * _Nullable)insertNodeWithKey:(NSString *)key
+                               identifier:(NSString *)identifier
+                                   parent:(NSNumber *)parent
+                                     data:(NSData *)data;
+
+// Replaces the data of an existing node. Returns NO if a write has failed.
+- (BOOL)updateNodeWithRowID:(NSNumber *)rowid
+                        key:(NSString *)key
+                 identifier:(NSString *)identifier
+                     parent:(NSNumber *)parent
+                       data:(NSData *)data;
+
+// Returns NO if a write has failed.
+- (BOOL)deleteNodeWithRowID:(NSNumber *)rowid;
+
+// Chunks are content-addressed, so inserting one that is already present is harmless. Returns NO
+// if a write has failed.
+- (BOOL)insertChunkWithHash:(NSData *)hash data:(NSData *)data;
+- (BOOL)deleteChunkWithHash:(NSData *)hash;
+
+// Writes everything that is still queued. Returns NO if any write failed.
+- (BOOL)flush;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,259 @@
+//
+//  iTermGraphDatabaseWriter.m
+//  iTerm2SharedARC
+//
+//  Created by George Nachman on 10/18/26.
+//
+
+#import "iTermGraphDatabaseWriter.h"
+
+#import "DebugLogging.h"
+
+// Older versions of SQLite allow at most 999 parameters per statement. Upserts take five per row.
+static const NSInteger iTermGraphDatabaseWriterBatchSize = 100;
+
+static NSString *iTermGraphDatabaseWriterStatement(NSString *prefix,
+                                                   NSString *row,
+                                                   NSString *separator,
+                                                   NSString *suffix,
+                                                   NSInteger count) {
+    NSMutableString *sql = [prefix mutableCopy];
+    for (NSInteger i = 0; i < count; i++) {
+        if (i > 0) {
+            [sql appendString:separator];
+        }
+        [sql appendString:row];
+    }
+    [sql appendString:suffix];
+    return sql;
+}
+
+@implementation iTermGraphDatabaseWriter {
+    id<iTermDatabase> _db;
+    // Flattened (rowid, key, identifier, parent, data) tuples.
+    NSMutableArray *_upserts;
+    NSMutableArray<NSNumber *> *_deletes;
+    // Flattened (hash, data) pairs.
+    NSMutableArray *_chunkInsertions;
+    NSMutableArray<NSData *> *_chunkDeletions;
+    long long _nextRowID;
+    BOOL _failed;
+}
+
+- (instancetype)initWithDatabase:(id<iTermDatabase>)db {
+    self = [super init];
+    if (self) {
+        _db = db;
+        _upserts = [NSMutableArray array];
+        _deletes = [NSMutableArray array];
+        _chunkInsertions = [NSMutableArray array];
+        _chunkDeletions = [NSMutableArray array];
+    }
+    return self;
+}
+
+#pragma mark - APIs
+
+- (NSNumber *)insertNodeWithKey:(NSString *)key
+                     identifier:(NSString *)identifier
+                         parent:(NSNumber *)parent
+                           data:(NSData *)data {
+    if (_failed) {
+        return nil;
+    }
+    if (_nextRowID == 0 && ![self loadNextRowID]) {
+        _failed = YES;
+        return nil;
+    }
+    NSNumber *rowid = @(_nextRowID++);
+    if (![self enqueueUpsertWithRowID:rowid key:key identifier:identifier parent:parent data:data]) {
+        return nil;
+    }
+    return rowid;
+}
+
+- (BOOL)updateNodeWithRowID:(NSNumber *)rowid
+                        key:(NSString *)key
+                 identifier:(NSString *)identifier
+                     parent:(NSNumber *)parent
+                       data:(NSData *)data {
+    if (_failed) {
+        return NO;
+    }
+    return [self enqueueUpsertWithRowID:rowid key:key identifier:identifier parent:parent data:data];
+}
+
+- (BOOL)deleteNodeWithRowID:(NSNumber *)rowid {
+    if (_failed) {
+        return NO;
+    }
+    [_deletes addObject:rowid];
+    if (_deletes.count == iTermGraphDatabaseWriterBatchSize) {
+        return [self flushDeletes];
+    }
+    return YES;
+}
+
+- (BOOL)insertChunkWithHash:(NSData *)hash data:(NSData *)data {
+    if (_failed) {
+        return NO;
+    }
+    _bytesWritten += data.length;
+    [_chunkInsertions addObjectsFromArray:@[ hash, data ]];
+    if (_chunkInsertions.count == iTermGraphDatabaseWriterBatchSize * 2) {
+        return [self flushChunkInsertions];
+    }
+    return YES;
+}
+
+- (BOOL)deleteChunkWithHash:(NSData *)hash {
+    if (_failed) {
+        return NO;
+    }
+    [_chunkDeletions addObject:hash];
+    if (_chunkDeletions.count == iTermGraphDatabaseWriterBatchSize) {
+        return [self flushChunkDeletions];
+    }
+    return YES;
+}
+
+- (BOOL)flush {
+    if (_failed) {
+        return NO;
+    }
+    return ([self flushChunkInsertions] &&
+            [self flushUpserts] &&
+            [self flushDeletes] &&
+            [self flushChunkDeletions]);
+}
+
+#pragma mark - Private
+
+- (BOOL)loadNextRowID {
+    id<iTermDatabaseResultSet> rs = [_db executeQuery:@"select max(rowid) as maxrowid from Node"];
+    if (!rs) {
+        DLog(@"Failed to get max rowid: %@", _db.lastError);
+        return NO;
+    }
+    long long maxRowID = 0;
+    if ([rs next]) {
+        maxRowID = [rs longLongIntForColumn:@"maxrowid"];
+    }
+    [rs close];
+    _nextRowID = maxRowID + 1;
+    return YES;
+}
+
+- (BOOL)enqueueUpsertWithRowID:(NSNumber *)rowid
+                           key:(NSString *)key
+                    identifier:(NSString *)identifier
+                        parent:(NSNumber *)parent
+                          data:(NSData *)data {
+    _bytesWritten += data.length;
+    [_upserts addObjectsFromArray:@[ rowid, key, identifier, parent, data ]];
+    if (_upserts.count == iTermGraphDatabaseWriterBatchSize * 5) {
+        return [self flushUpserts];
+    }
+    return YES;
+}
+
+// Since rowids are always given, this inserts new nodes and overwrites existing ones. An existing
+// node never changes its key, identifier, or parent, so only its data is actually replaced.
+- (BOOL)flushUpserts {
+    static NSString *batchStatement;
+    static NSString *singleStatement;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        NSString *prefix = @"insert or replace into Node (rowid, key, identifier, parent, data) values ";
+        batchStatement = iTermGraphDatabaseWriterStatement(prefix, @"(?, ?, ?, ?, ?)", @", ", @"",
+                                                           iTermGraphDatabaseWriterBatchSize);
+        singleStatement = iTermGraphDatabaseWriterStatement(prefix, @"(?, ?, ?, ?, ?)", @", ", @"", 1);
+    });
+    const BOOL ok = [self flushArguments:_upserts
+                            argumentsPer:5
+                          batchStatement:batchStatement
+                         singleStatement:singleStatement];
+    [_upserts removeAllObjects];
+    return ok;
+}
+
+- (BOOL)flushDeletes {
+    static NSString *batchStatement;
+    static NSString *singleStatement;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        NSString *prefix = @"delete from Node where rowid in (";
+        batchStatement = iTermGraphDatabaseWriterStatement(prefix, @"?", @", ", @")",
+                                                           iTermGraphDatabaseWriterBatchSize);
+        singleStatement = iTermGraphDatabaseWriterStatement(prefix, @"?", @", ", @")", 1);
+    });
+    const BOOL ok = [self flushArguments:_deletes
+                            argumentsPer:1
+                          batchStatement:batchStatement
+                         singleStatement:singleStatement];
+    [_deletes removeAllObjects];
+    return ok;
+}
+
+- (BOOL)flushChunkInsertions {
+    static NSString *batchStatement;
+    static NSString *singleStatement;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        NSString *prefix = @"insert or ignore into Chunk (hash, data) values ";
+        batchStatement = iTermGraphDatabaseWriterStatement(prefix, @"(?, ?)", @", ", @"",
+                                                           iTermGraphDatabaseWriterBatchSize);
+        singleStatement = iTermGraphDatabaseWriterStatement(prefix, @"(?, ?)", @", ", @"", 1);
+    });
+    const BOOL ok = [self flushArguments:_chunkInsertions
+                            argumentsPer:2
+                          batchStatement:batchStatement
+                         singleStatement:singleStatement];
+    [_chunkInsertions removeAllObjects];
+    return ok;
+}
+
+- (BOOL)flushChunkDeletions {
+    static NSString *batchStatement;
+    static NSString *singleStatement;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        NSString *prefix = @"delete from Chunk where hash in (";
+        batchStatement = iTermGraphDatabaseWriterStatement(prefix, @"?", @", ", @")",
+                                                           iTermGraphDatabaseWriterBatchSize);
+        singleStatement = iTermGraphDatabaseWriterStatement(prefix, @"?", @", ", @")", 1);
+    });
+    const BOOL ok = [self flushArguments:_chunkDeletions
+                            argumentsPer:1
+                          batchStatement:batchStatement
+                         singleStatement:singleStatement];
+    [_chunkDeletions removeAllObjects];
+    return ok;
+}
+
+// Full batches use batchStatement. Leftover rows use singleStatement one at a time so that there are
+// only ever two distinct statements to prepare.
+- (BOOL)flushArguments:(NSArray *)arguments
+          argumentsPer:(NSInteger)argumentsPer
+        batchStatement:(NSString *)batchStatement
+       singleStatement:(NSString *)singleStatement {
+    if (_failed) {
+        return NO;
+    }
+    const NSInteger batchLength = iTermGraphDatabaseWriterBatchSize * argumentsPer;
+    NSInteger offset = 0;
+    while (offset < arguments.count) {
+        const BOOL full = (arguments.count - offset >= batchLength);
+        const NSInteger length = full ? batchLength : argumentsPer;
+        NSArray *slice = [arguments subarrayWithRange:NSMakeRange(offset, length)];
+        if (![_db executeUpdate:full ? batchStatement : singleStatement withArguments:slice]) {
+            DLog(@"Batched write failed: %@", _db.lastError);
+            _failed = YES;
+            return NO;
+        }
+        offset += length;
+    }
+    return YES;
+}
+
+@end
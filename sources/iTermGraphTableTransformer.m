@@ -11,6 +11,20 @@
 #import "NSArray+iTerm.h"
 #import "NSData+iTerm.h"
 #import "NSObject+iTerm.h"
+#import "iTermAdvancedSettingsModel.h"
+
+static NSDictionary<NSString *, id> *iTermGraphTableTransformerUnarchive(NSDictionary *nodeDict) {
+    NSData *data = nodeDict[@"data"];
+    if (!data.length) {
+        return @{};
+    }
+    NSError *error;
+    NSDictionary<NSString *, id> *pod = [data it_unarchivedObjectOfBasicClassesWithError:&error];
+    if (error) {
+        DLog(@"Failed to unarchive data for node %@: %@", nodeDict, error);
+    }
+    return pod;
+}
 
 static iTermEncoderGraphRecord *iTermGraphDeltaEncoderMakeGraphRecord(NSNumber *nodeID,
                                                                       NSDictionary *nodes,
@@ -22,17 +36,7 @@ static iTermEncoderGraphRecord *iTermGraphDeltaEncoderMakeGraphRecord(NSNumber *
         [childNodeIDs mapWithBlock:^id(NSNumber *childNodeID) {
             return iTermGraphDeltaEncoderMakeGraphRecord(childNodeID, nodes, [path arrayByAddingObject:tail]);
         }];
-    NSDictionary<NSString *, id> *pod;
-    NSData *data = nodeDict[@"data"];
-    if (data.length) {
-        NSError *error;
-        pod = [data it_unarchivedObjectOfBasicClassesWithError:&error];
-        if (error) {
-            DLog(@"Failed to unarchive data for node %@: %@", nodeDict, error);
-        }
-    } else {
-        pod = @{};
-    }
+    NSDictionary<NSString *, id> *pod = nodeDict[@"pod"];
 
     DLog(@"key=%@ id=%@ rowid=%@ children=%@ pod=%@", nodeDict[@"key"], nodeDict[@"identifier"],
           nodeDict[@"rowid"], childNodeIDs, [pod tastefulDescription] );
@@ -96,8 +100,7 @@ static iTermEncoderGraphRecord *iTermGraphDeltaEncoderMakeGraphRecord(NSNumber *
             }
             *rootNodeIDOut = rowid;
         }
-        nodes[rowid] = [@{ @"pod": [NSMutableDictionary dictionary],
-                           @"key": key,
+        nodes[rowid] = [@{ @"key": key,
                            @"identifier": identifier,
                            @"parent": parent,
                            @"children": [NSMutableArray array],
@@ -131,6 +134,28 @@ static iTermEncoderGraphRecord *iTermGraphDeltaEncoderMakeGraphRecord(NSNumber *
     return ok;
 }
 
+// Unarchiving is most of the cost of loading, and each node's data can be unarchived
+// independently. A session's scrollback blocks are separate nodes, so a large restoration spreads
+// out over all cores.
+- (void)unarchivePODs:(NSDictionary<NSNumber *, NSMutableDictionary *> *)nodes {
+    NSArray<NSMutableDictionary *> *nodeDicts = nodes.allValues;
+    if (![iTermAdvancedSettingsModel decodeRestorableStateConcurrently]) {
+        for (NSMutableDictionary *nodeDict in nodeDicts) {
+            nodeDict[@"pod"] = iTermGraphTableTransformerUnarchive(nodeDict);
+        }
+        return;
+    }
+    // Each iteration mutates only its own node dictionary.
+    dispatch_apply(nodeDicts.count,
+                   dispatch_get_global_queue(QOS_CLASS_USER_INITIATED, 0),
+                   ^(size_t i) {
+        @autoreleasepool {
+            NSMutableDictionary *nodeDict = nodeDicts[i];
+            nodeDict[@"pod"] = iTermGraphTableTransformerUnarchive(nodeDict);
+        }
+    });
+}
+
 - (iTermEncoderGraphRecord * _Nullable)transform {
     NSNumber *rootNodeID = nil;
     NSDictionary<NSNumber *, NSMutableDictionary *> *nodes = [self nodes:&rootNodeID];
@@ -147,6 +172,8 @@ static iTermEncoderGraphRecord *iTermGraphDeltaEncoderMakeGraphRecord(NSNumber *
         return nil;
     }
 
+    [self unarchivePODs:nodes];
+
     // Finally, we can construct a record.
     return iTermGraphDeltaEncoderMakeGraphRecord(rootNodeID, nodes, @[ @"(root)" ]);
 }
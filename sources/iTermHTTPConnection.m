@@ -254,10 +254,13 @@
         return NO;
     }
 
-    char buffer[4096];
-    int rc;
+    // Read straight into the buffer to avoid copying. It gets handed off by readSynchronously.
+    const NSUInteger existingLength = _buffer.length;
+    const NSUInteger chunkSize = 16384;
+    [_buffer setLength:existingLength + chunkSize];
+    ssize_t rc;
     do {
-        rc = read(fd, buffer, sizeof(buffer));
+        rc = read(fd, (char *)_buffer.mutableBytes + existingLength, chunkSize);
     } while (rc == -1 && (errno == EINTR || errno == EAGAIN));
     if (rc <= 0) {
         if (rc < 0) {
@@ -265,13 +268,14 @@
         } else {
             DLog(@"EOF reached");
         }
+        [_buffer setLength:existingLength];
         @synchronized(_fdSync) {
             _fd = -1;
         }
         return NO;
     }
 
-    [_buffer appendBytes:buffer length:rc];
+    [_buffer setLength:existingLength + rc];
     return YES;
 }
 
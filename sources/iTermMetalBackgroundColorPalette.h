@@ -0,0 +1,52 @@
+//
+//  iTermMetalBackgroundColorPalette.h
+//  iTerm2SharedARC
+//
+//  Created by George Nachman on 10/18/26.
+//
+
+#import <Foundation/Foundation.h>
+#import <simd/simd.h>
+
+#import "ScreenChar.h"
+#import "iTermColorMap.h"
+#import "iTermTextRendererCommon.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+// Inputs to a cell's background color that don't come from its screen_char_t.
+typedef NS_OPTIONS(unsigned char, iTermMetalBackgroundCellFlags) {
+    iTermMetalBackgroundCellFlagSelected = 1 << 0,
+    iTermMetalBackgroundCellFlagFindMatch = 1 << 1
+};
+
+// Unprocessed background colors, alpha included, for every kind of cell. Lets a whole row's
+// background colors be resolved without a message send or an NSColor. Build one per frame, since
+// it depends on the color map and the frame's settings.
+typedef struct {
+    // Indexed by 8-bit color.
+    vector_float4 ansi[256];
+    // Indexed by ALTSEM_xxx.
+    vector_float4 alternate[ALTSEM_SYSTEM_MESSAGE + 1];
+    // For ColorModeInvalid and unknown ALTSEM_xxx values.
+    vector_float4 invalid;
+    vector_float4 selected;
+    vector_float4 findMatch;
+    vector_float4 image;
+    // 24-bit colors are computed from their components. This is their alpha.
+    float trueColorAlpha;
+    iTermBackgroundColorProcessingParameters processing;
+} iTermMetalBackgroundColorPalette;
+
+// Splits a row into runs of cells whose background colors are the same. Each run gets its
+// processed (muted and dimmed) color. Its unprocessed color, which minimum contrast is computed
+// against, goes in the same element of unprocessedColors. runs and unprocessedColors must have room
+// for `width` elements. Returns the number of runs.
+int iTermMetalBackgroundColorPaletteGetRuns(const iTermMetalBackgroundColorPalette *palette,
+                                            const screen_char_t *line,
+                                            const iTermMetalBackgroundCellFlags *cellFlags,
+                                            int width,
+                                            iTermMetalBackgroundColorRLE *runs,
+                                            vector_float4 *unprocessedColors);
+
+NS_ASSUME_NONNULL_END
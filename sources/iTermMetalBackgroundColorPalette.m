@@ -0,0 +1,113 @@
+//
+//  iTermMetalBackgroundColorPalette.m
+//  iTerm2SharedARC
+//
+//  Created by George Nachman on 10/18/26.
+//
+
+#import "iTermMetalBackgroundColorPalette.h"
+
+static const int iTermMetalBackgroundCellKeyModeShift = 24;
+static const uint32_t iTermMetalBackgroundCellKeyImageBit = 1 << 26;
+static const int iTermMetalBackgroundCellKeyFlagsShift = 27;
+
+// Packs everything about a cell that affects its background color into an integer, so runs can be
+// found by comparing integers.
+static inline uint32_t iTermMetalBackgroundCellKey(const screen_char_t *c,
+                                                   iTermMetalBackgroundCellFlags flags) {
+    return ((uint32_t)c->backgroundColor |
+            ((uint32_t)c->bgGreen << 8) |
+            ((uint32_t)c->bgBlue << 16) |
+            ((uint32_t)c->backgroundColorMode << iTermMetalBackgroundCellKeyModeShift) |
+            (c->image ? iTermMetalBackgroundCellKeyImageBit : 0) |
+            ((uint32_t)flags << iTermMetalBackgroundCellKeyFlagsShift));
+}
+
+// Follows the same precedence as -[iTermMetalPerFrameState unprocessedColorForBackgroundColorKey:isDefault:].
+static inline vector_float4 iTermMetalBackgroundColorPaletteLookUp(const iTermMetalBackgroundColorPalette *palette,
+                                                                   uint32_t key) {
+    const iTermMetalBackgroundCellFlags flags = key >> iTermMetalBackgroundCellKeyFlagsShift;
+    if (flags & iTermMetalBackgroundCellFlagSelected) {
+        return palette->selected;
+    }
+    if (key & iTermMetalBackgroundCellKeyImageBit) {
+        return palette->image;
+    }
+    if (flags & iTermMetalBackgroundCellFlagFindMatch) {
+        return palette->findMatch;
+    }
+    const unsigned int red = key & 0xff;
+    switch ((key >> iTermMetalBackgroundCellKeyModeShift) & 3) {
+        case ColorModeAlternate:
+            if (red <= ALTSEM_SYSTEM_MESSAGE) {
+                return palette->alternate[red];
+            }
+            return palette->invalid;
+        case ColorModeNormal:
+            return palette->ansi[red];
+        case ColorMode24bit: {
+            // Same arithmetic as +[NSColor colorWith8BitRed:green:blue:].
+            const unsigned int green = (key >> 8) & 0xff;
+            const unsigned int blue = (key >> 16) & 0xff;
+            return simd_make_float4(red / 255.0, green / 255.0, blue / 255.0, palette->trueColorAlpha);
+        }
+        default:
+            return palette->invalid;
+    }
+}
+
+// Same as -[iTermColorMap fastProcessedBackgroundColorForBackgroundColor:], done on whole vectors.
+static inline vector_float4 iTermMetalBackgroundColorProcess(const iTermBackgroundColorProcessingParameters *parameters,
+                                                             vector_float4 color) {
+    const float muting = parameters->mutingAmount;
+    const vector_float4 muted = color * (1 - muting) + parameters->defaultBackgroundColor * muting;
+
+    BOOL shouldDim;
+    float gray;
+    if (parameters->dimOnlyText) {
+        // Text and non-default background colors get dimmed toward the background's brightness.
+        const simd_float3 delta = simd_abs(color.xyz - parameters->defaultBackgroundColor.xyz);
+        shouldDim = !simd_all(delta < 0.01f);
+        gray = parameters->backgroundBrightness;
+    } else {
+        shouldDim = parameters->dimmingAmount > 0;
+        gray = 0.5;
+    }
+
+    vector_float4 result = muted;
+    if (shouldDim) {
+        const float dimming = parameters->dimmingAmount;
+        result = muted * (1 - dimming) + gray * dimming;
+    }
+    result.w = color.w;
+    return result;
+}
+
+int iTermMetalBackgroundColorPaletteGetRuns(const iTermMetalBackgroundColorPalette *palette,
+                                            const screen_char_t *line,
+                                            const iTermMetalBackgroundCellFlags *cellFlags,
+                                            int width,
+                                            iTermMetalBackgroundColorRLE *runs,
+                                            vector_float4 *unprocessedColors) {
+    int count = 0;
+    uint32_t previousKey = 0;
+    for (int x = 0; x < width; x++) {
+        const uint32_t key = iTermMetalBackgroundCellKey(&line[x], cellFlags[x]);
+        if (count > 0 && key == previousKey) {
+            runs[count - 1].count++;
+            continue;
+        }
+        previousKey = key;
+        unprocessedColors[count] = iTermMetalBackgroundColorPaletteLookUp(palette, key);
+        runs[count].origin = x;
+        runs[count].count = 1;
+        count++;
+    }
+
+    // Processing happens in a separate pass so it runs over contiguous colors.
+    const iTermBackgroundColorProcessingParameters processing = palette->processing;
+    for (int i = 0; i < count; i++) {
+        runs[i].color = iTermMetalBackgroundColorProcess(&processing, unprocessedColors[i]);
+    }
+    return count;
+}
@@ -17,6 +17,8 @@ NS_ASSUME_NONNULL_BEGIN
 NS_CLASS_AVAILABLE(10_11, NA)
 @protocol iTermMetalGlueDelegate<NSObject>
 - (void)metalGlueDidDrawFrameAndNeedsRedraw:(BOOL)redrawAsap;
+// Main thread time taken to gather the state for a frame.
+- (void)metalGlueDidPrepareFrameWithDuration:(NSTimeInterval)duration;
 - (CGContextRef)metalGlueContext;
 - (iTermImageWrapper *)metalGlueBackgroundImage;
 - (iTermBackgroundImageMode)metalGlueBackgroundImageMode;
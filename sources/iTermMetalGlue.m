@@ -17,6 +17,7 @@
 #import "iTermImageInfo.h"
 #import "iTermMarkRenderer.h"
 #import "iTermMetalPerFrameState.h"
+#import "iTermMetalRowCache.h"
 #import "iTermSelection.h"
 #import "iTermSmartCursorColor.h"
 #import "iTermTextDrawingHelper.h"
@@ -45,6 +46,7 @@ NS_ASSUME_NONNULL_BEGIN
 
 @synthesize oldCursorScreenCoord = _oldCursorScreenCoord;
 @synthesize lastTimeCursorMoved = _lastTimeCursorMoved;
+@synthesize rowCache = _rowCache;
 
 - (instancetype)init {
     self = [super init];
@@ -55,6 +57,7 @@ NS_ASSUME_NONNULL_BEGIN
                                                    object:nil];
         _missingImages = [NSMutableSet set];
         _loadedImages = [NSMutableSet set];
+        _rowCache = [[iTermMetalRowCache alloc] init];
     }
     return self;
 }
@@ -94,10 +97,13 @@ NS_ASSUME_NONNULL_BEGIN
     }
     ITBetaAssert(self.delegate != nil, @"Nil delegate");
     ITBetaAssert(self.delegate.metalGlueContext != nil, @"Nil metal glue context");
-    return [[iTermMetalPerFrameState alloc] initWithTextView:self.textView
-                                                      screen:self.screen
-                                                        glue:self
-                                                     context:self.delegate.metalGlueContext];
+    const CFTimeInterval start = CACurrentMediaTime();
+    iTermMetalPerFrameState *state = [[iTermMetalPerFrameState alloc] initWithTextView:self.textView
+                                                                                screen:self.screen
+                                                                                  glue:self
+                                                                               context:self.delegate.metalGlueContext];
+    [self.delegate metalGlueDidPrepareFrameWithDuration:CACurrentMediaTime() - start];
+    return state;
 }
 
 - (void)metalDidFindImages:(NSSet<NSString *> *)foundImages
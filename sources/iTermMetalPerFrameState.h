@@ -6,13 +6,17 @@
 //
 
 #import <Foundation/Foundation.h>
+#import "iTermMetalBackgroundColorPalette.h"
 #import "iTermMetalDriver.h"
 
 NS_ASSUME_NONNULL_BEGIN
 
 @class PTYTextView;
 @class VT100Screen;
+@class iTermColorMap;
 @class iTermImageWrapper;
+@class iTermMetalPerFrameStateRow;
+@class iTermMetalRowCache;
 
 @protocol iTermMetalPerFrameStateDelegate <NSObject>
 // Screen-relative cursor location on last frame
@@ -23,6 +27,8 @@ NS_ASSUME_NONNULL_BEGIN
 @property (nonatomic, readonly) iTermImageWrapper *backgroundImage;
 @property (nonatomic, readonly) iTermBackgroundImageMode backroundImageMode;
 @property (nonatomic, readonly) CGFloat backgroundImageBlend;
+// Lives as long as the session so unchanged rows can be reused from one frame to the next.
+@property (nonatomic, readonly) iTermMetalRowCache *rowCache;
 @end
 
 @interface iTermMetalPerFrameState : NSObject<
@@ -40,6 +46,21 @@ NS_ASSUME_NONNULL_BEGIN
                          context:(CGContextRef)context NS_DESIGNATED_INITIALIZER;
 - (instancetype)init NS_UNAVAILABLE;
 
+// Tests only! Prepares rows without a text view. Colors come from colorMap and other settings have
+// their defaults.
+- (instancetype)initWithColorMap:(iTermColorMap *)colorMap
+                            rows:(NSArray<iTermMetalPerFrameStateRow *> *)rows
+                           width:(int)width
+                        rowCache:(nullable iTermMetalRowCache *)rowCache NS_DESIGNATED_INITIALIZER;
+
+// Tests only! The palette that rows' background colors are resolved with.
+- (const iTermMetalBackgroundColorPalette *)backgroundColorPalette;
+
+// Tests only! Resolves one cell's unprocessed background color without the palette.
+- (vector_float4)unprocessedBackgroundColorForCharacter:(screen_char_t)c
+                                               selected:(BOOL)selected
+                                              findMatch:(BOOL)findMatch;
+
 @end
 
 NS_ASSUME_NONNULL_END
@@ -15,10 +15,14 @@
 #import "iTermColorMap.h"
 #import "iTermController.h"
 #import "iTermData.h"
+#import "iTermGlyphBitmapCache.h"
 #import "iTermImageInfo.h"
+#import "iTermMalloc.h"
 #import "iTermMarkRenderer.h"
+#import "iTermMetalBackgroundColorPalette.h"
 #import "iTermMetalPerFrameStateConfiguration.h"
 #import "iTermMetalPerFrameStateRow.h"
+#import "iTermMetalRowCache.h"
 #import "iTermPreferences.h"
 #import "iTermSelection.h"
 #import "iTermSmartCursorColor.h"
@@ -114,6 +118,22 @@ typedef struct {
     NSArray<iTermHighlightedRow *> *_highlightedRows;
     NSTimeInterval _startTime;
     NSEdgeInsets _extraMargins;
+
+    // Nil if rows are not cached.
+    iTermMetalRowCache *_rowCache;
+    // Hash of the settings that affect every row's glyph keys. Part of each row's cache key.
+    uint64_t _rowCacheSettings;
+    // The settings that _rowCacheSettings hashes.
+    NSData *_rowCacheSettingsBytes;
+    // Holds the bytes of the row cache key most recently made by -getRowCacheKey:row:width:.
+    NSMutableData *_rowCacheKeyBytes;
+
+    iTermMetalBackgroundColorPalette _backgroundColorPalette;
+    // Scratch space for -metalGetGlyphKeys:..., which is never called concurrently. Each holds
+    // _scratchWidth elements.
+    iTermMetalBackgroundCellFlags *_backgroundCellFlags;
+    vector_float4 *_unprocessedBackgroundColors;
+    int _scratchWidth;
 }
 @end
 
@@ -135,6 +155,29 @@ typedef struct {
         [textView performBlockWithFlickerFixerGrid:^{
             [self loadAllWithTextView:textView screen:screen glue:glue];
         }];
+        [self loadRowCache:glue.rowCache];
+        [self loadBackgroundColorPalette];
+    }
+    return self;
+}
+
+- (instancetype)initWithColorMap:(iTermColorMap *)colorMap
+                            rows:(NSArray<iTermMetalPerFrameStateRow *> *)rows
+                           width:(int)width
+                        rowCache:(nullable iTermMetalRowCache *)rowCache {
+    self = [super init];
+    if (self) {
+        _configuration = [[iTermMetalPerFrameStateConfiguration alloc] init];
+        _configuration->_colorMap = colorMap;
+        _configuration->_gridSize = VT100GridSizeMake(width, (int)rows.count);
+        _configuration->_transparencyAlpha = 1;
+        _configuration->_thinStrokes = iTermThinStrokesSettingNever;
+        _configuration->_isFrontTextView = YES;
+        _configuration->_blinkingItemsVisible = YES;
+        _rows = [rows mutableCopy];
+        _startTime = [NSDate timeIntervalSinceReferenceDate];
+        [self loadRowCache:rowCache];
+        [self loadBackgroundColorPalette];
     }
     return self;
 }
@@ -143,6 +186,8 @@ typedef struct {
     if (_metalContext) {
         CGContextRelease(_metalContext);
     }
+    free(_backgroundCellFlags);
+    free(_unprocessedBackgroundColors);
 }
 
 - (void)loadAllWithTextView:(PTYTextView *)textView
@@ -166,6 +211,106 @@ typedef struct {
     [textView.dataSource setUseSavedGridIfAvailable:NO];
 }
 
+- (void)loadRowCache:(iTermMetalRowCache *)rowCache {
+    if (!rowCache || ![iTermAdvancedSettingsModel cacheMetalRows]) {
+        return;
+    }
+    _rowCache = rowCache;
+    [_rowCache beginFrameWithWidth:_configuration->_gridSize.width rows:(int)_rows.count];
+
+    // Everything besides the row's own state that -metalGetGlyphKeys:... depends on.
+    struct {
+        NSUInteger colorMapGeneration;
+        vector_float4 unfocusedSelectionColor;
+        CGFloat transparencyAlpha;
+        iTermThinStrokesSetting thinStrokes;
+        BOOL transparencyAffectsOnlyDefaultBackgroundColor;
+        BOOL isFrontTextView;
+        BOOL reverseVideo;
+        BOOL useCustomBoldColor;
+        BOOL brightenBold;
+        BOOL useNativePowerlineGlyphs;
+        BOOL isRetina;
+        BOOL blinkingItemsVisible;
+        BOOL blinkAllowed;
+        BOOL underlineHyperlinks;
+    } settings;
+    // Zero the padding so it doesn't affect the hash.
+    memset(&settings, 0, sizeof(settings));
+    settings.colorMapGeneration = _configuration->_colorMap.generation;
+    settings.unfocusedSelectionColor = _configuration->_unfocusedSelectionColor;
+    settings.transparencyAlpha = _configuration->_transparencyAlpha;
+    settings.thinStrokes = _configuration->_thinStrokes;
+    settings.transparencyAffectsOnlyDefaultBackgroundColor = _configuration->_transparencyAffectsOnlyDefaultBackgroundColor;
+    settings.isFrontTextView = _configuration->_isFrontTextView;
+    settings.reverseVideo = _configuration->_reverseVideo;
+    settings.useCustomBoldColor = _configuration->_useCustomBoldColor;
+    settings.brightenBold = _configuration->_brightenBold;
+    settings.useNativePowerlineGlyphs = _configuration->_useNativePowerlineGlyphs;
+    settings.isRetina = _configuration->_isRetina;
+    settings.blinkingItemsVisible = _configuration->_blinkingItemsVisible;
+    settings.blinkAllowed = _configuration->_blinkAllowed;
+    settings.underlineHyperlinks = [iTermAdvancedSettingsModel underlineHyperlinks];
+    _rowCacheSettings = iTermMetalRowCacheHash(&settings, sizeof(settings), 0);
+    _rowCacheSettingsBytes = [NSData dataWithBytes:&settings length:sizeof(settings)];
+    _rowCacheKeyBytes = [NSMutableData data];
+}
+
+- (const iTermMetalBackgroundColorPalette *)backgroundColorPalette {
+    return &_backgroundColorPalette;
+}
+
+- (vector_float4)unprocessedBackgroundColorForCharacter:(screen_char_t)c
+                                               selected:(BOOL)selected
+                                              findMatch:(BOOL)findMatch {
+    iTermBackgroundColorKey key = {
+        .bgColor = c.backgroundColor,
+        .bgGreen = c.bgGreen,
+        .bgBlue = c.bgBlue,
+        .bgColorMode = c.backgroundColorMode,
+        .selected = selected,
+        .isMatch = findMatch,
+        .image = c.image
+    };
+    BOOL isDefault;
+    return [self unprocessedColorForBackgroundColorKey:&key isDefault:&isDefault];
+}
+
+// Resolves one cell of each kind through the per-cell path so that rows can be resolved in bulk.
+- (void)loadBackgroundColorPalette {
+    iTermBackgroundColorKey key = {
+        .bgColor = 0,
+        .bgGreen = 0,
+        .bgBlue = 0,
+        .bgColorMode = ColorModeNormal,
+        .selected = NO,
+        .isMatch = NO,
+        .image = NO
+    };
+    BOOL isDefault;
+    for (int i = 0; i < 256; i++) {
+        key.bgColor = i;
+        _backgroundColorPalette.ansi[i] = [self unprocessedColorForBackgroundColorKey:&key isDefault:&isDefault];
+    }
+    key.bgColorMode = ColorModeAlternate;
+    for (int i = 0; i <= ALTSEM_SYSTEM_MESSAGE; i++) {
+        key.bgColor = i;
+        _backgroundColorPalette.alternate[i] = [self unprocessedColorForBackgroundColorKey:&key isDefault:&isDefault];
+    }
+    key.bgColor = 0;
+    key.bgColorMode = ColorMode24bit;
+    _backgroundColorPalette.trueColorAlpha = [self unprocessedColorForBackgroundColorKey:&key isDefault:&isDefault].w;
+    key.bgColorMode = ColorModeInvalid;
+    _backgroundColorPalette.invalid = [self unprocessedColorForBackgroundColorKey:&key isDefault:&isDefault];
+    key.isMatch = YES;
+    _backgroundColorPalette.findMatch = [self unprocessedColorForBackgroundColorKey:&key isDefault:&isDefault];
+    key.image = YES;
+    _backgroundColorPalette.image = [self unprocessedColorForBackgroundColorKey:&key isDefault:&isDefault];
+    key.selected = YES;
+    _backgroundColorPalette.selected = [self unprocessedColorForBackgroundColorKey:&key isDefault:&isDefault];
+    _backgroundColorPalette.processing = [_configuration->_colorMap backgroundColorProcessingParameters];
+}
+
 - (void)loadSettingsWithDrawingHelper:(iTermTextDrawingHelper *)drawingHelper
                              textView:(PTYTextView *)textView {
     _numberOfScrollbackLines = textView.dataSource.numberOfScrollbackLines;
@@ -689,80 +834,57 @@ ambiguousIsDoubleWidth:(BOOL)ambiguousIsDoubleWidth
     iTermTextColorKey keys[2];
     iTermTextColorKey *currentColorKey = &keys[0];
     iTermTextColorKey *previousColorKey = &keys[1];
-    iTermBackgroundColorKey lastBackgroundKey;
     NSRange underlinedRange = _rows[row]->_underlinedRange;
-    int rles = 0;
     int previousImageCode = -1;
     VT100GridCoord previousImageCoord;
     NSIndexSet *annotatedIndexes = _rowToAnnotationRanges[@(row)];
-    vector_float4 lastUnprocessedBackgroundColor = simd_make_float4(0, 0, 0, 0);
-    BOOL lastSelected = NO;
     const BOOL underlineHyperlinks = [iTermAdvancedSettingsModel underlineHyperlinks];
     iTermMetalPerFrameStateCaches caches;
     memset(&caches, 0, sizeof(caches));
 
     *markStylePtr = [_rows[row]->_markStyle intValue];
+
+    iTermMetalRowCacheKey cacheKey;
+    const BOOL cacheable = [self getRowCacheKey:&cacheKey row:row width:width];
+    if (cacheable && [_rowCache getGlyphKeys:glyphKeys
+                                  attributes:attributes
+                                  background:backgroundRLE
+                                    rleCount:rleCount
+                              drawableGlyphs:drawableGlyphsPtr
+                                      forKey:cacheKey]) {
+        [self setCursorTextColorInAttributes:attributes row:row width:width];
+        [lineData checkForOverrun];
+        return;
+    }
+
+    [self ensureScratchSpaceForWidth:width];
+    [self getBackgroundCellFlags:_backgroundCellFlags
+                            line:line
+                 selectedIndexes:selectedIndexes
+                     findMatches:findMatches
+                           width:width];
+    const int rles = iTermMetalBackgroundColorPaletteGetRuns(&_backgroundColorPalette,
+                                                             line,
+                                                             _backgroundCellFlags,
+                                                             width,
+                                                             backgroundRLE,
+                                                             _unprocessedBackgroundColors);
+    int currentRLE = 0;
+
     int lastDrawableGlyph = -1;
     for (int x = 0; x < width; x++) {
-        BOOL selected = [selectedIndexes containsIndex:x];
-        BOOL findMatch = NO;
-        if (findMatches && !selected) {
-            findMatch = CheckFindMatchAtIndex(findMatches, x);
-        }
-        if (lastSelected && line[x].code == DWC_RIGHT && !line[x].complexChar) {
-            // If the left half of a DWC was selected, extend the selection to the right half.
-            lastSelected = selected;
-            selected = YES;
-        } else if (!lastSelected && selected && line[x].code == DWC_RIGHT && !line[x].complexChar) {
-            // If the right half of a DWC is selected but the left half is not, un-select the right half.
-            lastSelected = YES;
-            selected = NO;
-        } else {
-            // Normal code path
-            lastSelected = selected;
-        }
+        const BOOL selected = !!(_backgroundCellFlags[x] & iTermMetalBackgroundCellFlagSelected);
+        const BOOL findMatch = !!(_backgroundCellFlags[x] & iTermMetalBackgroundCellFlagFindMatch);
         const BOOL annotated = [annotatedIndexes containsIndex:x];
         const BOOL inUnderlinedRange = NSLocationInRange(x, underlinedRange) || annotated;
 
         // Background colors
-        iTermBackgroundColorKey backgroundKey = {
-            .bgColor = line[x].backgroundColor,
-            .bgGreen = line[x].bgGreen,
-            .bgBlue = line[x].bgBlue,
-            .bgColorMode = line[x].backgroundColorMode,
-            .selected = selected,
-            .isMatch = findMatch,
-            .image = line[x].image
-        };
-
-        vector_float4 backgroundColor;
-        vector_float4 unprocessedBackgroundColor;
-        if (x > 0 &&
-            backgroundKey.bgColor == lastBackgroundKey.bgColor &&
-            backgroundKey.bgGreen == lastBackgroundKey.bgGreen &&
-            backgroundKey.bgBlue == lastBackgroundKey.bgBlue &&
-            backgroundKey.bgColorMode == lastBackgroundKey.bgColorMode &&
-            backgroundKey.selected == lastBackgroundKey.selected &&
-            backgroundKey.isMatch == lastBackgroundKey.isMatch &&
-            backgroundKey.image == lastBackgroundKey.image) {
-
-            const int previousRLE = rles - 1;
-            backgroundColor = backgroundRLE[previousRLE].color;
-            backgroundRLE[previousRLE].count++;
-            unprocessedBackgroundColor = lastUnprocessedBackgroundColor;
-        } else {
-            BOOL isDefaultBackgroundColor = NO;
-            unprocessedBackgroundColor = [self unprocessedColorForBackgroundColorKey:&backgroundKey
-                                                                        isDefault:&isDefaultBackgroundColor];
-            lastUnprocessedBackgroundColor = unprocessedBackgroundColor;
-            // The unprocessed color is needed for minimum contrast computation for text color.
-            backgroundColor = [_configuration->_colorMap fastProcessedBackgroundColorForBackgroundColor:unprocessedBackgroundColor];
-            backgroundRLE[rles].color = backgroundColor;
-            backgroundRLE[rles].origin = x;
-            backgroundRLE[rles].count = 1;
-            rles++;
+        if (x >= backgroundRLE[currentRLE].origin + backgroundRLE[currentRLE].count) {
+            currentRLE++;
         }
-        lastBackgroundKey = backgroundKey;
+        const vector_float4 backgroundColor = backgroundRLE[currentRLE].color;
+        // The unprocessed color is needed for minimum contrast computation for text color.
+        const vector_float4 unprocessedBackgroundColor = _unprocessedBackgroundColors[currentRLE];
         attributes[x].backgroundColor = backgroundColor;
         attributes[x].annotation = annotated;
 
@@ -892,8 +1014,63 @@ ambiguousIsDoubleWidth:(BOOL)ambiguousIsDoubleWidth
 
     *rleCount = rles;
     *drawableGlyphsPtr = lastDrawableGlyph + 1;
+    if (cacheable) {
+        [_rowCache setGlyphKeys:glyphKeys
+                     attributes:attributes
+                     background:backgroundRLE
+                       rleCount:rles
+                 drawableGlyphs:lastDrawableGlyph + 1
+                         forKey:cacheKey];
+    }
+
+    [self setCursorTextColorInAttributes:attributes row:row width:width];
+    [lineData checkForOverrun];
+}
+
+- (void)ensureScratchSpaceForWidth:(int)width {
+    if (width <= _scratchWidth) {
+        return;
+    }
+    free(_backgroundCellFlags);
+    free(_unprocessedBackgroundColors);
+    _backgroundCellFlags = iTermMalloc(sizeof(*_backgroundCellFlags) * width);
+    _unprocessedBackgroundColors = iTermMalloc(sizeof(*_unprocessedBackgroundColors) * width);
+    _scratchWidth = width;
+}
+
+- (void)getBackgroundCellFlags:(iTermMetalBackgroundCellFlags *)cellFlags
+                          line:(const screen_char_t *)line
+               selectedIndexes:(NSIndexSet *)selectedIndexes
+                   findMatches:(NSData *)findMatches
+                         width:(int)width {
+    BOOL lastSelected = NO;
+    for (int x = 0; x < width; x++) {
+        BOOL selected = [selectedIndexes containsIndex:x];
+        BOOL findMatch = NO;
+        if (findMatches && !selected) {
+            findMatch = CheckFindMatchAtIndex(findMatches, x);
+        }
+        if (lastSelected && line[x].code == DWC_RIGHT && !line[x].complexChar) {
+            // If the left half of a DWC was selected, extend the selection to the right half.
+            lastSelected = selected;
+            selected = YES;
+        } else if (!lastSelected && selected && line[x].code == DWC_RIGHT && !line[x].complexChar) {
+            // If the right half of a DWC is selected but the left half is not, un-select the right half.
+            lastSelected = YES;
+            selected = NO;
+        } else {
+            // Normal code path
+            lastSelected = selected;
+        }
+        cellFlags[x] = ((selected ? iTermMetalBackgroundCellFlagSelected : 0) |
+                        (findMatch ? iTermMetalBackgroundCellFlagFindMatch : 0));
+    }
+}
 
-    // Tweak the text color for the cell that has a box cursor.
+// Tweak the text color for the cell that has a box cursor. This is not cached with the row.
+- (void)setCursorTextColorInAttributes:(iTermMetalGlyphAttributes *)attributes
+                                   row:(int)row
+                                 width:(int)width {
     if (row == _cursorInfo.coord.y &&
         _cursorInfo.type == CURSOR_BOX &&
         _cursorInfo.cursorVisible &&
@@ -917,7 +1094,61 @@ ambiguousIsDoubleWidth:(BOOL)ambiguousIsDoubleWidth
             attributes[_cursorInfo.coord.x].foregroundColor.w = 1;
         }
     }
-    [lineData checkForOverrun];
+}
+
+// Returns NO if the row can't be cached. The key's bytes are valid until the next call.
+- (BOOL)getRowCacheKey:(iTermMetalRowCacheKey *)key row:(int)row width:(int)width {
+    if (!_rowCache || width != _configuration->_gridSize.width) {
+        return NO;
+    }
+    iTermMetalPerFrameStateRow *rowState = _rows[row];
+    const iTermData *lineData = rowState->_screenCharLine;
+    const screen_char_t *const line = (const screen_char_t *const)lineData.bytes;
+    for (int x = 0; x < width; x++) {
+        if (line[x].image) {
+            // Image runs are objects that refer to their row, so they can't be reused.
+            return NO;
+        }
+    }
+    key->content = iTermMetalRowCacheHash(lineData.bytes, lineData.length, 0);
+
+    // Everything hashed below is also appended to the key's bytes so a hit can be confirmed exactly.
+    NSMutableData *bytes = _rowCacheKeyBytes;
+    bytes.length = 0;
+    [bytes appendBytes:lineData.bytes length:lineData.length];
+
+    const NSRange underlinedRange = rowState->_underlinedRange;
+    [bytes appendBytes:&underlinedRange length:sizeof(underlinedRange)];
+    __block uint64_t decorations = iTermMetalRowCacheHash(&underlinedRange, sizeof(underlinedRange), 1);
+    [rowState->_selectedIndexSet enumerateRangesUsingBlock:^(NSRange range, BOOL * _Nonnull stop) {
+        [bytes appendBytes:&range length:sizeof(range)];
+        decorations = iTermMetalRowCacheHash(&range, sizeof(range), decorations);
+    }];
+    // Separates the selection from the annotations.
+    const int separator = 2;
+    const NSRange terminator = NSMakeRange(NSNotFound, 0);
+    [bytes appendBytes:&terminator length:sizeof(terminator)];
+    decorations = iTermMetalRowCacheHash(&separator, sizeof(separator), decorations);
+    [_rowToAnnotationRanges[@(row)] enumerateRangesUsingBlock:^(NSRange range, BOOL * _Nonnull stop) {
+        [bytes appendBytes:&range length:sizeof(range)];
+        decorations = iTermMetalRowCacheHash(&range, sizeof(range), decorations);
+    }];
+    [bytes appendBytes:&terminator length:sizeof(terminator)];
+    NSData *findMatches = rowState->_matches;
+    // NSNotFound distinguishes no find matches from an empty set of them.
+    const NSUInteger findMatchesLength = findMatches ? findMatches.length : NSNotFound;
+    [bytes appendBytes:&findMatchesLength length:sizeof(findMatchesLength)];
+    if (findMatches) {
+        [bytes appendData:findMatches];
+        decorations = iTermMetalRowCacheHash(findMatches.bytes, findMatches.length, decorations ^ 3);
+    }
+    [bytes appendData:_rowCacheSettingsBytes];
+
+    key->decorations = decorations;
+    key->settings = _rowCacheSettings;
+    key->bytes = bytes.bytes;
+    key->length = bytes.length;
+    return YES;
 }
 
 - (BOOL)useThinStrokesWithAttributes:(iTermMetalGlyphAttributes *)attributes {
@@ -1147,6 +1378,22 @@ ambiguousIsDoubleWidth:(BOOL)ambiguousIsDoubleWidth
             string = [string stringByAppendingString:successorString];
         }
     }
+    NSData *cacheKey = nil;
+    iTermGlyphBitmapCache *cache = nil;
+    if ([iTermAdvancedSettingsModel shareGlyphBitmaps]) {
+        cache = [iTermGlyphBitmapCache sharedInstance];
+        cacheKey = [iTermGlyphBitmapCache keyForCharacter:string
+                                               descriptor:descriptor
+                                               attributes:attributes
+                                               boxDrawing:glyphKey->boxDrawing
+                                                   radius:radius
+                                 useNativePowerlineGlyphs:_configuration->_useNativePowerlineGlyphs
+                                           asciiPartsOnly:isAscii];
+        NSDictionary<NSNumber *, iTermCharacterBitmap *> *cached = [cache bitmapsForKey:cacheKey emoji:emoji];
+        if (cached) {
+            return cached;
+        }
+    }
     iTermCharacterSource *characterSource =
     [[iTermCharacterSource alloc] initWithCharacter:string
                                          descriptor:descriptor
@@ -1173,6 +1420,9 @@ ambiguousIsDoubleWidth:(BOOL)ambiguousIsDoubleWidth
     if (emoji) {
         *emoji = characterSource.isEmoji;
     }
+    if (cacheKey) {
+        [cache setBitmaps:result emoji:characterSource.isEmoji forKey:cacheKey];
+    }
     return result;
 }
 
@@ -27,6 +27,10 @@ NS_ASSUME_NONNULL_BEGIN
 }
 
 - (instancetype)init NS_UNAVAILABLE;
+
+// Tests only!
+- (instancetype)initWithScreenCharLine:(iTermData *)screenCharLine
+                      selectedIndexSet:(nullable NSIndexSet *)selectedIndexSet;
 @end
 
 
@@ -61,6 +61,18 @@ NS_ASSUME_NONNULL_BEGIN
     return self;
 }
 
+- (instancetype)initWithScreenCharLine:(iTermData *)screenCharLine
+                      selectedIndexSet:(nullable NSIndexSet *)selectedIndexSet {
+    self = [super init];
+    if (self) {
+        _screenCharLine = screenCharLine;
+        _selectedIndexSet = selectedIndexSet;
+        _underlinedRange = NSMakeRange(NSNotFound, 0);
+        _markStyle = @(iTermMarkStyleNone);
+    }
+    return self;
+}
+
 - (iTermMarkStyle)markStyleForLine:(int)i
                            enabled:(BOOL)enabled
                           textView:(PTYTextView *)textView
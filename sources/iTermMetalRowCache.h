@@ -0,0 +1,63 @@
+//
+//  iTermMetalRowCache.h
+//  iTerm2SharedARC
+//
+//  Created by George Nachman on 10/18/26.
+//
+
+#import <Foundation/Foundation.h>
+
+#import "iTermMetalGlyphKey.h"
+#import "iTermTextRendererCommon.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+// Identifies everything that goes into the glyph keys, attributes, and background runs of a row.
+// The hashes find an entry quickly. The bytes they were computed from are compared on a hash match,
+// so a collision can never draw another row's text.
+typedef struct {
+    // The row's screen chars.
+    uint64_t content;
+    // Selection, find matches, and underlines.
+    uint64_t decorations;
+    // Colors and other per-frame settings.
+    uint64_t settings;
+    // Everything that was hashed. Not owned; the cache keeps its own copy.
+    const void * _Nullable bytes;
+    size_t length;
+} iTermMetalRowCacheKey;
+
+// 64-bit hash of a buffer. Pass the result of a previous call as `seed` to hash several buffers.
+uint64_t iTermMetalRowCacheHash(const void *bytes, size_t length, uint64_t seed);
+
+// Remembers the glyph keys, attributes, and background color runs computed for recently drawn rows
+// so a row that is unchanged from a recent frame, even if it has scrolled, need not be recomputed.
+// Entries are kept for a few frames after their last use. The table is allocated up front, so
+// lookups and stores don't allocate unless the grid grows. Thread-safe.
+@interface iTermMetalRowCache : NSObject
+
+// Tests only!
+@property (nonatomic, readonly) NSInteger hits;
+@property (nonatomic, readonly) NSInteger misses;
+
+// Call once for each frame before it looks anything up. Changing the width empties the cache.
+- (void)beginFrameWithWidth:(int)width rows:(int)rows;
+
+// Returns NO on a miss. The buffers must hold `width` elements.
+- (BOOL)getGlyphKeys:(iTermMetalGlyphKey *)glyphKeys
+          attributes:(iTermMetalGlyphAttributes *)attributes
+          background:(iTermMetalBackgroundColorRLE *)background
+            rleCount:(int *)rleCount
+      drawableGlyphs:(int *)drawableGlyphs
+              forKey:(iTermMetalRowCacheKey)key;
+
+- (void)setGlyphKeys:(const iTermMetalGlyphKey *)glyphKeys
+          attributes:(const iTermMetalGlyphAttributes *)attributes
+          background:(const iTermMetalBackgroundColorRLE *)background
+            rleCount:(int)rleCount
+      drawableGlyphs:(int)drawableGlyphs
+              forKey:(iTermMetalRowCacheKey)key;
+
+@end
+
+NS_ASSUME_NONNULL_END
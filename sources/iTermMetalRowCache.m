@@ -0,0 +1,270 @@
+//
+//  iTermMetalRowCache.m
+//  iTerm2SharedARC
+//
+//  Created by George Nachman on 10/18/26.
+//
+
+#import "iTermMetalRowCache.h"
+
+#import "iTermMalloc.h"
+
+// An entry that was last used this many frames ago may be replaced. A frame's rows can be prepared
+// after the next frame has begun, so this is more than one.
+static const NSInteger iTermMetalRowCacheFramesToKeep = 3;
+
+typedef struct {
+    // key.bytes points at keyBytes.
+    iTermMetalRowCacheKey key;
+    void *keyBytes;
+    size_t keyCapacity;
+    // Frame in which the entry was last used, or 0 if the slot has never been filled.
+    NSInteger frame;
+    int rleCount;
+    int drawableGlyphs;
+    // Each holds `width` elements. Allocated the first time the slot is filled.
+    iTermMetalGlyphKey *glyphKeys;
+    iTermMetalGlyphAttributes *attributes;
+    iTermMetalBackgroundColorRLE *background;
+} iTermMetalRowCacheEntry;
+
+uint64_t iTermMetalRowCacheHash(const void *bytes, size_t length, uint64_t seed) {
+    const unsigned char *p = bytes;
+    uint64_t h = seed ^ (length * 0x9e3779b97f4a7c15ULL);
+    size_t i = 0;
+    for (; i + sizeof(uint64_t) <= length; i += sizeof(uint64_t)) {
+        uint64_t word;
+        memcpy(&word, p + i, sizeof(word));
+        h = (h ^ word) * 0xff51afd7ed558ccdULL;
+        h ^= h >> 32;
+    }
+    uint64_t tail = 0;
+    memcpy(&tail, p + i, length - i);
+    h = (h ^ tail) * 0xc4ceb9fe1a85ec53ULL;
+    h ^= h >> 29;
+    return h;
+}
+
+static BOOL iTermMetalRowCacheKeyEqual(const iTermMetalRowCacheKey *a, const iTermMetalRowCacheKey *b) {
+    if (a->content != b->content ||
+        a->decorations != b->decorations ||
+        a->settings != b->settings ||
+        a->length != b->length) {
+        return NO;
+    }
+    return a->length == 0 || !memcmp(a->bytes, b->bytes, a->length);
+}
+
+static void iTermMetalRowCacheEntryFree(iTermMetalRowCacheEntry *entry) {
+    free(entry->glyphKeys);
+    free(entry->attributes);
+    free(entry->background);
+    free(entry->keyBytes);
+}
+
+static NSUInteger iTermMetalRowCacheBucket(const iTermMetalRowCacheKey *key, NSInteger capacity) {
+    const uint64_t h = key->content ^ ((key->decorations << 21) | (key->decorations >> 43)) ^ ((key->settings << 42) | (key->settings >> 22));
+    return (NSUInteger)(h & (capacity - 1));
+}
+
+@implementation iTermMetalRowCache {
+    // Open addressing with linear probing. Capacity is a power of two.
+    iTermMetalRowCacheEntry *_entries;
+    NSInteger _capacity;
+    // Number of slots that have ever been filled. Probing stops at a slot that has never been filled,
+    // so this only goes down when the table is rebuilt.
+    NSInteger _occupied;
+    int _width;
+    NSInteger _frame;
+}
+
+- (instancetype)init {
+    self = [super init];
+    if (self) {
+        _frame = 1;
+    }
+    return self;
+}
+
+- (void)dealloc {
+    [self freeEntries:_entries capacity:_capacity];
+}
+
+#pragma mark - APIs
+
+- (void)beginFrameWithWidth:(int)width rows:(int)rows {
+    @synchronized (self) {
+        _frame += 1;
+        if (width != _width) {
+            [self freeEntries:_entries capacity:_capacity];
+            _entries = NULL;
+            _capacity = 0;
+            _occupied = 0;
+            _width = width;
+        }
+        // Leave room for every row of the last few frames to be different with a load factor of
+        // at most one half.
+        NSInteger capacity = MAX(64, _capacity);
+        while (capacity < rows * iTermMetalRowCacheFramesToKeep * 2) {
+            capacity *= 2;
+        }
+        if (capacity != _capacity) {
+            [self rebuildWithCapacity:capacity];
+        }
+    }
+}
+
+- (BOOL)getGlyphKeys:(iTermMetalGlyphKey *)glyphKeys
+          attributes:(iTermMetalGlyphAttributes *)attributes
+          background:(iTermMetalBackgroundColorRLE *)background
+            rleCount:(int *)rleCount
+      drawableGlyphs:(int *)drawableGlyphs
+              forKey:(iTermMetalRowCacheKey)key {
+    @synchronized (self) {
+        iTermMetalRowCacheEntry *entry = [self entryForKey:&key];
+        if (!entry) {
+            _misses += 1;
+            return NO;
+        }
+        _hits += 1;
+        entry->frame = _frame;
+        memcpy(glyphKeys, entry->glyphKeys, sizeof(*glyphKeys) * _width);
+        memcpy(attributes, entry->attributes, sizeof(*attributes) * _width);
+        memcpy(background, entry->background, sizeof(*background) * entry->rleCount);
+        *rleCount = entry->rleCount;
+        *drawableGlyphs = entry->drawableGlyphs;
+        return YES;
+    }
+}
+
+- (void)setGlyphKeys:(const iTermMetalGlyphKey *)glyphKeys
+          attributes:(const iTermMetalGlyphAttributes *)attributes
+          background:(const iTermMetalBackgroundColorRLE *)background
+            rleCount:(int)rleCount
+      drawableGlyphs:(int)drawableGlyphs
+              forKey:(iTermMetalRowCacheKey)key {
+    @synchronized (self) {
+        if (_width <= 0 || _capacity == 0 || rleCount > _width) {
+            return;
+        }
+        iTermMetalRowCacheEntry *entry = [self slotForKey:&key];
+        if (!entry) {
+            return;
+        }
+        if (!entry->glyphKeys) {
+            entry->glyphKeys = iTermMalloc(sizeof(*glyphKeys) * _width);
+            entry->attributes = iTermMalloc(sizeof(*attributes) * _width);
+            entry->background = iTermMalloc(sizeof(*background) * _width);
+        }
+        if (entry->keyCapacity < key.length) {
+            free(entry->keyBytes);
+            entry->keyBytes = iTermMalloc(key.length);
+            entry->keyCapacity = key.length;
+        }
+        if (key.length > 0) {
+            memcpy(entry->keyBytes, key.bytes, key.length);
+        }
+        entry->key = key;
+        entry->key.bytes = entry->keyBytes;
+        entry->frame = _frame;
+        entry->rleCount = rleCount;
+        entry->drawableGlyphs = drawableGlyphs;
+        memcpy(entry->glyphKeys, glyphKeys, sizeof(*glyphKeys) * _width);
+        memcpy(entry->attributes, attributes, sizeof(*attributes) * _width);
+        memcpy(entry->background, background, sizeof(*background) * rleCount);
+    }
+}
+
+#pragma mark - Private
+
+// An entry's contents depend only on its key, so an entry that is old enough to be replaced is
+// still a valid hit.
+- (iTermMetalRowCacheEntry *)entryForKey:(const iTermMetalRowCacheKey *)key {
+    if (_capacity == 0) {
+        return NULL;
+    }
+    NSUInteger i = iTermMetalRowCacheBucket(key, _capacity);
+    for (NSInteger probes = 0; probes < _capacity; probes++) {
+        iTermMetalRowCacheEntry *entry = &_entries[i];
+        if (entry->frame == 0) {
+            return NULL;
+        }
+        if (iTermMetalRowCacheKeyEqual(&entry->key, key)) {
+            return entry;
+        }
+        i = (i + 1) & (_capacity - 1);
+    }
+    return NULL;
+}
+
+- (BOOL)entryIsReplaceable:(const iTermMetalRowCacheEntry *)entry {
+    return entry->frame <= _frame - iTermMetalRowCacheFramesToKeep;
+}
+
+// Returns the slot to store key in: its existing entry, else the first replaceable one in its probe
+// sequence, else a fresh slot.
+- (iTermMetalRowCacheEntry *)slotForKey:(const iTermMetalRowCacheKey *)key {
+    iTermMetalRowCacheEntry *replaceable = NULL;
+    NSUInteger i = iTermMetalRowCacheBucket(key, _capacity);
+    for (NSInteger probes = 0; probes < _capacity; probes++) {
+        iTermMetalRowCacheEntry *entry = &_entries[i];
+        if (entry->frame == 0) {
+            if (replaceable) {
+                return replaceable;
+            }
+            if ((_occupied + 1) * 4 > _capacity * 3) {
+                // Too many probe chains run through stale entries. Drop them and start over, growing
+                // if the live entries alone fill the table.
+                [self rebuildWithCapacity:_capacity];
+                if ((_occupied + 1) * 4 > _capacity * 3) {
+                    [self rebuildWithCapacity:_capacity * 2];
+                }
+                return [self slotForKey:key];
+            }
+            _occupied += 1;
+            return entry;
+        }
+        if (iTermMetalRowCacheKeyEqual(&entry->key, key)) {
+            return entry;
+        }
+        if (!replaceable && [self entryIsReplaceable:entry]) {
+            replaceable = entry;
+        }
+        i = (i + 1) & (_capacity - 1);
+    }
+    return replaceable;
+}
+
+- (void)rebuildWithCapacity:(NSInteger)capacity {
+    iTermMetalRowCacheEntry *oldEntries = _entries;
+    const NSInteger oldCapacity = _capacity;
+    _entries = iTermCalloc(capacity, sizeof(iTermMetalRowCacheEntry));
+    _capacity = capacity;
+    _occupied = 0;
+    for (NSInteger j = 0; j < oldCapacity; j++) {
+        iTermMetalRowCacheEntry *entry = &oldEntries[j];
+        if (entry->frame == 0) {
+            continue;
+        }
+        if ([self entryIsReplaceable:entry]) {
+            iTermMetalRowCacheEntryFree(entry);
+            continue;
+        }
+        NSUInteger i = iTermMetalRowCacheBucket(&entry->key, _capacity);
+        while (_entries[i].frame != 0) {
+            i = (i + 1) & (_capacity - 1);
+        }
+        _entries[i] = *entry;
+        _occupied += 1;
+    }
+    free(oldEntries);
+}
+
+- (void)freeEntries:(iTermMetalRowCacheEntry *)entries capacity:(NSInteger)capacity {
+    for (NSInteger i = 0; i < capacity; i++) {
+        iTermMetalRowCacheEntryFree(&entries[i]);
+    }
+    free(entries);
+}
+
+@end
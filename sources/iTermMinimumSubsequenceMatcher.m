@@ -167,8 +167,8 @@
             [bestIndexes addObjectsFromArray:_indexes];
         }
 
-        if (currentRange.length == queryLength) {
-            // No need to keep looking.
+        if (currentRange.length == queryLength - 1) {
+            // The matching characters are consecutive, so no need to keep looking.
             break;
         }
 
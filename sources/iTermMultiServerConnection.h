@@ -18,6 +18,8 @@ NS_ASSUME_NONNULL_BEGIN
 @interface iTermMultiServerConnection: NSObject<iTermFileDescriptorMultiClientDelegate>
 
 @property (nonatomic, readonly) pid_t pid;
+// May be incomplete if the server is still reporting children. See
+// -getUnattachedChildrenWithCallback:.
 @property (nonatomic, readonly) NSArray<iTermFileDescriptorMultiClientChild *> *unattachedChildren;
 @property (nonatomic, readonly) int socketNumber;
 
@@ -32,6 +34,10 @@ NS_ASSUME_NONNULL_BEGIN
 
 - (instancetype)init NS_UNAVAILABLE;
 
+// Runs the callback after the server has reported all of its children.
+- (void)getUnattachedChildrenWithCallback:(iTermCallback<id, NSArray<iTermFileDescriptorMultiClientChild *> *> *)callback;
+
+// If the child hasn't been reported yet, the callback runs once it is.
 - (void)attachToProcessID:(pid_t)pid
                  callback:(iTermCallback<id, iTermFileDescriptorMultiClientChild *> *)callback;
 
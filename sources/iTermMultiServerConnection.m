@@ -40,6 +40,12 @@
 @interface iTermMultiServerPerConnectionState: iTermSynchronizedState<iTermMultiServerPerConnectionState *>
 @property (nonatomic, strong) iTermFileDescriptorMultiClient *client;
 @property (nonatomic, strong, readonly) NSMutableArray<iTermFileDescriptorMultiClientChild *> *unattachedChildren;
+// Set once the server has reported all its children or the connection has closed.
+@property (nonatomic) BOOL childReportsComplete;
+// Attach requests for children that haven't been reported yet, keyed by pid.
+@property (nonatomic, strong, readonly) NSMutableDictionary<NSNumber *, NSMutableArray<iTermCallback *> *> *pendingAttachments;
+// Callbacks waiting for the complete list of unattached children.
+@property (nonatomic, strong, readonly) NSMutableArray<iTermCallback *> *unattachedChildrenCallbacks;
 @end
 
 @implementation iTermMultiServerPerConnectionState
@@ -48,6 +54,8 @@
     if (self) {
         _client = client;
         _unattachedChildren = [NSMutableArray array];
+        _pendingAttachments = [NSMutableDictionary dictionary];
+        _unattachedChildrenCallbacks = [NSMutableArray array];
     }
     return self;
 }
@@ -323,6 +331,20 @@
     return result;
 }
 
+- (void)getUnattachedChildrenWithCallback:(iTermCallback<id, NSArray<iTermFileDescriptorMultiClientChild *> *> *)callback {
+    [_thread dispatchAsync:^(iTermMultiServerPerConnectionState * _Nullable state) {
+        if (!state.childReportsComplete) {
+            DLog(@"Defer getting unattached children until all have been reported");
+            [state.unattachedChildrenCallbacks addObject:callback];
+            return;
+        }
+        [callback invokeWithObject:[state.unattachedChildren copy]];
+    }];
+}
+
+// Children are reported after the connection is established, so a session being restored may ask
+// for its child before the server has gotten around to it. In that case the callback runs when the
+// child is reported, or with nil once it's clear it never will be.
 - (void)attachToProcessID:(pid_t)pid
                  callback:(iTermCallback<id, iTermFileDescriptorMultiClientChild *> *)callback {
     [_thread dispatchAsync:^(iTermMultiServerPerConnectionState * _Nullable state) {
@@ -332,6 +354,16 @@
                                                           BOOL *stop) {
             return element.pid == pid;
         }];
+        if (!child && !state.childReportsComplete) {
+            DLog(@"Child with pid %@ not reported yet. Wait for it.", @(pid));
+            NSMutableArray<iTermCallback *> *callbacks = state.pendingAttachments[@(pid)];
+            if (!callbacks) {
+                callbacks = [NSMutableArray array];
+                state.pendingAttachments[@(pid)] = callbacks;
+            }
+            [callbacks addObject:callback];
+            return;
+        }
         if (!child) {
             DLog(@"Failed to attach to child with pid %@ - not in unattached children", @(pid));
             [callback invokeWithObject:nil];
@@ -392,11 +424,57 @@
 - (void)fileDescriptorMultiClient:(iTermFileDescriptorMultiClient *)client
                  didDiscoverChild:(iTermFileDescriptorMultiClientChild *)child {
     [_thread dispatchAsync:^(iTermMultiServerPerConnectionState * _Nullable state) {
-        DLog(@"Discovered child %@. Add to unattached children.", child);
-        [state.unattachedChildren addObject:child];
+        NSMutableArray<iTermCallback *> *callbacks = state.pendingAttachments[@(child.pid)];
+        if (!callbacks.count) {
+            DLog(@"Discovered child %@. Add to unattached children.", child);
+            [state.unattachedChildren addObject:child];
+            return;
+        }
+        DLog(@"Discovered child %@ that someone is waiting to attach to.", child);
+        [state.pendingAttachments removeObjectForKey:@(child.pid)];
+        [callbacks.firstObject invokeWithObject:child];
+        // Only one session can have a child. The others fail as they would have had they asked
+        // after the first one attached.
+        for (iTermCallback *callback in [callbacks subarrayWithRange:NSMakeRange(1, callbacks.count - 1)]) {
+            [callback invokeWithObject:nil];
+        }
+    }];
+}
+
+- (void)fileDescriptorMultiClientDidFinishReportingChildren:(iTermFileDescriptorMultiClient *)client {
+    [_thread dispatchAsync:^(iTermMultiServerPerConnectionState * _Nullable state) {
+        DLog(@"All children reported");
+        [self finishChildReportsWithState:state];
     }];
 }
 
+// Fails attachments to children that will never be reported and runs callbacks waiting for the
+// full list of unattached children.
+- (void)finishChildReportsWithState:(iTermMultiServerPerConnectionState *)state {
+    if (state.childReportsComplete) {
+        return;
+    }
+    state.childReportsComplete = YES;
+
+    NSDictionary<NSNumber *, NSMutableArray<iTermCallback *> *> *pendingAttachments = [state.pendingAttachments copy];
+    [state.pendingAttachments removeAllObjects];
+    [pendingAttachments enumerateKeysAndObjectsUsingBlock:^(NSNumber * _Nonnull pid,
+                                                            NSMutableArray<iTermCallback *> * _Nonnull callbacks,
+                                                            BOOL * _Nonnull stop) {
+        DLog(@"Failed to attach to child with pid %@ - never reported", pid);
+        for (iTermCallback *callback in callbacks) {
+            [callback invokeWithObject:nil];
+        }
+    }];
+
+    NSArray<iTermCallback *> *unattachedChildrenCallbacks = [state.unattachedChildrenCallbacks copy];
+    [state.unattachedChildrenCallbacks removeAllObjects];
+    NSArray<iTermFileDescriptorMultiClientChild *> *children = [state.unattachedChildren copy];
+    for (iTermCallback *callback in unattachedChildrenCallbacks) {
+        [callback invokeWithObject:children];
+    }
+}
+
 - (void)fileDescriptorMultiClientDidClose:(iTermFileDescriptorMultiClient *)client {
     [[iTermMultiServerConnection thread] dispatchAsync:^(iTermMultiServerConnectionGlobalState * _Nullable state) {
         [state.registry removeObjectForKey:@(self.socketNumber)];
@@ -404,6 +482,7 @@
             assert(client == state.client);
             state.client.delegate = nil;
             state.client = nil;
+            [self finishChildReportsWithState:state];
         }];
     }];
 }
@@ -11,9 +11,10 @@ NS_ASSUME_NONNULL_BEGIN
 
 @interface iTermMultiServerMessage: NSObject
 @property (nonatomic, readonly) NSData *data;
-@property (nonatomic, readonly) NSNumber *fileDescriptor;
+// Usually empty or one file descriptor. Launch batch responses may have more.
+@property (nonatomic, readonly) NSArray<NSNumber *> *fileDescriptors;
 
-- (instancetype)initWithData:(NSData *)data fileDescriptor:(NSNumber *)fileDescriptor NS_DESIGNATED_INITIALIZER;
+- (instancetype)initWithData:(NSData *)data fileDescriptors:(NSArray<NSNumber *> *)fileDescriptors NS_DESIGNATED_INITIALIZER;
 - (instancetype)init NS_UNAVAILABLE;
 @end
 
@@ -10,29 +10,34 @@
 #import "DebugLogging.h"
 
 @implementation iTermMultiServerMessage {
-    NSNumber *_fileDescriptor;
-    BOOL _fileDescriptorAccessed;
+    NSArray<NSNumber *> *_fileDescriptors;
+    BOOL _fileDescriptorsAccessed;
 }
 
-- (instancetype)initWithData:(NSData *)data fileDescriptor:(NSNumber *)fileDescriptor {
+- (instancetype)initWithData:(NSData *)data fileDescriptors:(NSArray<NSNumber *> *)fileDescriptors {
     self = [super init];
     if (self) {
         _data = [data copy];
-        _fileDescriptor = fileDescriptor;
+        _fileDescriptors = [fileDescriptors copy];
     }
     return self;
 }
 
 - (void)dealloc {
-    if (!_fileDescriptorAccessed && _fileDescriptor && _fileDescriptor.intValue >= 0) {
-        DLog(@"File descriptor in message never accessed. Closing %d", _fileDescriptor.intValue);
-        close(_fileDescriptor.intValue);
+    if (_fileDescriptorsAccessed) {
+        return;
+    }
+    for (NSNumber *fileDescriptor in _fileDescriptors) {
+        if (fileDescriptor.intValue >= 0) {
+            DLog(@"File descriptor in message never accessed. Closing %d", fileDescriptor.intValue);
+            close(fileDescriptor.intValue);
+        }
     }
 }
 
-- (NSNumber *)fileDescriptor {
-    _fileDescriptorAccessed = YES;
-    return _fileDescriptor;
+- (NSArray<NSNumber *> *)fileDescriptors {
+    _fileDescriptorsAccessed = YES;
+    return _fileDescriptors;
 }
 
 @end
@@ -11,7 +11,7 @@
 
 @implementation iTermMultiServerMessageBuilder {
     NSMutableData *_accumulator;
-    NSNumber *_fileDescriptor;
+    NSMutableArray<NSNumber *> *_fileDescriptors;
     iTermMultiServerMessage *_message;
 }
 
@@ -19,14 +19,20 @@
     self = [super init];
     if (self) {
         _accumulator = [NSMutableData data];
+        _fileDescriptors = [NSMutableArray array];
     }
     return self;
 }
 
 - (void)dealloc {
-    if (!_message && _fileDescriptor && _fileDescriptor.intValue >= 0) {
-        DLog(@"Close file descriptor %d in message that was never decoded", _fileDescriptor.intValue);
-        close(_fileDescriptor.intValue);
+    if (_message) {
+        return;
+    }
+    for (NSNumber *fileDescriptor in _fileDescriptors) {
+        if (fileDescriptor.intValue >= 0) {
+            DLog(@"Close file descriptor %d in message that was never decoded", fileDescriptor.intValue);
+            close(fileDescriptor.intValue);
+        }
     }
 }
 
@@ -35,8 +41,8 @@
                        length:length];
 }
 
-- (void)setFileDescriptor:(int)fileDescriptor {
-    _fileDescriptor = @(fileDescriptor);
+- (void)addFileDescriptor:(int)fileDescriptor {
+    [_fileDescriptors addObject:@(fileDescriptor)];
 }
 
 - (NSInteger)length {
@@ -48,7 +54,7 @@
         return _message;
     }
     _message = [[iTermMultiServerMessage alloc] initWithData:_accumulator
-                                              fileDescriptor:_fileDescriptor];
+                                             fileDescriptors:_fileDescriptors];
     return _message;
 }
 
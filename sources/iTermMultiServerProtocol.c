@@ -67,6 +67,18 @@ typedef enum iTermMultiServerProtocolError {
     iTermMultiServerProtocolErrorReportChildMissingTTY = 708,
 
     iTermMultiServerProtocolErrorTerminationMissingPID = 800,
+
+    iTermMultiServerProtocolErrorLaunchBatchRequestMissingCount = 900,
+    iTermMultiServerProtocolErrorLaunchBatchRequestInvalidCount = 901,
+
+    iTermMultiServerProtocolErrorLaunchBatchResponseMissingCount = 1000,
+    iTermMultiServerProtocolErrorLaunchBatchResponseInvalidCount = 1001,
+    iTermMultiServerProtocolErrorLaunchBatchResponseWrongNumberOfFileDescriptors = 1002,
+
+    iTermMultiServerProtocolErrorReportChildrenMissingIsLast = 1100,
+    iTermMultiServerProtocolErrorReportChildrenMissingCount = 1101,
+    iTermMultiServerProtocolErrorReportChildrenInvalidCount = 1102,
+    iTermMultiServerProtocolErrorReportChildrenWrongNumberOfFileDescriptors = 1103,
 } iTermMultiServerProtocolError;
 
 static int ParseHandshakeRequest(iTermClientServerProtocolMessageParser *parser,
@@ -220,6 +232,104 @@ static int EncodeLaunchResponse(iTermClientServerProtocolMessageEncoder *encoder
     return 0;
 }
 
+static int ParseLaunchBatchRequest(iTermClientServerProtocolMessageParser *parser,
+                                   iTermMultiServerRequestLaunchBatch *out) {
+    int count = 0;
+    if (iTermClientServerProtocolParseTaggedInt(parser, &count, sizeof(count), iTermMultiServerTagLaunchBatchRequestCount)) {
+        return iTermMultiServerProtocolErrorLaunchBatchRequestMissingCount;
+    }
+    if (count <= 0 || count > iTermMultiServerMaximumLaunchBatchSize) {
+        return iTermMultiServerProtocolErrorLaunchBatchRequestInvalidCount;
+    }
+    // Zero-filled so a partially parsed batch can be freed.
+    out->launches = calloc(count, sizeof(*out->launches));
+    out->count = count;
+    for (int i = 0; i < count; i++) {
+        const int rc = ParseLaunchReqest(parser, &out->launches[i]);
+        if (rc) {
+            return rc;
+        }
+    }
+    return 0;
+}
+
+static int EncodeLaunchBatchRequest(iTermClientServerProtocolMessageEncoder *encoder,
+                                    iTermMultiServerRequestLaunchBatch *batch) {
+    if (iTermClientServerProtocolEncodeTaggedInt(encoder, &batch->count, sizeof(batch->count), iTermMultiServerTagLaunchBatchRequestCount)) {
+        return iTermMultiServerProtocolErrorEncodingFailed;
+    }
+    for (int i = 0; i < batch->count; i++) {
+        if (EncodeLaunchRequest(encoder, &batch->launches[i])) {
+            return iTermMultiServerProtocolErrorEncodingFailed;
+        }
+    }
+    return 0;
+}
+
+static int ParseLaunchBatchResponse(iTermClientServerProtocolMessageParser *parser,
+                                    iTermMultiServerResponseLaunchBatch *out) {
+    int count = 0;
+    if (iTermClientServerProtocolParseTaggedInt(parser, &count, sizeof(count), iTermMultiServerTagLaunchBatchResponseCount)) {
+        return iTermMultiServerProtocolErrorLaunchBatchResponseMissingCount;
+    }
+    if (count <= 0 || count > iTermMultiServerMaximumLaunchBatchSize) {
+        return iTermMultiServerProtocolErrorLaunchBatchResponseInvalidCount;
+    }
+    out->launches = calloc(count, sizeof(*out->launches));
+    out->count = count;
+    for (int i = 0; i < count; i++) {
+        out->launches[i].fd = -1;
+    }
+    for (int i = 0; i < count; i++) {
+        const int rc = ParseLaunchResponse(parser, &out->launches[i]);
+        if (rc) {
+            return rc;
+        }
+    }
+    return 0;
+}
+
+static int EncodeLaunchBatchResponse(iTermClientServerProtocolMessageEncoder *encoder,
+                                     iTermMultiServerResponseLaunchBatch *batch) {
+    if (iTermClientServerProtocolEncodeTaggedInt(encoder, &batch->count, sizeof(batch->count), iTermMultiServerTagLaunchBatchResponseCount)) {
+        return iTermMultiServerProtocolErrorEncodingFailed;
+    }
+    for (int i = 0; i < batch->count; i++) {
+        if (EncodeLaunchResponse(encoder, &batch->launches[i])) {
+            return iTermMultiServerProtocolErrorEncodingFailed;
+        }
+    }
+    return 0;
+}
+
+// Hands out the received file descriptors to the successful launches, in order.
+static int AssignLaunchBatchFileDescriptors(iTermClientServerProtocolMessage *message,
+                                            iTermMultiServerResponseLaunchBatch *batch) {
+    int fds[iTermMultiServerMaximumLaunchBatchSize];
+    const int numberOfFileDescriptors = iTermMultiServerProtocolGetFileDescriptors(message,
+                                                                                  fds,
+                                                                                  iTermMultiServerMaximumLaunchBatchSize);
+    int expected = 0;
+    for (int i = 0; i < batch->count; i++) {
+        if (batch->launches[i].status == 0) {
+            expected++;
+        }
+    }
+    if (expected != numberOfFileDescriptors) {
+        for (int i = 0; i < numberOfFileDescriptors; i++) {
+            close(fds[i]);
+        }
+        return iTermMultiServerProtocolErrorLaunchBatchResponseWrongNumberOfFileDescriptors;
+    }
+    int next = 0;
+    for (int i = 0; i < batch->count; i++) {
+        if (batch->launches[i].status == 0) {
+            batch->launches[i].fd = fds[next++];
+        }
+    }
+    return 0;
+}
+
 static int ParseWaitRequest(iTermClientServerProtocolMessageParser *parser,
                             iTermMultiServerRequestWait *out) {
     if (iTermClientServerProtocolParseTaggedInt(parser, &out->pid, sizeof(out->pid), iTermMultiServerTagWaitRequestPid)) {
@@ -334,6 +444,68 @@ static int EncodeReportChild(iTermClientServerProtocolMessageEncoder *encoder,
     return 0;
 }
 
+static int ParseReportChildren(iTermClientServerProtocolMessageParser *parser,
+                               iTermMultiServerReportChildren *out) {
+    if (iTermClientServerProtocolParseTaggedInt(parser, &out->isLast, sizeof(out->isLast), iTermMultiServerTagReportChildrenIsLast)) {
+        return iTermMultiServerProtocolErrorReportChildrenMissingIsLast;
+    }
+    int count = 0;
+    if (iTermClientServerProtocolParseTaggedInt(parser, &count, sizeof(count), iTermMultiServerTagReportChildrenCount)) {
+        return iTermMultiServerProtocolErrorReportChildrenMissingCount;
+    }
+    if (count <= 0 || count > iTermMultiServerMaximumReportChildrenBatchSize) {
+        return iTermMultiServerProtocolErrorReportChildrenInvalidCount;
+    }
+    // Zero-filled so a partially parsed batch can be freed.
+    out->children = calloc(count, sizeof(*out->children));
+    out->count = count;
+    for (int i = 0; i < count; i++) {
+        out->children[i].fd = -1;
+    }
+    for (int i = 0; i < count; i++) {
+        const int rc = ParseReportChild(parser, &out->children[i]);
+        if (rc) {
+            return rc;
+        }
+    }
+    return 0;
+}
+
+static int EncodeReportChildren(iTermClientServerProtocolMessageEncoder *encoder,
+                                iTermMultiServerReportChildren *obj) {
+    if (iTermClientServerProtocolEncodeTaggedInt(encoder, &obj->isLast, sizeof(obj->isLast), iTermMultiServerTagReportChildrenIsLast)) {
+        return iTermMultiServerProtocolErrorEncodingFailed;
+    }
+    if (iTermClientServerProtocolEncodeTaggedInt(encoder, &obj->count, sizeof(obj->count), iTermMultiServerTagReportChildrenCount)) {
+        return iTermMultiServerProtocolErrorEncodingFailed;
+    }
+    for (int i = 0; i < obj->count; i++) {
+        if (EncodeReportChild(encoder, &obj->children[i])) {
+            return iTermMultiServerProtocolErrorEncodingFailed;
+        }
+    }
+    return 0;
+}
+
+// Every reported child has a file descriptor, so there must be exactly one per child.
+static int AssignReportChildrenFileDescriptors(iTermClientServerProtocolMessage *message,
+                                               iTermMultiServerReportChildren *obj) {
+    int fds[iTermMultiServerMaximumReportChildrenBatchSize];
+    const int numberOfFileDescriptors = iTermMultiServerProtocolGetFileDescriptors(message,
+                                                                                  fds,
+                                                                                  iTermMultiServerMaximumReportChildrenBatchSize);
+    if (numberOfFileDescriptors != obj->count) {
+        for (int i = 0; i < numberOfFileDescriptors; i++) {
+            close(fds[i]);
+        }
+        return iTermMultiServerProtocolErrorReportChildrenWrongNumberOfFileDescriptors;
+    }
+    for (int i = 0; i < obj->count; i++) {
+        obj->children[i].fd = fds[i];
+    }
+    return 0;
+}
+
 static int ParseTermination(iTermClientServerProtocolMessageParser *parser,
                             iTermMultiServerReportTermination *out) {
     if (iTermClientServerProtocolParseTaggedInt(parser, &out->pid, sizeof(out->pid), iTermMultiServerTagTerminationPid)) {
@@ -380,10 +552,13 @@ int iTermMultiServerProtocolParseMessageFromClient(iTermClientServerProtocolMess
             return ParseLaunchReqest(&parser, &out->payload.launch);
         case iTermMultiServerRPCTypeWait:
             return ParseWaitRequest(&parser, &out->payload.wait);
+        case iTermMultiServerRPCTypeLaunchBatch:
+            return ParseLaunchBatchRequest(&parser, &out->payload.launchBatch);
 
         case iTermMultiServerRPCTypeReportChild:  // Server-originated, no response.
         case iTermMultiServerRPCTypeTermination: // Server-originated, no response.
         case iTermMultiServerRPCTypeHello: // Server-originated, no response.
+        case iTermMultiServerRPCTypeReportChildren: // Server-originated, no response.
             return iTermMultiServerProtocolErrorUnexpectedType;
     }
     FDLog(LOG_DEBUG, "Parsed message with unknown type %d", (int)out->type);
@@ -409,6 +584,43 @@ int iTermMultiServerProtocolGetFileDescriptor(iTermClientServerProtocolMessage *
     return 0;
 }
 
+int iTermMultiServerProtocolGetFileDescriptors(iTermClientServerProtocolMessage *message,
+                                               int *fds,
+                                               int capacity) {
+    // See the note in iTermMultiServerProtocolGetFileDescriptor about CMSG_FIRSTHDR.
+    struct cmsghdr *messageHeader = &message->controlBuffer.cm;
+    if (messageHeader->cmsg_len < CMSG_LEN(sizeof(int)) ||
+        messageHeader->cmsg_len > CMSG_LEN(sizeof(int) * ITERM_MULTISERVER_MAX_FILE_DESCRIPTORS_PER_MESSAGE)) {
+        return 0;
+    }
+    if (messageHeader->cmsg_level != SOL_SOCKET || messageHeader->cmsg_type != SCM_RIGHTS) {
+        return 0;
+    }
+    const int count = (int)((messageHeader->cmsg_len - CMSG_LEN(0)) / sizeof(int));
+    const int *received = (const int *)CMSG_DATA(messageHeader);
+    for (int i = 0; i < count; i++) {
+        if (i < capacity) {
+            fds[i] = received[i];
+        } else {
+            // Nobody will take ownership of it.
+            close(received[i]);
+        }
+    }
+    return count < capacity ? count : capacity;
+}
+
+// Closes the file descriptors that came with a message that was rejected, since nobody will take
+// ownership of them.
+static void CloseReceivedFileDescriptors(iTermClientServerProtocolMessage *message) {
+    int fds[ITERM_MULTISERVER_MAX_FILE_DESCRIPTORS_PER_MESSAGE];
+    const int numberOfFileDescriptors = iTermMultiServerProtocolGetFileDescriptors(message,
+                                                                                  fds,
+                                                                                  ITERM_MULTISERVER_MAX_FILE_DESCRIPTORS_PER_MESSAGE);
+    for (int i = 0; i < numberOfFileDescriptors; i++) {
+        close(fds[i]);
+    }
+}
+
 int iTermMultiServerProtocolParseMessageFromServer(iTermClientServerProtocolMessage *message,
                                                    iTermMultiServerServerOriginatedMessage *out) {
     memset(out, 0, sizeof(*out));
@@ -421,6 +633,7 @@ int iTermMultiServerProtocolParseMessageFromServer(iTermClientServerProtocolMess
     };
 
     if (iTermClientServerProtocolParseTaggedInt(&parser, &out->type, sizeof(out->type), iTermMultiServerTagType)) {
+        CloseReceivedFileDescriptors(message);
         return iTermMultiServerProtocolErrorMissingType;
     }
     switch (out->type) {
@@ -430,6 +643,7 @@ int iTermMultiServerProtocolParseMessageFromServer(iTermClientServerProtocolMess
         case iTermMultiServerRPCTypeLaunch: { // Server-originated response to client-originated request
             int rc = ParseLaunchResponse(&parser, &out->payload.launch);
             if (rc) {
+                CloseReceivedFileDescriptors(message);
                 return rc;
             }
             return iTermMultiServerProtocolGetFileDescriptor(message, &out->payload.launch.fd);
@@ -437,6 +651,7 @@ int iTermMultiServerProtocolParseMessageFromServer(iTermClientServerProtocolMess
         case iTermMultiServerRPCTypeReportChild: {  // Server-originated, no response.
             int rc = ParseReportChild(&parser, &out->payload.reportChild);
             if (rc) {
+                CloseReceivedFileDescriptors(message);
                 return rc;
             }
             return iTermMultiServerProtocolGetFileDescriptor(message, &out->payload.reportChild.fd);
@@ -449,7 +664,26 @@ int iTermMultiServerProtocolParseMessageFromServer(iTermClientServerProtocolMess
 
         case iTermMultiServerRPCTypeHello:  // Server-originated, no response.
             return ParseHello(&parser, &out->payload.hello);
+
+        case iTermMultiServerRPCTypeLaunchBatch: {  // Server-originated response to client-originated request
+            int rc = ParseLaunchBatchResponse(&parser, &out->payload.launchBatch);
+            if (rc) {
+                CloseReceivedFileDescriptors(message);
+                return rc;
+            }
+            return AssignLaunchBatchFileDescriptors(message, &out->payload.launchBatch);
+        }
+
+        case iTermMultiServerRPCTypeReportChildren: {  // Server-originated, no response.
+            int rc = ParseReportChildren(&parser, &out->payload.reportChildren);
+            if (rc) {
+                CloseReceivedFileDescriptors(message);
+                return rc;
+            }
+            return AssignReportChildrenFileDescriptors(message, &out->payload.reportChildren);
+        }
     }
+    CloseReceivedFileDescriptors(message);
     return iTermMultiServerProtocolErrorUnknownType;
 }
 
@@ -477,9 +711,14 @@ int iTermMultiServerProtocolEncodeMessageFromClient(iTermMultiServerClientOrigin
             status = EncodeWaitRequest(&encoder, &obj->payload.wait);
             break;
 
+        case iTermMultiServerRPCTypeLaunchBatch:
+            status = EncodeLaunchBatchRequest(&encoder, &obj->payload.launchBatch);
+            break;
+
         case iTermMultiServerRPCTypeReportChild:
         case iTermMultiServerRPCTypeTermination:
         case iTermMultiServerRPCTypeHello:
+        case iTermMultiServerRPCTypeReportChildren:
             break;
     }
     if (!status) {
@@ -517,6 +756,12 @@ int iTermMultiServerProtocolEncodeMessageFromServer(iTermMultiServerServerOrigin
         case iTermMultiServerRPCTypeHello:
             status = EncodeHello(&encoder, &obj->payload.hello);
             break;
+        case iTermMultiServerRPCTypeLaunchBatch:
+            status = EncodeLaunchBatchResponse(&encoder, &obj->payload.launchBatch);
+            break;
+        case iTermMultiServerRPCTypeReportChildren:
+            status = EncodeReportChildren(&encoder, &obj->payload.reportChildren);
+            break;
     }
     if (status) {
         FDLog(LOG_ERR, "Failed to encode message from server:");
@@ -552,10 +797,18 @@ static void FreeReportChild(iTermMultiServerReportChild *obj) {
         free((void *)obj->envp[i]);
     }
     free((void *)obj->envp);
+    free((void *)obj->pwd);
     free((void *)obj->tty);
     memset(obj, 0xab, sizeof(*obj));
 }
 
+static void FreeReportChildren(iTermMultiServerReportChildren *obj) {
+    for (int i = 0; i < obj->count; i++) {
+        FreeReportChild(&obj->children[i]);
+    }
+    free(obj->children);
+}
+
 static void FreeHello(iTermMultiServerHello *obj) {
 }
 
@@ -575,6 +828,20 @@ static void FreeLaunchResponse(iTermMultiServerResponseLaunch *launch) {
     free((void *)launch->tty);
 }
 
+static void FreeLaunchBatchRequest(iTermMultiServerRequestLaunchBatch *batch) {
+    for (int i = 0; i < batch->count; i++) {
+        FreeLaunchRequest(&batch->launches[i]);
+    }
+    free(batch->launches);
+}
+
+static void FreeLaunchBatchResponse(iTermMultiServerResponseLaunchBatch *batch) {
+    for (int i = 0; i < batch->count; i++) {
+        FreeLaunchResponse(&batch->launches[i]);
+    }
+    free(batch->launches);
+}
+
 void iTermMultiServerClientOriginatedMessageFree(iTermMultiServerClientOriginatedMessage *obj) {
     switch (obj->type) {
         case iTermMultiServerRPCTypeHandshake:
@@ -586,9 +853,13 @@ void iTermMultiServerClientOriginatedMessageFree(iTermMultiServerClientOriginate
         case iTermMultiServerRPCTypeWait:
             FreeWaitRequest(&obj->payload.wait);
             break;
+        case iTermMultiServerRPCTypeLaunchBatch:
+            FreeLaunchBatchRequest(&obj->payload.launchBatch);
+            break;
         case iTermMultiServerRPCTypeReportChild:
         case iTermMultiServerRPCTypeTermination:
         case iTermMultiServerRPCTypeHello:
+        case iTermMultiServerRPCTypeReportChildren:
             break;
     }
     memset(obj, 0xAB, sizeof(*obj));
@@ -611,6 +882,12 @@ void iTermMultiServerServerOriginatedMessageFree(iTermMultiServerServerOriginate
         case iTermMultiServerRPCTypeHello:
             FreeHello(&obj->payload.hello);
             break;
+        case iTermMultiServerRPCTypeLaunchBatch:
+            FreeLaunchBatchResponse(&obj->payload.launchBatch);
+            break;
+        case iTermMultiServerRPCTypeReportChildren:
+            FreeReportChildren(&obj->payload.reportChildren);
+            break;
         case iTermMultiServerRPCTypeTermination:
             break;
     }
@@ -727,6 +1004,13 @@ static void LogLaunchRequest(iTermMultiServerRequestLaunch *message) {
     }
 }
 
+static void LogLaunchBatchRequest(iTermMultiServerRequestLaunchBatch *message) {
+    FDLog(LOG_DEBUG, "Launch batch request [count=%d]", message->count);
+    for (int i = 0; i < message->count; i++) {
+        LogLaunchRequest(&message->launches[i]);
+    }
+}
+
 static void LogWaitRequest(iTermMultiServerRequestWait *message) {
     FDLog(LOG_DEBUG, "Wait Request [pid=%d removePreemptively=%d]",
           message->pid, message->removePreemptively);
@@ -751,8 +1035,13 @@ iTermMultiServerProtocolLogMessageFromClient(iTermMultiServerClientOriginatedMes
             LogWaitRequest(&message->payload.wait);
             break;
 
+        case iTermMultiServerRPCTypeLaunchBatch:
+            LogLaunchBatchRequest(&message->payload.launchBatch);
+            break;
+
         case iTermMultiServerRPCTypeTermination:
         case iTermMultiServerRPCTypeHello:
+        case iTermMultiServerRPCTypeReportChildren:
             // Server-originated, no response.
             break;
     }
@@ -774,6 +1063,13 @@ static void LogLaunchResponse(iTermMultiServerResponseLaunch *message) {
           message->tty);
 }
 
+static void LogLaunchBatchResponse(iTermMultiServerResponseLaunchBatch *message) {
+    FDLog(LOG_DEBUG, "Launch batch response [count=%d]", message->count);
+    for (int i = 0; i < message->count; i++) {
+        LogLaunchResponse(&message->launches[i]);
+    }
+}
+
 static void LogReportChild(iTermMultiServerReportChild *message) {
     FDLog(LOG_DEBUG, "Report child [isLast=%d pid=%d path=%s isUTF8=%d pwd=%s terminated=%d tty=%s fd=%d argc=%d envc=%d]",
           message->isLast,
@@ -796,6 +1092,13 @@ static void LogReportChild(iTermMultiServerReportChild *message) {
     }
 }
 
+static void LogReportChildren(iTermMultiServerReportChildren *message) {
+    FDLog(LOG_DEBUG, "Report children [isLast=%d count=%d]", message->isLast, message->count);
+    for (int i = 0; i < message->count; i++) {
+        LogReportChild(&message->children[i]);
+    }
+}
+
 static void LogWaitResponse(iTermMultiServerResponseWait *message) {
     FDLog(LOG_DEBUG, "Wait response [pid=%d status=%d resultType=%d]",
           message->pid, message->status, message->resultType);
@@ -836,5 +1139,13 @@ iTermMultiServerProtocolLogMessageFromServer(iTermMultiServerServerOriginatedMes
         case iTermMultiServerRPCTypeHello:
             LogHello(&message->payload.hello);
             break;
+
+        case iTermMultiServerRPCTypeLaunchBatch:
+            LogLaunchBatchResponse(&message->payload.launchBatch);
+            break;
+
+        case iTermMultiServerRPCTypeReportChildren:
+            LogReportChildren(&message->payload.reportChildren);
+            break;
     }
 }
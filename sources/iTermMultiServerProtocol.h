@@ -10,9 +10,18 @@
 enum {
     iTermMultiServerProtocolVersionRejected = -1,
     iTermMultiServerProtocolVersion1 = 1,
-    iTermMultiServerProtocolVersion2 = 2
+    iTermMultiServerProtocolVersion2 = 2,
+    iTermMultiServerProtocolVersion3 = 3,  // Adds iTermMultiServerRPCTypeLaunchBatch
+    iTermMultiServerProtocolVersion4 = 4  // Adds iTermMultiServerRPCTypeReportChildren
 };
 
+// Launch batches can't be larger than this because all their file descriptors go in one control
+// message.
+#define iTermMultiServerMaximumLaunchBatchSize ITERM_MULTISERVER_MAX_FILE_DESCRIPTORS_PER_MESSAGE
+
+// Same limit as above: every reported child's PTY master goes in one control message.
+#define iTermMultiServerMaximumReportChildrenBatchSize ITERM_MULTISERVER_MAX_FILE_DESCRIPTORS_PER_MESSAGE
+
 typedef enum {
     iTermMultiServerTagType,
 
@@ -57,6 +66,12 @@ typedef enum {
 
     iTermMultiServerTagTerminationPid,
     iTermMultiServerTagTerminationStatus,
+
+    iTermMultiServerTagLaunchBatchRequestCount,
+    iTermMultiServerTagLaunchBatchResponseCount,
+
+    iTermMultiServerTagReportChildrenIsLast,
+    iTermMultiServerTagReportChildrenCount,
 } iTermMultiServerTagLaunch;
 
 typedef struct {
@@ -129,6 +144,25 @@ typedef struct {
     const char *tty;
 } iTermMultiServerResponseLaunch;
 
+// Requires iTermMultiServerProtocolVersion3. The server forks all the children before responding.
+typedef struct {
+    // iTermMultiServerTagLaunchBatchRequestCount
+    int count;
+
+    // Each is encoded like iTermMultiServerRequestLaunch.
+    iTermMultiServerRequestLaunch *launches;
+} iTermMultiServerRequestLaunchBatch;
+
+// NOTE: The PTY master file descriptors of the launches with a status of 0 are passed with this
+// message in a single control message, in the same order as the launches.
+typedef struct {
+    // iTermMultiServerTagLaunchBatchResponseCount
+    int count;
+
+    // Each is encoded like iTermMultiServerResponseLaunch.
+    iTermMultiServerResponseLaunch *launches;
+} iTermMultiServerResponseLaunchBatch;
+
 typedef struct {
     // iTermMultiServerTagWaitRequestPid
     pid_t pid;
@@ -198,6 +232,20 @@ typedef struct iTermMultiServerReportChild {
     int fd;
 } iTermMultiServerReportChild;
 
+// Requires iTermMultiServerProtocolVersion4. Sent instead of a run of iTermMultiServerReportChild
+// messages after the handshake. The PTY master file descriptors of all the children are passed
+// with this message in a single control message, in the same order as the children.
+typedef struct {
+    // iTermMultiServerTagReportChildrenIsLast
+    int isLast;
+
+    // iTermMultiServerTagReportChildrenCount
+    int count;
+
+    // Each is encoded like iTermMultiServerReportChild. Their isLast fields are always 0.
+    iTermMultiServerReportChild *children;
+} iTermMultiServerReportChildren;
+
 typedef enum {
     iTermMultiServerRPCTypeHandshake,  // Client-originated, has response
     iTermMultiServerRPCTypeLaunch,  // Client-originated, has response
@@ -205,6 +253,8 @@ typedef enum {
     iTermMultiServerRPCTypeReportChild,  // Server-originated, no response.
     iTermMultiServerRPCTypeTermination,  // Server-originated, no response.
     iTermMultiServerRPCTypeHello,  // Server-originated, no response.
+    iTermMultiServerRPCTypeLaunchBatch,  // Client-originated, has response
+    iTermMultiServerRPCTypeReportChildren,  // Server-originated, no response.
 } iTermMultiServerRPCType;
 
 // You should send iTermMultiServerResponseWait after getting this.
@@ -219,6 +269,7 @@ typedef struct {
         iTermMultiServerRequestHandshake handshake;
         iTermMultiServerRequestLaunch launch;
         iTermMultiServerRequestWait wait;
+        iTermMultiServerRequestLaunchBatch launchBatch;
     } payload;
 } iTermMultiServerClientOriginatedMessage;
 
@@ -234,6 +285,8 @@ typedef struct {
         iTermMultiServerReportTermination termination;
         iTermMultiServerReportChild reportChild;
         iTermMultiServerHello hello;
+        iTermMultiServerResponseLaunchBatch launchBatch;
+        iTermMultiServerReportChildren reportChildren;
     } payload;
 } iTermMultiServerServerOriginatedMessage;
 
@@ -274,6 +327,12 @@ int __attribute__((warn_unused_result))
 iTermMultiServerProtocolGetFileDescriptor(iTermClientServerProtocolMessage *message,
                                           int *receivedFileDescriptorPtr);
 
+// Get all the file descriptors from a received message. Returns the number of file descriptors
+// stored in `fds`, which is 0 if there are none. You own the file descriptors.
+int iTermMultiServerProtocolGetFileDescriptors(iTermClientServerProtocolMessage *message,
+                                               int *fds,
+                                               int capacity);
+
 void
 iTermMultiServerProtocolLogMessageFromClient(iTermMultiServerClientOriginatedMessage *message);
 
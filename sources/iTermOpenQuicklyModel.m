@@ -5,9 +5,9 @@
 #import "iTermApplicationDelegate.h"
 #import "iTermColorPresets.h"
 #import "iTermController.h"
+#import "iTermFuzzyMatcher.h"
 #import "iTermGitPollWorker.h"
 #import "iTermLogoGenerator.h"
-#import "iTermMinimumSubsequenceMatcher.h"
 #import "iTermOpenQuicklyCommands.h"
 #import "iTermOpenQuicklyItem.h"
 #import "iTermScriptsMenuController.h"
@@ -54,7 +54,11 @@ static const double kProfileNameMultiplierForColorPresetItem = 0.095;
 // Multipliers for script items. Ranks below profiles.
 static const double kProfileNameMultiplierForScriptItem = 0.09;
 
-@implementation iTermOpenQuicklyModel
+@implementation iTermOpenQuicklyModel {
+    // Lives as long as the window is open so documents are prepared only once and each keystroke
+    // that extends the query skips documents that didn't match before it.
+    iTermFuzzyMatcher *_matcher;
+}
 
 #pragma mark - Commands
 
@@ -200,7 +204,7 @@ static const double kProfileNameMultiplierForScriptItem = 0.09;
 }
 
 - (void)addSessionLocationToItems:(NSMutableArray<iTermOpenQuicklyItem *> *)items
-                    withMatcher:(iTermMinimumSubsequenceMatcher *)matcher {
+                    withMatcher:(iTermFuzzyMatcher *)matcher {
     NSString *(^detailFunction)(PTYSession *) = [self detailFunctionForSessions:self.sessions];
 
     for (PTYSession *session in self.sessions) {
@@ -236,7 +240,7 @@ static const double kProfileNameMultiplierForScriptItem = 0.09;
 }
 
 - (void)addCreateNewTabToItems:(NSMutableArray<iTermOpenQuicklyItem *> *)items
-                   withMatcher:(iTermMinimumSubsequenceMatcher *)matcher
+                   withMatcher:(iTermFuzzyMatcher *)matcher
              haveCurrentWindow:(BOOL)haveCurrentWindow {
     for (Profile *profile in [[ProfileModel sharedInstance] bookmarks]) {
         iTermOpenQuicklyProfileItem *newSessionWithProfileItem = [[iTermOpenQuicklyProfileItem alloc] init];
@@ -260,7 +264,7 @@ static const double kProfileNameMultiplierForScriptItem = 0.09;
 }
 
 - (void)addChangeColorPresetToItems:(NSMutableArray<iTermOpenQuicklyItem *> *)items
-                        withMatcher:(iTermMinimumSubsequenceMatcher *)matcher {
+                        withMatcher:(iTermFuzzyMatcher *)matcher {
     iTermColorPresetDictionary *allPresets = [iTermColorPresets allColorPresets];
     NSColor *defaultColor = [NSColor colorWithRed:0.5 green:0.5 blue:0.5 alpha:1];
     for (NSString *name in allPresets) {
@@ -288,7 +292,7 @@ static const double kProfileNameMultiplierForScriptItem = 0.09;
 }
 
 - (void)addChangeProfileToItems:(NSMutableArray<iTermOpenQuicklyItem *> *)items
-                    withMatcher:(iTermMinimumSubsequenceMatcher *)matcher {
+                    withMatcher:(iTermFuzzyMatcher *)matcher {
     for (Profile *profile in [[ProfileModel sharedInstance] bookmarks]) {
         iTermOpenQuicklyChangeProfileItem *changeProfileItem = [[iTermOpenQuicklyChangeProfileItem alloc] init];
         NSMutableAttributedString *attributedName = [[NSMutableAttributedString alloc] init];
@@ -305,7 +309,7 @@ static const double kProfileNameMultiplierForScriptItem = 0.09;
 }
 
 - (void)addActionsToItems:(NSMutableArray<iTermOpenQuicklyItem *> *)items
-              withMatcher:(iTermMinimumSubsequenceMatcher *)matcher {
+              withMatcher:(iTermFuzzyMatcher *)matcher {
     [[[iTermActionsModel sharedInstance] actions] enumerateObjectsUsingBlock:^(iTermAction * _Nonnull action, NSUInteger idx, BOOL * _Nonnull stop) {
         iTermOpenQuicklyActionItem *actionItem = [self actionItemForAction:action
                                                                    matcher:matcher];
@@ -316,7 +320,7 @@ static const double kProfileNameMultiplierForScriptItem = 0.09;
 }
 
 - (iTermOpenQuicklyActionItem *)actionItemForAction:(iTermAction *)action
-                                            matcher:(iTermMinimumSubsequenceMatcher *)matcher {
+                                            matcher:(iTermFuzzyMatcher *)matcher {
     iTermOpenQuicklyActionItem *actionItem = [[iTermOpenQuicklyActionItem alloc] init];
     actionItem.action = action;
     NSMutableAttributedString *attributedName = [[NSMutableAttributedString alloc] init];
@@ -333,7 +337,7 @@ static const double kProfileNameMultiplierForScriptItem = 0.09;
 }
 
 - (void)addSnippetsToItems:(NSMutableArray<iTermOpenQuicklyItem *> *)items
-               withMatcher:(iTermMinimumSubsequenceMatcher *)matcher {
+               withMatcher:(iTermFuzzyMatcher *)matcher {
     [[[iTermSnippetsModel sharedInstance] snippets] enumerateObjectsUsingBlock:^(iTermSnippet * _Nonnull snippet, NSUInteger idx, BOOL * _Nonnull stop) {
         iTermOpenQuicklySnippetItem *snippetItem = [self snippetItemForSnippet:snippet
                                                                        matcher:matcher];
@@ -344,7 +348,7 @@ static const double kProfileNameMultiplierForScriptItem = 0.09;
 }
 
 - (iTermOpenQuicklySnippetItem *)snippetItemForSnippet:(iTermSnippet *)snippet
-                                               matcher:(iTermMinimumSubsequenceMatcher *)matcher {
+                                               matcher:(iTermFuzzyMatcher *)matcher {
     iTermOpenQuicklySnippetItem *snippetItem = [[iTermOpenQuicklySnippetItem alloc] init];
     snippetItem.snippet = snippet;
     NSMutableAttributedString *attributedName = [[NSMutableAttributedString alloc] init];
@@ -362,7 +366,7 @@ static const double kProfileNameMultiplierForScriptItem = 0.09;
 
 
 - (iTermOpenQuicklyArrangementItem *)arrangementItemWithName:(NSString *)arrangementName
-                                                     matcher:(iTermMinimumSubsequenceMatcher *)matcher
+                                                     matcher:(iTermFuzzyMatcher *)matcher
                                                       inTabs:(BOOL)inTabs {
     iTermOpenQuicklyArrangementItem *item = [[iTermOpenQuicklyArrangementItem alloc] init];
     NSMutableAttributedString *attributedName = [[NSMutableAttributedString alloc] init];
@@ -383,7 +387,7 @@ static const double kProfileNameMultiplierForScriptItem = 0.09;
 }
 
 - (iTermOpenQuicklyScriptItem *)scriptItemWithName:(NSString *)scriptName
-                                           matcher:(iTermMinimumSubsequenceMatcher *)matcher {
+                                           matcher:(iTermFuzzyMatcher *)matcher {
     iTermOpenQuicklyScriptItem *item = [[iTermOpenQuicklyScriptItem alloc] init];
     NSMutableAttributedString *attributedName = [[NSMutableAttributedString alloc] init];
     item.score = [self scoreForScriptWithName:scriptName
@@ -402,7 +406,7 @@ static const double kProfileNameMultiplierForScriptItem = 0.09;
 }
 
 - (void)addOpenArrangementToItems:(NSMutableArray<iTermOpenQuicklyItem *> *)items
-                      withMatcher:(iTermMinimumSubsequenceMatcher *)matcher {
+                      withMatcher:(iTermFuzzyMatcher *)matcher {
     for (NSString *arrangementName in [WindowArrangements allNames]) {
         iTermOpenQuicklyArrangementItem *item;
         item = [self arrangementItemWithName:arrangementName matcher:matcher inTabs:NO];
@@ -417,7 +421,7 @@ static const double kProfileNameMultiplierForScriptItem = 0.09;
 }
 
 - (void)addScriptToItems:(NSMutableArray<iTermOpenQuicklyItem *> *)items
-             withMatcher:(iTermMinimumSubsequenceMatcher *)matcher {
+             withMatcher:(iTermFuzzyMatcher *)matcher {
     NSArray<NSString *> *allScripts = [[[[iTermApplication sharedApplication] delegate] scriptsMenuController] allScripts];
     for (NSString *script in allScripts) {
         iTermOpenQuicklyScriptItem *item;
@@ -432,13 +436,17 @@ static const double kProfileNameMultiplierForScriptItem = 0.09;
 
 - (void)removeAllItems {
     [_items removeAllObjects];
+    _matcher = nil;
 }
 
 - (void)updateWithQuery:(NSString *)queryString {
     id<iTermOpenQuicklyCommand> command = [self commandForQuery:[queryString lowercaseString]];
 
-    iTermMinimumSubsequenceMatcher *matcher =
-        [[iTermMinimumSubsequenceMatcher alloc] initWithQuery:command.text];
+    if (!_matcher) {
+        _matcher = [[iTermFuzzyMatcher alloc] init];
+    }
+    iTermFuzzyMatcher *matcher = _matcher;
+    matcher.query = command.text;
 
     NSMutableArray *items = [NSMutableArray array];
 
@@ -475,20 +483,16 @@ static const double kProfileNameMultiplierForScriptItem = 0.09;
         [self addSnippetsToItems:items withMatcher:matcher];
     }
 
-    // Sort from highest to lowest score.
-    [items sortUsingComparator:^NSComparisonResult(iTermOpenQuicklyItem *obj1,
-                                                   iTermOpenQuicklyItem *obj2) {
-        return [@(obj2.score) compare:@(obj1.score)];
-    }];
-
-    // To avoid performance issues, only keep the 100 best.
+    // To avoid performance issues, only keep the 100 best, from highest to lowest score.
     static const int kMaxItems = 100;
-    if (items.count > kMaxItems) {
-        [items removeObjectsInRange:NSMakeRange(kMaxItems, items.count - kMaxItems)];
-    }
+    NSArray *bestItems = [iTermFuzzyMatcher bestObjects:items
+                                           maximumCount:kMaxItems
+                                                  score:^double(iTermOpenQuicklyItem *item) {
+                                                      return item.score;
+                                                  }];
 
     // Replace self.items with new items.
-    self.items = items;
+    self.items = [bestItems mutableCopy];
 }
 
 - (id)objectAtIndex:(NSInteger)index {
@@ -522,7 +526,7 @@ static const double kProfileNameMultiplierForScriptItem = 0.09;
 #pragma mark - Scoring
 
 - (double)scoreForArrangementWithName:(NSString *)arrangementName
-                              matcher:(iTermMinimumSubsequenceMatcher *)matcher
+                              matcher:(iTermFuzzyMatcher *)matcher
                        attributedName:(NSMutableAttributedString *)attributedName {
     NSMutableArray *nameFeature = [NSMutableArray array];
     double score = [self scoreUsingMatcher:matcher
@@ -543,7 +547,7 @@ static const double kProfileNameMultiplierForScriptItem = 0.09;
 }
 
 - (double)scoreForScriptWithName:(NSString *)arrangementName
-                         matcher:(iTermMinimumSubsequenceMatcher *)matcher
+                         matcher:(iTermFuzzyMatcher *)matcher
                   attributedName:(NSMutableAttributedString *)attributedName {
     NSMutableArray *nameFeature = [NSMutableArray array];
     double score = [self scoreUsingMatcher:matcher
@@ -559,7 +563,7 @@ static const double kProfileNameMultiplierForScriptItem = 0.09;
 }
 
 - (double)scoreForAction:(iTermAction *)action
-                 matcher:(iTermMinimumSubsequenceMatcher *)matcher
+                 matcher:(iTermFuzzyMatcher *)matcher
           attributedName:(NSMutableAttributedString *)attributedName {
     NSMutableArray *nameFeature = [NSMutableArray array];
     double score = [self scoreUsingMatcher:matcher
@@ -575,7 +579,7 @@ static const double kProfileNameMultiplierForScriptItem = 0.09;
 }
 
 - (double)scoreForSnippet:(iTermSnippet *)snippet
-                  matcher:(iTermMinimumSubsequenceMatcher *)matcher
+                  matcher:(iTermFuzzyMatcher *)matcher
            attributedName:(NSMutableAttributedString *)attributedName {
     NSMutableArray *nameFeature = [NSMutableArray array];
     double score = [self scoreUsingMatcher:matcher
@@ -592,7 +596,7 @@ static const double kProfileNameMultiplierForScriptItem = 0.09;
 }
 
 - (double)scoreForColorPreset:(NSString *)presetName
-                      matcher:(iTermMinimumSubsequenceMatcher *)matcher
+                      matcher:(iTermFuzzyMatcher *)matcher
                attributedName:(NSMutableAttributedString *)attributedName {
     NSMutableArray *nameFeature = [NSMutableArray array];
     double score = [self scoreUsingMatcher:matcher
@@ -608,7 +612,7 @@ static const double kProfileNameMultiplierForScriptItem = 0.09;
 }
 
 - (double)scoreForProfile:(Profile *)profile
-                  matcher:(iTermMinimumSubsequenceMatcher *)matcher
+                  matcher:(iTermFuzzyMatcher *)matcher
            attributedName:(NSMutableAttributedString *)attributedName {
     NSMutableArray *nameFeature = [NSMutableArray array];
     double score = [self scoreUsingMatcher:matcher
@@ -639,7 +643,7 @@ static const double kProfileNameMultiplierForScriptItem = 0.09;
 // attributedName: The session's name with matching characters highlighted
 //   (suitable for display) will be appended to this NSMutableAttributedString.
 - (double)scoreForSession:(PTYSession *)session
-                  matcher:(iTermMinimumSubsequenceMatcher *)matcher
+                  matcher:(iTermFuzzyMatcher *)matcher
                  features:(NSMutableArray *)features
            attributedName:(NSMutableAttributedString *)attributedName {
     double score = 0;
@@ -747,7 +751,7 @@ static const double kProfileNameMultiplierForScriptItem = 0.09;
 // features: The highest-scoring document will have an NSAttributedString added
 //   to this array describing the match, suitable for display.
 // limit: Upper bound for the returned score.
-- (double)scoreUsingMatcher:(iTermMinimumSubsequenceMatcher *)matcher
+- (double)scoreUsingMatcher:(iTermFuzzyMatcher *)matcher
                   documents:(NSArray *)documents
                  multiplier:(double)multiplier
                        name:(NSString *)name
@@ -772,15 +776,11 @@ static const double kProfileNameMultiplierForScriptItem = 0.09;
     }
     double score = 0;
     double highestValue = 0;
-    NSString *bestFeature = nil;
-    NSIndexSet *bestIndexSet = nil;
+    iTermFuzzyMatchDocument *bestDocument = nil;
     int n = documents.count;
-    NSMutableIndexSet *indexSet = [NSMutableIndexSet indexSet];
     for (NSString *document in documents) {
-        [indexSet removeAllIndexes];
-        double value = [self qualityOfMatchWithMatcher:matcher
-                                              document:[document lowercaseString]
-                                              indexSet:indexSet];
+        iTermFuzzyMatchDocument *fuzzyDocument = [matcher documentForString:document];
+        double value = [matcher qualityOfMatchForDocument:fuzzyDocument];
 
         // Discount older documents (which appear at the beginning of the list)
         value /= n;
@@ -788,8 +788,7 @@ static const double kProfileNameMultiplierForScriptItem = 0.09;
 
         if (value > highestValue) {
             highestValue = value;
-            bestFeature = document;
-            bestIndexSet = [indexSet copy];
+            bestDocument = fuzzyDocument;
         }
         score += value * multiplier;
         if (score > limit) {
@@ -797,56 +796,17 @@ static const double kProfileNameMultiplierForScriptItem = 0.09;
         }
     }
 
-    if (bestFeature && features) {
+    if (bestDocument && features) {
+        // Only the best document is displayed, so only it needs its matching indexes.
         id displayString = [_delegate openQuicklyModelDisplayStringForFeatureNamed:name
-                                                                             value:bestFeature
-                                                                highlightedIndexes:bestIndexSet];
+                                                                             value:bestDocument.string
+                                                                highlightedIndexes:[matcher indexSetForDocument:bestDocument]];
         [features addObject:@[ displayString, @(score) ]];
     }
 
     return MIN(limit, score);
 }
 
-// Returns a value between 0 and 1 for how well a query matches a document.
-// The passed-in indexSet will be populated with indices into documentString
-// that were found to match query.
-// The current implementation returns:
-//   1.0 if query equals document.
-//   0.9 if query is a prefix of document.
-//   0.5 if query is a substring of document
-//   0 < score < 0.5 if query is a subsequence of a document. Each gap of non-matching characters
-//       increases the penalty.
-//   0.0 otherwise
-- (double)qualityOfMatchWithMatcher:(iTermMinimumSubsequenceMatcher *)matcher
-                           document:(NSString *)documentString
-                           indexSet:(NSMutableIndexSet *)indexSet {
-    [indexSet addIndexes:[matcher indexSetForDocument:documentString]];
-
-    double score;
-    if (!indexSet.count) {
-        // No match
-        score = 0;
-    } else if (indexSet.firstIndex == 0 && indexSet.lastIndex == documentString.length - 1) {
-        // Exact equality
-        score = 1;
-    } else if (indexSet.firstIndex == 0) {
-        // Is a prefix
-        score = 0.9;
-    } else {
-        score = 0.5 / ([self numberOfGapsInIndexSet:indexSet] + 1);
-    }
-
-    return score;
-}
-
-- (NSInteger)numberOfGapsInIndexSet:(NSIndexSet *)indexSet {
-    __block NSInteger numRanges = 0;
-    [indexSet enumerateRangesUsingBlock:^(NSRange range, BOOL *stop) {
-        ++numRanges;
-    }];
-    return numRanges - 1;
-}
-
 #pragma mark - Feature Extraction
 
 // Returns an array of hostnames from an array of VT100RemoteHost*s
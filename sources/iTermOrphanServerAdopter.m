@@ -196,10 +196,19 @@ static void iTermOrphanServerAdopterFindMultiServers(void (^completion)(NSArray<
                              socketNumber:(NSInteger)number
                                     state:(iTermMainThreadState *)state
                                completion:(void (^)(void))completion {
+    DLog(@"Multiserver adoption waiting for children to be reported.");
+    [connection getUnattachedChildrenWithCallback:[iTermThread.main newCallbackWithBlock:^(iTermMainThreadState *state,
+                                                                                           NSArray<iTermFileDescriptorMultiClientChild *> *children) {
+        [self adoptMultiserverChildren:children socketNumber:number completion:completion];
+    }]];
+}
+
+- (void)adoptMultiserverChildren:(NSArray<iTermFileDescriptorMultiClientChild *> *)children
+                    socketNumber:(NSInteger)number
+                      completion:(void (^)(void))completion {
     dispatch_group_t group = dispatch_group_create();
 
     DLog(@"Multiserver adoption beginning.");
-    NSArray<iTermFileDescriptorMultiClientChild *> *children = [connection.unattachedChildren copy];
     for (iTermFileDescriptorMultiClientChild *child in children) {
         iTermGeneralServerConnection generalConnection = {
             .type = iTermGeneralServerConnectionTypeMulti,
@@ -0,0 +1,56 @@
+//
+//  iTermScrollbackExporter.h
+//  iTerm2SharedARC
+//
+//  Created by George Nachman on 10/18/26.
+//
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+@class ITMGetScrollbackRequest;
+@class ITMGetScrollbackResponse;
+@class LineBuffer;
+
+// Converts a snapshot of a session's history into GetScrollbackResponse chunks. The snapshot owns
+// copies of the lines it holds, which lets the conversion run off the main thread while the
+// session keeps running.
+@interface iTermScrollbackExporter : NSObject
+
+// Absolute line number of the first line in the snapshot.
+@property (nonatomic, readonly) long long firstLine;
+
+// Absolute line number just past the last line in the snapshot.
+@property (nonatomic, readonly) long long endOfBuffer;
+
+// A serial queue on which exports should be performed.
++ (dispatch_queue_t)queue;
+
+// Returns the absolute line numbers that a response to |request| will contain, so the caller can
+// take a snapshot of just those lines. The location is NSNotFound if the cursor is invalid.
++ (NSRange)rangeOfLinesForRequest:(ITMGetScrollbackRequest *)request
+                        firstLine:(long long)firstLine
+                      endOfBuffer:(long long)endOfBuffer;
+
+// |lineBuffer| holds part of a history of lines numbered [firstLine, endOfBuffer). Its line 0 has
+// absolute line number |firstLineOfBuffer|. It must not be modified after this is called, and
+// requests may only ask for the lines it holds.
+- (instancetype)initWithLineBuffer:(LineBuffer *)lineBuffer
+                             width:(int)width
+                         firstLine:(long long)firstLine
+                 firstLineOfBuffer:(long long)firstLineOfBuffer
+                       endOfBuffer:(long long)endOfBuffer NS_DESIGNATED_INITIALIZER;
+
+// Exports the whole of |lineBuffer|, whose line 0 has absolute line number |overflow|.
+- (instancetype)initWithLineBuffer:(LineBuffer *)lineBuffer
+                             width:(int)width
+                          overflow:(long long)overflow;
+- (instancetype)init NS_UNAVAILABLE;
+
+// Returns one chunk of lines. May be called on any thread, but not concurrently.
+- (ITMGetScrollbackResponse *)responseForRequest:(ITMGetScrollbackRequest *)request;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,178 @@
+//
+//  iTermScrollbackExporter.m
+//  iTerm2SharedARC
+//
+//  Created by George Nachman on 10/18/26.
+//
+
+#import "iTermScrollbackExporter.h"
+
+#import "Api.pbobjc.h"
+#import "DebugLogging.h"
+#import "LineBuffer.h"
+#import "ScreenChar.h"
+
+// Used when the request doesn't specify max_lines.
+static const int iTermScrollbackExporterDefaultMaxLines = 1000;
+
+// Upper bound on max_lines so a single response can't get enormous.
+static const int iTermScrollbackExporterMaximumMaxLines = 10000;
+
+@implementation iTermScrollbackExporter {
+    LineBuffer *_lineBuffer;
+    long long _firstLineOfBuffer;
+    int _width;
+    // Reused across lines so converting a line doesn't have to allocate a buffer.
+    NSMutableData *_characters;
+}
+
++ (dispatch_queue_t)queue {
+    static dispatch_queue_t queue;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        queue = dispatch_queue_create("com.iterm2.scrollback-export", DISPATCH_QUEUE_SERIAL);
+    });
+    return queue;
+}
+
++ (NSRange)rangeOfLinesForRequest:(ITMGetScrollbackRequest *)request
+                        firstLine:(long long)firstLine
+                      endOfBuffer:(long long)endOfBuffer {
+    long long start = request.hasCursor ? request.cursor : firstLine;
+    if (start > endOfBuffer) {
+        return NSMakeRange(NSNotFound, 0);
+    }
+    // Lines before the first available one have been lost. Skip them; the client can tell by
+    // comparing first_line to the cursor it sent.
+    start = MAX(start, firstLine);
+
+    int maxLines = iTermScrollbackExporterDefaultMaxLines;
+    if (request.hasMaxLines && request.maxLines > 0) {
+        maxLines = MIN(request.maxLines, iTermScrollbackExporterMaximumMaxLines);
+    }
+    return NSMakeRange(start, MIN((long long)maxLines, endOfBuffer - start));
+}
+
+- (instancetype)initWithLineBuffer:(LineBuffer *)lineBuffer
+                             width:(int)width
+                         firstLine:(long long)firstLine
+                 firstLineOfBuffer:(long long)firstLineOfBuffer
+                       endOfBuffer:(long long)endOfBuffer {
+    self = [super init];
+    if (self) {
+        _lineBuffer = lineBuffer;
+        _width = width;
+        _firstLine = firstLine;
+        _firstLineOfBuffer = firstLineOfBuffer;
+        _endOfBuffer = endOfBuffer;
+        _characters = [NSMutableData dataWithLength:sizeof(unichar) * MAX(1, width) * kMaxParts];
+    }
+    return self;
+}
+
+- (instancetype)initWithLineBuffer:(LineBuffer *)lineBuffer
+                             width:(int)width
+                          overflow:(long long)overflow {
+    return [self initWithLineBuffer:lineBuffer
+                              width:width
+                          firstLine:overflow
+                  firstLineOfBuffer:overflow
+                        endOfBuffer:overflow + [lineBuffer numLinesWithWidth:width]];
+}
+
+- (ITMGetScrollbackResponse *)responseForRequest:(ITMGetScrollbackRequest *)request {
+    ITMGetScrollbackResponse *response = [[ITMGetScrollbackResponse alloc] init];
+    response.endOfBuffer = _endOfBuffer;
+
+    const NSRange range = [iTermScrollbackExporter rangeOfLinesForRequest:request
+                                                                firstLine:_firstLine
+                                                              endOfBuffer:_endOfBuffer];
+    if (range.location == NSNotFound) {
+        response.status = ITMGetScrollbackResponse_Status_InvalidCursor;
+        return response;
+    }
+    const long long start = range.location;
+    const int count = (int)range.length;
+    DLog(@"Export %@ lines starting at %@ of [%@, %@)", @(count), @(start), @(_firstLine), @(_endOfBuffer));
+    assert(count == 0 || start >= _firstLineOfBuffer);
+
+    response.status = ITMGetScrollbackResponse_Status_Ok;
+    response.firstLine = start;
+    response.nextCursor = start + count;
+
+    const BOOL textOnly = request.textOnly;
+    NSMutableArray<ITMLineContents *> *contentsArray = response.contentsArray;
+    [_lineBuffer enumerateLinesInRange:NSMakeRange(start - _firstLineOfBuffer, count)
+                                 width:_width
+                                 block:^(screen_char_t *chars,
+                                         int length,
+                                         int eol,
+                                         screen_char_t continuation,
+                                         BOOL *stop) {
+        [contentsArray addObject:[self lineContentsForChars:chars
+                                                     length:length
+                                                        eol:eol
+                                                   textOnly:textOnly]];
+    }];
+    return response;
+}
+
+#pragma mark - Private
+
+- (ITMLineContents *)lineContentsForChars:(screen_char_t *)screenChars
+                                   length:(int)length
+                                      eol:(int)eol
+                                 textOnly:(BOOL)textOnly {
+    ITMLineContents *lineContents = [[ITMLineContents alloc] init];
+    unichar *characters = _characters.mutableBytes;
+    NSMutableArray<ITMCodePointsPerCell *> *cppsArray = textOnly ? nil : lineContents.codePointsPerCellArray;
+    int numCodePointsInRun = 1;
+    int repeats = 0;
+    int o = 0;
+    for (int i = 0; i < length; ++i) {
+        int numCodePoints;
+        const unichar c = screenChars[i].code;
+        if (!screenChars[i].complexChar &&
+            (c == 0 || (c >= ITERM2_PRIVATE_BEGIN && c <= ITERM2_PRIVATE_END))) {
+            numCodePoints = 0;
+        } else if (screenChars[i].image) {
+            numCodePoints = 0;
+        } else {
+            numCodePoints = ExpandScreenChar(&screenChars[i], characters + o);
+            o += numCodePoints;
+        }
+        if (!cppsArray) {
+            continue;
+        }
+        if (numCodePoints != numCodePointsInRun && repeats > 0) {
+            [cppsArray addObject:[self codePointsPerCell:numCodePointsInRun repeats:repeats]];
+            repeats = 0;
+        }
+        numCodePointsInRun = numCodePoints;
+        repeats += 1;
+    }
+    if (cppsArray && repeats > 0) {
+        [cppsArray addObject:[self codePointsPerCell:numCodePointsInRun repeats:repeats]];
+    }
+    lineContents.text = [[NSString alloc] initWithCharacters:characters length:o];
+    switch (eol) {
+        case EOL_HARD:
+            lineContents.continuation = ITMLineContents_Continuation_ContinuationHardEol;
+            break;
+
+        case EOL_SOFT:
+        case EOL_DWC:
+            lineContents.continuation = ITMLineContents_Continuation_ContinuationSoftEol;
+            break;
+    }
+    return lineContents;
+}
+
+- (ITMCodePointsPerCell *)codePointsPerCell:(int)numCodePoints repeats:(int)repeats {
+    ITMCodePointsPerCell *cpps = [[ITMCodePointsPerCell alloc] init];
+    cpps.numCodePoints = numCodePoints;
+    cpps.repeats = repeats;
+    return cpps;
+}
+
+@end
@@ -8,6 +8,7 @@
 
 #import "iTermSelection.h"
 #import "DebugLogging.h"
+#import "iTermSelectionIndex.h"
 #import "NSArray+iTerm.h"
 #import "NSDictionary+iTerm.h"
 #import "NSIndexSet+iTerm.h"
@@ -148,6 +149,8 @@ static NSString *const kiTermSubSelectionMode = @"Mode";
     BOOL _live;
     BOOL _extend;
     NSMutableArray *_subSelections;  // iTermSubSelection array
+    // Index of _subSelections, excluding the live one. Made on demand; nil after they change.
+    iTermSelectionIndex *_subSelectionIndex;
 }
 
 + (NSString *)nameForMode:(iTermSelectionMode)mode {
@@ -179,6 +182,7 @@ static NSString *const kiTermSubSelectionMode = @"Mode";
 
 - (void)dealloc {
     [_subSelections release];
+    [_subSelectionIndex release];
     [super dealloc];
 }
 
@@ -216,6 +220,7 @@ static NSString *const kiTermSubSelectionMode = @"Mode";
         _absRange = sub.absRange;
         _selectionMode = sub.selectionMode;
         [_subSelections removeLastObject];
+        [self subSelectionsDidChange];
     }
     DLog(@"Begin extending selection.");
     _live = YES;
@@ -367,6 +372,7 @@ static NSString *const kiTermSubSelectionMode = @"Mode";
     if (!_appending) {
         [_subSelections removeAllObjects];
     }
+    [self subSelectionsDidChange];
     DLog(@"Begin new selection. coord=%@, extend=%d", VT100GridAbsCoordDescription(absCoord), extend);
     _live = YES;
     _extend = NO;
@@ -424,6 +430,7 @@ static NSString *const kiTermSubSelectionMode = @"Mode";
             _resumable = NO;
         }
     }
+    [self subSelectionsDidChange];
     _absRange = VT100GridAbsWindowedRangeMake(VT100GridAbsCoordRangeMake(-1, -1, -1, -1), 0, 0);
     _extend = NO;
     _live = NO;
@@ -481,6 +488,7 @@ static NSString *const kiTermSubSelectionMode = @"Mode";
         DLog(@"Clear selection");
         _absRange = VT100GridAbsWindowedRangeMake(VT100GridAbsCoordRangeMake(-1, -1, -1, -1), 0, 0);
         [_subSelections removeAllObjects];
+        [self subSelectionsDidChange];
         [_delegate selectionDidChange:[[self retain] autorelease]];
     }
 }
@@ -636,6 +644,7 @@ static NSString *const kiTermSubSelectionMode = @"Mode";
     for (iTermSubSelection *sub in subsToRemove) {
         [_subSelections removeObject:sub];
     }
+    [self subSelectionsDidChange];
 
     if (notifyDelegateOfChange) {
         [_delegate selectionDidChange:self];
@@ -654,11 +663,15 @@ static NSString *const kiTermSubSelectionMode = @"Mode";
     if (![self hasSelection]) {
         return NO;
     }
-    BOOL contained = NO;
-    for (iTermSubSelection *sub in [self allSubSelections]) {
+    __block BOOL contained = NO;
+    [[self subSelectionIndex] enumerateSubSelectionsOnAbsoluteLine:absCoord.y
+                                                              block:^(iTermSubSelection *sub) {
         if ([sub containsAbsCoord:absCoord]) {
             contained = !contained;
         }
+    }];
+    if ([self haveLiveSelection] && [[self liveSubSelection] containsAbsCoord:absCoord]) {
+        contained = !contained;
     }
 
     return contained;
@@ -771,16 +784,34 @@ static NSString *const kiTermSubSelectionMode = @"Mode";
     if ([self haveLiveSelection]) {
         NSMutableArray *subs = [NSMutableArray array];
         [subs addObjectsFromArray:_subSelections];
-        iTermSubSelection *temp = [iTermSubSelection subSelectionWithAbsRange:[self unflippedLiveAbsRange]
-                                                                         mode:_selectionMode
-                                                                        width:self.width];
-        [subs addObject:temp];
+        [subs addObject:[self liveSubSelection]];
         return subs;
     } else {
         return _subSelections;
     }
 }
 
+- (iTermSubSelection *)liveSubSelection {
+    return [iTermSubSelection subSelectionWithAbsRange:[self unflippedLiveAbsRange]
+                                                  mode:_selectionMode
+                                                 width:self.width];
+}
+
+- (void)subSelectionsDidChange {
+    [_subSelectionIndex release];
+    _subSelectionIndex = nil;
+}
+
+- (iTermSelectionIndex *)subSelectionIndex {
+    const int width = [self width];
+    if (!_subSelectionIndex || _subSelectionIndex.width != width) {
+        [_subSelectionIndex release];
+        _subSelectionIndex = [[iTermSelectionIndex alloc] initWithSubSelections:_subSelections
+                                                                          width:width];
+    }
+    return _subSelectionIndex;
+}
+
 - (VT100GridAbsCoordRange)spanningAbsRange {
     VT100GridAbsCoordRange span = VT100GridAbsCoordRangeMake(-1, -1, -1, -1);
     for (iTermSubSelection *sub in [self allSubSelections]) {
@@ -838,6 +869,7 @@ static NSString *const kiTermSubSelectionMode = @"Mode";
                                   withObject:[iTermSubSelection subSelectionWithAbsRange:firstRange
                                                                                     mode:mode
                                                                                    width:self.width]];
+        [self subSelectionsDidChange];
     }
     [_delegate selectionDidChange:[[self retain] autorelease]];
 }
@@ -852,6 +884,7 @@ static NSString *const kiTermSubSelectionMode = @"Mode";
         [_subSelections addObject:[iTermSubSelection subSelectionWithAbsRange:lastRange
                                                                          mode:mode
                                                                         width:self.width]];
+        [self subSelectionsDidChange];
     }
     [_delegate selectionDidChange:[[self retain] autorelease]];
 }
@@ -870,6 +903,7 @@ static NSString *const kiTermSubSelectionMode = @"Mode";
         }
         [_subSelections addObject:sub];
     }
+    [self subSelectionsDidChange];
     [_delegate selectionDidChange:[[self retain] autorelease]];
 }
 
@@ -892,72 +926,13 @@ static NSString *const kiTermSubSelectionMode = @"Mode";
     }
     [_subSelections autorelease];
     _subSelections = [newSubs retain];
-}
-
-static NSRange iTermMakeRange(NSInteger location, NSInteger length) {
-    if (location < 0) {
-        return iTermMakeRange(0, length + location);
-    }
-    if (location > NSNotFound) {
-        return NSMakeRange(NSNotFound, 0);
-    }
-    return NSMakeRange(location, MAX(0, length));
+    [self subSelectionsDidChange];
 }
 
 - (NSRange)rangeOfIndexesInAbsRange:(VT100GridAbsWindowedRange)range
                      onAbsoluteLine:(long long)line
                                mode:(iTermSelectionMode)mode {
-    if (mode == kiTermSelectionModeBox) {
-        if (range.coordRange.start.y <= line && range.coordRange.end.y >= line) {
-            return iTermMakeRange(range.coordRange.start.x,
-                                  range.coordRange.end.x - range.coordRange.start.x);
-        } else {
-            return iTermMakeRange(0, 0);
-        }
-    }
-    if (range.coordRange.start.y < line && range.coordRange.end.y > line) {
-        if (range.columnWindow.length) {
-            return iTermMakeRange(range.columnWindow.location,
-                                  range.columnWindow.length);
-        } else {
-            return iTermMakeRange(0, [self width]);
-        }
-    }
-    if (range.coordRange.start.y == line) {
-        if (range.coordRange.end.y == line) {
-            if (range.columnWindow.length) {
-                int limit = VT100GridRangeMax(range.columnWindow) + 1;
-                NSRange result;
-                result.location = MAX(range.columnWindow.location, range.coordRange.start.x);
-                result.length = MIN(limit, range.coordRange.end.x) - result.location;
-                return result;
-            } else {
-                return iTermMakeRange(range.coordRange.start.x,
-                                      range.coordRange.end.x - range.coordRange.start.x);
-            }
-        } else {
-            if (range.columnWindow.length) {
-                int limit = VT100GridRangeMax(range.columnWindow) + 1;
-                NSRange result;
-                result.location = MAX(range.columnWindow.location, range.coordRange.start.x);
-                result.length = MIN(limit, [self width]) - result.location;
-                return result;
-            } else {
-                return iTermMakeRange(range.coordRange.start.x,
-                                      [self width] - range.coordRange.start.x);
-            }
-        }
-    }
-    if (range.coordRange.end.y == line) {
-        if (range.columnWindow.length) {
-            int limit = VT100GridRangeMax(range.columnWindow) + 1;
-            return iTermMakeRange(range.columnWindow.location,
-                                  MIN(limit, range.coordRange.end.x) - range.columnWindow.location);
-        } else {
-            return iTermMakeRange(0, range.coordRange.end.x);
-        }
-    }
-    return iTermMakeRange(0, 0);
+    return iTermSelectionRangeOfIndexesInAbsRange(range, line, mode, [self width]);
 }
 
 - (NSIndexSet *)selectedIndexesOnAbsoluteLine:(long long)line {
@@ -982,29 +957,19 @@ static NSRange iTermMakeRange(NSInteger location, NSInteger length) {
         return [NSIndexSet it_indexSetWithIndexesInRange:theRange];
     }
 
-    // Slow path.
-    NSMutableIndexSet *indexes = [NSMutableIndexSet indexSet];
-    for (iTermSubSelection *sub in [self allSubSelections]) {
-        VT100GridAbsWindowedRange range = sub.absRange;
-        NSRange theRange = [self rangeOfIndexesInAbsRange:range
-                                           onAbsoluteLine:line
-                                                     mode:sub.selectionMode];
-
-        // Any values in theRange that intersect indexes should be removed from indexes.
-        // And values in theSet that don't intersect indexes should be added to indexes.
-        NSMutableIndexSet *indexesToAdd = [NSMutableIndexSet it_indexSetWithIndexesInRange:theRange];
-        NSMutableIndexSet *indexesToRemove = [NSMutableIndexSet indexSet];
-
-        [indexes enumerateRangesInRange:theRange options:0 usingBlock:^(NSRange innerRange, BOOL *stop) {
-            // innerRange exists in both indexes and theRange
-            [indexesToRemove addIndexesInRange:innerRange];
-            [indexesToAdd removeIndexesInRange:innerRange];
-        }];
-        [indexes removeIndexes:indexesToRemove];
-        [indexes addIndexes:indexesToAdd];
+    // Slow path. Most sub-selections don't touch this line, so use the index to find those that do.
+    NSIndexSet *indexes = [[self subSelectionIndex] selectedIndexesOnAbsoluteLine:line];
+    if (![self haveLiveSelection]) {
+        return indexes;
     }
-
-    return indexes;
+    // The live sub-selection changes as the mouse moves, so it's not in the index.
+    iTermSubSelection *live = [self liveSubSelection];
+    NSMutableIndexSet *result = [[indexes mutableCopy] autorelease];
+    iTermSelectionToggleIndexesInRange(result,
+                                       [self rangeOfIndexesInAbsRange:live.absRange
+                                                       onAbsoluteLine:line
+                                                                 mode:live.selectionMode]);
+    return result;
 }
 
 // orphaned tab fillers are selected iff they are in the selection.
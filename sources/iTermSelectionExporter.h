@@ -0,0 +1,72 @@
+//
+//  iTermSelectionExporter.h
+//  iTerm2SharedARC
+//
+//  Created by George Nachman on 10/18/26.
+//
+
+#import <Cocoa/Cocoa.h>
+
+#import "VT100GridTypes.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+@class iTermSelection;
+@class LineBuffer;
+
+// Produces the text of a selection a piece at a time from a snapshot of a session's history, so
+// copying or saving a huge selection never holds all of its text in memory at once. The text is
+// the same as copying produces: each piece is extracted by iTermTextExtractor from a run of lines
+// that ends at a hard newline, so trimming trailing whitespace works as it does on the whole.
+@interface iTermSelectionExporter : NSObject
+
+// These have the same meaning as for -[iTermTextExtractor contentInRange:...].
+@property (nonatomic) BOOL includeLastNewline;
+@property (nonatomic) BOOL trimTrailingWhitespace;
+
+// Number of lines extracted at a time. Runs are extended to the next hard newline.
+@property (nonatomic) int linesPerChunk;
+
+// Called on the exporting thread after each piece with the fraction of lines done.
+@property (nullable, nonatomic, copy) void (^progress)(double fractionCompleted);
+
+@property (atomic, readonly) BOOL cancelled;
+
+// A serial queue on which exports should be performed.
++ (dispatch_queue_t)queue;
+
+// |lineBuffer| must not be modified after this is called. Line 0 of |lineBuffer| has absolute
+// line number |overflow|.
+- (instancetype)initWithLineBuffer:(LineBuffer *)lineBuffer
+                             width:(int)width
+                          overflow:(long long)overflow NS_DESIGNATED_INITIALIZER;
+- (instancetype)init NS_UNAVAILABLE;
+
+// Adds a range to export. If |newline| is set, a newline follows its text unless it already ends
+// with one. Ranges that begin before the first line of the snapshot are skipped, as when copying.
+- (void)addAbsRange:(VT100GridAbsWindowedRange)absRange newline:(BOOL)newline;
+
+// Adds the ranges of a selection. Call on the main thread.
+- (void)addRangesOfSelection:(iTermSelection *)selection;
+
+// Stops an export in progress. May be called on any thread.
+- (void)cancel;
+
+// Calls |block| with consecutive pieces of the text. Returns NO if canceled or stopped.
+- (BOOL)enumerateChunksUsingBlock:(void (^ NS_NOESCAPE)(NSString *chunk, BOOL *stop))block;
+
+// Writes the text as UTF-8. On failure or cancellation the partial file is removed and NO is
+// returned.
+- (BOOL)writeToURL:(NSURL *)url error:(NSError * _Nullable *)error;
+
+@end
+
+// Puts a text file on the pasteboard without reading it until it's pasted, and then only by
+// mapping it. Removes the file when the pasteboard no longer needs it.
+@interface iTermFilePasteboardDataProvider : NSObject<NSPasteboardItemDataProvider>
+
++ (BOOL)writeTextFileAtURL:(NSURL *)url toPasteboard:(NSPasteboard *)pasteboard;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,361 @@
+//
+//  iTermSelectionExporter.m
+//  iTerm2SharedARC
+//
+//  Created by George Nachman on 10/18/26.
+//
+
+#import "iTermSelectionExporter.h"
+
+#import "DebugLogging.h"
+#import "iTermSelection.h"
+#import "iTermTextExtractor.h"
+#import "LineBuffer.h"
+#import "PTYTextViewDataSource.h"
+#import "ScreenChar.h"
+
+static const int iTermSelectionExporterDefaultLinesPerChunk = 4096;
+
+typedef struct {
+    VT100GridAbsWindowedRange absRange;
+    BOOL newline;
+} iTermSelectionExporterRange;
+
+// A run of lines copied out of the line buffer, laid out like the screen's lines so
+// iTermTextExtractor can read them. Line 0 is the first line of the run.
+@interface iTermSelectionExporterLines : NSObject<iTermTextDataSource>
+@property (nonatomic, readonly) int count;
+- (instancetype)initWithWidth:(int)width;
+- (void)removeAllLines;
+- (void)appendChars:(const screen_char_t *)chars
+             length:(int)length
+                eol:(int)eol
+       continuation:(screen_char_t)continuation;
+- (BOOL)lineHasHardNewline:(int)line;
+@end
+
+@implementation iTermSelectionExporterLines {
+    int _width;
+    NSMutableData *_data;
+}
+
+- (instancetype)initWithWidth:(int)width {
+    self = [super init];
+    if (self) {
+        _width = width;
+        _data = [NSMutableData data];
+    }
+    return self;
+}
+
+- (void)removeAllLines {
+    _data.length = 0;
+    _count = 0;
+}
+
+// Same conversion as -[VT100Screen getLineAtIndex:withBuffer:].
+- (void)appendChars:(const screen_char_t *)chars
+             length:(int)length
+                eol:(int)eol
+       continuation:(screen_char_t)continuation {
+    const size_t stride = sizeof(screen_char_t) * (_width + 1);
+    [_data increaseLengthBy:stride];
+    screen_char_t *line = (screen_char_t *)((uint8_t *)_data.mutableBytes + stride * _count);
+    memcpy(line, chars, sizeof(screen_char_t) * MIN(length, _width));
+    if (eol == EOL_DWC) {
+        line[_width - 1].code = DWC_SKIP;
+        line[_width - 1].complexChar = NO;
+    }
+    line[_width] = continuation;
+    line[_width].code = eol;
+    _count += 1;
+}
+
+- (BOOL)lineHasHardNewline:(int)line {
+    return [self getLineAtIndex:line][_width].code == EOL_HARD;
+}
+
+#pragma mark - iTermTextDataSource
+
+- (int)width {
+    return _width;
+}
+
+- (int)numberOfLines {
+    return _count;
+}
+
+- (screen_char_t *)getLineAtIndex:(int)theIndex {
+    return (screen_char_t *)((uint8_t *)_data.mutableBytes + sizeof(screen_char_t) * (_width + 1) * theIndex);
+}
+
+- (long long)totalScrollbackOverflow {
+    return 0;
+}
+
+@end
+
+@interface iTermSelectionExporter ()
+@property (atomic, readwrite) BOOL cancelled;
+@end
+
+@implementation iTermSelectionExporter {
+    LineBuffer *_lineBuffer;
+    int _width;
+    long long _overflow;
+    int _numberOfLines;
+    NSMutableData *_ranges;
+}
+
++ (dispatch_queue_t)queue {
+    static dispatch_queue_t queue;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        queue = dispatch_queue_create("com.iterm2.selection-export", DISPATCH_QUEUE_SERIAL);
+    });
+    return queue;
+}
+
+- (instancetype)initWithLineBuffer:(LineBuffer *)lineBuffer
+                             width:(int)width
+                          overflow:(long long)overflow {
+    self = [super init];
+    if (self) {
+        _lineBuffer = lineBuffer;
+        _width = width;
+        _overflow = overflow;
+        _numberOfLines = [lineBuffer numLinesWithWidth:width];
+        _ranges = [NSMutableData data];
+        _linesPerChunk = iTermSelectionExporterDefaultLinesPerChunk;
+    }
+    return self;
+}
+
+- (void)addAbsRange:(VT100GridAbsWindowedRange)absRange newline:(BOOL)newline {
+    iTermSelectionExporterRange range = {
+        .absRange = absRange,
+        .newline = newline
+    };
+    [_ranges appendBytes:&range length:sizeof(range)];
+}
+
+- (void)addRangesOfSelection:(iTermSelection *)selection {
+    [selection enumerateSelectedAbsoluteRanges:^(VT100GridAbsWindowedRange absRange, BOOL *stop, BOOL eol) {
+        [self addAbsRange:absRange newline:eol];
+    }];
+}
+
+- (void)cancel {
+    self.cancelled = YES;
+}
+
+- (BOOL)enumerateChunksUsingBlock:(void (^ NS_NOESCAPE)(NSString *chunk, BOOL *stop))block {
+    const iTermSelectionExporterRange *ranges = _ranges.bytes;
+    const NSInteger count = _ranges.length / sizeof(iTermSelectionExporterRange);
+    long long totalLines = 0;
+    for (NSInteger i = 0; i < count; i++) {
+        totalLines += ranges[i].absRange.coordRange.end.y - ranges[i].absRange.coordRange.start.y + 1;
+    }
+    __block long long linesDone = 0;
+    __block BOOL stop = NO;
+    iTermSelectionExporterLines *lines = [[iTermSelectionExporterLines alloc] initWithWidth:_width];
+    for (NSInteger i = 0; i < count && !stop; i++) {
+        const iTermSelectionExporterRange range = ranges[i];
+        const long long startY = range.absRange.coordRange.start.y - _overflow;
+        const long long endY = range.absRange.coordRange.end.y - _overflow;
+        if (startY < 0 || endY < 0 || endY > INT_MAX) {
+            linesDone += endY - startY + 1;
+            continue;
+        }
+        __block BOOL endsWithNewline = NO;
+        [self enumerateChunksInRange:range.absRange
+                               lines:lines
+                               block:^(NSString *chunk, int numberOfLines) {
+            linesDone += numberOfLines;
+            if (chunk.length) {
+                endsWithNewline = [chunk hasSuffix:@"\n"];
+                block(chunk, &stop);
+            }
+            if (!stop && self.progress && totalLines > 0) {
+                self.progress((double)linesDone / totalLines);
+            }
+            return (BOOL)(stop || self.cancelled);
+        }];
+        if (stop || self.cancelled) {
+            break;
+        }
+        if (range.newline && !endsWithNewline) {
+            block(@"\n", &stop);
+        }
+    }
+    return !stop && !self.cancelled;
+}
+
+// Calls |block| with the text of each run of lines and how many lines it covered. Returns early if
+// the block returns YES.
+- (void)enumerateChunksInRange:(VT100GridAbsWindowedRange)absRange
+                         lines:(iTermSelectionExporterLines *)lines
+                         block:(BOOL (^ NS_NOESCAPE)(NSString *chunk, int numberOfLines))block {
+    const VT100GridWindowedRange range = VT100GridWindowedRangeFromAbsWindowedRange(absRange, _overflow);
+    const int lastLine = MIN(range.coordRange.end.y, _numberOfLines - 1);
+    const BOOL truncated = lastLine < range.coordRange.end.y;
+    const int left = range.columnWindow.length > 0 ? range.columnWindow.location : 0;
+    iTermTextExtractor *extractor = [iTermTextExtractor textExtractorWithDataSource:lines];
+    const int linesPerChunk = MAX(1, _linesPerChunk);
+
+    int y = range.coordRange.start.y;
+    int x = range.coordRange.start.x;
+    while (y <= lastLine) {
+        @autoreleasepool {
+            [lines removeAllLines];
+            // Copy lines until there are enough and the last one ends in a hard newline. One more
+            // line is copied when it's not the end so the extractor sees this run's last line
+            // ends before the range does.
+            int end = y - 1;
+            BOOL final = NO;
+            while (YES) {
+                const int limit = MIN(lastLine, end + linesPerChunk);
+                [self copyLinesFrom:end + 1 through:limit to:lines];
+                end = limit;
+                if (end == lastLine) {
+                    final = YES;
+                    break;
+                }
+                if ([lines lineHasHardNewline:end - y]) {
+                    break;
+                }
+                // The run ends in a soft-wrapped line. Keep going so whitespace at the end of the
+                // run isn't trimmed when it's in the middle of a line.
+                if (self.cancelled) {
+                    return;
+                }
+            }
+            VT100GridWindowedRange chunkRange = range;
+            if (final) {
+                chunkRange.coordRange = VT100GridCoordRangeMake(x,
+                                                                0,
+                                                                truncated ? _width : range.coordRange.end.x,
+                                                                end - y);
+            } else {
+                [self copyLinesFrom:end + 1 through:end + 1 to:lines];
+                chunkRange.coordRange = VT100GridCoordRangeMake(x, 0, left, end - y + 1);
+            }
+            NSString *chunk = [extractor contentInRange:chunkRange
+                                      attributeProvider:nil
+                                             nullPolicy:kiTermTextExtractorNullPolicyMidlineAsSpaceIgnoreTerminal
+                                                    pad:NO
+                                     includeLastNewline:final ? _includeLastNewline : YES
+                                 trimTrailingWhitespace:_trimTrailingWhitespace
+                                           cappedAtSize:INT_MAX
+                                           truncateTail:YES
+                                      continuationChars:nil
+                                                 coords:nil];
+            if (block(chunk, end - y + 1)) {
+                return;
+            }
+            y = end + 1;
+            x = left;
+        }
+    }
+}
+
+- (void)copyLinesFrom:(int)first through:(int)last to:(iTermSelectionExporterLines *)lines {
+    if (last < first) {
+        return;
+    }
+    [_lineBuffer enumerateLinesInRange:NSMakeRange(first, last - first + 1)
+                                 width:_width
+                                 block:^(screen_char_t *chars,
+                                         int length,
+                                         int eol,
+                                         screen_char_t continuation,
+                                         BOOL *stop) {
+        [lines appendChars:chars length:length eol:eol continuation:continuation];
+    }];
+}
+
+- (BOOL)writeToURL:(NSURL *)url error:(NSError * _Nullable *)error {
+    NSOutputStream *stream = [NSOutputStream outputStreamWithURL:url append:NO];
+    [stream open];
+    __block NSError *streamError = stream.streamError;
+    BOOL ok = NO;
+    if (!streamError) {
+        ok = [self enumerateChunksUsingBlock:^(NSString *chunk, BOOL *stop) {
+            NSData *data = [chunk dataUsingEncoding:NSUTF8StringEncoding];
+            const uint8_t *bytes = data.bytes;
+            NSUInteger offset = 0;
+            while (offset < data.length) {
+                const NSInteger written = [stream write:bytes + offset maxLength:data.length - offset];
+                if (written <= 0) {
+                    streamError = stream.streamError;
+                    *stop = YES;
+                    return;
+                }
+                offset += written;
+            }
+        }];
+    }
+    [stream close];
+    if (!ok) {
+        DLog(@"Export to %@ did not finish. cancelled=%@ error=%@", url.path, @(self.cancelled), streamError);
+        [[NSFileManager defaultManager] removeItemAtURL:url error:nil];
+        if (error) {
+            *error = streamError ?: [NSError errorWithDomain:NSCocoaErrorDomain code:NSUserCancelledError userInfo:nil];
+        }
+    }
+    return ok;
+}
+
+@end
+
+@implementation iTermFilePasteboardDataProvider {
+    NSURL *_url;
+}
+
+// The pasteboard doesn't keep its data providers alive, so the current one is kept here until the
+// pasteboard says it's done with it.
+static iTermFilePasteboardDataProvider *sCurrentFilePasteboardDataProvider;
+
++ (BOOL)writeTextFileAtURL:(NSURL *)url toPasteboard:(NSPasteboard *)pasteboard {
+    iTermFilePasteboardDataProvider *provider = [[self alloc] initWithURL:url];
+    NSPasteboardItem *item = [[NSPasteboardItem alloc] init];
+    if (![item setDataProvider:provider forTypes:@[ NSPasteboardTypeString ]]) {
+        return NO;
+    }
+    [pasteboard clearContents];
+    if (![pasteboard writeObjects:@[ item ]]) {
+        return NO;
+    }
+    sCurrentFilePasteboardDataProvider = provider;
+    return YES;
+}
+
+- (instancetype)initWithURL:(NSURL *)url {
+    self = [super init];
+    if (self) {
+        _url = url;
+    }
+    return self;
+}
+
+- (void)pasteboard:(nullable NSPasteboard *)pasteboard
+              item:(NSPasteboardItem *)item
+provideDataForType:(NSPasteboardType)type {
+    NSError *error = nil;
+    NSData *data = [NSData dataWithContentsOfURL:_url options:NSDataReadingMappedIfSafe error:&error];
+    if (!data) {
+        DLog(@"Failed to read %@: %@", _url.path, error);
+        return;
+    }
+    [item setData:data forType:type];
+}
+
+- (void)pasteboardFinishedWithDataProvider:(NSPasteboard *)pasteboard {
+    DLog(@"Pasteboard is done with %@", _url.path);
+    [[NSFileManager defaultManager] removeItemAtURL:_url error:nil];
+    if (sCurrentFilePasteboardDataProvider == self) {
+        sCurrentFilePasteboardDataProvider = nil;
+    }
+}
+
+@end
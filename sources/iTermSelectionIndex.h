@@ -0,0 +1,48 @@
+//
+//  iTermSelectionIndex.h
+//  iTerm2
+//
+//  Created by George Nachman on 10/18/26.
+//
+
+#import <Foundation/Foundation.h>
+
+#import "iTermSelection.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+// Returns the columns of `line` that a sub-selection with the given range and mode covers.
+NSRange iTermSelectionRangeOfIndexesInAbsRange(VT100GridAbsWindowedRange range,
+                                               long long line,
+                                               iTermSelectionMode mode,
+                                               int width);
+
+// Removes indexes in `range` that are in `indexes` and adds those that aren't.
+void iTermSelectionToggleIndexesInRange(NSMutableIndexSet *indexes, NSRange range);
+
+// Answers which sub-selections touch a line without looking at all of them. Sub-selections are
+// sorted by their top line, and the largest bottom line seen so far is kept alongside, so a search
+// can stop as soon as no earlier sub-selection can reach the line.
+//
+// It also remembers the selected columns of each line it's asked about, since the same lines are
+// asked about for every frame drawn. It doesn't notice changes to the sub-selections, so make a new
+// one when they change.
+@interface iTermSelectionIndex : NSObject
+
+@property (nonatomic, readonly) int width;
+
+- (instancetype)initWithSubSelections:(NSArray<iTermSubSelection *> *)subSelections
+                                width:(int)width NS_DESIGNATED_INITIALIZER;
+- (instancetype)init NS_UNAVAILABLE;
+
+// Calls the block for each sub-selection that might select something on `line`. The order is not
+// defined.
+- (void)enumerateSubSelectionsOnAbsoluteLine:(long long)line
+                                       block:(void (^ NS_NOESCAPE)(iTermSubSelection *sub))block;
+
+// Columns on `line` selected by an odd number of sub-selections.
+- (NSIndexSet *)selectedIndexesOnAbsoluteLine:(long long)line;
+
+@end
+
+NS_ASSUME_NONNULL_END
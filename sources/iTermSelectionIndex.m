@@ -0,0 +1,203 @@
+//
+//  iTermSelectionIndex.m
+//  iTerm2
+//
+//  Created by George Nachman on 10/18/26.
+//
+
+#import "iTermSelectionIndex.h"
+
+#import "iTermMalloc.h"
+#import "NSIndexSet+iTerm.h"
+
+// Lines whose selected columns are remembered. More than a screenful, so scrolling a little
+// doesn't lose them all.
+static const NSUInteger iTermSelectionIndexMaximumCachedLines = 1024;
+
+typedef struct {
+    long long top;
+    long long bottom;
+    NSInteger subSelectionIndex;
+} iTermSelectionIndexEntry;
+
+static NSRange iTermMakeRange(NSInteger location, NSInteger length) {
+    if (location < 0) {
+        return iTermMakeRange(0, length + location);
+    }
+    if (location > NSNotFound) {
+        return NSMakeRange(NSNotFound, 0);
+    }
+    return NSMakeRange(location, MAX(0, length));
+}
+
+NSRange iTermSelectionRangeOfIndexesInAbsRange(VT100GridAbsWindowedRange range,
+                                               long long line,
+                                               iTermSelectionMode mode,
+                                               int width) {
+    if (mode == kiTermSelectionModeBox) {
+        if (range.coordRange.start.y <= line && range.coordRange.end.y >= line) {
+            return iTermMakeRange(range.coordRange.start.x,
+                                  range.coordRange.end.x - range.coordRange.start.x);
+        } else {
+            return iTermMakeRange(0, 0);
+        }
+    }
+    if (range.coordRange.start.y < line && range.coordRange.end.y > line) {
+        if (range.columnWindow.length) {
+            return iTermMakeRange(range.columnWindow.location,
+                                  range.columnWindow.length);
+        } else {
+            return iTermMakeRange(0, width);
+        }
+    }
+    if (range.coordRange.start.y == line) {
+        if (range.coordRange.end.y == line) {
+            if (range.columnWindow.length) {
+                int limit = VT100GridRangeMax(range.columnWindow) + 1;
+                NSRange result;
+                result.location = MAX(range.columnWindow.location, range.coordRange.start.x);
+                result.length = MIN(limit, range.coordRange.end.x) - result.location;
+                return result;
+            } else {
+                return iTermMakeRange(range.coordRange.start.x,
+                                      range.coordRange.end.x - range.coordRange.start.x);
+            }
+        } else {
+            if (range.columnWindow.length) {
+                int limit = VT100GridRangeMax(range.columnWindow) + 1;
+                NSRange result;
+                result.location = MAX(range.columnWindow.location, range.coordRange.start.x);
+                result.length = MIN(limit, width) - result.location;
+                return result;
+            } else {
+                return iTermMakeRange(range.coordRange.start.x,
+                                      width - range.coordRange.start.x);
+            }
+        }
+    }
+    if (range.coordRange.end.y == line) {
+        if (range.columnWindow.length) {
+            int limit = VT100GridRangeMax(range.columnWindow) + 1;
+            return iTermMakeRange(range.columnWindow.location,
+                                  MIN(limit, range.coordRange.end.x) - range.columnWindow.location);
+        } else {
+            return iTermMakeRange(0, range.coordRange.end.x);
+        }
+    }
+    return iTermMakeRange(0, 0);
+}
+
+void iTermSelectionToggleIndexesInRange(NSMutableIndexSet *indexes, NSRange range) {
+    // Any values in range that intersect indexes should be removed from indexes.
+    // And values in range that don't intersect indexes should be added to indexes.
+    NSMutableIndexSet *indexesToAdd = [NSMutableIndexSet it_indexSetWithIndexesInRange:range];
+    NSMutableIndexSet *indexesToRemove = [NSMutableIndexSet indexSet];
+
+    [indexes enumerateRangesInRange:range options:0 usingBlock:^(NSRange innerRange, BOOL *stop) {
+        // innerRange exists in both indexes and range
+        [indexesToRemove addIndexesInRange:innerRange];
+        [indexesToAdd removeIndexesInRange:innerRange];
+    }];
+    [indexes removeIndexes:indexesToRemove];
+    [indexes addIndexes:indexesToAdd];
+}
+
+static int iTermSelectionIndexCompareEntries(const void *a, const void *b) {
+    const iTermSelectionIndexEntry *lhs = a;
+    const iTermSelectionIndexEntry *rhs = b;
+    if (lhs->top != rhs->top) {
+        return lhs->top < rhs->top ? -1 : 1;
+    }
+    if (lhs->subSelectionIndex != rhs->subSelectionIndex) {
+        return lhs->subSelectionIndex < rhs->subSelectionIndex ? -1 : 1;
+    }
+    return 0;
+}
+
+@implementation iTermSelectionIndex {
+    NSArray<iTermSubSelection *> *_subSelections;
+    // Sorted by top.
+    iTermSelectionIndexEntry *_entries;
+    // _maximumBottom[i] is the largest bottom among _entries[0...i].
+    long long *_maximumBottom;
+    NSInteger _count;
+    NSMutableDictionary<NSNumber *, NSIndexSet *> *_cachedIndexes;
+}
+
+- (instancetype)initWithSubSelections:(NSArray<iTermSubSelection *> *)subSelections
+                                width:(int)width {
+    self = [super init];
+    if (self) {
+        _subSelections = [subSelections copy];
+        _width = width;
+        _count = _subSelections.count;
+        _entries = iTermMalloc(sizeof(iTermSelectionIndexEntry) * MAX(1, _count));
+        _maximumBottom = iTermMalloc(sizeof(long long) * MAX(1, _count));
+        [_subSelections enumerateObjectsUsingBlock:^(iTermSubSelection *sub, NSUInteger i, BOOL *stop) {
+            const VT100GridAbsCoordRange coordRange = sub.absRange.coordRange;
+            _entries[i].top = MIN(coordRange.start.y, coordRange.end.y);
+            _entries[i].bottom = MAX(coordRange.start.y, coordRange.end.y);
+            _entries[i].subSelectionIndex = i;
+        }];
+        qsort(_entries, _count, sizeof(iTermSelectionIndexEntry), iTermSelectionIndexCompareEntries);
+        long long maximum = LLONG_MIN;
+        for (NSInteger i = 0; i < _count; i++) {
+            maximum = MAX(maximum, _entries[i].bottom);
+            _maximumBottom[i] = maximum;
+        }
+        _cachedIndexes = [[NSMutableDictionary alloc] init];
+    }
+    return self;
+}
+
+- (void)dealloc {
+    [_subSelections release];
+    [_cachedIndexes release];
+    free(_entries);
+    free(_maximumBottom);
+    [super dealloc];
+}
+
+- (void)enumerateSubSelectionsOnAbsoluteLine:(long long)line
+                                       block:(void (^ NS_NOESCAPE)(iTermSubSelection *sub))block {
+    // Find the first entry that starts after line.
+    NSInteger lo = 0;
+    NSInteger hi = _count;
+    while (lo < hi) {
+        const NSInteger mid = lo + (hi - lo) / 2;
+        if (_entries[mid].top <= line) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    // Everything before it starts on or before line. Walk back until nothing earlier can reach it.
+    for (NSInteger i = lo - 1; i >= 0 && _maximumBottom[i] >= line; i--) {
+        if (_entries[i].bottom >= line) {
+            block(_subSelections[_entries[i].subSelectionIndex]);
+        }
+    }
+}
+
+- (NSIndexSet *)selectedIndexesOnAbsoluteLine:(long long)line {
+    NSIndexSet *cached = _cachedIndexes[@(line)];
+    if (cached) {
+        return cached;
+    }
+    NSMutableIndexSet *indexes = [NSMutableIndexSet indexSet];
+    [self enumerateSubSelectionsOnAbsoluteLine:line block:^(iTermSubSelection *sub) {
+        iTermSelectionToggleIndexesInRange(indexes,
+                                           iTermSelectionRangeOfIndexesInAbsRange(sub.absRange,
+                                                                                  line,
+                                                                                  sub.selectionMode,
+                                                                                  _width));
+    }];
+    if (_cachedIndexes.count >= iTermSelectionIndexMaximumCachedLines) {
+        [_cachedIndexes removeAllObjects];
+    }
+    NSIndexSet *result = [[indexes copy] autorelease];
+    _cachedIndexes[@(line)] = result;
+    return result;
+}
+
+@end
@@ -111,4 +111,11 @@ extern NSString *const kDirectoriesDidChangeNotificationName;
 - (BOOL)finishInitialization;
 - (instancetype)initPartially;
 
+// Keep history in an append-only log rather than the database when saving to disk.
+- (BOOL)logStorageEnabled;
+- (void)compactLog;
+
+// Waits until everything appended to the log has been written.
+- (void)flushLog;
+
 @end
@@ -9,13 +9,16 @@
 #import "iTermShellHistoryController.h"
 
 #import "DebugLogging.h"
+#import "iTermAdvancedSettingsModel.h"
 #import "iTermCommandHistoryEntryMO+Additions.h"
+#import "iTermCommandHistoryIndex.h"
 #import "iTermDirectoryTree.h"
 #import "iTermHostRecordMO.h"
 #import "iTermHostRecordMO+Additions.h"
 #import "iTermPreferences.h"
 #import "iTermRecentDirectoryMO.h"
 #import "iTermRecentDirectoryMO+Additions.h"
+#import "iTermShellHistoryLog.h"
 #import "NSArray+iTerm.h"
 #import "NSDictionary+iTerm.h"
 #import "NSStringITerm.h"
@@ -34,6 +37,13 @@ static const int kMaxResults = 200;
 static const NSTimeInterval kMaxTimeToRememberCommands = 60 * 60 * 24 * 90;
 static const NSTimeInterval kMaxTimeToRememberDirectories = 60 * 60 * 24 * 90;
 
+// Only save the most recent 1000 directories
+static const NSInteger iTermMaxDirectoriesToSave = 1000;
+
+// The log is compacted when it has grown to twice its compacted size, but not while it's smaller
+// than this.
+static const unsigned long long kMinimumLogSizeToCompact = 1024 * 1024;
+
 @interface VT100RemoteHost (CommandHistory)
 
 - (NSString *)key;
@@ -53,6 +63,9 @@ static const NSTimeInterval kMaxTimeToRememberDirectories = 60 * 60 * 24 * 90;
 
     // Keys are remote host keys, "user@hostname".
     NSMutableDictionary<NSString *, NSMutableArray<iTermCommandHistoryCommandUseMO *> *> *_expandedCache;
+
+    // Keys are remote host keys. Built when first needed.
+    NSMutableDictionary<NSString *, iTermCommandHistoryIndex *> *_commandIndexes;
     NSManagedObjectContext *_managedObjectContext;
     iTermDirectoryTree *_tree;
 
@@ -62,6 +75,22 @@ static const NSTimeInterval kMaxTimeToRememberDirectories = 60 * 60 * 24 * 90;
 
     // Current store is on-disk?
     BOOL _savingToDisk;
+
+    // When history is kept in a log the managed object context is in memory and a host's objects
+    // are created from the log the first time it's needed.
+    iTermShellHistoryLog *_log;
+    NSMutableSet<NSString *> *_loadedHostKeys;
+    // Keys of hosts that have records in the log. Kept here so asking doesn't wait on _logQueue.
+    NSMutableSet<NSString *> *_logHostKeys;
+
+    // The log is only used on this serial queue. Appends are done asynchronously so the main
+    // thread doesn't wait on the disk.
+    dispatch_queue_t _logQueue;
+    // Automatic compaction rewrites a snapshot of the log in this group, off _logQueue, so loading
+    // a host's records never waits for the whole log to be rewritten.
+    dispatch_group_t _compactionGroup;
+    // Only accessed on _logQueue.
+    BOOL _compacting;
 }
 
 + (instancetype)sharedInstance {
@@ -93,24 +122,58 @@ static const NSTimeInterval kMaxTimeToRememberDirectories = 60 * 60 * 24 * 90;
 }
 
 - (BOOL)finishInitialization {
+    _logQueue = dispatch_queue_create("com.iterm2.shell-history-log", DISPATCH_QUEUE_SERIAL);
+    _compactionGroup = dispatch_group_create();
+    if (self.shouldSaveToDisk && self.logStorageEnabled) {
+        [self openLog];
+    }
     if (![self initializeCoreDataWithRetry:YES vacuum:NO]) {
         [self release];
         return NO;
     }
     _records = [[NSMutableDictionary alloc] init];
     _expandedCache = [[NSMutableDictionary alloc] init];
+    _commandIndexes = [[NSMutableDictionary alloc] init];
+    _loadedHostKeys = [[NSMutableSet alloc] init];
+    _logHostKeys = [[NSMutableSet alloc] init];
     _tree = [[iTermDirectoryTree alloc] init];
 
+    if (_log) {
+        [self reloadLogHostKeys];
+        // Hosts are loaded lazily by -recordForHost:.
+        [[NSNotificationCenter defaultCenter] addObserver:self
+                                                 selector:@selector(applicationWillTerminate:)
+                                                     name:NSApplicationWillTerminateNotification
+                                                   object:nil];
+        _initializing = NO;
+        return YES;
+    }
     [self removeOldData];
     [self loadObjectGraph];
+    if (self.shouldSaveToDisk && [[NSFileManager defaultManager] fileExistsAtPath:self.pathToLog]) {
+        [self importLog];
+    }
 
     _initializing = NO;
     return YES;
 }
 
 - (void)dealloc {
+    [[NSNotificationCenter defaultCenter] removeObserver:self];
+    [self flushLog];
     [_records release];
     [_expandedCache release];
+    [_commandIndexes release];
+    [_loadedHostKeys release];
+    [_logHostKeys release];
+    [_log release];
+    if (_compactionGroup) {
+        dispatch_group_wait(_compactionGroup, DISPATCH_TIME_FOREVER);
+        dispatch_release(_compactionGroup);
+    }
+    if (_logQueue) {
+        dispatch_release(_logQueue);
+    }
     [_managedObjectContext release];
     [_tree release];
     [super dealloc];
@@ -149,6 +212,10 @@ static const NSTimeInterval kMaxTimeToRememberDirectories = 60 * 60 * 24 * 90;
     return @"ShellHistory.sqlite";
 }
 
+- (NSString *)pathToLog {
+    return [self pathForFileNamed:@"ShellHistory.log"];
+}
+
 - (NSString *)pathToDatabase {
     NSString *path = [self pathForFileNamed:self.databaseFilenamePrefix];
     if (!self.shouldSaveToDisk) {
@@ -190,7 +257,7 @@ static const NSTimeInterval kMaxTimeToRememberDirectories = 60 * 60 * 24 * 90;
     // need to wait for it to finish before -loadCommandHistory could be called.
     NSError *error = nil;
     NSString *storeType;
-    if ([self shouldSaveToDisk] || vacuum) {
+    if (([self shouldSaveToDisk] && !_log) || vacuum) {
         _savingToDisk = YES;
         storeType = NSSQLiteStoreType;
     } else {
@@ -212,7 +279,7 @@ static const NSTimeInterval kMaxTimeToRememberDirectories = 60 * 60 * 24 * 90;
                                                      error:&error];
     if (error) {
         NSLog(@"Got an exception when opening the command history database: %@", error);
-        if (![self shouldSaveToDisk]) {
+        if (![self shouldSaveToDisk] || _log) {
             NSLog(@"This is an in-memory database, it should not fail.");
             return NO;
         }
@@ -235,7 +302,7 @@ static const NSTimeInterval kMaxTimeToRememberDirectories = 60 * 60 * 24 * 90;
         return [self initializeCoreDataWithRetry:NO vacuum:vacuum];
     }
 
-    if (self.shouldSaveToDisk) {
+    if (self.shouldSaveToDisk && !_log) {
         [self makeDatabaseReadableOnlyByUser];
     }
     return YES;
@@ -327,6 +394,10 @@ static const NSTimeInterval kMaxTimeToRememberDirectories = 60 * 60 * 24 * 90;
     return [iTermPreferences boolForKey:kPreferenceKeySavePasteAndCommandHistory];
 }
 
+- (BOOL)logStorageEnabled {
+    return [iTermAdvancedSettingsModel shellHistoryUsesAppendOnlyLog];
+}
+
 - (NSArray *)managedObjects {
     NSFetchRequest *fetchRequest =
         [NSFetchRequest fetchRequestWithEntityName:[iTermHostRecordMO entityName]];
@@ -351,6 +422,7 @@ static const NSTimeInterval kMaxTimeToRememberDirectories = 60 * 60 * 24 * 90;
     // Reload everything.
     [_records removeAllObjects];
     [_expandedCache removeAllObjects];
+    [_commandIndexes removeAllObjects];
     [_tree release];
     _tree = [[iTermDirectoryTree alloc] init];
     [self loadObjectGraph];
@@ -390,6 +462,34 @@ static const NSTimeInterval kMaxTimeToRememberDirectories = 60 * 60 * 24 * 90;
 }
 
 - (void)backingStoreTypeDidChange {
+    if (_log) {
+        if (self.shouldSaveToDisk) {
+            // No change
+            return;
+        }
+        // The managed object context is already in memory. Load everything into it and erase the
+        // file containing user data.
+        for (NSString *hostKey in self.logHostKeys) {
+            [self loadHostWithKeyIfNeeded:hostKey];
+        }
+        // Wait for compaction and pending appends so nothing writes to the file after it's removed.
+        dispatch_group_wait(_compactionGroup, DISPATCH_TIME_FOREVER);
+        [self flushLog];
+        [_log release];
+        _log = nil;
+        [[NSFileManager defaultManager] removeItemAtPath:self.pathToLog error:NULL];
+        return;
+    }
+    if (self.shouldSaveToDisk && self.logStorageEnabled && [self writeLogFromObjectGraph]) {
+        _log = [[iTermShellHistoryLog alloc] initWithPath:self.pathToLog];
+        if (_log) {
+            // Everything in the log is already in memory.
+            [self reloadLogHostKeys];
+            [_loadedHostKeys unionSet:_logHostKeys];
+            return;
+        }
+    }
+
     NSPersistentStore *store =
         _managedObjectContext.persistentStoreCoordinator.persistentStores.firstObject;
     NSString *storeType = self.shouldSaveToDisk ? NSSQLiteStoreType : NSInMemoryStoreType;
@@ -445,6 +545,16 @@ static const NSTimeInterval kMaxTimeToRememberDirectories = 60 * 60 * 24 * 90;
     }
 
     [self saveObjectGraph];
+    if (_log) {
+        // Rewriting the log removes the erased records from disk. Wait for it so the history is
+        // really gone when this returns.
+        const NSTimeInterval now = [self now];
+        iTermShellHistoryLog *log = _log;
+        dispatch_sync(_logQueue, ^{
+            [iTermShellHistoryController compactLog:log now:now erasingCommands:commandHistory directories:directories];
+        });
+        [self reloadLogHostKeys];
+    }
     [self vacuum];
 
     [[NSNotificationCenter defaultCenter] postNotificationName:kDirectoriesDidChangeNotificationName
@@ -471,13 +581,8 @@ static const NSTimeInterval kMaxTimeToRememberDirectories = 60 * 60 * 24 * 90;
         [self setRecord:hostRecord forHost:host];
     }
 
-    iTermCommandHistoryEntryMO *theEntry = nil;
-    for (iTermCommandHistoryEntryMO *entry in hostRecord.entries) {
-        if ([entry.command isEqualToString:command]) {
-            theEntry = entry;
-            break;
-        }
-    }
+    iTermCommandHistoryIndex *index = [self commandIndexForHost:host];
+    iTermCommandHistoryEntryMO *theEntry = (iTermCommandHistoryEntryMO *)[index entryWithCommand:command];
 
     if (!theEntry) {
         theEntry = [iTermCommandHistoryEntryMO commandHistoryEntryInContext:_managedObjectContext];
@@ -487,6 +592,7 @@ static const NSTimeInterval kMaxTimeToRememberDirectories = 60 * 60 * 24 * 90;
 
     theEntry.numberOfUses = @(theEntry.numberOfUses.integerValue + 1);
     theEntry.timeOfLastUse = @([self now]);
+    [index updateEntry:theEntry];
 
     iTermCommandHistoryCommandUseMO *commandUse =
     [iTermCommandHistoryCommandUseMO commandHistoryCommandUseInContext:_managedObjectContext];
@@ -496,6 +602,11 @@ static const NSTimeInterval kMaxTimeToRememberDirectories = 60 * 60 * 24 * 90;
     commandUse.command = theEntry.command;
     [theEntry addUsesObject:commandUse];
 
+    if (_log) {
+        [self appendToLog:[self logRecordForCommandHistoryEntry:theEntry onHost:hostRecord]];
+        [self appendToLog:[self logRecordForCommandUse:commandUse ofEntry:theEntry onHost:hostRecord]];
+    }
+
     NSString *key = host.key ?: @"";
     if (_expandedCache[key]) {
         [_expandedCache[key] addObject:commandUse];
@@ -512,6 +623,15 @@ static const NSTimeInterval kMaxTimeToRememberDirectories = 60 * 60 * 24 * 90;
     // in the common case.
     if (commandUse && commandUse.code.intValue != status) {
         commandUse.code = @(status);
+        if (_log) {
+            iTermShellHistoryLogRecord *record =
+                [iTermShellHistoryLogRecord recordWithType:iTermShellHistoryLogRecordTypeCommandStatus
+                                                  username:remoteHost.username
+                                                  hostname:remoteHost.hostname];
+            record.markGuid = commandUse.markGuid;
+            record.code = commandUse.code;
+            [self appendToLog:record];
+        }
         [self saveCommandHistory];
     }
 }
@@ -520,6 +640,7 @@ static const NSTimeInterval kMaxTimeToRememberDirectories = 60 * 60 * 24 * 90;
 
 - (BOOL)commandHistoryHasEverBeenUsed {
     return (_records.count > 0 ||
+            self.logHostKeys.count > 0 ||
             [[NSUserDefaults standardUserDefaults] boolForKey:kCommandHistoryHasEverBeenUsed]);
 }
 
@@ -528,22 +649,19 @@ static const NSTimeInterval kMaxTimeToRememberDirectories = 60 * 60 * 24 * 90;
     if (host == nil) {
         return [self commandHistoryEntriesWithPrefix:partialCommand onHost:[VT100RemoteHost localhost]];
     }
-    BOOL emptyPartialCommand = (partialCommand.length == 0);
-    NSMutableArray<iTermCommandHistoryEntryMO *> *result = [NSMutableArray array];
-    iTermHostRecordMO *hostRecord = [self recordForHost:host];
-    for (iTermCommandHistoryEntryMO *entry in hostRecord.entries) {
-        if (emptyPartialCommand || [entry.command caseInsensitiveHasPrefix:partialCommand]) {
-            // The FinalTerm algorithm doesn't require |partialCommand| to be a prefix of the
-            // history entry, but based on how our autocomplete works, it makes sense to only
-            // accept prefixes. Their scoring algorithm is implemented in case this should change.
-            entry.matchLocation = @0;
-            [result addObject:entry];
-        }
+    if (![self recordForHost:host]) {
+        return @[];
     }
-
-    // TODO: Cache this.
-    NSArray *sortedEntries = [result sortedArrayUsingSelector:@selector(compare:)];
-    return [sortedEntries subarrayWithRange:NSMakeRange(0, MIN(kMaxResults, sortedEntries.count))];
+    NSArray<iTermCommandHistoryEntryMO *> *result =
+        (NSArray<iTermCommandHistoryEntryMO *> *)[[self commandIndexForHost:host] entriesWithPrefix:partialCommand
+                                                                                         maximumCount:kMaxResults];
+    for (iTermCommandHistoryEntryMO *entry in result) {
+        // The FinalTerm algorithm doesn't require |partialCommand| to be a prefix of the
+        // history entry, but based on how our autocomplete works, it makes sense to only
+        // accept prefixes. Their scoring algorithm is implemented in case this should change.
+        entry.matchLocation = @0;
+    }
+    return result;
 }
 
 - (NSArray<iTermCommandHistoryCommandUseMO *> *)autocompleteSuggestionsWithPartialCommand:(NSString *)partialCommand
@@ -627,6 +745,9 @@ static const NSTimeInterval kMaxTimeToRememberDirectories = 60 * 60 * 24 * 90;
     }
     directory.useCount = @(directory.useCount.integerValue + 1);
     directory.lastUse = @([self now]);
+    if (_log) {
+        [self appendToLog:[self logRecordForDirectory:directory onHost:hostRecord]];
+    }
 
     [self saveDirectories];
 
@@ -635,6 +756,9 @@ static const NSTimeInterval kMaxTimeToRememberDirectories = 60 * 60 * 24 * 90;
 
 - (void)setDirectory:(iTermRecentDirectoryMO *)directory starred:(BOOL)starred {
     directory.starred = @(starred);
+    if (_log) {
+        [self appendToLog:[self logRecordForDirectory:directory onHost:directory.remoteHost]];
+    }
     [self saveDirectories];
 }
 
@@ -660,6 +784,10 @@ static const NSTimeInterval kMaxTimeToRememberDirectories = 60 * 60 * 24 * 90;
     if (hostRecord) {
         [hostRecord removeEntries:hostRecord.entries];
         [_expandedCache removeObjectForKey:key];
+        [_commandIndexes removeObjectForKey:key];
+        [self appendToLog:[iTermShellHistoryLogRecord recordWithType:iTermShellHistoryLogRecordTypeEraseCommands
+                                                            username:hostRecord.username
+                                                            hostname:hostRecord.hostname]];
         [self saveCommandHistory];
     }
 }
@@ -668,6 +796,9 @@ static const NSTimeInterval kMaxTimeToRememberDirectories = 60 * 60 * 24 * 90;
     iTermHostRecordMO *hostRecord = [self recordForHost:host];
     if (hostRecord) {
         [hostRecord removeDirectories:hostRecord.directories];
+        [self appendToLog:[iTermShellHistoryLogRecord recordWithType:iTermShellHistoryLogRecordTypeEraseDirectories
+                                                            username:hostRecord.username
+                                                            hostname:hostRecord.hostname]];
         [self saveDirectories];
     }
 }
@@ -714,9 +845,6 @@ static const NSTimeInterval kMaxTimeToRememberDirectories = 60 * 60 * 24 * 90;
         [_managedObjectContext deleteObject:directory];
     }
 
-    // Only save the most recent 1000 directories
-    static const NSInteger iTermMaxDirectoriesToSave = 1000;
-
     NSSortDescriptor *lastUseDescriptor = [[[NSSortDescriptor alloc] initWithKey:@"lastUse"
                                                                        ascending:NO
                                                                         selector:@selector(compare:)] autorelease];
@@ -752,6 +880,7 @@ static const NSTimeInterval kMaxTimeToRememberDirectories = 60 * 60 * 24 * 90;
 - (void)loadObjectGraph {
     [self loadObjectGraphIntoDictionary:_records];
     [_expandedCache removeAllObjects];
+    [_commandIndexes removeAllObjects];
     for (NSString *hostKey in _records) {
         iTermHostRecordMO *hostRecord = _records[hostKey];
         for (iTermRecentDirectoryMO *directory in hostRecord.directories) {
@@ -761,13 +890,347 @@ static const NSTimeInterval kMaxTimeToRememberDirectories = 60 * 60 * 24 * 90;
 }
 
 - (iTermHostRecordMO *)recordForHost:(VT100RemoteHost *)host {
-    return _records[host.key ?: @""];
+    NSString *key = host.key ?: @"";
+    [self loadHostWithKeyIfNeeded:key];
+    return _records[key];
 }
 
 - (void)setRecord:(iTermHostRecordMO *)record forHost:(VT100RemoteHost *)host {
     _records[host.key ?: @""] = record;
 }
 
+#pragma mark Private Log
+
+// Opens the log, first moving history over from the database if the log doesn't exist yet. Leaves
+// _log nil if it can't be opened, in which case the database continues to be used.
+//
+// The database is deleted only after its history has been moved into a new log. A database found
+// next to an existing log may have been written by an older version, so it's left alone.
+- (void)openLog {
+    NSString *path = self.pathToLog;
+    NSFileManager *fileManager = [NSFileManager defaultManager];
+    BOOL migrated = NO;
+    if (![fileManager fileExistsAtPath:path] && [fileManager fileExistsAtPath:self.pathToDatabase]) {
+        if ([self initializeCoreDataWithRetry:NO vacuum:NO]) {
+            [self removeOldData];
+            migrated = [self writeLogFromObjectGraph];
+        }
+        [_managedObjectContext release];
+        _managedObjectContext = nil;
+        if (!migrated && [fileManager fileExistsAtPath:self.pathToDatabase]) {
+            return;
+        }
+    }
+    _log = [[iTermShellHistoryLog alloc] initWithPath:path];
+    if (_log && migrated) {
+        [self deleteDatabase];
+    }
+}
+
+- (void)flushLog {
+    if (_logQueue) {
+        dispatch_sync(_logQueue, ^{});
+    }
+}
+
+- (void)applicationWillTerminate:(NSNotification *)notification {
+    // Don't lose appends that haven't been written yet.
+    [self flushLog];
+}
+
+- (NSArray<NSString *> *)logHostKeys {
+    if (!_log) {
+        return nil;
+    }
+    return _logHostKeys.allObjects;
+}
+
+// Waits for _logQueue, so call it only when little or nothing is queued there.
+- (void)reloadLogHostKeys {
+    __block NSArray<NSString *> *hostKeys = nil;
+    iTermShellHistoryLog *log = _log;
+    dispatch_sync(_logQueue, ^{
+        hostKeys = [log.hostKeys retain];
+    });
+    [_logHostKeys removeAllObjects];
+    if (hostKeys) {
+        [_logHostKeys addObjectsFromArray:hostKeys];
+    }
+    [hostKeys release];
+}
+
+// Moves history from a log written when log storage was enabled into the database.
+- (void)importLog {
+    iTermShellHistoryLog *log = [[[iTermShellHistoryLog alloc] initWithPath:self.pathToLog] autorelease];
+    for (NSString *hostKey in log.hostKeys) {
+        [self loadHostWithKey:hostKey fromLog:log];
+    }
+    [self saveObjectGraph];
+    [[NSFileManager defaultManager] removeItemAtPath:self.pathToLog error:NULL];
+}
+
+- (BOOL)writeLogFromObjectGraph {
+    NSArray<iTermHostRecordMO *> *hostRecords = [self managedObjects];
+    return [iTermShellHistoryLog writeLogAtPath:self.pathToLog
+                                     usingBlock:^(void (^append)(iTermShellHistoryLogRecord *)) {
+        for (iTermHostRecordMO *hostRecord in hostRecords) {
+            for (iTermCommandHistoryEntryMO *entry in hostRecord.entries) {
+                append([self logRecordForCommandHistoryEntry:entry onHost:hostRecord]);
+                for (iTermCommandHistoryCommandUseMO *commandUse in entry.uses) {
+                    append([self logRecordForCommandUse:commandUse ofEntry:entry onHost:hostRecord]);
+                }
+            }
+            for (iTermRecentDirectoryMO *directory in hostRecord.directories) {
+                append([self logRecordForDirectory:directory onHost:hostRecord]);
+            }
+        }
+    }];
+}
+
+- (void)loadHostWithKeyIfNeeded:(NSString *)hostKey {
+    if (!_log || [_loadedHostKeys containsObject:hostKey]) {
+        return;
+    }
+    [_loadedHostKeys addObject:hostKey];
+    if (![_logHostKeys containsObject:hostKey]) {
+        // Nothing to load, so don't wait for the log.
+        return;
+    }
+    // Read the records on the log's queue, after any pending appends, and make managed objects of
+    // them here.
+    __block NSArray<iTermShellHistoryLogRecord *> *records = nil;
+    iTermShellHistoryLog *log = _log;
+    const NSTimeInterval now = [self now];
+    dispatch_sync(_logQueue, ^{
+        records = [[iTermShellHistoryController compactedRecordsForHostKey:hostKey
+                                                                   fromLog:log
+                                                                       now:now] retain];
+    });
+    [self loadHostWithKey:hostKey records:records];
+    [records release];
+}
+
+// Old history is left out just as -removeOldData would remove it.
++ (NSArray<iTermShellHistoryLogRecord *> *)compactedRecordsForHostKey:(NSString *)hostKey
+                                                              fromLog:(iTermShellHistoryLog *)log
+                                                                  now:(NSTimeInterval)now {
+    NSMutableArray<iTermShellHistoryLogRecord *> *records = [NSMutableArray array];
+    if (![log hasRecordsForHostKey:hostKey]) {
+        return records;
+    }
+    [log enumerateCompactedRecordsForHostKey:hostKey
+                               commandCutoff:now - kMaxTimeToRememberCommands
+                             directoryCutoff:now - kMaxTimeToRememberDirectories
+                                       block:^(iTermShellHistoryLogRecord *record) {
+        [records addObject:record];
+    }];
+    return records;
+}
+
+- (void)loadHostWithKey:(NSString *)hostKey fromLog:(iTermShellHistoryLog *)log {
+    [self loadHostWithKey:hostKey
+                  records:[iTermShellHistoryController compactedRecordsForHostKey:hostKey
+                                                                           fromLog:log
+                                                                               now:[self now]]];
+}
+
+// Creates managed objects for a host's compacted log records.
+- (void)loadHostWithKey:(NSString *)hostKey records:(NSArray<iTermShellHistoryLogRecord *> *)records {
+    iTermHostRecordMO *hostRecord = _records[hostKey];
+    iTermCommandHistoryEntryMO *entry = nil;
+    for (iTermShellHistoryLogRecord *record in records) {
+        if (!hostRecord) {
+            hostRecord = [iTermHostRecordMO hostRecordInContext:_managedObjectContext];
+            hostRecord.hostname = record.hostname;
+            hostRecord.username = record.username;
+            _records[hostKey] = hostRecord;
+        }
+        switch (record.type) {
+            case iTermShellHistoryLogRecordTypeCommandEntry:
+                entry = [iTermCommandHistoryEntryMO commandHistoryEntryInContext:_managedObjectContext];
+                entry.command = record.text;
+                entry.numberOfUses = @(record.count);
+                entry.timeOfLastUse = @(record.time);
+                [hostRecord addEntriesObject:entry];
+                break;
+
+            case iTermShellHistoryLogRecordTypeCommandUse: {
+                iTermCommandHistoryCommandUseMO *commandUse =
+                    [iTermCommandHistoryCommandUseMO commandHistoryCommandUseInContext:_managedObjectContext];
+                commandUse.time = @(record.time);
+                commandUse.markGuid = record.markGuid;
+                commandUse.directory = record.directory;
+                commandUse.command = entry.command;
+                commandUse.code = record.code;
+                [entry addUsesObject:commandUse];
+                break;
+            }
+
+            case iTermShellHistoryLogRecordTypeDirectory: {
+                iTermRecentDirectoryMO *directory =
+                    [NSEntityDescription insertNewObjectForEntityForName:[iTermRecentDirectoryMO entityName]
+                                                  inManagedObjectContext:_managedObjectContext];
+                directory.path = record.text;
+                directory.useCount = @(record.count);
+                directory.lastUse = @(record.time);
+                directory.starred = @(record.starred);
+                [_tree addPath:directory.path];
+                [hostRecord addDirectoriesObject:directory];
+                break;
+            }
+
+            case iTermShellHistoryLogRecordTypeCommandStatus:
+            case iTermShellHistoryLogRecordTypeEraseCommands:
+            case iTermShellHistoryLogRecordTypeEraseDirectories:
+                // Compacted records don't include these.
+                break;
+        }
+    }
+}
+
+- (iTermShellHistoryLogRecord *)logRecordForCommandHistoryEntry:(iTermCommandHistoryEntryMO *)entry
+                                                         onHost:(iTermHostRecordMO *)hostRecord {
+    iTermShellHistoryLogRecord *record =
+        [iTermShellHistoryLogRecord recordWithType:iTermShellHistoryLogRecordTypeCommandEntry
+                                          username:hostRecord.username
+                                          hostname:hostRecord.hostname];
+    record.text = entry.command;
+    record.count = entry.numberOfUses.longLongValue;
+    record.time = entry.timeOfLastUse.doubleValue;
+    return record;
+}
+
+- (iTermShellHistoryLogRecord *)logRecordForCommandUse:(iTermCommandHistoryCommandUseMO *)commandUse
+                                               ofEntry:(iTermCommandHistoryEntryMO *)entry
+                                                onHost:(iTermHostRecordMO *)hostRecord {
+    iTermShellHistoryLogRecord *record =
+        [iTermShellHistoryLogRecord recordWithType:iTermShellHistoryLogRecordTypeCommandUse
+                                          username:hostRecord.username
+                                          hostname:hostRecord.hostname];
+    record.text = entry.command;
+    record.directory = commandUse.directory;
+    record.markGuid = commandUse.markGuid;
+    record.time = commandUse.time.doubleValue;
+    record.code = commandUse.code;
+    return record;
+}
+
+- (iTermShellHistoryLogRecord *)logRecordForDirectory:(iTermRecentDirectoryMO *)directory
+                                               onHost:(iTermHostRecordMO *)hostRecord {
+    iTermShellHistoryLogRecord *record =
+        [iTermShellHistoryLogRecord recordWithType:iTermShellHistoryLogRecordTypeDirectory
+                                          username:hostRecord.username
+                                          hostname:hostRecord.hostname];
+    record.text = directory.path;
+    record.count = directory.useCount.longLongValue;
+    record.time = directory.lastUse.doubleValue;
+    record.starred = directory.starred.boolValue;
+    return record;
+}
+
+- (void)appendToLog:(iTermShellHistoryLogRecord *)record {
+    if (!_log) {
+        return;
+    }
+    [_logHostKeys addObject:record.hostKey];
+    iTermShellHistoryLog *log = _log;
+    const NSTimeInterval now = [self now];
+    dispatch_async(_logQueue, ^{
+        [log appendRecord:record];
+        if (!self->_compacting && log.size > MAX(kMinimumLogSizeToCompact, 2 * log.sizeAfterLastReplacement)) {
+            [self compactLogInBackground:log now:now];
+        }
+    });
+}
+
+// Runs on _logQueue. The snapshot is rewritten on another queue while the log keeps being read and
+// appended to here. Only copying records appended in the meantime and renaming the new file over
+// the old one happen on _logQueue.
+- (void)compactLogInBackground:(iTermShellHistoryLog *)log now:(NSTimeInterval)now {
+    iTermShellHistoryLog *snapshot = [log newSnapshot];
+    if (!snapshot) {
+        return;
+    }
+    _compacting = YES;
+    dispatch_group_async(_compactionGroup, dispatch_get_global_queue(QOS_CLASS_UTILITY, 0), ^{
+        const BOOL ok = [snapshot writeReplacementUsingBlock:^(void (^append)(iTermShellHistoryLogRecord *)) {
+            [iTermShellHistoryController appendCompactedRecordsOfLog:snapshot
+                                                                 now:now
+                                                     erasingCommands:NO
+                                                         directories:NO
+                                                              append:append];
+        }];
+        dispatch_group_async(self->_compactionGroup, self->_logQueue, ^{
+            if (ok) {
+                [log replaceContentsWithReplacementFromSnapshot:snapshot];
+            }
+            [snapshot release];
+            self->_compacting = NO;
+        });
+    });
+}
+
+- (void)compactLog {
+    if (!_log) {
+        return;
+    }
+    iTermShellHistoryLog *log = _log;
+    const NSTimeInterval now = [self now];
+    dispatch_sync(_logQueue, ^{
+        [iTermShellHistoryController compactLog:log now:now erasingCommands:NO directories:NO];
+    });
+}
+
+// Rewrites the log with just enough records to reproduce the history, less anything erased or too
+// old to keep. Runs on _logQueue.
++ (void)compactLog:(iTermShellHistoryLog *)log
+               now:(NSTimeInterval)now
+   erasingCommands:(BOOL)eraseCommands
+       directories:(BOOL)eraseDirectories {
+    [log replaceContentsUsingBlock:^(void (^append)(iTermShellHistoryLogRecord *)) {
+        [self appendCompactedRecordsOfLog:log
+                                      now:now
+                          erasingCommands:eraseCommands
+                              directories:eraseDirectories
+                                   append:append];
+    }];
+}
+
++ (void)appendCompactedRecordsOfLog:(iTermShellHistoryLog *)log
+                                now:(NSTimeInterval)now
+                    erasingCommands:(BOOL)eraseCommands
+                        directories:(BOOL)eraseDirectories
+                             append:(void (^)(iTermShellHistoryLogRecord *))append {
+    NSMutableArray<iTermShellHistoryLogRecord *> *directories = [NSMutableArray array];
+    for (NSString *hostKey in log.hostKeys) {
+        [log enumerateCompactedRecordsForHostKey:hostKey
+                                   commandCutoff:now - kMaxTimeToRememberCommands
+                                 directoryCutoff:now - kMaxTimeToRememberDirectories
+                                           block:^(iTermShellHistoryLogRecord *record) {
+            if (record.type == iTermShellHistoryLogRecordTypeDirectory) {
+                if (!eraseDirectories) {
+                    [directories addObject:record];
+                }
+            } else if (!eraseCommands) {
+                append(record);
+            }
+        }];
+    }
+
+    // As in -removeOldData, keep only the most recently used unstarred directories.
+    [directories sortUsingComparator:^NSComparisonResult(iTermShellHistoryLogRecord *lhs,
+                                                         iTermShellHistoryLogRecord *rhs) {
+        return [@(rhs.time) compare:@(lhs.time)];
+    }];
+    NSInteger numberOfUnstarredDirectories = 0;
+    for (iTermShellHistoryLogRecord *record in directories) {
+        if (!record.starred && ++numberOfUnstarredDirectories > iTermMaxDirectoriesToSave) {
+            continue;
+        }
+        append(record);
+    }
+}
+
 #pragma mark Private Command History
 
 - (NSMutableArray<iTermCommandHistoryCommandUseMO *> *)commandUsesByExpandingEntries:(NSArray<iTermCommandHistoryEntryMO *> *)array {
@@ -789,6 +1252,16 @@ static const NSTimeInterval kMaxTimeToRememberDirectories = 60 * 60 * 24 * 90;
     return result;
 }
 
+- (iTermCommandHistoryIndex *)commandIndexForHost:(VT100RemoteHost *)host {
+    NSString *key = host.key ?: @"";
+    iTermCommandHistoryIndex *index = _commandIndexes[key];
+    if (!index) {
+        index = [[[iTermCommandHistoryIndex alloc] initWithEntries:[[self recordForHost:host] entries] ?: @[]] autorelease];
+        _commandIndexes[key] = index;
+    }
+    return index;
+}
+
 - (void)loadExpandedCacheForHost:(VT100RemoteHost *)host {
     NSString *key = host.key ?: @"";
 
@@ -802,7 +1275,10 @@ static const NSTimeInterval kMaxTimeToRememberDirectories = 60 * 60 * 24 * 90;
 }
 
 - (void)saveCommandHistory {
-    [self saveObjectGraph];
+    if (!_log) {
+        // With a log the change was saved when it was appended.
+        [self saveObjectGraph];
+    }
     if (!_initializing) {
         [[NSNotificationCenter defaultCenter] postNotificationName:kCommandHistoryDidChangeNotificationName
                                                             object:nil];
@@ -825,7 +1301,9 @@ static const NSTimeInterval kMaxTimeToRememberDirectories = 60 * 60 * 24 * 90;
 }
 
 - (void)saveDirectories {
-    [self saveObjectGraph];
+    if (!_log) {
+        [self saveObjectGraph];
+    }
     if (!_initializing) {
         [[NSNotificationCenter defaultCenter] postNotificationName:kDirectoriesDidChangeNotificationName
                                                             object:nil];
@@ -0,0 +1,116 @@
+//
+//  iTermShellHistoryLog.h
+//  iTerm2
+//
+//  Created by George Nachman on 10/18/26.
+//
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+typedef NS_ENUM(uint8_t, iTermShellHistoryLogRecordType) {
+    // Sets a command's number of uses (count) and time of last use. text is the command.
+    iTermShellHistoryLogRecordTypeCommandEntry = 1,
+
+    // Adds a use of a command. text is the command. Uses directory, markGuid, time, and code.
+    iTermShellHistoryLogRecordTypeCommandUse = 2,
+
+    // Sets the code of the command use with markGuid.
+    iTermShellHistoryLogRecordTypeCommandStatus = 3,
+
+    // Sets a directory's use count (count), time of last use, and starred. text is the path.
+    iTermShellHistoryLogRecordTypeDirectory = 4,
+
+    // Removes all commands or all directories of the host.
+    iTermShellHistoryLogRecordTypeEraseCommands = 5,
+    iTermShellHistoryLogRecordTypeEraseDirectories = 6
+};
+
+@interface iTermShellHistoryLogRecord : NSObject
+
+@property(nonatomic) iTermShellHistoryLogRecordType type;
+@property(nullable, nonatomic, copy) NSString *username;
+@property(nullable, nonatomic, copy) NSString *hostname;
+@property(nullable, nonatomic, copy) NSString *text;
+@property(nullable, nonatomic, copy) NSString *directory;
+@property(nullable, nonatomic, copy) NSString *markGuid;
+@property(nonatomic) NSTimeInterval time;
+@property(nonatomic) long long count;
+@property(nullable, nonatomic, retain) NSNumber *code;
+@property(nonatomic) BOOL starred;
+
+// Same as -[VT100RemoteHost key] and -[iTermHostRecordMO hostKey].
+@property(nonatomic, readonly) NSString *hostKey;
+
++ (instancetype)recordWithType:(iTermShellHistoryLogRecordType)type
+                      username:(nullable NSString *)username
+                      hostname:(nullable NSString *)hostname;
+
+@end
+
+// Stores shell history as a file of records that is only ever appended to, so recording a command
+// costs one write no matter how much history there is. Each record is checksummed. A record cut
+// short by a crash is found when the file is opened and cut off. Obsolete records pile up until the
+// owner compacts the log by replacing its contents, which is done in a new file that's renamed over
+// the old one.
+//
+// Opening the log reads only enough of each record to learn its host. Records for a host are read
+// when asked for.
+//
+// Not thread-safe. iTermShellHistoryController uses it only on a serial queue, and compacts a
+// snapshot of it on another.
+@interface iTermShellHistoryLog : NSObject
+
+@property(nonatomic, readonly) NSString *path;
+
+// Keys of hosts that have records.
+@property(nonatomic, readonly) NSArray<NSString *> *hostKeys;
+
+// Size of the file in bytes, and its size when it was opened or last replaced.
+@property(nonatomic, readonly) unsigned long long size;
+@property(nonatomic, readonly) unsigned long long sizeAfterLastReplacement;
+
+// Writes a new log at |path| containing the records |block| appends, replacing any file there only
+// once it's complete.
++ (BOOL)writeLogAtPath:(NSString *)path
+            usingBlock:(void (^ NS_NOESCAPE)(void (^append)(iTermShellHistoryLogRecord *record)))block;
+
+// Opens the log at |path|, creating it if needed. Returns nil if it can't be opened.
+- (nullable instancetype)initWithPath:(NSString *)path NS_DESIGNATED_INITIALIZER;
+- (instancetype)init NS_UNAVAILABLE;
+
+- (BOOL)hasRecordsForHostKey:(NSString *)hostKey;
+
+// Calls |block| with each record of a host in the order they were appended.
+- (void)enumerateRecordsForHostKey:(NSString *)hostKey
+                             block:(void (^ NS_NOESCAPE)(iTermShellHistoryLogRecord *record))block;
+
+// Replays a host's records and calls |block| with the fewest records that produce the same
+// history: each command entry followed by its uses, with statuses folded in, and then each
+// directory. Uses older than |commandCutoff| are left out, as are entries with no uses left and
+// unstarred directories last used before |directoryCutoff|.
+- (void)enumerateCompactedRecordsForHostKey:(NSString *)hostKey
+                              commandCutoff:(NSTimeInterval)commandCutoff
+                            directoryCutoff:(NSTimeInterval)directoryCutoff
+                                      block:(void (^ NS_NOESCAPE)(iTermShellHistoryLogRecord *record))block;
+
+- (BOOL)appendRecord:(iTermShellHistoryLogRecord *)record;
+
+// Atomically replaces all records with those that |block| appends.
+- (BOOL)replaceContentsUsingBlock:(void (^ NS_NOESCAPE)(void (^append)(iTermShellHistoryLogRecord *record)))block;
+
+// Replacing contents in these steps lets the log keep being read and appended to while the new
+// file is written. -newSnapshot returns a log that reads the records appended so far; later appends
+// don't change it, and it must not be appended to. -writeReplacementUsingBlock: is called on the
+// snapshot, from any thread, to write the new records to a temporary file. Finally
+// -replaceContentsWithReplacementFromSnapshot: adds the records appended to this log since the
+// snapshot was made and puts the new file in place. It fails if the contents were replaced in the
+// meantime.
+- (nullable iTermShellHistoryLog *)newSnapshot;
+- (BOOL)writeReplacementUsingBlock:(void (^ NS_NOESCAPE)(void (^append)(iTermShellHistoryLogRecord *record)))block;
+- (BOOL)replaceContentsWithReplacementFromSnapshot:(iTermShellHistoryLog *)snapshot;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,750 @@
+//
+//  iTermShellHistoryLog.m
+//  iTerm2
+//
+//  Created by George Nachman on 10/18/26.
+//
+
+#import "iTermShellHistoryLog.h"
+
+#import "DebugLogging.h"
+#import "zlib.h"
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// The file begins with a magic number and a version. Each record is then a 32-bit payload length,
+// a CRC-32 of the payload, and the payload. Numbers are in host byte order.
+static const uint32_t iTermShellHistoryLogMagic = 'iTHL';
+static const uint32_t iTermShellHistoryLogVersion = 1;
+static const size_t iTermShellHistoryLogHeaderSize = sizeof(uint32_t) * 2;
+static const size_t iTermShellHistoryLogRecordHeaderSize = sizeof(uint32_t) * 2;
+
+// Records are collected into a buffer this big before being written when making a new log.
+static const NSUInteger iTermShellHistoryLogWriteBufferSize = 1024 * 1024;
+
+static const uint32_t iTermShellHistoryLogNilString = UINT32_MAX;
+
+typedef NS_OPTIONS(uint8_t, iTermShellHistoryLogRecordFlags) {
+    iTermShellHistoryLogRecordFlagHasCode = 1 << 0,
+    iTermShellHistoryLogRecordFlagStarred = 1 << 1
+};
+
+typedef struct {
+    const uint8_t *bytes;
+    size_t length;
+    size_t offset;
+    BOOL ok;
+} iTermShellHistoryLogReader;
+
+static BOOL iTermShellHistoryLogRead(iTermShellHistoryLogReader *reader, void *value, size_t size) {
+    if (!reader->ok || reader->length - reader->offset < size) {
+        reader->ok = NO;
+        return NO;
+    }
+    memcpy(value, reader->bytes + reader->offset, size);
+    reader->offset += size;
+    return YES;
+}
+
+static NSString *iTermShellHistoryLogReadString(iTermShellHistoryLogReader *reader) {
+    uint32_t length;
+    if (!iTermShellHistoryLogRead(reader, &length, sizeof(length)) ||
+        length == iTermShellHistoryLogNilString) {
+        return nil;
+    }
+    if (reader->length - reader->offset < length) {
+        reader->ok = NO;
+        return nil;
+    }
+    NSString *string = [[[NSString alloc] initWithBytes:reader->bytes + reader->offset
+                                                 length:length
+                                               encoding:NSUTF8StringEncoding] autorelease];
+    reader->offset += length;
+    return string;
+}
+
+static void iTermShellHistoryLogAppendString(NSMutableData *data, NSString *string) {
+    if (!string) {
+        [data appendBytes:&iTermShellHistoryLogNilString length:sizeof(iTermShellHistoryLogNilString)];
+        return;
+    }
+    const NSUInteger maximumLength = [string maximumLengthOfBytesUsingEncoding:NSUTF8StringEncoding];
+    const NSUInteger lengthOffset = data.length;
+    [data increaseLengthBy:sizeof(uint32_t) + maximumLength];
+    NSUInteger usedLength = 0;
+    [string getBytes:(uint8_t *)data.mutableBytes + lengthOffset + sizeof(uint32_t)
+           maxLength:maximumLength
+          usedLength:&usedLength
+            encoding:NSUTF8StringEncoding
+             options:0
+               range:NSMakeRange(0, string.length)
+      remainingRange:NULL];
+    const uint32_t length = (uint32_t)usedLength;
+    memcpy((uint8_t *)data.mutableBytes + lengthOffset, &length, sizeof(length));
+    data.length = lengthOffset + sizeof(uint32_t) + usedLength;
+}
+
+// Returns the length of the type, username, and hostname at the start of a payload, or 0 if it's
+// malformed. Records with the same bytes after the type belong to the same host.
+static size_t iTermShellHistoryLogHostPrefixLength(const uint8_t *bytes, size_t length) {
+    size_t offset = sizeof(iTermShellHistoryLogRecordType);
+    for (int i = 0; i < 2; i++) {
+        uint32_t stringLength;
+        if (offset > length || length - offset < sizeof(stringLength)) {
+            return 0;
+        }
+        memcpy(&stringLength, bytes + offset, sizeof(stringLength));
+        offset += sizeof(stringLength);
+        if (stringLength == iTermShellHistoryLogNilString) {
+            continue;
+        }
+        if (length - offset < stringLength) {
+            return 0;
+        }
+        offset += stringLength;
+    }
+    return offset;
+}
+
+static BOOL iTermShellHistoryLogWriteAll(int fd, const void *bytes, size_t length) {
+    size_t offset = 0;
+    while (offset < length) {
+        const ssize_t written = write(fd, (const uint8_t *)bytes + offset, length - offset);
+        if (written < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return NO;
+        }
+        offset += written;
+    }
+    return YES;
+}
+
+static BOOL iTermShellHistoryLogReadAll(int fd, void *bytes, size_t length, off_t offset) {
+    size_t done = 0;
+    while (done < length) {
+        const ssize_t n = pread(fd, (uint8_t *)bytes + done, length - done, offset + done);
+        if (n < 0 && errno == EINTR) {
+            continue;
+        }
+        if (n <= 0) {
+            return NO;
+        }
+        done += n;
+    }
+    return YES;
+}
+
+@implementation iTermShellHistoryLogRecord
+
++ (instancetype)recordWithType:(iTermShellHistoryLogRecordType)type
+                      username:(NSString *)username
+                      hostname:(NSString *)hostname {
+    iTermShellHistoryLogRecord *record = [[[self alloc] init] autorelease];
+    record.type = type;
+    record.username = username;
+    record.hostname = hostname;
+    return record;
+}
+
+- (void)dealloc {
+    [_username release];
+    [_hostname release];
+    [_text release];
+    [_directory release];
+    [_markGuid release];
+    [_code release];
+    [super dealloc];
+}
+
+- (NSString *)hostKey {
+    return [NSString stringWithFormat:@"%@@%@", _username, _hostname];
+}
+
+- (NSString *)description {
+    return [NSString stringWithFormat:@"<%@: %p type=%@ host=%@ text=%@>",
+            NSStringFromClass(self.class), self, @(_type), self.hostKey, _text];
+}
+
+// Appends a record header and the payload.
+- (void)appendToData:(NSMutableData *)data {
+    const NSUInteger start = data.length;
+    [data increaseLengthBy:iTermShellHistoryLogRecordHeaderSize];
+
+    [data appendBytes:&_type length:sizeof(_type)];
+    iTermShellHistoryLogAppendString(data, _username);
+    iTermShellHistoryLogAppendString(data, _hostname);
+    iTermShellHistoryLogAppendString(data, _text);
+    iTermShellHistoryLogAppendString(data, _directory);
+    iTermShellHistoryLogAppendString(data, _markGuid);
+    [data appendBytes:&_time length:sizeof(_time)];
+    [data appendBytes:&_count length:sizeof(_count)];
+    iTermShellHistoryLogRecordFlags flags = 0;
+    if (_code) {
+        flags |= iTermShellHistoryLogRecordFlagHasCode;
+    }
+    if (_starred) {
+        flags |= iTermShellHistoryLogRecordFlagStarred;
+    }
+    [data appendBytes:&flags length:sizeof(flags)];
+    const long long code = _code.longLongValue;
+    [data appendBytes:&code length:sizeof(code)];
+
+    const uint8_t *payload = (const uint8_t *)data.bytes + start + iTermShellHistoryLogRecordHeaderSize;
+    const uint32_t length = (uint32_t)(data.length - start - iTermShellHistoryLogRecordHeaderSize);
+    const uint32_t header[2] = { length, (uint32_t)crc32(0, payload, length) };
+    memcpy((uint8_t *)data.mutableBytes + start, header, sizeof(header));
+}
+
++ (instancetype)recordWithPayload:(const uint8_t *)bytes length:(size_t)length {
+    iTermShellHistoryLogReader reader = { .bytes = bytes, .length = length, .offset = 0, .ok = YES };
+    iTermShellHistoryLogRecordType type = 0;
+    iTermShellHistoryLogRead(&reader, &type, sizeof(type));
+    NSString *username = iTermShellHistoryLogReadString(&reader);
+    NSString *hostname = iTermShellHistoryLogReadString(&reader);
+    iTermShellHistoryLogRecord *record = [self recordWithType:type username:username hostname:hostname];
+    record.text = iTermShellHistoryLogReadString(&reader);
+    record.directory = iTermShellHistoryLogReadString(&reader);
+    record.markGuid = iTermShellHistoryLogReadString(&reader);
+    NSTimeInterval time = 0;
+    iTermShellHistoryLogRead(&reader, &time, sizeof(time));
+    record.time = time;
+    long long count = 0;
+    iTermShellHistoryLogRead(&reader, &count, sizeof(count));
+    record.count = count;
+    iTermShellHistoryLogRecordFlags flags = 0;
+    iTermShellHistoryLogRead(&reader, &flags, sizeof(flags));
+    long long code = 0;
+    iTermShellHistoryLogRead(&reader, &code, sizeof(code));
+    if (flags & iTermShellHistoryLogRecordFlagHasCode) {
+        record.code = @(code);
+    }
+    record.starred = !!(flags & iTermShellHistoryLogRecordFlagStarred);
+    return reader.ok ? record : nil;
+}
+
+// Reads just enough of a payload to find its host.
++ (NSString *)hostKeyOfPayload:(const uint8_t *)bytes length:(size_t)length {
+    iTermShellHistoryLogReader reader = { .bytes = bytes, .length = length, .offset = 0, .ok = YES };
+    iTermShellHistoryLogRecordType type;
+    iTermShellHistoryLogRead(&reader, &type, sizeof(type));
+    NSString *username = iTermShellHistoryLogReadString(&reader);
+    NSString *hostname = iTermShellHistoryLogReadString(&reader);
+    if (!reader.ok) {
+        return nil;
+    }
+    return [NSString stringWithFormat:@"%@@%@", username, hostname];
+}
+
+@end
+
+@interface iTermShellHistoryLog ()
+- (instancetype)initWithPath:(NSString *)path
+                          fd:(int)fd
+                     offsets:(NSMutableDictionary<NSString *, NSMutableData *> *)offsets
+                        size:(unsigned long long)size
+        numberOfReplacements:(NSInteger)numberOfReplacements NS_DESIGNATED_INITIALIZER;
+@end
+
+@implementation iTermShellHistoryLog {
+    int _fd;
+    // Host key -> offsets (unsigned long long) of the host's records.
+    NSMutableDictionary<NSString *, NSMutableData *> *_offsets;
+    // Incremented each time the contents are replaced. Copied by snapshots.
+    NSInteger _numberOfReplacements;
+
+    // Set by -writeReplacementUsingBlock: on a snapshot.
+    NSString *_replacementPath;
+    NSMutableDictionary<NSString *, NSMutableData *> *_replacementOffsets;
+    unsigned long long _replacementSize;
+}
+
++ (BOOL)writeLogAtPath:(NSString *)path
+            usingBlock:(void (^ NS_NOESCAPE)(void (^)(iTermShellHistoryLogRecord *)))block {
+    return [self writeLogAtPath:path offsets:nil size:NULL usingBlock:block];
+}
+
++ (BOOL)writeLogAtPath:(NSString *)path
+               offsets:(NSMutableDictionary<NSString *, NSMutableData *> *)offsets
+                  size:(unsigned long long *)sizePtr
+            usingBlock:(void (^ NS_NOESCAPE)(void (^)(iTermShellHistoryLogRecord *)))block {
+    NSString *temporaryPath = [path stringByAppendingString:@".tmp"];
+    if (![self writeTemporaryLogAtPath:temporaryPath offsets:offsets size:sizePtr usingBlock:block]) {
+        return NO;
+    }
+    if (rename(temporaryPath.fileSystemRepresentation, path.fileSystemRepresentation) != 0) {
+        XLog(@"Failed to write %@: %s", path, strerror(errno));
+        unlink(temporaryPath.fileSystemRepresentation);
+        return NO;
+    }
+    return YES;
+}
+
+// Writes a complete log at |temporaryPath| and makes sure it's on disk. Nothing is left there on
+// failure.
++ (BOOL)writeTemporaryLogAtPath:(NSString *)temporaryPath
+                        offsets:(NSMutableDictionary<NSString *, NSMutableData *> *)offsets
+                           size:(unsigned long long *)sizePtr
+                     usingBlock:(void (^ NS_NOESCAPE)(void (^)(iTermShellHistoryLogRecord *)))block {
+    const int fd = open(temporaryPath.fileSystemRepresentation, O_WRONLY | O_CREAT | O_TRUNC, 0600);
+    if (fd < 0) {
+        XLog(@"Failed to create %@: %s", temporaryPath, strerror(errno));
+        return NO;
+    }
+    NSMutableData *buffer = [NSMutableData data];
+    const uint32_t header[2] = { iTermShellHistoryLogMagic, iTermShellHistoryLogVersion };
+    [buffer appendBytes:header length:sizeof(header)];
+    __block unsigned long long flushed = 0;
+    __block BOOL ok = YES;
+    block(^(iTermShellHistoryLogRecord *record) {
+        if (!ok) {
+            return;
+        }
+        unsigned long long offset = flushed + buffer.length;
+        [record appendToData:buffer];
+        if (offsets) {
+            NSString *hostKey = record.hostKey;
+            NSMutableData *hostOffsets = offsets[hostKey];
+            if (!hostOffsets) {
+                hostOffsets = [NSMutableData data];
+                offsets[hostKey] = hostOffsets;
+            }
+            [hostOffsets appendBytes:&offset length:sizeof(offset)];
+        }
+        if (buffer.length >= iTermShellHistoryLogWriteBufferSize) {
+            ok = iTermShellHistoryLogWriteAll(fd, buffer.bytes, buffer.length);
+            flushed += buffer.length;
+            buffer.length = 0;
+        }
+    });
+    if (ok) {
+        ok = iTermShellHistoryLogWriteAll(fd, buffer.bytes, buffer.length);
+        flushed += buffer.length;
+    }
+    // Make sure the new file is really on disk before it replaces the old one.
+    if (ok && fcntl(fd, F_FULLFSYNC) != 0 && fsync(fd) != 0) {
+        ok = NO;
+    }
+    close(fd);
+    if (!ok) {
+        XLog(@"Failed to write %@: %s", temporaryPath, strerror(errno));
+        unlink(temporaryPath.fileSystemRepresentation);
+        return NO;
+    }
+    if (sizePtr) {
+        *sizePtr = flushed;
+    }
+    return YES;
+}
+
+- (instancetype)initWithPath:(NSString *)path {
+    self = [super init];
+    if (self) {
+        _fd = -1;
+        _path = [path copy];
+        _offsets = [[NSMutableDictionary alloc] init];
+        if (![[NSFileManager defaultManager] fileExistsAtPath:path] &&
+            ![iTermShellHistoryLog writeLogAtPath:path usingBlock:^(void (^append)(iTermShellHistoryLogRecord *)) {}]) {
+            [self release];
+            return nil;
+        }
+        _fd = open(path.fileSystemRepresentation, O_RDWR | O_APPEND);
+        if (_fd < 0) {
+            XLog(@"Failed to open %@: %s", path, strerror(errno));
+            [self release];
+            return nil;
+        }
+        if (![self loadOffsets]) {
+            [self release];
+            return nil;
+        }
+        _sizeAfterLastReplacement = _size;
+    }
+    return self;
+}
+
+- (instancetype)initWithPath:(NSString *)path
+                          fd:(int)fd
+                     offsets:(NSMutableDictionary<NSString *, NSMutableData *> *)offsets
+                        size:(unsigned long long)size
+        numberOfReplacements:(NSInteger)numberOfReplacements {
+    self = [super init];
+    if (self) {
+        _fd = fd;
+        _path = [path copy];
+        _offsets = [offsets retain];
+        _size = size;
+        _sizeAfterLastReplacement = size;
+        _numberOfReplacements = numberOfReplacements;
+    }
+    return self;
+}
+
+- (void)dealloc {
+    if (_fd >= 0) {
+        close(_fd);
+    }
+    if (_replacementPath) {
+        // Never used.
+        unlink(_replacementPath.fileSystemRepresentation);
+    }
+    [_path release];
+    [_offsets release];
+    [_replacementPath release];
+    [_replacementOffsets release];
+    [super dealloc];
+}
+
+- (NSArray<NSString *> *)hostKeys {
+    return _offsets.allKeys;
+}
+
+- (BOOL)hasRecordsForHostKey:(NSString *)hostKey {
+    return _offsets[hostKey] != nil;
+}
+
+- (void)enumerateCompactedRecordsForHostKey:(NSString *)hostKey
+                              commandCutoff:(NSTimeInterval)commandCutoff
+                            directoryCutoff:(NSTimeInterval)directoryCutoff
+                                      block:(void (^ NS_NOESCAPE)(iTermShellHistoryLogRecord *))block {
+    // Commands and directories are keyed by their text and kept in the order first seen.
+    NSMutableArray<NSString *> *commands = [NSMutableArray array];
+    NSMutableDictionary<NSString *, iTermShellHistoryLogRecord *> *entries = [NSMutableDictionary dictionary];
+    NSMutableDictionary<NSString *, NSMutableArray<iTermShellHistoryLogRecord *> *> *uses = [NSMutableDictionary dictionary];
+    NSMutableDictionary<NSString *, iTermShellHistoryLogRecord *> *usesByMarkGuid = [NSMutableDictionary dictionary];
+    NSMutableArray<NSString *> *paths = [NSMutableArray array];
+    NSMutableDictionary<NSString *, iTermShellHistoryLogRecord *> *directories = [NSMutableDictionary dictionary];
+
+    [self enumerateRecordsForHostKey:hostKey block:^(iTermShellHistoryLogRecord *record) {
+        switch (record.type) {
+            case iTermShellHistoryLogRecordTypeCommandEntry:
+                if (!record.text) {
+                    break;
+                }
+                if (!entries[record.text]) {
+                    [commands addObject:record.text];
+                    uses[record.text] = [NSMutableArray array];
+                }
+                entries[record.text] = record;
+                break;
+
+            case iTermShellHistoryLogRecordTypeCommandUse:
+                if (!record.text || !uses[record.text] || record.time < commandCutoff) {
+                    break;
+                }
+                [uses[record.text] addObject:record];
+                if (record.markGuid) {
+                    usesByMarkGuid[record.markGuid] = record;
+                }
+                break;
+
+            case iTermShellHistoryLogRecordTypeCommandStatus:
+                if (record.markGuid) {
+                    usesByMarkGuid[record.markGuid].code = record.code;
+                }
+                break;
+
+            case iTermShellHistoryLogRecordTypeDirectory:
+                if (!record.text) {
+                    break;
+                }
+                if (!directories[record.text]) {
+                    [paths addObject:record.text];
+                }
+                directories[record.text] = record;
+                break;
+
+            case iTermShellHistoryLogRecordTypeEraseCommands:
+                [commands removeAllObjects];
+                [entries removeAllObjects];
+                [uses removeAllObjects];
+                [usesByMarkGuid removeAllObjects];
+                break;
+
+            case iTermShellHistoryLogRecordTypeEraseDirectories:
+                [paths removeAllObjects];
+                [directories removeAllObjects];
+                break;
+        }
+    }];
+
+    for (NSString *command in commands) {
+        NSArray<iTermShellHistoryLogRecord *> *commandUses = uses[command];
+        if (commandUses.count == 0) {
+            continue;
+        }
+        block(entries[command]);
+        for (iTermShellHistoryLogRecord *use in commandUses) {
+            block(use);
+        }
+    }
+    for (NSString *path in paths) {
+        iTermShellHistoryLogRecord *directory = directories[path];
+        if (directory.starred || directory.time >= directoryCutoff) {
+            block(directory);
+        }
+    }
+}
+
+- (void)enumerateRecordsForHostKey:(NSString *)hostKey
+                             block:(void (^ NS_NOESCAPE)(iTermShellHistoryLogRecord *))block {
+    NSData *hostOffsets = _offsets[hostKey];
+    const unsigned long long *offsets = hostOffsets.bytes;
+    const NSUInteger count = hostOffsets.length / sizeof(*offsets);
+    NSMutableData *payload = [NSMutableData data];
+    for (NSUInteger i = 0; i < count; i++) {
+        @autoreleasepool {
+            uint32_t header[2];
+            if (!iTermShellHistoryLogReadAll(_fd, header, sizeof(header), offsets[i])) {
+                XLog(@"Failed to read record at %@ in %@: %s", @(offsets[i]), _path, strerror(errno));
+                return;
+            }
+            payload.length = header[0];
+            if (!iTermShellHistoryLogReadAll(_fd,
+                                             payload.mutableBytes,
+                                             header[0],
+                                             offsets[i] + iTermShellHistoryLogRecordHeaderSize)) {
+                XLog(@"Failed to read record at %@ in %@: %s", @(offsets[i]), _path, strerror(errno));
+                return;
+            }
+            iTermShellHistoryLogRecord *record = [iTermShellHistoryLogRecord recordWithPayload:payload.bytes
+                                                                                        length:payload.length];
+            if (record) {
+                block(record);
+            }
+        }
+    }
+}
+
+- (BOOL)appendRecord:(iTermShellHistoryLogRecord *)record {
+    NSMutableData *data = [NSMutableData data];
+    [record appendToData:data];
+    if (!iTermShellHistoryLogWriteAll(_fd, data.bytes, data.length)) {
+        XLog(@"Failed to append to %@: %s", _path, strerror(errno));
+        // Don't leave part of a record behind for the next record to be appended to.
+        ftruncate(_fd, _size);
+        return NO;
+    }
+    [self addOffset:_size forHostKey:record.hostKey];
+    _size += data.length;
+    return YES;
+}
+
+- (BOOL)replaceContentsUsingBlock:(void (^ NS_NOESCAPE)(void (^)(iTermShellHistoryLogRecord *)))block {
+    NSMutableDictionary<NSString *, NSMutableData *> *offsets = [NSMutableDictionary dictionary];
+    unsigned long long size = 0;
+    if (![iTermShellHistoryLog writeLogAtPath:_path offsets:offsets size:&size usingBlock:block]) {
+        return NO;
+    }
+    const int fd = open(_path.fileSystemRepresentation, O_RDWR | O_APPEND);
+    if (fd < 0) {
+        XLog(@"Failed to reopen %@: %s", _path, strerror(errno));
+        return NO;
+    }
+    close(_fd);
+    _fd = fd;
+    [_offsets release];
+    _offsets = [offsets retain];
+    _size = size;
+    _sizeAfterLastReplacement = size;
+    _numberOfReplacements += 1;
+    return YES;
+}
+
+- (iTermShellHistoryLog *)newSnapshot {
+    // The file is only appended to until it's replaced, and replacing it renames a new file over
+    // it, so a duplicate descriptor keeps reading the records that exist now.
+    const int fd = dup(_fd);
+    if (fd < 0) {
+        XLog(@"Failed to dup descriptor for %@: %s", _path, strerror(errno));
+        return nil;
+    }
+    NSMutableDictionary<NSString *, NSMutableData *> *offsets = [NSMutableDictionary dictionary];
+    [_offsets enumerateKeysAndObjectsUsingBlock:^(NSString *hostKey, NSMutableData *hostOffsets, BOOL *stop) {
+        offsets[hostKey] = [[hostOffsets mutableCopy] autorelease];
+    }];
+    return [[iTermShellHistoryLog alloc] initWithPath:_path
+                                                   fd:fd
+                                              offsets:offsets
+                                                 size:_size
+                                 numberOfReplacements:_numberOfReplacements];
+}
+
+- (BOOL)writeReplacementUsingBlock:(void (^ NS_NOESCAPE)(void (^)(iTermShellHistoryLogRecord *)))block {
+    // Not the path -replaceContentsUsingBlock: uses, since that may run on the log meanwhile.
+    NSString *temporaryPath = [_path stringByAppendingString:@".compacting"];
+    NSMutableDictionary<NSString *, NSMutableData *> *offsets = [NSMutableDictionary dictionary];
+    unsigned long long size = 0;
+    if (![iTermShellHistoryLog writeTemporaryLogAtPath:temporaryPath offsets:offsets size:&size usingBlock:block]) {
+        return NO;
+    }
+    [_replacementPath release];
+    _replacementPath = [temporaryPath copy];
+    [_replacementOffsets release];
+    _replacementOffsets = [offsets retain];
+    _replacementSize = size;
+    return YES;
+}
+
+- (BOOL)replaceContentsWithReplacementFromSnapshot:(iTermShellHistoryLog *)snapshot {
+    NSString *temporaryPath = [[snapshot->_replacementPath retain] autorelease];
+    if (!temporaryPath) {
+        return NO;
+    }
+    [snapshot->_replacementPath release];
+    snapshot->_replacementPath = nil;
+    if (snapshot->_numberOfReplacements != _numberOfReplacements) {
+        // The snapshot's records are out of date, as when history was erased.
+        unlink(temporaryPath.fileSystemRepresentation);
+        return NO;
+    }
+    const int fd = open(temporaryPath.fileSystemRepresentation, O_RDWR | O_APPEND);
+    if (fd < 0) {
+        XLog(@"Failed to open %@: %s", temporaryPath, strerror(errno));
+        unlink(temporaryPath.fileSystemRepresentation);
+        return NO;
+    }
+
+    // Copy the records appended since the snapshot, in the order they were appended.
+    NSMutableArray<NSArray *> *appended = [NSMutableArray array];
+    [_offsets enumerateKeysAndObjectsUsingBlock:^(NSString *hostKey, NSMutableData *hostOffsets, BOOL *stop) {
+        const unsigned long long *offsets = hostOffsets.bytes;
+        const NSUInteger count = hostOffsets.length / sizeof(*offsets);
+        for (NSUInteger i = 0; i < count; i++) {
+            if (offsets[i] >= snapshot->_size) {
+                [appended addObject:@[ @(offsets[i]), hostKey ]];
+            }
+        }
+    }];
+    [appended sortUsingComparator:^NSComparisonResult(NSArray *lhs, NSArray *rhs) {
+        return [lhs[0] compare:rhs[0]];
+    }];
+    NSMutableDictionary<NSString *, NSMutableData *> *offsets = snapshot->_replacementOffsets;
+    unsigned long long size = snapshot->_replacementSize;
+    NSMutableData *data = [NSMutableData data];
+    BOOL ok = YES;
+    for (NSArray *tuple in appended) {
+        const unsigned long long offset = [tuple[0] unsignedLongLongValue];
+        uint32_t header[2];
+        if (!iTermShellHistoryLogReadAll(_fd, header, sizeof(header), offset)) {
+            ok = NO;
+            break;
+        }
+        data.length = iTermShellHistoryLogRecordHeaderSize + header[0];
+        if (!iTermShellHistoryLogReadAll(_fd, data.mutableBytes, data.length, offset) ||
+            !iTermShellHistoryLogWriteAll(fd, data.bytes, data.length)) {
+            ok = NO;
+            break;
+        }
+        NSMutableData *hostOffsets = offsets[tuple[1]];
+        if (!hostOffsets) {
+            hostOffsets = [NSMutableData data];
+            offsets[tuple[1]] = hostOffsets;
+        }
+        [hostOffsets appendBytes:&size length:sizeof(size)];
+        size += data.length;
+    }
+    if (ok && appended.count > 0 && fcntl(fd, F_FULLFSYNC) != 0 && fsync(fd) != 0) {
+        ok = NO;
+    }
+    if (ok && rename(temporaryPath.fileSystemRepresentation, _path.fileSystemRepresentation) != 0) {
+        ok = NO;
+    }
+    if (!ok) {
+        XLog(@"Failed to replace %@: %s", _path, strerror(errno));
+        close(fd);
+        unlink(temporaryPath.fileSystemRepresentation);
+        return NO;
+    }
+    close(_fd);
+    _fd = fd;
+    [_offsets release];
+    _offsets = [offsets retain];
+    _size = size;
+    _sizeAfterLastReplacement = size;
+    _numberOfReplacements += 1;
+    return YES;
+}
+
+#pragma mark - Private
+
+- (void)addOffset:(unsigned long long)offset forHostKey:(NSString *)hostKey {
+    NSMutableData *hostOffsets = _offsets[hostKey];
+    if (!hostOffsets) {
+        hostOffsets = [NSMutableData data];
+        _offsets[hostKey] = hostOffsets;
+    }
+    [hostOffsets appendBytes:&offset length:sizeof(offset)];
+}
+
+// Finds the records of each host. Anything after the last intact record is removed.
+- (BOOL)loadOffsets {
+    NSError *error = nil;
+    NSData *data = [NSData dataWithContentsOfFile:_path options:NSDataReadingMappedIfSafe error:&error];
+    if (!data) {
+        XLog(@"Failed to read %@: %@", _path, error);
+        return NO;
+    }
+    const uint8_t *bytes = data.bytes;
+    const size_t length = data.length;
+    uint32_t header[2] = { 0, 0 };
+    if (length >= iTermShellHistoryLogHeaderSize) {
+        memcpy(header, bytes, sizeof(header));
+    }
+    if (header[0] != iTermShellHistoryLogMagic || header[1] != iTermShellHistoryLogVersion) {
+        XLog(@"%@ is not a shell history log", _path);
+        return NO;
+    }
+
+    size_t offset = iTermShellHistoryLogHeaderSize;
+    // A host's records are usually next to each other, so avoid making a key for each record.
+    const uint8_t *previousHostPrefix = NULL;
+    size_t previousHostPrefixLength = 0;
+    NSMutableData *hostOffsets = nil;
+    while (length - offset >= iTermShellHistoryLogRecordHeaderSize) {
+        uint32_t recordHeader[2];
+        memcpy(recordHeader, bytes + offset, sizeof(recordHeader));
+        const size_t payloadOffset = offset + iTermShellHistoryLogRecordHeaderSize;
+        if (length - payloadOffset < recordHeader[0] ||
+            crc32(0, bytes + payloadOffset, recordHeader[0]) != recordHeader[1]) {
+            break;
+        }
+        const uint8_t *payload = bytes + payloadOffset;
+        const size_t hostPrefixLength = iTermShellHistoryLogHostPrefixLength(payload, recordHeader[0]);
+        if (hostPrefixLength == 0) {
+            break;
+        }
+        const size_t typeLength = sizeof(iTermShellHistoryLogRecordType);
+        if (hostPrefixLength != previousHostPrefixLength ||
+            memcmp(payload + typeLength, previousHostPrefix + typeLength, hostPrefixLength - typeLength) != 0) {
+            NSString *hostKey = [iTermShellHistoryLogRecord hostKeyOfPayload:payload length:recordHeader[0]];
+            if (!hostKey) {
+                break;
+            }
+            hostOffsets = _offsets[hostKey];
+            if (!hostOffsets) {
+                hostOffsets = [NSMutableData data];
+                _offsets[hostKey] = hostOffsets;
+            }
+            previousHostPrefix = payload;
+            previousHostPrefixLength = hostPrefixLength;
+        }
+        const unsigned long long recordOffset = offset;
+        [hostOffsets appendBytes:&recordOffset length:sizeof(recordOffset)];
+        offset = payloadOffset + recordHeader[0];
+    }
+    if (offset < length) {
+        XLog(@"Removing %@ bytes after the last intact record in %@", @(length - offset), _path);
+        if (ftruncate(_fd, offset) != 0) {
+            XLog(@"Failed to truncate %@: %s", _path, strerror(errno));
+            return NO;
+        }
+    }
+    _size = offset;
+    return YES;
+}
+
+@end
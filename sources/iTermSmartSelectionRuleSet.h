@@ -0,0 +1,39 @@
+//
+//  iTermSmartSelectionRuleSet.h
+//  iTerm2
+//
+//  Created by George Nachman on 10/18/26.
+//
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+// Smart selection rules with their regular expressions compiled once. Rules whose regex doesn't
+// compile never match.
+@interface iTermSmartSelectionRuleSet : NSObject
+
+@property (nonatomic, readonly) NSArray<NSDictionary *> *rules;
+
+// Returns a shared rule set for these rules, compiling them only the first time they're seen.
++ (instancetype)ruleSetWithRules:(NSArray<NSDictionary *> *)rules;
+
+- (instancetype)initWithRules:(NSArray<NSDictionary *> *)rules NS_DESIGNATED_INITIALIZER;
+- (instancetype)init NS_UNAVAILABLE;
+
+// Calls `block` for each match that contains `offset`, in rule order. Each rule takes a single
+// forward pass over `string`: after a match that contains `offset` the search resumes at its end,
+// and after one that doesn't it resumes one character past its start, so overlapping candidates
+// are still found. Searches are bounded by ranges of `string` and never copy it. A match's
+// components are the text of its capture groups, with @"" for groups that didn't participate.
+- (void)enumerateMatchesInString:(NSString *)string
+                  coveringOffset:(NSInteger)offset
+                  actionRequired:(BOOL)actionRequired
+                           block:(void (^ NS_NOESCAPE)(NSDictionary *rule,
+                                                  double precision,
+                                                  NSRange range,
+                                                  NSArray<NSString *> *components))block;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,149 @@
+//
+//  iTermSmartSelectionRuleSet.m
+//  iTerm2
+//
+//  Created by George Nachman on 10/18/26.
+//
+
+#import "iTermSmartSelectionRuleSet.h"
+
+#import "DebugLogging.h"
+#import "iTermCache.h"
+#import "SmartSelectionController.h"
+
+// Profiles each have their own rules, but few are in use at once.
+static const NSInteger iTermSmartSelectionRuleSetCacheCapacity = 16;
+
+@interface iTermSmartSelectionCompiledRule : NSObject
+@property (nonatomic, readonly) NSDictionary *rule;
+// Nil if the regex is invalid.
+@property (nullable, nonatomic, readonly) NSRegularExpression *regex;
+@property (nonatomic, readonly) double precision;
+@property (nonatomic, readonly) BOOL hasActions;
+@end
+
+@implementation iTermSmartSelectionCompiledRule
+
+- (instancetype)initWithRule:(NSDictionary *)rule {
+    self = [super init];
+    if (self) {
+        _rule = [rule retain];
+        NSString *pattern = [SmartSelectionController regexInRule:rule];
+        if (pattern) {
+            NSError *error = nil;
+            _regex = [[NSRegularExpression alloc] initWithPattern:pattern options:0 error:&error];
+            if (!_regex) {
+                DLog(@"Invalid smart selection regex %@: %@", pattern, error);
+            }
+        }
+        _precision = [SmartSelectionController precisionInRule:rule];
+        _hasActions = [[SmartSelectionController actionsInRule:rule] count] > 0;
+    }
+    return self;
+}
+
+- (void)dealloc {
+    [_rule release];
+    [_regex release];
+    [super dealloc];
+}
+
+- (NSArray<NSString *> *)componentsOfMatch:(NSTextCheckingResult *)match inString:(NSString *)string {
+    NSMutableArray<NSString *> *components = [NSMutableArray arrayWithCapacity:match.numberOfRanges];
+    for (NSUInteger i = 0; i < match.numberOfRanges; i++) {
+        const NSRange range = [match rangeAtIndex:i];
+        if (range.location == NSNotFound) {
+            [components addObject:@""];
+        } else {
+            [components addObject:[string substringWithRange:range]];
+        }
+    }
+    return components;
+}
+
+@end
+
+@implementation iTermSmartSelectionRuleSet {
+    NSArray<iTermSmartSelectionCompiledRule *> *_compiledRules;
+}
+
++ (instancetype)ruleSetWithRules:(NSArray<NSDictionary *> *)rules {
+    static iTermCache<NSArray *, iTermSmartSelectionRuleSet *> *cache;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        cache = [[iTermCache alloc] initWithCapacity:iTermSmartSelectionRuleSetCacheCapacity];
+    });
+    iTermSmartSelectionRuleSet *ruleSet = cache[rules];
+    if (!ruleSet) {
+        ruleSet = [[[self alloc] initWithRules:rules] autorelease];
+        cache[rules] = ruleSet;
+    }
+    return ruleSet;
+}
+
+- (instancetype)initWithRules:(NSArray<NSDictionary *> *)rules {
+    self = [super init];
+    if (self) {
+        _rules = [rules copy];
+        NSMutableArray<iTermSmartSelectionCompiledRule *> *compiledRules = [NSMutableArray arrayWithCapacity:rules.count];
+        for (NSDictionary *rule in rules) {
+            [compiledRules addObject:[[[iTermSmartSelectionCompiledRule alloc] initWithRule:rule] autorelease]];
+        }
+        _compiledRules = [compiledRules copy];
+    }
+    return self;
+}
+
+- (void)dealloc {
+    [_rules release];
+    [_compiledRules release];
+    [super dealloc];
+}
+
+- (void)enumerateMatchesInString:(NSString *)string
+                  coveringOffset:(NSInteger)offset
+                  actionRequired:(BOOL)actionRequired
+                           block:(void (^ NS_NOESCAPE)(NSDictionary *rule,
+                                                  double precision,
+                                                  NSRange range,
+                                                  NSArray<NSString *> *components))block {
+    const NSInteger length = string.length;
+    if (offset < 0 || offset >= length) {
+        return;
+    }
+    const BOOL debug = [SmartSelectionController logDebugInfo];
+    for (iTermSmartSelectionCompiledRule *compiledRule in _compiledRules) {
+        if (actionRequired && !compiledRule.hasActions) {
+            DLog(@"Ignore smart selection rule because it has no action: %@", compiledRule.rule);
+            continue;
+        }
+        NSRegularExpression *regex = compiledRule.regex;
+        if (debug) {
+            NSLog(@"Try regex %@", regex.pattern ?: [SmartSelectionController regexInRule:compiledRule.rule]);
+        }
+        if (!regex) {
+            continue;
+        }
+        NSInteger i = 0;
+        while (i <= offset) {
+            NSTextCheckingResult *match = [regex firstMatchInString:string
+                                                            options:0
+                                                              range:NSMakeRange(i, length - i)];
+            if (!match) {
+                break;
+            }
+            const NSRange range = match.range;
+            if ((NSInteger)range.location <= offset && (NSInteger)NSMaxRange(range) > offset) {
+                block(compiledRule.rule,
+                      compiledRule.precision,
+                      range,
+                      [compiledRule componentsOfMatch:match inString:string]);
+                i = NSMaxRange(range);
+            } else {
+                i = range.location + 1;
+            }
+        }
+    }
+}
+
+@end
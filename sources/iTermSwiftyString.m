@@ -9,15 +9,17 @@
 
 #import "DebugLogging.h"
 #import "iTermAPIHelper.h"
+#import "iTermCompiledExpression.h"
 #import "iTermExpressionEvaluator.h"
 #import "iTermScriptFunctionCall.h"
 #import "iTermScriptHistory.h"
+#import "iTermSwiftyStringScheduler.h"
 #import "iTermVariableReference.h"
 #import "iTermVariableScope.h"
 #import "NSArray+iTerm.h"
 #import "NSObject+iTerm.h"
 
-@interface iTermSwiftyString()
+@interface iTermSwiftyString()<iTermSwiftyStringSchedulerNode>
 @property (nonatomic) BOOL needsReevaluation;
 @property (nonatomic) NSInteger count;
 @property (nonatomic) NSInteger appliedCount;
@@ -28,6 +30,10 @@
     iTermVariableScope *_scope;
     BOOL _observing;
     iTermVariableReference<NSString *> *_sourceRef;
+
+    // Whether _swiftyString calls a function. Computed for the value in _functionCallCheckedString.
+    NSString *_functionCallCheckedString;
+    BOOL _containsFunctionCall;
 }
 
 - (instancetype)initWithString:(NSString *)swiftyString
@@ -116,6 +122,14 @@
         return;
     }
 
+    // Swifty strings that refer to the destination variable or to anything the observer changes
+    // should be evaluated after this one.
+    [[iTermSwiftyStringScheduler sharedInstance] performUpdatesFromProducer:self block:^{
+        [self reallySetEvaluatedString:evaluatedString error:error];
+    }];
+}
+
+- (void)reallySetEvaluatedString:(NSString *)evaluatedString error:(NSError *)error {
     _evaluatedString = [evaluatedString copy];
     if (self.destinationPath) {
         [_scope setValue:evaluatedString forVariableNamed:self.destinationPath];
@@ -211,17 +225,26 @@
     if (!_observing) {
         [self setNeedsReevaluation];
     }
-    
 }
+
 - (void)setNeedsReevaluation {
     self.needsReevaluation = YES;
-    dispatch_async(dispatch_get_main_queue(), ^{
-        if (self.needsReevaluation) {
-            [self reevaluateIfNeeded];
-        }
-    });
+    [[iTermSwiftyStringScheduler sharedInstance] setNeedsEvaluation:self];
 }
 
+- (BOOL)containsFunctionCall {
+    if (![NSObject object:_functionCallCheckedString isEqualToObject:_swiftyString]) {
+        _functionCallCheckedString = [_swiftyString copy];
+        iTermCompiledExpression *compiledExpression =
+            [iTermCompiledExpression compiledExpressionWithString:_swiftyString ?: @""
+                                                             mode:iTermCompiledExpressionModeInterpolatedString];
+        _containsFunctionCall = compiledExpression.containsFunctionCall;
+    }
+    return _containsFunctionCall;
+}
+
+#pragma mark - iTermSwiftyStringSchedulerNode
+
 - (void)reevaluateIfNeeded {
     if (!_evaluatedString) {
         _needsReevaluation = YES;
@@ -230,10 +253,15 @@
         return;
     }
     _needsReevaluation = NO;
-    if (!_evaluatedString) {
+    // Only function calls can take time. Without them, finish now so strings that depend on this
+    // one see the new value in the same batch.
+    const BOOL mayBlock = [self containsFunctionCall];
+    if (!_evaluatedString || !mayBlock) {
         [self evaluateSynchronously:YES];
     }
-    [self evaluateSynchronously:NO];
+    if (mayBlock) {
+        [self evaluateSynchronously:NO];
+    }
 }
 
 #pragma mark - Notifications
@@ -0,0 +1,49 @@
+//
+//  iTermSwiftyStringScheduler.h
+//  iTerm2SharedARC
+//
+//  Created by George Nachman on 10/18/26.
+//
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+@protocol iTermSwiftyStringSchedulerNode<NSObject>
+// Evaluate if still needed. Called at most once per batch.
+- (void)reevaluateIfNeeded;
+@end
+
+// Coalesces reevaluation of swifty strings. When a variable a swifty string depends on changes, the
+// string is marked dirty instead of being evaluated. All dirty strings are evaluated together on the
+// next turn of the runloop, so setting many variables at once (as shell integration does at each
+// prompt) costs one evaluation per affected string.
+//
+// Evaluating one string can dirty others, for example when it sets session.autoName and a tab
+// title refers to it. The scheduler remembers which strings dirtied which and evaluates producers
+// before their consumers. A string dirtied again after it was evaluated waits for the next batch.
+//
+// Unlike iTermSwiftyStringGraph, which is built on demand to look for cycles among variables, this
+// tracks swifty strings as they actually affect each other.
+@interface iTermSwiftyStringScheduler : NSObject
+
+// Instrumentation.
+@property (nonatomic, readonly) NSInteger evaluationsPerSecond;
+@property (nonatomic, readonly) NSUInteger numberOfEvaluations;
+@property (nonatomic, readonly) NSUInteger numberOfBatches;
+
++ (instancetype)sharedInstance;
+
+// Schedules |node| to be evaluated in the next batch.
+- (void)setNeedsEvaluation:(id<iTermSwiftyStringSchedulerNode>)node;
+
+// Nodes that become dirty while |block| runs are recorded as consumers of |producer|.
+- (void)performUpdatesFromProducer:(id<iTermSwiftyStringSchedulerNode>)producer
+                             block:(void (^ NS_NOESCAPE)(void))block;
+
+// Evaluates the pending batch now instead of on the next turn of the runloop.
+- (void)evaluatePendingNodes;
+
+@end
+
+NS_ASSUME_NONNULL_END
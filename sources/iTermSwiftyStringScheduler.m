@@ -0,0 +1,164 @@
+//
+//  iTermSwiftyStringScheduler.m
+//  iTerm2SharedARC
+//
+//  Created by George Nachman on 10/18/26.
+//
+
+#import "iTermSwiftyStringScheduler.h"
+
+#import "DebugLogging.h"
+#import "iTermThroughputEstimator.h"
+
+@implementation iTermSwiftyStringScheduler {
+    // Dirty nodes in the order they became dirty.
+    NSMutableOrderedSet<id<iTermSwiftyStringSchedulerNode>> *_pending;
+
+    // Nodes dirtied during a batch after having been evaluated in it. They form the next batch.
+    NSMutableOrderedSet<id<iTermSwiftyStringSchedulerNode>> *_deferred;
+
+    // Nodes evaluated so far in the current batch.
+    NSHashTable<id<iTermSwiftyStringSchedulerNode>> *_evaluatedInBatch;
+
+    // Maps a producer to nodes it has dirtied.
+    NSMapTable<id<iTermSwiftyStringSchedulerNode>, NSHashTable<id<iTermSwiftyStringSchedulerNode>> *> *_consumers;
+
+    // Stack of nodes passed to -performUpdatesFromProducer:block:.
+    NSMutableArray<id<iTermSwiftyStringSchedulerNode>> *_producers;
+
+    BOOL _scheduled;
+    BOOL _evaluating;
+    iTermThroughputEstimator *_evaluationRate;
+}
+
++ (instancetype)sharedInstance {
+    static iTermSwiftyStringScheduler *instance;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        instance = [[self alloc] init];
+    });
+    return instance;
+}
+
+- (instancetype)init {
+    self = [super init];
+    if (self) {
+        _pending = [NSMutableOrderedSet orderedSet];
+        _deferred = [NSMutableOrderedSet orderedSet];
+        _evaluatedInBatch = [NSHashTable hashTableWithOptions:NSPointerFunctionsObjectPointerPersonality];
+        _consumers = [NSMapTable weakToStrongObjectsMapTable];
+        _producers = [NSMutableArray array];
+        _evaluationRate = [[iTermThroughputEstimator alloc] initWithHistoryOfDuration:5
+                                                                     secondsPerBucket:1];
+    }
+    return self;
+}
+
+- (NSInteger)evaluationsPerSecond {
+    return _evaluationRate.estimatedThroughput;
+}
+
+- (void)setNeedsEvaluation:(id<iTermSwiftyStringSchedulerNode>)node {
+    id<iTermSwiftyStringSchedulerNode> producer = _producers.lastObject;
+    if (producer && producer != node) {
+        [self addConsumer:node ofProducer:producer];
+    }
+    if (_evaluating && [_evaluatedInBatch containsObject:node]) {
+        [_deferred addObject:node];
+        return;
+    }
+    [_pending addObject:node];
+    if (!_evaluating) {
+        [self schedule];
+    }
+}
+
+- (void)performUpdatesFromProducer:(id<iTermSwiftyStringSchedulerNode>)producer
+                             block:(void (^ NS_NOESCAPE)(void))block {
+    [_producers addObject:producer];
+    block();
+    [_producers removeLastObject];
+}
+
+- (void)evaluatePendingNodes {
+    if (_evaluating || _pending.count == 0) {
+        return;
+    }
+    _evaluating = YES;
+    _numberOfBatches++;
+    const NSUInteger before = _numberOfEvaluations;
+    while (_pending.count) {
+        // Nodes dirtied by an earlier node in the order are picked up later in the same pass.
+        // Anything dirtied through an edge not seen before gets another pass.
+        for (id<iTermSwiftyStringSchedulerNode> node in [self topologicallySortedNodesReachableFrom:_pending]) {
+            if (![_pending containsObject:node]) {
+                continue;
+            }
+            [_pending removeObject:node];
+            [_evaluatedInBatch addObject:node];
+            _numberOfEvaluations++;
+            [node reevaluateIfNeeded];
+        }
+    }
+    [_evaluationRate addByteCount:_numberOfEvaluations - before];
+    DLog(@"Batch %@ evaluated %@ swifty strings. %@ evaluations/sec",
+         @(_numberOfBatches), @(_numberOfEvaluations - before), @(self.evaluationsPerSecond));
+    [_evaluatedInBatch removeAllObjects];
+    _evaluating = NO;
+
+    if (_deferred.count) {
+        [_pending unionOrderedSet:_deferred];
+        [_deferred removeAllObjects];
+        [self schedule];
+    }
+}
+
+#pragma mark - Private
+
+- (void)schedule {
+    if (_scheduled) {
+        return;
+    }
+    _scheduled = YES;
+    dispatch_async(dispatch_get_main_queue(), ^{
+        self->_scheduled = NO;
+        [self evaluatePendingNodes];
+    });
+}
+
+- (void)addConsumer:(id<iTermSwiftyStringSchedulerNode>)consumer
+         ofProducer:(id<iTermSwiftyStringSchedulerNode>)producer {
+    NSHashTable *consumers = [_consumers objectForKey:producer];
+    if (!consumers) {
+        consumers = [NSHashTable weakObjectsHashTable];
+        [_consumers setObject:consumers forKey:producer];
+    }
+    [consumers addObject:consumer];
+}
+
+// Returns |roots| and every node that might be dirtied by evaluating them, producers before
+// consumers. Should there be a cycle it is broken arbitrarily.
+- (NSArray<id<iTermSwiftyStringSchedulerNode>> *)topologicallySortedNodesReachableFrom:(NSOrderedSet<id<iTermSwiftyStringSchedulerNode>> *)roots {
+    NSMutableArray<id<iTermSwiftyStringSchedulerNode>> *postorder = [NSMutableArray array];
+    NSHashTable<id<iTermSwiftyStringSchedulerNode>> *visited =
+        [NSHashTable hashTableWithOptions:NSPointerFunctionsObjectPointerPersonality];
+    for (id<iTermSwiftyStringSchedulerNode> root in roots) {
+        [self visit:root visited:visited postorder:postorder];
+    }
+    return postorder.reverseObjectEnumerator.allObjects;
+}
+
+- (void)visit:(id<iTermSwiftyStringSchedulerNode>)node
+      visited:(NSHashTable<id<iTermSwiftyStringSchedulerNode>> *)visited
+    postorder:(NSMutableArray<id<iTermSwiftyStringSchedulerNode>> *)postorder {
+    if ([visited containsObject:node]) {
+        return;
+    }
+    [visited addObject:node];
+    for (id<iTermSwiftyStringSchedulerNode> consumer in [[_consumers objectForKey:node] allObjects]) {
+        [self visit:consumer visited:visited postorder:postorder];
+    }
+    [postorder addObject:node];
+}
+
+@end
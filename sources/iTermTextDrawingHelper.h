@@ -159,6 +159,9 @@ BOOL CheckFindMatchAtIndex(NSData *findMatches, int index);
 // Does bold text render as the bright version of a dim ansi color, and also use specified bold color?
 @property(nonatomic, assign) BOOL useCustomBoldColor;
 
+// Are bold dim ansi colors drawn as their bright versions?
+@property(nonatomic, assign) BOOL brightenBold;
+
 // Is this the current text view of the "front" terminal window?
 // TODO: This might be the same as textViewIsActiveSession.
 @property(nonatomic, assign) BOOL isFrontTextView;
@@ -199,6 +202,11 @@ BOOL CheckFindMatchAtIndex(NSData *findMatches, int index);
 // Amount to shift anti-aliased text by horizontally to simulate bold
 @property(nonatomic, assign) CGFloat antiAliasedShift;
 
+// Number of runs whose attributed strings were found in, or had to be added to, the cache since
+// this object was created. For tests and performance logging.
+@property(nonatomic, readonly) NSInteger attributedStringCacheHits;
+@property(nonatomic, readonly) NSInteger attributedStringCacheMisses;
+
 // NSTextInputClient support
 @property(nonatomic, retain) NSAttributedString *markedText;
 
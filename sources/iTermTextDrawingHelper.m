@@ -15,6 +15,7 @@
 #import "iTermAttributedStringProxy.h"
 #import "iTermBackgroundColorRun.h"
 #import "iTermBoxDrawingBezierCurveFactory.h"
+#import "iTermCache.h"
 #import "iTermColorMap.h"
 #import "iTermController.h"
 #import "iTermFindCursorView.h"
@@ -27,6 +28,7 @@
 #import "iTermSelection.h"
 #import "iTermTextExtractor.h"
 #import "iTermTimestampDrawHelper.h"
+#import "iTermTuple.h"
 #import "iTermVirtualOffset.h"
 #import "MovingAverage.h"
 #import "NSArray+iTerm.h"
@@ -48,6 +50,9 @@
 
 static const int kBadgeMargin = 4;
 
+// Maximum number of runs whose attributed strings are remembered.
+static const NSInteger iTermTextDrawingHelperAttributedStringCacheCapacity = 2048;
+
 extern void CGContextSetFontSmoothingStyle(CGContextRef, int);
 extern int CGContextGetFontSmoothingStyle(CGContextRef);
 
@@ -137,6 +142,88 @@ typedef struct iTermTextColorContext {
     NSColor *previousForegroundColor;
 } iTermTextColorContext;
 
+// Everything besides a run's own characters, colors, and decorations that affects its attributed
+// strings. Part of the key of each entry in the attributed string cache.
+typedef struct {
+    NSUInteger colorMapGeneration;
+    // ASCII and non-ASCII fonts, each plain, bold, italic, and bold italic.
+    struct {
+        NSUInteger fontHash;
+        CGFloat pointSize;
+        NSInteger ligatureLevel;
+        BOOL fakeBold;
+        BOOL fakeItalic;
+    } fonts[8];
+    CGFloat unfocusedSelectionColor[4];
+    CGFloat cellWidth;
+    double minimumContrast;
+    double transparencyAlpha;
+    float blend;
+    BOOL asciiAntiAlias;
+    BOOL nonAsciiAntiAlias;
+    BOOL useNonAsciiFont;
+    BOOL isRetina;
+    BOOL forceAntialiasingOnRetina;
+    BOOL useNativePowerlineGlyphs;
+    BOOL preferSpeedToFullLigatureSupport;
+    BOOL asciiLigaturesAvailable;
+    BOOL asciiLigatures;
+    BOOL nonAsciiLigatures;
+    BOOL zippy;
+    BOOL blinkingItemsVisible;
+    BOOL blinkAllowed;
+    BOOL reverseVideo;
+    BOOL useCustomBoldColor;
+    BOOL brightenBold;
+    BOOL hasBackgroundImage;
+    BOOL transparencyAffectsOnlyDefaultBackgroundColor;
+    BOOL isFrontTextView;
+} iTermTextDrawingHelperAttributedStringSettings;
+
+// Fixed-size part of an attributed string cache key. The find matches and the run's characters
+// follow it.
+typedef struct {
+    // Hash of everything that follows. It comes first because NSData hashes only a prefix of its
+    // bytes.
+    uint64_t hash;
+    iTermTextDrawingHelperAttributedStringSettings settings;
+    NSRange range;
+    NSRange underlinedRange;
+    int bgColor;
+    int bgGreen;
+    int bgBlue;
+    ColorMode bgColorMode;
+    BOOL colorRunSelected;
+    BOOL colorRunIsMatch;
+    BOOL hasSelectedText;
+    BOOL hasBackgroundColor;
+    CGFloat backgroundColor[4];
+    // Complex characters are identified by codes whose meaning can change. For runs that have any,
+    // this is the ScreenCharGeneration() when the key was made. Otherwise it is -1.
+    NSInteger screenCharGeneration;
+    NSUInteger findMatchesLength;
+} iTermTextDrawingHelperAttributedStringKeyHeader;
+
+static uint64_t iTermTextDrawingHelperHash(const unsigned char *bytes, size_t length) {
+    uint64_t h = 0xcbf29ce484222325ULL ^ length;
+    size_t i = 0;
+    for (; i + sizeof(uint64_t) <= length; i += sizeof(uint64_t)) {
+        uint64_t word;
+        memcpy(&word, bytes + i, sizeof(word));
+        h = (h ^ word) * 0x100000001b3ULL;
+        h ^= h >> 29;
+    }
+    for (; i < length; i++) {
+        h = (h ^ bytes[i]) * 0x100000001b3ULL;
+    }
+    return h;
+}
+
+static void iTermTextDrawingHelperGetColorComponents(NSColor *color, CGFloat components[4]) {
+    NSColor *srgb = [color colorUsingColorSpace:[NSColorSpace sRGBColorSpace]];
+    [srgb getRed:&components[0] green:&components[1] blue:&components[2] alpha:&components[3]];
+}
+
 static CGFloat iTermTextDrawingHelperAlphaValueForDefaultBackgroundColor(BOOL hasBackgroundImage,
                                                                          BOOL enableBlending,
                                                                          BOOL reverseVideo,
@@ -179,6 +266,11 @@ static CGFloat iTermTextDrawingHelperAlphaValueForDefaultBackgroundColor(BOOL ha
     NSMutableDictionary<iTermAttributedStringProxy *, id> *_replacementLineRefCache;
 
     BOOL _preferSpeedToFullLigatureSupport;
+
+    // Maps an attributed string cache key to a tuple of the attributed strings and the NSData of
+    // CGFloat positions that -attributedStringsForLine:... produced for it.
+    iTermCache<NSData *, iTermTuple<NSArray *, NSData *> *> *_attributedStringCache;
+    iTermTextDrawingHelperAttributedStringSettings _attributedStringSettings;
 }
 
 - (instancetype)init {
@@ -203,6 +295,7 @@ static CGFloat iTermTextDrawingHelperAlphaValueForDefaultBackgroundColor(BOOL ha
         _missingImages = [[NSMutableSet alloc] init];
         _lineRefCache = [[NSMutableDictionary alloc] init];
         _replacementLineRefCache = [[NSMutableDictionary alloc] init];
+        _attributedStringCache = [[iTermCache alloc] initWithCapacity:iTermTextDrawingHelperAttributedStringCacheCapacity];
     }
     return self;
 }
@@ -224,6 +317,7 @@ static CGFloat iTermTextDrawingHelperAlphaValueForDefaultBackgroundColor(BOOL ha
     [_backgroundStripesImage release];
     [_lineRefCache release];
     [_replacementLineRefCache release];
+    [_attributedStringCache release];
     [_timestampDrawHelper release];
 
     [super dealloc];
@@ -253,6 +347,7 @@ static CGFloat iTermTextDrawingHelperAlphaValueForDefaultBackgroundColor(BOOL ha
         iTermRectFill(rect, virtualOffset);
     }
     [self updateCachedMetrics];
+    [self updateAttributedStringSettings];
     // If there are two or more rects that need display, the OS will pass in |rect| as the smallest
     // bounding rect that contains them all. Luckily, we can get the list of the "real" dirty rects
     // and they're guaranteed to be disjoint. So draw each of them individually.
@@ -318,7 +413,12 @@ static CGFloat iTermTextDrawingHelperAlphaValueForDefaultBackgroundColor(BOOL ha
 
     [self stopTiming];
 
-    iTermPreciseTimerPeriodicLog(@"drawRect", _stats, sizeof(_stats) / sizeof(*_stats), 5, [iTermAdvancedSettingsModel logDrawingPerformance], nil);
+    NSString *identifier = @"drawRect";
+    if ([iTermAdvancedSettingsModel logDrawingPerformance]) {
+        identifier = [NSString stringWithFormat:@"drawRect (attributed string cache: %@ hits, %@ misses)",
+                      @(_attributedStringCacheHits), @(_attributedStringCacheMisses)];
+    }
+    iTermPreciseTimerPeriodicLog(identifier, _stats, sizeof(_stats) / sizeof(*_stats), 5, [iTermAdvancedSettingsModel logDrawingPerformance], nil);
 
     if (_debug) {
         NSColor *c = [NSColor colorWithCalibratedRed:(rand() % 255) / 255.0
@@ -1199,15 +1299,29 @@ static CGFloat iTermTextDrawingHelperAlphaValueForDefaultBackgroundColor(BOOL ha
 //    NSLog(@"Draw text on line %d range %@", row, NSStringFromRange(indexRange));
 
     iTermPreciseTimerStatsStartTimer(&_stats[TIMER_STAT_CONSTRUCTION]);
-    NSArray<id<iTermAttributedString>> *attributedStrings = [self attributedStringsForLine:theLine
-                                                                                     range:indexRange
-                                                                           hasSelectedText:bgselected
-                                                                           backgroundColor:bgColor
-                                                                            forceTextColor:forceTextColor
-                                                                                  colorRun:colorRun
-                                                                               findMatches:matches
-                                                                           underlinedRange:[self underlinedRangeOnLine:row + _totalScrollbackOverflow]
-                                                                                 positions:&positions];
+    NSArray<id<iTermAttributedString>> *attributedStrings;
+    const NSRange underlinedRange = [self underlinedRangeOnLine:row + _totalScrollbackOverflow];
+    if (!forceTextColor && colorRun && [iTermAdvancedSettingsModel cacheAttributedStrings]) {
+        // Drawing a run of a line of the session, which is likely to look just like it did last time.
+        attributedStrings = [self cachedAttributedStringsForLine:theLine
+                                                           range:indexRange
+                                                 hasSelectedText:bgselected
+                                                 backgroundColor:bgColor
+                                                        colorRun:colorRun
+                                                     findMatches:matches
+                                                 underlinedRange:underlinedRange
+                                                       positions:&positions];
+    } else {
+        attributedStrings = [self attributedStringsForLine:theLine
+                                                     range:indexRange
+                                           hasSelectedText:bgselected
+                                           backgroundColor:bgColor
+                                            forceTextColor:forceTextColor
+                                                  colorRun:colorRun
+                                               findMatches:matches
+                                           underlinedRange:underlinedRange
+                                                 positions:&positions];
+    }
     iTermPreciseTimerStatsMeasureAndAccumulate(&_stats[TIMER_STAT_CONSTRUCTION]);
 
     iTermPreciseTimerStatsStartTimer(&_stats[TIMER_STAT_DRAW]);
@@ -2303,6 +2417,151 @@ static BOOL iTermTextDrawingHelperShouldAntiAlias(screen_char_t *c,
             [iTermAdvancedSettingsModel zippyTextDrawing]);
 }
 
+// Like -attributedStringsForLine:... without a forced text color, but reuses the results for a run
+// that was drawn recently with the same characters, colors, decorations, and settings, even if it
+// was on a different line.
+- (NSArray<id<iTermAttributedString>> *)cachedAttributedStringsForLine:(screen_char_t *)line
+                                                                 range:(NSRange)indexRange
+                                                       hasSelectedText:(BOOL)hasSelectedText
+                                                       backgroundColor:(NSColor *)backgroundColor
+                                                              colorRun:(iTermBackgroundColorRun *)colorRun
+                                                           findMatches:(NSData *)findMatches
+                                                       underlinedRange:(NSRange)underlinedRange
+                                                             positions:(CTVector(CGFloat) *)positions {
+    NSData *key = [self attributedStringCacheKeyForLine:line
+                                                  range:indexRange
+                                        hasSelectedText:hasSelectedText
+                                        backgroundColor:backgroundColor
+                                               colorRun:colorRun
+                                            findMatches:findMatches
+                                        underlinedRange:underlinedRange];
+    iTermTuple<NSArray *, NSData *> *entry = _attributedStringCache[key];
+    if (entry) {
+        _attributedStringCacheHits += 1;
+        const CGFloat *cachedPositions = (const CGFloat *)entry.secondObject.bytes;
+        const NSInteger count = entry.secondObject.length / sizeof(CGFloat);
+        for (NSInteger i = 0; i < count; i++) {
+            CTVectorAppend(positions, cachedPositions[i]);
+        }
+        return entry.firstObject;
+    }
+
+    _attributedStringCacheMisses += 1;
+    NSArray<id<iTermAttributedString>> *attributedStrings = [self attributedStringsForLine:line
+                                                                                     range:indexRange
+                                                                           hasSelectedText:hasSelectedText
+                                                                           backgroundColor:backgroundColor
+                                                                            forceTextColor:nil
+                                                                                  colorRun:colorRun
+                                                                               findMatches:findMatches
+                                                                           underlinedRange:underlinedRange
+                                                                                 positions:positions];
+    NSData *positionsData = [NSData dataWithBytes:positions->elements
+                                           length:CTVectorCount(positions) * sizeof(CGFloat)];
+    _attributedStringCache[key] = [iTermTuple tupleWithObject:attributedStrings andObject:positionsData];
+    return attributedStrings;
+}
+
+- (NSData *)attributedStringCacheKeyForLine:(const screen_char_t *)line
+                                      range:(NSRange)indexRange
+                            hasSelectedText:(BOOL)hasSelectedText
+                            backgroundColor:(NSColor *)backgroundColor
+                                   colorRun:(iTermBackgroundColorRun *)colorRun
+                                findMatches:(NSData *)findMatches
+                            underlinedRange:(NSRange)underlinedRange {
+    iTermTextDrawingHelperAttributedStringKeyHeader header;
+    // Zero the padding so it doesn't affect equality.
+    memset(&header, 0, sizeof(header));
+    header.settings = _attributedStringSettings;
+    header.range = indexRange;
+    header.underlinedRange = underlinedRange;
+    header.bgColor = colorRun->bgColor;
+    header.bgGreen = colorRun->bgGreen;
+    header.bgBlue = colorRun->bgBlue;
+    header.bgColorMode = colorRun->bgColorMode;
+    header.colorRunSelected = colorRun->selected;
+    header.colorRunIsMatch = colorRun->isMatch;
+    header.hasSelectedText = hasSelectedText;
+    header.hasBackgroundColor = (backgroundColor != nil);
+    if (backgroundColor) {
+        iTermTextDrawingHelperGetColorComponents(backgroundColor, header.backgroundColor);
+    }
+    header.screenCharGeneration = -1;
+    for (NSUInteger i = indexRange.location; i < NSMaxRange(indexRange); i++) {
+        if (line[i].complexChar) {
+            header.screenCharGeneration = ScreenCharGeneration();
+            break;
+        }
+    }
+    header.findMatchesLength = findMatches.length;
+
+    const NSUInteger lineLength = indexRange.length * sizeof(screen_char_t);
+    NSMutableData *key = [NSMutableData dataWithCapacity:sizeof(header) + findMatches.length + lineLength];
+    [key appendBytes:&header length:sizeof(header)];
+    if (findMatches.length) {
+        [key appendData:findMatches];
+    }
+    [key appendBytes:line + indexRange.location length:lineLength];
+
+    unsigned char *bytes = key.mutableBytes;
+    const uint64_t hash = iTermTextDrawingHelperHash(bytes + sizeof(uint64_t), key.length - sizeof(uint64_t));
+    memcpy(bytes, &hash, sizeof(hash));
+    return key;
+}
+
+- (void)updateAttributedStringSettings {
+    iTermTextDrawingHelperAttributedStringSettings *settings = &_attributedStringSettings;
+    memset(settings, 0, sizeof(*settings));
+    settings->colorMapGeneration = _colorMap.generation;
+
+    // Hiragana "a" stands in for all non-ASCII characters.
+    const UniChar characters[2] = { 'a', 0x3042 };
+    int i = 0;
+    for (int c = 0; c < 2; c++) {
+        for (int style = 0; style < 4; style++) {
+            BOOL bold = !!(style & 1);
+            BOOL italic = !!(style & 2);
+            PTYFontInfo *fontInfo = [_delegate drawingHelperFontForChar:characters[c]
+                                                              isComplex:NO
+                                                             renderBold:&bold
+                                                           renderItalic:&italic];
+            settings->fonts[i].fontHash = fontInfo.font.hash;
+            settings->fonts[i].pointSize = fontInfo.font.pointSize;
+            settings->fonts[i].ligatureLevel = fontInfo.ligatureLevel;
+            settings->fonts[i].fakeBold = bold;
+            settings->fonts[i].fakeItalic = italic;
+            i++;
+        }
+    }
+
+    if (_unfocusedSelectionColor) {
+        iTermTextDrawingHelperGetColorComponents(_unfocusedSelectionColor, settings->unfocusedSelectionColor);
+    }
+    settings->cellWidth = _cellSize.width;
+    settings->minimumContrast = _minimumContrast;
+    settings->transparencyAlpha = _transparencyAlpha;
+    settings->blend = _blend;
+    settings->asciiAntiAlias = _asciiAntiAlias;
+    settings->nonAsciiAntiAlias = _nonAsciiAntiAlias;
+    settings->useNonAsciiFont = _useNonAsciiFont;
+    settings->isRetina = _isRetina;
+    settings->forceAntialiasingOnRetina = _forceAntialiasingOnRetina;
+    settings->useNativePowerlineGlyphs = _useNativePowerlineGlyphs;
+    settings->preferSpeedToFullLigatureSupport = _preferSpeedToFullLigatureSupport;
+    settings->asciiLigaturesAvailable = _asciiLigaturesAvailable;
+    settings->asciiLigatures = _asciiLigatures;
+    settings->nonAsciiLigatures = _nonAsciiLigatures;
+    settings->zippy = self.zippy;
+    settings->blinkingItemsVisible = _blinkingItemsVisible;
+    settings->blinkAllowed = _blinkAllowed;
+    settings->reverseVideo = _reverseVideo;
+    settings->useCustomBoldColor = _useCustomBoldColor;
+    settings->brightenBold = _brightenBold;
+    settings->hasBackgroundImage = _hasBackgroundImage;
+    settings->transparencyAffectsOnlyDefaultBackgroundColor = _transparencyAffectsOnlyDefaultBackgroundColor;
+    settings->isFrontTextView = _isFrontTextView;
+}
+
 - (NSArray<id<iTermAttributedString>> *)attributedStringsForLine:(screen_char_t *)line
                                                            range:(NSRange)indexRange
                                                  hasSelectedText:(BOOL)hasSelectedText
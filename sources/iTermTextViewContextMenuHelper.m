@@ -194,7 +194,8 @@ static const int kMaxSelectedTextLengthForCustomActions = 400;
         [item action] == @selector(browse:) ||
         [item action] == @selector(searchInBrowser:) ||
         [item action] == @selector(addTrigger:) ||
-        [item action] == @selector(saveSelectionAsSnippet:)) {
+        [item action] == @selector(saveSelectionAsSnippet:) ||
+        [item action] == @selector(saveSelectionToFile:)) {
         iTermSelection *selection = [self.delegate contextMenuSelection:self];
         return selection.hasSelection;
     }
@@ -537,6 +538,7 @@ static uint64_t iTermInt64FromBytes(const unsigned char *bytes, BOOL bigEndian)
 
     add(@"Send Selection", @selector(sendSelection:));
     add(@"Save Selection as Snippet", @selector(saveSelectionAsSnippet:));
+    add(@"Save Selection to File…", @selector(saveSelectionToFile:));
 
     // Clear buffer
     add(@"Clear Buffer", @selector(clearTextViewBuffer:));
@@ -889,6 +891,14 @@ static uint64_t iTermInt64FromBytes(const unsigned char *bytes, BOOL bigEndian)
     [self.delegate contextMenuSaveSelectionAsSnippet:self];
 }
 
+- (void)saveSelectionToFile:(id)sender {
+    iTermSelection *selection = [self.delegate contextMenuSelection:self];
+    if (!selection.hasSelection) {
+        return;
+    }
+    [self.delegate contextMenuSaveSelectionToFile:self];
+}
+
 - (void)clearTextViewBuffer:(id)sender {
     [self.delegate contextMenuClearBuffer:self];
 }
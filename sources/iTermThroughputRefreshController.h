@@ -0,0 +1,56 @@
+//
+//  iTermThroughputRefreshController.h
+//  iTerm2
+//
+//  Created by George Nachman on 10/18/26.
+//
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+// Decides when a session is receiving so much output that redrawing would slow down parsing, and
+// how often to redraw while that lasts. Both parsing and drawing happen on the main thread. From
+// the measured cost of parsing a byte, the cost of drawing a frame, and the throughput, it works
+// out how much of the main thread parsing needs. When parsing needs most of it, the session enters
+// "bulk output" mode, where drawing is limited to a small share of the main thread. A keystroke
+// ends bulk output mode immediately so typing feels responsive.
+//
+// Time is always passed in, so it can be simulated with a virtual clock.
+@interface iTermThroughputRefreshController : NSObject
+
+// Share of the main thread parsing must need to enter bulk output mode.
+@property (nonatomic) double enterBulkLoad;
+// Bulk output mode ends when parsing needs less than this share of the main thread.
+@property (nonatomic) double exitBulkLoad;
+// How long the load must stay above enterBulkLoad before bulk output mode begins, so short bursts
+// of output are drawn at the normal rate.
+@property (nonatomic) NSTimeInterval enterBulkDelay;
+// After a keystroke, bulk output mode can't begin for this long.
+@property (nonatomic) NSTimeInterval keystrokeGracePeriod;
+// Share of the main thread drawing may use in bulk output mode.
+@property (nonatomic) double bulkDrawBudget;
+// Longest time between redraws in bulk output mode.
+@property (nonatomic) NSTimeInterval maximumBulkPeriod;
+
+@property (nonatomic, readonly) BOOL bulkOutput;
+// Moving averages of measured costs, in seconds. 0 until measured.
+@property (nonatomic, readonly) double parseCostPerByte;
+@property (nonatomic, readonly) double drawCostPerFrame;
+
+- (instancetype)init NS_DESIGNATED_INITIALIZER;
+
+- (void)didParseBytes:(NSInteger)count duration:(NSTimeInterval)duration;
+- (void)didDrawFrameWithDuration:(NSTimeInterval)duration;
+- (void)didHandleKeystrokeAt:(NSTimeInterval)now;
+
+// Updates the mode given the throughput in bytes per second. Returns the time between redraws to
+// use in bulk output mode, or 0 if not in bulk output mode. `minimumPeriod` is the time between
+// redraws when output isn't bulky; bulk output is never redrawn more often than that.
+- (NSTimeInterval)bulkPeriodForThroughput:(NSInteger)bytesPerSecond
+                            minimumPeriod:(NSTimeInterval)minimumPeriod
+                                      now:(NSTimeInterval)now;
+
+@end
+
+NS_ASSUME_NONNULL_END
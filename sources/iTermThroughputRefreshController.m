@@ -0,0 +1,100 @@
+//
+//  iTermThroughputRefreshController.m
+//  iTerm2
+//
+//  Created by George Nachman on 10/18/26.
+//
+
+#import "iTermThroughputRefreshController.h"
+
+#import "DebugLogging.h"
+
+// Weight of each new sample in the moving averages of costs.
+static const double iTermThroughputRefreshControllerSmoothing = 0.2;
+
+// Batches smaller than this have too much fixed overhead to say much about the cost per byte.
+static const NSInteger iTermThroughputRefreshControllerMinimumSampleBytes = 256;
+
+@implementation iTermThroughputRefreshController {
+    // When the load first exceeded enterBulkLoad. NAN if it hasn't since the last time it was under.
+    NSTimeInterval _overloadStart;
+    NSTimeInterval _lastKeystroke;
+}
+
+- (instancetype)init {
+    self = [super init];
+    if (self) {
+        _enterBulkLoad = 0.5;
+        _exitBulkLoad = 0.2;
+        _enterBulkDelay = 0.25;
+        _keystrokeGracePeriod = 1;
+        _bulkDrawBudget = 0.05;
+        _maximumBulkPeriod = 0.5;
+        _overloadStart = NAN;
+        _lastKeystroke = -INFINITY;
+    }
+    return self;
+}
+
+static double iTermThroughputRefreshControllerAverage(double average, double sample) {
+    if (average == 0) {
+        return sample;
+    }
+    return average + (sample - average) * iTermThroughputRefreshControllerSmoothing;
+}
+
+- (void)didParseBytes:(NSInteger)count duration:(NSTimeInterval)duration {
+    if (count < iTermThroughputRefreshControllerMinimumSampleBytes) {
+        return;
+    }
+    _parseCostPerByte = iTermThroughputRefreshControllerAverage(_parseCostPerByte, duration / count);
+}
+
+- (void)didDrawFrameWithDuration:(NSTimeInterval)duration {
+    _drawCostPerFrame = iTermThroughputRefreshControllerAverage(_drawCostPerFrame, duration);
+}
+
+- (void)didHandleKeystrokeAt:(NSTimeInterval)now {
+    _lastKeystroke = now;
+    if (_bulkOutput) {
+        DLog(@"Leave bulk output mode because of keystroke");
+    }
+    _bulkOutput = NO;
+    _overloadStart = NAN;
+}
+
+- (NSTimeInterval)bulkPeriodForThroughput:(NSInteger)bytesPerSecond
+                            minimumPeriod:(NSTimeInterval)minimumPeriod
+                                      now:(NSTimeInterval)now {
+    // Share of the main thread needed to parse everything that's arriving.
+    const double load = bytesPerSecond * _parseCostPerByte;
+    if (_bulkOutput) {
+        if (load < _exitBulkLoad) {
+            DLog(@"Leave bulk output mode. load=%f", load);
+            _bulkOutput = NO;
+            _overloadStart = NAN;
+        }
+    } else if (load >= _enterBulkLoad && now - _lastKeystroke >= _keystrokeGracePeriod) {
+        if (isnan(_overloadStart)) {
+            _overloadStart = now;
+        }
+        if (now - _overloadStart >= _enterBulkDelay) {
+            DLog(@"Enter bulk output mode. load=%f", load);
+            _bulkOutput = YES;
+        }
+    } else {
+        _overloadStart = NAN;
+    }
+
+    if (!_bulkOutput) {
+        return 0;
+    }
+    // Redraw as often as the budget allows.
+    NSTimeInterval period = _maximumBulkPeriod;
+    if (_drawCostPerFrame > 0) {
+        period = _drawCostPerFrame / _bulkDrawBudget;
+    }
+    return MAX(minimumPeriod, MIN(_maximumBulkPeriod, period));
+}
+
+@end
@@ -0,0 +1,68 @@
+//
+//  iTermURLActionCache.h
+//  iTerm2SharedARC
+//
+//  Created by George Nachman on 10/18/26.
+//
+
+#import <Foundation/Foundation.h>
+
+#import "VT100GridTypes.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+@class URLAction;
+
+// Everything the URL action at a cell depends on. `lineGenerations` holds the generations of the
+// lines whose text could be used to find the action, so any change to them makes a new key.
+@interface iTermURLActionCacheKey : NSObject<NSCopying>
+
+@property (nonatomic, readonly) long long absLine;
+@property (nonatomic, readonly) int column;
+@property (nonatomic, readonly) VT100GridRange columnWindow;
+@property (nonatomic, readonly) BOOL respectHardNewlines;
+@property (nonatomic, readonly) NSData *lineGenerations;
+@property (nonatomic, readonly) NSString *workingDirectory;
+@property (nullable, nonatomic, readonly) NSArray *rules;
+
+- (instancetype)initWithAbsLine:(long long)absLine
+                         column:(int)column
+                   columnWindow:(VT100GridRange)columnWindow
+            respectHardNewlines:(BOOL)respectHardNewlines
+                lineGenerations:(NSData *)lineGenerations
+               workingDirectory:(NSString *)workingDirectory
+                          rules:(nullable NSArray *)rules NS_DESIGNATED_INITIALIZER;
+- (instancetype)init NS_UNAVAILABLE;
+
+@end
+
+// Remembers the URL action found at each cell so that moving the mouse over the same text with
+// Cmd held doesn't search for it again. The search probes the filesystem, so results expire:
+// finding nothing expires sooner since it's the likelier to change (e.g., when a build creates the
+// file being looked for). Main thread only.
+@interface iTermURLActionCache : NSObject
+
+@property (nonatomic) NSTimeInterval positiveTTL;
+@property (nonatomic) NSTimeInterval negativeTTL;
+@property (nonatomic, readonly) NSInteger hits;
+@property (nonatomic, readonly) NSInteger misses;
+
+- (instancetype)initWithCapacity:(NSInteger)capacity NS_DESIGNATED_INITIALIZER;
+- (instancetype)init NS_UNAVAILABLE;
+
+// Calls completion with the cached action for `key` if it hasn't expired at `now`. Otherwise
+// calls `evaluate`, caches the action it produces, and passes it on to `completion`.
+- (void)actionForKey:(iTermURLActionCacheKey *)key
+                 now:(NSTimeInterval)now
+            evaluate:(void (^)(void (^completion)(URLAction * _Nullable action)))evaluate
+          completion:(void (^)(URLAction * _Nullable action))completion;
+
+- (void)removeAllActions;
+
+// Tokens in `string` that might name files, with surrounding punctuation and trailing line and
+// column numbers removed. These are the paths worth checking for ahead of time.
++ (NSArray<NSString *> *)pathLikeTokensInString:(NSString *)string;
+
+@end
+
+NS_ASSUME_NONNULL_END
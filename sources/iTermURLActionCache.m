@@ -0,0 +1,152 @@
+//
+//  iTermURLActionCache.m
+//  iTerm2SharedARC
+//
+//  Created by George Nachman on 10/18/26.
+//
+
+#import "iTermURLActionCache.h"
+
+#import "DebugLogging.h"
+#import "iTermCache.h"
+#import "NSObject+iTerm.h"
+#import "NSStringITerm.h"
+#import "RegexKitLite.h"
+#import "URLAction.h"
+
+@implementation iTermURLActionCacheKey
+
+- (instancetype)initWithAbsLine:(long long)absLine
+                         column:(int)column
+                   columnWindow:(VT100GridRange)columnWindow
+            respectHardNewlines:(BOOL)respectHardNewlines
+                lineGenerations:(NSData *)lineGenerations
+               workingDirectory:(NSString *)workingDirectory
+                          rules:(NSArray *)rules {
+    self = [super init];
+    if (self) {
+        _absLine = absLine;
+        _column = column;
+        _columnWindow = columnWindow;
+        _respectHardNewlines = respectHardNewlines;
+        _lineGenerations = [lineGenerations copy];
+        _workingDirectory = [workingDirectory copy];
+        _rules = [rules copy];
+    }
+    return self;
+}
+
+- (NSString *)description {
+    return [NSString stringWithFormat:@"<%@: %p line=%@ column=%@ window=%@ respectHardNewlines=%@ wd=%@>",
+            NSStringFromClass([self class]), self, @(_absLine), @(_column),
+            VT100GridRangeDescription(_columnWindow), @(_respectHardNewlines), _workingDirectory];
+}
+
+- (id)copyWithZone:(NSZone *)zone {
+    return self;
+}
+
+- (NSUInteger)hash {
+    return (NSUInteger)_absLine * 1000003 ^ (NSUInteger)_column * 8191 ^ _workingDirectory.hash;
+}
+
+- (BOOL)isEqual:(id)object {
+    if (object == self) {
+        return YES;
+    }
+    iTermURLActionCacheKey *other = [iTermURLActionCacheKey castFrom:object];
+    if (!other) {
+        return NO;
+    }
+    return (_absLine == other->_absLine &&
+            _column == other->_column &&
+            _columnWindow.location == other->_columnWindow.location &&
+            _columnWindow.length == other->_columnWindow.length &&
+            _respectHardNewlines == other->_respectHardNewlines &&
+            [_lineGenerations isEqualToData:other->_lineGenerations] &&
+            [_workingDirectory isEqualToString:other->_workingDirectory] &&
+            (_rules == other->_rules || [_rules isEqualToArray:other->_rules]));
+}
+
+@end
+
+@interface iTermURLActionCacheEntry : NSObject
+// Nil if nothing was found.
+@property (nullable, nonatomic, strong) URLAction *action;
+@property (nonatomic) NSTimeInterval expiration;
+@end
+
+@implementation iTermURLActionCacheEntry
+@end
+
+@implementation iTermURLActionCache {
+    NSInteger _capacity;
+    iTermCache<iTermURLActionCacheKey *, iTermURLActionCacheEntry *> *_cache;
+}
+
+- (instancetype)initWithCapacity:(NSInteger)capacity {
+    self = [super init];
+    if (self) {
+        _capacity = capacity;
+        _cache = [[iTermCache alloc] initWithCapacity:capacity];
+        _positiveTTL = 10;
+        _negativeTTL = 3;
+    }
+    return self;
+}
+
+- (void)actionForKey:(iTermURLActionCacheKey *)key
+                 now:(NSTimeInterval)now
+            evaluate:(void (^)(void (^)(URLAction *)))evaluate
+          completion:(void (^)(URLAction *))completion {
+    iTermURLActionCacheEntry *entry = _cache[key];
+    if (entry && now < entry.expiration) {
+        DLog(@"URL action cache hit for %@: %@", key, entry.action);
+        _hits += 1;
+        completion(entry.action);
+        return;
+    }
+    _misses += 1;
+    __weak __typeof(self) weakSelf = self;
+    evaluate(^(URLAction *action) {
+        [weakSelf setAction:action forKey:key now:now];
+        completion(action);
+    });
+}
+
+- (void)setAction:(URLAction *)action forKey:(iTermURLActionCacheKey *)key now:(NSTimeInterval)now {
+    iTermURLActionCacheEntry *entry = [[iTermURLActionCacheEntry alloc] init];
+    entry.action = action;
+    entry.expiration = now + (action ? _positiveTTL : _negativeTTL);
+    _cache[key] = entry;
+}
+
+- (void)removeAllActions {
+    _cache = [[iTermCache alloc] initWithCapacity:_capacity];
+}
+
++ (NSArray<NSString *> *)pathLikeTokensInString:(NSString *)string {
+    static NSCharacterSet *separators;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        NSMutableCharacterSet *temp = [[NSCharacterSet whitespaceAndNewlineCharacterSet] mutableCopy];
+        [temp addCharactersInString:@"\"'`()[]{}<>,;|="];
+        separators = temp;
+    });
+    NSMutableOrderedSet<NSString *> *tokens = [NSMutableOrderedSet orderedSet];
+    for (NSString *word in [string componentsSeparatedByCharactersInSet:separators]) {
+        // Drop a trailing line and column number and any trailing punctuation.
+        NSString *token = [word stringByReplacingOccurrencesOfRegex:@"(:\\d+)*[.:!?]*$" withString:@""];
+        if (token.length < 2) {
+            continue;
+        }
+        // Require a slash or a file extension so ordinary words aren't looked up.
+        if ([token containsString:@"/"] ||
+            [token rangeOfRegex:@"[^./]\\.[A-Za-z0-9_]{1,10}$"].location != NSNotFound) {
+            [tokens addObject:token];
+        }
+    }
+    return tokens.array;
+}
+
+@end
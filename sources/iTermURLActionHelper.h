@@ -43,6 +43,9 @@ NS_ASSUME_NONNULL_BEGIN
 
 - (long long)urlActionTotalScrollbackOverflow:(iTermURLActionHelper *)helper;
 
+// Changes whenever the content of the line changes.
+- (NSInteger)urlActionHelper:(iTermURLActionHelper *)helper generationForLine:(int)line;
+
 - (VT100RemoteHost *)urlActionHelper:(iTermURLActionHelper *)helper remoteHostOnLine:(int)line;
 
 - (NSDictionary<NSNumber *, NSString *> *)urlActionHelperSmartSelectionActionSelectorDictionary:(iTermURLActionHelper *)helper;
@@ -78,6 +81,9 @@ NS_ASSUME_NONNULL_BEGIN
 
 - (void)openTargetWithEvent:(NSEvent *)event inBackground:(BOOL)openInBackground;
 
+// Looks for files named on these lines in the background so hovering over them is fast.
+- (void)prefetchPathsOnLines:(VT100GridRange)lines;
+
 - (void)findUrlInString:(NSString *)aURLString andOpenInBackground:(BOOL)background;
 
 - (void)downloadFileAtSecureCopyPath:(SCPPath *)scpPath
@@ -10,13 +10,16 @@
 #import "DebugLogging.h"
 #import "FileTransferManager.h"
 #import "iTermAdvancedSettingsModel.h"
+#import "iTermCachingFileManager.h"
 #import "iTermImageInfo.h"
 #import "iTermLaunchServices.h"
 #import "iTermSelection.h"
 #import "iTermSemanticHistoryController.h"
 #import "iTermTextExtractor.h"
+#import "iTermURLActionCache.h"
 #import "iTermURLActionFactory.h"
 #import "iTermUserDefaults.h"
+#import "NSDate+iTerm.h"
 #import "NSHost+iTerm.h"
 #import "NSObject+iTerm.h"
 #import "NSURL+iTerm.h"
@@ -24,14 +27,28 @@
 #import "SmartMatch.h"
 #import "URLAction.h"
 
+// Enough for every cell of a few screenfuls.
+static const NSInteger iTermURLActionHelperCacheCapacity = 4096;
+
+// Visible lines are checked for files at most this often.
+static const NSTimeInterval iTermURLActionHelperPrefetchInterval = 1;
+
 @implementation iTermURLActionHelper {
     NSInteger _openTargetGeneration;
+    // Nil if disabled.
+    iTermURLActionCache *_cache;
+    VT100GridRange _lastPrefetchRange;
+    long long _lastPrefetchOverflow;
+    NSTimeInterval _lastPrefetchTime;
 }
 
 - (instancetype)initWithSemanticHistoryController:(iTermSemanticHistoryController *)semanticHistoryController {
     self = [super init];
     if (self) {
         _semanticHistoryController = semanticHistoryController;
+        if ([iTermAdvancedSettingsModel cacheURLActions]) {
+            _cache = [[iTermURLActionCache alloc] initWithCapacity:iTermURLActionHelperCacheCapacity];
+        }
     }
     return self;
 }
@@ -76,18 +93,86 @@
     [self.delegate urlActionHelper:self
             workingDirectoryOnLine:coord.y
                         completion:^(NSString *workingDirectory) {
-        [iTermURLActionFactory urlActionAtCoord:coord
-                            respectHardNewlines:respectHardNewlines
-                               workingDirectory:workingDirectory ?: @""
-                                     remoteHost:[self.delegate urlActionHelper:self remoteHostOnLine:coord.y]
-                                      selectors:[self.delegate urlActionHelperSmartSelectionActionSelectorDictionary:self]
-                                          rules:[self.delegate urlActionHelperSmartSelectionRules:self]
-                                      extractor:extractor
-                      semanticHistoryController:self.semanticHistoryController
-                                    pathFactory:^SCPPath *(NSString *path, int line) {
-                                        return [self.delegate urlActionHelper:self secureCopyPathForFile:path onLine:line];
-                                    }
-                                     completion:completion];
+        NSArray *rules = [self.delegate urlActionHelperSmartSelectionRules:self];
+        void (^evaluate)(void (^)(URLAction *)) = ^(void (^evaluateCompletion)(URLAction *)) {
+            [iTermURLActionFactory urlActionAtCoord:coord
+                                respectHardNewlines:respectHardNewlines
+                                   workingDirectory:workingDirectory ?: @""
+                                         remoteHost:[self.delegate urlActionHelper:self remoteHostOnLine:coord.y]
+                                          selectors:[self.delegate urlActionHelperSmartSelectionActionSelectorDictionary:self]
+                                              rules:rules
+                                          extractor:extractor
+                          semanticHistoryController:self.semanticHistoryController
+                                        pathFactory:^SCPPath *(NSString *path, int line) {
+                                            return [self.delegate urlActionHelper:self secureCopyPathForFile:path onLine:line];
+                                        }
+                                         completion:evaluateCompletion];
+        };
+        if (!self->_cache) {
+            evaluate(completion);
+            return;
+        }
+        iTermURLActionCacheKey *key = [self cacheKeyForCoord:coord
+                                                   extractor:extractor
+                                         respectHardNewlines:respectHardNewlines
+                                            workingDirectory:workingDirectory ?: @""
+                                                       rules:rules];
+        [self->_cache actionForKey:key
+                               now:[NSDate it_timeSinceBoot]
+                          evaluate:evaluate
+                        completion:completion];
+    }];
+}
+
+- (void)prefetchPathsOnLines:(VT100GridRange)lines {
+    if (!_cache || lines.length <= 0) {
+        return;
+    }
+    const long long overflow = [self.delegate urlActionTotalScrollbackOverflow:self];
+    const NSTimeInterval now = [NSDate it_timeSinceBoot];
+    if (VT100GridRangeEqualsRange(lines, _lastPrefetchRange) &&
+        overflow == _lastPrefetchOverflow &&
+        now - _lastPrefetchTime < iTermURLActionHelperPrefetchInterval) {
+        return;
+    }
+    _lastPrefetchRange = lines;
+    _lastPrefetchOverflow = overflow;
+    _lastPrefetchTime = now;
+
+    iTermTextExtractor *extractor = [self.delegate urlActionHelperNewTextExtractor:self];
+    const int width = [extractor.dataSource width];
+    const VT100GridWindowedRange range =
+        VT100GridWindowedRangeMake(VT100GridCoordRangeMake(0, lines.location, width, VT100GridRangeMax(lines)), 0, 0);
+    NSString *text = [extractor contentInRange:range
+                             attributeProvider:nil
+                                    nullPolicy:kiTermTextExtractorNullPolicyMidlineAsSpaceIgnoreTerminal
+                                           pad:NO
+                            includeLastNewline:NO
+                        trimTrailingWhitespace:YES
+                                  cappedAtSize:-1
+                                  truncateTail:YES
+                             continuationChars:nil
+                                        coords:nil];
+    NSArray<NSString *> *tokens = [iTermURLActionCache pathLikeTokensInString:text];
+    if (tokens.count == 0) {
+        return;
+    }
+    [self.delegate urlActionHelper:self
+            workingDirectoryOnLine:VT100GridRangeMax(lines)
+                        completion:^(NSString *workingDirectory) {
+        NSMutableArray<NSString *> *paths = [NSMutableArray array];
+        for (NSString *token in tokens) {
+            NSString *path = [token stringByExpandingTildeInPath];
+            if (![path hasPrefix:@"/"]) {
+                if (!workingDirectory.length) {
+                    continue;
+                }
+                path = [workingDirectory stringByAppendingPathComponent:path];
+            }
+            [paths addObject:path];
+        }
+        [[iTermCachingFileManager cachingFileManager] prefetchExistenceOfPaths:paths
+                                                                 pathsToIgnore:[[iTermAdvancedSettingsModel pathsToIgnore] componentsSeparatedByString:@","]];
     }];
 }
 
@@ -215,6 +300,33 @@
     [self.delegate urlActionHelperCopySelectionIfNeeded:self];
 }
 
+#pragma mark - URL Action Cache
+
+// The URL action depends on the text within maxSemanticHistoryPrefixOrSuffix characters of the
+// coord, and smart selection looks at least two lines away.
+- (iTermURLActionCacheKey *)cacheKeyForCoord:(VT100GridCoord)coord
+                                   extractor:(iTermTextExtractor *)extractor
+                         respectHardNewlines:(BOOL)respectHardNewlines
+                            workingDirectory:(NSString *)workingDirectory
+                                       rules:(NSArray *)rules {
+    const int width = MAX(1, [extractor.dataSource width]);
+    const int radius = MAX(2, [iTermAdvancedSettingsModel maxSemanticHistoryPrefixOrSuffix] / width + 1);
+    const int firstLine = MAX(0, coord.y - radius);
+    const int lastLine = MIN([extractor.dataSource numberOfLines] - 1, coord.y + radius);
+    NSMutableData *generations = [NSMutableData dataWithCapacity:MAX(0, lastLine - firstLine + 1) * sizeof(NSInteger)];
+    for (int y = firstLine; y <= lastLine; y++) {
+        const NSInteger generation = [self.delegate urlActionHelper:self generationForLine:y];
+        [generations appendBytes:&generation length:sizeof(generation)];
+    }
+    return [[iTermURLActionCacheKey alloc] initWithAbsLine:coord.y + [extractor.dataSource totalScrollbackOverflow]
+                                                    column:coord.x
+                                              columnWindow:extractor.logicalWindow
+                                       respectHardNewlines:respectHardNewlines
+                                           lineGenerations:generations
+                                          workingDirectory:workingDirectory
+                                                     rules:rules];
+}
+
 #pragma mark - Open Target
 
 // If iTerm2 is the handler for the scheme, then the profile is launched directly.
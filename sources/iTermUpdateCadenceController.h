@@ -20,6 +20,10 @@ typedef struct {
     NSInteger adaptiveFrameRateThroughputThreshold;
     double slowFrameRate;
     BOOL liveResizing;
+    // Is the session in the key window?
+    BOOL key;
+    // Is the session's window completely covered or offscreen?
+    BOOL occluded;
 } iTermUpdateCadenceState;
 
 @protocol iTermUpdateCadenceControllerDelegate<NSObject>
@@ -53,4 +57,8 @@ typedef struct {
 - (void)didHandleInput;
 - (void)didHandleKeystroke;
 
+// Measurements of main thread work, which decide when to redraw less during bulk output.
+- (void)didParseBytes:(NSInteger)count duration:(NSTimeInterval)duration;
+- (void)didDrawFrameWithDuration:(NSTimeInterval)duration;
+
 @end
@@ -11,9 +11,12 @@
 #import "DebugLogging.h"
 #import "NSTimer+iTerm.h"
 #import "iTermAdvancedSettingsModel.h"
+#import "iTermFrameScheduler.h"
 #import "iTermHistogram.h"
 #import "iTermThroughputEstimator.h"
+#import "iTermThroughputRefreshController.h"
 #import "iTermWarning.h"
+#import "iTermWindowOcclusionChangeMonitor.h"
 
 // Timer period between updates when adaptive frame rate is enabled and throughput is low but not 0.
 static const NSTimeInterval kFastUpdateCadence = 1.0 / 60.0;
@@ -23,8 +26,14 @@ static const NSTimeInterval kFastUpdateCadence = 1.0 / 60.0;
 // TODO(georgen): There's room for improvement here.
 static const NSTimeInterval kBackgroundUpdateCadence = 1;
 
+@interface iTermUpdateCadenceController()<iTermFrameSchedulerClient>
+@end
 
 @implementation iTermUpdateCadenceController {
+    // If set, updates come from the shared iTermFrameScheduler, which coalesces them with other
+    // sessions' updates, rather than a timer of our own.
+    BOOL _useFrameScheduler;
+    iTermFrameSchedulerPriority _priority;
     BOOL _useGCDUpdateTimer;
     // This timer fires periodically to redraw textview, update the scroll position, tab appearance,
     // etc.
@@ -44,25 +53,40 @@ static const NSTimeInterval kBackgroundUpdateCadence = 1;
     NSTimeInterval _activeUpdateCadence;
 
     CFTimeInterval _lastKeystrokeTime;
+
+    // Decides when output is heavy enough to redraw less often than the slow frame rate. Nil if
+    // disabled.
+    iTermThroughputRefreshController *_refreshController;
 }
 
 - (instancetype)initWithThroughputEstimator:(iTermThroughputEstimator *)throughputEstimator {
     self = [super init];
     if (self) {
+        _useFrameScheduler = [iTermAdvancedSettingsModel useFrameScheduler];
         _useGCDUpdateTimer = [iTermAdvancedSettingsModel useGCDUpdateTimer];
         _throughputEstimator = throughputEstimator;
         _histogram = [[iTermHistogram alloc] init];
         _activeUpdateCadence = 1.0 / MAX(1, [iTermAdvancedSettingsModel activeUpdateCadence]);
+        if ([iTermAdvancedSettingsModel reduceRefreshForBulkOutput]) {
+            _refreshController = [[iTermThroughputRefreshController alloc] init];
+        }
         [[NSNotificationCenter defaultCenter] addObserver:self
                                                  selector:@selector(applicationDidBecomeActive:)
                                                      name:NSApplicationDidBecomeActiveNotification
                                                    object:nil];
+        [[NSNotificationCenter defaultCenter] addObserver:self
+                                                 selector:@selector(windowOcclusionDidChange:)
+                                                     name:iTermWindowOcclusionDidChange
+                                                   object:nil];
     }
     return self;
 }
 
 - (void)dealloc {
     [[NSNotificationCenter defaultCenter] removeObserver:self];
+    if (_useFrameScheduler) {
+        [[iTermFrameScheduler sharedInstance] removeClient:self];
+    }
     if (_gcdUpdateTimer != nil) {
         dispatch_source_cancel(_gcdUpdateTimer);
     }
@@ -97,6 +121,20 @@ static const NSTimeInterval kBackgroundUpdateCadence = 1;
 
 - (void)didHandleKeystroke {
     _lastKeystrokeTime = CACurrentMediaTime();
+    const BOOL wasBulk = _refreshController.bulkOutput;
+    [_refreshController didHandleKeystrokeAt:_lastKeystrokeTime];
+    if (wasBulk) {
+        // Snap back to the normal frame rate so the keystroke's effect shows up promptly.
+        [self changeCadenceIfNeeded:YES];
+    }
+}
+
+- (void)didParseBytes:(NSInteger)count duration:(NSTimeInterval)duration {
+    [_refreshController didParseBytes:count duration:duration];
+}
+
+- (void)didDrawFrameWithDuration:(NSTimeInterval)duration {
+    [_refreshController didDrawFrameWithDuration:duration];
 }
 
 - (void)willStartLiveResize {
@@ -106,7 +144,7 @@ static const NSTimeInterval kBackgroundUpdateCadence = 1;
 }
 
 - (void)liveResizeDidEnd {
-    if (_useGCDUpdateTimer) {
+    if (_useFrameScheduler || _useGCDUpdateTimer) {
         NSTimeInterval cadence = _cadence;
         _cadence = 0;
         [self setUpdateCadence:cadence liveResizing:NO force:NO];
@@ -145,6 +183,7 @@ static const NSTimeInterval kBackgroundUpdateCadence = 1;
     // idle means no input has been received on the PTY in a while (3 seconds by default).
     // assignment to self.isActive is used to update whether Metal is in use, when it's disabled while idle.
     self.isActive = (state.active || !state.idle);
+    _priority = [self priorityForState:state];
 
     if (!self.isActive) {
         // Periodic redraws not needed (i.e., nothing is blinking) and the session is idle. It doesn't matter
@@ -171,6 +210,14 @@ static const NSTimeInterval kBackgroundUpdateCadence = 1;
     // Adaptive framerate path - the session is active and visible
     const NSInteger kThroughputLimit = state.adaptiveFrameRateThroughputThreshold;
     const NSInteger estimatedThroughput = [_throughputEstimator estimatedThroughput];
+    const NSTimeInterval bulkPeriod = [_refreshController bulkPeriodForThroughput:estimatedThroughput
+                                                                    minimumPeriod:1.0 / state.slowFrameRate
+                                                                              now:CACurrentMediaTime()];
+    if (bulkPeriod > 0) {
+        DLog(@"select bulk output cadence of %@", @(bulkPeriod));
+        [self setUpdateCadence:bulkPeriod liveResizing:state.liveResizing force:force];
+        return;
+    }
     if (estimatedThroughput < kThroughputLimit && estimatedThroughput > 0) {
         DLog(@"select fast cadence");
         [self setUpdateCadence:kFastUpdateCadence liveResizing:state.liveResizing force:force];
@@ -180,8 +227,23 @@ static const NSTimeInterval kBackgroundUpdateCadence = 1;
     }
 }
 
+- (iTermFrameSchedulerPriority)priorityForState:(iTermUpdateCadenceState)state {
+    if (!self.isActive || !state.visible) {
+        return iTermFrameSchedulerPriorityBackground;
+    }
+    if (state.occluded && !state.liveResizing) {
+        return iTermFrameSchedulerPriorityOccluded;
+    }
+    if (state.key) {
+        return iTermFrameSchedulerPriorityKeyWindow;
+    }
+    return iTermFrameSchedulerPriorityVisible;
+}
+
 - (void)setUpdateCadence:(NSTimeInterval)cadence liveResizing:(BOOL)liveResizing force:(BOOL)force {
-    if (_useGCDUpdateTimer) {
+    if (_useFrameScheduler) {
+        [self setScheduledUpdateCadence:cadence liveResizing:liveResizing force:force];
+    } else if (_useGCDUpdateTimer) {
         [self setGCDUpdateCadence:cadence liveResizing:liveResizing force:force];
     } else {
         [self setTimerUpdateCadence:cadence liveResizing:liveResizing force:force];
@@ -258,8 +320,36 @@ static const NSTimeInterval kBackgroundUpdateCadence = 1;
     dispatch_resume(_gcdUpdateTimer);
 }
 
+- (void)setScheduledUpdateCadence:(NSTimeInterval)cadence liveResizing:(BOOL)liveResizing force:(BOOL)force {
+    const NSTimeInterval period = liveResizing ? _activeUpdateCadence : cadence;
+    iTermFrameScheduler *scheduler = [iTermFrameScheduler sharedInstance];
+    if (_cadence == period && [scheduler hasClient:self]) {
+        // The priority may have changed even though the period didn't.
+        [scheduler setPeriod:period priority:_priority forClient:self];
+        return;
+    }
+    DLog(@"Set cadence of %@ to %f", self, cadence);
+
+    if (!force && _cadence > 0 && cadence > _cadence) {
+        // As with the GCD timer, let the screen draw before slowing down.
+        DLog(@"Defer cadence change");
+        _deferredCadenceChange = YES;
+        return;
+    }
+
+    _cadence = period;
+    [scheduler setPeriod:period priority:_priority forClient:self];
+}
+
+- (void)frameSchedulerDidTick {
+    DLog(@"Frame scheduler ticked for %@", self);
+    [self maybeUpdateDisplay];
+}
+
 - (BOOL)updateTimerIsValid {
-    if (_useGCDUpdateTimer) {
+    if (_useFrameScheduler) {
+        return [[iTermFrameScheduler sharedInstance] hasClient:self];
+    } else if (_useGCDUpdateTimer) {
         return _gcdUpdateTimer != nil;
     } else {
         return _updateTimer.isValid;
@@ -287,6 +377,10 @@ static const NSTimeInterval kBackgroundUpdateCadence = 1;
     [_delegate updateCadenceControllerUpdateDisplay:self];
 }
 
+- (void)windowOcclusionDidChange:(NSNotification *)notification {
+    [self changeCadenceIfNeeded];
+}
+
 - (void)applicationDidBecomeActive:(NSNotification *)notification {
     _histogram = [[iTermHistogram alloc] init];
     _lastUpdate = 0;
@@ -328,6 +328,10 @@ NSString *const iTermVariableKeyWindowNumber = @"number";
 }
 
 - (void)didChangeTerminalValueWithPath:(NSString *)name {
+    if (!_resolvedLinks[name] && !_unresolvedLinks[name]) {
+        // Nothing refers to it, as is the case for most variables.
+        return;
+    }
     NSArray<id<iTermVariableReference>> *refs = [self strongArrayFromWeakArray:_resolvedLinks[name]];
     for (id<iTermVariableReference> ref in refs) {
         [ref valueDidChange];
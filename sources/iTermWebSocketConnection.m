@@ -260,7 +260,7 @@ typedef NS_ENUM(NSUInteger, iTermWebSocketConnectionState) {
 - (void)reallySendBinary:(NSData *)binaryData {
     if (_state == iTermWebSocketConnectionStateOpen) {
         DLog(@"Sending binary frame");
-        [self sendFrame:[iTermWebSocketFrame binaryFrameWithData:binaryData]];
+        [self sendPayload:binaryData opcode:iTermWebSocketOpcodeBinary];
     } else {
         DLog(@"Not sending binary frame because not open");
     }
@@ -291,16 +291,32 @@ typedef NS_ENUM(NSUInteger, iTermWebSocketConnectionState) {
 // queue
 - (void)sendFrame:(iTermWebSocketFrame *)frame {
     DLog(@"Send frame %@", frame);
-    [self sendData:frame.data];
+    [self sendPayload:frame.payload opcode:frame.opcode];
 }
 
 // queue
-- (void)sendData:(NSData *)data {
-    dispatch_data_t dispatchData = dispatch_data_create(data.bytes, data.length, _queue, ^{
+- (void)sendPayload:(NSData *)payload opcode:(iTermWebSocketOpcode)opcode {
+    NSData *header = [iTermWebSocketFrame headerForFinalFrameWithOpcode:opcode
+                                                          payloadLength:payload.length];
+    // Concatenating dispatch data doesn't copy. The channel writes the header and payload with
+    // a single vectored write.
+    [self sendDispatchData:dispatch_data_create_concat([self dispatchDataWithData:header],
+                                                       [self dispatchDataWithData:payload])];
+}
+
+// queue
+- (dispatch_data_t)dispatchDataWithData:(NSData *)data {
+    if (data.length == 0) {
+        return dispatch_data_empty;
+    }
+    return dispatch_data_create(data.bytes, data.length, _queue, ^{
         DLog(@"Disposing of data %p", data);
         [data length];  // Keep a reference to data
     });
+}
 
+// queue
+- (void)sendDispatchData:(dispatch_data_t)dispatchData {
     __weak __typeof(self) weakSelf = self;
     dispatch_io_write(_channel, 0, dispatchData, _queue, ^(bool done, dispatch_data_t  _Nullable data, int error) {
         DLog(@"Write progress: done=%d error=%d", (int)done, (int)error);
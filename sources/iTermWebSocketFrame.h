@@ -55,6 +55,17 @@ typedef NS_ENUM(int, iTermWebSocketOpcode) {
 + (instancetype)binaryFrameWithData:(NSData *)data;
 + (instancetype)frameWithDataSource:(unsigned char *(^)(int64_t))dataSource;
 
+// Parses a frame that begins at |offset| in |buffer|. Returns nil if |buffer| does not yet hold
+// the whole frame; otherwise *consumedPtr is set to the frame's size. The payload is unmasked in
+// place and refers to |buffer|'s bytes without copying, so |buffer| must not be modified later.
++ (instancetype)frameByParsingBuffer:(NSMutableData *)buffer
+                              offset:(NSUInteger)offset
+                            consumed:(NSUInteger *)consumedPtr;
+
+// Returns the header of an unmasked, unfragmented frame. Send it followed by the payload.
++ (NSData *)headerForFinalFrameWithOpcode:(iTermWebSocketOpcode)opcode
+                            payloadLength:(uint64_t)payloadLength;
+
 // Valid if opcode is ConnectionClose
 - (uint16_t)closeFrameCode;
 - (NSString *)closeFrameReason;
@@ -62,3 +73,6 @@ typedef NS_ENUM(int, iTermWebSocketOpcode) {
 - (BOOL)appendFragment:(iTermWebSocketFrame *)fragment;
 
 @end
+
+// XORs |length| bytes with the repeating four-byte masking key. Exposed for testing.
+void iTermWebSocketFrameUnmask(unsigned char *bytes, NSUInteger length, const unsigned char maskingKey[4]);
@@ -9,6 +9,28 @@
 #import "iTermWebSocketFrame.h"
 #import "DebugLogging.h"
 
+#import <simd/simd.h>
+
+void iTermWebSocketFrameUnmask(unsigned char *bytes, NSUInteger length, const unsigned char maskingKey[4]) {
+    NSUInteger i = 0;
+    if (length >= sizeof(simd_uchar16)) {
+        simd_uchar16 mask;
+        for (int j = 0; j < sizeof(mask); j++) {
+            mask[j] = maskingKey[j & 3];
+        }
+        // i stays a multiple of 16 so the key stays in phase for the scalar tail.
+        for (; i + sizeof(mask) <= length; i += sizeof(mask)) {
+            simd_uchar16 vector;
+            memcpy(&vector, bytes + i, sizeof(vector));
+            vector ^= mask;
+            memcpy(bytes + i, &vector, sizeof(vector));
+        }
+    }
+    for (; i < length; i++) {
+        bytes[i] ^= maskingKey[i & 3];
+    }
+}
+
 @interface iTermWebSocketFrame()
 @property (nonatomic, readwrite) BOOL fin;
 @property (nonatomic, readwrite) iTermWebSocketOpcode opcode;
@@ -143,15 +165,96 @@
         return nil;
     }
     if (mask) {
-        for (int i = 0; i < payloadLength; i++) {
-            data[i] ^= maskingKey[i & 3];
-        }
+        iTermWebSocketFrameUnmask(data, payloadLength, maskingKey);
     }
     frame.payload = [NSData dataWithBytes:data length:payloadLength];
 
     return frame;
 }
 
++ (instancetype)frameByParsingBuffer:(NSMutableData *)buffer
+                              offset:(NSUInteger)offset
+                            consumed:(NSUInteger *)consumedPtr {
+    unsigned char *const start = (unsigned char *)buffer.mutableBytes + offset;
+    const NSUInteger available = buffer.length - offset;
+    NSUInteger headerLength = 2;
+    if (available < headerLength) {
+        return nil;
+    }
+    const BOOL mask = !!(start[1] & 0x80);
+    uint64_t payloadLength = (start[1] & 0x7f);
+    if (payloadLength == 126) {
+        headerLength += 2;
+        if (available < headerLength) {
+            return nil;
+        }
+        uint16_t networkLength;
+        memmove(&networkLength, start + 2, sizeof(networkLength));
+        payloadLength = ntohs(networkLength);
+    } else if (payloadLength == 127) {
+        headerLength += 8;
+        if (available < headerLength) {
+            return nil;
+        }
+        uint64_t networkLength;
+        memmove(&networkLength, start + 2, sizeof(networkLength));
+        payloadLength = ntohll(networkLength);
+    }
+    unsigned char maskingKey[4] = { 0 };
+    if (mask) {
+        if (available < headerLength + 4) {
+            return nil;
+        }
+        memmove(maskingKey, start + headerLength, 4);
+        headerLength += 4;
+    }
+    if (payloadLength > available - headerLength) {
+        return nil;
+    }
+
+    iTermWebSocketFrame *frame = [[iTermWebSocketFrame alloc] init];
+    frame.fin = !!(start[0] & 0x80);
+    frame.opcode = (start[0] & 0x0f);
+    unsigned char *payload = start + headerLength;
+    if (mask) {
+        iTermWebSocketFrameUnmask(payload, payloadLength, maskingKey);
+    }
+    // Keep the buffer alive for as long as the payload is around instead of copying it out.
+    frame->_payload = [[NSData alloc] initWithBytesNoCopy:payload
+                                                   length:payloadLength
+                                              deallocator:^(void *bytes, NSUInteger length) {
+        [buffer length];
+    }];
+    *consumedPtr = headerLength + payloadLength;
+    DLog(@"Parsed %@", frame);
+    return frame;
+}
+
++ (NSData *)headerForFinalFrameWithOpcode:(iTermWebSocketOpcode)opcode
+                            payloadLength:(uint64_t)payloadLength {
+    uint8_t bytes[10];
+    NSUInteger length = 0;
+    bytes[length++] = 0x80 | (opcode & 0x0f);
+
+    // We're a server so we never mask outgoing data. Mask bit won't get set here (would go in
+    // high bit of the second byte).
+    if (payloadLength <= 125) {
+        bytes[length++] = payloadLength;
+    } else if (payloadLength <= 0xffff) {
+        bytes[length++] = 126;
+        const uint16_t networkLength = htons(payloadLength);
+        memmove(bytes + length, &networkLength, sizeof(networkLength));
+        length += sizeof(networkLength);
+    } else {
+        bytes[length++] = 127;
+        const uint64_t networkLength = htonll(payloadLength);
+        memmove(bytes + length, &networkLength, sizeof(networkLength));
+        length += sizeof(networkLength);
+    }
+    // Do not encode masking key since we're a server.
+    return [NSData dataWithBytes:bytes length:length];
+}
+
 - (NSString *)description {
     NSString *opcode;
     switch (_opcode) {
@@ -196,41 +299,8 @@
     }
     if (!_data) {
         DLog(@"Encoding frame %@", self);
-        NSMutableData *data = [NSMutableData data];
-        uint8_t byte = 0;
-        if (self.fin) {
-            DLog(@"Set fin bit");
-            byte |= 0x80;
-        }
-        byte |= (self.opcode & 0x0f);
-        [data appendBytes:&byte length:1];
-
-        byte = 0;
-        // We're a server so we never mask outgoing data. Mask bit won't get set here (would go in
-        // high bit of 'byte').
-        if (self.payload.length <= 125) {
-            DLog(@"Payload is short so using 1 byte encoding");
-            byte = self.payload.length;
-            [data appendBytes:&byte length:1];
-        } else if (self.payload.length <= 0xffff) {
-            DLog(@"Medium length payload, using 3 byte encoding");
-            byte = 126;
-            [data appendBytes:&byte length:1];
-
-            uint16_t payloadLength = htons(self.payload.length);
-            [data appendBytes:&payloadLength length:sizeof(payloadLength)];
-        } else {
-            DLog(@"Long payload, using 9 byte encoding");
-            byte = 127;
-            [data appendBytes:&byte length:1];
-
-            uint64_t payloadLength = htonll(self.payload.length);
-            [data appendBytes:&payloadLength length:sizeof(payloadLength)];
-        }
-        DLog(@"Frame without payload: %@", data);
-
-        // Do not encode masking key since we're a server.
-
+        NSMutableData *data = [[iTermWebSocketFrame headerForFinalFrameWithOpcode:self.opcode
+                                                                    payloadLength:self.payload.length] mutableCopy];
         [data appendData:self.payload];
         _data = data;
     }
@@ -266,7 +336,7 @@
         XLog(@"Fragment opcode not continuation");
         return NO;
     }
-    if (!self.fin) {
+    if (self.fin) {
         XLog(@"Appending fragment to finished frame");
         return NO;
     }
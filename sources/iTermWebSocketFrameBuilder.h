@@ -11,5 +11,7 @@
 @class iTermWebSocketFrame;
 
 @interface iTermWebSocketFrameBuilder : NSObject
-- (void)addData:(NSData *)data frame:(void (^)(iTermWebSocketFrame *, BOOL *))frameBlock;
+// Takes ownership of |data|: masked payloads are unmasked in place and frames refer to its bytes
+// rather than copies of them. Do not modify it after calling this.
+- (void)addData:(NSMutableData *)data frame:(void (^)(iTermWebSocketFrame *, BOOL *))frameBlock;
 @end
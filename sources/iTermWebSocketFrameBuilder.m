@@ -10,66 +10,71 @@
 #import "iTermWebSocketFrame.h"
 
 @implementation iTermWebSocketFrameBuilder {
-    NSMutableData *_data;
+    // Holds the start of a frame that hasn't been fully received yet. No frame refers to it, so
+    // it's safe to append to.
+    NSMutableData *_pending;
     iTermWebSocketFrame *_fragment;
 }
 
-- (instancetype)init {
-    self = [super init];
-    if (self) {
-        _data = [[NSMutableData alloc] init];
+- (void)addData:(NSMutableData *)data frame:(void (^)(iTermWebSocketFrame *, BOOL *))frameBlock {
+    NSMutableData *buffer = data;
+    if (_pending.length) {
+        // Only bytes that complete a frame split across reads get copied.
+        [_pending appendData:data];
+        buffer = _pending;
     }
-    return self;
-}
-
-- (void)addData:(NSData *)data frame:(void (^)(iTermWebSocketFrame *, BOOL *))frameBlock {
-    [_data appendData:data];
+    _pending = nil;
 
-    __block int64_t offset = 0;
-    __block BOOL eof = NO;
-    while (!eof) {
-        iTermWebSocketFrame *frame = [iTermWebSocketFrame frameWithDataSource:^unsigned char *(int64_t bytesWanted) {
-            if (self->_data.length < offset + bytesWanted) {
-                eof = YES;
-                return NULL;
-            } else {
-                unsigned char *result = self->_data.mutableBytes + offset;
-                offset += bytesWanted;
-                return result;
-            }
-        }];
-        if (!eof) {
-            [_data replaceBytesInRange:NSMakeRange(0, offset) withBytes:"" length:0];
-            offset = 0;
+    NSUInteger offset = 0;
+    while (YES) {
+        NSUInteger consumed = 0;
+        iTermWebSocketFrame *frame = [iTermWebSocketFrame frameByParsingBuffer:buffer
+                                                                        offset:offset
+                                                                      consumed:&consumed];
+        if (!frame) {
+            [self savePendingBytesFromBuffer:buffer offset:offset];
+            return;
         }
-        if (frame) {
-            if (_fragment) {
-                if (![_fragment appendFragment:frame]) {
-                    BOOL stop = NO;
-                    frameBlock(NULL, &stop);
+        offset += consumed;
+        if (_fragment) {
+            if (![_fragment appendFragment:frame]) {
+                BOOL stop = NO;
+                frameBlock(NULL, &stop);
+                return;
+            }
+            if (_fragment.fin) {
+                BOOL stop = NO;
+                frameBlock(_fragment, &stop);
+                _fragment = nil;
+                if (stop) {
                     return;
                 }
-                if (_fragment.fin) {
-                    BOOL stop = NO;
-                    frameBlock(_fragment, &stop);
-                    _fragment = nil;
-                    if (stop) {
-                        return;
-                    }
+            }
+        } else {
+            if (frame.fin) {
+                BOOL stop = NO;
+                frameBlock(frame, &stop);
+                if (stop) {
+                    return;
                 }
             } else {
-                if (frame.fin) {
-                    BOOL stop = NO;
-                    frameBlock(frame, &stop);
-                    if (stop) {
-                        return;
-                    }
-                } else {
-                    _fragment = frame;
-                }
+                _fragment = frame;
             }
         }
     }
 }
 
+- (void)savePendingBytesFromBuffer:(NSMutableData *)buffer offset:(NSUInteger)offset {
+    if (offset == buffer.length) {
+        return;
+    }
+    if (offset == 0) {
+        // Nothing refers to the buffer yet, so adopt it rather than copying.
+        _pending = buffer;
+        return;
+    }
+    _pending = [NSMutableData dataWithBytes:(unsigned char *)buffer.mutableBytes + offset
+                                     length:buffer.length - offset];
+}
+
 @end
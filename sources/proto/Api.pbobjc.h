@@ -65,6 +65,8 @@ CF_EXTERN_C_BEGIN
 @class ITMGetPromptResponse;
 @class ITMGetPropertyRequest;
 @class ITMGetPropertyResponse;
+@class ITMGetScrollbackRequest;
+@class ITMGetScrollbackResponse;
 @class ITMInjectRequest;
 @class ITMInjectResponse;
 @class ITMInvokeFunctionRequest;
@@ -808,6 +810,24 @@ GPBEnumDescriptor *ITMGetBufferResponse_Status_EnumDescriptor(void);
  **/
 BOOL ITMGetBufferResponse_Status_IsValidValue(int32_t value);
 
+#pragma mark - Enum ITMGetScrollbackResponse_Status
+
+typedef GPB_ENUM(ITMGetScrollbackResponse_Status) {
+  ITMGetScrollbackResponse_Status_Ok = 0,
+  ITMGetScrollbackResponse_Status_SessionNotFound = 1,
+
+  /** The cursor is after the end of the buffer. */
+  ITMGetScrollbackResponse_Status_InvalidCursor = 2,
+};
+
+GPBEnumDescriptor *ITMGetScrollbackResponse_Status_EnumDescriptor(void);
+
+/**
+ * Checks to see if the given value is defined by the enum or was not known at
+ * the time this source was generated.
+ **/
+BOOL ITMGetScrollbackResponse_Status_IsValidValue(int32_t value);
+
 #pragma mark - Enum ITMGetPromptResponse_Status
 
 typedef GPB_ENUM(ITMGetPromptResponse_Status) {
@@ -1061,6 +1081,7 @@ typedef GPB_ENUM(ITMClientOriginatedMessage_FieldNumber) {
   ITMClientOriginatedMessage_FieldNumber_CloseRequest = 131,
   ITMClientOriginatedMessage_FieldNumber_InvokeFunctionRequest = 132,
   ITMClientOriginatedMessage_FieldNumber_ListPromptsRequest = 133,
+  ITMClientOriginatedMessage_FieldNumber_GetScrollbackRequest = 134,
 };
 
 typedef GPB_ENUM(ITMClientOriginatedMessage_Submessage_OneOfCase) {
@@ -1099,6 +1120,7 @@ typedef GPB_ENUM(ITMClientOriginatedMessage_Submessage_OneOfCase) {
   ITMClientOriginatedMessage_Submessage_OneOfCase_CloseRequest = 131,
   ITMClientOriginatedMessage_Submessage_OneOfCase_InvokeFunctionRequest = 132,
   ITMClientOriginatedMessage_Submessage_OneOfCase_ListPromptsRequest = 133,
+  ITMClientOriginatedMessage_Submessage_OneOfCase_GetScrollbackRequest = 134,
 };
 
 /**
@@ -1180,6 +1202,8 @@ typedef GPB_ENUM(ITMClientOriginatedMessage_Submessage_OneOfCase) {
 
 @property(nonatomic, readwrite, strong, null_resettable) ITMListPromptsRequest *listPromptsRequest;
 
+@property(nonatomic, readwrite, strong, null_resettable) ITMGetScrollbackRequest *getScrollbackRequest;
+
 @end
 
 /**
@@ -1226,6 +1250,7 @@ typedef GPB_ENUM(ITMServerOriginatedMessage_FieldNumber) {
   ITMServerOriginatedMessage_FieldNumber_CloseResponse = 131,
   ITMServerOriginatedMessage_FieldNumber_InvokeFunctionResponse = 132,
   ITMServerOriginatedMessage_FieldNumber_ListPromptsResponse = 133,
+  ITMServerOriginatedMessage_FieldNumber_GetScrollbackResponse = 134,
   ITMServerOriginatedMessage_FieldNumber_Notification = 1000,
 };
 
@@ -1266,6 +1291,7 @@ typedef GPB_ENUM(ITMServerOriginatedMessage_Submessage_OneOfCase) {
   ITMServerOriginatedMessage_Submessage_OneOfCase_CloseResponse = 131,
   ITMServerOriginatedMessage_Submessage_OneOfCase_InvokeFunctionResponse = 132,
   ITMServerOriginatedMessage_Submessage_OneOfCase_ListPromptsResponse = 133,
+  ITMServerOriginatedMessage_Submessage_OneOfCase_GetScrollbackResponse = 134,
   ITMServerOriginatedMessage_Submessage_OneOfCase_Notification = 1000,
 };
 
@@ -1352,6 +1378,8 @@ typedef GPB_ENUM(ITMServerOriginatedMessage_Submessage_OneOfCase) {
 
 @property(nonatomic, readwrite, strong, null_resettable) ITMListPromptsResponse *listPromptsResponse;
 
+@property(nonatomic, readwrite, strong, null_resettable) ITMGetScrollbackResponse *getScrollbackResponse;
+
 /** This is the only response that is sent spontaneously. The 'id' field will not be set. */
 @property(nonatomic, readwrite, strong, null_resettable) ITMNotification *notification;
 
@@ -4281,6 +4309,88 @@ typedef GPB_ENUM(ITMGetBufferResponse_FieldNumber) {
 
 @end
 
+#pragma mark - ITMGetScrollbackRequest
+
+typedef GPB_ENUM(ITMGetScrollbackRequest_FieldNumber) {
+  ITMGetScrollbackRequest_FieldNumber_Session = 1,
+  ITMGetScrollbackRequest_FieldNumber_Cursor = 2,
+  ITMGetScrollbackRequest_FieldNumber_MaxLines = 3,
+  ITMGetScrollbackRequest_FieldNumber_TextOnly = 4,
+};
+
+/**
+ * Requests a chunk of scrollback history and screen contents. Unlike GetBufferRequest, this
+ * is meant for exporting large amounts of history: each response holds a bounded number of
+ * lines and names the line at which the next request should begin. The work is done off the
+ * main thread on a snapshot of the session, so it does not block other requests.
+ **/
+@interface ITMGetScrollbackRequest : GPBMessage
+
+/** See documentation on session IDs. "all" not accepted. */
+@property(nonatomic, readwrite, copy, null_resettable) NSString *session;
+/** Test to see if @c session has been set. */
+@property(nonatomic, readwrite) BOOL hasSession;
+
+/**
+ * The absolute line number (as in a Coord's y) of the first line to return. If unset, begins
+ * at the oldest line still available. Lines that have been lost from the head of history are
+ * skipped; check `first_line` in the response to detect this.
+ **/
+@property(nonatomic, readwrite) int64_t cursor;
+
+@property(nonatomic, readwrite) BOOL hasCursor;
+/**
+ * The maximum number of lines to return. If unset or out of range, a reasonable default is
+ * used. Capped at 10,000.
+ **/
+@property(nonatomic, readwrite) int32_t maxLines;
+
+@property(nonatomic, readwrite) BOOL hasMaxLines;
+/**
+ * If true, only `text` and `continuation` are filled in for each line. This is faster and
+ * produces a smaller response.
+ **/
+@property(nonatomic, readwrite) BOOL textOnly;
+
+@property(nonatomic, readwrite) BOOL hasTextOnly;
+@end
+
+#pragma mark - ITMGetScrollbackResponse
+
+typedef GPB_ENUM(ITMGetScrollbackResponse_FieldNumber) {
+  ITMGetScrollbackResponse_FieldNumber_Status = 1,
+  ITMGetScrollbackResponse_FieldNumber_ContentsArray = 2,
+  ITMGetScrollbackResponse_FieldNumber_FirstLine = 3,
+  ITMGetScrollbackResponse_FieldNumber_NextCursor = 4,
+  ITMGetScrollbackResponse_FieldNumber_EndOfBuffer = 5,
+};
+
+@interface ITMGetScrollbackResponse : GPBMessage
+
+@property(nonatomic, readwrite) ITMGetScrollbackResponse_Status status;
+
+@property(nonatomic, readwrite) BOOL hasStatus;
+@property(nonatomic, readwrite, strong, null_resettable) NSMutableArray<ITMLineContents*> *contentsArray;
+/** The number of items in @c contentsArray without causing the array to be created. */
+@property(nonatomic, readonly) NSUInteger contentsArray_Count;
+
+/** The absolute line number of the first line in `contents`. */
+@property(nonatomic, readwrite) int64_t firstLine;
+
+@property(nonatomic, readwrite) BOOL hasFirstLine;
+/** Pass this as `cursor` to get the next chunk. */
+@property(nonatomic, readwrite) int64_t nextCursor;
+
+@property(nonatomic, readwrite) BOOL hasNextCursor;
+/**
+ * The absolute line number just past the last line in the session at the time the snapshot
+ * was taken. When `next_cursor` equals this, the export is complete.
+ **/
+@property(nonatomic, readwrite) int64_t endOfBuffer;
+
+@property(nonatomic, readwrite) BOOL hasEndOfBuffer;
+@end
+
 #pragma mark - ITMGetPromptRequest
 
 typedef GPB_ENUM(ITMGetPromptRequest_FieldNumber) {
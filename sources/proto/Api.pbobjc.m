@@ -308,6 +308,7 @@ BOOL ITMPromptMonitorMode_IsValidValue(int32_t value__) {
 @dynamic closeRequest;
 @dynamic invokeFunctionRequest;
 @dynamic listPromptsRequest;
+@dynamic getScrollbackRequest;
 
 typedef struct ITMClientOriginatedMessage__storage_ {
   uint32_t _has_storage_[2];
@@ -345,6 +346,7 @@ typedef struct ITMClientOriginatedMessage__storage_ {
   ITMCloseRequest *closeRequest;
   ITMInvokeFunctionRequest *invokeFunctionRequest;
   ITMListPromptsRequest *listPromptsRequest;
+  ITMGetScrollbackRequest *getScrollbackRequest;
   int64_t id_p;
 } ITMClientOriginatedMessage__storage_;
 
@@ -669,6 +671,15 @@ typedef struct ITMClientOriginatedMessage__storage_ {
         .flags = GPBFieldOptional,
         .dataType = GPBDataTypeMessage,
       },
+      {
+        .name = "getScrollbackRequest",
+        .dataTypeSpecific.className = GPBStringifySymbol(ITMGetScrollbackRequest),
+        .number = ITMClientOriginatedMessage_FieldNumber_GetScrollbackRequest,
+        .hasIndex = -1,
+        .offset = (uint32_t)offsetof(ITMClientOriginatedMessage__storage_, getScrollbackRequest),
+        .flags = GPBFieldOptional,
+        .dataType = GPBDataTypeMessage,
+      },
     };
     GPBDescriptor *localDescriptor =
         [GPBDescriptor allocDescriptorForClass:[ITMClientOriginatedMessage class]
@@ -738,6 +749,7 @@ void ITMClientOriginatedMessage_ClearSubmessageOneOfCase(ITMClientOriginatedMess
 @dynamic closeResponse;
 @dynamic invokeFunctionResponse;
 @dynamic listPromptsResponse;
+@dynamic getScrollbackResponse;
 @dynamic notification;
 
 typedef struct ITMServerOriginatedMessage__storage_ {
@@ -777,6 +789,7 @@ typedef struct ITMServerOriginatedMessage__storage_ {
   ITMCloseResponse *closeResponse;
   ITMInvokeFunctionResponse *invokeFunctionResponse;
   ITMListPromptsResponse *listPromptsResponse;
+  ITMGetScrollbackResponse *getScrollbackResponse;
   ITMNotification *notification;
   int64_t id_p;
 } ITMServerOriginatedMessage__storage_;
@@ -1111,6 +1124,15 @@ typedef struct ITMServerOriginatedMessage__storage_ {
         .flags = GPBFieldOptional,
         .dataType = GPBDataTypeMessage,
       },
+      {
+        .name = "getScrollbackResponse",
+        .dataTypeSpecific.className = GPBStringifySymbol(ITMGetScrollbackResponse),
+        .number = ITMServerOriginatedMessage_FieldNumber_GetScrollbackResponse,
+        .hasIndex = -1,
+        .offset = (uint32_t)offsetof(ITMServerOriginatedMessage__storage_, getScrollbackResponse),
+        .flags = GPBFieldOptional,
+        .dataType = GPBDataTypeMessage,
+      },
       {
         .name = "notification",
         .dataTypeSpecific.className = GPBStringifySymbol(ITMNotification),
@@ -9916,6 +9938,204 @@ BOOL ITMGetBufferResponse_Status_IsValidValue(int32_t value__) {
   }
 }
 
+#pragma mark - ITMGetScrollbackRequest
+
+@implementation ITMGetScrollbackRequest
+
+@dynamic hasSession, session;
+@dynamic hasCursor, cursor;
+@dynamic hasMaxLines, maxLines;
+@dynamic hasTextOnly, textOnly;
+
+typedef struct ITMGetScrollbackRequest__storage_ {
+  uint32_t _has_storage_[1];
+  int32_t maxLines;
+  NSString *session;
+  int64_t cursor;
+} ITMGetScrollbackRequest__storage_;
+
+// This method is threadsafe because it is initially called
+// in +initialize for each subclass.
++ (GPBDescriptor *)descriptor {
+  static GPBDescriptor *descriptor = nil;
+  if (!descriptor) {
+    static GPBMessageFieldDescription fields[] = {
+      {
+        .name = "session",
+        .dataTypeSpecific.className = NULL,
+        .number = ITMGetScrollbackRequest_FieldNumber_Session,
+        .hasIndex = 0,
+        .offset = (uint32_t)offsetof(ITMGetScrollbackRequest__storage_, session),
+        .flags = GPBFieldOptional,
+        .dataType = GPBDataTypeString,
+      },
+      {
+        .name = "cursor",
+        .dataTypeSpecific.className = NULL,
+        .number = ITMGetScrollbackRequest_FieldNumber_Cursor,
+        .hasIndex = 1,
+        .offset = (uint32_t)offsetof(ITMGetScrollbackRequest__storage_, cursor),
+        .flags = GPBFieldOptional,
+        .dataType = GPBDataTypeInt64,
+      },
+      {
+        .name = "maxLines",
+        .dataTypeSpecific.className = NULL,
+        .number = ITMGetScrollbackRequest_FieldNumber_MaxLines,
+        .hasIndex = 2,
+        .offset = (uint32_t)offsetof(ITMGetScrollbackRequest__storage_, maxLines),
+        .flags = GPBFieldOptional,
+        .dataType = GPBDataTypeInt32,
+      },
+      {
+        .name = "textOnly",
+        .dataTypeSpecific.className = NULL,
+        .number = ITMGetScrollbackRequest_FieldNumber_TextOnly,
+        .hasIndex = 3,
+        .offset = 4,  // Stored in _has_storage_ to save space.
+        .flags = GPBFieldOptional,
+        .dataType = GPBDataTypeBool,
+      },
+    };
+    GPBDescriptor *localDescriptor =
+        [GPBDescriptor allocDescriptorForClass:[ITMGetScrollbackRequest class]
+                                     rootClass:[ITMApiRoot class]
+                                          file:ITMApiRoot_FileDescriptor()
+                                        fields:fields
+                                    fieldCount:(uint32_t)(sizeof(fields) / sizeof(GPBMessageFieldDescription))
+                                   storageSize:sizeof(ITMGetScrollbackRequest__storage_)
+                                         flags:GPBDescriptorInitializationFlag_None];
+    NSAssert(descriptor == nil, @"Startup recursed!");
+    descriptor = localDescriptor;
+  }
+  return descriptor;
+}
+
+@end
+
+#pragma mark - ITMGetScrollbackResponse
+
+@implementation ITMGetScrollbackResponse
+
+@dynamic hasStatus, status;
+@dynamic contentsArray, contentsArray_Count;
+@dynamic hasFirstLine, firstLine;
+@dynamic hasNextCursor, nextCursor;
+@dynamic hasEndOfBuffer, endOfBuffer;
+
+typedef struct ITMGetScrollbackResponse__storage_ {
+  uint32_t _has_storage_[1];
+  ITMGetScrollbackResponse_Status status;
+  NSMutableArray *contentsArray;
+  int64_t firstLine;
+  int64_t nextCursor;
+  int64_t endOfBuffer;
+} ITMGetScrollbackResponse__storage_;
+
+// This method is threadsafe because it is initially called
+// in +initialize for each subclass.
++ (GPBDescriptor *)descriptor {
+  static GPBDescriptor *descriptor = nil;
+  if (!descriptor) {
+    static GPBMessageFieldDescription fields[] = {
+      {
+        .name = "status",
+        .dataTypeSpecific.enumDescFunc = ITMGetScrollbackResponse_Status_EnumDescriptor,
+        .number = ITMGetScrollbackResponse_FieldNumber_Status,
+        .hasIndex = 0,
+        .offset = (uint32_t)offsetof(ITMGetScrollbackResponse__storage_, status),
+        .flags = (GPBFieldFlags)(GPBFieldOptional | GPBFieldHasDefaultValue | GPBFieldHasEnumDescriptor),
+        .dataType = GPBDataTypeEnum,
+      },
+      {
+        .name = "contentsArray",
+        .dataTypeSpecific.className = GPBStringifySymbol(ITMLineContents),
+        .number = ITMGetScrollbackResponse_FieldNumber_ContentsArray,
+        .hasIndex = GPBNoHasBit,
+        .offset = (uint32_t)offsetof(ITMGetScrollbackResponse__storage_, contentsArray),
+        .flags = GPBFieldRepeated,
+        .dataType = GPBDataTypeMessage,
+      },
+      {
+        .name = "firstLine",
+        .dataTypeSpecific.className = NULL,
+        .number = ITMGetScrollbackResponse_FieldNumber_FirstLine,
+        .hasIndex = 1,
+        .offset = (uint32_t)offsetof(ITMGetScrollbackResponse__storage_, firstLine),
+        .flags = GPBFieldOptional,
+        .dataType = GPBDataTypeInt64,
+      },
+      {
+        .name = "nextCursor",
+        .dataTypeSpecific.className = NULL,
+        .number = ITMGetScrollbackResponse_FieldNumber_NextCursor,
+        .hasIndex = 2,
+        .offset = (uint32_t)offsetof(ITMGetScrollbackResponse__storage_, nextCursor),
+        .flags = GPBFieldOptional,
+        .dataType = GPBDataTypeInt64,
+      },
+      {
+        .name = "endOfBuffer",
+        .dataTypeSpecific.className = NULL,
+        .number = ITMGetScrollbackResponse_FieldNumber_EndOfBuffer,
+        .hasIndex = 3,
+        .offset = (uint32_t)offsetof(ITMGetScrollbackResponse__storage_, endOfBuffer),
+        .flags = GPBFieldOptional,
+        .dataType = GPBDataTypeInt64,
+      },
+    };
+    GPBDescriptor *localDescriptor =
+        [GPBDescriptor allocDescriptorForClass:[ITMGetScrollbackResponse class]
+                                     rootClass:[ITMApiRoot class]
+                                          file:ITMApiRoot_FileDescriptor()
+                                        fields:fields
+                                    fieldCount:(uint32_t)(sizeof(fields) / sizeof(GPBMessageFieldDescription))
+                                   storageSize:sizeof(ITMGetScrollbackResponse__storage_)
+                                         flags:GPBDescriptorInitializationFlag_None];
+    NSAssert(descriptor == nil, @"Startup recursed!");
+    descriptor = localDescriptor;
+  }
+  return descriptor;
+}
+
+@end
+
+#pragma mark - Enum ITMGetScrollbackResponse_Status
+
+GPBEnumDescriptor *ITMGetScrollbackResponse_Status_EnumDescriptor(void) {
+  static GPBEnumDescriptor *descriptor = NULL;
+  if (!descriptor) {
+    static const char *valueNames =
+        "Ok\000SessionNotFound\000InvalidCursor\000";
+    static const int32_t values[] = {
+        ITMGetScrollbackResponse_Status_Ok,
+        ITMGetScrollbackResponse_Status_SessionNotFound,
+        ITMGetScrollbackResponse_Status_InvalidCursor,
+    };
+    GPBEnumDescriptor *worker =
+        [GPBEnumDescriptor allocDescriptorForName:GPBNSStringifySymbol(ITMGetScrollbackResponse_Status)
+                                       valueNames:valueNames
+                                           values:values
+                                            count:(uint32_t)(sizeof(values) / sizeof(int32_t))
+                                     enumVerifier:ITMGetScrollbackResponse_Status_IsValidValue];
+    if (!OSAtomicCompareAndSwapPtrBarrier(nil, worker, (void * volatile *)&descriptor)) {
+      [worker release];
+    }
+  }
+  return descriptor;
+}
+
+BOOL ITMGetScrollbackResponse_Status_IsValidValue(int32_t value__) {
+  switch (value__) {
+    case ITMGetScrollbackResponse_Status_Ok:
+    case ITMGetScrollbackResponse_Status_SessionNotFound:
+    case ITMGetScrollbackResponse_Status_InvalidCursor:
+      return YES;
+    default:
+      return NO;
+  }
+}
+
 #pragma mark - ITMGetPromptRequest
 
 @implementation ITMGetPromptRequest
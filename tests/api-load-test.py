@@ -0,0 +1,91 @@
+#!/usr/bin/env python3
+# Drives the API server's unix socket with many concurrent clients and reports request latency.
+#
+# Each client opens its own connection and issues read-only requests (ListSessions and
+# GetProperty) in a loop. Use --mutating to make a fraction of requests SetProperty calls, which
+# are serialized on the main thread and invalidate the server's model snapshot.
+#
+# usage: api-load-test.py [-c clients] [-n requests-per-client] [--mutating fraction]
+import argparse
+import asyncio
+import json
+import random
+import statistics
+import time
+
+import iterm2
+import iterm2.rpc
+
+
+def percentile(sorted_values, p):
+    if not sorted_values:
+        return 0
+    index = min(len(sorted_values) - 1, int(round(p / 100.0 * (len(sorted_values) - 1))))
+    return sorted_values[index]
+
+
+async def async_client(count, mutating, session_id, window_id, frame):
+    connection = await iterm2.Connection.async_create()
+    latencies = {"read": [], "write": []}
+    for _ in range(count):
+        kind = "write" if random.random() < mutating else "read"
+        start = time.perf_counter()
+        if kind == "write":
+            await iterm2.rpc.async_set_property(connection, "frame", json.dumps(frame), window_id=window_id)
+        elif random.random() < 0.5:
+            await iterm2.rpc.async_list_sessions(connection)
+        else:
+            await iterm2.rpc.async_get_property(connection, "grid_size", session_id=session_id)
+        latencies[kind].append((time.perf_counter() - start) * 1000.0)
+    return latencies
+
+
+def report(name, values):
+    if not values:
+        return
+    values.sort()
+    print("%-6s n=%-7d p50=%7.3fms p99=%7.3fms max=%7.3fms mean=%7.3fms" % (
+        name,
+        len(values),
+        percentile(values, 50),
+        percentile(values, 99),
+        values[-1],
+        statistics.mean(values)))
+
+
+async def async_main(args):
+    connection = await iterm2.Connection.async_create()
+    app = await iterm2.async_get_app(connection)
+    window = app.current_terminal_window or app.terminal_windows[0]
+    session = window.current_tab.current_session
+    response = await iterm2.rpc.async_get_property(connection, "frame", window_id=window.window_id)
+    frame = json.loads(response.get_property_response.json_value)
+
+    start = time.perf_counter()
+    results = await asyncio.gather(*[
+        async_client(args.requests, args.mutating, session.session_id, window.window_id, frame)
+        for _ in range(args.clients)])
+    elapsed = time.perf_counter() - start
+
+    reads = [value for result in results for value in result["read"]]
+    writes = [value for result in results for value in result["write"]]
+    print("%d clients, %d requests in %.2fs (%.0f requests/s)" % (
+        args.clients,
+        len(reads) + len(writes),
+        elapsed,
+        (len(reads) + len(writes)) / elapsed))
+    report("read", reads)
+    report("write", writes)
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Load test for the iTerm2 API server")
+    parser.add_argument("-c", "--clients", type=int, default=32, help="Number of concurrent connections")
+    parser.add_argument("-n", "--requests", type=int, default=1000, help="Requests per client")
+    parser.add_argument("--mutating", type=float, default=0, help="Fraction of requests that are writes")
+    args = parser.parse_args()
+    asyncio.get_event_loop().run_until_complete(async_main(args))
+
+
+if __name__ == "__main__":
+    main()
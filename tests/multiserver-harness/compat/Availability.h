@@ -0,0 +1 @@
+// Empty stand-in for the macOS header so iTermServer builds on Linux.
@@ -0,0 +1,2 @@
+// Empty stand-in for the macOS header so iTermServer builds on Linux. The server doesn't use
+// anything from Carbon.
@@ -0,0 +1,38 @@
+// Force-included in every file when building iTermServer and the harness on Linux. It fills in
+// the BSD-isms the sources rely on.
+#include <stdint.h>
+#include <string.h>
+#include <sys/ioctl.h>
+#include <sys/wait.h>
+#include <termios.h>
+
+// Advisory locking is only used to keep two servers from sharing a socket. The harness doesn't
+// need it.
+#ifndef O_EXLOCK
+#define O_EXLOCK 0
+#endif
+
+// Linux has no delayed-suspend or status characters. Park them in unused c_cc slots.
+#ifndef VDSUSP
+#define VDSUSP 17
+#endif
+#ifndef VSTATUS
+#define VSTATUS 18
+#endif
+
+#if !defined(__GLIBC__) || !defined(__GLIBC_MINOR__) || __GLIBC__ < 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ < 38)
+static inline size_t strlcpy(char *dst, const char *src, size_t size) {
+    const size_t length = strlen(src);
+    if (size > 0) {
+        const size_t n = length < size - 1 ? length : size - 1;
+        memcpy(dst, src, n);
+        dst[n] = '\0';
+    }
+    return length;
+}
+#endif
+
+// iTermPosixTTYReplacements.c is built without _GNU_SOURCE, which hides glibc's declaration.
+#ifndef _GNU_SOURCE
+int asprintf(char **strp, const char *fmt, ...);
+#endif
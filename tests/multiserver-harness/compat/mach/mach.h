@@ -0,0 +1,24 @@
+// Just enough of mach to satisfy CheckIfBootstrapPortIsDead(). There is no bootstrap port on Linux
+// so it is never dead.
+#include <errno.h>
+
+typedef unsigned int mach_port_t;
+typedef unsigned int mach_port_type_t;
+typedef int kern_return_t;
+
+#define KERN_SUCCESS 0
+#define MACH_PORT_TYPE_DEAD_NAME 0x100000
+
+static inline mach_port_t mach_task_self(void) {
+    return 0;
+}
+
+static inline kern_return_t task_get_bootstrap_port(mach_port_t task, mach_port_t *port) {
+    *port = 1;
+    return KERN_SUCCESS;
+}
+
+static inline kern_return_t mach_port_type(mach_port_t task, mach_port_t port, mach_port_type_t *type) {
+    *type = 0;
+    return KERN_SUCCESS;
+}
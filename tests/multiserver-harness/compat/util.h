@@ -0,0 +1,3 @@
+// On Linux forkpty() is declared in pty.h instead of util.h.
+#include <pty.h>
+#include <utmp.h>
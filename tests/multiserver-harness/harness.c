@@ -0,0 +1,513 @@
+//
+//  harness.c
+//  iTerm2
+//
+//  Created by George Nachman on 10/18/26.
+//
+// A headless client for iTermServer. It launches the server the way iTerm2 does, has it fork a
+// bunch of children, disconnects, and then measures how long it takes to reattach and receive
+// every child report. It checks that every child comes back exactly once with a usable file
+// descriptor. Before that it checks that the client closes the file descriptors that come with a
+// message it can't parse.
+//
+// usage: harness -s path/to/iTermServer [-n children] [-p maximum protocol version]
+
+#include "iTermFileDescriptorServerShared.h"
+#include "iTermMultiServerProtocol.h"
+#include "iTermPosixTTYReplacements.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <signal.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <sys/un.h>
+#include <sys/wait.h>
+#include <time.h>
+#include <unistd.h>
+
+// Referenced by iTermCLogging.h when ITERM_SERVER is defined.
+const char *gMultiServerSocketPath = "harness";
+
+typedef struct {
+    int readFd;
+    int writeFd;
+} Connection;
+
+static void Fail(const char *format, ...) {
+    va_list args;
+    va_start(args, format);
+    fprintf(stderr, "FAIL: ");
+    vfprintf(stderr, format, args);
+    fprintf(stderr, "\n");
+    va_end(args);
+    exit(1);
+}
+
+static double Now(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1000.0 + ts.tv_nsec / 1000000.0;
+}
+
+static int ReadAll(int fd, void *buffer, size_t length) {
+    size_t offset = 0;
+    while (offset < length) {
+        const ssize_t n = read(fd, (char *)buffer + offset, length - offset);
+        if (n < 0 && errno == EINTR) {
+            continue;
+        }
+        if (n <= 0) {
+            return -1;
+        }
+        offset += n;
+    }
+    return 0;
+}
+
+#pragma mark - Messages
+
+// Reads a length-prefixed message. File descriptors arrive with the first byte of the payload, so
+// use recvmsg for the first read and plain reads for the rest, as iTermFileDescriptorMultiClient
+// does.
+static int ReadRawMessage(int fd, iTermClientServerProtocolMessage *message) {
+    size_t length = 0;
+    if (ReadAll(fd, &length, sizeof(length))) {
+        return -1;
+    }
+    if (length == 0 || length > 1024 * 1024) {
+        return -1;
+    }
+    iTermClientServerProtocolMessageInitialize(message);
+    iTermClientServerProtocolMessageEnsureSpace(message, length);
+    ssize_t n;
+    do {
+        n = recvmsg(fd, &message->message, 0);
+    } while (n < 0 && errno == EINTR);
+    if (n <= 0) {
+        iTermClientServerProtocolMessageFree(message);
+        return -1;
+    }
+    if (ReadAll(fd, (char *)message->ioVectors[0].iov_base + n, length - n)) {
+        iTermClientServerProtocolMessageFree(message);
+        return -1;
+    }
+    return 0;
+}
+
+static int ReadServerMessage(int fd, iTermMultiServerServerOriginatedMessage *out) {
+    iTermClientServerProtocolMessage message;
+    if (ReadRawMessage(fd, &message)) {
+        return -1;
+    }
+    const int rc = iTermMultiServerProtocolParseMessageFromServer(&message, out);
+    iTermClientServerProtocolMessageFree(&message);
+    if (rc) {
+        fprintf(stderr, "Parse failed with %d\n", rc);
+        iTermMultiServerServerOriginatedMessageFree(out);
+        return -1;
+    }
+    return 0;
+}
+
+static void Send(Connection *connection, iTermMultiServerClientOriginatedMessage *request) {
+    iTermClientServerProtocolMessage message;
+    iTermClientServerProtocolMessageInitialize(&message);
+    if (iTermMultiServerProtocolEncodeMessageFromClient(request, &message)) {
+        Fail("Could not encode request of type %d", request->type);
+    }
+    const size_t length = message.ioVectors[0].iov_len;
+    if (iTermFileDescriptorClientWrite(connection->writeFd, &length, sizeof(length)) != sizeof(length) ||
+        iTermFileDescriptorClientWrite(connection->writeFd, message.ioVectors[0].iov_base, length) != (ssize_t)length) {
+        Fail("Write failed: %s", strerror(errno));
+    }
+    iTermClientServerProtocolMessageFree(&message);
+}
+
+#pragma mark - Server
+
+// Launches the server with the file descriptors it expects on entry. See the comment at the top of
+// iTermFileDescriptorMultiServer.c.
+static pid_t LaunchServer(const char *serverPath, const char *socketPath, Connection *connection) {
+    const int acceptFd = iTermFileDescriptorServerSocketBindListen(socketPath);
+    if (acceptFd < 0) {
+        Fail("Could not listen on %s", socketPath);
+    }
+    int initialConnection[2];
+    int toServer[2];
+    int deadMansPipe[2];
+    if (socketpair(AF_UNIX, SOCK_STREAM, 0, initialConnection) ||
+        pipe(toServer) ||
+        pipe(deadMansPipe)) {
+        Fail("Could not create pipes: %s", strerror(errno));
+    }
+    char lockPath[PATH_MAX];
+    snprintf(lockPath, sizeof(lockPath), "%s.lock", socketPath);
+    const int lockFd = open(lockPath, O_CREAT | O_TRUNC | O_RDWR, 0600);
+
+    const pid_t pid = fork();
+    if (pid < 0) {
+        Fail("fork failed: %s", strerror(errno));
+    }
+    if (pid == 0) {
+        int fds[] = { acceptFd, initialConnection[1], deadMansPipe[1], toServer[0], lockFd };
+        iTermPosixMoveFileDescriptors(fds, sizeof(fds) / sizeof(*fds));
+        execl(serverPath, serverPath, socketPath, (char *)NULL);
+        _exit(1);
+    }
+    close(acceptFd);
+    close(initialConnection[1]);
+    close(toServer[0]);
+    close(deadMansPipe[1]);
+    close(lockFd);
+    unlink(lockPath);
+    connection->readFd = initialConnection[0];
+    connection->writeFd = toServer[1];
+    return pid;
+}
+
+// Connects to a running server. It answers with a hello carrying the write end of a new pipe.
+static void Reconnect(const char *socketPath, Connection *connection) {
+    const int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    struct sockaddr_un address = { .sun_family = AF_UNIX };
+    strlcpy(address.sun_path, socketPath, sizeof(address.sun_path));
+    if (connect(fd, (struct sockaddr *)&address, sizeof(address))) {
+        Fail("connect failed: %s", strerror(errno));
+    }
+    iTermClientServerProtocolMessage message;
+    if (ReadRawMessage(fd, &message)) {
+        Fail("No hello");
+    }
+    int writeFd = -1;
+    if (iTermMultiServerProtocolGetFileDescriptor(&message, &writeFd)) {
+        Fail("Hello is missing its file descriptor");
+    }
+    iTermClientServerProtocolMessageFree(&message);
+    connection->readFd = fd;
+    connection->writeFd = writeFd;
+}
+
+static void Disconnect(Connection *connection) {
+    close(connection->readFd);
+    close(connection->writeFd);
+    connection->readFd = -1;
+    connection->writeFd = -1;
+}
+
+static int Handshake(Connection *connection, int maximumProtocolVersion, int *numberOfChildren) {
+    iTermMultiServerClientOriginatedMessage request = {
+        .type = iTermMultiServerRPCTypeHandshake,
+        .payload.handshake.maximumProtocolVersion = maximumProtocolVersion
+    };
+    Send(connection, &request);
+    iTermMultiServerServerOriginatedMessage response;
+    if (ReadServerMessage(connection->readFd, &response) ||
+        response.type != iTermMultiServerRPCTypeHandshake) {
+        Fail("Bad handshake response");
+    }
+    const int version = response.payload.handshake.protocolVersion;
+    *numberOfChildren = response.payload.handshake.numChildren;
+    iTermMultiServerServerOriginatedMessageFree(&response);
+    return version;
+}
+
+#pragma mark - Children
+
+static const char *gArgv[] = { "/bin/sleep", "600", NULL };
+static const char *gEnvironment[] = { "PATH=/usr/bin:/bin", "TERM=xterm-256color", "LANG=C.UTF-8", NULL };
+
+static iTermMultiServerRequestLaunch MakeLaunchRequest(int i) {
+    iTermMultiServerRequestLaunch launch = {
+        .path = gArgv[0],
+        .argv = gArgv,
+        .argc = 2,
+        .envp = gEnvironment,
+        .envc = 3,
+        .columns = 80,
+        .rows = 25,
+        .pixel_width = 640,
+        .pixel_height = 400,
+        .isUTF8 = 1,
+        .pwd = "/",
+        .uniqueId = 1000 + i
+    };
+    return launch;
+}
+
+static void RecordLaunch(const iTermMultiServerResponseLaunch *launch, pid_t *pids, int *count) {
+    if (launch->status != 0) {
+        Fail("Launch failed with status %d", launch->status);
+    }
+    pids[(*count)++] = launch->pid;
+    close(launch->fd);
+}
+
+static void LaunchChildren(Connection *connection, int protocolVersion, int n, pid_t *pids) {
+    int launched = 0;
+    while (launched < n) {
+        iTermMultiServerResponseLaunch *responses;
+        int count;
+        iTermMultiServerServerOriginatedMessage response;
+        if (protocolVersion >= iTermMultiServerProtocolVersion3) {
+            iTermMultiServerRequestLaunch launches[iTermMultiServerMaximumLaunchBatchSize];
+            count = n - launched < iTermMultiServerMaximumLaunchBatchSize ? n - launched : iTermMultiServerMaximumLaunchBatchSize;
+            for (int i = 0; i < count; i++) {
+                launches[i] = MakeLaunchRequest(launched + i);
+            }
+            iTermMultiServerClientOriginatedMessage request = {
+                .type = iTermMultiServerRPCTypeLaunchBatch,
+                .payload.launchBatch = { .count = count, .launches = launches }
+            };
+            Send(connection, &request);
+            if (ReadServerMessage(connection->readFd, &response) ||
+                response.type != iTermMultiServerRPCTypeLaunchBatch) {
+                Fail("Bad launch batch response");
+            }
+            responses = response.payload.launchBatch.launches;
+            count = response.payload.launchBatch.count;
+        } else {
+            iTermMultiServerClientOriginatedMessage request = {
+                .type = iTermMultiServerRPCTypeLaunch,
+                .payload.launch = MakeLaunchRequest(launched)
+            };
+            Send(connection, &request);
+            if (ReadServerMessage(connection->readFd, &response) ||
+                response.type != iTermMultiServerRPCTypeLaunch) {
+                Fail("Bad launch response");
+            }
+            responses = &response.payload.launch;
+            count = 1;
+        }
+        for (int i = 0; i < count; i++) {
+            RecordLaunch(&responses[i], pids, &launched);
+        }
+        iTermMultiServerServerOriginatedMessageFree(&response);
+    }
+}
+
+static void CheckReport(const iTermMultiServerReportChild *report, pid_t *pids, int n, int *seen) {
+    int index = -1;
+    for (int i = 0; i < n; i++) {
+        if (pids[i] == report->pid) {
+            index = i;
+            break;
+        }
+    }
+    if (index < 0) {
+        Fail("Unexpected pid %d", report->pid);
+    }
+    if (seen[index]) {
+        Fail("Pid %d reported twice", report->pid);
+    }
+    seen[index] = 1;
+    if (report->argc != 2 || strcmp(report->argv[0], gArgv[0]) || strcmp(report->path, gArgv[0])) {
+        Fail("Wrong command line for pid %d", report->pid);
+    }
+    if (!isatty(report->fd)) {
+        Fail("File descriptor %d for pid %d isn't a tty", report->fd, report->pid);
+    }
+    close(report->fd);
+}
+
+// Reads reports until the last one. Returns the number of messages it took.
+static int ReadChildReports(Connection *connection,
+                            pid_t *pids,
+                            int n,
+                            double start,
+                            double *firstReportTime) {
+    int *seen = calloc(n, sizeof(int));
+    int numberOfMessages = 0;
+    int numberReported = 0;
+    int isLast = (n == 0);
+    while (!isLast) {
+        iTermMultiServerServerOriginatedMessage message;
+        if (ReadServerMessage(connection->readFd, &message)) {
+            Fail("Could not read child report");
+        }
+        if (numberOfMessages == 0) {
+            *firstReportTime = Now() - start;
+        }
+        numberOfMessages++;
+        switch (message.type) {
+            case iTermMultiServerRPCTypeReportChild:
+                CheckReport(&message.payload.reportChild, pids, n, seen);
+                numberReported++;
+                isLast = message.payload.reportChild.isLast;
+                break;
+            case iTermMultiServerRPCTypeReportChildren:
+                for (int i = 0; i < message.payload.reportChildren.count; i++) {
+                    CheckReport(&message.payload.reportChildren.children[i], pids, n, seen);
+                }
+                numberReported += message.payload.reportChildren.count;
+                isLast = message.payload.reportChildren.isLast;
+                break;
+            default:
+                Fail("Unexpected message of type %d while reading reports", message.type);
+        }
+        iTermMultiServerServerOriginatedMessageFree(&message);
+    }
+    if (numberReported != n) {
+        Fail("Expected %d children but %d were reported", n, numberReported);
+    }
+    free(seen);
+    return numberOfMessages;
+}
+
+#pragma mark - Rejected Messages
+
+static int CountOpenFileDescriptors(void) {
+    int count = 0;
+    for (int fd = 0; fd < 1024; fd++) {
+        if (fcntl(fd, F_GETFD) != -1) {
+            count++;
+        }
+    }
+    return count;
+}
+
+// Sends a message of |type| that ends after its first field, along with |n| file descriptors, and
+// checks that the parser rejects it without leaking any of them.
+static void CheckTruncatedMessageClosesFileDescriptors(iTermMultiServerRPCType type, int firstTag, int n) {
+    int sockets[2];
+    if (socketpair(AF_UNIX, SOCK_STREAM, 0, sockets)) {
+        Fail("socketpair failed: %s", strerror(errno));
+    }
+    const int before = CountOpenFileDescriptors();
+
+    iTermClientServerProtocolMessage message;
+    iTermClientServerProtocolMessageInitialize(&message);
+    iTermClientServerProtocolMessageEncoder encoder = {
+        .offset = 0,
+        .message = &message
+    };
+    int value = 1;
+    if (iTermClientServerProtocolEncodeTaggedInt(&encoder, &type, sizeof(type), iTermMultiServerTagType) ||
+        iTermClientServerProtocolEncodeTaggedInt(&encoder, &value, sizeof(value), firstTag)) {
+        Fail("Could not encode truncated message of type %d", type);
+    }
+    iTermEncoderCommit(&encoder);
+
+    int fds[iTermMultiServerMaximumReportChildrenBatchSize];
+    for (int i = 0; i < n; i++) {
+        fds[i] = open("/dev/null", O_RDONLY);
+    }
+    int error = 0;
+    if (iTermFileDescriptorServerWriteLengthAndBufferAndFileDescriptors(sockets[1],
+                                                                        message.ioVectors[0].iov_base,
+                                                                        message.ioVectors[0].iov_len,
+                                                                        fds,
+                                                                        n,
+                                                                        &error) <= 0) {
+        Fail("Could not send truncated message: %s", strerror(error));
+    }
+    for (int i = 0; i < n; i++) {
+        close(fds[i]);
+    }
+    iTermClientServerProtocolMessageFree(&message);
+
+    iTermMultiServerServerOriginatedMessage parsed;
+    if (ReadServerMessage(sockets[0], &parsed) == 0) {
+        Fail("Truncated message of type %d was accepted", type);
+    }
+    const int after = CountOpenFileDescriptors();
+    if (after != before) {
+        Fail("Rejecting a message of type %d leaked %d file descriptors", type, after - before);
+    }
+    close(sockets[0]);
+    close(sockets[1]);
+}
+
+#pragma mark - Main
+
+int main(int argc, char *argv[]) {
+    const char *serverPath = NULL;
+    int numberOfChildren = 100;
+    int maximumProtocolVersion = iTermMultiServerProtocolVersion4;
+    int opt;
+    while ((opt = getopt(argc, argv, "s:n:p:")) != -1) {
+        switch (opt) {
+            case 's':
+                serverPath = optarg;
+                break;
+            case 'n':
+                numberOfChildren = atoi(optarg);
+                break;
+            case 'p':
+                maximumProtocolVersion = atoi(optarg);
+                break;
+            default:
+                fprintf(stderr, "usage: %s -s path/to/iTermServer [-n children] [-p maximum protocol version]\n", argv[0]);
+                return 2;
+        }
+    }
+    if (!serverPath || numberOfChildren <= 0) {
+        fprintf(stderr, "usage: %s -s path/to/iTermServer [-n children] [-p maximum protocol version]\n", argv[0]);
+        return 2;
+    }
+    signal(SIGPIPE, SIG_IGN);
+
+    CheckTruncatedMessageClosesFileDescriptors(iTermMultiServerRPCTypeReportChildren,
+                                               iTermMultiServerTagReportChildrenIsLast,
+                                               iTermMultiServerMaximumReportChildrenBatchSize);
+    CheckTruncatedMessageClosesFileDescriptors(iTermMultiServerRPCTypeLaunchBatch,
+                                               iTermMultiServerTagLaunchBatchResponseCount,
+                                               4);
+
+    char socketPath[] = "/tmp/iterm2-harness-XXXXXX";
+    if (!mkdtemp(socketPath)) {
+        Fail("mkdtemp failed: %s", strerror(errno));
+    }
+    char directory[sizeof(socketPath)];
+    strcpy(directory, socketPath);
+    strlcpy(socketPath + strlen(socketPath), "/s", 3);
+
+    Connection connection;
+    const pid_t serverPid = LaunchServer(serverPath, socketPath, &connection);
+    int existingChildren = 0;
+    const int protocolVersion = Handshake(&connection, maximumProtocolVersion, &existingChildren);
+    if (existingChildren != 0) {
+        Fail("New server has %d children", existingChildren);
+    }
+
+    pid_t *pids = calloc(numberOfChildren, sizeof(pid_t));
+    const double launchStart = Now();
+    LaunchChildren(&connection, protocolVersion, numberOfChildren, pids);
+    const double launchTime = Now() - launchStart;
+
+    // Simulate iTerm2 quitting and relaunching.
+    Disconnect(&connection);
+    Reconnect(socketPath, &connection);
+
+    const double start = Now();
+    int reportedChildren = 0;
+    const int reattachVersion = Handshake(&connection, maximumProtocolVersion, &reportedChildren);
+    if (reportedChildren != numberOfChildren) {
+        Fail("Handshake says %d children, expected %d", reportedChildren, numberOfChildren);
+    }
+    double firstReportTime = 0;
+    const int numberOfMessages = ReadChildReports(&connection, pids, numberOfChildren, start, &firstReportTime);
+    const double reattachTime = Now() - start;
+
+    printf("protocol=%d children=%d launch=%.2fms reattach: messages=%d first=%.2fms all=%.2fms\n",
+           reattachVersion,
+           numberOfChildren,
+           launchTime,
+           numberOfMessages,
+           firstReportTime,
+           reattachTime);
+
+    for (int i = 0; i < numberOfChildren; i++) {
+        kill(pids[i], SIGKILL);
+    }
+    Disconnect(&connection);
+    kill(serverPid, SIGTERM);
+    waitpid(serverPid, NULL, 0);
+    unlink(socketPath);
+    rmdir(directory);
+    free(pids);
+    return 0;
+}
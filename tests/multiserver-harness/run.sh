@@ -0,0 +1,44 @@
+#!/bin/bash
+# Builds iTermServer and a headless C client from the sources in this tree, then measures how long
+# reattaching to a server with many children takes with each protocol version. Runs on Linux as
+# well as macOS; on Linux the headers in compat/ stand in for the macOS-only ones.
+#
+# usage: run.sh [number of children...]
+set -e
+
+HERE=$(cd "$(dirname "$0")" && pwd)
+SOURCES="$HERE/../../sources"
+BUILD=$(mktemp -d)
+trap 'rm -rf "$BUILD"' EXIT
+
+CC=${CC:-cc}
+CFLAGS="-O2 -DITERM_SERVER=1 -I $SOURCES -Wall -Werror"
+if [ "$(uname)" = "Linux" ]; then
+    CFLAGS="$CFLAGS -I $HERE/compat -include iTermLinuxCompat.h"
+    # gcc objects to #import and #pragma mark, which the sources use everywhere.
+    CFLAGS="$CFLAGS -Wno-deprecated -Wno-unknown-pragmas"
+    # iTermPosixTTYReplacements.c declares environ itself, which conflicts with _GNU_SOURCE.
+    GNU="-D_GNU_SOURCE"
+    LIBS="-lutil"
+fi
+
+SHARED="iTermMultiServerProtocol.c iTermClientServerProtocol.c iTermFileDescriptorServerShared.c iTermTTYState.c iTermResourceLimitsHelper.c"
+for f in $SHARED iTermFileDescriptorMultiServer.c; do
+    $CC $CFLAGS $GNU -c "$SOURCES/$f" -o "$BUILD/${f%.c}.o"
+done
+$CC $CFLAGS -c "$SOURCES/iTermPosixTTYReplacements.c" -o "$BUILD/iTermPosixTTYReplacements.o"
+$CC $CFLAGS $GNU -c "$HERE/harness.c" -o "$BUILD/harness.o"
+
+OBJECTS=""
+for f in $SHARED iTermPosixTTYReplacements.c; do
+    OBJECTS="$OBJECTS $BUILD/${f%.c}.o"
+done
+$CC -o "$BUILD/iTermServer" $OBJECTS "$BUILD/iTermFileDescriptorMultiServer.o" $LIBS
+$CC -o "$BUILD/harness" $OBJECTS "$BUILD/harness.o" $LIBS
+
+COUNTS=${@:-1 10 100 500}
+for n in $COUNTS; do
+    for version in 2 3 4; do
+        "$BUILD/harness" -s "$BUILD/iTermServer" -n "$n" -p "$version"
+    done
+done